@@ -134,6 +134,92 @@ public class BridgeBenchmarks : IDisposable
     }
 }
 
+/// <summary>
+/// Compares the postMessage transport (request as a web message, response as an evaluated
+/// <c>_onResponse</c> script) with the fetch transport (request and response as one
+/// <c>app://__rpc</c> exchange): latency of one call and throughput of a burst of concurrent
+/// calls. The mock adapter leaves out engine IPC, so this isolates the runtime's share.
+/// </summary>
+[MemoryDiagnoser]
+[SimpleJob(RuntimeMoniker.Net90)]
+public class BridgeTransportBenchmarks : IDisposable
+{
+    private const int ConcurrentCalls = 64;
+
+    private WebViewCore _core = null!;
+    private Testing.MockWebViewAdapterWithFetchBridge _adapter = null!;
+    private Testing.TestDispatcher _dispatcher = null!;
+    private string[] _requests = null!;
+
+    [Params(WebMessageBridgeTransport.PostMessage, WebMessageBridgeTransport.Fetch)]
+    public WebMessageBridgeTransport Transport { get; set; }
+
+    [GlobalSetup]
+    public void Setup()
+    {
+        _dispatcher = new Testing.TestDispatcher();
+        _adapter = Testing.MockWebViewAdapter.CreateWithFetchBridge();
+        _core = new WebViewCore(_adapter, _dispatcher);
+
+        _core.EnableWebMessageBridge(new WebMessageBridgeOptions { Transport = Transport });
+        _dispatcher.RunAll();
+
+        _core.Bridge.Expose<BridgeBenchmarks.ICalcService>(new CalcServiceImpl());
+        _dispatcher.RunAll();
+
+        _requests = Enumerable.Range(0, ConcurrentCalls)
+            .Select(i => JsonSerializer.Serialize(new
+            {
+                jsonrpc = "2.0",
+                id = "__js_" + i,
+                method = "CalcService.Add",
+                @params = new { a = i, b = 1 }
+            }))
+            .ToArray();
+    }
+
+    [GlobalCleanup]
+    public void Cleanup() => Dispose();
+
+    /// <inheritdoc />
+    public void Dispose()
+    {
+        _core?.Dispose();
+        GC.SuppressFinalize(this);
+    }
+
+    [Benchmark(Description = "Bridge transport: one call, request to response")]
+    public async Task Latency()
+    {
+        await CallAsync(_requests[0]);
+    }
+
+    [Benchmark(Description = "Bridge transport: 64 concurrent calls", OperationsPerInvoke = ConcurrentCalls)]
+    public async Task Throughput()
+    {
+        var calls = new Task[ConcurrentCalls];
+        for (var i = 0; i < calls.Length; i++)
+            calls[i] = CallAsync(_requests[i]);
+        await Task.WhenAll(calls);
+    }
+
+    private Task CallAsync(string request)
+    {
+        if (Transport == WebMessageBridgeTransport.Fetch)
+            return _adapter.FetchAsync(request);
+
+        // The response leaves as an _onResponse script evaluated while the dispatcher drains.
+        _adapter.RaiseWebMessage(request, "app://localhost", _core.ChannelId);
+        _dispatcher.RunAll();
+        return Task.CompletedTask;
+    }
+
+    private sealed class CalcServiceImpl : BridgeBenchmarks.ICalcService
+    {
+        public Task<int> Add(int a, int b) => Task.FromResult(a + b);
+    }
+}
+
 /// <summary>
 /// Measures raw RPC (non-typed) overhead for comparison.
 /// </summary>
@@ -0,0 +1,79 @@
+using System.Globalization;
+using System.Security.Cryptography;
+using System.Text;
+using BenchmarkDotNet.Columns;
+using BenchmarkDotNet.Configs;
+using BenchmarkDotNet.Reports;
+using BenchmarkDotNet.Running;
+
+namespace Agibuild.Fulora.Benchmarks;
+
+/// <summary>
+/// Hands values measured inside a benchmark process (process RSS, frame counts) to summary
+/// columns in the host process. BenchmarkDotNet runs each case in its own process, so the
+/// benchmark reports from <c>[GlobalCleanup]</c> into a file keyed by case and metric, and a
+/// <see cref="GtkBenchmarkMetricColumn"/> reads it back when the summary is printed.
+/// </summary>
+internal static class GtkBenchmarkMetrics
+{
+    private static readonly string MetricsDirectory = Path.Combine(Path.GetTempPath(), "fulora-benchmark-metrics");
+
+    /// <summary>Records <paramref name="value"/> for the running case of <paramref name="benchmark"/>.</summary>
+    /// <param name="parameters">The case's <c>[Params]</c> as <c>Name=value</c> pairs, in declaration order.</param>
+    public static void Report(object benchmark, string metric, double value, params string[] parameters)
+    {
+        Directory.CreateDirectory(MetricsDirectory);
+        File.WriteAllText(
+            PathFor(benchmark.GetType().Name, string.Join('&', parameters), metric),
+            value.ToString("R", CultureInfo.InvariantCulture));
+    }
+
+    internal static string? Read(BenchmarkCase benchmarkCase, string metric)
+    {
+        var parameters = string.Join('&', benchmarkCase.Parameters.Items.Select(p =>
+            p.Name + "=" + Convert.ToString(p.Value, CultureInfo.InvariantCulture)));
+        var path = PathFor(benchmarkCase.Descriptor.Type.Name, parameters, metric);
+        return File.Exists(path) ? File.ReadAllText(path) : null;
+    }
+
+    private static string PathFor(string type, string parameters, string metric)
+    {
+        var key = SHA256.HashData(Encoding.UTF8.GetBytes(type + "\n" + parameters + "\n" + metric));
+        return Path.Combine(MetricsDirectory, Convert.ToHexString(key, 0, 12) + ".txt");
+    }
+}
+
+/// <summary>A numeric summary column filled from <see cref="GtkBenchmarkMetrics.Report"/>.</summary>
+internal sealed class GtkBenchmarkMetricColumn(string metric, string format = "N1") : IColumn
+{
+    public string Id => nameof(GtkBenchmarkMetricColumn) + "." + metric;
+    public string ColumnName => metric;
+    public bool AlwaysShow => true;
+    public ColumnCategory Category => ColumnCategory.Custom;
+    public int PriorityInCategory => 0;
+    public bool IsNumeric => true;
+    public UnitType UnitType => UnitType.Dimensionless;
+    public string Legend => $"{metric}, measured in the benchmark process at cleanup";
+
+    public bool IsDefault(Summary summary, BenchmarkCase benchmarkCase) => false;
+    public bool IsAvailable(Summary summary) => true;
+
+    public string GetValue(Summary summary, BenchmarkCase benchmarkCase)
+        => GetValue(summary, benchmarkCase, summary.Style);
+
+    public string GetValue(Summary summary, BenchmarkCase benchmarkCase, SummaryStyle style)
+        => GtkBenchmarkMetrics.Read(benchmarkCase, metric) is { } text
+            && double.TryParse(text, NumberStyles.Float, CultureInfo.InvariantCulture, out var value)
+            ? value.ToString(format, style.CultureInfo)
+            : "-";
+}
+
+/// <summary>Adds one <see cref="GtkBenchmarkMetricColumn"/> per metric name.</summary>
+internal class GtkBenchmarkMetricsConfig : ManualConfig
+{
+    public GtkBenchmarkMetricsConfig(params string[] metrics)
+    {
+        foreach (var metric in metrics)
+            AddColumn(new GtkBenchmarkMetricColumn(metric));
+    }
+}
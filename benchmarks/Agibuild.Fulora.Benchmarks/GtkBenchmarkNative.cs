@@ -0,0 +1,52 @@
+using System.Runtime.InteropServices;
+
+namespace Agibuild.Fulora.Benchmarks;
+
+/// <summary>
+/// X11 and GLib entry points shared by the WebKitGTK benchmarks. The benchmark thread creates a
+/// plain X11 window to host the view and owns the default GLib main context, pumping it while
+/// asynchronous work is in flight.
+/// </summary>
+internal static partial class GtkBenchmarkNative
+{
+    private const string X11Lib = "libX11.so.6";
+    private const string GLibLib = "libglib-2.0.so.0";
+
+    [LibraryImport(X11Lib)]
+    public static partial IntPtr XOpenDisplay(IntPtr name);
+
+    [LibraryImport(X11Lib)]
+    public static partial ulong XDefaultRootWindow(IntPtr display);
+
+    [LibraryImport(X11Lib)]
+    public static partial ulong XCreateSimpleWindow(IntPtr display, ulong parent, int x, int y,
+        uint width, uint height, uint borderWidth, ulong border, ulong background);
+
+    [LibraryImport(X11Lib)]
+    public static partial int XMapWindow(IntPtr display, ulong window);
+
+    [LibraryImport(X11Lib)]
+    public static partial int XFlush(IntPtr display);
+
+    [LibraryImport(X11Lib)]
+    public static partial int XDestroyWindow(IntPtr display, ulong window);
+
+    [LibraryImport(X11Lib)]
+    public static partial int XCloseDisplay(IntPtr display);
+
+    [LibraryImport(GLibLib)]
+    [return: MarshalAs(UnmanagedType.I1)]
+    public static partial bool g_main_context_acquire(IntPtr context);
+
+    [LibraryImport(GLibLib)]
+    public static partial void g_main_context_release(IntPtr context);
+
+    [LibraryImport(GLibLib)]
+    [return: MarshalAs(UnmanagedType.I1)]
+    public static partial bool g_main_context_iteration(IntPtr context, [MarshalAs(UnmanagedType.I1)] bool mayBlock);
+}
+
+internal sealed record GtkBenchmarkX11Handle(nint Handle) : INativeHandle
+{
+    public string HandleDescriptor => "XID";
+}
@@ -0,0 +1,109 @@
+using Agibuild.Fulora.Adapters.Gtk;
+using BenchmarkDotNet.Attributes;
+using BenchmarkDotNet.Jobs;
+
+namespace Agibuild.Fulora.Benchmarks;
+
+/// <summary>
+/// Pulls a large serialized page model out of a WebKitGTK view as a string (NUL-terminated copy,
+/// then a .NET string) and as a stream over the shim's buffer. MemoryDiagnoser covers managed
+/// allocations; process peak RSS is reported in its own summary column. Linux only; needs an
+/// X11 display.
+/// </summary>
+[MemoryDiagnoser]
+[SimpleJob(RuntimeMoniker.Net90)]
+[Config(typeof(MetricsConfig))]
+public class GtkLargeScriptResultBenchmarks
+{
+    private const string PeakRssMetric = "Peak RSS MiB";
+
+    private GtkWebViewAdapter _adapter = null!;
+    private IntPtr _display;
+    private ulong _window;
+    private readonly byte[] _chunk = new byte[64 * 1024];
+
+    [Params(1, 50)]
+    public int SizeMb { get; set; }
+
+    [GlobalSetup]
+    public void Setup()
+    {
+        if (!OperatingSystem.IsLinux() || string.IsNullOrEmpty(Environment.GetEnvironmentVariable("DISPLAY")))
+            throw new PlatformNotSupportedException("GTK script result benchmarks need Linux with an X11 DISPLAY.");
+
+        _display = GtkBenchmarkNative.XOpenDisplay(IntPtr.Zero);
+        _window = GtkBenchmarkNative.XCreateSimpleWindow(_display, GtkBenchmarkNative.XDefaultRootWindow(_display), 0, 0, 800, 600, 0, 0, 0);
+        GtkBenchmarkNative.XMapWindow(_display, _window);
+        GtkBenchmarkNative.XFlush(_display);
+        GtkBenchmarkNative.g_main_context_acquire(IntPtr.Zero);
+
+        _adapter = new GtkWebViewAdapter();
+        _adapter.Initialize(new BenchmarkHost());
+        _adapter.Attach(new GtkBenchmarkX11Handle((nint)_window));
+
+        // A page model of roughly SizeMb megabytes of JSON, built once in the page.
+        Pump(_adapter.InvokeScriptAsync($$"""
+            (function() {
+                var rows = [];
+                var target = {{SizeMb}} * 1024 * 1024;
+                for (var i = 0, size = 0; size < target; i++) {
+                    var row = { id: i, name: 'item ' + i, tags: ['a', 'b', 'c'], value: i * 0.5 };
+                    rows.push(row);
+                    size += 64;
+                }
+                window.__model = rows;
+                return rows.length;
+            })()
+            """));
+    }
+
+    [Benchmark(Baseline = true, Description = "Script result as string")]
+    public int AsString()
+    {
+        var json = Pump(_adapter.InvokeScriptAsync("JSON.stringify(window.__model)"));
+        return json?.Length ?? 0;
+    }
+
+    [Benchmark(Description = "Script result as native-buffer stream")]
+    public long AsStream()
+    {
+        using var stream = Pump(_adapter.InvokeScriptStreamAsync("JSON.stringify(window.__model)"));
+        if (stream is null) return 0;
+
+        long total = 0;
+        int read;
+        while ((read = stream.Read(_chunk, 0, _chunk.Length)) > 0)
+            total += read;
+        return total;
+    }
+
+    [GlobalCleanup]
+    public void Cleanup()
+    {
+        var peak = File.ReadLines("/proc/self/status").FirstOrDefault(l => l.StartsWith("VmHWM:", StringComparison.Ordinal));
+        if (peak is not null && long.TryParse(peak["VmHWM:".Length..].Trim().Split(' ')[0], out var kb))
+            GtkBenchmarkMetrics.Report(this, PeakRssMetric, kb / 1024.0, $"SizeMb={SizeMb}");
+
+        _adapter.Detach();
+        GtkBenchmarkNative.g_main_context_release(IntPtr.Zero);
+        GtkBenchmarkNative.XDestroyWindow(_display, _window);
+        GtkBenchmarkNative.XCloseDisplay(_display);
+    }
+
+    private static T Pump<T>(Task<T> task)
+    {
+        while (!task.IsCompleted)
+            GtkBenchmarkNative.g_main_context_iteration(IntPtr.Zero, true);
+        return task.GetAwaiter().GetResult();
+    }
+
+    private sealed class MetricsConfig() : GtkBenchmarkMetricsConfig(PeakRssMetric);
+
+    private sealed class BenchmarkHost : IWebViewAdapterHost
+    {
+        public Guid ChannelId { get; } = Guid.NewGuid();
+
+        public ValueTask<NativeNavigationStartingDecision> OnNativeNavigationStartingAsync(NativeNavigationStartingInfo info)
+            => ValueTask.FromResult(new NativeNavigationStartingDecision(IsAllowed: true, NavigationId: Guid.NewGuid()));
+    }
+}
@@ -0,0 +1,122 @@
+using Agibuild.Fulora.Adapters.Gtk;
+using BenchmarkDotNet.Attributes;
+using BenchmarkDotNet.Jobs;
+
+namespace Agibuild.Fulora.Benchmarks;
+
+/// <summary>
+/// Round-trips typed bridge calls from page script through a real WebKitGTK view, with the
+/// script-message transport and with the web-extension transport, each with requests posted as
+/// messages or fetched from app://__rpc. Linux only; needs an X11 display, webkit2gtk-4.1
+/// (2.40+ for fetch) and the bridge extension built next to the shim.
+/// </summary>
+[MemoryDiagnoser]
+[SimpleJob(RuntimeMoniker.Net90)]
+public class GtkNativeBridgeBenchmarks
+{
+    private const int CallsPerRun = 200;
+
+    private WebViewCore _core = null!;
+    private GtkWebViewAdapter _adapter = null!;
+    private Testing.TestDispatcher _dispatcher = null!;
+    private BenchService _service = null!;
+    private IntPtr _display;
+    private ulong _window;
+
+    [Params(false, true)]
+    public bool NativeBridge { get; set; }
+
+    [Params(WebMessageBridgeTransport.PostMessage, WebMessageBridgeTransport.Fetch)]
+    public WebMessageBridgeTransport Transport { get; set; }
+
+    [JsExport]
+    public interface INativeBridgeBenchService
+    {
+        Task<int> Add(int a, int b);
+        Task Done();
+    }
+
+    private sealed class BenchService : INativeBridgeBenchService
+    {
+        public volatile bool Completed;
+
+        public Task<int> Add(int a, int b) => Task.FromResult(a + b);
+
+        public Task Done()
+        {
+            Completed = true;
+            return Task.CompletedTask;
+        }
+    }
+
+    [GlobalSetup]
+    public void Setup()
+    {
+        if (!OperatingSystem.IsLinux() || string.IsNullOrEmpty(Environment.GetEnvironmentVariable("DISPLAY")))
+            throw new PlatformNotSupportedException("GTK bridge benchmarks need Linux with an X11 DISPLAY.");
+
+        _display = GtkBenchmarkNative.XOpenDisplay(IntPtr.Zero);
+        _window = GtkBenchmarkNative.XCreateSimpleWindow(_display, GtkBenchmarkNative.XDefaultRootWindow(_display), 0, 0, 800, 600, 0, 0, 0);
+        GtkBenchmarkNative.XMapWindow(_display, _window);
+        GtkBenchmarkNative.XFlush(_display);
+        GtkBenchmarkNative.g_main_context_acquire(IntPtr.Zero);
+
+        _dispatcher = new Testing.TestDispatcher();
+        _adapter = new GtkWebViewAdapter();
+        _core = new WebViewCore(_adapter, _dispatcher);
+        _adapter.SetNativeBridgeEnabled(NativeBridge);
+        _core.Attach(new GtkBenchmarkX11Handle((nint)_window));
+
+        Pump(_core.NavigateToStringAsync("<!doctype html><html><body>bridge</body></html>"));
+
+        _service = new BenchService();
+        _core.EnableWebMessageBridge(new WebMessageBridgeOptions { Transport = Transport });
+        _core.Bridge.Expose<INativeBridgeBenchService>(_service);
+        _dispatcher.RunAll();
+
+        if (NativeBridge && !_adapter.IsNativeBridgeConnected)
+            throw new InvalidOperationException("The bridge web extension did not connect; is it installed next to the shim?");
+
+        // Warm up the JIT on both sides before measuring.
+        RoundTrips();
+    }
+
+    [Benchmark(Description = "GTK bridge: 200 sequential JS→C# calls", OperationsPerInvoke = CallsPerRun)]
+    public void RoundTrips()
+    {
+        _service.Completed = false;
+        _ = _core.InvokeScriptAsync($$"""
+            (async function() {
+                var rpc = window.agWebView.rpc;
+                for (var i = 0; i < {{CallsPerRun}}; i++)
+                    await rpc.invoke('NativeBridgeBenchService.Add', { a: i, b: 1 });
+                await rpc.invoke('NativeBridgeBenchService.Done', {});
+            })();
+            """);
+
+        while (!_service.Completed)
+        {
+            GtkBenchmarkNative.g_main_context_iteration(IntPtr.Zero, false);
+            _dispatcher.RunAll();
+        }
+    }
+
+    [GlobalCleanup]
+    public void Cleanup()
+    {
+        _core.Dispose();
+        GtkBenchmarkNative.g_main_context_release(IntPtr.Zero);
+        GtkBenchmarkNative.XDestroyWindow(_display, _window);
+        GtkBenchmarkNative.XCloseDisplay(_display);
+    }
+
+    private void Pump(Task task)
+    {
+        while (!task.IsCompleted)
+        {
+            GtkBenchmarkNative.g_main_context_iteration(IntPtr.Zero, false);
+            _dispatcher.RunAll();
+        }
+        task.GetAwaiter().GetResult();
+    }
+}
@@ -0,0 +1,127 @@
+using System.Diagnostics;
+using System.Runtime.InteropServices;
+using Agibuild.Fulora.Adapters.Gtk;
+using BenchmarkDotNet.Attributes;
+using BenchmarkDotNet.Jobs;
+
+namespace Agibuild.Fulora.Benchmarks;
+
+/// <summary>
+/// Time from a DOM change to the repainted frame, with the view embedded through the XEmbed plug
+/// and rendered offscreen into the shim's frame ring. The plug path waits for the second
+/// animation frame after the change; the offscreen path additionally waits until the frame has
+/// been copied into a host buffer. Process CPU time per update, and for the offscreen path the
+/// frames published and dropped, are reported in their own summary columns. Linux only; needs an
+/// X11 display.
+/// </summary>
+[SimpleJob(RuntimeMoniker.Net90)]
+[Config(typeof(MetricsConfig))]
+public class GtkOffscreenRenderingBenchmarks
+{
+    private const int Width = 800;
+    private const int Height = 600;
+    private const string CpuPerUpdateMetric = "CPU/update ms";
+    private const string FramesPublishedMetric = "Frames published";
+    private const string FramesDroppedMetric = "Frames dropped";
+
+    private GtkWebViewAdapter _adapter = null!;
+    private IntPtr _display;
+    private ulong _window;
+    private IntPtr _hostBuffer;
+    private int _updates;
+    private TimeSpan _cpuAtStart;
+
+    [Params(false, true)]
+    public bool Offscreen { get; set; }
+
+    [GlobalSetup]
+    public void Setup()
+    {
+        if (!OperatingSystem.IsLinux() || string.IsNullOrEmpty(Environment.GetEnvironmentVariable("DISPLAY")))
+            throw new PlatformNotSupportedException("GTK rendering benchmarks need Linux with an X11 DISPLAY.");
+
+        _display = GtkBenchmarkNative.XOpenDisplay(IntPtr.Zero);
+        _window = GtkBenchmarkNative.XCreateSimpleWindow(_display, GtkBenchmarkNative.XDefaultRootWindow(_display), 0, 0, Width, Height, 0, 0, 0);
+        GtkBenchmarkNative.XMapWindow(_display, _window);
+        GtkBenchmarkNative.XFlush(_display);
+        GtkBenchmarkNative.g_main_context_acquire(IntPtr.Zero);
+
+        _hostBuffer = Marshal.AllocHGlobal(Width * 4 * Height);
+        _adapter = new GtkWebViewAdapter();
+        _adapter.Initialize(new BenchmarkHost());
+        _adapter.SetOffscreenRendering(Offscreen, Width, Height);
+        _adapter.Attach(new GtkBenchmarkX11Handle((nint)_window));
+
+        Pump(_adapter.InvokeScriptAsync("""
+            document.body.innerHTML = '<div id="box" style="width:400px;height:300px"></div>';
+            window.__painted = 0;
+            window.__update = function(n) {
+                document.getElementById('box').style.background = n % 2 ? '#c03' : '#03c';
+                requestAnimationFrame(function() { requestAnimationFrame(function() { window.__painted = n; }); });
+            };
+            """));
+
+        _cpuAtStart = Process.GetCurrentProcess().TotalProcessorTime;
+    }
+
+    [Benchmark(Description = "DOM change to repainted frame")]
+    public void Update()
+    {
+        var n = ++_updates;
+        _ = _adapter.InvokeScriptAsync($"window.__update({n})");
+
+        while (Pump(_adapter.InvokeScriptAsync("String(window.__painted)")) != n.ToString(System.Globalization.CultureInfo.InvariantCulture))
+            GtkBenchmarkNative.g_main_context_iteration(IntPtr.Zero, false);
+
+        if (!Offscreen)
+            return;
+        while (!_adapter.TryCopyOffscreenFrame(_hostBuffer, Width * 4, Width, Height, out _))
+            GtkBenchmarkNative.g_main_context_iteration(IntPtr.Zero, true);
+    }
+
+    [GlobalCleanup]
+    public void Cleanup()
+    {
+        var cpu = Process.GetCurrentProcess().TotalProcessorTime - _cpuAtStart;
+        var perUpdate = _updates > 0 ? cpu.TotalMilliseconds / _updates : 0;
+        GtkBenchmarkMetrics.Report(this, CpuPerUpdateMetric, perUpdate, $"Offscreen={Offscreen}");
+        if (Offscreen)
+        {
+            var (published, dropped) = _adapter.GetOffscreenFrameStats();
+            GtkBenchmarkMetrics.Report(this, FramesPublishedMetric, published, $"Offscreen={Offscreen}");
+            GtkBenchmarkMetrics.Report(this, FramesDroppedMetric, dropped, $"Offscreen={Offscreen}");
+        }
+
+        _adapter.Detach();
+        Marshal.FreeHGlobal(_hostBuffer);
+        GtkBenchmarkNative.g_main_context_release(IntPtr.Zero);
+        GtkBenchmarkNative.XDestroyWindow(_display, _window);
+        GtkBenchmarkNative.XCloseDisplay(_display);
+    }
+
+    private static T Pump<T>(Task<T> task)
+    {
+        while (!task.IsCompleted)
+            GtkBenchmarkNative.g_main_context_iteration(IntPtr.Zero, true);
+        return task.GetAwaiter().GetResult();
+    }
+
+    private sealed class MetricsConfig : GtkBenchmarkMetricsConfig
+    {
+        public MetricsConfig()
+        {
+            AddColumn(
+                new GtkBenchmarkMetricColumn(CpuPerUpdateMetric, "N3"),
+                new GtkBenchmarkMetricColumn(FramesPublishedMetric, "N0"),
+                new GtkBenchmarkMetricColumn(FramesDroppedMetric, "N0"));
+        }
+    }
+
+    private sealed class BenchmarkHost : IWebViewAdapterHost
+    {
+        public Guid ChannelId { get; } = Guid.NewGuid();
+
+        public ValueTask<NativeNavigationStartingDecision> OnNativeNavigationStartingAsync(NativeNavigationStartingInfo info)
+            => ValueTask.FromResult(new NativeNavigationStartingDecision(IsAllowed: true, NavigationId: Guid.NewGuid()));
+    }
+}
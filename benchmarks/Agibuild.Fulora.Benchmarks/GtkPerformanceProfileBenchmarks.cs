@@ -0,0 +1,141 @@
+using System.Text;
+using Agibuild.Fulora.Adapters.Gtk;
+using BenchmarkDotNet.Attributes;
+using BenchmarkDotNet.Jobs;
+
+namespace Agibuild.Fulora.Benchmarks;
+
+/// <summary>
+/// Compares page-load time and process-tree memory between WebKitGTK performance profiles.
+/// Linux only; needs an X11 display (e.g. <c>xvfb-run</c>) and webkit2gtk-4.1. The benchmark
+/// thread owns the GLib main context and pumps it while a load is in flight. Process-tree RSS
+/// after the run is reported in its own summary column.
+/// </summary>
+[MemoryDiagnoser]
+[SimpleJob(RuntimeMoniker.Net90)]
+[Config(typeof(MetricsConfig))]
+public class GtkPerformanceProfileBenchmarks
+{
+    private const string TreeRssMetric = "Tree RSS MiB";
+
+    private GtkWebViewAdapter _adapter = null!;
+    private IntPtr _display;
+    private ulong _window;
+    private string _html = null!;
+
+    [Params("default", "low-memory", "throughput", "interactive")]
+    public string Profile { get; set; } = "default";
+
+    [GlobalSetup]
+    public void Setup()
+    {
+        if (!OperatingSystem.IsLinux() || string.IsNullOrEmpty(Environment.GetEnvironmentVariable("DISPLAY")))
+            throw new PlatformNotSupportedException("GTK profile benchmarks need Linux with an X11 DISPLAY.");
+
+        _display = GtkBenchmarkNative.XOpenDisplay(IntPtr.Zero);
+        _window = GtkBenchmarkNative.XCreateSimpleWindow(_display, GtkBenchmarkNative.XDefaultRootWindow(_display), 0, 0, 1024, 768, 0, 0, 0);
+        GtkBenchmarkNative.XMapWindow(_display, _window);
+        GtkBenchmarkNative.XFlush(_display);
+
+        // Own the default context so shim dispatches run inline on this thread.
+        GtkBenchmarkNative.g_main_context_acquire(IntPtr.Zero);
+
+        _adapter = new GtkWebViewAdapter();
+        _adapter.Initialize(new BenchmarkHost());
+        _adapter.SetPerformanceProfile(Profile switch
+        {
+            "low-memory" => GtkPerformanceProfile.LowMemory,
+            "throughput" => GtkPerformanceProfile.Throughput,
+            "interactive" => GtkPerformanceProfile.Interactive,
+            _ => GtkPerformanceProfile.Default,
+        });
+        _adapter.Attach(new GtkBenchmarkX11Handle((nint)_window));
+        _html = BuildPage();
+
+        // Warm up the web process so the first measured load does not include its spawn.
+        LoadPage();
+    }
+
+    [Benchmark]
+    public void LoadPage()
+    {
+        var completed = false;
+        void OnCompleted(object? sender, NavigationCompletedEventArgs e) => completed = true;
+
+        _adapter.NavigationCompleted += OnCompleted;
+        try
+        {
+            _adapter.NavigateToStringAsync(Guid.NewGuid(), _html);
+            while (!completed)
+                GtkBenchmarkNative.g_main_context_iteration(IntPtr.Zero, true);
+        }
+        finally
+        {
+            _adapter.NavigationCompleted -= OnCompleted;
+        }
+    }
+
+    [GlobalCleanup]
+    public void Cleanup()
+    {
+        GtkBenchmarkMetrics.Report(this, TreeRssMetric, ProcessTreeRssBytes() / (1024.0 * 1024), $"Profile={Profile}");
+
+        _adapter.Detach();
+        GtkBenchmarkNative.g_main_context_release(IntPtr.Zero);
+        GtkBenchmarkNative.XDestroyWindow(_display, _window);
+        GtkBenchmarkNative.XCloseDisplay(_display);
+    }
+
+    private static string BuildPage()
+    {
+        var sb = new StringBuilder("<!doctype html><html><head><style>.row{display:flex;gap:4px}</style></head><body>");
+        for (var i = 0; i < 2000; i++)
+            sb.Append("<div class=\"row\"><span>").Append(i).Append("</span><span>item ").Append(i).Append("</span></div>");
+        sb.Append("<script>let s=0;for(let i=0;i<2e6;i++){s+=i%7;}document.title=String(s);</script></body></html>");
+        return sb.ToString();
+    }
+
+    /// <summary>Resident memory of this process plus its WebKit helper processes.</summary>
+    private static long ProcessTreeRssBytes()
+    {
+        var root = Environment.ProcessId;
+        var parents = new Dictionary<int, int>();
+        foreach (var dir in Directory.EnumerateDirectories("/proc"))
+        {
+            if (!int.TryParse(Path.GetFileName(dir), out var pid)) continue;
+            try
+            {
+                // Field 4 of /proc/<pid>/stat is the parent pid; the comm field may contain spaces.
+                var stat = File.ReadAllText(Path.Combine(dir, "stat"));
+                var fields = stat[(stat.LastIndexOf(')') + 2)..].Split(' ');
+                parents[pid] = int.Parse(fields[1]);
+            }
+            catch (IOException) { }
+            catch (UnauthorizedAccessException) { }
+        }
+
+        long total = 0;
+        foreach (var (pid, _) in parents)
+        {
+            var p = pid;
+            while (p != root && parents.TryGetValue(p, out var parent) && parent > 1)
+                p = parent;
+            if (p != root) continue;
+
+            var status = File.ReadLines($"/proc/{pid}/status").FirstOrDefault(l => l.StartsWith("VmRSS:", StringComparison.Ordinal));
+            if (status is not null && long.TryParse(status.Split(' ', StringSplitOptions.RemoveEmptyEntries)[1], out var kb))
+                total += kb * 1024;
+        }
+        return total;
+    }
+
+    private sealed class MetricsConfig() : GtkBenchmarkMetricsConfig(TreeRssMetric);
+
+    private sealed class BenchmarkHost : IWebViewAdapterHost
+    {
+        public Guid ChannelId { get; } = Guid.NewGuid();
+
+        public ValueTask<NativeNavigationStartingDecision> OnNativeNavigationStartingAsync(NativeNavigationStartingInfo info)
+            => ValueTask.FromResult(new NativeNavigationStartingDecision(IsAllowed: true, NavigationId: Guid.NewGuid()));
+    }
+}
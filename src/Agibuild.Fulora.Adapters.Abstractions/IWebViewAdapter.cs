@@ -12,14 +12,20 @@ namespace Agibuild.Fulora.Adapters.Abstractions;
 // `adapter as IXxxAdapter` / null-propagation — capability negotiation has
 // been removed for the mandatory set.
 //
-// Two truly-optional facets are kept as standalone interfaces that are NOT
+// Four truly-optional facets are kept as standalone interfaces that are NOT
 // inherited by IWebViewAdapter:
 //   * IDragDropAdapter        — Android WebView exposes no native DnD APIs.
 //   * IAsyncPreloadScriptAdapter — An opt-in async refinement of
 //                                  IPreloadScriptAdapter, only Windows offers it
 //                                  today because WebView2 exposes an async
 //                                  AddScriptToExecuteOnDocumentCreatedAsync.
-// Those two remain negotiated through AdapterCapabilities.
+//   * IFetchBridgeAdapter     — Serving bridge RPC over a custom-scheme fetch
+//                                  needs request bodies from the engine;
+//                                  only WebKitGTK 2.40+ wires that up today.
+//   * IHostVisibilityAdapter  — Throttling a page nobody can see is only
+//                                  worth doing where the engine leaves it
+//                                  running; GTK is the one adapter that does.
+// Those four remain negotiated through AdapterCapabilities.
 // ---------------------------------------------------------------------------
 
 internal interface ICookieAdapter
@@ -200,3 +206,483 @@ internal interface IDragDropAdapter
     event EventHandler<EventArgs>? DragLeft;
     event EventHandler<DropEventArgs>? DropCompleted;
 }
+
+/// <summary>
+/// Truly-optional fetch transport for the RPC bridge. Page script POSTs JSON-RPC
+/// requests to <c>app://__rpc/&lt;service&gt;/&lt;method&gt;</c> and reads the
+/// response from the HTTP body, so a call needs no <c>postMessage</c> hop and no
+/// response script evaluation. Negotiated via <c>AdapterCapabilities.FetchBridge</c>.
+/// </summary>
+internal interface IFetchBridgeAdapter
+{
+    /// <summary>Scheme of the fetch bridge endpoint.</summary>
+    const string Scheme = "app";
+
+    /// <summary>Host of the fetch bridge endpoint.</summary>
+    const string Host = "__rpc";
+
+    /// <summary>
+    /// Routes fetch bridge requests to <paramref name="handler"/>, or stops routing them when
+    /// <see langword="null"/>. Returns <see langword="false"/> when the engine cannot serve them.
+    /// </summary>
+    bool SetFetchBridgeHandler(FetchBridgeRequestHandler? handler);
+}
+
+/// <summary>
+/// Serves one fetch bridge request. Called off the UI thread with the request body and the
+/// page's <c>Origin</c>; returns the JSON-RPC response, or <see langword="null"/> to refuse it.
+/// </summary>
+internal delegate Task<string?> FetchBridgeRequestHandler(string body, string origin, CancellationToken cancellationToken);
+
+/// <summary>
+/// Truly-optional serving of host memory to the page by URL, so large payloads reach page
+/// script through <c>fetch()</c> instead of base64 in a message. Negotiated via
+/// <c>AdapterCapabilities.BlobPublishing</c>.
+/// </summary>
+internal interface IBlobPublishingAdapter
+{
+    /// <summary>
+    /// Serves <paramref name="data"/> without copying and returns the same-origin path it is
+    /// served at. The memory must not change until <paramref name="owner"/> is disposed, which
+    /// happens once the blob is revoked and no response is reading from it. Throws
+    /// <see cref="ArgumentException"/> when the id is already published.
+    /// </summary>
+    string PublishBlob(string id, ReadOnlyMemory<byte> data, string? mimeType, IDisposable? owner);
+
+    /// <summary>Stops serving the blob. Returns <see langword="false"/> when no blob has that id.</summary>
+    bool RevokeBlob(string id);
+}
+
+/// <summary>Which page stub entry point an RPC envelope is delivered to.</summary>
+internal enum RpcDeliveryKind
+{
+    /// <summary>A C# → JS request or notification, passed to <c>rpc._dispatch</c>.</summary>
+    Dispatch,
+
+    /// <summary>The response to a JS → C# request, passed to <c>rpc._onResponse</c>.</summary>
+    Response,
+}
+
+/// <summary>
+/// Truly-optional direct channel into the page stub. An adapter with one hands RPC envelopes to
+/// the stub without compiling and evaluating a delivery script. Negotiated via
+/// <c>AdapterCapabilities.RpcDelivery</c>.
+/// </summary>
+internal interface IRpcDeliveryAdapter
+{
+    /// <summary>
+    /// Called on the UI thread to deliver <paramref name="json"/>. Returns <see langword="false"/>
+    /// when the channel is not available right now; the runtime then evaluates the delivery script.
+    /// </summary>
+    bool TryDeliverRpc(RpcDeliveryKind kind, string json);
+}
+
+/// <summary>
+/// Truly-optional notification that the hosting control stopped or started being shown, so the
+/// adapter can throttle or suspend a page nobody can see. Negotiated via
+/// <c>AdapterCapabilities.HostVisibility</c>.
+/// </summary>
+internal interface IHostVisibilityAdapter
+{
+    /// <summary>Called on the UI thread whenever the effective visibility of the host changes.</summary>
+    void SetHostVisible(bool visible);
+}
+
+/// <summary>
+/// Truly-optional compiled content-blocker rule lists, enforced by the engine for navigations
+/// and subresources alike. Negotiated via <c>AdapterCapabilities.ContentFilters</c>.
+/// </summary>
+internal interface IContentFilterAdapter
+{
+    /// <summary>
+    /// Loads the compiled form of <paramref name="rulesJson"/> from the adapter's store, compiling
+    /// and persisting it on a miss, and applies it to the view under <paramref name="identifier"/>.
+    /// Loading again under the same identifier replaces the previous rules.
+    /// </summary>
+    Task<ContentFilterResult> LoadOrCompileContentFilterAsync(string identifier, string rulesJson);
+
+    /// <summary>Detaches a previously loaded content filter from the view.</summary>
+    void RemoveContentFilter(string identifier);
+}
+
+/// <summary>
+/// Outcome of loading (or compiling on a cache miss) a content-blocker rule list.
+/// </summary>
+/// <param name="Identifier">Logical identifier supplied by the caller.</param>
+/// <param name="RuleCount">Number of rules in the source rule list.</param>
+/// <param name="FromCache">True when the compiled form was loaded from the on-disk store.</param>
+/// <param name="Elapsed">Native load/compile time.</param>
+internal sealed record ContentFilterResult(string Identifier, int RuleCount, bool FromCache, TimeSpan Elapsed);
+
+/// <summary>
+/// Truly-optional named sets of user scripts and style sheets defined once per process and
+/// attached to any number of views, so a large preload bundle is held once rather than copied
+/// into every view. Negotiated via <c>AdapterCapabilities.SharedContentSets</c>.
+/// </summary>
+internal interface ISharedContentSetAdapter
+{
+    /// <summary>
+    /// Defines or atomically replaces the process-wide set <paramref name="name"/>. Views that
+    /// already have the set attached pick up the new contents for their next document.
+    /// </summary>
+    void DefineSharedContentSet(string name, IReadOnlyList<string> scripts, IReadOnlyList<string>? styleSheets,
+        SharedContentSetOptions options);
+
+    /// <summary>Removes the set from every view it is attached to and releases it.</summary>
+    void DestroySharedContentSet(string name);
+
+    /// <summary>Attaches a defined set to the view. Throws when no set has that name.</summary>
+    void AttachSharedContentSet(string name);
+
+    /// <summary>Detaches the set from the view, if attached.</summary>
+    void DetachSharedContentSet(string name);
+}
+
+/// <summary>Injection options for a shared content set.</summary>
+[Flags]
+internal enum SharedContentSetOptions : uint
+{
+    /// <summary>Inject into every frame at document start.</summary>
+    None = 0,
+
+    /// <summary>Inject into the top-level frame only instead of all frames.</summary>
+    TopFrameOnly = 0x1,
+
+    /// <summary>Run scripts at document end instead of document start.</summary>
+    InjectAtDocumentEnd = 0x2,
+}
+
+/// <summary>
+/// Truly-optional per-origin website data accounting, so hosts can keep caches warm while trimming
+/// origins that grow past a budget. Negotiated via <c>AdapterCapabilities.WebsiteData</c>.
+/// </summary>
+internal interface IWebsiteDataAdapter
+{
+    /// <summary>Fetches per-origin usage for the requested data categories.</summary>
+    Task<IReadOnlyList<WebsiteDataUsage>> FetchWebsiteDataUsageAsync(WebsiteDataTypes types);
+
+    /// <summary>
+    /// Removes the given data categories for <paramref name="origins"/> (as reported by
+    /// <see cref="FetchWebsiteDataUsageAsync"/>), or for every origin when <see langword="null"/>.
+    /// </summary>
+    Task RemoveWebsiteDataAsync(WebsiteDataTypes types, IReadOnlyCollection<string>? origins);
+}
+
+/// <summary>Website data categories; the bits follow WebKit's <c>WebKitWebsiteDataTypes</c>.</summary>
+[Flags]
+internal enum WebsiteDataTypes : uint
+{
+    None = 0,
+    MemoryCache = 1u << 0,
+    DiskCache = 1u << 1,
+    OfflineApplicationCache = 1u << 2,
+    SessionStorage = 1u << 3,
+    LocalStorage = 1u << 4,
+    IndexedDbDatabases = 1u << 6,
+    Cookies = 1u << 8,
+    DeviceIdHashSalt = 1u << 9,
+    HstsCache = 1u << 10,
+    Itp = 1u << 11,
+    ServiceWorkerRegistrations = 1u << 12,
+    DomCache = 1u << 13,
+    All = (1u << 14) - 1,
+}
+
+/// <summary>Website data stored for one origin.</summary>
+/// <param name="Origin">The origin (host name) the engine groups the data under.</param>
+/// <param name="Types">Categories of data present for the origin.</param>
+/// <param name="Sizes">Bytes used per category, for the categories the engine can size.</param>
+internal sealed record WebsiteDataUsage(
+    string Origin,
+    WebsiteDataTypes Types,
+    IReadOnlyDictionary<WebsiteDataTypes, long> Sizes)
+{
+    /// <summary>Total bytes across all sized categories.</summary>
+    public long TotalSize => Sizes.Values.Sum();
+}
+
+/// <summary>
+/// Truly-optional speculative loading: resolving host names and loading likely next pages ahead
+/// of navigation so they come from warm connections and cache. Negotiated via
+/// <c>AdapterCapabilities.SpeculativeLoading</c>.
+/// </summary>
+internal interface ISpeculativeLoadingAdapter
+{
+    /// <summary>Resolves <paramref name="hostname"/> ahead of the first request to it.</summary>
+    void PrefetchDns(string hostname);
+
+    /// <summary>
+    /// Replaces the preload queue with <paramref name="uris"/>. URIs the adapter cannot preload
+    /// are skipped.
+    /// </summary>
+    void PreloadUris(IReadOnlyList<Uri> uris);
+
+    /// <summary>Returns cumulative preload outcomes for the view.</summary>
+    PreloadStats GetPreloadStats();
+}
+
+/// <summary>Cumulative speculative-preload outcomes for one view.</summary>
+/// <param name="Hits">Navigations to a URL that had finished preloading.</param>
+/// <param name="Misses">Navigations, after preloading was first requested, to a URL that had not.</param>
+/// <param name="Wasted">Preloaded URLs evicted before any navigation used them.</param>
+internal readonly record struct PreloadStats(ulong Hits, ulong Misses, ulong Wasted);
+
+/// <summary>
+/// Truly-optional recording of the view's resource loads, exported as HAR so slow requests can be
+/// inspected in standard tooling. Negotiated via <c>AdapterCapabilities.ResourceTiming</c>.
+/// </summary>
+internal interface IResourceTimingAdapter
+{
+    /// <summary>
+    /// Starts or stops recording. <paramref name="capacity"/> bounds the number of completed loads
+    /// kept (0 selects the adapter default); changing it discards what was recorded.
+    /// </summary>
+    void SetResourceTimingEnabled(bool enabled, int capacity);
+
+    /// <summary>Discards the recorded loads.</summary>
+    void ClearResourceTimings();
+
+    /// <summary>Exports the recorded loads, oldest first, as HAR 1.2 JSON.</summary>
+    string ExportResourceTimingsAsHar();
+}
+
+/// <summary>
+/// Truly-optional limits on concurrent script evaluation, so a storm of script calls cannot pile
+/// up unbounded work in a busy page. Negotiated via <c>AdapterCapabilities.ScriptEvaluationLimits</c>.
+/// </summary>
+internal interface IScriptEvaluationLimitsAdapter
+{
+    /// <summary>
+    /// Runs at most <paramref name="maxInFlight"/> evaluations at once (0 = unlimited) with up to
+    /// <paramref name="maxQueued"/> waiting; further requests fail immediately. A
+    /// <paramref name="timeout"/> bounds queueing plus execution of requests issued afterwards.
+    /// </summary>
+    void ConfigureScriptEvaluation(int maxInFlight, int maxQueued, TimeSpan? timeout);
+}
+
+/// <summary>
+/// Truly-optional streaming of large script results straight from the engine's buffer, so
+/// multi-megabyte results are not copied into a string. Negotiated via
+/// <c>AdapterCapabilities.ScriptStreaming</c>.
+/// </summary>
+internal interface IScriptStreamingAdapter
+{
+    /// <summary>
+    /// Evaluates <paramref name="script"/> and returns its string conversion as a read-only UTF-8
+    /// stream, or <see langword="null"/> for <c>null</c>/<c>undefined</c>. Disposing the stream
+    /// releases the buffer.
+    /// </summary>
+    Task<Stream?> InvokeScriptStreamAsync(string script, CancellationToken cancellationToken);
+
+    /// <summary>
+    /// String results of at least <paramref name="thresholdBytes"/> UTF-8 bytes (0 = never) are
+    /// decoded from the engine's buffer instead of a NUL-terminated copy.
+    /// </summary>
+    void SetScriptResultBufferThreshold(long thresholdBytes);
+}
+
+/// <summary>
+/// Truly-optional offscreen composition: the view renders into frames the host draws itself
+/// instead of a native child window, and the host forwards input back. Negotiated via
+/// <c>AdapterCapabilities.OffscreenRendering</c>; frames flow only while the adapter was
+/// configured to render offscreen before attach.
+/// </summary>
+internal interface IOffscreenRenderingAdapter
+{
+    /// <summary>Whether the view renders offscreen rather than into a native child window.</summary>
+    bool IsOffscreenRendering { get; }
+
+    /// <summary>
+    /// Raised on the adapter's UI thread when a new frame is ready for
+    /// <see cref="TryCopyOffscreenFrame"/>. The argument is the frame's sequence number.
+    /// </summary>
+    event EventHandler<ulong>? OffscreenFrameReady;
+
+    /// <summary>Resizes the view, in pixels; the next frame is copied in full.</summary>
+    void ResizeOffscreen(int width, int height);
+
+    /// <summary>
+    /// Copies the newest unseen frame into <paramref name="destination"/>, a BGRA premultiplied
+    /// buffer that keeps the previous frame between calls: only the area changed since the
+    /// previous copy is written, unless the destination size differs from the frame. Any thread;
+    /// <see langword="false"/> when no new frame is available.
+    /// </summary>
+    bool TryCopyOffscreenFrame(IntPtr destination, int destinationStride, int destinationWidth, int destinationHeight,
+        out OffscreenFrameCopy copy);
+
+    /// <summary>Forwards one input event to the view. <see langword="false"/> when it was not delivered.</summary>
+    bool SendOffscreenInput(in OffscreenInput input);
+}
+
+/// <summary>Input forwarded to an offscreen view.</summary>
+internal enum OffscreenInputKind
+{
+    Motion = 0,
+    ButtonPress = 1,
+    ButtonRelease = 2,
+    Scroll = 3,
+    KeyPress = 4,
+    KeyRelease = 5,
+    FocusIn = 6,
+    FocusOut = 7,
+}
+
+/// <summary>Modifier and button state of an input event; the bits follow GDK's <c>GdkModifierType</c>.</summary>
+[Flags]
+internal enum OffscreenInputModifiers : uint
+{
+    None = 0,
+    Shift = 1 << 0,
+    Lock = 1 << 1,
+    Control = 1 << 2,
+    Alt = 1 << 3,
+    Button1 = 1 << 8,
+    Button2 = 1 << 9,
+    Button3 = 1 << 10,
+    Super = 1 << 26,
+}
+
+/// <summary>One input event for an offscreen view, in view pixels.</summary>
+/// <param name="Kind">What happened.</param>
+/// <param name="X">Pointer position for pointer events.</param>
+/// <param name="Y">Pointer position for pointer events.</param>
+/// <param name="DeltaX">Smooth scroll delta, in scroll steps.</param>
+/// <param name="DeltaY">Smooth scroll delta, in scroll steps.</param>
+/// <param name="Button">Button number (1 = primary, 2 = middle, 3 = secondary).</param>
+/// <param name="KeyVal">X keysym for key events.</param>
+/// <param name="Modifiers">Modifier and button state at the time of the event.</param>
+/// <param name="TimestampMs">Event time in milliseconds, as reported to the page.</param>
+internal readonly record struct OffscreenInput(
+    OffscreenInputKind Kind,
+    double X = 0,
+    double Y = 0,
+    double DeltaX = 0,
+    double DeltaY = 0,
+    uint Button = 0,
+    uint KeyVal = 0,
+    OffscreenInputModifiers Modifiers = OffscreenInputModifiers.None,
+    uint TimestampMs = 0);
+
+/// <summary>Result of copying an offscreen frame into a host buffer.</summary>
+/// <param name="Sequence">Frame sequence number; increases with every published frame.</param>
+/// <param name="Width">Frame width in pixels.</param>
+/// <param name="Height">Frame height in pixels.</param>
+/// <param name="DirtyX">Left of the area that was copied.</param>
+/// <param name="DirtyY">Top of the area that was copied.</param>
+/// <param name="DirtyWidth">Width of the area that was copied.</param>
+/// <param name="DirtyHeight">Height of the area that was copied.</param>
+/// <param name="Latency">From the oldest damage first shown in this frame to the copy.</param>
+internal readonly record struct OffscreenFrameCopy(
+    ulong Sequence,
+    int Width,
+    int Height,
+    int DirtyX,
+    int DirtyY,
+    int DirtyWidth,
+    int DirtyHeight,
+    TimeSpan Latency);
+
+/// <summary>
+/// Truly-optional download management beyond <see cref="IDownloadAdapter"/>: destinations chosen
+/// asynchronously, coalesced progress, completion and cancellation by id. Negotiated via
+/// <c>AdapterCapabilities.DownloadManagement</c>.
+/// </summary>
+internal interface IDownloadManagementAdapter
+{
+    /// <summary>
+    /// Chooses the destination of downloads that <see cref="IDownloadAdapter.DownloadRequested"/>
+    /// handlers left undecided. Returning <see langword="null"/> cancels the download, which waits
+    /// until the task completes.
+    /// </summary>
+    Func<WebViewDownload, CancellationToken, ValueTask<string?>>? DownloadDestinationResolver { get; set; }
+
+    /// <summary>Raised on the adapter's UI thread at most once per progress interval per download.</summary>
+    event EventHandler<WebViewDownloadProgress>? DownloadProgressChanged;
+
+    /// <summary>Raised on the adapter's UI thread when a download completed, failed or was cancelled.</summary>
+    event EventHandler<WebViewDownloadResult>? DownloadCompleted;
+
+    /// <summary>Minimum time between two progress reports for the same download.</summary>
+    void SetDownloadProgressInterval(TimeSpan interval);
+
+    /// <summary>Cancels a running download; <see langword="false"/> when the id is unknown or already finished.</summary>
+    bool CancelDownload(ulong downloadId);
+}
+
+/// <summary>How a download ended.</summary>
+internal enum WebViewDownloadStatus
+{
+    Completed = 0,
+    Failed = 1,
+    Cancelled = 2,
+}
+
+/// <summary>A download the view started, as offered to the destination resolver.</summary>
+/// <param name="Id">Download id, valid until the download finishes.</param>
+/// <param name="Uri">The downloaded URI.</param>
+/// <param name="SuggestedFileName">File name suggested by the server or the URI, if any.</param>
+/// <param name="ContentType">MIME type of the response, if known.</param>
+/// <param name="ContentLength">Expected size in bytes, if known.</param>
+internal sealed record WebViewDownload(ulong Id, Uri Uri, string? SuggestedFileName, string? ContentType, long? ContentLength);
+
+/// <summary>Progress of a running download, coalesced to the configured progress interval.</summary>
+/// <param name="Id">Download id.</param>
+/// <param name="ReceivedBytes">Bytes written to the destination so far.</param>
+/// <param name="TotalBytes">Expected size in bytes, if known.</param>
+/// <param name="BytesPerSecond">Average rate since the download started.</param>
+internal readonly record struct WebViewDownloadProgress(ulong Id, long ReceivedBytes, long? TotalBytes, double BytesPerSecond);
+
+/// <summary>Final state of a download.</summary>
+/// <param name="Id">Download id.</param>
+/// <param name="Status">How the download ended.</param>
+/// <param name="Path">Destination file of a completed download.</param>
+/// <param name="ReceivedBytes">Bytes received in total.</param>
+/// <param name="Error">The engine's error message for failed and cancelled downloads.</param>
+internal sealed record WebViewDownloadResult(ulong Id, WebViewDownloadStatus Status, string? Path, long ReceivedBytes, string? Error);
+
+/// <summary>
+/// Truly-optional report of how much work the view is allowed to do while the host shows or
+/// hides it (see <see cref="IHostVisibilityAdapter"/>). Negotiated via
+/// <c>AdapterCapabilities.ActivityState</c>.
+/// </summary>
+internal interface IActivityStateAdapter
+{
+    /// <summary>The current state.</summary>
+    WebViewActivityState ActivityState { get; }
+
+    /// <summary>Raised on the UI thread after the activity state changed.</summary>
+    event EventHandler<WebViewActivityState>? ActivityStateChanged;
+
+    /// <summary>How long a hidden view stays throttled before it is suspended; <see langword="null"/> never suspends.</summary>
+    TimeSpan? SuspendAfterHidden { get; set; }
+}
+
+/// <summary>How much work a view is allowed to do.</summary>
+internal enum WebViewActivityState
+{
+    /// <summary>Shown and running normally.</summary>
+    Active = 0,
+
+    /// <summary>Hidden: the page sees <c>visibilitychange</c>, stops painting and has its timers throttled.</summary>
+    Throttled = 1,
+
+    /// <summary>Throttled and muted. Hibernation, where supported, is the next step down.</summary>
+    Suspended = 2,
+}
+
+/// <summary>
+/// Truly-optional capture of the whole document rather than the viewport, in bounded memory.
+/// Negotiated via <c>AdapterCapabilities.FullPageCapture</c>.
+/// </summary>
+internal interface IFullPageCaptureAdapter
+{
+    /// <summary>
+    /// Writes the whole document as one PNG to <paramref name="destination"/>, which is left open.
+    /// <paramref name="progress"/> reports the fraction of rows captured. A failed or cancelled
+    /// capture may leave a partial image in the stream.
+    /// </summary>
+    Task<FullPageCaptureResult> CaptureFullPageAsync(Stream destination, IProgress<double>? progress, CancellationToken cancellationToken);
+}
+
+/// <summary>Size of a finished full-document capture, in device pixels.</summary>
+internal sealed record FullPageCaptureResult(int Width, int Height, int Tiles);
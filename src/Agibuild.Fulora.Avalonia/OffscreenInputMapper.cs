@@ -0,0 +1,94 @@
+using Agibuild.Fulora.Adapters.Abstractions;
+using Avalonia.Input;
+
+namespace Agibuild.Fulora;
+
+/// <summary>
+/// Translates Avalonia input into the X keysyms, buttons and modifier bits an offscreen view expects.
+/// </summary>
+internal static class OffscreenInputMapper
+{
+    // Keysym for a Unicode code point outside Latin-1 (X11 keysymdef.h).
+    private const uint UnicodeKeySymFlag = 0x01000000;
+
+    public static uint ToKeyVal(Key key, string? keySymbol)
+    {
+        var named = key switch
+        {
+            Key.Enter => 0xff0du,
+            Key.Back => 0xff08u,
+            Key.Tab => 0xff09u,
+            Key.Escape => 0xff1bu,
+            Key.Delete => 0xffffu,
+            Key.Insert => 0xff63u,
+            Key.Home => 0xff50u,
+            Key.Left => 0xff51u,
+            Key.Up => 0xff52u,
+            Key.Right => 0xff53u,
+            Key.Down => 0xff54u,
+            Key.PageUp => 0xff55u,
+            Key.PageDown => 0xff56u,
+            Key.End => 0xff57u,
+            Key.LeftShift => 0xffe1u,
+            Key.RightShift => 0xffe2u,
+            Key.LeftCtrl => 0xffe3u,
+            Key.RightCtrl => 0xffe4u,
+            Key.LeftAlt => 0xffe9u,
+            Key.RightAlt => 0xffeau,
+            Key.LWin => 0xffebu,
+            Key.RWin => 0xffecu,
+            >= Key.F1 and <= Key.F12 => 0xffbeu + (uint)(key - Key.F1),
+            _ => 0u,
+        };
+        if (named != 0)
+            return named;
+
+        // The produced character carries the layout and shift state.
+        if (!string.IsNullOrEmpty(keySymbol)
+            && System.Text.Rune.DecodeFromUtf16(keySymbol, out var rune, out var consumed) == System.Buffers.OperationStatus.Done
+            && consumed == keySymbol.Length
+            && rune.Value >= 0x20 && rune.Value != 0x7f)
+        {
+            return rune.Value < 0x100 ? (uint)rune.Value : UnicodeKeySymFlag | (uint)rune.Value;
+        }
+
+        return key switch
+        {
+            Key.Space => 0x20u,
+            >= Key.A and <= Key.Z => 'a' + (uint)(key - Key.A),
+            >= Key.D0 and <= Key.D9 => '0' + (uint)(key - Key.D0),
+            _ => 0u,
+        };
+    }
+
+    public static uint ToButton(PointerUpdateKind kind) => kind switch
+    {
+        PointerUpdateKind.LeftButtonPressed or PointerUpdateKind.LeftButtonReleased => 1,
+        PointerUpdateKind.MiddleButtonPressed or PointerUpdateKind.MiddleButtonReleased => 2,
+        PointerUpdateKind.RightButtonPressed or PointerUpdateKind.RightButtonReleased => 3,
+        PointerUpdateKind.XButton1Pressed or PointerUpdateKind.XButton1Released => 8,
+        PointerUpdateKind.XButton2Pressed or PointerUpdateKind.XButton2Released => 9,
+        _ => 0,
+    };
+
+    public static OffscreenInputModifiers ToModifiers(KeyModifiers modifiers)
+    {
+        var result = OffscreenInputModifiers.None;
+        if (modifiers.HasFlag(KeyModifiers.Shift)) result |= OffscreenInputModifiers.Shift;
+        if (modifiers.HasFlag(KeyModifiers.Control)) result |= OffscreenInputModifiers.Control;
+        if (modifiers.HasFlag(KeyModifiers.Alt)) result |= OffscreenInputModifiers.Alt;
+        if (modifiers.HasFlag(KeyModifiers.Meta)) result |= OffscreenInputModifiers.Super;
+        return result;
+    }
+
+    public static OffscreenInputModifiers ToModifiers(KeyModifiers modifiers, PointerPointProperties pointer)
+    {
+        var result = ToModifiers(modifiers);
+        if (pointer.IsLeftButtonPressed) result |= OffscreenInputModifiers.Button1;
+        if (pointer.IsMiddleButtonPressed) result |= OffscreenInputModifiers.Button2;
+        if (pointer.IsRightButtonPressed) result |= OffscreenInputModifiers.Button3;
+        return result;
+    }
+
+    public static uint Timestamp() => unchecked((uint)Environment.TickCount64);
+}
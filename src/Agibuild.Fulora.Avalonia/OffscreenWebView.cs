@@ -0,0 +1,350 @@
+using Agibuild.Fulora.Adapters.Abstractions;
+using Avalonia;
+using Avalonia.Controls;
+using Avalonia.Input;
+using Avalonia.Media;
+using Avalonia.Media.Imaging;
+using Avalonia.Platform;
+using Avalonia.Threading;
+using Microsoft.Extensions.Logging;
+using Microsoft.Extensions.Logging.Abstractions;
+
+namespace Agibuild.Fulora;
+
+/// <summary>
+/// An Avalonia control that draws a WebView rendered offscreen, so Avalonia content can overlap,
+/// clip and transform it like any other control. Only platforms that render offscreen show a
+/// page (currently Linux/WebKitGTK); elsewhere the control stays empty and <see cref="Browser"/>
+/// is <see langword="null"/>.
+/// <para>
+/// Usage in XAML:
+/// <code>&lt;agw:OffscreenWebView Source="https://example.com" /&gt;</code>
+/// </para>
+/// </summary>
+public sealed class OffscreenWebView : Control, IDisposable
+{
+    /// <summary>
+    /// Styled property backing <see cref="Source"/>.
+    /// </summary>
+    public static readonly StyledProperty<Uri?> SourceProperty =
+        AvaloniaProperty.Register<OffscreenWebView, Uri?>(nameof(Source));
+
+    private WebViewCore? _core;
+    private IOffscreenRenderingAdapter? _offscreen;
+    private WriteableBitmap? _frame;
+    private PixelSize _viewSize;
+    private int _copyQueued;
+
+    static OffscreenWebView()
+    {
+        SourceProperty.Changed.AddClassHandler<OffscreenWebView>((view, e) => view.OnSourceChanged(e));
+        FocusableProperty.OverrideDefaultValue<OffscreenWebView>(true);
+        ClipToBoundsProperty.OverrideDefaultValue<OffscreenWebView>(true);
+    }
+
+    /// <summary>
+    /// The page to show. Navigates as soon as the view is attached.
+    /// </summary>
+    public Uri? Source
+    {
+        get => GetValue(SourceProperty);
+        set => SetValue(SourceProperty, value);
+    }
+
+    /// <summary>
+    /// Environment options for the view, read when it attaches. Offscreen rendering is always on;
+    /// <see langword="null"/> uses <see cref="WebViewEnvironment.Options"/>.
+    /// </summary>
+    public IWebViewEnvironmentOptions? EnvironmentOptions { get; set; }
+
+    /// <summary>
+    /// Logger factory for the view; <see langword="null"/> uses <see cref="WebViewEnvironment.LoggerFactory"/>.
+    /// </summary>
+    public ILoggerFactory? LoggerFactory { get; set; }
+
+    /// <summary>
+    /// The attached view, for navigation, scripts and the bridge; <see langword="null"/> while
+    /// detached from the visual tree or when the platform cannot render offscreen.
+    /// </summary>
+    public IWebView? Browser => _offscreen is null ? null : _core;
+
+    /// <inheritdoc />
+    protected override void OnAttachedToVisualTree(VisualTreeAttachmentEventArgs e)
+    {
+        base.OnAttachedToVisualTree(e);
+        AttachCore();
+    }
+
+    /// <inheritdoc />
+    protected override void OnDetachedFromVisualTree(VisualTreeAttachmentEventArgs e)
+    {
+        DestroyCore();
+        base.OnDetachedFromVisualTree(e);
+    }
+
+    /// <inheritdoc />
+    protected override void OnSizeChanged(SizeChangedEventArgs e)
+    {
+        base.OnSizeChanged(e);
+        ResizeView();
+    }
+
+    /// <inheritdoc />
+    protected override void OnPropertyChanged(AvaloniaPropertyChangedEventArgs change)
+    {
+        base.OnPropertyChanged(change);
+        if (change.Property == IsFocusedProperty)
+        {
+            var kind = IsFocused ? OffscreenInputKind.FocusIn : OffscreenInputKind.FocusOut;
+            Send(new OffscreenInput(kind, TimestampMs: OffscreenInputMapper.Timestamp()));
+        }
+        else if (change.Property == IsVisibleProperty)
+        {
+            _core?.SetHostVisible(IsEffectivelyVisible);
+        }
+    }
+
+    /// <inheritdoc />
+    public override void Render(DrawingContext context)
+    {
+        if (_frame is null)
+            return;
+        context.DrawImage(_frame, new Rect(_frame.Size), new Rect(Bounds.Size));
+    }
+
+    // ---------------------------------------------------------------------------
+    //  Input
+    // ---------------------------------------------------------------------------
+
+    /// <inheritdoc />
+    protected override void OnPointerMoved(PointerEventArgs e)
+    {
+        base.OnPointerMoved(e);
+        var point = e.GetCurrentPoint(this);
+        e.Handled |= SendPointer(OffscreenInputKind.Motion, point, e.KeyModifiers, button: 0);
+    }
+
+    /// <inheritdoc />
+    protected override void OnPointerPressed(PointerPressedEventArgs e)
+    {
+        base.OnPointerPressed(e);
+        var point = e.GetCurrentPoint(this);
+        Focus();
+        e.Pointer.Capture(this);
+        e.Handled |= SendPointer(OffscreenInputKind.ButtonPress, point, e.KeyModifiers,
+            OffscreenInputMapper.ToButton(point.Properties.PointerUpdateKind));
+    }
+
+    /// <inheritdoc />
+    protected override void OnPointerReleased(PointerReleasedEventArgs e)
+    {
+        base.OnPointerReleased(e);
+        var point = e.GetCurrentPoint(this);
+        e.Handled |= SendPointer(OffscreenInputKind.ButtonRelease, point, e.KeyModifiers,
+            OffscreenInputMapper.ToButton(point.Properties.PointerUpdateKind));
+    }
+
+    /// <inheritdoc />
+    protected override void OnPointerWheelChanged(PointerWheelEventArgs e)
+    {
+        base.OnPointerWheelChanged(e);
+        var point = e.GetCurrentPoint(this);
+        var scale = Scaling();
+        // Avalonia's wheel delta is positive away from the user; GDK's is positive towards the end.
+        e.Handled |= Send(new OffscreenInput(
+            OffscreenInputKind.Scroll,
+            point.Position.X * scale,
+            point.Position.Y * scale,
+            DeltaX: -e.Delta.X,
+            DeltaY: -e.Delta.Y,
+            Modifiers: OffscreenInputMapper.ToModifiers(e.KeyModifiers, point.Properties),
+            TimestampMs: OffscreenInputMapper.Timestamp()));
+    }
+
+    /// <inheritdoc />
+    protected override void OnKeyDown(KeyEventArgs e)
+    {
+        base.OnKeyDown(e);
+        e.Handled |= SendKey(OffscreenInputKind.KeyPress, e);
+    }
+
+    /// <inheritdoc />
+    protected override void OnKeyUp(KeyEventArgs e)
+    {
+        base.OnKeyUp(e);
+        e.Handled |= SendKey(OffscreenInputKind.KeyRelease, e);
+    }
+
+    private bool SendPointer(OffscreenInputKind kind, PointerPoint point, KeyModifiers modifiers, uint button)
+    {
+        var scale = Scaling();
+        return Send(new OffscreenInput(
+            kind,
+            point.Position.X * scale,
+            point.Position.Y * scale,
+            Button: button,
+            Modifiers: OffscreenInputMapper.ToModifiers(modifiers, point.Properties),
+            TimestampMs: OffscreenInputMapper.Timestamp()));
+    }
+
+    private bool SendKey(OffscreenInputKind kind, KeyEventArgs e)
+    {
+        var keyVal = OffscreenInputMapper.ToKeyVal(e.Key, e.KeySymbol);
+        return keyVal != 0 && Send(new OffscreenInput(
+            kind,
+            KeyVal: keyVal,
+            Modifiers: OffscreenInputMapper.ToModifiers(e.KeyModifiers),
+            TimestampMs: OffscreenInputMapper.Timestamp()));
+    }
+
+    private bool Send(in OffscreenInput input) => _offscreen?.SendOffscreenInput(input) ?? false;
+
+    // ---------------------------------------------------------------------------
+    //  Lifecycle and frames
+    // ---------------------------------------------------------------------------
+
+    private void AttachCore()
+    {
+        if (_core is not null)
+            return;
+
+        var loggerFactory = LoggerFactory ?? WebViewEnvironment.LoggerFactory;
+        var logger = loggerFactory?.CreateLogger<WebViewCore>()
+                     ?? (ILogger<WebViewCore>)NullLogger<WebViewCore>.Instance;
+        var options = new OffscreenEnvironmentOptions(EnvironmentOptions ?? WebViewEnvironment.Options);
+
+        WebViewCore? core = null;
+        try
+        {
+            core = WebViewCore.CreateForControl(new SynchronizationContextWebViewDispatcher(), logger, options);
+            core.Attach(OffscreenParentHandle.Instance);
+        }
+        catch (PlatformNotSupportedException)
+        {
+            core?.Dispose();
+            return;
+        }
+
+        _core = core;
+        _offscreen = core.OffscreenRendering;
+        if (_offscreen is null)
+        {
+            // The adapter ignored the option and draws into a native window nobody hosts.
+            DestroyCore();
+            return;
+        }
+
+        _offscreen.OffscreenFrameReady += OnOffscreenFrameReady;
+        core.SetHostVisible(IsEffectivelyVisible);
+        ResizeView();
+
+        if (Source is { } source)
+            _ = core.NavigateAsync(source);
+    }
+
+    private void DestroyCore()
+    {
+        if (_offscreen is not null)
+            _offscreen.OffscreenFrameReady -= OnOffscreenFrameReady;
+        _offscreen = null;
+
+        var core = _core;
+        _core = null;
+        if (core is not null)
+        {
+            core.Detach();
+            core.Dispose();
+        }
+
+        _frame?.Dispose();
+        _frame = null;
+        _viewSize = default;
+    }
+
+    private void OnSourceChanged(AvaloniaPropertyChangedEventArgs e)
+    {
+        if (_offscreen is not null && _core is not null && e.NewValue is Uri uri)
+            _ = _core.NavigateAsync(uri);
+    }
+
+    private void ResizeView()
+    {
+        if (_offscreen is null)
+            return;
+
+        var size = PixelSize.FromSize(Bounds.Size, Scaling());
+        if (size.Width <= 0 || size.Height <= 0 || size == _viewSize)
+            return;
+
+        _viewSize = size;
+        _offscreen.ResizeOffscreen(size.Width, size.Height);
+    }
+
+    // Raised on the adapter's thread; frames that arrive before the UI thread copies the last one
+    // are picked up by that copy, since the adapter always hands out the newest frame.
+    private void OnOffscreenFrameReady(object? sender, ulong sequence)
+    {
+        if (Interlocked.Exchange(ref _copyQueued, 1) == 0)
+            Dispatcher.UIThread.Post(CopyFrame, DispatcherPriority.Render);
+    }
+
+    private void CopyFrame()
+    {
+        Volatile.Write(ref _copyQueued, 0);
+        if (_offscreen is null || _viewSize.Width <= 0 || _viewSize.Height <= 0)
+            return;
+
+        if (_frame is null || _frame.PixelSize != _viewSize)
+        {
+            _frame?.Dispose();
+            _frame = new WriteableBitmap(_viewSize, new Vector(96, 96) * Scaling(), PixelFormat.Bgra8888, AlphaFormat.Premul);
+        }
+
+        bool copied;
+        using (var buffer = _frame.Lock())
+        {
+            copied = _offscreen.TryCopyOffscreenFrame(buffer.Address, buffer.RowBytes,
+                buffer.Size.Width, buffer.Size.Height, out _);
+        }
+
+        if (copied)
+            InvalidateVisual();
+    }
+
+    private double Scaling() => TopLevel.GetTopLevel(this)?.RenderScaling ?? 1.0;
+
+    /// <summary>
+    /// Detaches and disposes the underlying view.
+    /// </summary>
+    public void Dispose() => DestroyCore();
+
+    // An offscreen view has no parent window; adapters that render offscreen accept a null handle.
+    private sealed class OffscreenParentHandle : INativeHandle
+    {
+        public static readonly OffscreenParentHandle Instance = new();
+
+        public nint Handle => IntPtr.Zero;
+        public string HandleDescriptor => string.Empty;
+    }
+
+    // Forwards the caller's options with offscreen rendering forced on.
+    private sealed class OffscreenEnvironmentOptions(IWebViewEnvironmentOptions inner) : IWebViewEnvironmentOptions
+    {
+        public bool EnableDevTools { get => inner.EnableDevTools; set => inner.EnableDevTools = value; }
+        public string? CustomUserAgent { get => inner.CustomUserAgent; set => inner.CustomUserAgent = value; }
+        public bool UseEphemeralSession { get => inner.UseEphemeralSession; set => inner.UseEphemeralSession = value; }
+        public bool TransparentBackground { get => inner.TransparentBackground; set => inner.TransparentBackground = value; }
+        public string? ContentFilterStorePath { get => inner.ContentFilterStorePath; set => inner.ContentFilterStorePath = value; }
+        public string? WebsiteDataDirectory { get => inner.WebsiteDataDirectory; set => inner.WebsiteDataDirectory = value; }
+        public string? WebsiteCacheDirectory { get => inner.WebsiteCacheDirectory; set => inner.WebsiteCacheDirectory = value; }
+        public WebViewCacheModel? CacheModel { get => inner.CacheModel; set => inner.CacheModel = value; }
+        public WebViewPerformanceProfile PerformanceProfile { get => inner.PerformanceProfile; set => inner.PerformanceProfile = value; }
+        public long? HibernationMemoryBudgetBytes { get => inner.HibernationMemoryBudgetBytes; set => inner.HibernationMemoryBudgetBytes = value; }
+        public bool EnableCrashRecovery { get => inner.EnableCrashRecovery; set => inner.EnableCrashRecovery = value; }
+        public TimeSpan? TerminateUnresponsiveWebProcessAfter { get => inner.TerminateUnresponsiveWebProcessAfter; set => inner.TerminateUnresponsiveWebProcessAfter = value; }
+        public bool EnableNativeBridge { get => inner.EnableNativeBridge; set => inner.EnableNativeBridge = value; }
+        public bool OffscreenRendering { get => true; set { } }
+        public IReadOnlyList<CustomSchemeRegistration> CustomSchemes => inner.CustomSchemes;
+        public IReadOnlyList<string> PreloadScripts => inner.PreloadScripts;
+    }
+}
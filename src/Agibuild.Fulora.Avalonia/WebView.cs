@@ -80,6 +80,7 @@ public class WebView : NativeControlHost, ISpaHostingWebView
         SourceProperty.Changed.AddClassHandler<WebView>((wv, e) => wv.OnSourceChanged(e));
         ZoomFactorProperty.Changed.AddClassHandler<WebView>((wv, e) => wv.OnZoomFactorChanged(e));
         OverlayContentProperty.Changed.AddClassHandler<WebView>((wv, e) => wv.OnOverlayContentChanged(e));
+        IsVisibleProperty.Changed.AddClassHandler<WebView>((wv, _) => wv.ReportHostVisibility());
     }
 
     /// <summary>
@@ -549,6 +550,8 @@ public class WebView : NativeControlHost, ISpaHostingWebView
         base.OnAttachedToVisualTree(e);
         _hostClosingRuntime.RefreshHook();
         _overlayRuntime.AttachVisualHooks();
+        LayoutUpdated += OnLayoutUpdatedReportVisibility;
+        ReportHostVisibility();
     }
 
     /// <summary>
@@ -556,9 +559,11 @@ public class WebView : NativeControlHost, ISpaHostingWebView
     /// </summary>
     protected override void OnDetachedFromVisualTree(VisualTreeAttachmentEventArgs e)
     {
+        LayoutUpdated -= OnLayoutUpdatedReportVisibility;
         _overlayRuntime.DetachVisualHooks();
         _hostClosingRuntime.Unhook();
         base.OnDetachedFromVisualTree(e);
+        ReportHostVisibility();
     }
 
     /// <summary>
@@ -573,6 +578,7 @@ public class WebView : NativeControlHost, ISpaHostingWebView
         if (_controlRuntime.IsCoreAttached)
             _hostClosingRuntime.RefreshHook();
 
+        ReportHostVisibility();
         return handle;
     }
 
@@ -602,6 +608,15 @@ public class WebView : NativeControlHost, ISpaHostingWebView
     private void OnOverlayContentChanged(AvaloniaPropertyChangedEventArgs e)
         => _overlayRuntime.UpdateOverlayContent(e.NewValue);
 
+    // Hiding an ancestor changes IsEffectivelyVisible without raising IsVisible on this control,
+    // but it always runs a layout pass, so every pass reports again.
+    private void OnLayoutUpdatedReportVisibility(object? sender, EventArgs e)
+        => ReportHostVisibility();
+
+    // Lets adapters throttle a page nobody can see; the core ignores repeats.
+    private void ReportHostVisibility()
+        => _controlRuntime.Core?.SetHostVisible(IsEffectivelyVisible && VisualRoot is not null);
+
     // Internal test seam for lifecycle wiring assertions without private reflection.
     internal void TestOnlyAttachCore(WebViewCore core)
     {
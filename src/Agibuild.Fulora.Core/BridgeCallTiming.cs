@@ -0,0 +1,98 @@
+namespace Agibuild.Fulora;
+
+/// <summary>
+/// Phase names of a <see cref="BridgeCallTiming"/>, used as span names and metric tags.
+/// </summary>
+public static class BridgeCallPhases
+{
+    /// <summary>Page-side serialization and posting of the request.</summary>
+    public const string PageSerialize = "page.serialize";
+
+    /// <summary>Engine IPC and the host event loop until the adapter sees the request.</summary>
+    public const string RequestTransit = "request.transit";
+
+    /// <summary>Adapter receipt until the RPC service dispatches the request on the UI thread.</summary>
+    public const string HostQueue = "host.queue";
+
+    /// <summary>Handler execution and response serialization.</summary>
+    public const string HostHandler = "host.handler";
+
+    /// <summary>Response delivery into the page (script evaluation or HTTP body) until the stub sees it.</summary>
+    public const string ResponseTransit = "response.transit";
+
+    /// <summary>The whole round trip as the page saw it.</summary>
+    public const string Total = "total";
+}
+
+/// <summary>
+/// End-to-end timestamps of one JS → C# bridge call, joined by call id from the page's clock
+/// (<c>performance.timeOrigin + performance.now()</c>) and the host's system clock.
+/// <see cref="Phases"/> moves the page timestamps onto the host clock by
+/// <paramref name="ClockOffset"/>, so the two transit phases are measured on one clock.
+/// </summary>
+/// <param name="CallId">JSON-RPC request id.</param>
+/// <param name="ServiceName">The service name.</param>
+/// <param name="MethodName">The method name.</param>
+/// <param name="Transport">The request transport: <c>"message"</c> or <c>"fetch"</c>.</param>
+/// <param name="PageInvoked">When page script called <c>rpc.invoke</c>.</param>
+/// <param name="PageSent">When the serialized request was handed to the transport.</param>
+/// <param name="HostReceived">When the adapter raised the message (or fetch request).</param>
+/// <param name="HostDispatched">When the RPC service started dispatching it.</param>
+/// <param name="HostResponded">When the response was serialized and handed back.</param>
+/// <param name="PageReceived">When the page stub received the response.</param>
+/// <param name="IsError">Whether the call ended in an error response.</param>
+/// <param name="ClockOffset">
+/// Estimated host clock minus page clock. The collector uses the NTP estimate
+/// <c>((HostReceived - PageSent) + (HostResponded - PageReceived)) / 2</c> from the call with the
+/// smallest round trip seen for the page, so it is off by at most half that round trip and
+/// unequal request and response transits show up as such. Zero when the clocks are assumed to agree.
+/// </param>
+public sealed record BridgeCallTiming(
+    string CallId,
+    string ServiceName,
+    string MethodName,
+    string Transport,
+    DateTimeOffset PageInvoked,
+    DateTimeOffset PageSent,
+    DateTimeOffset HostReceived,
+    DateTimeOffset HostDispatched,
+    DateTimeOffset HostResponded,
+    DateTimeOffset PageReceived,
+    bool IsError,
+    TimeSpan ClockOffset = default)
+{
+    /// <summary>
+    /// Each phase with its start (on the host clock) and duration, in call order, ending with
+    /// <see cref="BridgeCallPhases.Total"/>. A negative transit means <see cref="ClockOffset"/>
+    /// no longer matches the clocks.
+    /// </summary>
+    public IReadOnlyList<(string Phase, DateTimeOffset Start, TimeSpan Duration)> Phases
+    {
+        get
+        {
+            var invoked = PageInvoked + ClockOffset;
+            var sent = PageSent + ClockOffset;
+            var received = PageReceived + ClockOffset;
+            return
+            [
+                (BridgeCallPhases.PageSerialize, invoked, sent - invoked),
+                (BridgeCallPhases.RequestTransit, sent, HostReceived - sent),
+                (BridgeCallPhases.HostQueue, HostReceived, HostDispatched - HostReceived),
+                (BridgeCallPhases.HostHandler, HostDispatched, HostResponded - HostDispatched),
+                (BridgeCallPhases.ResponseTransit, HostResponded, received - HostResponded),
+                (BridgeCallPhases.Total, invoked, received - invoked),
+            ];
+        }
+    }
+}
+
+/// <summary>
+/// Optional facet of <see cref="IBridgeTracer"/>. When the configured tracer implements it, the
+/// page stub timestamps each JS → C# call and reports back, and the tracer receives one
+/// <see cref="BridgeCallTiming"/> per completed call.
+/// </summary>
+public interface IBridgeCallTimingSink
+{
+    /// <summary>Called once the page has reported a call's receipt of its response.</summary>
+    void OnCallTiming(BridgeCallTiming timing);
+}
@@ -31,6 +31,47 @@ public sealed record DragDropPayload
     public string? Html { get; init; }
     /// <summary>URI content, if any.</summary>
     public string? Uri { get; init; }
+
+    /// <summary>
+    /// Set by platforms that deliver only file paths with the drop; looks up MIME type and size
+    /// of one of <see cref="Files"/> off the UI thread. The platform caches each lookup with the
+    /// payload, so asking again is cheap.
+    /// </summary>
+    internal Func<FileDropInfo, CancellationToken, Task<FileDropInfo>>? FileInfoResolver { get; init; }
+
+    /// <summary>
+    /// Returns <see cref="Files"/>[<paramref name="index"/>] with <see cref="FileDropInfo.MimeType"/>
+    /// and <see cref="FileDropInfo.Size"/> filled in when the platform can describe it, looking up
+    /// only that file.
+    /// </summary>
+    public Task<FileDropInfo> GetFileInfoAsync(int index, CancellationToken cancellationToken = default)
+    {
+        var files = Files ?? [];
+        ArgumentOutOfRangeException.ThrowIfNegative(index);
+        ArgumentOutOfRangeException.ThrowIfGreaterThanOrEqual(index, files.Count);
+
+        return FileInfoResolver is { } resolver
+            ? resolver(files[index], cancellationToken)
+            : Task.FromResult(files[index]);
+    }
+
+    /// <summary>
+    /// Returns this payload with <see cref="FileDropInfo.MimeType"/> and <see cref="FileDropInfo.Size"/>
+    /// filled in for every file the platform can describe. Platforms that report them with the
+    /// drop return the payload unchanged.
+    /// </summary>
+    public async Task<DragDropPayload> WithFileInfoAsync(CancellationToken cancellationToken = default)
+    {
+        if (FileInfoResolver is not { } resolver || Files is not { Count: > 0 } files)
+            return this;
+
+        var lookups = new Task<FileDropInfo>[files.Count];
+        for (var i = 0; i < files.Count; i++)
+            lookups[i] = resolver(files[i], cancellationToken);
+
+        var resolved = await Task.WhenAll(lookups).ConfigureAwait(false);
+        return this with { Files = resolved, FileInfoResolver = null };
+    }
 }
 
 /// <summary>
@@ -42,6 +42,8 @@ public static class FuloraErrorCodes
 
     /// <summary>Script execution failed.</summary>
     public const string ScriptError = "SCRIPT_ERROR";
+    /// <summary>The web content process terminated while the operation was in flight.</summary>
+    public const string WebProcessTerminated = "WEB_PROCESS_TERMINATED";
 
     /// <summary>RPC invocation failed.</summary>
     public const string RpcError = "RPC_ERROR";
@@ -72,4 +72,33 @@ public enum PermissionState
     Deny
 }
 
+/// <summary>How much memory and disk the engine may spend on caching pages and resources.</summary>
+public enum WebViewCacheModel
+{
+    /// <summary>No memory or disk cache.</summary>
+    DocumentViewer = 0,
+
+    /// <summary>Large caches, for apps that revisit many pages.</summary>
+    WebBrowser = 1,
+
+    /// <summary>Moderate caches, for apps that mostly show local or single-origin content.</summary>
+    DocumentBrowser = 2,
+}
+
+/// <summary>Preset trade-off between memory use and rendering and loading speed.</summary>
+public enum WebViewPerformanceProfile
+{
+    /// <summary>Keeps every engine default.</summary>
+    Default,
+
+    /// <summary>Smallest footprint for low-end devices: software rendering, no page cache.</summary>
+    LowMemory,
+
+    /// <summary>Fastest page loads and script execution; animations are not smoothed.</summary>
+    Throughput,
+
+    /// <summary>Throughput plus smooth scrolling, for touch and pointer-heavy UIs.</summary>
+    Interactive,
+}
+
 #pragma warning restore CS1591
@@ -134,6 +134,16 @@ public interface IWebViewEnvironmentOptions
     string? CustomUserAgent { get; set; }
     bool UseEphemeralSession { get; set; }
     bool TransparentBackground { get => false; set { } }
+    string? ContentFilterStorePath { get => null; set { } }
+    string? WebsiteDataDirectory { get => null; set { } }
+    string? WebsiteCacheDirectory { get => null; set { } }
+    WebViewCacheModel? CacheModel { get => null; set { } }
+    WebViewPerformanceProfile PerformanceProfile { get => WebViewPerformanceProfile.Default; set { } }
+    long? HibernationMemoryBudgetBytes { get => null; set { } }
+    bool EnableCrashRecovery { get => false; set { } }
+    TimeSpan? TerminateUnresponsiveWebProcessAfter { get => null; set { } }
+    bool EnableNativeBridge { get => false; set { } }
+    bool OffscreenRendering { get => false; set { } }
     IReadOnlyList<CustomSchemeRegistration> CustomSchemes { get; }
     IReadOnlyList<string> PreloadScripts { get; }
 }
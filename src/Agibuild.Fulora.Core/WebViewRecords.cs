@@ -212,6 +212,9 @@ public sealed class WebMessageReceivedEventArgs : EventArgs
     public string Origin { get; }
     public Guid ChannelId { get; }
     public int ProtocolVersion { get; }
+
+    /// <summary>When the adapter raised the message; the host-receipt time of bridge call timing.</summary>
+    public DateTimeOffset ReceivedAt { get; } = DateTimeOffset.UtcNow;
 }
 
 public sealed class WebResourceRequestedEventArgs : EventArgs
@@ -399,6 +402,32 @@ public class WebViewScriptException : FuloraException
     }
 }
 
+/// <summary>Why the web content process backing a WebView terminated.</summary>
+public enum WebViewProcessTerminationReason
+{
+    /// <summary>The process crashed.</summary>
+    Crashed = 0,
+    /// <summary>The process was killed for exceeding its memory limit.</summary>
+    ExceededMemoryLimit = 1,
+    /// <summary>The process was terminated on request of the application.</summary>
+    TerminatedByApi = 2,
+}
+
+/// <summary>
+/// Faults operations that were in flight when the web content process terminated.
+/// </summary>
+public class WebViewProcessTerminatedException : FuloraException
+{
+    public WebViewProcessTerminatedException(WebViewProcessTerminationReason reason)
+        : base(FuloraErrorCodes.WebProcessTerminated, $"The web content process terminated ({reason}).")
+    {
+        Reason = reason;
+    }
+
+    /// <summary>Why the process terminated.</summary>
+    public WebViewProcessTerminationReason Reason { get; }
+}
+
 public class WebViewRpcException : FuloraException
 {
     public WebViewRpcException(int code, string message)
@@ -0,0 +1,99 @@
+using System.Diagnostics.Metrics;
+
+namespace Agibuild.Fulora.Adapters.Gtk;
+
+/// <summary>
+/// Metrics emitted by the WebKitGTK adapter and its native shim.
+/// Collect them by subscribing to <see cref="MeterName"/> (e.g. OpenTelemetry <c>AddMeter</c>).
+/// </summary>
+internal static class GtkAdapterMetrics
+{
+    /// <summary>Meter name for WebKitGTK adapter metrics.</summary>
+    internal const string MeterName = "Agibuild.Fulora.Gtk";
+
+    private static readonly Meter s_meter = new(MeterName);
+
+    internal static readonly Histogram<double> ContentFilterLoadMs =
+        s_meter.CreateHistogram<double>("fulora.gtk.content_filter.load_ms");
+
+    internal static readonly Histogram<long> ContentFilterRuleCount =
+        s_meter.CreateHistogram<long>("fulora.gtk.content_filter.rules");
+
+    internal static readonly Counter<long> DragMotionDelivered =
+        s_meter.CreateCounter<long>("fulora.gtk.drag.motion_delivered");
+
+    internal static readonly Counter<long> DragMotionSuppressed =
+        s_meter.CreateCounter<long>("fulora.gtk.drag.motion_suppressed");
+
+    internal static readonly Counter<long> PreloadHits =
+        s_meter.CreateCounter<long>("fulora.gtk.preload.hits");
+
+    internal static readonly Counter<long> PreloadMisses =
+        s_meter.CreateCounter<long>("fulora.gtk.preload.misses");
+
+    internal static readonly Counter<long> PreloadWasted =
+        s_meter.CreateCounter<long>("fulora.gtk.preload.wasted");
+
+    internal static readonly Counter<long> HibernationHibernated =
+        s_meter.CreateCounter<long>("fulora.gtk.hibernation.hibernated");
+
+    internal static readonly Counter<long> HibernationResumed =
+        s_meter.CreateCounter<long>("fulora.gtk.hibernation.resumed");
+
+    internal static readonly Counter<long> ActivityStateChanges =
+        s_meter.CreateCounter<long>("fulora.gtk.activity.changes");
+
+    internal static readonly Counter<long> WebProcessTerminations =
+        s_meter.CreateCounter<long>("fulora.gtk.web_process.terminations");
+
+    internal static readonly Histogram<double> WebProcessRecoveryMs =
+        s_meter.CreateHistogram<double>("fulora.gtk.web_process.recovery_ms");
+
+    internal static readonly Histogram<double> WebProcessHangMs =
+        s_meter.CreateHistogram<double>("fulora.gtk.web_process.hang_ms");
+
+    internal static readonly Histogram<double> NavigationPolicyWaitMs =
+        s_meter.CreateHistogram<double>("fulora.gtk.navigation.policy_wait_ms");
+
+    internal static readonly Histogram<double> NavigationServerMs =
+        s_meter.CreateHistogram<double>("fulora.gtk.navigation.server_ms");
+
+    internal static readonly Histogram<double> NavigationRenderMs =
+        s_meter.CreateHistogram<double>("fulora.gtk.navigation.render_ms");
+
+    internal static readonly Histogram<double> NavigationTotalMs =
+        s_meter.CreateHistogram<double>("fulora.gtk.navigation.total_ms");
+
+    internal static readonly Counter<long> NavigationRedirects =
+        s_meter.CreateCounter<long>("fulora.gtk.navigation.redirects");
+
+    internal static readonly UpDownCounter<long> ScriptsInFlight =
+        s_meter.CreateUpDownCounter<long>("fulora.gtk.script.in_flight");
+
+    internal static readonly Histogram<double> ScriptQueueWaitMs =
+        s_meter.CreateHistogram<double>("fulora.gtk.script.queue_wait_ms");
+
+    internal static readonly Histogram<double> ScriptRunMs =
+        s_meter.CreateHistogram<double>("fulora.gtk.script.run_ms");
+
+    internal static readonly Counter<long> ScriptsRejected =
+        s_meter.CreateCounter<long>("fulora.gtk.script.rejected");
+
+    internal static readonly Counter<long> BridgeNativeDeliveries =
+        s_meter.CreateCounter<long>("fulora.gtk.bridge.native_deliveries");
+
+    internal static readonly UpDownCounter<long> PublishedBlobBytes =
+        s_meter.CreateUpDownCounter<long>("fulora.gtk.blob.bytes");
+
+    internal static readonly Histogram<double> OffscreenFrameLatencyMs =
+        s_meter.CreateHistogram<double>("fulora.gtk.offscreen.frame_latency_ms");
+
+    internal static readonly Histogram<double> OffscreenFrameCopyMs =
+        s_meter.CreateHistogram<double>("fulora.gtk.offscreen.frame_copy_ms");
+
+    internal static readonly Counter<long> DownloadBytes =
+        s_meter.CreateCounter<long>("fulora.gtk.download.bytes");
+
+    internal static readonly Histogram<double> DownloadBytesPerSecond =
+        s_meter.CreateHistogram<double>("fulora.gtk.download.bytes_per_second");
+}
@@ -0,0 +1,6 @@
+namespace Agibuild.Fulora.Adapters.Gtk;
+
+/// <summary>Cumulative drag-over update counts for one WebKitGTK view.</summary>
+/// <param name="Delivered">Updates forwarded to managed code.</param>
+/// <param name="Suppressed">Motion events dropped because a newer position superseded them within the same frame/interval.</param>
+internal readonly record struct GtkDragMotionStats(ulong Delivered, ulong Suppressed);
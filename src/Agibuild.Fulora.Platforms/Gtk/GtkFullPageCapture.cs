@@ -0,0 +1,50 @@
+namespace Agibuild.Fulora.Adapters.Gtk;
+
+/// <summary>How full-document tiles are handed out (mirrors AG_GTK_TILE_RAW/PNG).</summary>
+internal enum GtkTileEncoding
+{
+    /// <summary>Premultiplied BGRA rows (cairo ARGB32) with <see cref="GtkScreenshotTile.Stride"/> bytes each.</summary>
+    Raw = 0,
+
+    /// <summary>Each tile is a complete PNG file.</summary>
+    Png = 1,
+}
+
+/// <summary>Tiling of a full-document capture.</summary>
+internal sealed record GtkFullPageCaptureOptions
+{
+    /// <summary>Rows per tile in device pixels; 0 uses the viewport height, which is also the upper bound.</summary>
+    public int TileHeight { get; init; }
+
+    /// <summary>Tiles are made shorter until one fits in this many bytes of raw pixels; 0 = no limit.</summary>
+    public long MaxTileBytes { get; init; } = 16L * 1024 * 1024;
+
+    public GtkTileEncoding Encoding { get; init; } = GtkTileEncoding.Png;
+}
+
+/// <summary>One tile of a full-document capture. <see cref="Data"/> is only valid during the callback.</summary>
+internal readonly ref struct GtkScreenshotTile(
+    int index, int y, int width, int height, int totalHeight, int stride, GtkTileEncoding encoding, ReadOnlySpan<byte> data)
+{
+    public int Index { get; } = index;
+
+    /// <summary>First document row of the tile, in device pixels.</summary>
+    public int Y { get; } = y;
+
+    public int Width { get; } = width;
+
+    public int Height { get; } = height;
+
+    /// <summary>Document height in device pixels, fixed when the capture starts.</summary>
+    public int TotalHeight { get; } = totalHeight;
+
+    /// <summary>Bytes per row of a raw tile; 0 for encoded tiles.</summary>
+    public int Stride { get; } = stride;
+
+    public GtkTileEncoding Encoding { get; } = encoding;
+
+    public ReadOnlySpan<byte> Data { get; } = data;
+}
+
+/// <summary>Receives tiles in document order on the GTK thread.</summary>
+internal delegate void GtkScreenshotTileHandler(in GtkScreenshotTile tile);
@@ -0,0 +1,100 @@
+using System.Globalization;
+using System.Text;
+using System.Text.Json;
+
+namespace Agibuild.Fulora.Adapters.Gtk;
+
+/// <summary>
+/// Writes recorded resource loads as an HTTP Archive (HAR 1.2) log. Only what the shim records
+/// is filled in; headers, cookies and connection phases are left empty or -1 as the format allows.
+/// Custom-scheme handler time is exported as the <c>_handlerMs</c> custom field.
+/// </summary>
+internal static class GtkHarWriter
+{
+    internal static string Write(IReadOnlyList<GtkResourceTiming> entries, string creatorName, string creatorVersion)
+    {
+        ArgumentNullException.ThrowIfNull(entries);
+
+        using var buffer = new MemoryStream();
+        using (var w = new Utf8JsonWriter(buffer, new JsonWriterOptions { Indented = true }))
+        {
+            w.WriteStartObject();
+            w.WriteStartObject("log");
+            w.WriteString("version", "1.2");
+            w.WriteStartObject("creator");
+            w.WriteString("name", creatorName);
+            w.WriteString("version", creatorVersion);
+            w.WriteEndObject();
+
+            w.WriteStartArray("entries");
+            foreach (var e in entries)
+                WriteEntry(w, e);
+            w.WriteEndArray();
+
+            w.WriteEndObject();
+            w.WriteEndObject();
+        }
+        return Encoding.UTF8.GetString(buffer.GetBuffer(), 0, (int)buffer.Length);
+    }
+
+    private static void WriteEntry(Utf8JsonWriter w, GtkResourceTiming e)
+    {
+        w.WriteStartObject();
+        w.WriteString("startedDateTime", e.StartedAt.ToString("yyyy-MM-ddTHH:mm:ss.fffzzz", CultureInfo.InvariantCulture));
+        w.WriteNumber("time", Milliseconds(e.Total));
+
+        w.WriteStartObject("request");
+        w.WriteString("method", e.Method);
+        w.WriteString("url", e.Url);
+        w.WriteString("httpVersion", "");
+        WriteEmptyArray(w, "cookies");
+        WriteEmptyArray(w, "headers");
+        WriteEmptyArray(w, "queryString");
+        w.WriteNumber("headersSize", -1);
+        w.WriteNumber("bodySize", -1);
+        w.WriteEndObject();
+
+        w.WriteStartObject("response");
+        w.WriteNumber("status", e.Status);
+        w.WriteString("statusText", "");
+        w.WriteString("httpVersion", "");
+        WriteEmptyArray(w, "cookies");
+        WriteEmptyArray(w, "headers");
+        w.WriteStartObject("content");
+        w.WriteNumber("size", e.Size ?? -1);
+        w.WriteString("mimeType", e.MimeType ?? "");
+        w.WriteEndObject();
+        w.WriteString("redirectURL", "");
+        w.WriteNumber("headersSize", -1);
+        w.WriteNumber("bodySize", e.Size ?? -1);
+        w.WriteEndObject();
+
+        w.WriteStartObject("cache");
+        w.WriteEndObject();
+
+        // Without a response the whole duration is reported as wait.
+        w.WriteStartObject("timings");
+        w.WriteNumber("blocked", -1);
+        w.WriteNumber("dns", -1);
+        w.WriteNumber("connect", -1);
+        w.WriteNumber("ssl", -1);
+        w.WriteNumber("send", 0);
+        w.WriteNumber("wait", Milliseconds(e.Wait ?? e.Total));
+        w.WriteNumber("receive", Milliseconds(e.Receive ?? TimeSpan.Zero));
+        w.WriteEndObject();
+
+        if (e.HandlerTime is { } handler)
+            w.WriteNumber("_handlerMs", Milliseconds(handler));
+        if (e.Failed)
+            w.WriteBoolean("_failed", true);
+        w.WriteEndObject();
+    }
+
+    private static double Milliseconds(TimeSpan value) => Math.Round(value.TotalMilliseconds, 3);
+
+    private static void WriteEmptyArray(Utf8JsonWriter w, string name)
+    {
+        w.WriteStartArray(name);
+        w.WriteEndArray();
+    }
+}
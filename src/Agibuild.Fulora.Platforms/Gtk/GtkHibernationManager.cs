@@ -0,0 +1,115 @@
+namespace Agibuild.Fulora.Adapters.Gtk;
+
+/// <summary>
+/// Keeps the number of awake WebKitGTK views within a memory budget by hibernating the least
+/// recently active ones. Each awake view is assumed to cost <c>estimatedBytesPerView</c>
+/// (its web process); the most recently active view is never hibernated.
+/// </summary>
+/// <remarks>Not thread-safe; call from the UI thread.</remarks>
+internal sealed class GtkHibernationManager
+{
+    private readonly Dictionary<IGtkHibernatable, long> _lastActive = new(ReferenceEqualityComparer.Instance);
+    private readonly HashSet<IGtkHibernatable> _hibernating = new(ReferenceEqualityComparer.Instance);
+    private long _activitySequence;
+
+    private static readonly System.Collections.Concurrent.ConcurrentDictionary<long, GtkHibernationManager> s_byBudget = new();
+
+    /// <summary>
+    /// The process-wide manager for <paramref name="memoryBudgetBytes"/>, so every view configured
+    /// with the same budget competes for it.
+    /// </summary>
+    public static GtkHibernationManager ForBudget(long memoryBudgetBytes)
+    {
+        ArgumentOutOfRangeException.ThrowIfNegativeOrZero(memoryBudgetBytes);
+        return s_byBudget.GetOrAdd(memoryBudgetBytes, static budget => new GtkHibernationManager(budget));
+    }
+
+    public GtkHibernationManager(long memoryBudgetBytes, long estimatedBytesPerView = 200L * 1024 * 1024)
+    {
+        ArgumentOutOfRangeException.ThrowIfNegativeOrZero(memoryBudgetBytes);
+        ArgumentOutOfRangeException.ThrowIfNegativeOrZero(estimatedBytesPerView);
+        MemoryBudgetBytes = memoryBudgetBytes;
+        EstimatedBytesPerView = estimatedBytesPerView;
+    }
+
+    public long MemoryBudgetBytes { get; }
+
+    public long EstimatedBytesPerView { get; }
+
+    /// <summary>Whether views should show a last-frame snapshot while hibernated.</summary>
+    public bool CaptureSnapshots { get; init; } = true;
+
+    /// <summary>Awake views allowed by the budget; always at least one.</summary>
+    public int MaxAwakeViews => (int)Math.Max(1, MemoryBudgetBytes / EstimatedBytesPerView);
+
+    public int AwakeViewCount => _lastActive.Keys.Count(v => !v.IsHibernated && !_hibernating.Contains(v));
+
+    public void Register(IGtkHibernatable view)
+    {
+        ArgumentNullException.ThrowIfNull(view);
+        _lastActive[view] = ++_activitySequence;
+    }
+
+    public void Unregister(IGtkHibernatable view)
+    {
+        _lastActive.Remove(view);
+        _hibernating.Remove(view);
+    }
+
+    /// <summary>
+    /// Marks <paramref name="view"/> as the most recently used, resuming it if hibernated, then
+    /// hibernates older views that no longer fit the budget.
+    /// </summary>
+    public Task MarkActiveAsync(IGtkHibernatable view)
+    {
+        ArgumentNullException.ThrowIfNull(view);
+        _lastActive[view] = ++_activitySequence;
+        if (view.IsHibernated)
+        {
+            view.Resume();
+            GtkAdapterMetrics.HibernationResumed.Add(1);
+        }
+        return TrimAsync();
+    }
+
+    /// <summary>Hibernates least-recently-active views until the awake views fit the budget.</summary>
+    public async Task TrimAsync()
+    {
+        var excess = AwakeViewCount - MaxAwakeViews;
+        if (excess <= 0) return;
+
+        var victims = _lastActive
+            .Where(p => !p.Key.IsHibernated && !_hibernating.Contains(p.Key))
+            .OrderBy(p => p.Value)
+            .Take(excess)
+            .Select(p => p.Key)
+            .ToList();
+
+        foreach (var view in victims)
+            _hibernating.Add(view);
+
+        try
+        {
+            await Task.WhenAll(victims.Select(HibernateOneAsync)).ConfigureAwait(true);
+        }
+        finally
+        {
+            foreach (var view in victims)
+                _hibernating.Remove(view);
+        }
+    }
+
+    private async Task HibernateOneAsync(IGtkHibernatable view)
+    {
+        try
+        {
+            await view.HibernateAsync(CaptureSnapshots).ConfigureAwait(true);
+            GtkAdapterMetrics.HibernationHibernated.Add(1);
+        }
+        catch (InvalidOperationException)
+        {
+            // Detached or replaced while hibernating; it no longer counts against the budget
+            // or will be retried on the next trim.
+        }
+    }
+}
@@ -0,0 +1,30 @@
+namespace Agibuild.Fulora.Adapters.Gtk;
+
+/// <summary>
+/// Process-wide native resource counts of the WebKitGTK shim. The GObject instance counts are
+/// only populated when the process started with <c>GOBJECT_DEBUG=instance-count</c>
+/// (<see cref="HasInstanceCounts"/>); they include objects of every view in the process.
+/// </summary>
+/// <param name="LiveViews">Shim views created and not yet destroyed.</param>
+/// <param name="AttachedViews">Views currently attached to a host window.</param>
+/// <param name="OperationTables">Per-view operation tables, including tables of destroyed views still waiting on WebKit.</param>
+/// <param name="OutstandingOperations">Asynchronous operations holding a slot in any table.</param>
+/// <param name="HasInstanceCounts">Whether the GObject instance counts below are maintained.</param>
+/// <param name="WebViews">Live WebKitWebView instances, preload views included.</param>
+/// <param name="UserContentManagers">Live WebKitUserContentManager instances.</param>
+/// <param name="WebContexts">Live WebKitWebContext instances.</param>
+/// <param name="Downloads">Live WebKitDownload instances.</param>
+/// <param name="Plugs">Live GtkPlug instances.</param>
+/// <param name="OffscreenWindows">Live GtkOffscreenWindow instances.</param>
+internal readonly record struct GtkNativeResourceStats(
+    long LiveViews,
+    long AttachedViews,
+    long OperationTables,
+    long OutstandingOperations,
+    bool HasInstanceCounts,
+    long WebViews,
+    long UserContentManagers,
+    long WebContexts,
+    long Downloads,
+    long Plugs,
+    long OffscreenWindows);
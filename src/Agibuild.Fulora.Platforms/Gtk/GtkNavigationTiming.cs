@@ -0,0 +1,57 @@
+namespace Agibuild.Fulora.Adapters.Gtk;
+
+/// <summary>
+/// Phase timing of one main-frame load in a WebKitGTK view. Every offset is measured from the
+/// moment the navigation's policy decision was requested (or the load started, if it had none),
+/// and is <see langword="null"/> when the load never reached that phase.
+/// </summary>
+/// <param name="Url">The URL the load ended on.</param>
+/// <param name="Status">How the load ended.</param>
+/// <param name="PolicyDecided">When managed code decided the first policy request.</param>
+/// <param name="PolicyWait">Total time spent waiting on policy decisions, redirects included.</param>
+/// <param name="LoadStarted">When the provisional load started.</param>
+/// <param name="Committed">When the first response data arrived and the load committed.</param>
+/// <param name="FirstPaint">When the view first drew after commit.</param>
+/// <param name="Finished">When the load finished or failed.</param>
+/// <param name="RedirectCount">Server redirects followed.</param>
+internal sealed record GtkNavigationTiming(
+    Uri? Url,
+    NavigationCompletedStatus Status,
+    TimeSpan? PolicyDecided,
+    TimeSpan PolicyWait,
+    TimeSpan? LoadStarted,
+    TimeSpan? Committed,
+    TimeSpan? FirstPaint,
+    TimeSpan? Finished,
+    int RedirectCount)
+{
+    /// <summary>Time from load start to commit: network and server latency, redirects included.</summary>
+    public TimeSpan? ServerTime => Committed - LoadStarted;
+
+    /// <summary>Time from commit to the first frame of the new page.</summary>
+    public TimeSpan? RenderTime => FirstPaint - Committed;
+
+    /// <summary>Builds a record from the shim's microsecond offsets (-1 = phase not reached).</summary>
+    internal static GtkNavigationTiming FromNative(
+        string? url, int status, long policyDecidedUs, long policyWaitUs, long loadStartedUs,
+        long committedUs, long firstPaintUs, long finishedUs, int redirectCount)
+    {
+        static TimeSpan? Offset(long us) => us < 0 ? null : TimeSpan.FromMicroseconds(us);
+
+        return new GtkNavigationTiming(
+            url is not null && Uri.TryCreate(url, UriKind.Absolute, out var uri) ? uri : null,
+            status switch
+            {
+                0 => NavigationCompletedStatus.Success,
+                2 => NavigationCompletedStatus.Canceled,
+                _ => NavigationCompletedStatus.Failure,
+            },
+            Offset(policyDecidedUs),
+            TimeSpan.FromMicroseconds(Math.Max(0, policyWaitUs)),
+            Offset(loadStartedUs),
+            Offset(committedUs),
+            Offset(firstPaintUs),
+            Offset(finishedUs),
+            redirectCount);
+    }
+}
@@ -0,0 +1,21 @@
+namespace Agibuild.Fulora.Adapters.Gtk;
+
+/// <summary>Kinds of asynchronous operation a WebKitGTK view can have outstanding in the shim.</summary>
+internal enum GtkPendingOperationKind
+{
+    Unknown = 0,
+    PolicyDecision = 1,
+    Script = 2,
+    Screenshot = 3,
+    PrintToPdf = 4,
+    CookieRead = 5,
+    Download = 6,
+    SchemeUpload = 7,
+}
+
+/// <summary>One operation holding a slot in a view's native operation table.</summary>
+/// <param name="Id">Generation-tagged operation id (policy request ids are these ids).</param>
+/// <param name="Kind">What the operation is waiting on.</param>
+/// <param name="Completing">Already answered because the view detached; WebKit has not finished with it yet.</param>
+/// <param name="Age">Time since the operation was started.</param>
+internal readonly record struct GtkPendingOperation(ulong Id, GtkPendingOperationKind Kind, bool Completing, TimeSpan Age);
@@ -0,0 +1,68 @@
+namespace Agibuild.Fulora.Adapters.Gtk;
+
+/// <summary>Values match WebKitGTK's <c>WebKitHardwareAccelerationPolicy</c>.</summary>
+internal enum GtkHardwareAccelerationPolicy
+{
+    OnDemand = 0,
+    Always = 1,
+    Never = 2,
+}
+
+/// <summary>
+/// WebKitSettings that trade memory for speed. <c>null</c> keeps WebKit's default (or, when
+/// applied to a live view, the current value). Start from a preset and override with <c>with</c>.
+/// </summary>
+/// <remarks>
+/// The JavaScript JIT is not part of a profile: it is a process-wide JavaScriptCore option, set
+/// once before the first view with <see cref="GtkWebViewAdapter.SetJavaScriptJit"/>.
+/// </remarks>
+internal sealed record GtkPerformanceProfile
+{
+    public GtkHardwareAccelerationPolicy? HardwareAccelerationPolicy { get; init; }
+    public bool? EnablePageCache { get; init; }
+    public bool? EnableSmoothScrolling { get; init; }
+    public bool? EnableMediaSource { get; init; }
+    public bool? EnableWebGL { get; init; }
+    public bool? EnableWriteConsoleMessagesToStdout { get; init; }
+
+    /// <summary>Keeps every WebKit default.</summary>
+    public static GtkPerformanceProfile Default { get; } = new();
+
+    /// <summary>
+    /// Smallest footprint for low-end devices: software rendering, no page cache. Pair it with
+    /// <c>SetJavaScriptJit(false)</c> at startup to drop the JIT as well.
+    /// </summary>
+    public static GtkPerformanceProfile LowMemory { get; } = new()
+    {
+        HardwareAccelerationPolicy = GtkHardwareAccelerationPolicy.Never,
+        EnablePageCache = false,
+        EnableSmoothScrolling = false,
+        EnableMediaSource = false,
+        EnableWebGL = false,
+        EnableWriteConsoleMessagesToStdout = false,
+    };
+
+    /// <summary>Fastest page loads and script execution; animations are not smoothed.</summary>
+    public static GtkPerformanceProfile Throughput { get; } = new()
+    {
+        HardwareAccelerationPolicy = GtkHardwareAccelerationPolicy.Always,
+        EnablePageCache = true,
+        EnableSmoothScrolling = false,
+        EnableMediaSource = true,
+        EnableWebGL = true,
+        EnableWriteConsoleMessagesToStdout = false,
+    };
+
+    /// <summary>Throughput plus smooth scrolling, for touch and pointer-heavy UIs.</summary>
+    public static GtkPerformanceProfile Interactive { get; } = Throughput with { EnableSmoothScrolling = true };
+
+    /// <summary>The preset for a <see cref="WebViewPerformanceProfile"/> environment option.</summary>
+    public static GtkPerformanceProfile From(WebViewPerformanceProfile profile) => profile switch
+    {
+        WebViewPerformanceProfile.Default => Default,
+        WebViewPerformanceProfile.LowMemory => LowMemory,
+        WebViewPerformanceProfile.Throughput => Throughput,
+        WebViewPerformanceProfile.Interactive => Interactive,
+        _ => throw new ArgumentOutOfRangeException(nameof(profile), profile, null),
+    };
+}
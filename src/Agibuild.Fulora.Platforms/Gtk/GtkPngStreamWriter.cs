@@ -0,0 +1,255 @@
+using System.Buffers;
+using System.Buffers.Binary;
+using System.IO.Compression;
+
+namespace Agibuild.Fulora.Adapters.Gtk;
+
+/// <summary>
+/// Writes an 8-bit RGBA PNG of a known size row block by row block, so a tall image never has
+/// to be in memory at once. Rows come in as cairo ARGB32 (premultiplied BGRA) and are
+/// un-premultiplied on the way out.
+/// </summary>
+internal sealed class GtkPngStreamWriter : IDisposable
+{
+    private static ReadOnlySpan<byte> Signature => [0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A];
+
+    private readonly Stream _output;
+    private readonly IdatStream _idat;
+    private readonly ZLibStream _deflate;
+    private readonly byte[] _row;
+    private int _rowsWritten;
+    private bool _completed;
+
+    public GtkPngStreamWriter(Stream output, int width, int height, CompressionLevel compression = CompressionLevel.Fastest)
+    {
+        ArgumentNullException.ThrowIfNull(output);
+        ArgumentOutOfRangeException.ThrowIfNegativeOrZero(width);
+        ArgumentOutOfRangeException.ThrowIfNegativeOrZero(height);
+
+        _output = output;
+        Width = width;
+        Height = height;
+        _row = new byte[1 + width * 4]; // filter byte (0 = none) + RGBA
+
+        _output.Write(Signature);
+        Span<byte> header = stackalloc byte[13];
+        BinaryPrimitives.WriteInt32BigEndian(header, width);
+        BinaryPrimitives.WriteInt32BigEndian(header[4..], height);
+        header[8] = 8;  // bit depth
+        header[9] = 6;  // colour type: RGBA
+        header[10] = 0; // deflate
+        header[11] = 0; // adaptive filtering
+        header[12] = 0; // no interlace
+        WriteChunk(_output, "IHDR"u8, header);
+
+        _idat = new IdatStream(_output);
+        _deflate = new ZLibStream(_idat, compression, leaveOpen: true);
+    }
+
+    public int Width { get; }
+
+    public int Height { get; }
+
+    /// <summary>Appends <paramref name="rows"/> rows of <see cref="Width"/> BGRA pixels, <paramref name="stride"/> bytes apart.</summary>
+    public void WriteRows(ReadOnlySpan<byte> bgra, int stride, int rows)
+    {
+        ObjectDisposedException.ThrowIf(_completed, this);
+        ArgumentOutOfRangeException.ThrowIfLessThan(stride, Width * 4);
+        if (rows < 0 || _rowsWritten + rows > Height)
+            throw new ArgumentOutOfRangeException(nameof(rows), $"The image has {Height - _rowsWritten} rows left.");
+        if (rows > 0 && bgra.Length < (rows - 1) * stride + Width * 4)
+            throw new ArgumentException("The buffer is shorter than the rows it describes.", nameof(bgra));
+
+        for (var r = 0; r < rows; r++)
+        {
+            var source = bgra.Slice(r * stride, Width * 4);
+            var target = _row.AsSpan(1);
+            for (var x = 0; x < source.Length; x += 4)
+            {
+                var a = source[x + 3];
+                if (a == 255 || a == 0)
+                {
+                    target[x] = source[x + 2];
+                    target[x + 1] = source[x + 1];
+                    target[x + 2] = source[x];
+                }
+                else
+                {
+                    target[x] = (byte)((source[x + 2] * 255 + a / 2) / a);
+                    target[x + 1] = (byte)((source[x + 1] * 255 + a / 2) / a);
+                    target[x + 2] = (byte)((source[x] * 255 + a / 2) / a);
+                }
+                target[x + 3] = a;
+            }
+            _deflate.Write(_row);
+        }
+        _rowsWritten += rows;
+    }
+
+    /// <summary>Finishes the image; every row must have been written.</summary>
+    public void Complete()
+    {
+        ObjectDisposedException.ThrowIf(_completed, this);
+        if (_rowsWritten != Height)
+            throw new InvalidOperationException($"Only {_rowsWritten} of {Height} rows were written.");
+
+        _completed = true;
+        _deflate.Dispose();
+        _idat.Flush();
+        WriteChunk(_output, "IEND"u8, []);
+        _output.Flush();
+    }
+
+    public void Dispose()
+    {
+        if (_completed) return;
+        _completed = true;
+        _deflate.Dispose();
+    }
+
+    private static void WriteChunk(Stream output, ReadOnlySpan<byte> type, ReadOnlySpan<byte> data)
+    {
+        Span<byte> word = stackalloc byte[4];
+        BinaryPrimitives.WriteInt32BigEndian(word, data.Length);
+        output.Write(word);
+        output.Write(type);
+        output.Write(data);
+        BinaryPrimitives.WriteUInt32BigEndian(word, Crc32.Append(Crc32.Append(uint.MaxValue, type), data) ^ uint.MaxValue);
+        output.Write(word);
+    }
+
+    /// <summary>Cuts the zlib stream into IDAT chunks of at most <see cref="ChunkSize"/> bytes.</summary>
+    private sealed class IdatStream(Stream output) : Stream
+    {
+        private const int ChunkSize = 64 * 1024;
+        private readonly byte[] _buffer = new byte[ChunkSize];
+        private int _length;
+
+        public override bool CanRead => false;
+        public override bool CanSeek => false;
+        public override bool CanWrite => true;
+        public override long Length => throw new NotSupportedException();
+        public override long Position { get => throw new NotSupportedException(); set => throw new NotSupportedException(); }
+
+        public override void Write(byte[] buffer, int offset, int count) => Write(buffer.AsSpan(offset, count));
+
+        public override void Write(ReadOnlySpan<byte> buffer)
+        {
+            while (!buffer.IsEmpty)
+            {
+                var n = Math.Min(buffer.Length, ChunkSize - _length);
+                buffer[..n].CopyTo(_buffer.AsSpan(_length));
+                _length += n;
+                buffer = buffer[n..];
+                if (_length == ChunkSize)
+                    Flush();
+            }
+        }
+
+        public override void Flush()
+        {
+            if (_length == 0) return;
+            WriteChunk(output, "IDAT"u8, _buffer.AsSpan(0, _length));
+            _length = 0;
+        }
+
+        public override int Read(byte[] buffer, int offset, int count) => throw new NotSupportedException();
+        public override long Seek(long offset, SeekOrigin origin) => throw new NotSupportedException();
+        public override void SetLength(long value) => throw new NotSupportedException();
+    }
+
+    private static class Crc32
+    {
+        private static readonly uint[] s_table = CreateTable();
+
+        public static uint Append(uint crc, ReadOnlySpan<byte> data)
+        {
+            foreach (var b in data)
+                crc = s_table[(crc ^ b) & 0xFF] ^ (crc >> 8);
+            return crc;
+        }
+
+        private static uint[] CreateTable()
+        {
+            var table = new uint[256];
+            for (uint n = 0; n < 256; n++)
+            {
+                var c = n;
+                for (var k = 0; k < 8; k++)
+                    c = (c & 1) != 0 ? 0xEDB88320 ^ (c >> 1) : c >> 1;
+                table[n] = c;
+            }
+            return table;
+        }
+    }
+}
+
+/// <summary>
+/// Feeds full-document tiles to a <see cref="GtkPngStreamWriter"/> on the thread pool, so the GTK
+/// thread only copies each tile and never waits on deflate or the disk. At most
+/// <c>maxQueuedTiles</c> copies are held; the GTK thread blocks only when encoding falls that
+/// far behind. Tiles are written in the order they are added.
+/// </summary>
+internal sealed class GtkPngTileWriter(Stream output, int maxQueuedTiles = 2) : IAsyncDisposable
+{
+    private readonly Stream _output = output;
+    private readonly SemaphoreSlim _slots = new(maxQueuedTiles, maxQueuedTiles);
+    private GtkPngStreamWriter? _png;
+    private Task _tail = Task.CompletedTask;
+
+    /// <summary>Copies a raw tile and queues it; rethrows the first encoding failure so the capture stops.</summary>
+    public void Add(in GtkScreenshotTile tile)
+    {
+        if (_tail.IsFaulted)
+            _tail.GetAwaiter().GetResult();
+        if (tile.Encoding != GtkTileEncoding.Raw)
+            throw new ArgumentException("Only raw tiles can be streamed into a PNG.", nameof(tile));
+
+        var queued = new TileBlock(ArrayPool<byte>.Shared.Rent(tile.Data.Length),
+            tile.Width, tile.TotalHeight, tile.Stride, tile.Height);
+        tile.Data.CopyTo(queued.Buffer);
+
+        _slots.Wait();
+        _tail = _tail.ContinueWith(static (previous, state) =>
+        {
+            var (self, block) = ((GtkPngTileWriter, TileBlock))state!;
+            try
+            {
+                previous.GetAwaiter().GetResult();
+                self._png ??= new GtkPngStreamWriter(self._output, block.Width, block.TotalHeight);
+                self._png.WriteRows(block.Buffer, block.Stride, block.Rows);
+            }
+            finally
+            {
+                ArrayPool<byte>.Shared.Return(block.Buffer);
+                self._slots.Release();
+            }
+        }, (this, queued), CancellationToken.None, TaskContinuationOptions.None, TaskScheduler.Default);
+    }
+
+    /// <summary>Waits for every queued tile and finishes the image.</summary>
+    public async Task CompleteAsync()
+    {
+        await _tail.ConfigureAwait(false);
+        if (_png is null)
+            throw new InvalidOperationException("The document has no content to capture.");
+        _png.Complete();
+    }
+
+    /// <summary>Waits for the queued tiles to drain (ignoring failures) and abandons an unfinished image.</summary>
+    public async ValueTask DisposeAsync()
+    {
+        try
+        {
+            await _tail.ConfigureAwait(false);
+        }
+        catch
+        {
+            // The failure already reached the capture.
+        }
+        _png?.Dispose();
+        _slots.Dispose();
+    }
+
+    private readonly record struct TileBlock(byte[] Buffer, int Width, int TotalHeight, int Stride, int Rows);
+}
@@ -0,0 +1,48 @@
+namespace Agibuild.Fulora.Adapters.Gtk;
+
+/// <summary>One resource load recorded by the WebKitGTK shim's resource-timing ring.</summary>
+/// <param name="Url">Requested URL.</param>
+/// <param name="Method">HTTP method of the request.</param>
+/// <param name="MimeType">Response MIME type, or <see langword="null"/> without a response.</param>
+/// <param name="Status">HTTP status, 0 without a response.</param>
+/// <param name="Failed">Whether the load ended in an error.</param>
+/// <param name="StartedAt">Wall-clock time the request started.</param>
+/// <param name="Wait">Request start to response (time to first byte).</param>
+/// <param name="Receive">Response to the end of the load.</param>
+/// <param name="Total">Request start to the end of the load.</param>
+/// <param name="Size">Response content length, when the server sent one.</param>
+/// <param name="HandlerTime">Time spent in the managed custom-scheme handler, for custom-scheme loads.</param>
+internal sealed record GtkResourceTiming(
+    string Url,
+    string Method,
+    string? MimeType,
+    int Status,
+    bool Failed,
+    DateTimeOffset StartedAt,
+    TimeSpan? Wait,
+    TimeSpan? Receive,
+    TimeSpan Total,
+    long? Size,
+    TimeSpan? HandlerTime)
+{
+    /// <summary>Builds a record from the shim's microsecond values (-1 = not reached or unknown).</summary>
+    internal static GtkResourceTiming FromNative(
+        string url, string method, string? mimeType, int status, bool failed, long startedUnixUs,
+        long waitUs, long receiveUs, long totalUs, long size, long handlerUs)
+    {
+        static TimeSpan? Duration(long us) => us < 0 ? null : TimeSpan.FromMicroseconds(us);
+
+        return new GtkResourceTiming(
+            url,
+            method,
+            mimeType,
+            status,
+            failed,
+            DateTimeOffset.UnixEpoch.AddTicks(startedUnixUs * TimeSpan.TicksPerMicrosecond),
+            Duration(waitUs),
+            Duration(receiveUs),
+            TimeSpan.FromMicroseconds(Math.Max(0, totalUs)),
+            size < 0 ? null : size,
+            Duration(handlerUs));
+    }
+}
@@ -0,0 +1,33 @@
+namespace Agibuild.Fulora.Adapters.Gtk;
+
+/// <summary>
+/// A custom-scheme request that carries a body (a page <c>fetch</c> POST/PUT, a form upload).
+/// <see cref="Body"/> streams the body from WebKit on the reading thread; it is only valid
+/// until the handler's task completes, and reads fail once the view detaches.
+/// </summary>
+/// <param name="RequestUri">The requested URI.</param>
+/// <param name="Method">HTTP method.</param>
+/// <param name="Headers">Request headers, case-insensitive.</param>
+/// <param name="ContentLength">Declared <c>Content-Length</c>, when the page sent one.</param>
+/// <param name="Body">Forward-only body stream; read it off the UI thread for large uploads.</param>
+internal sealed record GtkSchemeUpload(
+    Uri RequestUri,
+    string Method,
+    IReadOnlyDictionary<string, string> Headers,
+    long? ContentLength,
+    Stream Body)
+{
+    /// <summary>The <c>Content-Type</c> header, if present.</summary>
+    public string? ContentType => Headers.TryGetValue("Content-Type", out var value) ? value : null;
+}
+
+/// <summary>Response to a <see cref="GtkSchemeUpload"/>; the body is copied to the shim.</summary>
+/// <param name="Body">Response body.</param>
+/// <param name="ContentType">Response MIME type.</param>
+/// <param name="StatusCode">HTTP status code.</param>
+/// <param name="AllowOrigin">
+/// Sent as <c>Access-Control-Allow-Origin</c> so a page on that origin may read the response;
+/// null sends no CORS headers.
+/// </param>
+internal sealed record GtkSchemeResponse(
+    ReadOnlyMemory<byte> Body, string ContentType = "application/octet-stream", int StatusCode = 200, string? AllowOrigin = null);
@@ -0,0 +1,37 @@
+namespace Agibuild.Fulora.Adapters.Gtk;
+
+/// <summary>What a <see cref="GtkWebProcessHang"/> report marks; values match the shim's <c>AG_GTK_HANG_*</c>.</summary>
+internal enum GtkWebProcessHangPhase
+{
+    /// <summary>WebKit stopped getting answers from the web process.</summary>
+    Started = 0,
+
+    /// <summary>The web process answered again.</summary>
+    Recovered = 1,
+
+    /// <summary>The web process went away (crash, watchdog or hibernation) before answering.</summary>
+    Terminated = 2,
+}
+
+/// <summary>
+/// One web process hang report. <paramref name="Duration"/> is zero when the hang starts; the
+/// in-flight work is captured then and repeated on the report that closes the hang. WebKit
+/// notices a hang a few seconds after it begins, so durations undercount by that much.
+/// <para>
+/// <see cref="PendingScript"/> and <see cref="LastBridgeMessage"/> quote page traffic verbatim
+/// and may contain user data (form input, tokens, message payloads); scrub them before the
+/// report leaves the process.
+/// </para>
+/// </summary>
+/// <param name="NavigationId">The main-frame navigation that had not finished, if any.</param>
+/// <param name="ScriptsInFlight">Script evaluations (bridge calls included) queued or running.</param>
+/// <param name="PendingScript">The start of the most recently submitted script, when any were in flight.</param>
+/// <param name="LastBridgeMessage">The start of the last message the page posted to the bridge.</param>
+internal sealed record GtkWebProcessHang(
+    GtkWebProcessHangPhase Phase,
+    TimeSpan Duration,
+    Guid? NavigationId,
+    Uri? NavigationUri,
+    int ScriptsInFlight,
+    string? PendingScript,
+    string? LastBridgeMessage);
@@ -0,0 +1,11 @@
+namespace Agibuild.Fulora.Adapters.Gtk;
+
+/// <summary>Raised after the web process of a WebKitGTK view terminated and its in-flight operations were failed.</summary>
+internal sealed class GtkWebProcessTerminatedEventArgs(WebViewProcessTerminationReason reason, bool recovering) : EventArgs
+{
+    /// <summary>Why the process terminated.</summary>
+    public WebViewProcessTerminationReason Reason { get; } = reason;
+
+    /// <summary>Whether the shim is reloading the last committed entry on a new process.</summary>
+    public bool Recovering { get; } = recovering;
+}
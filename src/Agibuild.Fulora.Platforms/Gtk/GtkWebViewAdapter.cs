@@ -2,6 +2,7 @@ using System.Collections.Concurrent;
 using System.Reflection;
 using System.Runtime.CompilerServices;
 using System.Runtime.InteropServices;
+using System.Text;
 using Agibuild.Fulora;
 using Agibuild.Fulora.Adapters.Abstractions;
 using Agibuild.Fulora.Security;
@@ -11,7 +12,11 @@ namespace Agibuild.Fulora.Adapters.Gtk;
 internal sealed partial class GtkWebViewAdapter : IWebViewAdapter, INativeWebViewHandleProvider, ICookieAdapter, IWebViewAdapterOptions,
     ICustomSchemeAdapter, IDownloadAdapter, IPermissionAdapter, ICommandAdapter, IScreenshotAdapter,
     IDragDropAdapter, IPrintAdapter,
-    IFindInPageAdapter, IZoomAdapter, IPreloadScriptAdapter, IContextMenuAdapter, IDevToolsAdapter
+    IFindInPageAdapter, IZoomAdapter, IPreloadScriptAdapter, IContextMenuAdapter, IDevToolsAdapter,
+    IFetchBridgeAdapter, IHostVisibilityAdapter, IRpcDeliveryAdapter, IBlobPublishingAdapter, IGtkHibernatable,
+    IContentFilterAdapter, ISharedContentSetAdapter, IWebsiteDataAdapter, ISpeculativeLoadingAdapter,
+    IResourceTimingAdapter, IScriptEvaluationLimitsAdapter, IScriptStreamingAdapter, IOffscreenRenderingAdapter,
+    IDownloadManagementAdapter, IActivityStateAdapter, IFullPageCaptureAdapter
 {
     private static bool DiagnosticsEnabled
         => string.Equals(Environment.GetEnvironmentVariable("AGIBUILD_WEBVIEW_DIAG"), "1", StringComparison.Ordinal);
@@ -50,6 +55,7 @@ internal sealed partial class GtkWebViewAdapter : IWebViewAdapter, INativeWebVie
     // Script completion
     private long _nextScriptRequestId;
     private readonly ConcurrentDictionary<ulong, TaskCompletionSource<string?>> _scriptTcsById = new();
+    private readonly ConcurrentDictionary<ulong, double> _lastDownloadRates = new();
 
     private const int SslStatusCode = 5;
 
@@ -125,14 +131,22 @@ internal sealed partial class GtkWebViewAdapter : IWebViewAdapter, INativeWebVie
                 on_navigation_completed = (IntPtr)(delegate* unmanaged[Cdecl]<IntPtr, IntPtr, int, long, IntPtr, IntPtr, IntPtr, IntPtr, IntPtr, long, long, void>)&NavigationCompletedTrampoline,
                 on_script_result = (IntPtr)(delegate* unmanaged[Cdecl]<IntPtr, ulong, IntPtr, IntPtr, void>)&ScriptResultTrampoline,
                 on_message = (IntPtr)(delegate* unmanaged[Cdecl]<IntPtr, IntPtr, IntPtr, void>)&MessageTrampoline,
-                on_download = (IntPtr)(delegate* unmanaged[Cdecl]<IntPtr, IntPtr, IntPtr, IntPtr, long, void>)&DownloadTrampoline,
+                on_download = (IntPtr)(delegate* unmanaged[Cdecl]<IntPtr, ulong, IntPtr, IntPtr, IntPtr, long, int>)&DownloadTrampoline,
                 on_permission = (IntPtr)(delegate* unmanaged[Cdecl]<IntPtr, int, IntPtr, int*, void>)&PermissionTrampoline,
-                on_scheme_request = (IntPtr)(delegate* unmanaged[Cdecl]<IntPtr, IntPtr, IntPtr, IntPtr*, long*, IntPtr*, int*, byte>)&SchemeRequestTrampoline,
+                on_scheme_request = (IntPtr)(delegate* unmanaged[Cdecl]<IntPtr, IntPtr, IntPtr, IntPtr, ulong, IntPtr, long, IntPtr*, long*, IntPtr*, int*, int>)&SchemeRequestTrampoline,
                 on_context_menu = (IntPtr)(delegate* unmanaged[Cdecl]<IntPtr, double, double, IntPtr, IntPtr, int, IntPtr, byte, byte>)&ContextMenuTrampoline,
-                on_drag_entered = (IntPtr)(delegate* unmanaged[Cdecl]<IntPtr, IntPtr, IntPtr, double, double, void>)&OnDragEnteredNative,
+                on_drag_entered = (IntPtr)(delegate* unmanaged[Cdecl]<IntPtr, int, IntPtr*, IntPtr*, IntPtr, double, double, void>)&OnDragEnteredNative,
                 on_drag_updated = (IntPtr)(delegate* unmanaged[Cdecl]<IntPtr, double, double, void>)&OnDragUpdatedNative,
                 on_drag_exited = (IntPtr)(delegate* unmanaged[Cdecl]<IntPtr, void>)&OnDragExitedNative,
-                on_drop_performed = (IntPtr)(delegate* unmanaged[Cdecl]<IntPtr, IntPtr, IntPtr, double, double, void>)&OnDropPerformedNative,
+                on_drop_performed = (IntPtr)(delegate* unmanaged[Cdecl]<IntPtr, int, IntPtr*, IntPtr*, IntPtr, double, double, void>)&OnDropPerformedNative,
+                on_web_process_terminated = (IntPtr)(delegate* unmanaged[Cdecl]<IntPtr, int, byte, void>)&WebProcessTerminatedTrampoline,
+                on_navigation_timing = (IntPtr)(delegate* unmanaged[Cdecl]<IntPtr, IntPtr, NavigationTimingNative*, void>)&NavigationTimingTrampoline,
+                on_script_settled = (IntPtr)(delegate* unmanaged[Cdecl]<IntPtr, ulong, int, long, long, void>)&ScriptSettledTrampoline,
+                on_script_buffer = (IntPtr)(delegate* unmanaged[Cdecl]<IntPtr, ulong, IntPtr, byte*, long, void>)&ScriptBufferTrampoline,
+                on_offscreen_frame = (IntPtr)(delegate* unmanaged[Cdecl]<IntPtr, ulong, long, void>)&OffscreenFrameTrampoline,
+                on_download_progress = (IntPtr)(delegate* unmanaged[Cdecl]<IntPtr, ulong, long, long, double, void>)&DownloadProgressTrampoline,
+                on_download_finished = (IntPtr)(delegate* unmanaged[Cdecl]<IntPtr, ulong, int, IntPtr, long, IntPtr, void>)&DownloadFinishedTrampoline,
+                on_web_process_hang = (IntPtr)(delegate* unmanaged[Cdecl]<IntPtr, int, long, void>)&WebProcessHangTrampoline,
             };
         }
 
@@ -197,14 +211,15 @@ internal sealed partial class GtkWebViewAdapter : IWebViewAdapter, INativeWebVie
     }
 
     [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvCdecl) })]
-    private static void DownloadTrampoline(IntPtr userData, IntPtr urlUtf8, IntPtr suggestedFileNameUtf8, IntPtr mimeTypeUtf8, long contentLength)
+    private static int DownloadTrampoline(IntPtr userData, ulong downloadId, IntPtr urlUtf8, IntPtr suggestedFileNameUtf8, IntPtr mimeTypeUtf8, long contentLength)
     {
         var self = NativeMethods.FromUserData(userData);
-        self?.OnDownloadNative(
+        return self?.OnDownloadNative(
+            downloadId,
             NativeMethods.PtrToString(urlUtf8),
             NativeMethods.PtrToString(suggestedFileNameUtf8),
             NativeMethods.PtrToString(mimeTypeUtf8),
-            contentLength);
+            contentLength) ?? DownloadDecisionDefault;
     }
 
     [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvCdecl) })]
@@ -218,17 +233,23 @@ internal sealed partial class GtkWebViewAdapter : IWebViewAdapter, INativeWebVie
     }
 
     [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvCdecl) })]
-    private static unsafe byte SchemeRequestTrampoline(
-        IntPtr userData, IntPtr urlUtf8, IntPtr methodUtf8,
+    private static unsafe int SchemeRequestTrampoline(
+        IntPtr userData, IntPtr urlUtf8, IntPtr methodUtf8, IntPtr headersUtf8,
+        ulong requestId, IntPtr body, long bodyLength,
         IntPtr* outResponseData, long* outResponseLength, IntPtr* outMimeTypeUtf8, int* outStatusCode)
     {
         var self = NativeMethods.FromUserData(userData);
-        if (self is null) return 0;
-        return self.OnSchemeRequestNative(
-            NativeMethods.PtrToString(urlUtf8),
-            NativeMethods.PtrToString(methodUtf8),
+        if (self is null) return SchemeNotHandled;
+
+        var url = NativeMethods.PtrToString(urlUtf8);
+        var method = NativeMethods.PtrToString(methodUtf8);
+        var headers = ParseSchemeRequestHeaders(NativeMethods.PtrToStringNullable(headersUtf8));
+        if (body != IntPtr.Zero && self.TryDeferSchemeUpload(url, method, headers, requestId, body, bodyLength))
+            return SchemeDeferred;
+
+        return self.OnSchemeRequestNative(url, method, headers,
             outResponseData, outResponseLength, outMimeTypeUtf8, outStatusCode)
-            ? (byte)1 : (byte)0;
+            ? SchemeResponded : SchemeNotHandled;
     }
 
     [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvCdecl) })]
@@ -245,6 +266,13 @@ internal sealed partial class GtkWebViewAdapter : IWebViewAdapter, INativeWebVie
             isEditable != 0) ? (byte)1 : (byte)0;
     }
 
+    [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvCdecl) })]
+    private static void WebProcessTerminatedTrampoline(IntPtr userData, int reason, byte recovering)
+    {
+        var self = NativeMethods.FromUserData(userData);
+        self?.OnWebProcessTerminatedNative(reason, recovering != 0);
+    }
+
     [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvCdecl) })]
     private static void CookiesGetTrampoline(IntPtr context, IntPtr jsonUtf8)
     {
@@ -292,7 +320,8 @@ internal sealed partial class GtkWebViewAdapter : IWebViewAdapter, INativeWebVie
             throw new InvalidOperationException($"{nameof(Attach)} can only be called once.");
         }
 
-        if (parentHandle.Handle == IntPtr.Zero)
+        // An offscreen view draws into frames the host copies, so it has no parent window.
+        if (parentHandle.Handle == IntPtr.Zero && !_offscreenEnabled)
         {
             throw new ArgumentException("Parent handle must be non-zero.", nameof(parentHandle));
         }
@@ -306,6 +335,9 @@ internal sealed partial class GtkWebViewAdapter : IWebViewAdapter, INativeWebVie
         }
 
         _attached = true;
+
+        if (HibernationManager is { } manager)
+            ObserveHibernation(manager.MarkActiveAsync(this));
     }
 
     public void Detach()
@@ -317,15 +349,22 @@ internal sealed partial class GtkWebViewAdapter : IWebViewAdapter, INativeWebVie
             return;
         }
 
-        _detached = true;
+        lock (_nativeLeaseLock)
+            _detached = true;
         _attached = false;
 
         try
         {
+            _detachCts.Cancel();
+            CancelSuspendTimer();
+            HibernationManager?.Unregister(this);
+
             if (_native != IntPtr.Zero)
             {
+                CloseOffscreenFrames();
                 NativeMethods.Detach(_native);
-                NativeMethods.Destroy(_native);
+                if (!DeferDestroyToNativeLeases())
+                    NativeMethods.Destroy(_native);
             }
         }
         finally
@@ -338,6 +377,9 @@ internal sealed partial class GtkWebViewAdapter : IWebViewAdapter, INativeWebVie
             }
             _scriptTcsById.Clear();
 
+            // The shim drops its queue on detach without settling; balance the gauge here.
+            GtkAdapterMetrics.ScriptsInFlight.Add(-Interlocked.Exchange(ref _scriptsInFlight, 0));
+
             if (_selfHandle.IsAllocated)
             {
                 _selfHandle.Free();
@@ -357,6 +399,8 @@ internal sealed partial class GtkWebViewAdapter : IWebViewAdapter, INativeWebVie
 
         lock (_navLock) { BeginApiNavigation(navigationId, requestUri: uri); }
         NativeMethods.Navigate(_native, uri.AbsoluteUri);
+        if (_preloadRequested)
+            ReportPreloadStats();
         return Task.CompletedTask;
     }
 
@@ -374,15 +418,66 @@ internal sealed partial class GtkWebViewAdapter : IWebViewAdapter, INativeWebVie
     }
 
     public Task<string?> InvokeScriptAsync(string script)
+        => InvokeScriptAsync(script, CancellationToken.None);
+
+    /// <summary>
+    /// Evaluates <paramref name="script"/> subject to the limits set by
+    /// <see cref="ConfigureScriptEvaluation"/>. Cancelling drops the request from the native
+    /// queue, or discards the result of a script that is already running.
+    /// </summary>
+    internal Task<string?> InvokeScriptAsync(string script, CancellationToken cancellationToken)
     {
         ArgumentNullException.ThrowIfNull(script);
         ThrowIfNotAttached();
+        if (cancellationToken.IsCancellationRequested)
+            return Task.FromCanceled<string?>(cancellationToken);
 
         var requestId = (ulong)Interlocked.Increment(ref _nextScriptRequestId);
+        return EvaluateScript(requestId, script, buffered: false, cancellationToken);
+    }
+
+    private Task<string?> EvaluateScript(ulong requestId, string script, bool buffered, CancellationToken cancellationToken)
+    {
         var tcs = new TaskCompletionSource<string?>(TaskCreationOptions.RunContinuationsAsynchronously);
         _scriptTcsById.TryAdd(requestId, tcs);
+        _lastScriptPreview = Preview(script);
+
+        var started = buffered
+            ? NativeMethods.EvalJsBuffered(_native, requestId, script)
+            : NativeMethods.EvalJs(_native, requestId, script);
+        switch (started)
+        {
+            case EvalStarted:
+            case EvalQueued:
+                Interlocked.Increment(ref _scriptsInFlight);
+                GtkAdapterMetrics.ScriptsInFlight.Add(1);
+                break;
+            case EvalRejected:
+                _scriptTcsById.TryRemove(requestId, out _);
+                GtkAdapterMetrics.ScriptsRejected.Add(1);
+                tcs.TrySetException(new WebViewScriptException("Too many script evaluations are in flight for this view."));
+                return tcs.Task;
+            default:
+                _scriptTcsById.TryRemove(requestId, out _);
+                tcs.TrySetException(_detached
+                    ? new ObjectDisposedException(nameof(GtkWebViewAdapter))
+                    : new WebViewScriptException("The view has no web content to evaluate script in."));
+                return tcs.Task;
+        }
 
-        NativeMethods.EvalJs(_native, requestId, script);
+        if (cancellationToken.CanBeCanceled)
+        {
+            var registration = cancellationToken.Register(() =>
+            {
+                if (!_scriptTcsById.TryRemove(requestId, out var pending))
+                    return;
+                pending.TrySetCanceled(cancellationToken);
+                if (!_detached)
+                    NativeMethods.EvalJsCancel(_native, requestId);
+            });
+            _ = tcs.Task.ContinueWith(_ => registration.Dispose(),
+                CancellationToken.None, TaskContinuationOptions.ExecuteSynchronously, TaskScheduler.Default);
+        }
         return tcs.Task;
     }
 
@@ -448,6 +543,51 @@ internal sealed partial class GtkWebViewAdapter : IWebViewAdapter, INativeWebVie
         {
             NativeMethods.SetUserAgent(_native, options.CustomUserAgent);
         }
+
+        if (options.ContentFilterStorePath is not null)
+        {
+            SetContentFilterStorePath(options.ContentFilterStorePath);
+        }
+
+        if (options.WebsiteDataDirectory is not null || options.WebsiteCacheDirectory is not null)
+        {
+            SetWebsiteDataDirectories(options.WebsiteDataDirectory, options.WebsiteCacheDirectory);
+        }
+
+        if (options.CacheModel is { } cacheModel)
+        {
+            SetCacheModel(cacheModel);
+        }
+
+        if (options.PerformanceProfile != WebViewPerformanceProfile.Default)
+        {
+            SetPerformanceProfile(GtkPerformanceProfile.From(options.PerformanceProfile));
+        }
+
+        if (options.HibernationMemoryBudgetBytes is { } hibernationBudget)
+        {
+            HibernationManager = GtkHibernationManager.ForBudget(hibernationBudget);
+        }
+
+        if (options.EnableCrashRecovery)
+        {
+            SetCrashRecoveryEnabled(true);
+        }
+
+        if (options.TerminateUnresponsiveWebProcessAfter is { } terminateAfter)
+        {
+            SetHangPolicy(terminateAfter);
+        }
+
+        if (options.EnableNativeBridge)
+        {
+            SetNativeBridgeEnabled(true);
+        }
+
+        if (options.OffscreenRendering)
+        {
+            SetOffscreenRendering(true);
+        }
     }
 
     public void SetCustomUserAgent(string? userAgent)
@@ -662,6 +802,17 @@ internal sealed partial class GtkWebViewAdapter : IWebViewAdapter, INativeWebVie
         {
             throw new InvalidOperationException("Adapter must be attached before use.");
         }
+
+        // Every operation on the web view goes through here, so a hibernated view wakes up
+        // on first use instead of silently dropping the call. Waking through the manager makes
+        // it the most recently active view and hibernates others to stay within the budget.
+        if (_hibernated)
+        {
+            if (HibernationManager is { } manager)
+                ObserveHibernation(manager.MarkActiveAsync(this));
+            else
+                Resume();
+        }
     }
 
     private static void SafeRaise(Action action)
@@ -794,6 +945,9 @@ internal sealed partial class GtkWebViewAdapter : IWebViewAdapter, INativeWebVie
             ? parsed
             : null;
 
+        if (_crashRecoveryPending)
+            ReportCrashRecovery(succeeded: status == 0);
+
         if (status == 0)
         {
             OnNavigationTerminal(NavigationCompletedStatus.Success, error: null, requestUriOverride: requestUri);
@@ -899,24 +1053,35 @@ internal sealed partial class GtkWebViewAdapter : IWebViewAdapter, INativeWebVie
             return;
         }
 
+        _lastBridgeMessagePreview = Preview(body);
         var channelId = _host?.ChannelId ?? Guid.Empty;
         RaiseWebMessageReceived(body ?? string.Empty, origin ?? string.Empty, channelId, protocolVersion: 1);
     }
 
-    private void OnDownloadNative(string? url, string? suggestedFileName, string? mimeType, long contentLength)
+    private int OnDownloadNative(ulong downloadId, string? url, string? suggestedFileName, string? mimeType, long contentLength)
     {
-        if (_detached) return;
+        if (_detached) return DownloadDecisionCancel;
 
         if (string.IsNullOrEmpty(url) || !Uri.TryCreate(url, UriKind.Absolute, out var uri))
-            return;
+            return DownloadDecisionDefault;
 
-        var args = new DownloadRequestedEventArgs(
+        var download = new WebViewDownload(
+            downloadId,
             uri,
             string.IsNullOrEmpty(suggestedFileName) ? null : suggestedFileName,
             string.IsNullOrEmpty(mimeType) ? null : mimeType,
             contentLength > 0 ? contentLength : null);
+        var args = new DownloadRequestedEventArgs(download.Uri, download.SuggestedFileName, download.ContentType, download.ContentLength);
 
         DownloadRequested?.Invoke(this, args);
+
+        var resolver = DownloadDestinationResolver;
+        var decision = DecideDownload(args, resolver is not null);
+        if (decision == DownloadDecisionAccepted && !NativeMethods.DownloadSetDestination(_native, downloadId, Path.GetFullPath(args.DownloadPath!)))
+            return DownloadDecisionCancel;
+        if (decision == DownloadDecisionDeferred)
+            _ = ResolveDownloadDestinationAsync(resolver!, download);
+        return decision;
     }
 
     private int OnPermissionNative(int permissionKind, string? origin)
@@ -945,14 +1110,14 @@ internal sealed partial class GtkWebViewAdapter : IWebViewAdapter, INativeWebVie
     }
 
     private unsafe bool OnSchemeRequestNative(
-        string? url, string? method,
+        string? url, string? method, IReadOnlyDictionary<string, string>? headers,
         IntPtr* outResponseData, long* outResponseLength, IntPtr* outMimeTypeUtf8, int* outStatusCode)
     {
         if (_detached) return false;
         if (string.IsNullOrEmpty(url) || !Uri.TryCreate(url, UriKind.Absolute, out var uri))
             return false;
 
-        var args = new WebResourceRequestedEventArgs(uri, method ?? "GET");
+        var args = new WebResourceRequestedEventArgs(uri, method ?? "GET", headers);
         WebResourceRequested?.Invoke(this, args);
 
         if (!args.Handled || args.ResponseBody is null)
@@ -981,11 +1146,16 @@ internal sealed partial class GtkWebViewAdapter : IWebViewAdapter, INativeWebVie
     // ==== Drag-drop native callbacks ====
 
     [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvCdecl) })]
-    private static void OnDragEnteredNative(IntPtr userData, IntPtr filesJsonUtf8, IntPtr textUtf8, double x, double y)
+    private static unsafe void OnDragEnteredNative(IntPtr userData, int fileCount, IntPtr* filePaths, IntPtr* fileUris,
+        IntPtr textUtf8, double x, double y)
     {
         var adapter = NativeMethods.FromUserData(userData);
         if (adapter is null) return;
-        var payload = ParseGtkDragPayload(filesJsonUtf8, textUtf8);
+        var count = Math.Max(fileCount, 0);
+        var payload = BuildGtkDropPayload(
+            new ReadOnlySpan<IntPtr>(filePaths, filePaths == null ? 0 : count),
+            new ReadOnlySpan<IntPtr>(fileUris, fileUris == null ? 0 : count),
+            textUtf8);
         adapter.DragEntered?.Invoke(adapter, new DragEventArgs
         {
             Payload = payload,
@@ -996,13 +1166,18 @@ internal sealed partial class GtkWebViewAdapter : IWebViewAdapter, INativeWebVie
         });
     }
 
+    // Drag-over carries no payload; share one instance instead of allocating per update.
+    private static readonly DragDropPayload s_emptyDragPayload = new();
+
     [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvCdecl) })]
     private static void OnDragUpdatedNative(IntPtr userData, double x, double y)
     {
         var adapter = NativeMethods.FromUserData(userData);
-        adapter?.DragOver?.Invoke(adapter, new DragEventArgs
+        var handler = adapter?.DragOver;
+        if (handler is null) return;
+        handler(adapter, new DragEventArgs
         {
-            Payload = new DragDropPayload(),
+            Payload = s_emptyDragPayload,
             AllowedEffects = DragDropEffects.Copy,
             Effect = DragDropEffects.Copy,
             X = x,
@@ -1014,15 +1189,23 @@ internal sealed partial class GtkWebViewAdapter : IWebViewAdapter, INativeWebVie
     private static void OnDragExitedNative(IntPtr userData)
     {
         var adapter = NativeMethods.FromUserData(userData);
-        adapter?.DragLeft?.Invoke(adapter, EventArgs.Empty);
+        if (adapter is null) return;
+        adapter.ReportDragMotionStats();
+        adapter.DragLeft?.Invoke(adapter, EventArgs.Empty);
     }
 
     [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvCdecl) })]
-    private static void OnDropPerformedNative(IntPtr userData, IntPtr filesJsonUtf8, IntPtr textUtf8, double x, double y)
+    private static unsafe void OnDropPerformedNative(IntPtr userData, int fileCount, IntPtr* filePaths, IntPtr* fileUris,
+        IntPtr textUtf8, double x, double y)
     {
         var adapter = NativeMethods.FromUserData(userData);
         if (adapter is null) return;
-        var payload = ParseGtkDragPayload(filesJsonUtf8, textUtf8);
+        adapter.ReportDragMotionStats();
+        var count = Math.Max(fileCount, 0);
+        var payload = BuildGtkDropPayload(
+            new ReadOnlySpan<IntPtr>(filePaths, filePaths == null ? 0 : count),
+            new ReadOnlySpan<IntPtr>(fileUris, fileUris == null ? 0 : count),
+            textUtf8);
         adapter.DropCompleted?.Invoke(adapter, new DropEventArgs
         {
             Payload = payload,
@@ -1032,34 +1215,116 @@ internal sealed partial class GtkWebViewAdapter : IWebViewAdapter, INativeWebVie
         });
     }
 
-    private static DragDropPayload ParseGtkDragPayload(IntPtr filesJsonUtf8, IntPtr textUtf8)
+    /// <summary>
+    /// Builds a drag or drop payload from the shim's parallel path/URI tables. Only paths are read
+    /// here; MIME type and size are looked up per file when a consumer asks for them, and each
+    /// file is looked up once per payload.
+    /// </summary>
+    internal static DragDropPayload BuildGtkDropPayload(ReadOnlySpan<IntPtr> filePaths, ReadOnlySpan<IntPtr> fileUris, IntPtr textUtf8)
     {
         var payload = new DragDropPayload
         {
             Text = NativeMethods.PtrToStringNullable(textUtf8)
         };
 
-        var filesJson = NativeMethods.PtrToStringNullable(filesJsonUtf8);
-        if (!string.IsNullOrEmpty(filesJson) && filesJson != "[]")
+        if (filePaths.IsEmpty)
+            return payload;
+
+        var files = new List<FileDropInfo>(filePaths.Length);
+        string? firstNonFileUri = null;
+        for (var i = 0; i < filePaths.Length; i++)
         {
-            try
-            {
-                using var doc = System.Text.Json.JsonDocument.Parse(filesJson);
-                var files = new List<FileDropInfo>();
-                foreach (var elem in doc.RootElement.EnumerateArray())
-                {
-                    var path = elem.GetProperty("path").GetString() ?? "";
-                    files.Add(new FileDropInfo(path, null, null));
-                }
-                payload = payload with { Files = files };
-            }
-            catch (System.Text.Json.JsonException)
-            {
-                // Native layer sent malformed file list JSON; proceed with text-only payload.
-                System.Diagnostics.Trace.TraceWarning("GtkWebViewAdapter: Failed to parse drag-drop files JSON.");
-            }
+            if (filePaths[i] != IntPtr.Zero)
+                files.Add(new FileDropInfo(NativeMethods.PtrToString(filePaths[i])));
+            else if (i < fileUris.Length)
+                firstNonFileUri ??= NativeMethods.PtrToStringNullable(fileUris[i]);
         }
-        return payload;
+
+        return payload with
+        {
+            Files = files.Count > 0 ? files : null,
+            Uri = firstNonFileUri,
+            FileInfoResolver = CreateDropFileInfoResolver(QueryDropFileInfo)
+        };
+    }
+
+    /// <summary>
+    /// Returns a resolver that looks up each dropped file on a worker thread the first time it is
+    /// asked for and hands out the cached result afterwards. Dropping a large folder only costs
+    /// path decoding on the GTK thread; a consumer that reads one file pays for that file only.
+    /// </summary>
+    internal static Func<FileDropInfo, CancellationToken, Task<FileDropInfo>> CreateDropFileInfoResolver(
+        Func<FileDropInfo, FileDropInfo> query)
+    {
+        ArgumentNullException.ThrowIfNull(query);
+        var resolved = new ConcurrentDictionary<string, Task<FileDropInfo>>(StringComparer.Ordinal);
+
+        // The lookup itself is not cancelled, so a cancelled caller never leaves a cancelled
+        // task in the cache; it only stops waiting for it.
+        return (file, cancellationToken) => resolved
+            .GetOrAdd(file.Path, static (_, state) => Task.Run(() => state.query(state.file)), (query, file))
+            .WaitAsync(cancellationToken);
+    }
+
+    /// <summary>Looks up MIME type and size of a dropped file; returns it unchanged when GIO cannot.</summary>
+    internal static FileDropInfo QueryDropFileInfo(FileDropInfo file)
+    {
+        if (!NativeMethods.QueryFileInfo(file.Path, out var mimePtr, out var size))
+            return file;
+
+        var mime = NativeMethods.PtrToStringNullable(mimePtr);
+        NativeMethods.Free(mimePtr);
+        return file with
+        {
+            MimeType = mime ?? file.MimeType,
+            Size = size >= 0 ? size : file.Size
+        };
+    }
+
+    // ==== Drag-motion coalescing ====
+    // The shim forwards at most one drag update per frame (or per configured interval),
+    // keeping only the latest position and flushing it before leave/drop.
+
+    private ulong _reportedDragMotionDelivered;
+    private ulong _reportedDragMotionSuppressed;
+
+    /// <summary>
+    /// Sets how often coalesced drag-over updates are delivered.
+    /// <see cref="TimeSpan.Zero"/> (the default) delivers at most one update per frame.
+    /// </summary>
+    internal void SetDragMotionCoalescingInterval(TimeSpan interval)
+    {
+        ThrowIfNotInitialized();
+        ArgumentOutOfRangeException.ThrowIfLessThan(interval, TimeSpan.Zero);
+        NativeMethods.SetDragMotionInterval(_native, (int)Math.Min(interval.TotalMilliseconds, int.MaxValue));
+    }
+
+    /// <summary>Cumulative drag-over updates delivered to managed code and suppressed by coalescing.</summary>
+    internal GtkDragMotionStats GetDragMotionStats()
+    {
+        if (_native == IntPtr.Zero || _detached) return default;
+        NativeMethods.GetDragMotionStats(_native, out var delivered, out var suppressed);
+        return new GtkDragMotionStats(delivered, suppressed);
+    }
+
+    private void ReportDragMotionStats()
+    {
+        // A detached view reads zero; there is nothing left to report.
+        if (_native == IntPtr.Zero || _detached) return;
+        var stats = GetDragMotionStats();
+        GtkAdapterMetrics.DragMotionDelivered.Add(AdvanceCounter(stats.Delivered, ref _reportedDragMotionDelivered));
+        GtkAdapterMetrics.DragMotionSuppressed.Add(AdvanceCounter(stats.Suppressed, ref _reportedDragMotionSuppressed));
+    }
+
+    /// <summary>
+    /// Returns how far a cumulative native counter moved since it was last reported and records
+    /// the new value. A counter that went backwards (a fresh native view) yields zero.
+    /// </summary>
+    internal static long AdvanceCounter(ulong current, ref ulong reported)
+    {
+        var delta = current > reported ? current - reported : 0;
+        reported = current;
+        return (long)Math.Min(delta, long.MaxValue);
     }
 
     // ==== Native interop ====
@@ -1138,6 +1403,14 @@ internal sealed partial class GtkWebViewAdapter : IWebViewAdapter, INativeWebVie
             public IntPtr on_drag_updated;
             public IntPtr on_drag_exited;
             public IntPtr on_drop_performed;
+            public IntPtr on_web_process_terminated;
+            public IntPtr on_navigation_timing;
+            public IntPtr on_script_settled;
+            public IntPtr on_script_buffer;
+            public IntPtr on_offscreen_frame;
+            public IntPtr on_download_progress;
+            public IntPtr on_download_finished;
+            public IntPtr on_web_process_hang;
         }
 
         [LibraryImport(LibraryName, EntryPoint = "ag_gtk_create")]
@@ -1175,7 +1448,31 @@ internal sealed partial class GtkWebViewAdapter : IWebViewAdapter, INativeWebVie
 
         [LibraryImport(LibraryName, EntryPoint = "ag_gtk_eval_js", StringMarshalling = StringMarshalling.Utf8)]
         [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
-        internal static partial void EvalJs(IntPtr handle, ulong requestId, string script);
+        internal static partial int EvalJs(IntPtr handle, ulong requestId, string script);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_eval_js_cancel")]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        internal static partial void EvalJsCancel(IntPtr handle, ulong requestId);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_eval_js_buffered", StringMarshalling = StringMarshalling.Utf8)]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        internal static partial int EvalJsBuffered(IntPtr handle, ulong requestId, string script);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_set_eval_buffer_threshold")]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        internal static partial void SetEvalBufferThreshold(IntPtr handle, long thresholdBytes);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_buffer_release")]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        internal static partial void BufferRelease(IntPtr buffer);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_set_eval_limits")]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        internal static partial void SetEvalLimits(IntPtr handle, int maxRunning, int maxQueued, int timeoutMs);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_get_eval_stats")]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        internal static partial void GetEvalStats(IntPtr handle, out int running, out int queued);
 
         [LibraryImport(LibraryName, EntryPoint = "ag_gtk_go_back")]
         [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
@@ -1276,6 +1573,17 @@ internal sealed partial class GtkWebViewAdapter : IWebViewAdapter, INativeWebVie
             delegate* unmanaged[Cdecl]<IntPtr, IntPtr, uint, void> callback,
             IntPtr context);
 
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_capture_full_page")]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        internal static unsafe partial void CaptureFullPage(
+            IntPtr handle,
+            int tileHeight,
+            long maxTileBytes,
+            int encoding,
+            delegate* unmanaged[Cdecl]<IntPtr, int, int, int, int, int, int, byte*, uint, byte> onTile,
+            delegate* unmanaged[Cdecl]<IntPtr, int, int, IntPtr, void> onDone,
+            IntPtr context);
+
         [LibraryImport(LibraryName, EntryPoint = "ag_gtk_print_to_pdf")]
         [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
         internal static unsafe partial void PrintToPdf(
@@ -1308,9 +1616,263 @@ internal sealed partial class GtkWebViewAdapter : IWebViewAdapter, INativeWebVie
         [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
         internal static partial IntPtr AddUserScript(IntPtr handle, string js);
 
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_remove_user_script", StringMarshalling = StringMarshalling.Utf8)]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        [return: MarshalAs(UnmanagedType.I1)]
+        internal static partial bool RemoveUserScript(IntPtr handle, string scriptId);
+
         [LibraryImport(LibraryName, EntryPoint = "ag_gtk_remove_all_user_scripts")]
         [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
         internal static partial void RemoveAllUserScripts(IntPtr handle);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_set_content_filter_store_path", StringMarshalling = StringMarshalling.Utf8)]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        internal static partial void SetContentFilterStorePath(IntPtr handle, string? path);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_content_filter_load_or_compile", StringMarshalling = StringMarshalling.Utf8)]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        internal static unsafe partial void ContentFilterLoadOrCompile(IntPtr handle,
+            string identifier, string? rulesJson,
+            delegate* unmanaged[Cdecl]<IntPtr, byte, byte, long, IntPtr, void> callback,
+            IntPtr context);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_content_filter_remove", StringMarshalling = StringMarshalling.Utf8)]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        internal static partial void ContentFilterRemove(IntPtr handle, string identifier);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_query_file_info", StringMarshalling = StringMarshalling.Utf8)]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        [return: MarshalAs(UnmanagedType.I1)]
+        internal static partial bool QueryFileInfo(string path, out IntPtr mimeUtf8, out long size);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_set_drag_motion_interval")]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        internal static partial void SetDragMotionInterval(IntPtr handle, int intervalMs);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_get_drag_motion_stats")]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        internal static partial void GetDragMotionStats(IntPtr handle, out ulong delivered, out ulong suppressed);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_content_set_define", StringMarshalling = StringMarshalling.Utf8)]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        [return: MarshalAs(UnmanagedType.I1)]
+        internal static partial bool ContentSetDefine(string name,
+            IntPtr[] scripts, int scriptCount, IntPtr[] styleSheets, int styleSheetCount, uint flags);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_content_set_destroy", StringMarshalling = StringMarshalling.Utf8)]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        internal static partial void ContentSetDestroy(string name);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_content_set_attach", StringMarshalling = StringMarshalling.Utf8)]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        [return: MarshalAs(UnmanagedType.I1)]
+        internal static partial bool ContentSetAttach(IntPtr handle, string name);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_content_set_detach", StringMarshalling = StringMarshalling.Utf8)]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        [return: MarshalAs(UnmanagedType.I1)]
+        internal static partial bool ContentSetDetach(IntPtr handle, string name);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_set_data_directories", StringMarshalling = StringMarshalling.Utf8)]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        internal static partial void SetDataDirectories(IntPtr handle, string? dataDir, string? cacheDir);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_set_cache_model")]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        internal static partial void SetCacheModel(IntPtr handle, int cacheModel);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_website_data_fetch")]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        internal static unsafe partial void WebsiteDataFetch(IntPtr handle, uint types,
+            delegate* unmanaged[Cdecl]<IntPtr, byte, int, WebsiteDataEntry*, IntPtr, void> callback,
+            IntPtr context);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_website_data_remove")]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        internal static unsafe partial void WebsiteDataRemove(IntPtr handle, uint types,
+            IntPtr[]? origins, int originCount,
+            delegate* unmanaged[Cdecl]<IntPtr, byte, IntPtr, void> callback,
+            IntPtr context);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_prefetch_dns", StringMarshalling = StringMarshalling.Utf8)]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        internal static partial void PrefetchDns(IntPtr handle, string hostname);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_preload_urls")]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        internal static partial void PreloadUrls(IntPtr handle, IntPtr[] urls, int count);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_get_preload_stats")]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        internal static partial void GetPreloadStats(IntPtr handle, out ulong hits, out ulong misses, out ulong wasted);
+
+        [StructLayout(LayoutKind.Sequential)]
+        internal struct AgGtkPerformanceProfile
+        {
+            public int hardware_acceleration_policy;
+            public int enable_page_cache;
+            public int enable_smooth_scrolling;
+            public int enable_mediasource;
+            public int enable_webgl;
+            public int enable_write_console_messages_to_stdout;
+        }
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_set_javascript_jit")]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        [return: MarshalAs(UnmanagedType.I1)]
+        internal static partial bool SetJavaScriptJit([MarshalAs(UnmanagedType.I1)] bool enabled);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_get_javascript_jit")]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        [return: MarshalAs(UnmanagedType.I1)]
+        internal static partial bool GetJavaScriptJit();
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_set_performance_profile")]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        internal static partial void SetPerformanceProfile(IntPtr handle, in AgGtkPerformanceProfile profile);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_get_effective_settings")]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        internal static partial void GetEffectiveSettings(IntPtr handle, out AgGtkPerformanceProfile profile);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_hibernate")]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        internal static unsafe partial void Hibernate(IntPtr handle, [MarshalAs(UnmanagedType.I1)] bool captureSnapshot,
+            delegate* unmanaged[Cdecl]<IntPtr, byte, IntPtr, void> callback, IntPtr context);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_resume")]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        [return: MarshalAs(UnmanagedType.I1)]
+        internal static partial bool Resume(IntPtr handle);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_set_crash_recovery")]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        internal static partial void SetCrashRecovery(IntPtr handle, [MarshalAs(UnmanagedType.I1)] bool enabled);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_get_crash_stats")]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        internal static partial void GetCrashStats(IntPtr handle, out ulong terminations, out ulong recoveries, out long lastRecoveryUs);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_set_resource_timing")]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        internal static partial void SetResourceTiming(IntPtr handle, [MarshalAs(UnmanagedType.I1)] bool enabled, int capacity);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_clear_resource_timings")]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        internal static partial void ClearResourceTimings(IntPtr handle);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_get_resource_timings")]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        internal static unsafe partial void GetResourceTimings(IntPtr handle,
+            delegate* unmanaged[Cdecl]<IntPtr, int, ResourceTimingNative*, void> callback, IntPtr context);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_set_native_bridge")]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        internal static partial void SetNativeBridge(IntPtr handle, [MarshalAs(UnmanagedType.I1)] bool enabled);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_bridge_is_connected")]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        [return: MarshalAs(UnmanagedType.I1)]
+        internal static partial bool BridgeIsConnected(IntPtr handle);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_bridge_send", StringMarshalling = StringMarshalling.Utf8)]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        [return: MarshalAs(UnmanagedType.I1)]
+        internal static partial bool BridgeSend(IntPtr handle, int kind, string payload);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_publish_blob", StringMarshalling = StringMarshalling.Utf8)]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        internal static unsafe partial int PublishBlob(IntPtr handle, string id, void* data, long length, string? mimeType,
+            delegate* unmanaged[Cdecl]<IntPtr, void> release, IntPtr context);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_revoke_blob", StringMarshalling = StringMarshalling.Utf8)]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        [return: MarshalAs(UnmanagedType.I1)]
+        internal static partial bool RevokeBlob(IntPtr handle, string id);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_get_pending_ops")]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        internal static unsafe partial void GetPendingOps(IntPtr handle,
+            delegate* unmanaged[Cdecl]<IntPtr, PendingOpNative*, int, void> callback, IntPtr context);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_set_offscreen_rendering")]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        internal static partial void SetOffscreenRendering(IntPtr handle, [MarshalAs(UnmanagedType.I1)] bool enabled, int width, int height);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_offscreen_resize")]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        internal static partial void OffscreenResize(IntPtr handle, int width, int height);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_offscreen_acquire_frame")]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        [return: MarshalAs(UnmanagedType.I1)]
+        internal static partial bool OffscreenAcquireFrame(IntPtr handle, out OffscreenFrameNative frame);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_offscreen_release_frame")]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        internal static partial void OffscreenReleaseFrame(IntPtr handle);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_offscreen_get_stats")]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        internal static partial void OffscreenGetStats(IntPtr handle, out ulong published, out ulong dropped);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_offscreen_send_input")]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        [return: MarshalAs(UnmanagedType.I1)]
+        internal static partial bool OffscreenSendInput(IntPtr handle, in InputEventNative input);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_download_set_destination", StringMarshalling = StringMarshalling.Utf8)]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        [return: MarshalAs(UnmanagedType.I1)]
+        internal static partial bool DownloadSetDestination(IntPtr handle, ulong downloadId, string path);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_download_cancel")]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        [return: MarshalAs(UnmanagedType.I1)]
+        internal static partial bool DownloadCancel(IntPtr handle, ulong downloadId);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_set_download_progress_interval")]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        internal static partial void SetDownloadProgressInterval(IntPtr handle, int intervalMs);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_get_resource_stats")]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        internal static partial void GetResourceStats(out ResourceStatsNative stats);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_scheme_body_read")]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        internal static unsafe partial long SchemeBodyRead(IntPtr body, byte* buffer, int size);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_scheme_body_close")]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        internal static partial void SchemeBodyClose(IntPtr body);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_scheme_request_respond", StringMarshalling = StringMarshalling.Utf8)]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        [return: MarshalAs(UnmanagedType.I1)]
+        internal static unsafe partial bool SchemeRequestRespond(IntPtr handle, ulong requestId, byte* data, long length, string mimeType, int statusCode, string? allowOrigin);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_scheme_request_fail", StringMarshalling = StringMarshalling.Utf8)]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        [return: MarshalAs(UnmanagedType.I1)]
+        internal static partial bool SchemeRequestFail(IntPtr handle, ulong requestId, int statusCode, string message);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_set_fetch_bridge", StringMarshalling = StringMarshalling.Utf8)]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        [return: MarshalAs(UnmanagedType.I1)]
+        internal static partial bool SetFetchBridge(IntPtr handle, string? scheme, string? host);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_set_hang_policy")]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        internal static partial void SetHangPolicy(IntPtr handle, long terminateAfterMs);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_set_activity_state")]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        internal static partial void SetActivityState(IntPtr handle, int activityState);
+
+        [LibraryImport(LibraryName, EntryPoint = "ag_gtk_free")]
+        [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+        internal static partial void Free(IntPtr ptr);
     }
 
     // ==================== ICommandAdapter ====================
@@ -1344,7 +1906,7 @@ internal sealed partial class GtkWebViewAdapter : IWebViewAdapter, INativeWebVie
         {
             NativeMethods.CaptureScreenshot(_native, &OnScreenshotComplete, GCHandle.ToIntPtr(handle));
         }
-        return tcs.Task;
+        return TrackInFlight(tcs);
     }
 
     [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvCdecl) })]
@@ -1365,29 +1927,161 @@ internal sealed partial class GtkWebViewAdapter : IWebViewAdapter, INativeWebVie
         tcs.TrySetResult(buffer);
     }
 
-    // ==================== IPrintAdapter ====================
-
-    public Task<byte[]> PrintToPdfAsync(PdfPrintOptions? options)
+    // ==================== Full-document capture ====================
+    // The shim scrolls the page a viewport at a time and cuts each visible snapshot into tiles,
+    // so a very tall page costs one viewport surface plus one tile instead of a surface the size
+    // of the document. Tiles arrive on the GTK thread in document order.
+
+    private const int FullPageCompleted = 0;
+    private const int FullPageCancelled = 1;
+
+    /// <summary>
+    /// Captures the whole document, handing each tile to <paramref name="onTile"/>. Cancelling
+    /// stops the capture before the next tile; an exception from <paramref name="onTile"/> stops
+    /// it and faults the task. <paramref name="progress"/> reports the fraction of rows captured.
+    /// </summary>
+    internal Task<FullPageCaptureResult> CaptureFullPageAsync(GtkScreenshotTileHandler onTile,
+        GtkFullPageCaptureOptions? options = null, IProgress<double>? progress = null, CancellationToken cancellationToken = default)
     {
+        ArgumentNullException.ThrowIfNull(onTile);
         ThrowIfNotAttached();
-        var tcs = new TaskCompletionSource<byte[]>(TaskCreationOptions.RunContinuationsAsynchronously);
-        var handle = GCHandle.Alloc(tcs);
-
+        options ??= new GtkFullPageCaptureOptions();
+        if (options.TileHeight < 0 || options.MaxTileBytes < 0)
+            throw new ArgumentOutOfRangeException(nameof(options), "Tile height and size limits cannot be negative.");
+        if (cancellationToken.IsCancellationRequested)
+            return Task.FromCanceled<FullPageCaptureResult>(cancellationToken);
+
+        var capture = new FullPageCapture(onTile, options.Encoding, progress, cancellationToken);
+        var handle = GCHandle.Alloc(capture);
         unsafe
         {
-            NativeMethods.PrintToPdf(_native, &OnPdfComplete, GCHandle.ToIntPtr(handle));
+            NativeMethods.CaptureFullPage(_native, options.TileHeight, options.MaxTileBytes, (int)options.Encoding,
+                &OnFullPageTile, &OnFullPageDone, GCHandle.ToIntPtr(handle));
         }
-        return tcs.Task;
+        return TrackInFlight(capture.Completion);
     }
 
-    [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvCdecl) })]
-    private static void OnPdfComplete(IntPtr context, IntPtr pdfData, uint pdfLen)
+    /// <summary>
+    /// Captures the whole document into a PNG file, which is deleted if the capture fails.
+    /// </summary>
+    internal async Task<FullPageCaptureResult> CaptureFullPageToFileAsync(string path,
+        GtkFullPageCaptureOptions? options = null, IProgress<double>? progress = null, CancellationToken cancellationToken = default)
     {
-        var gcHandle = GCHandle.FromIntPtr(context);
-        var tcs = (TaskCompletionSource<byte[]>)gcHandle.Target!;
-        gcHandle.Free();
+        ArgumentException.ThrowIfNullOrEmpty(path);
 
-        if (pdfData == IntPtr.Zero || pdfLen == 0)
+        await using var stream = new FileStream(path, FileMode.Create, FileAccess.Write, FileShare.None, bufferSize: 64 * 1024);
+        try
+        {
+            return await CaptureFullPageToStreamAsync(stream, options, progress, cancellationToken).ConfigureAwait(false);
+        }
+        catch
+        {
+            stream.Dispose();
+            File.Delete(path);
+            throw;
+        }
+    }
+
+    /// <summary>
+    /// Captures the whole document as one PNG written to <paramref name="destination"/>. Raw tiles
+    /// are copied on the GTK thread and encoded by <see cref="GtkPngTileWriter"/> on the thread
+    /// pool. A failed capture may leave a partial image in the stream.
+    /// </summary>
+    internal async Task<FullPageCaptureResult> CaptureFullPageToStreamAsync(Stream destination,
+        GtkFullPageCaptureOptions? options = null, IProgress<double>? progress = null, CancellationToken cancellationToken = default)
+    {
+        ArgumentNullException.ThrowIfNull(destination);
+        options = (options ?? new GtkFullPageCaptureOptions()) with { Encoding = GtkTileEncoding.Raw };
+
+        await using var writer = new GtkPngTileWriter(destination);
+        var result = await CaptureFullPageAsync(writer.Add, options, progress, cancellationToken).ConfigureAwait(false);
+        await writer.CompleteAsync().ConfigureAwait(false);
+        return result;
+    }
+
+    Task<FullPageCaptureResult> IFullPageCaptureAdapter.CaptureFullPageAsync(Stream destination, IProgress<double>? progress,
+        CancellationToken cancellationToken)
+        => CaptureFullPageToStreamAsync(destination, options: null, progress, cancellationToken);
+
+    private sealed class FullPageCapture(GtkScreenshotTileHandler onTile, GtkTileEncoding encoding,
+        IProgress<double>? progress, CancellationToken cancellationToken)
+    {
+        public GtkScreenshotTileHandler OnTile { get; } = onTile;
+        public GtkTileEncoding Encoding { get; } = encoding;
+        public IProgress<double>? Progress { get; } = progress;
+        public CancellationToken CancellationToken { get; } = cancellationToken;
+        public TaskCompletionSource<FullPageCaptureResult> Completion { get; } = new(TaskCreationOptions.RunContinuationsAsynchronously);
+        public Exception? Error { get; set; }
+        public int Width { get; set; }
+        public int TotalHeight { get; set; }
+    }
+
+    [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvCdecl) })]
+    private static unsafe byte OnFullPageTile(IntPtr context, int index, int y, int width, int height, int totalHeight,
+        int stride, byte* data, uint length)
+    {
+        var capture = (FullPageCapture)GCHandle.FromIntPtr(context).Target!;
+        if (capture.CancellationToken.IsCancellationRequested || capture.Completion.Task.IsCompleted)
+            return 0;
+
+        try
+        {
+            capture.OnTile(new GtkScreenshotTile(index, y, width, height, totalHeight, stride, capture.Encoding,
+                new ReadOnlySpan<byte>(data, (int)length)));
+        }
+        catch (Exception ex)
+        {
+            capture.Error = ex;
+            return 0;
+        }
+
+        capture.Width = width;
+        capture.TotalHeight = totalHeight;
+        capture.Progress?.Report(totalHeight > 0 ? (double)(y + height) / totalHeight : 1.0);
+        return 1;
+    }
+
+    [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvCdecl) })]
+    private static void OnFullPageDone(IntPtr context, int status, int tiles, IntPtr errorUtf8)
+    {
+        var handle = GCHandle.FromIntPtr(context);
+        var capture = (FullPageCapture)handle.Target!;
+        handle.Free();
+
+        if (capture.Error is not null)
+            capture.Completion.TrySetException(capture.Error);
+        else if (status == FullPageCompleted)
+            capture.Completion.TrySetResult(new FullPageCaptureResult(capture.Width, capture.TotalHeight, tiles));
+        else if (status == FullPageCancelled && capture.CancellationToken.IsCancellationRequested)
+            capture.Completion.TrySetCanceled(capture.CancellationToken);
+        else
+            capture.Completion.TrySetException(new InvalidOperationException(
+                $"Full-page capture failed: {NativeMethods.PtrToStringNullable(errorUtf8) ?? "cancelled"}"));
+    }
+
+    // ==================== IPrintAdapter ====================
+
+    public Task<byte[]> PrintToPdfAsync(PdfPrintOptions? options)
+    {
+        ThrowIfNotAttached();
+        var tcs = new TaskCompletionSource<byte[]>(TaskCreationOptions.RunContinuationsAsynchronously);
+        var handle = GCHandle.Alloc(tcs);
+
+        unsafe
+        {
+            NativeMethods.PrintToPdf(_native, &OnPdfComplete, GCHandle.ToIntPtr(handle));
+        }
+        return TrackInFlight(tcs);
+    }
+
+    [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvCdecl) })]
+    private static void OnPdfComplete(IntPtr context, IntPtr pdfData, uint pdfLen)
+    {
+        var gcHandle = GCHandle.FromIntPtr(context);
+        var tcs = (TaskCompletionSource<byte[]>)gcHandle.Target!;
+        gcHandle.Free();
+
+        if (pdfData == IntPtr.Zero || pdfLen == 0)
         {
             tcs.TrySetException(new InvalidOperationException("PDF printing failed or is not supported on this platform."));
             return;
@@ -1413,7 +2107,7 @@ internal sealed partial class GtkWebViewAdapter : IWebViewAdapter, INativeWebVie
         {
             NativeMethods.FindText(_native, text, caseSensitive, forward, &OnFindComplete, GCHandle.ToIntPtr(handle));
         }
-        return tcs.Task;
+        return TrackInFlight(tcs);
     }
 
     [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvCdecl) })]
@@ -1453,7 +2147,7 @@ internal sealed partial class GtkWebViewAdapter : IWebViewAdapter, INativeWebVie
 
     // ==================== IPreloadScriptAdapter ====================
 
-    private readonly Dictionary<string, string> _preloadScripts = new();
+    private readonly HashSet<string> _preloadScriptIds = new(StringComparer.Ordinal);
 
     public string AddPreloadScript(string javaScript)
     {
@@ -1463,21 +2157,15 @@ internal sealed partial class GtkWebViewAdapter : IWebViewAdapter, INativeWebVie
             throw new InvalidOperationException("Failed to add user script.");
         var scriptId = Marshal.PtrToStringUTF8(ptr)!;
         Marshal.FreeHGlobal(ptr);
-        _preloadScripts[scriptId] = javaScript;
+        _preloadScriptIds.Add(scriptId);
         return scriptId;
     }
 
     public void RemovePreloadScript(string scriptId)
     {
         if (_native == IntPtr.Zero || _detached) return;
-        if (_preloadScripts.Remove(scriptId))
-        {
-            NativeMethods.RemoveAllUserScripts(_native);
-            foreach (var remaining in _preloadScripts.Values)
-            {
-                NativeMethods.AddUserScript(_native, remaining);
-            }
-        }
+        if (_preloadScriptIds.Remove(scriptId))
+            NativeMethods.RemoveUserScript(_native, scriptId);
     }
 
     // ==================== IContextMenuAdapter ====================
@@ -1530,4 +2218,1887 @@ internal sealed partial class GtkWebViewAdapter : IWebViewAdapter, INativeWebVie
 
     public bool IsDevToolsOpen
         => _native != IntPtr.Zero && !_detached && NativeMethods.IsDevToolsOpen(_native);
+
+    // ==================== Content filters ====================
+    // Compiled WebKit content-blocker rule lists are enforced in the web process, so they
+    // cover subresources as well as navigations. Compiled filters are cached on disk under a
+    // store identifier that includes a hash of the rules, so edited rule lists recompile.
+
+    private readonly Dictionary<string, string> _contentFilterStoreIds = new(StringComparer.Ordinal);
+
+    /// <summary>Sets the directory for compiled content filters; defaults to the user cache dir.</summary>
+    internal void SetContentFilterStorePath(string? path)
+    {
+        ThrowIfNotInitialized();
+        if (_attached)
+            throw new InvalidOperationException("The content filter store path must be set before Attach.");
+        NativeMethods.SetContentFilterStorePath(_native, path);
+    }
+
+    /// <summary>
+    /// Loads the compiled form of <paramref name="rulesJson"/> from the store, compiling and
+    /// persisting it on a miss, and applies it to this view (now, or at Attach).
+    /// </summary>
+    public Task<ContentFilterResult> LoadOrCompileContentFilterAsync(string identifier, string rulesJson)
+    {
+        ArgumentException.ThrowIfNullOrEmpty(identifier);
+        ArgumentNullException.ThrowIfNull(rulesJson);
+        ThrowIfNotInitialized();
+        ObjectDisposedException.ThrowIf(_detached, nameof(GtkWebViewAdapter));
+
+        var ruleCount = CountContentFilterRules(rulesJson);
+        var storeId = ContentFilterStoreId(identifier, rulesJson);
+
+        if (_contentFilterStoreIds.TryGetValue(identifier, out var previous) && previous != storeId)
+            NativeMethods.ContentFilterRemove(_native, previous);
+        _contentFilterStoreIds[identifier] = storeId;
+
+        var request = new ContentFilterRequest(identifier, ruleCount);
+        var handle = GCHandle.Alloc(request);
+
+        unsafe
+        {
+            NativeMethods.ContentFilterLoadOrCompile(_native, storeId, rulesJson,
+                &OnContentFilterComplete, GCHandle.ToIntPtr(handle));
+        }
+        return request.Completion.Task;
+    }
+
+    /// <summary>Detaches a previously loaded content filter from this view.</summary>
+    public void RemoveContentFilter(string identifier)
+    {
+        if (_native == IntPtr.Zero || _detached) return;
+        if (_contentFilterStoreIds.Remove(identifier, out var storeId))
+            NativeMethods.ContentFilterRemove(_native, storeId);
+    }
+
+    /// <summary>Store identifier for a rule list: edited rules get a new id and so recompile.</summary>
+    internal static string ContentFilterStoreId(string identifier, string rulesJson)
+        => identifier + "-" + Convert.ToHexString(
+            System.Security.Cryptography.SHA256.HashData(System.Text.Encoding.UTF8.GetBytes(rulesJson)), 0, 8);
+
+    internal sealed class ContentFilterRequest(string identifier, int ruleCount)
+    {
+        public string Identifier { get; } = identifier;
+        public int RuleCount { get; } = ruleCount;
+        public TaskCompletionSource<ContentFilterResult> Completion { get; } =
+            new(TaskCreationOptions.RunContinuationsAsynchronously);
+
+        /// <summary>
+        /// Settles the request from the shim's single report: the store's result, or the
+        /// <c>"Detached"</c> failure when the view went away while the store was still working.
+        /// </summary>
+        public void Complete(bool success, bool fromCache, long elapsedUs, string? error)
+        {
+            if (!success)
+            {
+                Completion.TrySetException(new InvalidOperationException(
+                    $"Content filter '{Identifier}' could not be loaded: {error}"));
+                return;
+            }
+
+            var elapsed = TimeSpan.FromMicroseconds(elapsedUs);
+            var cacheTag = new KeyValuePair<string, object?>("from_cache", fromCache);
+            GtkAdapterMetrics.ContentFilterLoadMs.Record(elapsed.TotalMilliseconds, cacheTag);
+            GtkAdapterMetrics.ContentFilterRuleCount.Record(RuleCount, cacheTag);
+
+            Completion.TrySetResult(new ContentFilterResult(Identifier, RuleCount, fromCache, elapsed));
+        }
+    }
+
+    [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvCdecl) })]
+    private static void OnContentFilterComplete(IntPtr context, byte success, byte fromCache, long elapsedUs, IntPtr errorUtf8)
+    {
+        var handle = GCHandle.FromIntPtr(context);
+        var request = (ContentFilterRequest)handle.Target!;
+        handle.Free();
+
+        request.Complete(success != 0, fromCache != 0, elapsedUs, NativeMethods.PtrToString(errorUtf8));
+    }
+
+    internal static int CountContentFilterRules(string rulesJson)
+    {
+        // Content-blocker lists are a top-level JSON array of rule objects; count its elements
+        // without materializing a DOM.
+        var reader = new System.Text.Json.Utf8JsonReader(System.Text.Encoding.UTF8.GetBytes(rulesJson));
+        if (!reader.Read() || reader.TokenType != System.Text.Json.JsonTokenType.StartArray)
+            throw new ArgumentException("Content filter rules must be a JSON array.", nameof(rulesJson));
+
+        var count = 0;
+        while (reader.Read() && reader.TokenType != System.Text.Json.JsonTokenType.EndArray)
+        {
+            count++;
+            reader.Skip();
+        }
+        return count;
+    }
+
+    // ==================== Shared content sets ====================
+    // A named set of user scripts and style sheets is created once in the shim and attached to
+    // any number of views, so a large preload bundle is not re-copied per WebView. Redefining a
+    // set swaps it in every attached view at once; pages loaded afterwards see only the new set.
+
+    /// <summary>
+    /// Defines or atomically replaces the process-wide content set <paramref name="name"/>.
+    /// Views that already have the set attached pick up the new contents for their next document.
+    /// </summary>
+    internal static void DefineSharedContentSet(string name, IReadOnlyList<string> scripts,
+        IReadOnlyList<string>? styleSheets = null, SharedContentSetOptions options = SharedContentSetOptions.None)
+    {
+        ArgumentException.ThrowIfNullOrEmpty(name);
+        ArgumentNullException.ThrowIfNull(scripts);
+        styleSheets ??= Array.Empty<string>();
+
+        var scriptPtrs = new IntPtr[scripts.Count];
+        var stylePtrs = new IntPtr[styleSheets.Count];
+        try
+        {
+            for (var i = 0; i < scriptPtrs.Length; i++)
+                scriptPtrs[i] = Marshal.StringToCoTaskMemUTF8(scripts[i]);
+            for (var i = 0; i < stylePtrs.Length; i++)
+                stylePtrs[i] = Marshal.StringToCoTaskMemUTF8(styleSheets[i]);
+
+            // SharedContentSetOptions values match the shim's flags.
+            if (!NativeMethods.ContentSetDefine(name, scriptPtrs, scriptPtrs.Length, stylePtrs, stylePtrs.Length, (uint)options))
+                throw new InvalidOperationException($"Failed to define content set '{name}'.");
+        }
+        finally
+        {
+            foreach (var ptr in scriptPtrs)
+                Marshal.FreeCoTaskMem(ptr);
+            foreach (var ptr in stylePtrs)
+                Marshal.FreeCoTaskMem(ptr);
+        }
+    }
+
+    /// <summary>Removes the content set from every view it is attached to and releases it.</summary>
+    internal static void DestroySharedContentSet(string name)
+    {
+        ArgumentException.ThrowIfNullOrEmpty(name);
+        NativeMethods.ContentSetDestroy(name);
+    }
+
+    void ISharedContentSetAdapter.DefineSharedContentSet(string name, IReadOnlyList<string> scripts,
+        IReadOnlyList<string>? styleSheets, SharedContentSetOptions options)
+        => DefineSharedContentSet(name, scripts, styleSheets, options);
+
+    void ISharedContentSetAdapter.DestroySharedContentSet(string name) => DestroySharedContentSet(name);
+
+    /// <summary>Attaches a defined content set to this view (now, or at Attach).</summary>
+    public void AttachSharedContentSet(string name)
+    {
+        ArgumentException.ThrowIfNullOrEmpty(name);
+        ThrowIfNotInitialized();
+        ObjectDisposedException.ThrowIf(_detached, nameof(GtkWebViewAdapter));
+        if (!NativeMethods.ContentSetAttach(_native, name))
+            throw new InvalidOperationException($"Content set '{name}' is not defined.");
+    }
+
+    public void DetachSharedContentSet(string name)
+    {
+        if (_native == IntPtr.Zero || _detached) return;
+        NativeMethods.ContentSetDetach(_native, name);
+    }
+
+    // ==================== Website data ====================
+    // Views configured with explicit data/cache directories get a WebKitWebsiteDataManager rooted
+    // there (shared by views with the same directories). Usage is reported per origin so callers
+    // can keep caches warm while trimming the origins that grow past a budget.
+
+    /// <summary>
+    /// Roots persistent website data and caches at the given directories; <c>null</c> keeps
+    /// WebKit's default for that kind. Ignored for ephemeral sessions. Must be set before Attach.
+    /// </summary>
+    internal void SetWebsiteDataDirectories(string? dataDirectory, string? cacheDirectory)
+    {
+        ThrowIfNotInitialized();
+        if (_attached)
+            throw new InvalidOperationException("Website data directories must be set before Attach.");
+        NativeMethods.SetDataDirectories(_native, dataDirectory, cacheDirectory);
+    }
+
+    /// <summary>Sets the cache model applied to this view's context at Attach.</summary>
+    internal void SetCacheModel(WebViewCacheModel cacheModel)
+    {
+        ThrowIfNotInitialized();
+        if (_attached)
+            throw new InvalidOperationException("The cache model must be set before Attach.");
+        // WebViewCacheModel values match WebKitCacheModel.
+        NativeMethods.SetCacheModel(_native, (int)cacheModel);
+    }
+
+    /// <summary>Fetches per-origin usage for the requested data categories.</summary>
+    public Task<IReadOnlyList<WebsiteDataUsage>> FetchWebsiteDataUsageAsync(WebsiteDataTypes types = WebsiteDataTypes.All)
+    {
+        ThrowIfNotAttachedForCookies();
+        var tcs = new TaskCompletionSource<IReadOnlyList<WebsiteDataUsage>>(TaskCreationOptions.RunContinuationsAsynchronously);
+        var handle = GCHandle.Alloc(tcs);
+
+        unsafe
+        {
+            NativeMethods.WebsiteDataFetch(_native, (uint)types, &OnWebsiteDataFetched, GCHandle.ToIntPtr(handle));
+        }
+        return tcs.Task;
+    }
+
+    /// <summary>
+    /// Removes the given data categories for <paramref name="origins"/> (as reported by
+    /// <see cref="FetchWebsiteDataUsageAsync"/>), or for every origin when <c>null</c>.
+    /// </summary>
+    public Task RemoveWebsiteDataAsync(WebsiteDataTypes types, IReadOnlyCollection<string>? origins = null)
+    {
+        ThrowIfNotAttachedForCookies();
+        if (origins is { Count: 0 })
+            return Task.CompletedTask;
+
+        var tcs = new TaskCompletionSource();
+        var handle = GCHandle.Alloc(tcs);
+        var originPtrs = origins?.Select(Marshal.StringToCoTaskMemUTF8).ToArray();
+        try
+        {
+            unsafe
+            {
+                NativeMethods.WebsiteDataRemove(_native, (uint)types, originPtrs, originPtrs?.Length ?? 0,
+                    &CookieOpTrampoline, GCHandle.ToIntPtr(handle));
+            }
+        }
+        finally
+        {
+            if (originPtrs is not null)
+            {
+                foreach (var ptr in originPtrs)
+                    Marshal.FreeCoTaskMem(ptr);
+            }
+        }
+        return tcs.Task;
+    }
+
+    private const int WebsiteDataTypeSlots = 16;
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal unsafe struct WebsiteDataEntry
+    {
+        public IntPtr Name;
+        public uint Types;
+        public fixed ulong Sizes[WebsiteDataTypeSlots];
+    }
+
+    [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvCdecl) })]
+    private static unsafe void OnWebsiteDataFetched(IntPtr context, byte success, int count, WebsiteDataEntry* entries, IntPtr errorUtf8)
+    {
+        var handle = GCHandle.FromIntPtr(context);
+        var tcs = (TaskCompletionSource<IReadOnlyList<WebsiteDataUsage>>)handle.Target!;
+        handle.Free();
+
+        if (success == 0)
+        {
+            tcs.TrySetException(new InvalidOperationException(NativeMethods.PtrToString(errorUtf8)));
+            return;
+        }
+
+        var result = new WebsiteDataUsage[count];
+        for (var i = 0; i < count; i++)
+        {
+            result[i] = CreateWebsiteDataUsage(
+                NativeMethods.PtrToString(entries[i].Name),
+                entries[i].Types,
+                new ReadOnlySpan<ulong>(entries[i].Sizes, WebsiteDataTypeSlots));
+        }
+        tcs.TrySetResult(result);
+    }
+
+    internal static WebsiteDataUsage CreateWebsiteDataUsage(string origin, uint types, ReadOnlySpan<ulong> sizesByBit)
+    {
+        var sizes = new Dictionary<WebsiteDataTypes, long>();
+        for (var bit = 0; bit < sizesByBit.Length; bit++)
+        {
+            var type = (WebsiteDataTypes)(1u << bit);
+            if ((types & (uint)type) != 0 && sizesByBit[bit] > 0)
+                sizes[type] = (long)sizesByBit[bit];
+        }
+        return new WebsiteDataUsage(origin, (WebsiteDataTypes)types, sizes);
+    }
+
+    // ==================== DNS prefetch and preloading ====================
+    // Likely next URLs load in a hidden view on the same WebKit context, warming DNS, connections
+    // and the HTTP cache. NavigateAsync to a preloaded URL counts as a hit; hit/miss/wasted
+    // deltas are published to GtkAdapterMetrics after each navigation.
+
+    private bool _preloadRequested;
+    private ulong _reportedPreloadHits;
+    private ulong _reportedPreloadMisses;
+    private ulong _reportedPreloadWasted;
+
+    /// <summary>Resolves <paramref name="hostname"/> ahead of the first request to it.</summary>
+    public void PrefetchDns(string hostname)
+    {
+        ArgumentException.ThrowIfNullOrEmpty(hostname);
+        ThrowIfNotAttached();
+        NativeMethods.PrefetchDns(_native, hostname);
+    }
+
+    /// <summary>
+    /// Replaces the speculative preload queue with <paramref name="uris"/> (at most 8 are kept),
+    /// loading them one at a time in a hidden view. Only http(s) URIs are preloaded; the hidden
+    /// view does not open windows, serve custom schemes or follow script navigations off-host.
+    /// </summary>
+    public void PreloadUris(IReadOnlyList<Uri> uris)
+    {
+        ArgumentNullException.ThrowIfNull(uris);
+        ThrowIfNotAttached();
+
+        var preloadable = uris.Where(IsPreloadableUri).ToArray();
+        var ptrs = new IntPtr[preloadable.Length];
+        try
+        {
+            for (var i = 0; i < ptrs.Length; i++)
+                ptrs[i] = Marshal.StringToCoTaskMemUTF8(preloadable[i].AbsoluteUri);
+            NativeMethods.PreloadUrls(_native, ptrs, ptrs.Length);
+        }
+        finally
+        {
+            foreach (var ptr in ptrs)
+                Marshal.FreeCoTaskMem(ptr);
+        }
+        _preloadRequested = true;
+    }
+
+    /// <summary>Preloading warms the HTTP cache, so only absolute http(s) URIs qualify.</summary>
+    internal static bool IsPreloadableUri(Uri uri)
+        => uri.IsAbsoluteUri && (uri.Scheme == Uri.UriSchemeHttp || uri.Scheme == Uri.UriSchemeHttps);
+
+    /// <summary>Returns cumulative preload hit/miss counts for this view.</summary>
+    public PreloadStats GetPreloadStats()
+    {
+        if (_native == IntPtr.Zero || _detached)
+            return new PreloadStats(_reportedPreloadHits, _reportedPreloadMisses, _reportedPreloadWasted);
+        NativeMethods.GetPreloadStats(_native, out var hits, out var misses, out var wasted);
+        return new PreloadStats(hits, misses, wasted);
+    }
+
+    private void ReportPreloadStats()
+    {
+        var stats = GetPreloadStats();
+        GtkAdapterMetrics.PreloadHits.Add(AdvanceCounter(stats.Hits, ref _reportedPreloadHits));
+        GtkAdapterMetrics.PreloadMisses.Add(AdvanceCounter(stats.Misses, ref _reportedPreloadMisses));
+        GtkAdapterMetrics.PreloadWasted.Add(AdvanceCounter(stats.Wasted, ref _reportedPreloadWasted));
+    }
+
+    // ==================== Performance profile ====================
+
+    /// <summary>
+    /// Applies <paramref name="profile"/> at Attach, or immediately (on the GTK thread) when
+    /// already attached. Unset values keep their current setting.
+    /// </summary>
+    internal void SetPerformanceProfile(GtkPerformanceProfile profile)
+    {
+        ArgumentNullException.ThrowIfNull(profile);
+        ThrowIfNotInitialized();
+        ObjectDisposedException.ThrowIf(_detached, nameof(GtkWebViewAdapter));
+        var native = ToNativeProfile(profile);
+        NativeMethods.SetPerformanceProfile(_native, in native);
+    }
+
+    /// <summary>
+    /// Returns the settings in effect on the attached view (every value set), or the stored
+    /// profile before Attach.
+    /// </summary>
+    internal GtkPerformanceProfile GetEffectivePerformanceSettings()
+    {
+        ThrowIfNotInitialized();
+        ObjectDisposedException.ThrowIf(_detached, nameof(GtkWebViewAdapter));
+        NativeMethods.GetEffectiveSettings(_native, out var native);
+        return FromNativeProfile(native);
+    }
+
+    /// <summary>
+    /// Enables or disables the JavaScriptCore JIT for every web process. It is a process-wide
+    /// option read from the environment, so it can only be set before the first GTK view is
+    /// created; later calls throw.
+    /// </summary>
+    internal static void SetJavaScriptJit(bool enabled)
+    {
+        if (!NativeMethods.SetJavaScriptJit(enabled))
+            throw new InvalidOperationException("The JavaScript JIT must be configured before the first WebView is created.");
+    }
+
+    /// <summary>Whether web processes run with the JavaScript JIT.</summary>
+    internal static bool IsJavaScriptJitEnabled => NativeMethods.GetJavaScriptJit();
+
+    private static NativeMethods.AgGtkPerformanceProfile ToNativeProfile(GtkPerformanceProfile profile)
+    {
+        static int Tri(bool? value) => value is null ? -1 : value.Value ? 1 : 0;
+        return new NativeMethods.AgGtkPerformanceProfile
+        {
+            hardware_acceleration_policy = profile.HardwareAccelerationPolicy is { } policy ? (int)policy : -1,
+            enable_page_cache = Tri(profile.EnablePageCache),
+            enable_smooth_scrolling = Tri(profile.EnableSmoothScrolling),
+            enable_mediasource = Tri(profile.EnableMediaSource),
+            enable_webgl = Tri(profile.EnableWebGL),
+            enable_write_console_messages_to_stdout = Tri(profile.EnableWriteConsoleMessagesToStdout),
+        };
+    }
+
+    private static GtkPerformanceProfile FromNativeProfile(in NativeMethods.AgGtkPerformanceProfile native)
+    {
+        static bool? Tri(int value) => value < 0 ? null : value != 0;
+        return new GtkPerformanceProfile
+        {
+            HardwareAccelerationPolicy = native.hardware_acceleration_policy < 0
+                ? null
+                : (GtkHardwareAccelerationPolicy)native.hardware_acceleration_policy,
+            EnablePageCache = Tri(native.enable_page_cache),
+            EnableSmoothScrolling = Tri(native.enable_smooth_scrolling),
+            EnableMediaSource = Tri(native.enable_mediasource),
+            EnableWebGL = Tri(native.enable_webgl),
+            EnableWriteConsoleMessagesToStdout = Tri(native.enable_write_console_messages_to_stdout),
+        };
+    }
+
+    /// <summary>Passes a profile through the native struct and back, as Set/GetEffective do.</summary>
+    internal static GtkPerformanceProfile TestOnly_RoundTripNativeProfile(GtkPerformanceProfile profile)
+    {
+        var native = ToNativeProfile(profile);
+        return FromNativeProfile(native);
+    }
+
+    // ==================== Hibernation ====================
+    // A hibernated view keeps its plug, content manager and context but not its WebKitWebView,
+    // so the web process exits. The shim restores the back/forward session and scroll position
+    // on resume without raising navigation events for the reload. HibernationManager decides
+    // which views to hibernate: a view counts against it from Attach, and becoming visible marks
+    // it active (resuming it) and trims the least recently active others.
+
+    private volatile bool _hibernated;
+
+    public bool IsHibernated => _hibernated;
+
+    /// <summary>
+    /// Budget this view is hibernated under; set before <see cref="Attach"/>, normally from
+    /// <see cref="IWebViewEnvironmentOptions.HibernationMemoryBudgetBytes"/>. Null opts out.
+    /// </summary>
+    internal GtkHibernationManager? HibernationManager { get; set; }
+
+    public Task HibernateAsync(bool captureSnapshot)
+    {
+        ThrowIfNotInitialized();
+        ObjectDisposedException.ThrowIf(_detached, nameof(GtkWebViewAdapter));
+        if (!_attached)
+            throw new InvalidOperationException("Adapter must be attached before use.");
+        if (_hibernated)
+            return Task.CompletedTask;
+
+        var request = new HibernateRequest(this);
+        var handle = GCHandle.Alloc(request);
+        unsafe
+        {
+            NativeMethods.Hibernate(_native, captureSnapshot, &OnHibernateComplete, GCHandle.ToIntPtr(handle));
+        }
+        return request.Completion.Task;
+    }
+
+    public void Resume()
+    {
+        if (!_hibernated || _native == IntPtr.Zero || _detached) return;
+        if (!NativeMethods.Resume(_native))
+            throw new InvalidOperationException("Native WebKitGTK shim failed to resume the hibernated view.");
+        _hibernated = false;
+    }
+
+    private sealed class HibernateRequest(GtkWebViewAdapter adapter)
+    {
+        public GtkWebViewAdapter Adapter { get; } = adapter;
+        public TaskCompletionSource Completion { get; } = new(TaskCreationOptions.RunContinuationsAsynchronously);
+    }
+
+    [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvCdecl) })]
+    private static void OnHibernateComplete(IntPtr context, byte success, IntPtr errorUtf8)
+    {
+        var handle = GCHandle.FromIntPtr(context);
+        var request = (HibernateRequest)handle.Target!;
+        handle.Free();
+
+        if (success == 0)
+        {
+            request.Completion.TrySetException(new InvalidOperationException(
+                $"Hibernation failed: {NativeMethods.PtrToString(errorUtf8)}"));
+            return;
+        }
+
+        request.Adapter._hibernated = true;
+        request.Completion.TrySetResult();
+    }
+
+    private static void ObserveHibernation(Task task)
+        => task.ContinueWith(static t => _ = t.Exception, CancellationToken.None,
+            TaskContinuationOptions.OnlyOnFaulted, TaskScheduler.Default);
+
+    // ==================== Activity state ====================
+    // A view the host stops showing is throttled at once and suspended once it has stayed
+    // hidden for SuspendAfterHidden; showing it again makes it active. The shim keeps the state
+    // across hibernation; WebViewActivityState values match its AG_GTK_ACTIVITY_*. Bridge event
+    // delivery does not follow the state; hosts that want to hold back events subscribe to
+    // WebViewCore.ActivityStateChanged.
+    // Transitions happen on the UI thread; the suspend timer posts back to it.
+
+    private volatile WebViewActivityState _activityState;
+    private ITimer? _suspendTimer;
+    private SynchronizationContext? _suspendContext;
+
+    /// <summary>Raised on the UI thread after the activity state changed.</summary>
+    public event EventHandler<WebViewActivityState>? ActivityStateChanged;
+
+    public WebViewActivityState ActivityState => _activityState;
+
+    /// <summary>Whether host visibility drives the activity state. Defaults to on.</summary>
+    internal bool AutoActivityState { get; set; } = true;
+
+    /// <summary>How long a hidden view stays throttled before it is suspended; null never suspends.</summary>
+    public TimeSpan? SuspendAfterHidden { get; set; } = TimeSpan.FromSeconds(30);
+
+    /// <summary>Clock for the suspend timer.</summary>
+    internal TimeProvider ActivityTimeProvider { get; set; } = TimeProvider.System;
+
+    internal void SetActivityState(WebViewActivityState state)
+    {
+        ThrowIfNotInitialized();
+        ObjectDisposedException.ThrowIf(_detached, nameof(GtkWebViewAdapter));
+        if (!Enum.IsDefined(state))
+            throw new ArgumentOutOfRangeException(nameof(state));
+
+        ApplyActivityState(state);
+    }
+
+    public void SetHostVisible(bool visible)
+    {
+        if (_detached) return;
+        if (visible && HibernationManager is { } manager)
+            ObserveHibernation(manager.MarkActiveAsync(this));
+
+        if (!AutoActivityState || _native == IntPtr.Zero) return;
+        FollowHostVisibility(visible);
+    }
+
+    private void FollowHostVisibility(bool visible)
+    {
+        if (visible)
+        {
+            ApplyActivityState(WebViewActivityState.Active);
+            return;
+        }
+
+        if (_activityState != WebViewActivityState.Active) return;
+        ApplyActivityState(WebViewActivityState.Throttled);
+
+        if (SuspendAfterHidden is { } delay)
+        {
+            _suspendContext = SynchronizationContext.Current;
+            _suspendTimer = ActivityTimeProvider.CreateTimer(static state => ((GtkWebViewAdapter)state!).PostSuspend(),
+                this, delay, Timeout.InfiniteTimeSpan);
+        }
+    }
+
+    private void ApplyActivityState(WebViewActivityState state)
+    {
+        CancelSuspendTimer();
+        if (_activityState == state) return;
+        _activityState = state;
+        if (_native != IntPtr.Zero)
+            NativeMethods.SetActivityState(_native, (int)state);
+
+        GtkAdapterMetrics.ActivityStateChanges.Add(1, new KeyValuePair<string, object?>("state", state.ToString()));
+        SafeRaise(() => ActivityStateChanged?.Invoke(this, state));
+    }
+
+    private void PostSuspend()
+    {
+        if (_suspendContext is { } context)
+            context.Post(static state => ((GtkWebViewAdapter)state!).SuspendIfStillHidden(), this);
+        else
+            SuspendIfStillHidden();
+    }
+
+    private void SuspendIfStillHidden()
+    {
+        // Showing the view (or setting a state explicitly) cancels the timer first.
+        if (_suspendTimer is null || _activityState != WebViewActivityState.Throttled || _detached) return;
+        ApplyActivityState(WebViewActivityState.Suspended);
+    }
+
+    private void CancelSuspendTimer()
+    {
+        _suspendTimer?.Dispose();
+        _suspendTimer = null;
+    }
+
+    internal void TestOnly_FollowHostVisibility(bool visible)
+        => FollowHostVisibility(visible);
+
+    // ==================== Web process crash recovery ====================
+    // WebKit starts a new web process on the next load after a termination; with recovery
+    // enabled the shim issues that load itself. Everything still waiting on the old process
+    // is failed here instead of being left to hang.
+
+    private readonly ConcurrentDictionary<object, Action<Exception>> _inFlightOps = new();
+    private volatile bool _crashRecoveryPending;
+    private ulong _reportedCrashRecoveries;
+
+    internal event EventHandler<GtkWebProcessTerminatedEventArgs>? WebProcessTerminated;
+
+    /// <summary>
+    /// Reloads the last committed history entry after the web process crashes or exceeds its
+    /// memory limit. A page that keeps crashing before it finishes loading is given up on.
+    /// </summary>
+    internal void SetCrashRecoveryEnabled(bool enabled)
+    {
+        ThrowIfNotInitialized();
+        ObjectDisposedException.ThrowIf(_detached, nameof(GtkWebViewAdapter));
+        NativeMethods.SetCrashRecovery(_native, enabled);
+    }
+
+    private Task<T> TrackInFlight<T>(TaskCompletionSource<T> tcs)
+    {
+        _inFlightOps[tcs] = ex => tcs.TrySetException(ex);
+        _ = tcs.Task.ContinueWith(_ => _inFlightOps.TryRemove(tcs, out _),
+            CancellationToken.None, TaskContinuationOptions.ExecuteSynchronously, TaskScheduler.Default);
+        return tcs.Task;
+    }
+
+    private void OnWebProcessTerminatedNative(int reason, bool recovering)
+    {
+        if (_detached) return;
+
+        var terminationReason = (WebViewProcessTerminationReason)reason;
+        GtkAdapterMetrics.WebProcessTerminations.Add(1,
+            new KeyValuePair<string, object?>("reason", terminationReason.ToString()),
+            new KeyValuePair<string, object?>("recovering", recovering));
+
+        var error = new WebViewProcessTerminatedException(terminationReason);
+        foreach (var requestId in _scriptTcsById.Keys)
+        {
+            if (_scriptTcsById.TryRemove(requestId, out var tcs))
+                tcs.TrySetException(error);
+        }
+        foreach (var op in _inFlightOps.Keys)
+        {
+            if (_inFlightOps.TryRemove(op, out var fail))
+                fail(error);
+        }
+
+        OnNavigationTerminal(NavigationCompletedStatus.Failure, error, requestUriOverride: null);
+
+        _crashRecoveryPending = recovering;
+        SafeRaise(() => WebProcessTerminated?.Invoke(this, new GtkWebProcessTerminatedEventArgs(terminationReason, recovering)));
+    }
+
+    private void ReportCrashRecovery(bool succeeded)
+    {
+        _crashRecoveryPending = false;
+        if (!succeeded || _native == IntPtr.Zero || _detached) return;
+
+        NativeMethods.GetCrashStats(_native, out _, out var recoveries, out var lastRecoveryUs);
+        if (recoveries == _reportedCrashRecoveries) return;
+        _reportedCrashRecoveries = recoveries;
+        GtkAdapterMetrics.WebProcessRecoveryMs.Record(lastRecoveryUs / 1000.0);
+    }
+
+    internal void TestOnly_RaiseWebProcessTerminatedFromNative(int reason, bool recovering)
+        => OnWebProcessTerminatedNative(reason, recovering);
+
+    // ==================== Responsiveness watchdog ====================
+    // The shim reports when WebKit marks the web process unresponsive and how the hang ended.
+    // The work in flight is captured here when it starts, so a frozen panel can be traced to
+    // the navigation, script or bridge message that was running. Only the first
+    // HangPreviewLength characters of the last script and bridge message are kept, so the
+    // adapter never holds a large payload alive just for a report that may never come.
+
+    private const int HangPreviewLength = 160;
+
+    private GtkWebProcessHang? _currentHang;
+    private volatile string? _lastScriptPreview;
+    private volatile string? _lastBridgeMessagePreview;
+
+    /// <summary>
+    /// Raised on the GTK thread when a hang starts and again when it ends. Reports quote page
+    /// scripts and bridge messages, which may carry user data.
+    /// </summary>
+    internal event EventHandler<GtkWebProcessHang>? WebProcessHang;
+
+    internal bool IsWebProcessResponsive => Volatile.Read(ref _currentHang) is null;
+
+    /// <summary>
+    /// Terminates a web process that is still unresponsive <paramref name="terminateAfter"/> after
+    /// WebKit noticed the hang, then reloads the view on a new process; null only reports hangs.
+    /// </summary>
+    internal void SetHangPolicy(TimeSpan? terminateAfter)
+    {
+        ThrowIfNotInitialized();
+        ObjectDisposedException.ThrowIf(_detached, nameof(GtkWebViewAdapter));
+        if (terminateAfter is { } after)
+            ArgumentOutOfRangeException.ThrowIfLessThanOrEqual(after, TimeSpan.Zero, nameof(terminateAfter));
+
+        NativeMethods.SetHangPolicy(_native, terminateAfter is { } ms ? (long)Math.Ceiling(ms.TotalMilliseconds) : 0);
+    }
+
+    [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvCdecl) })]
+    private static void WebProcessHangTrampoline(IntPtr userData, int phase, long durationUs)
+    {
+        var self = NativeMethods.FromUserData(userData);
+        self?.OnWebProcessHangNative((GtkWebProcessHangPhase)phase, durationUs);
+    }
+
+    private void OnWebProcessHangNative(GtkWebProcessHangPhase phase, long durationUs)
+    {
+        if (_detached) return;
+
+        GtkWebProcessHang report;
+        if (phase == GtkWebProcessHangPhase.Started)
+        {
+            report = CaptureHangContext();
+            Volatile.Write(ref _currentHang, report);
+        }
+        else
+        {
+            var started = Interlocked.Exchange(ref _currentHang, null) ?? CaptureHangContext();
+            report = started with { Phase = phase, Duration = TimeSpan.FromTicks(durationUs * TimeSpan.TicksPerMicrosecond) };
+            GtkAdapterMetrics.WebProcessHangMs.Record(durationUs / 1000.0,
+                new KeyValuePair<string, object?>("outcome", phase == GtkWebProcessHangPhase.Recovered ? "recovered" : "terminated"));
+        }
+
+        SafeRaise(() => WebProcessHang?.Invoke(this, report));
+    }
+
+    private GtkWebProcessHang CaptureHangContext()
+    {
+        Guid? navigationId = null;
+        Uri? navigationUri = null;
+        lock (_navLock)
+        {
+            if (_activeNavigationId != Guid.Empty && !_activeNavigationCompleted)
+            {
+                navigationId = _activeNavigationId;
+                navigationUri = _activeRequestUri;
+            }
+        }
+
+        var scripts = (int)Interlocked.Read(ref _scriptsInFlight);
+        return new GtkWebProcessHang(GtkWebProcessHangPhase.Started, TimeSpan.Zero, navigationId, navigationUri,
+            scripts, scripts > 0 ? _lastScriptPreview : null, _lastBridgeMessagePreview);
+    }
+
+    private static string? Preview(string? text)
+        => text is null || text.Length <= HangPreviewLength ? text : string.Concat(text.AsSpan(0, HangPreviewLength), "…");
+
+    internal void TestOnly_RaiseWebProcessHangFromNative(GtkWebProcessHangPhase phase, long durationUs)
+        => OnWebProcessHangNative(phase, durationUs);
+
+    internal void TestOnly_RaiseMessageFromNative(string body, string origin)
+        => OnMessageNative(body, origin);
+
+    // ==================== Navigation timing ====================
+    // The shim stamps every main-frame load phase with the monotonic clock, including the time
+    // its policy decisions waited on DecidePolicyAsync, and reports one record per load.
+
+    internal event EventHandler<GtkNavigationTiming>? NavigationTimingRecorded;
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct NavigationTimingNative
+    {
+        public long StartUs;
+        public long PolicyDecidedUs;
+        public long PolicyWaitUs;
+        public long LoadStartedUs;
+        public long CommittedUs;
+        public long FirstPaintUs;
+        public long FinishedUs;
+        public int RedirectCount;
+        public int Status;
+    }
+
+    [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvCdecl) })]
+    private static unsafe void NavigationTimingTrampoline(IntPtr userData, IntPtr urlUtf8, NavigationTimingNative* timing)
+    {
+        var self = NativeMethods.FromUserData(userData);
+        if (self is null || timing is null) return;
+        self.OnNavigationTimingNative(GtkNavigationTiming.FromNative(
+            NativeMethods.PtrToStringNullable(urlUtf8), timing->Status, timing->PolicyDecidedUs, timing->PolicyWaitUs,
+            timing->LoadStartedUs, timing->CommittedUs, timing->FirstPaintUs, timing->FinishedUs, timing->RedirectCount));
+    }
+
+    private void OnNavigationTimingNative(GtkNavigationTiming timing)
+    {
+        if (_detached) return;
+
+        var status = new KeyValuePair<string, object?>("status", timing.Status.ToString());
+        GtkAdapterMetrics.NavigationPolicyWaitMs.Record(timing.PolicyWait.TotalMilliseconds, status);
+        if (timing.ServerTime is { } server)
+            GtkAdapterMetrics.NavigationServerMs.Record(server.TotalMilliseconds, status);
+        if (timing.RenderTime is { } render)
+            GtkAdapterMetrics.NavigationRenderMs.Record(render.TotalMilliseconds, status);
+        if (timing.Finished is { } total)
+            GtkAdapterMetrics.NavigationTotalMs.Record(total.TotalMilliseconds, status);
+        if (timing.RedirectCount > 0)
+            GtkAdapterMetrics.NavigationRedirects.Add(timing.RedirectCount, status);
+
+        SafeRaise(() => NavigationTimingRecorded?.Invoke(this, timing));
+    }
+
+    // ==================== Resource timing ====================
+    // The shim records resource-load-started / finished / failed into a bounded ring per view;
+    // custom-scheme loads also carry the time spent in OnSchemeRequestNative.
+
+    /// <summary>
+    /// Starts or stops recording resource loads. <paramref name="capacity"/> bounds the number of
+    /// completed loads kept (0 selects the shim default); changing it discards what was recorded.
+    /// </summary>
+    public void SetResourceTimingEnabled(bool enabled, int capacity = 0)
+    {
+        ThrowIfNotInitialized();
+        ObjectDisposedException.ThrowIf(_detached, nameof(GtkWebViewAdapter));
+        ArgumentOutOfRangeException.ThrowIfNegative(capacity);
+        NativeMethods.SetResourceTiming(_native, enabled, capacity);
+    }
+
+    public void ClearResourceTimings()
+    {
+        if (_native == IntPtr.Zero || _detached) return;
+        NativeMethods.ClearResourceTimings(_native);
+    }
+
+    /// <summary>Returns the recorded loads, oldest first.</summary>
+    internal IReadOnlyList<GtkResourceTiming> GetResourceTimings()
+    {
+        if (_native == IntPtr.Zero || _detached) return [];
+
+        var result = new List<GtkResourceTiming>();
+        var handle = GCHandle.Alloc(result);
+        try
+        {
+            unsafe
+            {
+                NativeMethods.GetResourceTimings(_native, &OnResourceTimings, GCHandle.ToIntPtr(handle));
+            }
+        }
+        finally
+        {
+            handle.Free();
+        }
+        return result;
+    }
+
+    /// <summary>Exports the recorded loads as HAR 1.2 JSON.</summary>
+    public string ExportResourceTimingsAsHar()
+        => GtkHarWriter.Write(GetResourceTimings(), "Agibuild.Fulora",
+            typeof(GtkWebViewAdapter).Assembly.GetName().Version?.ToString() ?? "0.0.0");
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct ResourceTimingNative
+    {
+        public IntPtr Url;
+        public IntPtr Method;
+        public IntPtr MimeType;
+        public int Status;
+        public int Failed;
+        public long StartedUnixUs;
+        public long WaitUs;
+        public long ReceiveUs;
+        public long TotalUs;
+        public long Size;
+        public long HandlerUs;
+    }
+
+    [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvCdecl) })]
+    private static unsafe void OnResourceTimings(IntPtr context, int count, ResourceTimingNative* entries)
+    {
+        // Called synchronously from GetResourceTimings, which owns the handle.
+        var result = (List<GtkResourceTiming>)GCHandle.FromIntPtr(context).Target!;
+        for (var i = 0; i < count; i++)
+        {
+            ref var e = ref entries[i];
+            result.Add(GtkResourceTiming.FromNative(
+                NativeMethods.PtrToString(e.Url),
+                NativeMethods.PtrToStringNullable(e.Method) ?? "GET",
+                NativeMethods.PtrToStringNullable(e.MimeType),
+                e.Status,
+                e.Failed != 0,
+                e.StartedUnixUs,
+                e.WaitUs,
+                e.ReceiveUs,
+                e.TotalUs,
+                e.Size,
+                e.HandlerUs));
+        }
+    }
+
+    // ==================== Native bridge transport ====================
+    // With the bridge web extension installed, page messages arrive over a Unix socket from
+    // the web process and the runtime's RPC deliveries (IRpcDeliveryAdapter) are sent back as
+    // frames the extension hands to window.agWebView.rpc directly, instead of being compiled and
+    // evaluated as script.
+
+    internal const int BridgeFrameDispatch = 3;  // AG_BRIDGE_FRAME_DISPATCH
+    internal const int BridgeFrameResponse = 4;  // AG_BRIDGE_FRAME_RESPONSE
+
+    private bool _nativeBridgeEnabled;
+
+    /// <summary>
+    /// Routes bridge traffic through the web extension when it is installed next to the shim.
+    /// Must be set before Attach; without the extension the script-message path is kept.
+    /// </summary>
+    internal void SetNativeBridgeEnabled(bool enabled)
+    {
+        ThrowIfNotInitialized();
+        if (_attached)
+            throw new InvalidOperationException("The native bridge must be configured before Attach.");
+        _nativeBridgeEnabled = enabled;
+        NativeMethods.SetNativeBridge(_native, enabled);
+    }
+
+    /// <summary>True once the web process hosting the page has connected through the extension.</summary>
+    internal bool IsNativeBridgeConnected
+        => _attached && !_detached && NativeMethods.BridgeIsConnected(_native);
+
+    public bool TryDeliverRpc(RpcDeliveryKind kind, string json)
+    {
+        ArgumentNullException.ThrowIfNull(json);
+        if (!_nativeBridgeEnabled || !_attached || _detached)
+            return false;
+        if (!NativeMethods.BridgeSend(_native, kind == RpcDeliveryKind.Dispatch ? BridgeFrameDispatch : BridgeFrameResponse, json))
+            return false;
+
+        GtkAdapterMetrics.BridgeNativeDeliveries.Add(1);
+        return true;
+    }
+
+    // ==================== Published blobs ====================
+    // Large payloads are handed to the page as a URL instead of base64 in a message: the shim
+    // serves the pinned buffer at <scheme>://<host>/__blob/<id> with Range support and releases
+    // it only after it is revoked and every response reading from it has finished.
+
+    internal const string BlobPathPrefix = "/__blob/";
+
+    internal const int BlobPublished = 0;      // AG_GTK_BLOB_PUBLISHED
+    internal const int BlobInvalidId = -1;     // AG_GTK_BLOB_INVALID_ID
+    internal const int BlobNoMemory = -2;      // AG_GTK_BLOB_NO_MEMORY
+    internal const int BlobUnavailable = -3;   // AG_GTK_BLOB_UNAVAILABLE
+    internal const int BlobDuplicateId = -4;   // AG_GTK_BLOB_DUPLICATE_ID
+
+    private long _publishedBlobBytes;
+
+    /// <summary>Bytes currently held alive by published blobs, including revoked ones still being read.</summary>
+    internal long PublishedBlobBytes => Interlocked.Read(ref _publishedBlobBytes);
+
+    /// <summary>
+    /// Publishes <paramref name="data"/> without copying and returns the path the page can
+    /// <c>fetch()</c> on any of the view's custom schemes. The memory is pinned until, and
+    /// <paramref name="owner"/> disposed when, the blob is released. An id stays taken until it
+    /// is revoked.
+    /// </summary>
+    public string PublishBlob(string id, ReadOnlyMemory<byte> data, string? mimeType = null, IDisposable? owner = null)
+    {
+        ArgumentException.ThrowIfNullOrEmpty(id);
+        ThrowIfNotInitialized();
+        ObjectDisposedException.ThrowIf(_detached, nameof(GtkWebViewAdapter));
+
+        var lease = new BlobLease(this, data.Pin(), data.Length, owner);
+        var context = GCHandle.Alloc(lease);
+        Interlocked.Add(ref _publishedBlobBytes, data.Length);
+        GtkAdapterMetrics.PublishedBlobBytes.Add(data.Length);
+
+        int status;
+        unsafe
+        {
+            status = NativeMethods.PublishBlob(_native, id, lease.Pin.Pointer, data.Length, mimeType,
+                &BlobReleaseTrampoline, GCHandle.ToIntPtr(context));
+        }
+        if (status != BlobPublished)
+        {
+            context.Free();
+            lease.Release();
+            throw PublishBlobFailure(status, id);
+        }
+        return BlobPathPrefix + id;
+    }
+
+    internal static Exception PublishBlobFailure(int status, string id) => status switch
+    {
+        BlobInvalidId => new ArgumentException("Blob ids may only contain letters, digits, '.', '-' and '_'.", nameof(id)),
+        BlobNoMemory => new InsufficientMemoryException($"Not enough memory to publish blob '{id}'."),
+        BlobUnavailable => new ObjectDisposedException(nameof(GtkWebViewAdapter)),
+        BlobDuplicateId => new ArgumentException($"A blob with id '{id}' is already published; revoke it first.", nameof(id)),
+        _ => new InvalidOperationException($"Publishing blob '{id}' failed ({status})."),
+    };
+
+    /// <summary>Stops serving the blob. Returns false when no blob with that id is published.</summary>
+    public bool RevokeBlob(string id)
+    {
+        ArgumentNullException.ThrowIfNull(id);
+        ThrowIfNotInitialized();
+        return NativeMethods.RevokeBlob(_native, id);
+    }
+
+    private sealed class BlobLease(GtkWebViewAdapter adapter, System.Buffers.MemoryHandle pin, long length, IDisposable? owner)
+    {
+        public System.Buffers.MemoryHandle Pin = pin;
+
+        public void Release()
+        {
+            Pin.Dispose();
+            if (owner is not null)
+                SafeRaise(owner.Dispose);
+            Interlocked.Add(ref adapter._publishedBlobBytes, -length);
+            GtkAdapterMetrics.PublishedBlobBytes.Add(-length);
+        }
+    }
+
+    [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvCdecl) })]
+    private static void BlobReleaseTrampoline(IntPtr context)
+    {
+        // Last reference gone: after revoke or destroy, possibly on the GTK thread.
+        var handle = GCHandle.FromIntPtr(context);
+        var lease = (BlobLease)handle.Target!;
+        handle.Free();
+        lease.Release();
+    }
+
+    // ==================== Script evaluation limits ====================
+    // The shim caps how many evaluations run in the web process at once, queues a bounded
+    // number behind them and rejects the rest, so a storm of script calls cannot pile up
+    // unbounded work (and memory) in a busy web process.
+
+    internal const int EvalStarted = 0;      // AG_GTK_EVAL_STARTED
+    internal const int EvalQueued = 1;       // AG_GTK_EVAL_QUEUED
+    internal const int EvalRejected = -1;    // AG_GTK_EVAL_REJECTED
+
+    internal const int ScriptCompleted = 0;  // AG_GTK_SCRIPT_COMPLETED
+    internal const int ScriptCancelled = 1;  // AG_GTK_SCRIPT_CANCELLED
+    internal const int ScriptTimedOut = 2;   // AG_GTK_SCRIPT_TIMED_OUT
+
+    private long _scriptsInFlight;
+
+    /// <summary>
+    /// Limits concurrent evaluations to <paramref name="maxInFlight"/> (0 = unlimited) with up to
+    /// <paramref name="maxQueued"/> waiting; further requests fail immediately. A
+    /// <paramref name="timeout"/> bounds queueing plus execution of requests issued afterwards.
+    /// </summary>
+    public void ConfigureScriptEvaluation(int maxInFlight, int maxQueued, TimeSpan? timeout = null)
+    {
+        ArgumentOutOfRangeException.ThrowIfNegative(maxInFlight);
+        ArgumentOutOfRangeException.ThrowIfNegative(maxQueued);
+        if (timeout is { } t)
+            ArgumentOutOfRangeException.ThrowIfLessThanOrEqual(t, TimeSpan.Zero, nameof(timeout));
+        ThrowIfNotInitialized();
+        ObjectDisposedException.ThrowIf(_detached, nameof(GtkWebViewAdapter));
+
+        var timeoutMs = timeout is { } value ? (int)Math.Min(int.MaxValue, Math.Ceiling(value.TotalMilliseconds)) : 0;
+        NativeMethods.SetEvalLimits(_native, maxInFlight, maxQueued, timeoutMs);
+    }
+
+    /// <summary>Evaluations currently running in the web process and waiting for a slot.</summary>
+    internal (int Running, int Queued) GetScriptEvaluationStats()
+    {
+        if (!_initialized || _detached || _native == IntPtr.Zero)
+            return (0, 0);
+        NativeMethods.GetEvalStats(_native, out var running, out var queued);
+        return (running, queued);
+    }
+
+    [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvCdecl) })]
+    private static void ScriptSettledTrampoline(IntPtr userData, ulong requestId, int status, long queuedUs, long runUs)
+    {
+        var self = NativeMethods.FromUserData(userData);
+        self?.OnScriptSettledNative(requestId, status, queuedUs, runUs);
+    }
+
+    private void OnScriptSettledNative(ulong requestId, int status, long queuedUs, long runUs)
+    {
+        Interlocked.Decrement(ref _scriptsInFlight);
+        GtkAdapterMetrics.ScriptsInFlight.Add(-1);
+
+        var tag = new KeyValuePair<string, object?>("status", status switch
+        {
+            ScriptCompleted => "completed",
+            ScriptCancelled => "cancelled",
+            ScriptTimedOut => "timed_out",
+            _ => "unknown",
+        });
+        GtkAdapterMetrics.ScriptQueueWaitMs.Record(queuedUs / 1000.0, tag);
+        if (runUs > 0)
+            GtkAdapterMetrics.ScriptRunMs.Record(runUs / 1000.0, tag);
+
+        // Completed requests are resolved by the result callback that follows.
+        if (status == ScriptCompleted || !_scriptTcsById.TryRemove(requestId, out var tcs))
+            return;
+
+        if (status == ScriptTimedOut)
+            tcs.TrySetException(new WebViewScriptException("Script evaluation timed out.", new TimeoutException()));
+        else
+            tcs.TrySetCanceled();
+    }
+
+
+    // ==================== Large script results ====================
+    // Big results stay in the shim's buffer (explicit length, NULs allowed). String callers get
+    // one decode from it with no strlen; stream callers read it in place and free it on dispose.
+
+    private readonly ConcurrentDictionary<ulong, TaskCompletionSource<Stream?>> _scriptStreamTcsById = new();
+
+    /// <summary>
+    /// Results of at least <paramref name="thresholdBytes"/> UTF-8 bytes (0 = never) are decoded
+    /// from the native buffer instead of a NUL-terminated copy.
+    /// </summary>
+    public void SetScriptResultBufferThreshold(long thresholdBytes)
+    {
+        ArgumentOutOfRangeException.ThrowIfNegative(thresholdBytes);
+        ThrowIfNotInitialized();
+        NativeMethods.SetEvalBufferThreshold(_native, thresholdBytes);
+    }
+
+    /// <summary>
+    /// Evaluates <paramref name="script"/> and returns its string conversion as a read-only UTF-8
+    /// stream over native memory, or null for <c>null</c>/<c>undefined</c>. Dispose the stream
+    /// to release the buffer.
+    /// </summary>
+    public Task<Stream?> InvokeScriptStreamAsync(string script, CancellationToken cancellationToken = default)
+    {
+        ArgumentNullException.ThrowIfNull(script);
+        ThrowIfNotAttached();
+        if (cancellationToken.IsCancellationRequested)
+            return Task.FromCanceled<Stream?>(cancellationToken);
+
+        var requestId = (ulong)Interlocked.Increment(ref _nextScriptRequestId);
+        var streamTcs = new TaskCompletionSource<Stream?>(TaskCreationOptions.RunContinuationsAsynchronously);
+        _scriptStreamTcsById[requestId] = streamTcs;
+        ForwardToScriptStream(requestId, streamTcs, EvaluateScript(requestId, script, buffered: true, cancellationToken), cancellationToken);
+        return streamTcs.Task;
+    }
+
+    private void ForwardToScriptStream(
+        ulong requestId, TaskCompletionSource<Stream?> streamTcs, Task<string?> request, CancellationToken cancellationToken)
+    {
+        // Errors, timeouts, cancellation and detach settle the underlying string request; a
+        // buffer result completes the stream first, making the forwarded outcome a no-op.
+        _ = request.ContinueWith(t =>
+        {
+            _scriptStreamTcsById.TryRemove(requestId, out _);
+            if (t.IsFaulted)
+                streamTcs.TrySetException(t.Exception!.InnerExceptions);
+            else if (t.IsCanceled)
+                streamTcs.TrySetCanceled(cancellationToken);
+            else
+                streamTcs.TrySetResult(null);
+        }, CancellationToken.None, TaskContinuationOptions.ExecuteSynchronously, TaskScheduler.Default);
+    }
+
+    [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvCdecl) })]
+    private static unsafe void ScriptBufferTrampoline(IntPtr userData, ulong requestId, IntPtr buffer, byte* data, long length)
+    {
+        var self = NativeMethods.FromUserData(userData);
+        if (self is null)
+        {
+            NativeMethods.BufferRelease(buffer);
+            return;
+        }
+        self.OnScriptBufferNative(requestId, buffer, data, length);
+    }
+
+    private unsafe void OnScriptBufferNative(ulong requestId, IntPtr buffer, byte* data, long length)
+    {
+        if (_scriptStreamTcsById.TryRemove(requestId, out var streamTcs))
+        {
+            var stream = new ScriptResultStream(new ScriptResultBuffer(buffer, (IntPtr)data, length), length);
+            if (!streamTcs.TrySetResult(stream))
+                stream.Dispose();
+            if (_scriptTcsById.TryRemove(requestId, out var forwarded))
+                forwarded.TrySetResult(null);
+            return;
+        }
+
+        try
+        {
+            if (!_scriptTcsById.TryRemove(requestId, out var tcs))
+                return;
+            if (length > int.MaxValue)
+            {
+                tcs.TrySetException(new WebViewScriptException(
+                    $"The script result ({length} bytes) is too large for a string; use a stream."));
+                return;
+            }
+            tcs.TrySetResult(System.Text.Encoding.UTF8.GetString(data, (int)length));
+        }
+        finally
+        {
+            if (buffer != IntPtr.Zero)
+                NativeMethods.BufferRelease(buffer);
+        }
+    }
+
+    /// <summary>Owns a shim result buffer; the handle is the data pointer.</summary>
+    private sealed class ScriptResultBuffer : SafeBuffer
+    {
+        private readonly IntPtr _buffer;
+
+        public ScriptResultBuffer(IntPtr buffer, IntPtr data, long length)
+            : base(ownsHandle: true)
+        {
+            _buffer = buffer;
+            SetHandle(data);
+            Initialize((ulong)length);
+        }
+
+        // An empty result may have no data pointer; the buffer still has to be released.
+        public override bool IsInvalid => _buffer == IntPtr.Zero;
+
+        protected override bool ReleaseHandle()
+        {
+            NativeMethods.BufferRelease(_buffer);
+            return true;
+        }
+    }
+
+    private sealed class ScriptResultStream : UnmanagedMemoryStream
+    {
+        private readonly ScriptResultBuffer _buffer;
+
+        public ScriptResultStream(ScriptResultBuffer buffer, long length)
+            : base(buffer, 0, length, FileAccess.Read)
+        {
+            _buffer = buffer;
+        }
+
+        protected override void Dispose(bool disposing)
+        {
+            base.Dispose(disposing);
+            if (disposing)
+                _buffer.Dispose();
+        }
+    }
+
+    // ==================== Pending native operations ====================
+    // Policy decisions, script evaluations, captures and cookie reads each hold a slot in the
+    // shim's per-view operation table until they complete; listing them shows what a view is
+    // still waiting on and for how long.
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct PendingOpNative
+    {
+        public ulong Id;
+        public int Kind;
+        public int Completing;
+        public long AgeUs;
+    }
+
+    /// <summary>Operations currently outstanding on the view, in no particular order.</summary>
+    internal IReadOnlyList<GtkPendingOperation> GetPendingNativeOperations()
+    {
+        if (!_initialized || _native == IntPtr.Zero)
+            return [];
+
+        var result = new List<GtkPendingOperation>();
+        var handle = GCHandle.Alloc(result);
+        try
+        {
+            unsafe
+            {
+                NativeMethods.GetPendingOps(_native, &PendingOpsTrampoline, GCHandle.ToIntPtr(handle));
+            }
+        }
+        finally
+        {
+            handle.Free();
+        }
+        return result;
+    }
+
+    [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvCdecl) })]
+    private static unsafe void PendingOpsTrampoline(IntPtr context, PendingOpNative* ops, int count)
+    {
+        var result = (List<GtkPendingOperation>)GCHandle.FromIntPtr(context).Target!;
+        for (var i = 0; i < count; i++)
+            result.Add(CreatePendingOperation(ops[i]));
+    }
+
+    internal static GtkPendingOperation CreatePendingOperation(in PendingOpNative native)
+    {
+        var kind = Enum.IsDefined((GtkPendingOperationKind)native.Kind)
+            ? (GtkPendingOperationKind)native.Kind
+            : GtkPendingOperationKind.Unknown;
+        return new GtkPendingOperation(native.Id, kind, native.Completing != 0,
+            TimeSpan.FromMicroseconds(Math.Max(0, native.AgeUs)));
+    }
+
+    // ==================== Offscreen composition ====================
+    // Opt-in alternative to the XEmbed plug: the view renders into a GtkOffscreenWindow, the shim
+    // copies damaged regions into a triple-buffered frame ring, and the host draws the frames
+    // itself (for example into a WriteableBitmap) and forwards input back as GDK events.
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct OffscreenFrameNative
+    {
+        public IntPtr Data;
+        public int Width;
+        public int Height;
+        public int Stride;
+        public int DirtyX;
+        public int DirtyY;
+        public int DirtyWidth;
+        public int DirtyHeight;
+        public ulong Sequence;
+        public long LatencyUs;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct InputEventNative
+    {
+        public int Type;
+        public uint TimeMs;
+        public double X;
+        public double Y;
+        public double DeltaX;
+        public double DeltaY;
+        public uint Button;
+        public uint KeyVal;
+        public uint Modifiers;
+    }
+
+    private readonly object _offscreenLock = new();
+    private bool _offscreenEnabled;
+    private bool _offscreenClosed;
+
+    /// <summary>
+    /// Raised on the GTK thread when a new frame is ready for <see cref="TryCopyOffscreenFrame"/>.
+    /// The argument is the frame's sequence number.
+    /// </summary>
+    public event EventHandler<ulong>? OffscreenFrameReady;
+
+    /// <summary>
+    /// Renders the view offscreen instead of embedding it into the host's X11 window. Must be set
+    /// before Attach; <paramref name="width"/> and <paramref name="height"/> are the initial size
+    /// in pixels (0 = 800x600). Hardware acceleration is turned off for the view in this mode.
+    /// </summary>
+    internal void SetOffscreenRendering(bool enabled, int width = 0, int height = 0)
+    {
+        ArgumentOutOfRangeException.ThrowIfNegative(width);
+        ArgumentOutOfRangeException.ThrowIfNegative(height);
+        ThrowIfNotInitialized();
+        if (_attached)
+            throw new InvalidOperationException("Offscreen rendering must be configured before Attach.");
+        _offscreenEnabled = enabled;
+        NativeMethods.SetOffscreenRendering(_native, enabled, width, height);
+    }
+
+    public bool IsOffscreenRendering => _offscreenEnabled;
+
+    /// <summary>Resizes an offscreen view; the next frame is copied in full.</summary>
+    public void ResizeOffscreen(int width, int height)
+    {
+        ArgumentOutOfRangeException.ThrowIfNegativeOrZero(width);
+        ArgumentOutOfRangeException.ThrowIfNegativeOrZero(height);
+        if (!_offscreenEnabled || !_attached || _detached)
+            return;
+        NativeMethods.OffscreenResize(_native, width, height);
+    }
+
+    /// <summary>
+    /// Copies the newest unseen frame into <paramref name="destination"/>, a BGRA premultiplied
+    /// buffer (Avalonia <c>PixelFormat.Bgra8888</c>, <c>AlphaFormat.Premul</c>) that keeps the
+    /// previous frame between calls: only the area changed since the previous copy is written,
+    /// unless the destination size differs from the frame. Any thread; false when no new frame
+    /// is available.
+    /// </summary>
+    public unsafe bool TryCopyOffscreenFrame(IntPtr destination, int destinationStride,
+        int destinationWidth, int destinationHeight, out OffscreenFrameCopy copy)
+    {
+        copy = default;
+        if (destination == IntPtr.Zero || destinationWidth <= 0 || destinationHeight <= 0)
+            return false;
+
+        OffscreenFrameNative frame;
+        int x, y, width, height;
+        lock (_offscreenLock)
+        {
+            if (!_offscreenEnabled || _offscreenClosed || _native == IntPtr.Zero)
+                return false;
+            if (!NativeMethods.OffscreenAcquireFrame(_native, out frame))
+                return false;
+
+            try
+            {
+                if (frame.Width == destinationWidth && frame.Height == destinationHeight)
+                    (x, y, width, height) = (frame.DirtyX, frame.DirtyY, frame.DirtyWidth, frame.DirtyHeight);
+                else
+                    (x, y, width, height) = (0, 0, Math.Min(frame.Width, destinationWidth), Math.Min(frame.Height, destinationHeight));
+
+                CopyPixels(new ReadOnlySpan<byte>((void*)frame.Data, frame.Stride * frame.Height), frame.Stride,
+                    new Span<byte>((void*)destination, destinationStride * destinationHeight), destinationStride,
+                    x, y, width, height);
+            }
+            finally
+            {
+                NativeMethods.OffscreenReleaseFrame(_native);
+            }
+        }
+
+        var latency = TimeSpan.FromMicroseconds(frame.LatencyUs);
+        GtkAdapterMetrics.OffscreenFrameLatencyMs.Record(latency.TotalMilliseconds);
+        copy = new OffscreenFrameCopy(frame.Sequence, frame.Width, frame.Height, x, y, width, height, latency);
+        return true;
+    }
+
+    /// <summary>Copies a rectangle of 32-bit pixels between two buffers with the same origin.</summary>
+    internal static void CopyPixels(ReadOnlySpan<byte> source, int sourceStride, Span<byte> destination, int destinationStride,
+        int x, int y, int width, int height)
+    {
+        if (width <= 0 || height <= 0)
+            return;
+        var rowBytes = width * 4;
+        for (var row = y; row < y + height; row++)
+        {
+            source.Slice(row * sourceStride + x * 4, rowBytes)
+                .CopyTo(destination.Slice(row * destinationStride + x * 4, rowBytes));
+        }
+    }
+
+    /// <summary>Forwards one input event to an offscreen view. False when it was not delivered.</summary>
+    public bool SendOffscreenInput(in OffscreenInput input)
+    {
+        if (!_offscreenEnabled || !_attached || _detached)
+            return false;
+        var native = new InputEventNative
+        {
+            Type = (int)input.Kind,
+            TimeMs = input.TimestampMs,
+            X = input.X,
+            Y = input.Y,
+            DeltaX = input.DeltaX,
+            DeltaY = input.DeltaY,
+            Button = input.Button,
+            KeyVal = input.KeyVal,
+            Modifiers = (uint)input.Modifiers,
+        };
+        return NativeMethods.OffscreenSendInput(_native, in native);
+    }
+
+    /// <summary>Frames published by the shim and frames superseded before the host copied them.</summary>
+    internal (ulong Published, ulong Dropped) GetOffscreenFrameStats()
+    {
+        if (!_offscreenEnabled || !_attached || _detached || _native == IntPtr.Zero)
+            return (0, 0);
+        NativeMethods.OffscreenGetStats(_native, out var published, out var dropped);
+        return (published, dropped);
+    }
+
+    // The shim frees the frame ring on detach; wait out a copy in progress and refuse new ones.
+    private void CloseOffscreenFrames()
+    {
+        lock (_offscreenLock)
+            _offscreenClosed = true;
+    }
+
+    [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvCdecl) })]
+    private static void OffscreenFrameTrampoline(IntPtr userData, ulong sequence, long copyUs)
+    {
+        var self = NativeMethods.FromUserData(userData);
+        if (self is null || self._detached) return;
+        GtkAdapterMetrics.OffscreenFrameCopyMs.Record(copyUs / 1000.0);
+        SafeRaise(() => self.OffscreenFrameReady?.Invoke(self, sequence));
+    }
+
+    // ==================== Downloads ====================
+    // The shim owns each WebKitDownload from start to finish: WebKit writes straight to the
+    // destination chosen here (synchronously from DownloadRequested, or later through
+    // DownloadDestinationResolver), progress arrives coalesced, and completion reports the final
+    // path and size. Download bytes never pass through managed memory.
+
+    internal const int DownloadDecisionDefault = 0;  // AG_GTK_DOWNLOAD_DEFAULT
+    internal const int DownloadDecisionAccepted = 1; // AG_GTK_DOWNLOAD_ACCEPTED
+    internal const int DownloadDecisionCancel = 2;   // AG_GTK_DOWNLOAD_CANCEL
+    internal const int DownloadDecisionDeferred = 3; // AG_GTK_DOWNLOAD_DEFERRED
+
+    /// <summary>
+    /// Chooses the destination of downloads that <see cref="DownloadRequested"/> handlers left
+    /// undecided. Returning <c>null</c> cancels the download. The download waits, paused in the
+    /// network process, until the task completes.
+    /// </summary>
+    public Func<WebViewDownload, CancellationToken, ValueTask<string?>>? DownloadDestinationResolver { get; set; }
+
+    /// <summary>Raised on the GTK thread at most once per progress interval per download.</summary>
+    public event EventHandler<WebViewDownloadProgress>? DownloadProgressChanged;
+
+    /// <summary>Raised on the GTK thread when a download completed, failed or was cancelled.</summary>
+    public event EventHandler<WebViewDownloadResult>? DownloadCompleted;
+
+    /// <summary>Minimum time between two progress reports for the same download (default 250 ms).</summary>
+    public void SetDownloadProgressInterval(TimeSpan interval)
+    {
+        ArgumentOutOfRangeException.ThrowIfLessThan(interval, TimeSpan.Zero);
+        ThrowIfNotInitialized();
+        NativeMethods.SetDownloadProgressInterval(_native, (int)Math.Min(int.MaxValue, interval.TotalMilliseconds));
+    }
+
+    /// <summary>Cancels a running download; false when the id is unknown or already finished.</summary>
+    public bool CancelDownload(ulong downloadId)
+        => _attached && !_detached && NativeMethods.DownloadCancel(_native, downloadId);
+
+    internal static int DecideDownload(DownloadRequestedEventArgs args, bool hasResolver)
+    {
+        if (args.Cancel)
+            return DownloadDecisionCancel;
+        if (!string.IsNullOrEmpty(args.DownloadPath))
+            return DownloadDecisionAccepted;
+        return hasResolver && !args.Handled ? DownloadDecisionDeferred : DownloadDecisionDefault;
+    }
+
+    private async Task ResolveDownloadDestinationAsync(Func<WebViewDownload, CancellationToken, ValueTask<string?>> resolver, WebViewDownload download)
+    {
+        string? path = null;
+        try
+        {
+            path = await resolver(download, CancellationToken.None).ConfigureAwait(false);
+        }
+        catch
+        {
+            // A failing resolver cancels the download below.
+        }
+
+        if (_detached || _native == IntPtr.Zero)
+            return;
+        if (string.IsNullOrEmpty(path) || !NativeMethods.DownloadSetDestination(_native, download.Id, Path.GetFullPath(path)))
+            NativeMethods.DownloadCancel(_native, download.Id);
+    }
+
+    [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvCdecl) })]
+    private static void DownloadProgressTrampoline(IntPtr userData, ulong downloadId, long received, long total, double bytesPerSecond)
+    {
+        var self = NativeMethods.FromUserData(userData);
+        if (self is null) return;
+        self._lastDownloadRates[downloadId] = bytesPerSecond;
+        if (self._detached) return;
+        var progress = new WebViewDownloadProgress(downloadId, received, total >= 0 ? total : null, bytesPerSecond);
+        SafeRaise(() => self.DownloadProgressChanged?.Invoke(self, progress));
+    }
+
+    [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvCdecl) })]
+    private static void DownloadFinishedTrampoline(IntPtr userData, ulong downloadId, int status, IntPtr pathUtf8, long received, IntPtr errorUtf8)
+    {
+        var self = NativeMethods.FromUserData(userData);
+        if (self is null) return;
+        self.OnDownloadFinishedNative(new WebViewDownloadResult(downloadId, (WebViewDownloadStatus)status,
+            NativeMethods.PtrToStringNullable(pathUtf8), received, NativeMethods.PtrToStringNullable(errorUtf8)));
+    }
+
+    private void OnDownloadFinishedNative(WebViewDownloadResult result)
+    {
+        GtkAdapterMetrics.DownloadBytes.Add(result.ReceivedBytes);
+        if (result.Status == WebViewDownloadStatus.Completed)
+        {
+            // The last progress report carries the average rate over the whole download.
+            if (_lastDownloadRates.TryRemove(result.Id, out var rate))
+                GtkAdapterMetrics.DownloadBytesPerSecond.Record(rate);
+        }
+        else
+        {
+            _lastDownloadRates.TryRemove(result.Id, out _);
+        }
+
+        if (_detached) return;
+        SafeRaise(() => DownloadCompleted?.Invoke(this, result));
+    }
+
+    // ==================== Resource statistics ====================
+    // Process-wide counts for leak checks in long-running hosts and the lifecycle soak: shim
+    // views, operation tables and slots, plus GObject instance counts when enabled.
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct ResourceStatsNative
+    {
+        public long LiveViews;
+        public long AttachedViews;
+        public long OpTables;
+        public long OutstandingOps;
+        public int InstanceCounts;
+        public int Reserved;
+        public long WebViews;
+        public long UserContentManagers;
+        public long WebContexts;
+        public long Downloads;
+        public long Plugs;
+        public long OffscreenWindows;
+    }
+
+    /// <summary>Current native resource counts of every view in the process.</summary>
+    internal static GtkNativeResourceStats GetNativeResourceStats()
+    {
+        NativeMethods.GetResourceStats(out var n);
+        return new GtkNativeResourceStats(n.LiveViews, n.AttachedViews, n.OpTables, n.OutstandingOps,
+            n.InstanceCounts != 0, n.WebViews, n.UserContentManagers, n.WebContexts, n.Downloads,
+            n.Plugs, n.OffscreenWindows);
+    }
+
+    // ==================== Custom scheme uploads ====================
+    // Requests with a body (POST/PUT from the page) can be handed to SchemeUploadHandler on a
+    // worker thread instead of WebResourceRequested. The handler reads the body as a stream
+    // straight from WebKit and answers whenever it is done, so an upload goes to disk in
+    // fixed-size chunks rather than through base64 over the bridge.
+
+    private const int SchemeNotHandled = 0; // AG_GTK_SCHEME_NOT_HANDLED
+    private const int SchemeResponded = 1;  // AG_GTK_SCHEME_RESPONDED
+    private const int SchemeDeferred = 2;   // AG_GTK_SCHEME_DEFERRED
+
+    /// <summary>
+    /// Handles custom-scheme requests that carry a body. Runs on a thread-pool thread; a
+    /// <c>null</c> result answers 404 and an exception 500. The token is cancelled when the view
+    /// detaches, after which the reply is dropped. When unset, such requests go to
+    /// <see cref="WebResourceRequested"/> without their body, as before.
+    /// </summary>
+    internal Func<GtkSchemeUpload, CancellationToken, Task<GtkSchemeResponse?>>? SchemeUploadHandler { get; set; }
+
+    internal static IReadOnlyDictionary<string, string>? ParseSchemeRequestHeaders(string? text)
+    {
+        if (string.IsNullOrEmpty(text))
+            return null;
+
+        var headers = new Dictionary<string, string>(StringComparer.OrdinalIgnoreCase);
+        foreach (var line in text.Split('\n', StringSplitOptions.RemoveEmptyEntries))
+        {
+            var colon = line.IndexOf(':');
+            if (colon <= 0)
+                continue;
+            var name = line[..colon].Trim();
+            var value = line[(colon + 1)..].Trim();
+            // Repeated headers combine as a comma-separated list (RFC 9110, 5.3).
+            headers[name] = headers.TryGetValue(name, out var existing) ? existing + ", " + value : value;
+        }
+        return headers;
+    }
+
+    // Upload replies come from worker threads, so each holds a lease on the native handle for
+    // the duration of the call; when one is outstanding at Detach, the last lease destroys the
+    // handle instead. The lock is never held across a native call, which would deadlock against
+    // a Detach on the GTK thread.
+    private readonly object _nativeLeaseLock = new();
+    private readonly CancellationTokenSource _detachCts = new();
+    private int _nativeLeases;
+    private bool _destroyDeferred;
+
+    private bool TryLeaseNative(out IntPtr native)
+    {
+        lock (_nativeLeaseLock)
+        {
+            native = _native;
+            if (_detached || native == IntPtr.Zero)
+                return false;
+            _nativeLeases++;
+            return true;
+        }
+    }
+
+    private void ReleaseNativeLease(IntPtr native)
+    {
+        bool destroy;
+        lock (_nativeLeaseLock)
+            destroy = --_nativeLeases == 0 && _destroyDeferred;
+        if (destroy)
+            NativeMethods.Destroy(native);
+    }
+
+    /// <summary>Called by Detach once no new lease can start; true when a reply will destroy the handle.</summary>
+    private bool DeferDestroyToNativeLeases()
+    {
+        lock (_nativeLeaseLock)
+            return _destroyDeferred = _nativeLeases > 0;
+    }
+
+    private bool TryDeferSchemeUpload(string? url, string? method, IReadOnlyDictionary<string, string>? headers,
+        ulong requestId, IntPtr body, long bodyLength)
+    {
+        if (_detached || requestId == 0)
+            return false;
+        if (string.IsNullOrEmpty(url) || !Uri.TryCreate(url, UriKind.Absolute, out var uri))
+            return false;
+        var handler = _fetchBridgeHandler is { } fetchBridge && IsFetchBridgeRequest(uri)
+            ? (upload, ct) => ServeFetchBridgeRequestAsync(fetchBridge, upload, ct)
+            : SchemeUploadHandler;
+        if (handler is null)
+            return false;
+
+        // Deferring hands this adapter a reference to the body; the stream closes it.
+        var upload = new GtkSchemeUpload(uri, string.IsNullOrEmpty(method) ? "POST" : method,
+            headers ?? new Dictionary<string, string>(StringComparer.OrdinalIgnoreCase),
+            bodyLength >= 0 ? bodyLength : null,
+            new SchemeBodyStream(body, bodyLength));
+        var detached = _detachCts.Token;
+        _ = Task.Run(() => CompleteSchemeUploadAsync(handler, upload, requestId, detached));
+        return true;
+    }
+
+    private async Task CompleteSchemeUploadAsync(
+        Func<GtkSchemeUpload, CancellationToken, Task<GtkSchemeResponse?>> handler, GtkSchemeUpload upload, ulong requestId,
+        CancellationToken detached)
+    {
+        var reply = await RunSchemeUploadAsync(handler, upload, detached).ConfigureAwait(false);
+        if (!TryLeaseNative(out var native))
+            return;
+        try
+        {
+            if (reply.Response is { } response)
+                RespondToSchemeUpload(native, requestId, response);
+            else
+                NativeMethods.SchemeRequestFail(native, requestId, reply.FailureStatus, reply.FailureMessage!);
+        }
+        finally
+        {
+            ReleaseNativeLease(native);
+        }
+    }
+
+    /// <summary>
+    /// Runs <paramref name="handler"/> and closes the body. A <c>null</c> result becomes a 404
+    /// failure and an exception a 500 failure carrying its message.
+    /// </summary>
+    internal static async Task<(GtkSchemeResponse? Response, int FailureStatus, string? FailureMessage)> RunSchemeUploadAsync(
+        Func<GtkSchemeUpload, CancellationToken, Task<GtkSchemeResponse?>> handler, GtkSchemeUpload upload,
+        CancellationToken cancellationToken)
+    {
+        try
+        {
+            var response = await handler(upload, cancellationToken).ConfigureAwait(false);
+            return response is null ? (null, 404, "Not handled") : (response, 0, null);
+        }
+        catch (Exception ex)
+        {
+            return (null, 500, ex.Message);
+        }
+        finally
+        {
+            await upload.Body.DisposeAsync().ConfigureAwait(false);
+        }
+    }
+
+    private static unsafe void RespondToSchemeUpload(IntPtr native, ulong requestId, GtkSchemeResponse response)
+    {
+        fixed (byte* data = response.Body.Span)
+        {
+            NativeMethods.SchemeRequestRespond(native, requestId, data, response.Body.Length,
+                response.ContentType, response.StatusCode > 0 ? response.StatusCode : 200, response.AllowOrigin);
+        }
+    }
+
+    /// <summary>Forward-only view of a request body held by the shim.</summary>
+    internal sealed class SchemeBodyStream(IntPtr body, long length) : Stream
+    {
+        private IntPtr _body = body;
+        private long _position;
+
+        public override bool CanRead => _body != IntPtr.Zero;
+        public override bool CanSeek => false;
+        public override bool CanWrite => false;
+        public override long Length => length >= 0 ? length : throw new NotSupportedException();
+        public override long Position
+        {
+            get => _position;
+            set => throw new NotSupportedException();
+        }
+
+        public override int Read(byte[] buffer, int offset, int count)
+            => Read(buffer.AsSpan(offset, count));
+
+        public override unsafe int Read(Span<byte> buffer)
+        {
+            ObjectDisposedException.ThrowIf(_body == IntPtr.Zero, this);
+            if (buffer.IsEmpty)
+                return 0;
+
+            long n;
+            fixed (byte* p = buffer)
+                n = NativeMethods.SchemeBodyRead(_body, p, buffer.Length);
+            if (n < 0)
+                throw new IOException("The request body could not be read; the view may have been detached.");
+            _position += n;
+            return (int)n;
+        }
+
+        public override void Flush() { }
+        public override long Seek(long offset, SeekOrigin origin) => throw new NotSupportedException();
+        public override void SetLength(long value) => throw new NotSupportedException();
+        public override void Write(byte[] buffer, int offset, int count) => throw new NotSupportedException();
+
+        protected override void Dispose(bool disposing)
+        {
+            var body = Interlocked.Exchange(ref _body, IntPtr.Zero);
+            if (body != IntPtr.Zero)
+                NativeMethods.SchemeBodyClose(body);
+            base.Dispose(disposing);
+        }
+    }
+
+    // ==================== IFetchBridgeAdapter ====================
+    // Bridge calls the page fetches from app://__rpc/<service>/<method> take the upload path
+    // above: the body is read and handed to the bridge on a worker thread, and the response
+    // JSON goes back as the HTTP body instead of queueing behind other script evaluations.
+    // Enabling it marks the app scheme secure and CORS-enabled on the view's web context for
+    // the context's lifetime (WebKit cannot undo that), so views sharing the context see the
+    // same scheme flags; their requests still reach their own handlers, which refuse them.
+
+    private volatile FetchBridgeRequestHandler? _fetchBridgeHandler;
+
+    public bool SetFetchBridgeHandler(FetchBridgeRequestHandler? handler)
+    {
+        if (_native == IntPtr.Zero || _detached)
+        {
+            _fetchBridgeHandler = null;
+            return handler is null;
+        }
+
+        var supported = handler is null
+            ? NativeMethods.SetFetchBridge(_native, null, null)
+            : NativeMethods.SetFetchBridge(_native, IFetchBridgeAdapter.Scheme, IFetchBridgeAdapter.Host);
+        _fetchBridgeHandler = supported ? handler : null;
+        return supported;
+    }
+
+    internal static bool IsFetchBridgeRequest(Uri uri)
+        => string.Equals(uri.Scheme, IFetchBridgeAdapter.Scheme, StringComparison.OrdinalIgnoreCase)
+            && string.Equals(uri.Host, IFetchBridgeAdapter.Host, StringComparison.OrdinalIgnoreCase);
+
+    internal static async Task<GtkSchemeResponse?> ServeFetchBridgeRequestAsync(
+        FetchBridgeRequestHandler handler, GtkSchemeUpload upload, CancellationToken cancellationToken)
+    {
+        string body;
+        using (var reader = new StreamReader(upload.Body, Encoding.UTF8, detectEncodingFromByteOrderMarks: false, leaveOpen: true))
+            body = await reader.ReadToEndAsync(cancellationToken).ConfigureAwait(false);
+
+        var origin = upload.Headers.TryGetValue("Origin", out var value) ? value : string.Empty;
+        var response = await handler(body, origin, cancellationToken).ConfigureAwait(false);
+
+        // The handler answers only origins the bridge policy admits, so the page may read the
+        // response when it came from exactly that origin; refusals fail without CORS headers.
+        return response is null
+            ? null
+            : new GtkSchemeResponse(Encoding.UTF8.GetBytes(response), "application/json",
+                AllowOrigin: origin.Length > 0 ? origin : null);
+    }
+
+    internal Task<string?> TestOnly_TrackScriptRequest(ulong requestId)
+    {
+        var tcs = new TaskCompletionSource<string?>(TaskCreationOptions.RunContinuationsAsynchronously);
+        _scriptTcsById[requestId] = tcs;
+        Interlocked.Increment(ref _scriptsInFlight);
+        return tcs.Task;
+    }
+
+    internal void TestOnly_RaiseScriptSettledFromNative(ulong requestId, int status, long queuedUs, long runUs)
+        => OnScriptSettledNative(requestId, status, queuedUs, runUs);
+
+    internal Task<Stream?> TestOnly_TrackScriptStreamRequest(ulong requestId)
+    {
+        var streamTcs = new TaskCompletionSource<Stream?>(TaskCreationOptions.RunContinuationsAsynchronously);
+        _scriptStreamTcsById[requestId] = streamTcs;
+        ForwardToScriptStream(requestId, streamTcs, TestOnly_TrackScriptRequest(requestId), CancellationToken.None);
+        return streamTcs.Task;
+    }
+
+    /// <summary>Raises a buffer result over caller-owned memory; there is no shim buffer to release.</summary>
+    internal unsafe void TestOnly_RaiseScriptBufferFromNative(ulong requestId, IntPtr data, long length)
+        => OnScriptBufferNative(requestId, IntPtr.Zero, (byte*)data, length);
 }
@@ -0,0 +1,13 @@
+namespace Agibuild.Fulora.Adapters.Gtk;
+
+/// <summary>A view whose web process can be released while idle and rebuilt on demand.</summary>
+internal interface IGtkHibernatable
+{
+    bool IsHibernated { get; }
+
+    /// <summary>Captures session state (and optionally a snapshot) and releases the web process.</summary>
+    Task HibernateAsync(bool captureSnapshot);
+
+    /// <summary>Rebuilds the view from the captured session; no-op when awake.</summary>
+    void Resume();
+}
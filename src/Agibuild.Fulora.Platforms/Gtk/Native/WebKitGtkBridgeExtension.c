@@ -0,0 +1,205 @@
+/*
+ * WebKitGTK web extension for the Agibuild bridge
+ * Loaded by WebKit into the web processes of contexts the shim enabled it on. Installs
+ * window.__agibuildBridge in every frame and exchanges frames (WebKitGtkBridgeProtocol.h)
+ * with the shim over a Unix socket, so bridge messages skip the script-message IPC and RPC
+ * replies are delivered as a function call instead of evaluated source.
+ *
+ * Build command:
+ *   gcc -shared -fPIC -o libAgibuildWebViewGtkBridge.so WebKitGtkBridgeExtension.c \
+ *       $(pkg-config --cflags --libs webkit2gtk-web-extension-4.1)
+ */
+
+#include <webkit2/webkit-web-extension.h>
+#include <gio/gio.h>
+#include <gio/gunixsocketaddress.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "WebKitGtkBridgeProtocol.h"
+
+/* ========== Connection ========== */
+
+static WebKitWebExtension* g_extension;
+static GSocketConnection* g_connection;
+static GOutputStream* g_output;
+static GByteArray* g_read_buffer;
+static uint8_t g_read_chunk[64 * 1024];
+
+static void close_connection(void)
+{
+    if (g_connection == NULL) return;
+    g_io_stream_close(G_IO_STREAM(g_connection), NULL, NULL);
+    g_object_unref(g_connection);
+    g_connection = NULL;
+    g_output = NULL;
+}
+
+/* Writes one frame; the socket is local, so a blocking write only waits on the shim. */
+static void send_frame(uint8_t kind, uint64_t page_id, const void* a, uint32_t a_len, const void* b, uint32_t b_len)
+{
+    if (g_output == NULL) return;
+
+    uint8_t header[AG_BRIDGE_HEADER_SIZE];
+    ag_bridge_write_header(header, a_len + b_len, kind, page_id);
+    if (!g_output_stream_write_all(g_output, header, sizeof(header), NULL, NULL, NULL)
+        || (a_len > 0 && !g_output_stream_write_all(g_output, a, a_len, NULL, NULL, NULL))
+        || (b_len > 0 && !g_output_stream_write_all(g_output, b, b_len, NULL, NULL, NULL)))
+    {
+        close_connection();
+    }
+}
+
+/* ========== Delivery into the page ========== */
+
+static void deliver_to_page(uint8_t kind, uint64_t page_id, const char* payload, uint32_t len)
+{
+    WebKitWebPage* page = webkit_web_extension_get_page(g_extension, page_id);
+    if (page == NULL) return;
+
+    JSCContext* ctx = webkit_frame_get_js_context(webkit_web_page_get_main_frame(page));
+    JSCValue* ag = jsc_context_get_value(ctx, "agWebView");
+    JSCValue* rpc = jsc_value_is_object(ag) ? jsc_value_object_get_property(ag, "rpc") : NULL;
+    JSCValue* fn = rpc != NULL && jsc_value_is_object(rpc)
+        ? jsc_value_object_get_property(rpc, kind == AG_BRIDGE_FRAME_DISPATCH ? "_dispatch" : "_onResponse")
+        : NULL;
+
+    if (fn != NULL && jsc_value_is_function(fn))
+    {
+        char* json = g_strndup(payload, len);
+        JSCValue* result = jsc_value_function_call(fn, G_TYPE_STRING, json, G_TYPE_NONE);
+        g_clear_object(&result);
+        g_free(json);
+        jsc_context_clear_exception(ctx);
+    }
+
+    g_clear_object(&fn);
+    g_clear_object(&rpc);
+    g_object_unref(ag);
+    g_object_unref(ctx);
+}
+
+static void process_frames(void)
+{
+    while (g_read_buffer->len >= AG_BRIDGE_HEADER_SIZE)
+    {
+        uint32_t len;
+        uint8_t kind;
+        uint64_t page_id;
+        ag_bridge_read_header(g_read_buffer->data, &len, &kind, &page_id);
+        if (len > AG_BRIDGE_MAX_PAYLOAD)
+        {
+            close_connection();
+            return;
+        }
+        if (g_read_buffer->len < AG_BRIDGE_HEADER_SIZE + len)
+            return;
+
+        if (kind == AG_BRIDGE_FRAME_DISPATCH || kind == AG_BRIDGE_FRAME_RESPONSE)
+            deliver_to_page(kind, page_id, (const char*)g_read_buffer->data + AG_BRIDGE_HEADER_SIZE, len);
+
+        g_byte_array_remove_range(g_read_buffer, 0, AG_BRIDGE_HEADER_SIZE + len);
+    }
+}
+
+static void start_read(void);
+
+static void on_read(GObject* source, GAsyncResult* result, gpointer user_data)
+{
+    gssize n = g_input_stream_read_finish(G_INPUT_STREAM(source), result, NULL);
+    if (n <= 0)
+    {
+        close_connection();
+        return;
+    }
+    g_byte_array_append(g_read_buffer, g_read_chunk, (guint)n);
+    process_frames();
+    start_read();
+}
+
+static void start_read(void)
+{
+    if (g_connection == NULL) return;
+    g_input_stream_read_async(g_io_stream_get_input_stream(G_IO_STREAM(g_connection)),
+        g_read_chunk, sizeof(g_read_chunk), G_PRIORITY_DEFAULT, NULL, on_read, NULL);
+}
+
+/* ========== window.__agibuildBridge ========== */
+
+static void bridge_post_message(const char* body, gpointer user_data)
+{
+    uint64_t page_id = *(uint64_t*)user_data;
+    if (body == NULL) return;
+
+    /* The shim stamps the page's origin, as it does for script messages. */
+    send_frame(AG_BRIDGE_FRAME_MESSAGE, page_id, body, (uint32_t)strlen(body), NULL, 0);
+}
+
+static void on_window_object_cleared(WebKitScriptWorld* world, WebKitWebPage* page, WebKitFrame* frame,
+                                     gpointer user_data)
+{
+    if (g_connection == NULL) return;
+
+    uint64_t* page_id = g_new(uint64_t, 1);
+    *page_id = webkit_web_page_get_id(page);
+
+    JSCContext* ctx = webkit_frame_get_js_context_for_script_world(frame, world);
+    JSCValue* bridge = jsc_value_new_object(ctx, NULL, NULL);
+    JSCValue* post = jsc_value_new_function(ctx, "postMessage", G_CALLBACK(bridge_post_message),
+        page_id, g_free, G_TYPE_NONE, 1, G_TYPE_STRING);
+    JSCValue* native = jsc_value_new_boolean(ctx, TRUE);
+
+    jsc_value_object_set_property(bridge, "postMessage", post);
+    jsc_value_object_set_property(bridge, "native", native);
+    jsc_context_set_value(ctx, "__agibuildBridge", bridge);
+
+    g_object_unref(native);
+    g_object_unref(post);
+    g_object_unref(bridge);
+    g_object_unref(ctx);
+}
+
+static void on_page_destroyed(gpointer data, GObject* where_the_page_was)
+{
+    uint64_t page_id = *(uint64_t*)data;
+    send_frame(AG_BRIDGE_FRAME_GOODBYE, page_id, NULL, 0, NULL, 0);
+    g_free(data);
+}
+
+static void on_page_created(WebKitWebExtension* extension, WebKitWebPage* page, gpointer user_data)
+{
+    uint64_t* page_id = g_new(uint64_t, 1);
+    *page_id = webkit_web_page_get_id(page);
+    send_frame(AG_BRIDGE_FRAME_HELLO, *page_id, NULL, 0, NULL, 0);
+    g_object_weak_ref(G_OBJECT(page), on_page_destroyed, page_id);
+}
+
+/* ========== Entry point ========== */
+
+/* user_data is the shim's socket path (a string variant). Without a connection the extension
+ * installs nothing and the page keeps using webkit.messageHandlers. */
+G_MODULE_EXPORT void webkit_web_extension_initialize_with_user_data(WebKitWebExtension* extension,
+                                                                   const GVariant* user_data)
+{
+    if (user_data == NULL || !g_variant_is_of_type((GVariant*)user_data, G_VARIANT_TYPE_STRING))
+        return;
+
+    const char* path = g_variant_get_string((GVariant*)user_data, NULL);
+    GSocketAddress* address = g_unix_socket_address_new(path);
+    GSocketClient* client = g_socket_client_new();
+    g_connection = g_socket_client_connect(client, G_SOCKET_CONNECTABLE(address), NULL, NULL);
+    g_object_unref(client);
+    g_object_unref(address);
+    if (g_connection == NULL)
+        return;
+
+    g_extension = extension;
+    g_output = g_io_stream_get_output_stream(G_IO_STREAM(g_connection));
+    g_read_buffer = g_byte_array_new();
+
+    g_signal_connect(extension, "page-created", G_CALLBACK(on_page_created), NULL);
+    g_signal_connect(webkit_script_world_get_default(), "window-object-cleared",
+        G_CALLBACK(on_window_object_cleared), NULL);
+    start_read();
+}
@@ -0,0 +1,49 @@
+/*
+ * Frame protocol between the WebKitGTK shim and its bridge web extension
+ * (WebKitGtkBridgeExtension.c), over a Unix stream socket owned by the shim.
+ *
+ * Every frame is a fixed header followed by payload_len bytes, in host byte order
+ * (both ends run on the same machine):
+ *
+ *   uint32_t payload_len | uint8_t kind | uint64_t page_id | payload
+ *
+ * page_id is webkit_web_page_get_id / webkit_web_view_get_page_id, which identify the same
+ * page in the web and UI processes. One connection per web process carries all its pages.
+ */
+
+#ifndef AG_WEBKIT_GTK_BRIDGE_PROTOCOL_H
+#define AG_WEBKIT_GTK_BRIDGE_PROTOCOL_H
+
+#include <stdint.h>
+#include <string.h>
+
+#define AG_BRIDGE_HEADER_SIZE 13
+#define AG_BRIDGE_MAX_PAYLOAD (64u * 1024u * 1024u)
+
+/* extension -> shim: the page exists; payload empty. */
+#define AG_BRIDGE_FRAME_HELLO 1
+/* extension -> shim: window.__agibuildBridge.postMessage; payload is the UTF-8 body, not
+ * NUL-terminated. */
+#define AG_BRIDGE_FRAME_MESSAGE 2
+/* shim -> extension: payload is the JSON passed to window.agWebView.rpc._dispatch. */
+#define AG_BRIDGE_FRAME_DISPATCH 3
+/* shim -> extension: payload is the JSON passed to window.agWebView.rpc._onResponse. */
+#define AG_BRIDGE_FRAME_RESPONSE 4
+/* extension -> shim: the page was destroyed; payload empty. */
+#define AG_BRIDGE_FRAME_GOODBYE 5
+
+static inline void ag_bridge_write_header(uint8_t* out, uint32_t payload_len, uint8_t kind, uint64_t page_id)
+{
+    memcpy(out, &payload_len, 4);
+    out[4] = kind;
+    memcpy(out + 5, &page_id, 8);
+}
+
+static inline void ag_bridge_read_header(const uint8_t* in, uint32_t* payload_len, uint8_t* kind, uint64_t* page_id)
+{
+    memcpy(payload_len, in, 4);
+    *kind = in[4];
+    memcpy(page_id, in + 5, 8);
+}
+
+#endif
@@ -9,8 +9,13 @@
  * Build command:
  *   gcc -shared -fPIC -o libAgibuildWebViewGtk.so WebKitGtkShim.c \
  *       $(pkg-config --cflags --libs webkit2gtk-4.1 gtk+-3.0)
+ *
+ * The optional bridge web extension (WebKitGtkBridgeExtension.c) is looked up in
+ * webkit-extensions/ next to this library.
  */
 
+#define _GNU_SOURCE /* dladdr */
+
 #include <gtk/gtk.h>
 #include <gtk/gtkx.h>
 #include <gio/gio.h>
@@ -20,6 +25,11 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <stdatomic.h>
+#include <dlfcn.h>
+#include <unistd.h>
+#include <gio/gunixsocketaddress.h>
+
+#include "WebKitGtkBridgeProtocol.h"
 
 /* ========== Callback typedefs ========== */
 
@@ -53,28 +63,102 @@ typedef void (*ag_gtk_script_result_cb)(
     const char* result_utf8,
     const char* error_message_utf8);
 
+/* Status passed to ag_gtk_script_settled_cb. Only COMPLETED is followed by on_script_result. */
+#define AG_GTK_SCRIPT_COMPLETED 0
+#define AG_GTK_SCRIPT_CANCELLED 1
+#define AG_GTK_SCRIPT_TIMED_OUT 2
+
+/* Return values of ag_gtk_eval_js. */
+#define AG_GTK_EVAL_STARTED      0
+#define AG_GTK_EVAL_QUEUED       1
+#define AG_GTK_EVAL_REJECTED    (-1) /* in-flight and queue limits reached */
+#define AG_GTK_EVAL_UNAVAILABLE (-2) /* detached or no web view */
+
+/* Return values of ag_gtk_publish_blob. On failure the release callback is not called. */
+#define AG_GTK_BLOB_PUBLISHED     0
+#define AG_GTK_BLOB_INVALID_ID   (-1) /* not made of [A-Za-z0-9._-], or no buffer */
+#define AG_GTK_BLOB_NO_MEMORY    (-2)
+#define AG_GTK_BLOB_UNAVAILABLE  (-3) /* detached */
+#define AG_GTK_BLOB_DUPLICATE_ID (-4) /* already published; revoke it first */
+
+/* Fired once for every tracked evaluation when it leaves the shim. queued_us is the wait for
+ * an in-flight slot, run_us the time in the web process (0 if it never started). */
+typedef void (*ag_gtk_script_settled_cb)(
+    void* user_data,
+    uint64_t request_id,
+    int32_t status,
+    int64_t queued_us,
+    int64_t run_us);
+
+/* A script result kept in a native buffer: data[0..length) is UTF-8 without a terminator and
+ * may contain NULs. The callee owns buffer and must pass it to ag_gtk_buffer_release. */
+typedef void (*ag_gtk_script_buffer_cb)(
+    void* user_data,
+    uint64_t request_id,
+    void* buffer,
+    const uint8_t* data,
+    int64_t length);
+
+/* Offscreen mode: a new frame is ready for ag_gtk_offscreen_acquire_frame. copy_us is the time
+ * spent copying its damaged regions into the frame buffer. */
+typedef void (*ag_gtk_offscreen_frame_cb)(void* user_data, uint64_t sequence, int64_t copy_us);
+
 typedef void (*ag_gtk_message_cb)(
     void* user_data,
     const char* body_utf8,
     const char* origin_utf8);
 
-typedef void (*ag_gtk_download_cb)(
+/* A download of this view needs a destination. Returns AG_GTK_DOWNLOAD_*; with ACCEPTED the
+ * callee has already called ag_gtk_download_set_destination, with DEFERRED it will call it (or
+ * ag_gtk_download_cancel) later. */
+typedef int32_t (*ag_gtk_download_cb)(
     void* user_data,
+    uint64_t download_id,
     const char* url_utf8,
     const char* suggested_filename_utf8,
     const char* mime_type_utf8,
     int64_t content_length);
 
+/* Coalesced to at most one call per progress interval. total is -1 when unknown. */
+typedef void (*ag_gtk_download_progress_cb)(
+    void* user_data,
+    uint64_t download_id,
+    int64_t received,
+    int64_t total,
+    double bytes_per_second);
+
+/* status is AG_GTK_DOWNLOAD_COMPLETED/FAILED/CANCELLED; path is NULL unless completed. */
+typedef void (*ag_gtk_download_finished_cb)(
+    void* user_data,
+    uint64_t download_id,
+    int32_t status,
+    const char* path_utf8,
+    int64_t received,
+    const char* error_utf8);
+
 typedef void (*ag_gtk_permission_cb)(
     void* user_data,
     int permission_kind, /* 0=Unknown, 1=Camera, 2=Microphone, 3=Geolocation, 6=Notifications */
     const char* origin_utf8,
     int* out_state); /* 0=Default, 1=Allow, 2=Deny */
 
-typedef bool (*ag_gtk_scheme_request_cb)(
+/* Readable request body of a custom-scheme request (POST/PUT uploads); see "Custom scheme
+ * request bodies". */
+typedef struct ag_gtk_scheme_body ag_gtk_scheme_body;
+
+/* Returns AG_GTK_SCHEME_NOT_HANDLED (404), AG_GTK_SCHEME_RESPONDED (the out_ parameters hold
+ * the response) or, for requests with a body only, AG_GTK_SCHEME_DEFERRED: managed code then
+ * owns a reference to `body` (ag_gtk_scheme_body_close) and answers later with
+ * ag_gtk_scheme_request_respond/_fail(request_id). headers_utf8 is "Name: value\n" lines;
+ * body is NULL and request_id 0 for requests without a body. */
+typedef int32_t (*ag_gtk_scheme_request_cb)(
     void* user_data,
     const char* url_utf8,
     const char* method_utf8,
+    const char* headers_utf8,
+    uint64_t request_id,
+    ag_gtk_scheme_body* body,
+    int64_t body_length, /* Content-Length, or -1 */
     const void** out_response_data,
     int64_t* out_response_length,
     const char** out_mime_type_utf8,
@@ -89,9 +173,13 @@ typedef bool (*ag_gtk_context_menu_cb)(
     const char* media_source_uri,
     bool is_editable);
 
+/* ag_gtk_drag_entered_cb: the dragged data in the same shape as ag_gtk_drop_performed_cb
+ * below; the strings live only for the duration of the callback. */
 typedef void (*ag_gtk_drag_entered_cb)(
     void* user_data,
-    const char* files_json_utf8,
+    int32_t file_count,
+    const char* const* file_paths,
+    const char* const* file_uris,
     const char* text_utf8,
     double x, double y);
 
@@ -102,12 +190,60 @@ typedef void (*ag_gtk_drag_updated_cb)(
 typedef void (*ag_gtk_drag_exited_cb)(
     void* user_data);
 
+/* ag_gtk_drop_performed_cb: file_paths and file_uris are parallel arrays of file_count entries.
+ * file_uris are the dropped URIs verbatim; file_paths[i] is the decoded local path, or NULL when
+ * the URI is not a local file. All strings live in one shim-owned arena that is freed as soon
+ * as the callback returns. */
 typedef void (*ag_gtk_drop_performed_cb)(
     void* user_data,
-    const char* files_json_utf8,
+    int32_t file_count,
+    const char* const* file_paths,
+    const char* const* file_uris,
     const char* text_utf8,
     double x, double y);
 
+/* ag_gtk_web_process_terminated_cb: reason is the WebKitWebProcessTerminationReason
+ * (0=Crashed, 1=ExceededMemoryLimit, 2=TerminatedByApi). recovering is true when the shim
+ * is reloading the last committed history entry on a fresh web process. */
+typedef void (*ag_gtk_web_process_terminated_cb)(
+    void* user_data,
+    int reason,
+    bool recovering);
+
+/* ag_gtk_web_process_hang_cb: event is AG_GTK_HANG_STARTED when WebKit marks the web process
+ * unresponsive, AG_GTK_HANG_RECOVERED when it answers again and AG_GTK_HANG_TERMINATED when the
+ * process went away first. duration_us is the time since the hang started, 0 for STARTED. */
+#define AG_GTK_HANG_STARTED    0
+#define AG_GTK_HANG_RECOVERED  1
+#define AG_GTK_HANG_TERMINATED 2
+
+typedef void (*ag_gtk_web_process_hang_cb)(
+    void* user_data,
+    int event,
+    int64_t duration_us);
+
+/* Main-frame navigation timing. start_us is the monotonic clock (g_get_monotonic_time) when the
+ * navigation's policy decision was requested, or when the load started if it had none; every
+ * other *_us field is an offset from start_us, or -1 if the phase was not reached. */
+typedef struct
+{
+    int64_t start_us;
+    int64_t policy_decided_us;
+    int64_t policy_wait_us;  /* total time spent waiting on managed policy decisions, redirects included */
+    int64_t load_started_us;
+    int64_t committed_us;
+    int64_t first_paint_us;  /* first frame drawn after commit */
+    int64_t finished_us;
+    int32_t redirect_count;
+    int32_t status;          /* as for ag_gtk_nav_completed_cb */
+} ag_gtk_navigation_timing;
+
+/* ag_gtk_navigation_timing_cb: called once per main-frame load, after on_navigation_completed. */
+typedef void (*ag_gtk_navigation_timing_cb)(
+    void* user_data,
+    const char* url_utf8,
+    const ag_gtk_navigation_timing* timing);
+
 struct ag_gtk_callbacks
 {
     ag_gtk_policy_request_cb on_policy_request;
@@ -122,6 +258,14 @@ struct ag_gtk_callbacks
     ag_gtk_drag_updated_cb on_drag_updated;
     ag_gtk_drag_exited_cb on_drag_exited;
     ag_gtk_drop_performed_cb on_drop_performed;
+    ag_gtk_web_process_terminated_cb on_web_process_terminated;
+    ag_gtk_navigation_timing_cb on_navigation_timing;
+    ag_gtk_script_settled_cb on_script_settled;
+    ag_gtk_script_buffer_cb on_script_buffer;
+    ag_gtk_offscreen_frame_cb on_offscreen_frame;
+    ag_gtk_download_progress_cb on_download_progress;
+    ag_gtk_download_finished_cb on_download_finished;
+    ag_gtk_web_process_hang_cb on_web_process_hang;
 };
 
 /* ========== Cookie operation callbacks ========== */
@@ -129,44 +273,507 @@ struct ag_gtk_callbacks
 typedef void (*ag_gtk_cookies_get_cb)(void* context, const char* json_utf8);
 typedef void (*ag_gtk_cookie_op_cb)(void* context, bool success, const char* error_utf8);
 
+/* ========== Content filter callbacks ========== */
+
+/* from_cache is true when the compiled filter was loaded from the on-disk store without
+ * recompiling; elapsed_us covers the load (and compile, on a cache miss) on the GTK thread. */
+typedef void (*ag_gtk_content_filter_cb)(void* context, bool success, bool from_cache,
+    int64_t elapsed_us, const char* error_utf8);
+
+/* ========== Hibernation callbacks ========== */
+
+/* Completion of ag_gtk_hibernate. */
+typedef void (*ag_gtk_hibernate_cb)(void* context, bool success, const char* error_utf8);
+
+/* Per-origin website data usage; sizes are indexed by the bit position of the
+ * WebKitWebsiteDataTypes flag and are 0 for types WebKit does not size. */
+#define AG_GTK_WEBSITE_DATA_TYPE_SLOTS 16
+
+typedef struct
+{
+    const char* name;
+    uint32_t types;
+    uint64_t sizes[AG_GTK_WEBSITE_DATA_TYPE_SLOTS];
+} ag_gtk_website_data_entry;
+
+typedef void (*ag_gtk_website_data_fetch_cb)(void* context, bool success,
+    int32_t count, const ag_gtk_website_data_entry* entries, const char* error_utf8);
+
+/* WebKitSettings performance profile. Every field is -1 to keep the WebKit default,
+ * otherwise 0/1 (or a WebKitHardwareAccelerationPolicy value). */
+typedef struct
+{
+    int32_t hardware_acceleration_policy;
+    int32_t enable_page_cache;
+    int32_t enable_smooth_scrolling;
+    int32_t enable_mediasource;
+    int32_t enable_webgl;
+    int32_t enable_write_console_messages_to_stdout;
+} ag_gtk_performance_profile;
+
+/* One recorded subresource (or main resource) load. Strings are valid for the duration of
+ * the callback only. Durations are in microseconds; -1 when the phase was not reached. */
+typedef struct
+{
+    const char* url;
+    const char* method;
+    const char* mime_type;    /* NULL without a response */
+    int32_t status;           /* HTTP status, 0 without a response */
+    int32_t failed;
+    int64_t started_unix_us;  /* wall clock (g_get_real_time) when the request started */
+    int64_t wait_us;          /* request start to response */
+    int64_t receive_us;       /* response to finished/failed */
+    int64_t total_us;
+    int64_t size;             /* response content length, -1 when unknown */
+    int64_t handler_us;       /* time spent in the managed custom-scheme handler, -1 otherwise */
+} ag_gtk_resource_timing;
+
+typedef void (*ag_gtk_resource_timings_cb)(void* context, int32_t count, const ag_gtk_resource_timing* entries);
+
+/* Called once the last reference to a published blob is gone: after revoke (or destroy) and
+ * after every response still reading from it has finished. May run on any thread. */
+typedef void (*ag_gtk_blob_release_cb)(void* context);
+
 /* ========== Shim state ========== */
 
+typedef struct bridge_peer bridge_peer;
+typedef struct op_table op_table;
+typedef struct offscreen_ring offscreen_ring;
+
+typedef struct
+{
+    char* url;
+    char* method;
+    char* mime_type;
+    int32_t status;
+    gboolean failed;
+    gint64 started_unix_us;
+    gint64 start_us;
+    gint64 response_us; /* -1 until the response arrives */
+    gint64 end_us;
+    int64_t size;
+    int64_t handler_us;
+} resource_record;
+
 typedef struct
 {
     struct ag_gtk_callbacks callbacks;
     void* user_data;
 
-    GtkWidget* plug;         /* GtkPlug embedding container */
+    GtkWidget* plug;         /* GtkPlug embedding container (GtkOffscreenWindow in offscreen mode) */
     WebKitWebView* web_view;
     WebKitUserContentManager* content_manager;
+    WebKitWebContext* web_context; /* owned ref, chosen at first attach */
     WebKitWebsiteDataManager* data_manager;
 
-    atomic_uint_fast64_t next_request_id;
     atomic_bool detached;
     atomic_bool dev_tools_open;
     gboolean gtk_initialized;
 
-    /* Pending policy decisions: request_id -> WebKitPolicyDecision* */
-    GHashTable* pending_policy;
+    /* Outstanding asynchronous operations (policy decisions, scripts, captures, cookie reads). */
+    op_table* ops;
 
     /* Options — set before attach. */
     gboolean opt_enable_dev_tools;
     gboolean opt_ephemeral;
     char* opt_user_agent; /* owned, NULL if not set */
+    char* opt_data_dir;   /* owned, NULL = WebKit default (ignored when ephemeral) */
+    char* opt_cache_dir;  /* owned, NULL = WebKit default */
+    int opt_cache_model;  /* WebKitCacheModel, -1 = leave context default */
+    ag_gtk_performance_profile opt_profile;
 
     /* Custom scheme registrations — set before attach. */
     char** custom_schemes; /* NULL-terminated array of scheme strings, owned */
     int custom_scheme_count;
 
+    /* Fetch bridge scheme (GTK thread), registered secure and CORS-enabled on the view's
+     * context. NULL when the bridge uses script messages. */
+    char* fetch_bridge_scheme;
+
     /* Drag-drop state — whether drag is currently over the widget */
     gboolean drag_inside;
 
+    /* GTK only hands over drag data on request, so drag-enter asks for it and is reported
+     * from drag-data-received at the latest motion position (GTK thread only). */
+    gboolean drag_enter_requested;
+    double drag_enter_x;
+    double drag_enter_y;
+
+    /* Drag-motion coalescing (GTK thread only): the latest position waits in
+     * drag_motion_x/y until the next frame tick (interval 0) or interval timeout. */
+    int opt_drag_motion_interval_ms;
+    gboolean drag_motion_pending;
+    double drag_motion_x;
+    double drag_motion_y;
+    guint drag_motion_tick_id;
+    guint drag_motion_timeout_id;
+    atomic_uint_fast64_t drag_motion_delivered;
+    atomic_uint_fast64_t drag_motion_suppressed;
+
+    /* Preload scripts added one at a time: id (char*) -> WebKitUserScript*, both owned. */
+    GHashTable* user_scripts;
+
+    /* Shared content sets attached to this view (content_set*, not owned; GTK thread). */
+    GPtrArray* attached_content_sets;
+
+    /* Speculative preloading: a hidden view on the same context warms the network cache for
+     * likely next URLs. preload_lock guards the queue, the ready set and the counters. */
+    GMutex preload_lock;
+    WebKitWebView* preload_view;  /* owned, GTK thread; NULL until first preload */
+    GQueue* preload_queue;        /* char* URLs waiting to load */
+    char* preload_current;        /* URL loading in preload_view */
+    GHashTable* preload_ready;    /* URL -> completion time (g_get_monotonic_time) */
+    gboolean preload_used;
+    uint64_t preload_hits;
+    uint64_t preload_misses;
+    uint64_t preload_wasted;
+
+    /* Activity state (AG_GTK_ACTIVITY_*) the host asked for; kept across hibernation and
+     * re-applied whenever the web view is (re)built. GTK thread. */
+    int activity_state;
+
+    /* Hibernation: the web view (and its web process) is released while the plug, content
+     * manager and context stay; the session state rebuilds it on resume. GTK thread, except
+     * hibernated, which ag_gtk_is_hibernated reads atomically from any thread. */
+    gint hibernated;
+    gboolean hibernating;
+    WebKitWebViewSessionState* hibernation_session;
+    double hibernation_scroll_x;
+    double hibernation_scroll_y;
+    gboolean restore_scroll_pending;
+    /* The resume reload of restoring_uri is underway: it is neither offered to the host's
+     * policy callback nor reported as completed, since the host already saw the original. */
+    gboolean restoring_session;
+    char* restoring_uri;
+    GtkWidget* hibernation_placeholder; /* last-frame snapshot shown while hibernated */
+
+    /* Web process crash recovery. The back/forward list lives in the UI process and survives
+     * a crash, so recovery reloads its current entry. GTK thread except the counters. */
+    gboolean opt_crash_recovery;
+    int consecutive_crashes;         /* reset when a load finishes */
+    gint64 recovery_started_us;      /* g_get_monotonic_time of the recovery reload, 0 = none */
+    atomic_uint_fast64_t web_process_terminations;
+    atomic_uint_fast64_t crash_recoveries;
+    atomic_int_fast64_t last_recovery_us;
+
+    /* Responsiveness watchdog (GTK thread). hang_started_us is g_get_monotonic_time when WebKit
+     * reported the web process unresponsive, 0 while it responds. */
+    gint64 hang_started_us;
+    int64_t opt_hang_terminate_ms;   /* 0 = report only */
+    guint hang_terminate_id;
+    gboolean hang_terminated;        /* the watchdog terminated the current process */
+
+    /* Main-frame navigation timing (GTK thread). A policy request is parked in the
+     * nav_timing_policy_* fields until the load it leads to starts or redirects;
+     * ag_gtk_policy_decide stamps the decision from the caller's thread. */
+    gboolean nav_timing_active;
+    ag_gtk_navigation_timing nav_timing;
+    gint64 nav_timing_policy_requested_us;
+    atomic_uint_fast64_t nav_timing_policy_req_id;
+    atomic_int_fast64_t nav_timing_policy_decided_us;
+
+    /* Resource timing (GTK thread): completed loads go to a ring of resource_ring_capacity
+     * records. Loads in flight are tracked so the scheme handler can tag them by URL and
+     * detach can drop them. */
+    gboolean resource_timing_enabled;
+    resource_record* resource_ring;
+    int resource_ring_capacity;
+    int resource_ring_count;
+    int resource_ring_next;
+    GHashTable* resource_inflight; /* set of resource_load*, freed through their resource */
+
+    /* Script evaluations (GTK thread): every tracked request, queued or running. */
+    GHashTable* eval_ops;     /* request id (guint64*) -> eval_op* */
+    GQueue* eval_queue;       /* eval_op* waiting for an in-flight slot */
+    int32_t eval_running;
+    int32_t eval_max_running; /* 0 = unlimited */
+    int32_t eval_max_queued;
+    int32_t eval_timeout_ms;  /* 0 = none */
+    int64_t eval_buffer_threshold; /* results at least this large go to on_script_buffer; 0 = off */
+
+    /* Published blobs served from host memory at <scheme>://<host>/__blob/<id>. */
+    GMutex blob_lock;
+    GHashTable* blobs; /* id -> published_blob*, guarded by blob_lock */
+
+    /* Native bridge transport through the web extension (GTK thread). */
+    gboolean opt_native_bridge;
+    guint64 bridge_page_id;   /* registered page id, 0 when not registered */
+    bridge_peer* bridge_peer; /* connection that said HELLO for bridge_page_id, not owned */
+    gulong bridge_page_id_handler;
+
+    /* Offscreen composition: the view renders into a GtkOffscreenWindow and damaged regions are
+     * copied into a ring of frame buffers the host draws itself. Set before attach. */
+    gboolean opt_offscreen;
+    int32_t offscreen_width;
+    int32_t offscreen_height;
+    offscreen_ring* offscreen; /* set and cleared under offscreen_lock; the ring's handoff fields use its own lock */
+    offscreen_ring* offscreen_held; /* ring the consumer holds a frame of, under offscreen_lock */
+    GMutex offscreen_lock;
+
+    gint64 download_progress_interval_us;
+
+    /* Compiled content filters (WebKitUserContentFilter*, owned refs) attached to the
+     * content manager; kept across attach so do_attach can re-apply them. */
+    GPtrArray* content_filters;
+    char* opt_content_filter_path; /* owned, NULL = default cache dir */
+
 } shim_state;
 
 typedef void* ag_gtk_handle;
 
 /* Forward declarations */
 void ag_gtk_detach(ag_gtk_handle handle);
+static void attach_content_filters(shim_state* s);
+static void attach_content_sets(shim_state* s);
+static void apply_performance_profile(shim_state* s, WebKitSettings* settings);
+static void release_hibernation_state(shim_state* s);
+static void cancel_pending_policies(shim_state* s);
+static void on_resource_load_started(WebKitWebView* web_view, WebKitWebResource* resource,
+    WebKitURIRequest* request, gpointer user_data);
+static void note_scheme_handler_time(shim_state* s, const char* uri, gint64 elapsed_us);
+static void release_resource_timing(shim_state* s);
+static void drop_inflight_resources(shim_state* s);
+static void bridge_register_view(shim_state* s);
+static void bridge_unregister_view(shim_state* s);
+static void eval_start_queued(shim_state* s);
+static void eval_abort_all(shim_state* s);
+static GtkWidget* offscreen_create_window(shim_state* s);
+static void offscreen_destroy(shim_state* s);
+static void activity_apply(shim_state* s);
+static void hang_end(shim_state* s, int event);
+static void hang_reset(shim_state* s);
+static void on_web_process_responsive_changed(GObject* object, GParamSpec* pspec, gpointer user_data);
+typedef struct published_blob published_blob;
+static void published_blob_free(published_blob* blob);
+static gboolean serve_published_blob(shim_state* s, WebKitURISchemeRequest* request, const char* uri);
+static void fetch_bridge_register(shim_state* s);
+static void destroy_preload_view(shim_state* s);
+static void note_navigation_for_preload(shim_state* s, const char* url);
+static WebKitWebContext* get_data_dir_context(const char* data_dir, const char* cache_dir);
+static void detach_content_sets(shim_state* s);
+static void freeze_process_options(void);
+
+/* ========== Resource accounting ========== */
+
+/* Process-wide counts reported by ag_gtk_get_resource_stats, so long-running hosts and the
+ * lifecycle soak can check that views give back everything they take. */
+static atomic_int_fast64_t g_live_views;
+static atomic_int_fast64_t g_attached_views;
+static atomic_int_fast64_t g_live_op_tables;
+static atomic_int_fast64_t g_outstanding_ops;
+
+/* Views (main, preload) point back at their shim_state so context-wide handlers can route by
+ * view; cleared before the state is freed. */
+#define AG_SHIM_STATE_KEY "ag-shim-state"
+
+/* ========== Operation slots ========== */
+
+/* Every asynchronous operation a view has outstanding (policy decisions waiting on managed
+ * code, script evaluations, screenshots, PDF exports, cookie reads, downloads, custom-scheme
+ * requests with a body, content-filter loads) holds a slot in the view's
+ * table. Slots live in fixed-size chunks that never move, carry the operation's context inline
+ * and are recycled through a free list. An id is the slot's generation in the high 32 bits and
+ * its index + 1 in the low 32 bits: a stale id never matches a reused slot, and an id can be
+ * resolved and claimed from any thread without the table lock. */
+
+#define AG_GTK_OP_POLICY     1
+#define AG_GTK_OP_SCRIPT     2
+#define AG_GTK_OP_SCREENSHOT 3
+#define AG_GTK_OP_PDF        4
+#define AG_GTK_OP_COOKIES    5
+#define AG_GTK_OP_DOWNLOAD   6
+#define AG_GTK_OP_SCHEME     7
+#define AG_GTK_OP_FILTER     8
+
+#define OP_CHUNK_SLOTS  256
+#define OP_MAX_CHUNKS   64 /* 16384 outstanding operations per view */
+#define OP_PAYLOAD_SIZE 128
+
+typedef struct op_slot op_slot;
+
+/* Completes a claimed operation because its view is going away. Async kinds report their usual
+ * failure result and keep the slot until WebKit finishes with it; others release it. */
+typedef void (*op_abort_fn)(op_slot* slot);
+
+struct op_slot
+{
+    _Atomic uint64_t live; /* id while the operation can still be completed, 0 otherwise */
+    uint64_t id;           /* current operation, stable until release */
+    op_table* table;
+    uint32_t generation;
+    int32_t kind;
+    int32_t next_free;     /* free list link, -1 = end */
+    gboolean in_use;       /* acquired and not yet released; guarded by the table lock */
+    gint64 started_us;
+    op_abort_fn abort;     /* NULL = the owning subsystem handles detach itself */
+    union
+    {
+        unsigned char bytes[OP_PAYLOAD_SIZE];
+        void* object;
+        gint64 align;
+    } payload;
+};
+
+struct op_table
+{
+    op_slot* _Atomic chunks[OP_MAX_CHUNKS];
+    GMutex lock;          /* acquire/release, free list, chunk creation */
+    int32_t free_head;    /* -1 = none */
+    uint32_t used;        /* slots below this index have been handed out at least once */
+    uint32_t outstanding;
+    gboolean orphaned;    /* the view was destroyed; the last release frees the table */
+};
+
+#define OP_PAYLOAD(slot, type) ((type*)(slot)->payload.bytes)
+
+static op_table* op_table_new(void)
+{
+    op_table* t = g_new0(op_table, 1);
+    g_mutex_init(&t->lock);
+    t->free_head = -1;
+    atomic_fetch_add(&g_live_op_tables, 1);
+    return t;
+}
+
+static void op_table_free(op_table* t)
+{
+    for (int i = 0; i < OP_MAX_CHUNKS; i++)
+        g_free(atomic_load(&t->chunks[i]));
+    g_mutex_clear(&t->lock);
+    g_free(t);
+    atomic_fetch_sub(&g_live_op_tables, 1);
+}
+
+static op_slot* op_slot_at(op_table* t, uint32_t index)
+{
+    op_slot* chunk = atomic_load(&t->chunks[index / OP_CHUNK_SLOTS]);
+    return chunk != NULL ? &chunk[index % OP_CHUNK_SLOTS] : NULL;
+}
+
+/* Returns a zeroed slot for a new operation, or NULL when the table is full. */
+static op_slot* op_slot_acquire(op_table* t, int32_t kind, op_abort_fn abort)
+{
+    g_mutex_lock(&t->lock);
+
+    op_slot* slot;
+    uint32_t index;
+    if (t->free_head >= 0)
+    {
+        index = (uint32_t)t->free_head;
+        slot = op_slot_at(t, index);
+        t->free_head = slot->next_free;
+    }
+    else if (t->used < OP_CHUNK_SLOTS * OP_MAX_CHUNKS)
+    {
+        index = t->used++;
+        if (index % OP_CHUNK_SLOTS == 0)
+            atomic_store(&t->chunks[index / OP_CHUNK_SLOTS], g_new0(op_slot, OP_CHUNK_SLOTS));
+        slot = op_slot_at(t, index);
+    }
+    else
+    {
+        g_mutex_unlock(&t->lock);
+        return NULL;
+    }
+
+    slot->generation = slot->generation == UINT32_MAX ? 1 : slot->generation + 1;
+    slot->id = ((uint64_t)slot->generation << 32) | (index + 1);
+    slot->table = t;
+    slot->kind = kind;
+    slot->next_free = -1;
+    slot->in_use = TRUE;
+    slot->started_us = g_get_monotonic_time();
+    slot->abort = abort;
+    memset(&slot->payload, 0, sizeof(slot->payload));
+    t->outstanding++;
+    atomic_fetch_add(&g_outstanding_ops, 1);
+    atomic_store(&slot->live, slot->id);
+
+    g_mutex_unlock(&t->lock);
+    return slot;
+}
+
+/* Resolves an id without claiming it. GTK thread, for kinds only ever released there. */
+static op_slot* op_table_find(op_table* t, uint64_t id, int32_t kind)
+{
+    uint32_t low = (uint32_t)id;
+    if (low == 0 || low > OP_CHUNK_SLOTS * OP_MAX_CHUNKS)
+        return NULL;
+    op_slot* slot = op_slot_at(t, low - 1);
+    return slot != NULL && atomic_load(&slot->live) == id && slot->kind == kind ? slot : NULL;
+}
+
+/* Takes the right to complete the slot's current operation; exactly one caller wins. */
+static gboolean op_slot_claim(op_slot* slot)
+{
+    uint64_t expected = slot->id;
+    return atomic_compare_exchange_strong(&slot->live, &expected, 0);
+}
+
+/* Resolves an id handed out to managed code and claims its operation. Lock-free and safe from
+ * any thread; NULL when the id is stale, already completed or of another kind. */
+static op_slot* op_table_claim(op_table* t, uint64_t id, int32_t kind)
+{
+    uint32_t low = (uint32_t)id;
+    if (low == 0 || low > OP_CHUNK_SLOTS * OP_MAX_CHUNKS)
+        return NULL;
+    op_slot* slot = op_slot_at(t, low - 1);
+    if (slot == NULL || atomic_load(&slot->live) != id || slot->kind != kind)
+        return NULL;
+    uint64_t expected = id;
+    return atomic_compare_exchange_strong(&slot->live, &expected, 0) ? slot : NULL;
+}
+
+static void op_slot_release(op_slot* slot)
+{
+    op_table* t = slot->table;
+    g_mutex_lock(&t->lock);
+    atomic_store(&slot->live, 0);
+    slot->abort = NULL;
+    slot->in_use = FALSE;
+    slot->next_free = t->free_head;
+    t->free_head = (int32_t)((uint32_t)slot->id - 1);
+    gboolean last = --t->outstanding == 0 && t->orphaned;
+    g_mutex_unlock(&t->lock);
+    atomic_fetch_sub(&g_outstanding_ops, 1);
+
+    if (last)
+        op_table_free(t);
+}
+
+/* Claims every outstanding operation of `kind` (0 = all) that has an abort handler and runs it.
+ * GTK thread. */
+static void op_table_abort(op_table* t, int32_t kind)
+{
+    GPtrArray* claimed = g_ptr_array_new();
+    g_mutex_lock(&t->lock);
+    for (uint32_t i = 0; i < t->used; i++)
+    {
+        op_slot* slot = op_slot_at(t, i);
+        if (slot->abort != NULL && (kind == 0 || slot->kind == kind) && op_slot_claim(slot))
+            g_ptr_array_add(claimed, slot);
+    }
+    g_mutex_unlock(&t->lock);
+
+    for (guint i = 0; i < claimed->len; i++)
+    {
+        op_slot* slot = (op_slot*)claimed->pdata[i];
+        slot->abort(slot);
+    }
+    g_ptr_array_free(claimed, TRUE);
+}
+
+/* The view is being destroyed. Slots still held by WebKit completions keep the table alive. */
+static void op_table_orphan(op_table* t)
+{
+    g_mutex_lock(&t->lock);
+    t->orphaned = TRUE;
+    gboolean idle = t->outstanding == 0;
+    g_mutex_unlock(&t->lock);
+
+    if (idle)
+        op_table_free(t);
+}
 
 /* ========== GTK thread safety ========== */
 
@@ -336,6 +943,118 @@ static int map_webkit_error(GError* error)
 
 /* ========== WebKitGTK signal handlers ========== */
 
+static void nav_timing_policy_requested(shim_state* s, uint64_t req_id)
+{
+    s->nav_timing_policy_requested_us = g_get_monotonic_time();
+    atomic_store(&s->nav_timing_policy_decided_us, 0);
+    atomic_store(&s->nav_timing_policy_req_id, req_id);
+}
+
+/* Adds the wait on a parked policy decision to the current record; returns the decision time. */
+static gint64 nav_timing_take_policy_decision(shim_state* s)
+{
+    atomic_store(&s->nav_timing_policy_req_id, 0);
+    gint64 decided = atomic_exchange(&s->nav_timing_policy_decided_us, 0);
+    gint64 requested = s->nav_timing_policy_requested_us;
+    s->nav_timing_policy_requested_us = 0;
+    if (decided == 0 || requested == 0 || !s->nav_timing_active)
+        return 0;
+
+    s->nav_timing.policy_wait_us += decided - requested;
+    return decided;
+}
+
+static void nav_timing_on_load_event(shim_state* s, WebKitLoadEvent event)
+{
+    gint64 now = g_get_monotonic_time();
+    ag_gtk_navigation_timing* t = &s->nav_timing;
+
+    if (event == WEBKIT_LOAD_STARTED && s->restoring_session)
+    {
+        /* The hibernation resume reload is not a navigation the host asked for; timing it
+         * would skew the load-time histograms with a cold process start. */
+        s->nav_timing_active = FALSE;
+        nav_timing_take_policy_decision(s);
+        return;
+    }
+
+    if (event == WEBKIT_LOAD_STARTED)
+    {
+        gint64 requested = s->nav_timing_policy_requested_us;
+        s->nav_timing_active = TRUE;
+        t->start_us = requested != 0 ? requested : now;
+        t->policy_decided_us = -1;
+        t->policy_wait_us = 0;
+        t->committed_us = -1;
+        t->first_paint_us = -1;
+        t->finished_us = -1;
+        t->redirect_count = 0;
+        t->status = 0;
+        gint64 decided = nav_timing_take_policy_decision(s);
+        if (decided != 0)
+            t->policy_decided_us = decided - t->start_us;
+        t->load_started_us = now - t->start_us;
+        return;
+    }
+
+    if (!s->nav_timing_active)
+        return;
+
+    /* A redirect asks for a policy decision of its own before it is reported. */
+    nav_timing_take_policy_decision(s);
+
+    if (event == WEBKIT_LOAD_REDIRECTED)
+        t->redirect_count++;
+    else if (event == WEBKIT_LOAD_COMMITTED)
+        t->committed_us = now - t->start_us;
+}
+
+static gboolean on_web_view_draw(GtkWidget* widget, cairo_t* cr, gpointer user_data)
+{
+    /* WebKitGTK does not report first visually non-empty layout to the UI process; the view
+     * keeps the previous page's frame until the new one has painted content, so the first
+     * draw after commit is the closest observable point. */
+    shim_state* s = (shim_state*)user_data;
+    if (s->nav_timing_active && s->nav_timing.committed_us >= 0 && s->nav_timing.first_paint_us < 0)
+        s->nav_timing.first_paint_us = g_get_monotonic_time() - s->nav_timing.start_us;
+    return FALSE;
+}
+
+static void nav_timing_finish(shim_state* s, const char* url)
+{
+    if (!s->nav_timing_active)
+        return;
+
+    s->nav_timing_active = FALSE;
+    s->nav_timing.finished_us = g_get_monotonic_time() - s->nav_timing.start_us;
+    if (s->callbacks.on_navigation_timing)
+        s->callbacks.on_navigation_timing(s->user_data, url ? url : "about:blank", &s->nav_timing);
+}
+
+static void abort_policy_decision(op_slot* slot)
+{
+    WebKitPolicyDecision* decision = (WebKitPolicyDecision*)slot->payload.object;
+    op_slot_release(slot);
+    webkit_policy_decision_ignore(decision);
+    g_object_unref(decision);
+}
+
+/* Holds a decision for managed code; returns its request id, or 0 when the table is full. */
+static uint64_t park_policy_decision(shim_state* s, WebKitPolicyDecision* decision)
+{
+    op_slot* slot = op_slot_acquire(s->ops, AG_GTK_OP_POLICY, abort_policy_decision);
+    if (slot == NULL)
+        return 0;
+    slot->payload.object = g_object_ref(decision);
+    return slot->id;
+}
+
+static void end_session_restore(shim_state* s)
+{
+    s->restoring_session = FALSE;
+    g_clear_pointer(&s->restoring_uri, g_free);
+}
+
 static gboolean on_decide_policy(WebKitWebView* web_view, WebKitPolicyDecision* decision,
                                   WebKitPolicyDecisionType type, gpointer user_data)
 {
@@ -353,11 +1072,9 @@ static gboolean on_decide_policy(WebKitWebView* web_view, WebKitPolicyDecision*
         WebKitURIRequest* request = webkit_navigation_action_get_request(action);
         const char* url = webkit_uri_request_get_uri(request);
 
-        if (s->callbacks.on_policy_request)
+        uint64_t req_id = s->callbacks.on_policy_request ? park_policy_decision(s, decision) : 0;
+        if (req_id != 0)
         {
-            uint64_t req_id = atomic_fetch_add(&s->next_request_id, 1);
-            g_object_ref(decision);
-            g_hash_table_insert(s->pending_policy, GUINT_TO_POINTER((guint)req_id), decision);
             s->callbacks.on_policy_request(s->user_data, req_id, url ? url : "", FALSE, TRUE, 0);
         }
         else
@@ -376,11 +1093,29 @@ static gboolean on_decide_policy(WebKitWebView* web_view, WebKitPolicyDecision*
         int nav_type = (int)webkit_navigation_action_get_navigation_type(action);
         gboolean is_main = webkit_navigation_policy_decision_get_frame_name(nav_decision) == NULL;
 
+        if (s->restoring_session && is_main)
+        {
+            /* The host approved the restored entry before hibernating. A redirect or any other
+             * URI is a navigation it has not seen, so it ends the restore and is offered below. */
+            if (nav_type == WEBKIT_NAVIGATION_TYPE_BACK_FORWARD && !webkit_navigation_action_is_redirect(action)
+                && url != NULL && s->restoring_uri != NULL && strcmp(url, s->restoring_uri) == 0)
+            {
+                webkit_policy_decision_use(decision);
+                return TRUE;
+            }
+            end_session_restore(s);
+        }
+
         if (s->callbacks.on_policy_request)
         {
-            uint64_t req_id = atomic_fetch_add(&s->next_request_id, 1);
-            g_object_ref(decision);
-            g_hash_table_insert(s->pending_policy, GUINT_TO_POINTER((guint)req_id), decision);
+            uint64_t req_id = park_policy_decision(s, decision);
+            if (req_id == 0)
+            {
+                webkit_policy_decision_ignore(decision);
+                return TRUE;
+            }
+            if (is_main)
+                nav_timing_policy_requested(s, req_id);
             s->callbacks.on_policy_request(s->user_data, req_id, url ? url : "", is_main, FALSE, nav_type);
         }
         else
@@ -399,14 +1134,36 @@ static void on_load_changed(WebKitWebView* web_view, WebKitLoadEvent event, gpoi
     if (atomic_load(&s->detached))
         return;
 
+    nav_timing_on_load_event(s, event);
+
     if (event == WEBKIT_LOAD_FINISHED)
     {
-        if (s->callbacks.on_navigation_completed)
+        s->consecutive_crashes = 0;
+        if (s->recovery_started_us != 0)
+        {
+            atomic_store(&s->last_recovery_us, g_get_monotonic_time() - s->recovery_started_us);
+            atomic_fetch_add(&s->crash_recoveries, 1);
+            s->recovery_started_us = 0;
+        }
+
+        if (s->restore_scroll_pending)
+        {
+            s->restore_scroll_pending = FALSE;
+            char script[96];
+            g_snprintf(script, sizeof(script), "window.scrollTo(%.0f, %.0f);",
+                s->hibernation_scroll_x, s->hibernation_scroll_y);
+            webkit_web_view_run_javascript(web_view, script, NULL, NULL, NULL);
+        }
+
+        const char* url = webkit_web_view_get_uri(web_view);
+        if (s->restoring_session)
+            end_session_restore(s);
+        else if (s->callbacks.on_navigation_completed)
         {
-            const char* url = webkit_web_view_get_uri(web_view);
             s->callbacks.on_navigation_completed(s->user_data, url ? url : "about:blank", 0, 0, "",
                 NULL, NULL, NULL, NULL, 0, 0);
         }
+        nav_timing_finish(s, url);
     }
 }
 
@@ -417,7 +1174,13 @@ static gboolean on_load_failed(WebKitWebView* web_view, WebKitLoadEvent event,
     if (atomic_load(&s->detached))
         return TRUE;
 
-    if (s->callbacks.on_navigation_completed)
+    s->recovery_started_us = 0; /* a recovery reload that fails did not recover */
+
+    /* load-changed FINISHED follows and reports the timing record. */
+    if (s->nav_timing_active)
+        s->nav_timing.status = map_webkit_error(error);
+
+    if (s->callbacks.on_navigation_completed && !s->restoring_session)
     {
         int status = map_webkit_error(error);
         int64_t code = error ? (int64_t)error->code : 0;
@@ -437,7 +1200,10 @@ static gboolean on_load_failed_tls(WebKitWebView* web_view, const char* failing_
     if (atomic_load(&s->detached))
         return TRUE;
 
-    if (s->callbacks.on_navigation_completed)
+    if (s->nav_timing_active)
+        s->nav_timing.status = 5; /* SSL */
+
+    if (s->callbacks.on_navigation_completed && !s->restoring_session)
     {
         char* host = ag_extract_host_from_uri_string(failing_uri);
         char* summary = ag_format_tls_certificate_errors(errors);
@@ -481,6 +1247,26 @@ static gboolean on_load_failed_tls(WebKitWebView* web_view, const char* failing_
     return TRUE;
 }
 
+/* Origin reported with page messages: scheme://host[:port] of the page's URI, or empty. */
+static void page_origin(shim_state* s, char* origin, size_t size)
+{
+    origin[0] = '\0';
+    const char* url = s->web_view != NULL ? webkit_web_view_get_uri(s->web_view) : NULL;
+    if (url == NULL)
+        return;
+
+    const char* scheme_end = strstr(url, "://");
+    if (scheme_end == NULL)
+        return;
+    const char* path_start = strchr(scheme_end + 3, '/');
+    size_t origin_len = path_start ? (size_t)(path_start - url) : strlen(url);
+    if (origin_len < size)
+    {
+        memcpy(origin, url, origin_len);
+        origin[origin_len] = '\0';
+    }
+}
+
 static void on_script_message(WebKitUserContentManager* manager, WebKitJavascriptResult* result,
                                gpointer user_data)
 {
@@ -492,61 +1278,104 @@ static void on_script_message(WebKitUserContentManager* manager, WebKitJavascrip
     {
         JSCValue* value = webkit_javascript_result_get_js_value(result);
         char* body = jsc_value_to_string(value);
-        const char* url = webkit_web_view_get_uri(s->web_view);
-
-        /* Extract origin from current URI */
-        char origin[512] = "";
-        if (url)
-        {
-            /* Simple origin extraction: scheme://host[:port] */
-            const char* scheme_end = strstr(url, "://");
-            if (scheme_end)
-            {
-                const char* host_start = scheme_end + 3;
-                const char* path_start = strchr(host_start, '/');
-                size_t origin_len = path_start ? (size_t)(path_start - url) : strlen(url);
-                if (origin_len < sizeof(origin))
-                {
-                    memcpy(origin, url, origin_len);
-                    origin[origin_len] = '\0';
-                }
-            }
-        }
-
+        char origin[512];
+        page_origin(s, origin, sizeof(origin));
         s->callbacks.on_message(s->user_data, body ? body : "", origin);
         g_free(body);
     }
 }
 
-/* ========== Script evaluation callback data ========== */
+/* A page that takes its web process down again before finishing a load is not reloaded
+ * more than this many times in a row. */
+#define AG_GTK_MAX_CONSECUTIVE_CRASH_RECOVERIES 3
+
+static void on_web_process_terminated(WebKitWebView* web_view, WebKitWebProcessTerminationReason reason,
+                                      gpointer user_data)
+{
+    shim_state* s = (shim_state*)user_data;
+    if (atomic_load(&s->detached))
+        return;
+
+    atomic_fetch_add(&s->web_process_terminations, 1);
+
+    /* A hang ends with its process; a process the watchdog killed is always reloaded. */
+    hang_end(s, AG_GTK_HANG_TERMINATED);
+    gboolean hang_recovery = s->hang_terminated;
+    s->hang_terminated = FALSE;
+
+    /* Decisions and scroll restores belong to the process that just went away. */
+    cancel_pending_policies(s);
+    s->restore_scroll_pending = FALSE;
+    end_session_restore(s);
+    s->recovery_started_us = 0;
+    s->nav_timing_active = FALSE;
+
+    const char* uri = webkit_web_view_get_uri(web_view);
+    gboolean recovering = (hang_recovery
+            || (s->opt_crash_recovery && reason != WEBKIT_WEB_PROCESS_TERMINATED_BY_API))
+        && s->consecutive_crashes < AG_GTK_MAX_CONSECUTIVE_CRASH_RECOVERIES
+        && uri != NULL && uri[0] != '\0';
+    s->consecutive_crashes++;
+
+    /* Managed code fails its in-flight operations here, before the reload starts. */
+    if (s->callbacks.on_web_process_terminated)
+        s->callbacks.on_web_process_terminated(s->user_data, (int)reason, recovering);
+
+    if (recovering && !atomic_load(&s->detached) && s->web_view == web_view)
+    {
+        s->recovery_started_us = g_get_monotonic_time();
+        webkit_web_view_reload(web_view);
+    }
+}
+
+/* ========== Script evaluation ========== */
 
+/* One tracked ag_gtk_eval_js request, held in an AG_GTK_OP_SCRIPT slot. The timeout runs from
+ * submission, so it also bounds the time spent waiting for an in-flight slot. */
 typedef struct
 {
+    op_slot* slot;
     shim_state* state;
     uint64_t request_id;
-} eval_js_data;
-
-static void on_eval_js_finish(GObject* source, GAsyncResult* result, gpointer user_data)
+    char* script;              /* owned while queued, NULL once started */
+    GCancellable* cancellable; /* owned once started */
+    guint timeout_id;
+    gint64 submitted_us;
+    gint64 started_us;
+    gboolean buffered;         /* always deliver the result through on_script_buffer */
+    gboolean abandoned;        /* settled early; the finish callback only frees it */
+} eval_op;
+
+G_STATIC_ASSERT(sizeof(eval_op) <= OP_PAYLOAD_SIZE);
+
+static void eval_op_free(eval_op* op)
 {
-    eval_js_data* data = (eval_js_data*)user_data;
-    shim_state* s = data->state;
-    uint64_t req_id = data->request_id;
-    free(data);
+    if (op->timeout_id != 0)
+        g_source_remove(op->timeout_id);
+    g_clear_object(&op->cancellable);
+    g_free(op->script);
+    op_slot_release(op->slot);
+}
 
-    if (atomic_load(&s->detached))
+static void eval_settle(shim_state* s, eval_op* op, int32_t status)
+{
+    if (s->callbacks.on_script_settled == NULL)
         return;
+    gint64 now = g_get_monotonic_time();
+    gint64 queued_us = (op->started_us != 0 ? op->started_us : now) - op->submitted_us;
+    gint64 run_us = op->started_us != 0 ? now - op->started_us : 0;
+    s->callbacks.on_script_settled(s->user_data, op->request_id, status, queued_us, run_us);
+}
 
+static void report_script_result(shim_state* s, uint64_t req_id, gboolean buffered,
+                                 WebKitJavascriptResult* js_result, GError* error)
+{
     if (!s->callbacks.on_script_result)
         return;
 
-    GError* error = NULL;
-    WebKitJavascriptResult* js_result = webkit_web_view_run_javascript_finish(
-        WEBKIT_WEB_VIEW(source), result, &error);
-
     if (error != NULL)
     {
         s->callbacks.on_script_result(s->user_data, req_id, NULL, error->message);
-        g_error_free(error);
         return;
     }
 
@@ -560,52 +1389,464 @@ static void on_eval_js_finish(GObject* source, GAsyncResult* result, gpointer us
     if (jsc_value_is_undefined(value) || jsc_value_is_null(value))
     {
         s->callbacks.on_script_result(s->user_data, req_id, NULL, NULL);
-        webkit_javascript_result_unref(js_result);
+        return;
+    }
+
+    /* Large results skip the NUL-terminated copy and the strlen on the managed side: the
+     * converted bytes are handed over as they are and released by the host. */
+    if (s->callbacks.on_script_buffer != NULL && (buffered || s->eval_buffer_threshold > 0))
+    {
+        GBytes* bytes = jsc_value_to_string_as_bytes(value);
+        gsize size = 0;
+        const uint8_t* data = bytes != NULL ? (const uint8_t*)g_bytes_get_data(bytes, &size) : NULL;
+        if (bytes != NULL && (buffered || (int64_t)size >= s->eval_buffer_threshold))
+        {
+            s->callbacks.on_script_buffer(s->user_data, req_id, bytes, data, (int64_t)size);
+            return;
+        }
+
+        /* Below the threshold the converted buffer itself becomes the string: JSC hands over a
+         * sole reference to a g_malloc'd buffer, so unref_to_data steals it and the realloc for
+         * the terminator stays in place, instead of copying the result a second time. */
+        char* small = NULL;
+        if (bytes != NULL)
+        {
+            small = (char*)g_bytes_unref_to_data(bytes, &size);
+            small = (char*)g_realloc(small, size + 1);
+            small[size] = '\0';
+        }
+        s->callbacks.on_script_result(s->user_data, req_id, small, NULL);
+        g_free(small);
         return;
     }
 
     char* str = jsc_value_to_string(value);
     s->callbacks.on_script_result(s->user_data, req_id, str ? str : NULL, NULL);
     g_free(str);
-    webkit_javascript_result_unref(js_result);
 }
 
-/* ========== Custom scheme handler ========== */
-
-static void on_custom_scheme_request(WebKitURISchemeRequest* request, gpointer user_data)
+static void on_eval_js_finish(GObject* source, GAsyncResult* result, gpointer user_data)
 {
-    shim_state* s = (shim_state*)user_data;
-    if (atomic_load(&s->detached) || s->callbacks.on_scheme_request == NULL)
+    eval_op* op = (eval_op*)user_data;
+    shim_state* s = op->state;
+
+    GError* error = NULL;
+    WebKitJavascriptResult* js_result = webkit_web_view_run_javascript_finish(
+        WEBKIT_WEB_VIEW(source), result, &error);
+
+    /* eval_abort_all already dropped the op from the tables on detach, and an abandoned op
+     * was settled and gave up its in-flight slot when it timed out or was cancelled. */
+    gboolean live = !op->abandoned && !atomic_load(&s->detached);
+    if (live)
     {
-        GError* err = g_error_new_literal(g_quark_from_string("ag-webkit"), 404, "Not handled");
-        webkit_uri_scheme_request_finish_error(request, err);
-        g_error_free(err);
-        return;
+        g_hash_table_remove(s->eval_ops, &op->request_id);
+        s->eval_running--;
+
+        eval_settle(s, op, AG_GTK_SCRIPT_COMPLETED);
+        report_script_result(s, op->request_id, op->buffered, js_result, error);
     }
 
-    const char* uri = webkit_uri_scheme_request_get_uri(request);
-    const char* method = webkit_uri_scheme_request_get_http_method(request);
+    if (js_result != NULL)
+        webkit_javascript_result_unref(js_result);
+    if (error != NULL)
+        g_error_free(error);
+    eval_op_free(op);
 
-    const void* response_data = NULL;
-    int64_t response_length = 0;
-    const char* mime_type = NULL;
-    int status_code = 0;
+    if (live && !atomic_load(&s->detached))
+        eval_start_queued(s);
+}
 
-    bool handled = s->callbacks.on_scheme_request(
-        s->user_data,
-        uri ? uri : "",
-        method ? method : "GET",
-        &response_data, &response_length, &mime_type, &status_code);
+static void eval_start(shim_state* s, eval_op* op)
+{
+    op->started_us = g_get_monotonic_time();
+    op->cancellable = g_cancellable_new();
+    s->eval_running++;
+    webkit_web_view_run_javascript(s->web_view, op->script, op->cancellable, on_eval_js_finish, op);
+    g_free(op->script);
+    op->script = NULL;
+}
 
-    if (!handled || response_data == NULL)
+static void eval_start_queued(shim_state* s)
+{
+    while (s->web_view != NULL && !g_queue_is_empty(s->eval_queue)
+           && (s->eval_max_running <= 0 || s->eval_running < s->eval_max_running))
     {
-        GError* err = g_error_new_literal(g_quark_from_string("ag-webkit"), 404, "Not handled");
-        webkit_uri_scheme_request_finish_error(request, err);
-        g_error_free(err);
-        return;
+        eval_start(s, (eval_op*)g_queue_pop_head(s->eval_queue));
     }
+}
 
-    GInputStream* stream = g_memory_input_stream_new_from_data(
+/* Settles a request that is still queued and frees it. */
+static void eval_drop_queued(shim_state* s, eval_op* op, int32_t status)
+{
+    g_queue_remove(s->eval_queue, op);
+    g_hash_table_remove(s->eval_ops, &op->request_id);
+    eval_settle(s, op, status);
+    eval_op_free(op);
+}
+
+/* Settles a running request now instead of when WebKit completes it: a script that never
+ * returns (or blocks the web process) would otherwise hold its in-flight slot, and every
+ * request queued behind it, until the page goes away. The op stays allocated for the pending
+ * run_javascript call, which only frees it. */
+static void eval_abandon_running(shim_state* s, eval_op* op, int32_t status)
+{
+    if (op->timeout_id != 0)
+    {
+        g_source_remove(op->timeout_id);
+        op->timeout_id = 0;
+    }
+    op->abandoned = TRUE;
+    g_hash_table_remove(s->eval_ops, &op->request_id);
+    s->eval_running--;
+    g_cancellable_cancel(op->cancellable);
+    eval_settle(s, op, status);
+    eval_start_queued(s);
+}
+
+static gboolean on_eval_timeout(gpointer user_data)
+{
+    eval_op* op = (eval_op*)user_data;
+    op->timeout_id = 0;
+    if (op->script != NULL)
+        eval_drop_queued(op->state, op, AG_GTK_SCRIPT_TIMED_OUT);
+    else
+        eval_abandon_running(op->state, op, AG_GTK_SCRIPT_TIMED_OUT);
+    return G_SOURCE_REMOVE;
+}
+
+/* Detach: queued requests are freed, running ones cancelled (they free themselves when
+ * WebKit completes them). No callbacks fire; the managed side fails its own waiters. */
+static void eval_abort_all(shim_state* s)
+{
+    eval_op* op;
+    while ((op = (eval_op*)g_queue_pop_head(s->eval_queue)) != NULL)
+    {
+        g_hash_table_remove(s->eval_ops, &op->request_id);
+        eval_op_free(op);
+    }
+
+    GHashTableIter iter;
+    gpointer value;
+    g_hash_table_iter_init(&iter, s->eval_ops);
+    while (g_hash_table_iter_next(&iter, NULL, &value))
+    {
+        op = (eval_op*)value;
+        if (op->timeout_id != 0)
+        {
+            g_source_remove(op->timeout_id);
+            op->timeout_id = 0;
+        }
+        g_cancellable_cancel(op->cancellable);
+    }
+    g_hash_table_remove_all(s->eval_ops);
+    s->eval_running = 0;
+}
+
+/* Reads up to count comma-separated numbers from an internal script's result (JS always
+ * formats them with a '.' decimal point) and returns how many were read. g_ascii_strtod
+ * ignores the process locale, which sscanf("%lf") would honour. */
+static int parse_script_numbers(const char* text, double* values, int count)
+{
+    int n = 0;
+    const char* p = text;
+    while (n < count && p != NULL && *p != '\0')
+    {
+        char* end = NULL;
+        double v = g_ascii_strtod(p, &end);
+        if (end == p)
+            break;
+        values[n++] = v;
+        if (*end != ',')
+            break;
+        p = end + 1;
+    }
+    return n;
+}
+
+/* ========== Custom scheme request bodies ========== */
+
+/* A body is read with blocking GIO reads from whichever managed thread consumes it (never the
+ * GTK thread for large uploads), so a 1 GB upload streams through a fixed buffer instead of
+ * being marshalled whole. It is shared by the pending request's slot and managed code; detach
+ * cancels it, which fails a read in progress, and the last close frees it. */
+
+#define AG_GTK_SCHEME_NOT_HANDLED 0
+#define AG_GTK_SCHEME_RESPONDED   1
+#define AG_GTK_SCHEME_DEFERRED    2
+
+struct ag_gtk_scheme_body
+{
+    atomic_int refs;
+    GInputStream* stream;
+    GCancellable* cancellable;
+};
+
+typedef struct
+{
+    WebKitURISchemeRequest* request; /* owned ref */
+    ag_gtk_scheme_body* body;        /* the slot's reference */
+} scheme_op;
+
+G_STATIC_ASSERT(sizeof(scheme_op) <= OP_PAYLOAD_SIZE);
+
+static GInputStream* scheme_request_body(WebKitURISchemeRequest* request)
+{
+#if WEBKIT_CHECK_VERSION(2, 40, 0)
+    return webkit_uri_scheme_request_get_http_body(request);
+#else
+    (void)request;
+    return NULL;
+#endif
+}
+
+static void append_request_header(const char* name, const char* value, gpointer user_data)
+{
+    g_string_append_printf((GString*)user_data, "%s: %s\n", name, value);
+}
+
+static char* format_request_headers(SoupMessageHeaders* headers)
+{
+    if (headers == NULL)
+        return NULL;
+    GString* text = g_string_new(NULL);
+    soup_message_headers_foreach(headers, append_request_header, text);
+    return g_string_free(text, FALSE);
+}
+
+static ag_gtk_scheme_body* scheme_body_new(GInputStream* stream)
+{
+    ag_gtk_scheme_body* body = g_new0(ag_gtk_scheme_body, 1);
+    atomic_init(&body->refs, 1);
+    body->stream = g_object_ref(stream);
+    body->cancellable = g_cancellable_new();
+    return body;
+}
+
+static void scheme_body_ref(ag_gtk_scheme_body* body)
+{
+    atomic_fetch_add(&body->refs, 1);
+}
+
+static void scheme_body_unref(ag_gtk_scheme_body* body)
+{
+    if (atomic_fetch_sub(&body->refs, 1) != 1)
+        return;
+    g_object_unref(body->stream);
+    g_object_unref(body->cancellable);
+    g_free(body);
+}
+
+static void scheme_op_release(op_slot* slot)
+{
+    scheme_op* op = OP_PAYLOAD(slot, scheme_op);
+    g_object_unref(op->request);
+    scheme_body_unref(op->body);
+    op_slot_release(slot);
+}
+
+/* Detach: the page sees a network error and managed readers see the body end in an error. */
+static void abort_scheme_request(op_slot* slot)
+{
+    scheme_op* op = OP_PAYLOAD(slot, scheme_op);
+    g_cancellable_cancel(op->body->cancellable);
+    GError* err = g_error_new_literal(g_quark_from_string("ag-webkit"), 499, "The view was detached");
+    webkit_uri_scheme_request_finish_error(op->request, err);
+    g_error_free(err);
+    scheme_op_release(slot);
+}
+
+/* Reads up to `size` bytes; returns the count, 0 at the end of the body and -1 on error or
+ * after detach. Blocks; call from a worker thread, one reader at a time. */
+int64_t ag_gtk_scheme_body_read(ag_gtk_scheme_body* body, void* buffer, int32_t size)
+{
+    if (body == NULL || buffer == NULL || size < 0) return -1;
+    gssize n = g_input_stream_read(body->stream, buffer, (gsize)size, body->cancellable, NULL);
+    return n < 0 ? -1 : (int64_t)n;
+}
+
+/* Drops the reference managed code took by deferring the request. */
+void ag_gtk_scheme_body_close(ag_gtk_scheme_body* body)
+{
+    if (body != NULL)
+        scheme_body_unref(body);
+}
+
+typedef struct
+{
+    shim_state* state;
+    uint64_t request_id;
+    const void* data;
+    int64_t length;
+    const char* mime_type;
+    const char* allow_origin;
+    int32_t status;
+    const char* message;
+    gboolean result;
+} scheme_respond_data;
+
+static void do_scheme_request_respond(void* data)
+{
+    scheme_respond_data* d = (scheme_respond_data*)data;
+    op_slot* slot = op_table_claim(d->state->ops, d->request_id, AG_GTK_OP_SCHEME);
+    if (slot == NULL) return;
+
+    scheme_op* op = OP_PAYLOAD(slot, scheme_op);
+    GInputStream* stream = g_memory_input_stream_new_from_data(
+        d->length > 0 ? g_memdup2(d->data, (gsize)d->length) : NULL, (gssize)d->length, g_free);
+    WebKitURISchemeResponse* response = webkit_uri_scheme_response_new(stream, d->length);
+    if (d->status > 0 && d->status != 200)
+        webkit_uri_scheme_response_set_status(response, (guint)d->status, soup_status_get_phrase((guint)d->status));
+    webkit_uri_scheme_response_set_content_type(response,
+        d->mime_type != NULL && *d->mime_type ? d->mime_type : "application/octet-stream");
+    if (d->allow_origin != NULL && *d->allow_origin)
+    {
+        SoupMessageHeaders* headers = soup_message_headers_new(SOUP_MESSAGE_HEADERS_RESPONSE);
+        soup_message_headers_append(headers, "Access-Control-Allow-Origin", d->allow_origin);
+        soup_message_headers_append(headers, "Vary", "Origin");
+        soup_message_headers_append(headers, "Cache-Control", "no-store");
+        webkit_uri_scheme_response_set_http_headers(response, headers); /* takes ownership */
+    }
+    webkit_uri_scheme_request_finish_with_response(op->request, response);
+    g_object_unref(response);
+    g_object_unref(stream);
+
+    scheme_op_release(slot);
+    d->result = TRUE;
+}
+
+static void do_scheme_request_fail(void* data)
+{
+    scheme_respond_data* d = (scheme_respond_data*)data;
+    op_slot* slot = op_table_claim(d->state->ops, d->request_id, AG_GTK_OP_SCHEME);
+    if (slot == NULL) return;
+
+    GError* err = g_error_new_literal(g_quark_from_string("ag-webkit"), d->status,
+        d->message != NULL ? d->message : "Request failed");
+    webkit_uri_scheme_request_finish_error(OP_PAYLOAD(slot, scheme_op)->request, err);
+    g_error_free(err);
+
+    scheme_op_release(slot);
+    d->result = TRUE;
+}
+
+/* Answers a deferred request. The data is copied. allow_origin_utf8 (NULL or empty = none) is
+ * sent as Access-Control-Allow-Origin: the caller names the one origin it accepted, the shim
+ * never derives it from the request. False when the request is unknown, already answered or
+ * its view detached. */
+bool ag_gtk_scheme_request_respond(ag_gtk_handle handle, uint64_t request_id, const void* data, int64_t length,
+                                   const char* mime_type_utf8, int32_t status_code, const char* allow_origin_utf8)
+{
+    if (!handle || length < 0 || (data == NULL && length > 0)) return false;
+    scheme_respond_data d = { (shim_state*)handle, request_id, data, length, mime_type_utf8, allow_origin_utf8,
+                              status_code, NULL, FALSE };
+    run_on_gtk_thread(do_scheme_request_respond, &d);
+    return d.result;
+}
+
+/* Fails a deferred request with a network error. */
+bool ag_gtk_scheme_request_fail(ag_gtk_handle handle, uint64_t request_id, int32_t status_code, const char* message_utf8)
+{
+    if (!handle) return false;
+    scheme_respond_data d = { (shim_state*)handle, request_id, NULL, 0, NULL, NULL, status_code, message_utf8, FALSE };
+    run_on_gtk_thread(do_scheme_request_fail, &d);
+    return d.result;
+}
+
+/* ========== Custom scheme handler ========== */
+
+/* Schemes are registered on the web context, which views with the same data directories (or
+ * the default context) share, and a later registration replaces the earlier handler. Requests
+ * are therefore routed by the requesting view rather than by registration user_data, which
+ * would point at whichever view attached last, even after it was destroyed. */
+static shim_state* scheme_request_owner(WebKitURISchemeRequest* request)
+{
+    WebKitWebView* view = webkit_uri_scheme_request_get_web_view(request);
+    return view != NULL ? (shim_state*)g_object_get_data(G_OBJECT(view), AG_SHIM_STATE_KEY) : NULL;
+}
+
+static void on_custom_scheme_request(WebKitURISchemeRequest* request, gpointer user_data)
+{
+    (void)user_data;
+    shim_state* s = scheme_request_owner(request);
+
+    /* The hidden preload view only fetches http(s); app content and the bridge stay with the
+     * visible view. */
+    if (s != NULL && webkit_uri_scheme_request_get_web_view(request) == s->preload_view)
+        s = NULL;
+
+    if (s != NULL && !atomic_load(&s->detached)
+        && serve_published_blob(s, request, webkit_uri_scheme_request_get_uri(request)))
+        return;
+
+    if (s == NULL || atomic_load(&s->detached) || s->callbacks.on_scheme_request == NULL)
+    {
+        GError* err = g_error_new_literal(g_quark_from_string("ag-webkit"), 404, "Not handled");
+        webkit_uri_scheme_request_finish_error(request, err);
+        g_error_free(err);
+        return;
+    }
+
+    const char* uri = webkit_uri_scheme_request_get_uri(request);
+    const char* method = webkit_uri_scheme_request_get_http_method(request);
+    SoupMessageHeaders* request_headers = webkit_uri_scheme_request_get_http_headers(request);
+    char* headers = format_request_headers(request_headers);
+
+    /* Requests with a body get an operation slot so managed code can read the body off the
+     * GTK thread and answer later. */
+    op_slot* slot = NULL;
+    ag_gtk_scheme_body* body = NULL;
+    GInputStream* body_stream = scheme_request_body(request);
+    if (body_stream != NULL)
+    {
+        slot = op_slot_acquire(s->ops, AG_GTK_OP_SCHEME, abort_scheme_request);
+        if (slot != NULL)
+        {
+            body = scheme_body_new(body_stream);
+            scheme_op* op = OP_PAYLOAD(slot, scheme_op);
+            op->request = g_object_ref(request);
+            op->body = body;
+        }
+        g_object_unref(body_stream);
+    }
+
+    const void* response_data = NULL;
+    int64_t response_length = 0;
+    const char* mime_type = NULL;
+    int status_code = 0;
+
+    gint64 handler_start = g_get_monotonic_time();
+    int32_t disposition = s->callbacks.on_scheme_request(
+        s->user_data,
+        uri ? uri : "",
+        method ? method : "GET",
+        headers,
+        slot != NULL ? slot->id : 0,
+        body,
+        request_headers != NULL ? soup_message_headers_get_content_length(request_headers) : -1,
+        &response_data, &response_length, &mime_type, &status_code);
+    if (s->resource_timing_enabled && uri != NULL)
+        note_scheme_handler_time(s, uri, g_get_monotonic_time() - handler_start);
+    g_free(headers);
+
+    if (slot != NULL)
+    {
+        if (disposition == AG_GTK_SCHEME_DEFERRED)
+        {
+            scheme_body_ref(body); /* managed code's reference */
+            return;
+        }
+        scheme_op_release(slot);
+    }
+
+    if (disposition != AG_GTK_SCHEME_RESPONDED || response_data == NULL)
+    {
+        GError* err = g_error_new_literal(g_quark_from_string("ag-webkit"), 404, "Not handled");
+        webkit_uri_scheme_request_finish_error(request, err);
+        g_error_free(err);
+        return;
+    }
+
+    GInputStream* stream = g_memory_input_stream_new_from_data(
         g_memdup2(response_data, (gsize)response_length),
         (gssize)response_length,
         g_free);
@@ -616,1151 +1857,5320 @@ static void on_custom_scheme_request(WebKitURISchemeRequest* request, gpointer u
     g_object_unref(stream);
 }
 
-/* ========== Download signal handler ========== */
+/* ========== Fetch bridge ========== */
 
-static void on_download_started(WebKitWebContext* context, WebKitDownload* download, gpointer user_data)
+/* Bridge RPC requests can arrive as page fetch POSTs to scheme://host/<service>/<method>; they
+ * take the deferred request path above, so managed code reads the body and dispatches off the
+ * GTK thread and the response body carries the result. Request bodies need WebKitGTK 2.40.
+ *
+ * The scheme is registered CORS-enabled and secure so pages on other origins (https included)
+ * can call it. WebKit keeps those flags on the web context and has no way to drop them, so
+ * they are set once per context, stay for its lifetime and also apply to views sharing it that
+ * never enabled the bridge; such views still route the requests to their own handler, which
+ * refuses them. Responses carry Access-Control-Allow-Origin only for the origin managed code
+ * passes with the reply, i.e. one the bridge's origin policy admitted; refused calls fail
+ * without CORS headers, so the calling page cannot read anything. */
+
+#define AG_FETCH_BRIDGE_SCHEME_KEY "ag-fetch-bridge-scheme"
+
+typedef struct
 {
-    shim_state* s = (shim_state*)user_data;
-    if (atomic_load(&s->detached)) return;
-    if (s->callbacks.on_download == NULL) return;
+    shim_state* state;
+    const char* scheme;
+    const char* host;
+} fetch_bridge_data;
+
+static gboolean has_custom_scheme(shim_state* s, const char* scheme)
+{
+    for (int i = 0; i < s->custom_scheme_count; i++)
+    {
+        if (g_ascii_strcasecmp(s->custom_schemes[i], scheme) == 0)
+            return TRUE;
+    }
+    return FALSE;
+}
+
+static void fetch_bridge_register(shim_state* s)
+{
+    if (s->fetch_bridge_scheme == NULL || s->web_view == NULL)
+        return;
+
+    WebKitWebContext* web_context = webkit_web_view_get_context(s->web_view);
+    char* key = g_strconcat(AG_FETCH_BRIDGE_SCHEME_KEY ":", s->fetch_bridge_scheme, NULL);
+    if (g_object_get_data(G_OBJECT(web_context), key) == NULL)
+    {
+        WebKitSecurityManager* security = webkit_web_context_get_security_manager(web_context);
+        webkit_security_manager_register_uri_scheme_as_secure(security, s->fetch_bridge_scheme);
+        webkit_security_manager_register_uri_scheme_as_cors_enabled(security, s->fetch_bridge_scheme);
+        g_object_set_data(G_OBJECT(web_context), key, GINT_TO_POINTER(1));
+    }
+    g_free(key);
+    if (!has_custom_scheme(s, s->fetch_bridge_scheme))
+        webkit_web_context_register_uri_scheme(web_context, s->fetch_bridge_scheme,
+            on_custom_scheme_request, NULL, NULL);
+}
+
+static void do_set_fetch_bridge(void* data)
+{
+    fetch_bridge_data* d = (fetch_bridge_data*)data;
+    shim_state* s = d->state;
+
+    g_clear_pointer(&s->fetch_bridge_scheme, g_free);
+    if (d->scheme == NULL || d->host == NULL)
+        return;
+
+    s->fetch_bridge_scheme = g_ascii_strdown(d->scheme, -1);
+    fetch_bridge_register(s); /* otherwise at attach */
+}
+
+/* Serves bridge fetches under scheme://host/ (NULL scheme or host turns it off). Routing stays
+ * with on_scheme_request and the CORS header comes with each reply; this only adds the
+ * registration. False when this WebKit cannot hand request bodies to the shim. */
+bool ag_gtk_set_fetch_bridge(ag_gtk_handle handle, const char* scheme_utf8, const char* host_utf8)
+{
+    if (!handle) return false;
+#if WEBKIT_CHECK_VERSION(2, 40, 0)
+    fetch_bridge_data d = { (shim_state*)handle, scheme_utf8, host_utf8 };
+    run_on_gtk_thread(do_set_fetch_bridge, &d);
+    return true;
+#else
+    return scheme_utf8 == NULL || host_utf8 == NULL;
+#endif
+}
+
+/* ========== Downloads ========== */
+
+/* Downloads started from this view hold an AG_GTK_OP_DOWNLOAD slot from download-started until
+ * WebKit reports them finished; the slot id is the download id managed code sees. The data goes
+ * straight from the network process to the destination file. */
+
+#define AG_GTK_DOWNLOAD_DEFAULT  0 /* WebKit's default destination handling */
+#define AG_GTK_DOWNLOAD_ACCEPTED 1
+#define AG_GTK_DOWNLOAD_CANCEL   2
+#define AG_GTK_DOWNLOAD_DEFERRED 3
+
+#define AG_GTK_DOWNLOAD_COMPLETED 0
+#define AG_GTK_DOWNLOAD_FAILED    1
+#define AG_GTK_DOWNLOAD_CANCELLED 2
+
+#define DOWNLOAD_PROGRESS_INTERVAL_US_DEFAULT 250000
+
+typedef struct
+{
+    shim_state* state;
+    WebKitDownload* download; /* owned ref */
+    guint64 received;
+    gint64 last_progress_us;
+    int32_t status;
+    char* error;              /* owned, from "failed" */
+} download_op;
+
+G_STATIC_ASSERT(sizeof(download_op) <= OP_PAYLOAD_SIZE);
+
+static int64_t download_total(WebKitDownload* download)
+{
+    WebKitURIResponse* response = webkit_download_get_response(download);
+    guint64 length = response != NULL ? webkit_uri_response_get_content_length(response) : 0;
+    return length > 0 ? (int64_t)length : -1;
+}
+
+static void download_report_progress(op_slot* slot)
+{
+    download_op* op = OP_PAYLOAD(slot, download_op);
+    shim_state* s = op->state;
+    gint64 now = g_get_monotonic_time();
+    op->last_progress_us = now;
+    if (s->callbacks.on_download_progress == NULL)
+        return;
+    double elapsed = (double)(now - slot->started_us) / G_USEC_PER_SEC;
+    s->callbacks.on_download_progress(s->user_data, slot->id, (int64_t)op->received,
+        download_total(op->download), elapsed > 0 ? (double)op->received / elapsed : 0);
+}
+
+static void download_op_release(op_slot* slot)
+{
+    download_op* op = OP_PAYLOAD(slot, download_op);
+    g_signal_handlers_disconnect_by_data(op->download, slot);
+    g_object_unref(op->download);
+    g_free(op->error);
+    op_slot_release(slot);
+}
+
+/* Detach: the view's downloads are cancelled without further callbacks. */
+static void abort_download(op_slot* slot)
+{
+    download_op* op = OP_PAYLOAD(slot, download_op);
+    g_signal_handlers_disconnect_by_data(op->download, slot);
+    webkit_download_cancel(op->download);
+    download_op_release(slot);
+}
+
+static gboolean on_download_decide_destination(WebKitDownload* download, const char* suggested, gpointer user_data)
+{
+    op_slot* slot = (op_slot*)user_data;
+    download_op* op = OP_PAYLOAD(slot, download_op);
+    shim_state* s = op->state;
 
     WebKitURIRequest* request = webkit_download_get_request(download);
     const char* url = request ? webkit_uri_request_get_uri(request) : "";
-
     WebKitURIResponse* response = webkit_download_get_response(download);
     const char* mime = response ? webkit_uri_response_get_mime_type(response) : "";
-    int64_t length = response ? (int64_t)webkit_uri_response_get_content_length(response) : -1;
 
-    const char* suggested = webkit_download_get_suggested_filename(download);
-    if (suggested == NULL) suggested = "";
+    int32_t decision = s->callbacks.on_download(s->user_data, slot->id, url ? url : "",
+        suggested ? suggested : "", mime ? mime : "", download_total(download));
 
-    s->callbacks.on_download(s->user_data, url, suggested, mime ? mime : "", length > 0 ? length : -1);
+    switch (decision)
+    {
+        case AG_GTK_DOWNLOAD_ACCEPTED:
+        case AG_GTK_DOWNLOAD_DEFERRED:
+            return TRUE;
+        case AG_GTK_DOWNLOAD_CANCEL:
+            webkit_download_cancel(download);
+            return TRUE;
+        default:
+            return FALSE;
+    }
 }
 
-/* ========== Permission signal handler ========== */
+static void on_download_received_data(WebKitDownload* download, guint64 length, gpointer user_data)
+{
+    (void)download;
+    op_slot* slot = (op_slot*)user_data;
+    download_op* op = OP_PAYLOAD(slot, download_op);
+    op->received += length;
+    if (g_get_monotonic_time() - op->last_progress_us >= op->state->download_progress_interval_us)
+        download_report_progress(slot);
+}
 
-static gboolean on_permission_request(WebKitWebView* web_view, WebKitPermissionRequest* request, gpointer user_data)
+static void on_download_failed(WebKitDownload* download, GError* error, gpointer user_data)
 {
-    shim_state* s = (shim_state*)user_data;
-    if (atomic_load(&s->detached)) return FALSE;
-    if (s->callbacks.on_permission == NULL) return FALSE;
+    (void)download;
+    download_op* op = OP_PAYLOAD((op_slot*)user_data, download_op);
+    op->status = g_error_matches(error, WEBKIT_DOWNLOAD_ERROR, WEBKIT_DOWNLOAD_ERROR_CANCELLED_BY_USER)
+        ? AG_GTK_DOWNLOAD_CANCELLED
+        : AG_GTK_DOWNLOAD_FAILED;
+    g_free(op->error);
+    op->error = g_strdup(error != NULL ? error->message : "Download failed");
+}
 
-    int kind = 0; /* Unknown */
-    if (WEBKIT_IS_MEDIA_KEY_SYSTEM_PERMISSION_REQUEST(request))
+/* Always emitted last, after "failed" when the download did not complete. */
+static void on_download_finished(WebKitDownload* download, gpointer user_data)
+{
+    op_slot* slot = (op_slot*)user_data;
+    download_op* op = OP_PAYLOAD(slot, download_op);
+    shim_state* s = op->state;
+
+    if (op->status == AG_GTK_DOWNLOAD_COMPLETED)
+        download_report_progress(slot);
+
+    if (s->callbacks.on_download_finished != NULL)
     {
-        kind = 0;
+        char* path = NULL;
+        const char* destination = webkit_download_get_destination(download);
+        if (op->status == AG_GTK_DOWNLOAD_COMPLETED && destination != NULL)
+            path = g_filename_from_uri(destination, NULL, NULL);
+        s->callbacks.on_download_finished(s->user_data, slot->id, op->status,
+            path != NULL ? path : destination, (int64_t)op->received, op->error);
+        g_free(path);
     }
-    else
-    {
-        /* Attempt to identify by type name since WebKitGTK doesn't
-           always expose all request types in older versions. */
-        const gchar* type_name = G_OBJECT_TYPE_NAME(request);
-        if (type_name != NULL)
-        {
-            if (g_str_has_prefix(type_name, "WebKitGeolocation"))
-                kind = 3; /* Geolocation */
-            else if (g_str_has_prefix(type_name, "WebKitNotification"))
-                kind = 6; /* Notifications */
-            else if (g_str_has_prefix(type_name, "WebKitUserMedia"))
-                kind = 1; /* Camera (media capture) */
+
+    download_op_release(slot);
+}
+
+static void on_download_started(WebKitWebContext* context, WebKitDownload* download, gpointer user_data)
+{
+    (void)context;
+    shim_state* s = (shim_state*)user_data;
+    if (atomic_load(&s->detached)) return;
+    if (s->callbacks.on_download == NULL) return;
+
+    /* The context may be shared with other views; each only handles its own downloads. */
+    if (s->web_view == NULL || webkit_download_get_web_view(download) != s->web_view)
+        return;
+
+    op_slot* slot = op_slot_acquire(s->ops, AG_GTK_OP_DOWNLOAD, abort_download);
+    if (slot == NULL)
+        return;
+
+    download_op* op = OP_PAYLOAD(slot, download_op);
+    op->state = s;
+    op->download = g_object_ref(download);
+    op->last_progress_us = slot->started_us;
+    op->status = AG_GTK_DOWNLOAD_COMPLETED;
+
+    g_signal_connect(download, "decide-destination", G_CALLBACK(on_download_decide_destination), slot);
+    g_signal_connect(download, "received-data", G_CALLBACK(on_download_received_data), slot);
+    g_signal_connect(download, "failed", G_CALLBACK(on_download_failed), slot);
+    g_signal_connect(download, "finished", G_CALLBACK(on_download_finished), slot);
+}
+
+typedef struct
+{
+    shim_state* state;
+    uint64_t download_id;
+    const char* path;
+    gboolean result;
+} download_command_data;
+
+static void do_download_set_destination(void* data)
+{
+    download_command_data* d = (download_command_data*)data;
+    op_slot* slot = op_table_find(d->state->ops, d->download_id, AG_GTK_OP_DOWNLOAD);
+    if (slot == NULL) return;
+
+    /* webkit2gtk-4.1 takes a file URI. */
+    char* uri = g_filename_to_uri(d->path, NULL, NULL);
+    if (uri == NULL) return;
+    download_op* op = OP_PAYLOAD(slot, download_op);
+    webkit_download_set_allow_overwrite(op->download, TRUE);
+    webkit_download_set_destination(op->download, uri);
+    g_free(uri);
+    d->result = TRUE;
+}
+
+static void do_download_cancel(void* data)
+{
+    download_command_data* d = (download_command_data*)data;
+    op_slot* slot = op_table_find(d->state->ops, d->download_id, AG_GTK_OP_DOWNLOAD);
+    if (slot == NULL) return;
+    /* "failed" and "finished" follow and release the slot. */
+    webkit_download_cancel(OP_PAYLOAD(slot, download_op)->download);
+    d->result = TRUE;
+}
+
+/* Sets the absolute destination path of a download, from the on_download callback (ACCEPTED) or
+ * later (DEFERRED). An existing file is replaced. */
+bool ag_gtk_download_set_destination(ag_gtk_handle handle, uint64_t download_id, const char* path_utf8)
+{
+    if (!handle || !path_utf8 || !g_path_is_absolute(path_utf8)) return false;
+    download_command_data d = { (shim_state*)handle, download_id, path_utf8, FALSE };
+    run_on_gtk_thread(do_download_set_destination, &d);
+    return d.result;
+}
+
+bool ag_gtk_download_cancel(ag_gtk_handle handle, uint64_t download_id)
+{
+    if (!handle) return false;
+    download_command_data d = { (shim_state*)handle, download_id, NULL, FALSE };
+    run_on_gtk_thread(do_download_cancel, &d);
+    return d.result;
+}
+
+/* Minimum time between two on_download_progress calls for the same download; 0 = every chunk. */
+void ag_gtk_set_download_progress_interval(ag_gtk_handle handle, int32_t interval_ms)
+{
+    if (!handle || interval_ms < 0) return;
+    ((shim_state*)handle)->download_progress_interval_us = (gint64)interval_ms * 1000;
+}
+
+/* ========== Permission signal handler ========== */
+
+static gboolean on_permission_request(WebKitWebView* web_view, WebKitPermissionRequest* request, gpointer user_data)
+{
+    shim_state* s = (shim_state*)user_data;
+    if (atomic_load(&s->detached)) return FALSE;
+    if (s->callbacks.on_permission == NULL) return FALSE;
+
+    int kind = 0; /* Unknown */
+    if (WEBKIT_IS_MEDIA_KEY_SYSTEM_PERMISSION_REQUEST(request))
+    {
+        kind = 0;
+    }
+    else
+    {
+        /* Attempt to identify by type name since WebKitGTK doesn't
+           always expose all request types in older versions. */
+        const gchar* type_name = G_OBJECT_TYPE_NAME(request);
+        if (type_name != NULL)
+        {
+            if (g_str_has_prefix(type_name, "WebKitGeolocation"))
+                kind = 3; /* Geolocation */
+            else if (g_str_has_prefix(type_name, "WebKitNotification"))
+                kind = 6; /* Notifications */
+            else if (g_str_has_prefix(type_name, "WebKitUserMedia"))
+                kind = 1; /* Camera (media capture) */
+        }
+    }
+
+    /* Get origin from the main resource URI */
+    const char* uri = webkit_web_view_get_uri(web_view);
+    int state = 0; /* Default */
+    s->callbacks.on_permission(s->user_data, kind, uri ? uri : "", &state);
+
+    if (state == 1) /* Allow */
+    {
+        webkit_permission_request_allow(request);
+        return TRUE;
+    }
+    else if (state == 2) /* Deny */
+    {
+        webkit_permission_request_deny(request);
+        return TRUE;
+    }
+
+    return FALSE; /* Let WebKitGTK handle default behavior */
+}
+
+/* ========== Context menu signal handler ========== */
+
+static gboolean on_context_menu(WebKitWebView* web_view, WebKitContextMenu* context_menu,
+                                GdkEvent* event, WebKitHitTestResult* hit_test_result,
+                                gpointer user_data)
+{
+    shim_state* s = (shim_state*)user_data;
+    if (atomic_load(&s->detached)) return FALSE;
+    if (s->callbacks.on_context_menu == NULL) return FALSE;
+
+    double x = 0, y = 0;
+    if (event != NULL && event->type == GDK_BUTTON_PRESS)
+    {
+        x = ((GdkEventButton*)event)->x;
+        y = ((GdkEventButton*)event)->y;
+    }
+
+    const char* link_uri = NULL;
+    const char* media_uri = NULL;
+    bool is_editable = false;
+    int media_type = 0;
+
+    if (hit_test_result != NULL)
+    {
+        if (webkit_hit_test_result_context_is_link(hit_test_result))
+            link_uri = webkit_hit_test_result_get_link_uri(hit_test_result);
+
+        is_editable = webkit_hit_test_result_context_is_editable(hit_test_result);
+
+        if (webkit_hit_test_result_context_is_image(hit_test_result))
+        {
+            media_type = 1;
+            media_uri = webkit_hit_test_result_get_image_uri(hit_test_result);
+        }
+        else if (webkit_hit_test_result_context_is_media(hit_test_result))
+        {
+            media_type = 2; /* Video — WebKitGTK doesn't distinguish video/audio */
+            media_uri = webkit_hit_test_result_get_media_uri(hit_test_result);
+        }
+    }
+
+    /* Selection text requires evaluating JS; WebKitGTK doesn't expose it via hit-test.
+       Pass NULL and let the managed side handle it if needed. */
+    bool handled = s->callbacks.on_context_menu(
+        s->user_data, x, y, link_uri, NULL, media_type, media_uri, is_editable);
+
+    return handled ? TRUE : FALSE;
+}
+
+/* ========== Drag-drop signal handlers ========== */
+
+static void flush_drag_motion(shim_state* s)
+{
+    if (!s->drag_motion_pending)
+        return;
+    s->drag_motion_pending = FALSE;
+    atomic_fetch_add(&s->drag_motion_delivered, 1);
+    if (s->callbacks.on_drag_updated)
+        s->callbacks.on_drag_updated(s->user_data, s->drag_motion_x, s->drag_motion_y);
+}
+
+static void cancel_drag_motion_flush(shim_state* s)
+{
+    if (s->drag_motion_tick_id != 0)
+    {
+        if (s->web_view != NULL)
+            gtk_widget_remove_tick_callback(GTK_WIDGET(s->web_view), s->drag_motion_tick_id);
+        s->drag_motion_tick_id = 0;
+    }
+    if (s->drag_motion_timeout_id != 0)
+    {
+        g_source_remove(s->drag_motion_timeout_id);
+        s->drag_motion_timeout_id = 0;
+    }
+}
+
+static gboolean on_drag_motion_tick(GtkWidget* widget, GdkFrameClock* frame_clock, gpointer user_data)
+{
+    (void)widget;
+    (void)frame_clock;
+    shim_state* s = (shim_state*)user_data;
+    s->drag_motion_tick_id = 0;
+    if (!atomic_load(&s->detached))
+        flush_drag_motion(s);
+    return G_SOURCE_REMOVE;
+}
+
+static gboolean on_drag_motion_timeout(gpointer user_data)
+{
+    shim_state* s = (shim_state*)user_data;
+    s->drag_motion_timeout_id = 0;
+    if (!atomic_load(&s->detached))
+        flush_drag_motion(s);
+    return G_SOURCE_REMOVE;
+}
+
+static gboolean on_drag_motion(GtkWidget* widget, GdkDragContext* context,
+    gint x, gint y, guint time, gpointer user_data)
+{
+    shim_state* s = (shim_state*)user_data;
+    if (atomic_load(&s->detached)) return FALSE;
+
+    if (!s->drag_inside)
+    {
+        s->drag_inside = TRUE;
+        if (s->callbacks.on_drag_entered)
+        {
+            GdkAtom target = gtk_drag_dest_find_target(widget, context, NULL);
+            if (target != GDK_NONE)
+            {
+                s->drag_enter_requested = TRUE;
+                s->drag_enter_x = (double)x;
+                s->drag_enter_y = (double)y;
+                gtk_drag_get_data(widget, context, target, time);
+            }
+            else
+            {
+                s->callbacks.on_drag_entered(s->user_data, 0, NULL, NULL, NULL, (double)x, (double)y);
+            }
+        }
+    }
+    else if (s->drag_enter_requested)
+    {
+        /* Enter is not reported yet; it carries the latest position instead. */
+        s->drag_enter_x = (double)x;
+        s->drag_enter_y = (double)y;
+    }
+    else if (s->callbacks.on_drag_updated)
+    {
+        /* Keep only the latest position; at most one update per frame (or interval). */
+        if (s->drag_motion_pending)
+            atomic_fetch_add(&s->drag_motion_suppressed, 1);
+        s->drag_motion_pending = TRUE;
+        s->drag_motion_x = (double)x;
+        s->drag_motion_y = (double)y;
+
+        if (s->drag_motion_tick_id == 0 && s->drag_motion_timeout_id == 0)
+        {
+            if (s->opt_drag_motion_interval_ms > 0)
+                s->drag_motion_timeout_id = g_timeout_add((guint)s->opt_drag_motion_interval_ms,
+                    on_drag_motion_timeout, s);
+            else
+                s->drag_motion_tick_id = gtk_widget_add_tick_callback(widget,
+                    on_drag_motion_tick, s, NULL);
+        }
+    }
+
+    gdk_drag_status(context, GDK_ACTION_COPY, time);
+    return TRUE;
+}
+
+static void on_drag_leave(GtkWidget* widget, GdkDragContext* context,
+    guint time, gpointer user_data)
+{
+    (void)widget;
+    (void)context;
+    (void)time;
+    shim_state* s = (shim_state*)user_data;
+    if (atomic_load(&s->detached)) return;
+
+    cancel_drag_motion_flush(s);
+    flush_drag_motion(s);
+
+    s->drag_inside = FALSE;
+    /* A drag that left before its data arrived was never reported as entered. */
+    if (s->callbacks.on_drag_exited && !s->drag_enter_requested)
+        s->callbacks.on_drag_exited(s->user_data);
+}
+
+static int hex_digit_value(char c)
+{
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+/* Decode a file:// URI into `out` (at least strlen(uri) + 1 bytes). Returns FALSE when the
+ * URI is not a local file, names a remote host, or decodes to an embedded NUL. */
+static gboolean decode_file_uri_into(const char* uri, char* out)
+{
+    if (g_ascii_strncasecmp(uri, "file://", 7) != 0)
+        return FALSE;
+
+    const char* p = uri + 7;
+    const char* path = strchr(p, '/');
+    if (path == NULL)
+        return FALSE;
+    if (path != p && !(path - p == 9 && g_ascii_strncasecmp(p, "localhost", 9) == 0))
+        return FALSE;
+
+    char* o = out;
+    for (p = path; *p != '\0' && *p != '?' && *p != '#'; p++)
+    {
+        if (*p == '%')
+        {
+            int hi = hex_digit_value(p[1]);
+            int lo = hi >= 0 ? hex_digit_value(p[2]) : -1;
+            if (lo < 0 || (hi == 0 && lo == 0))
+                return FALSE;
+            *o++ = (char)((hi << 4) | lo);
+            p += 2;
+        }
+        else
+        {
+            *o++ = *p;
+        }
+    }
+    *o = '\0';
+    return TRUE;
+}
+
+/* Decodes the local paths of a URI list into one allocation: the path pointer table followed
+ * by the paths (NULL for URIs that are not local files). A decoded path is never longer than
+ * its URI, so the URI lengths bound it. Free with g_free. */
+static const char** decode_drop_paths(gchar** uris, int32_t* out_count)
+{
+    gsize bytes = 0;
+    int32_t count = 0;
+    while (uris[count])
+    {
+        bytes += strlen(uris[count]) + 1;
+        count++;
+    }
+
+    char* arena = (char*)g_malloc(sizeof(char*) * (gsize)(count + 1) + bytes);
+    const char** paths = (const char**)arena;
+    char* cursor = arena + sizeof(char*) * (gsize)(count + 1);
+    for (int32_t i = 0; i < count; i++)
+    {
+        if (decode_file_uri_into(uris[i], cursor))
+        {
+            paths[i] = cursor;
+            cursor += strlen(cursor) + 1;
+        }
+        else
+        {
+            paths[i] = NULL;
+        }
+    }
+    paths[count] = NULL;
+    *out_count = count;
+    return paths;
+}
+
+static void on_drag_data_received(GtkWidget* widget, GdkDragContext* context,
+    gint x, gint y, GtkSelectionData* data, guint info, guint time, gpointer user_data)
+{
+    (void)widget;
+    shim_state* s = (shim_state*)user_data;
+
+    /* The first reply answers the drag-enter request; the drop's own request comes later. */
+    gboolean entering = s->drag_enter_requested;
+    s->drag_enter_requested = FALSE;
+
+    if (atomic_load(&s->detached))
+    {
+        if (!entering)
+            gtk_drag_finish(context, FALSE, FALSE, time);
+        return;
+    }
+    if (entering && !s->drag_inside)
+        return;
+
+    if (!entering)
+    {
+        cancel_drag_motion_flush(s);
+        flush_drag_motion(s);
+        s->drag_inside = FALSE;
+    }
+
+    gchar* text = NULL;
+    gchar** uris = NULL;
+    int32_t count = 0;
+    const char** paths = NULL;
+
+    if (info == 0) /* text/uri-list */
+    {
+        uris = gtk_selection_data_get_uris(data);
+        if (uris)
+            paths = decode_drop_paths(uris, &count);
+    }
+    else /* text/plain or UTF8_STRING */
+    {
+        text = (gchar*)gtk_selection_data_get_text(data);
+    }
+
+    if (entering)
+    {
+        if (s->callbacks.on_drag_entered)
+            s->callbacks.on_drag_entered(s->user_data, count, paths, (const char* const*)uris,
+                text, s->drag_enter_x, s->drag_enter_y);
+    }
+    else if (s->callbacks.on_drop_performed)
+    {
+        s->callbacks.on_drop_performed(s->user_data, count, paths, (const char* const*)uris,
+            text, (double)x, (double)y);
+    }
+
+    g_free((gpointer)paths);
+    g_strfreev(uris);
+    g_free(text);
+    if (!entering)
+        gtk_drag_finish(context, TRUE, FALSE, time);
+}
+
+/* ========== Drop file metadata ========== */
+
+/* Deferred per-file metadata for drop payloads: MIME sniffing and size via GIO. Thread-safe;
+ * the adapter calls it from worker threads on demand, never on the GTK thread.
+ * *out_mime_utf8 is g_malloc'd (free with ag_gtk_free); *out_size is -1 when unknown. */
+bool ag_gtk_query_file_info(const char* path_utf8, char** out_mime_utf8, int64_t* out_size)
+{
+    if (out_mime_utf8) *out_mime_utf8 = NULL;
+    if (out_size) *out_size = -1;
+    if (!path_utf8) return false;
+
+    GFile* file = g_file_new_for_path(path_utf8);
+    GFileInfo* info = g_file_query_info(file,
+        G_FILE_ATTRIBUTE_STANDARD_CONTENT_TYPE "," G_FILE_ATTRIBUTE_STANDARD_SIZE,
+        G_FILE_QUERY_INFO_NONE, NULL, NULL);
+    g_object_unref(file);
+    if (info == NULL)
+        return false;
+
+    if (out_size)
+        *out_size = (int64_t)g_file_info_get_size(info);
+
+    const char* content_type = g_file_info_get_content_type(info);
+    if (out_mime_utf8 && content_type != NULL)
+        *out_mime_utf8 = g_content_type_get_mime_type(content_type);
+
+    g_object_unref(info);
+    return true;
+}
+
+void ag_gtk_free(void* ptr)
+{
+    g_free(ptr);
+}
+
+/* ========== Attach helper ========== */
+
+/* Creates s->web_view with the stored options and per-view signal handlers. Used by attach
+ * and by resume from hibernation; context-level registration is done once in do_attach. */
+static void create_web_view(shim_state* s)
+{
+    /* The context is chosen once and kept, so a view rebuilt after hibernation keeps its
+     * (possibly ephemeral) session and the custom schemes registered on it. */
+    if (s->web_context == NULL)
+    {
+        if (s->opt_ephemeral)
+            s->web_context = webkit_web_context_new_ephemeral();
+        else if (s->opt_data_dir != NULL || s->opt_cache_dir != NULL)
+            /* Views sharing the same directories share one context (and network process). */
+            s->web_context = g_object_ref(get_data_dir_context(s->opt_data_dir, s->opt_cache_dir));
+        else
+            s->web_context = g_object_ref(webkit_web_context_get_default());
+    }
+
+    s->web_view = WEBKIT_WEB_VIEW(g_object_new(WEBKIT_TYPE_WEB_VIEW,
+        "web-context", s->web_context,
+        "user-content-manager", s->content_manager,
+        NULL));
+    g_object_set_data(G_OBJECT(s->web_view), AG_SHIM_STATE_KEY, s);
+
+    s->data_manager = webkit_web_context_get_website_data_manager(webkit_web_view_get_context(s->web_view));
+    if (s->opt_cache_model >= 0)
+        webkit_web_context_set_cache_model(webkit_web_view_get_context(s->web_view), (WebKitCacheModel)s->opt_cache_model);
+
+    /* Apply DevTools setting */
+    WebKitSettings* settings = webkit_web_view_get_settings(s->web_view);
+    webkit_settings_set_enable_developer_extras(settings, s->opt_enable_dev_tools);
+
+    /* Apply custom user agent */
+    if (s->opt_user_agent != NULL)
+    {
+        webkit_settings_set_user_agent(settings, s->opt_user_agent);
+    }
+
+    /* Enable JavaScript */
+    webkit_settings_set_enable_javascript(settings, TRUE);
+
+    apply_performance_profile(s, settings);
+
+    /* Accelerated compositing renders outside the offscreen window's surface. */
+    if (s->opt_offscreen)
+        webkit_settings_set_hardware_acceleration_policy(settings, WEBKIT_HARDWARE_ACCELERATION_POLICY_NEVER);
+
+    /* Connect signals */
+    g_signal_connect(s->web_view, "decide-policy", G_CALLBACK(on_decide_policy), s);
+    g_signal_connect(s->web_view, "load-changed", G_CALLBACK(on_load_changed), s);
+    g_signal_connect(s->web_view, "load-failed", G_CALLBACK(on_load_failed), s);
+    g_signal_connect(s->web_view, "load-failed-with-tls-errors", G_CALLBACK(on_load_failed_tls), s);
+    g_signal_connect(s->web_view, "web-process-terminated", G_CALLBACK(on_web_process_terminated), s);
+#if WEBKIT_CHECK_VERSION(2, 34, 0)
+    g_signal_connect(s->web_view, "notify::is-web-process-responsive",
+        G_CALLBACK(on_web_process_responsive_changed), s);
+#endif
+    if (s->callbacks.on_navigation_timing != NULL)
+        g_signal_connect_after(s->web_view, "draw", G_CALLBACK(on_web_view_draw), s);
+    g_signal_connect(s->web_view, "resource-load-started", G_CALLBACK(on_resource_load_started), s);
+
+    if (s->opt_native_bridge)
+        bridge_register_view(s);
+
+    /* Evaluations queued while the view was hibernated. */
+    eval_start_queued(s);
+
+    /* Permission signal */
+    g_signal_connect(s->web_view, "permission-request", G_CALLBACK(on_permission_request), s);
+
+    /* Context menu signal */
+    if (s->callbacks.on_context_menu != NULL)
+    {
+        g_signal_connect(s->web_view, "context-menu", G_CALLBACK(on_context_menu), s);
+    }
+
+    /* Set up drag-and-drop targets */
+    GtkTargetEntry targets[] = {
+        {"text/uri-list", 0, 0},
+        {"text/plain", 0, 1},
+        {"UTF8_STRING", 0, 2}
+    };
+    gtk_drag_dest_set(GTK_WIDGET(s->web_view),
+        GTK_DEST_DEFAULT_ALL,
+        targets, G_N_ELEMENTS(targets),
+        GDK_ACTION_COPY);
+    g_signal_connect(s->web_view, "drag-data-received", G_CALLBACK(on_drag_data_received), s);
+    g_signal_connect(s->web_view, "drag-motion", G_CALLBACK(on_drag_motion), s);
+    g_signal_connect(s->web_view, "drag-leave", G_CALLBACK(on_drag_leave), s);
+}
+
+typedef struct
+{
+    shim_state* state;
+    gulong x11_window_id;
+    gboolean result;
+} attach_data;
+
+static void do_attach(void* data)
+{
+    attach_data* ad = (attach_data*)data;
+    shim_state* s = ad->state;
+
+    if (atomic_load(&s->detached))
+    {
+        ad->result = FALSE;
+        return;
+    }
+
+    /* Create a GtkPlug to embed into the X11 window provided by Avalonia NativeControlHost,
+     * or an offscreen toplevel whose frames the host draws itself. */
+    s->plug = s->opt_offscreen ? offscreen_create_window(s) : gtk_plug_new((Window)ad->x11_window_id);
+    if (s->plug == NULL)
+    {
+        ad->result = FALSE;
+        return;
+    }
+
+    /* Create content manager for script message handling */
+    s->content_manager = webkit_user_content_manager_new();
+    g_signal_connect(s->content_manager, "script-message-received::agibuildWebView",
+                     G_CALLBACK(on_script_message), s);
+    webkit_user_content_manager_register_script_message_handler(s->content_manager, "agibuildWebView");
+
+    /* Re-apply compiled content filters and shared content sets attached before attach */
+    attach_content_filters(s);
+    attach_content_sets(s);
+
+    create_web_view(s);
+
+    /* Register custom URI schemes */
+    WebKitWebContext* web_context = webkit_web_view_get_context(s->web_view);
+    if (s->custom_schemes != NULL && s->callbacks.on_scheme_request != NULL)
+    {
+        for (int i = 0; i < s->custom_scheme_count; i++)
+        {
+            webkit_web_context_register_uri_scheme(web_context, s->custom_schemes[i],
+                on_custom_scheme_request, NULL, NULL);
+        }
+    }
+    fetch_bridge_register(s);
+
+    /* Download signal */
+    g_signal_connect(web_context, "download-started", G_CALLBACK(on_download_started), s);
+
+    /* Add WebView to the plug */
+    gtk_container_add(GTK_CONTAINER(s->plug), GTK_WIDGET(s->web_view));
+    gtk_widget_show_all(s->plug);
+    activity_apply(s);
+
+    atomic_fetch_add(&g_attached_views, 1);
+    ad->result = TRUE;
+}
+
+/* Ignores every policy decision still waiting on managed code. */
+static void cancel_pending_policies(shim_state* s)
+{
+    if (s->ops != NULL)
+        op_table_abort(s->ops, AG_GTK_OP_POLICY);
+}
+
+/* ========== Detach helper ========== */
+
+static void do_detach(void* data)
+{
+    shim_state* s = (shim_state*)data;
+    gboolean was_detached = atomic_exchange(&s->detached, TRUE);
+    if (was_detached)
+        return;
+
+    atomic_store(&s->dev_tools_open, FALSE);
+    cancel_drag_motion_flush(s);
+
+    detach_content_sets(s);
+    destroy_preload_view(s);
+    bridge_unregister_view(s);
+    eval_abort_all(s);
+
+    /* Unregister script message handler */
+    if (s->content_manager != NULL)
+    {
+        webkit_user_content_manager_unregister_script_message_handler(s->content_manager, "agibuildWebView");
+        g_signal_handlers_disconnect_by_data(s->content_manager, s);
+    }
+
+    /* A view WebKit keeps alive a little longer must not route requests back to this state. */
+    if (s->web_view != NULL)
+        g_object_set_data(G_OBJECT(s->web_view), AG_SHIM_STATE_KEY, NULL);
+
+    /* Destroy the plug (and its children including web_view) */
+    if (s->plug != NULL)
+    {
+        gtk_widget_destroy(s->plug);
+        s->plug = NULL;
+        atomic_fetch_sub(&g_attached_views, 1);
+    }
+    offscreen_destroy(s);
+
+    /* Context-level handlers (downloads) outlive this view on a shared context. */
+    if (s->web_context != NULL)
+    {
+        g_signal_handlers_disconnect_by_data(s->web_context, s);
+        g_object_unref(s->web_context);
+        s->web_context = NULL;
+    }
+
+    /* Policy decisions are ignored; captures and cookie reads report their failure result now
+     * rather than whenever WebKit gets round to cancelling them. */
+    op_table_abort(s->ops, 0);
+    release_hibernation_state(s);
+    drop_inflight_resources(s);
+    hang_reset(s);
+
+    /* The view held its own reference; this drops the one from webkit_user_content_manager_new. */
+    s->web_view = NULL;
+    g_clear_object(&s->content_manager);
+}
+
+/* ========== Public API ========== */
+
+ag_gtk_handle ag_gtk_create(const struct ag_gtk_callbacks* callbacks, void* user_data)
+{
+    freeze_process_options();
+    ensure_gtk_init();
+
+    shim_state* s = (shim_state*)calloc(1, sizeof(shim_state));
+    if (s == NULL)
+        return NULL;
+
+    if (callbacks)
+    {
+        s->callbacks = *callbacks;
+    }
+    s->user_data = user_data;
+    atomic_init(&s->detached, FALSE);
+    atomic_init(&s->dev_tools_open, FALSE);
+    atomic_init(&s->drag_motion_delivered, 0);
+    atomic_init(&s->drag_motion_suppressed, 0);
+    s->ops = op_table_new();
+    s->download_progress_interval_us = DOWNLOAD_PROGRESS_INTERVAL_US_DEFAULT;
+    s->content_filters = g_ptr_array_new_with_free_func((GDestroyNotify)webkit_user_content_filter_unref);
+    s->user_scripts = g_hash_table_new_full(g_str_hash, g_str_equal, g_free,
+        (GDestroyNotify)webkit_user_script_unref);
+    s->attached_content_sets = g_ptr_array_new();
+    s->opt_cache_model = -1;
+    memset(&s->opt_profile, 0xff, sizeof(s->opt_profile)); /* all -1 */
+    g_mutex_init(&s->preload_lock);
+    g_mutex_init(&s->blob_lock);
+    g_mutex_init(&s->offscreen_lock);
+    s->blobs = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, (GDestroyNotify)published_blob_free);
+    s->preload_queue = g_queue_new();
+    s->eval_ops = g_hash_table_new(g_int64_hash, g_int64_equal);
+    s->eval_queue = g_queue_new();
+    s->preload_ready = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+
+    atomic_fetch_add(&g_live_views, 1);
+    return (ag_gtk_handle)s;
+}
+
+void ag_gtk_register_custom_scheme(ag_gtk_handle handle, const char* scheme_utf8)
+{
+    if (!handle || !scheme_utf8) return;
+    shim_state* s = (shim_state*)handle;
+
+    int new_count = s->custom_scheme_count + 1;
+    s->custom_schemes = (char**)realloc(s->custom_schemes, sizeof(char*) * (new_count + 1));
+    s->custom_schemes[s->custom_scheme_count] = strdup(scheme_utf8);
+    s->custom_schemes[new_count] = NULL; /* NULL-terminate */
+    s->custom_scheme_count = new_count;
+}
+
+void ag_gtk_destroy(ag_gtk_handle handle)
+{
+    if (!handle) return;
+    shim_state* s = (shim_state*)handle;
+    ag_gtk_detach(handle);
+
+    /* Operations WebKit has not completed yet keep the table alive until they do. */
+    op_table_orphan(s->ops);
+    s->ops = NULL;
+
+    if (s->user_scripts != NULL)
+    {
+        g_hash_table_destroy(s->user_scripts);
+        s->user_scripts = NULL;
+    }
+
+    if (s->attached_content_sets != NULL)
+    {
+        g_ptr_array_unref(s->attached_content_sets);
+        s->attached_content_sets = NULL;
+    }
+
+    if (s->content_filters != NULL)
+    {
+        g_ptr_array_unref(s->content_filters);
+        s->content_filters = NULL;
+    }
+    free(s->opt_content_filter_path);
+
+    /* Free custom schemes */
+    if (s->custom_schemes != NULL)
+    {
+        for (int i = 0; i < s->custom_scheme_count; i++)
+        {
+            free(s->custom_schemes[i]);
+        }
+        free(s->custom_schemes);
+    }
+    g_free(s->fetch_bridge_scheme);
+
+    free(s->opt_user_agent);
+    free(s->opt_data_dir);
+    free(s->opt_cache_dir);
+    g_queue_free_full(s->preload_queue, g_free);
+    g_hash_table_destroy(s->preload_ready);
+    g_free(s->preload_current);
+    g_mutex_clear(&s->preload_lock);
+    release_resource_timing(s);
+    g_hash_table_destroy(s->blobs); /* responses still streaming keep their blob alive */
+    g_hash_table_destroy(s->eval_ops);
+    g_queue_free(s->eval_queue);
+    g_mutex_clear(&s->blob_lock);
+    g_mutex_clear(&s->offscreen_lock);
+    free(s);
+    atomic_fetch_sub(&g_live_views, 1);
+}
+
+bool ag_gtk_attach(ag_gtk_handle handle, unsigned long x11_window_id)
+{
+    if (!handle) return false;
+    shim_state* s = (shim_state*)handle;
+    /* An offscreen view has no parent window. */
+    if (x11_window_id == 0 && !s->opt_offscreen) return false;
+
+    attach_data ad;
+    ad.state = s;
+    ad.x11_window_id = x11_window_id;
+    ad.result = FALSE;
+
+    run_on_gtk_thread(do_attach, &ad);
+    return ad.result;
+}
+
+void ag_gtk_detach(ag_gtk_handle handle)
+{
+    if (!handle) return;
+    shim_state* s = (shim_state*)handle;
+    run_on_gtk_thread(do_detach, s);
+}
+
+void ag_gtk_policy_decide(ag_gtk_handle handle, uint64_t request_id, bool allow)
+{
+    if (!handle || request_id == 0) return;
+    shim_state* s = (shim_state*)handle;
+
+    /* Any thread: the claim is what makes a late or duplicate answer a no-op. */
+    op_slot* slot = op_table_claim(s->ops, request_id, AG_GTK_OP_POLICY);
+    if (slot == NULL)
+        return;
+
+    WebKitPolicyDecision* decision = (WebKitPolicyDecision*)slot->payload.object;
+    op_slot_release(slot);
+
+    if (request_id == atomic_load(&s->nav_timing_policy_req_id))
+        atomic_store(&s->nav_timing_policy_decided_us, g_get_monotonic_time());
+
+    if (allow)
+        webkit_policy_decision_use(decision);
+    else
+        webkit_policy_decision_ignore(decision);
+
+    g_object_unref(decision);
+}
+
+void ag_gtk_navigate(ag_gtk_handle handle, const char* url_utf8)
+{
+    if (!handle || !url_utf8) return;
+    shim_state* s = (shim_state*)handle;
+    if (atomic_load(&s->detached) || s->web_view == NULL) return;
+
+    note_navigation_for_preload(s, url_utf8);
+    webkit_web_view_load_uri(s->web_view, url_utf8);
+}
+
+void ag_gtk_load_html(ag_gtk_handle handle, const char* html_utf8, const char* base_url_utf8_or_null)
+{
+    if (!handle || !html_utf8) return;
+    shim_state* s = (shim_state*)handle;
+    if (atomic_load(&s->detached) || s->web_view == NULL) return;
+
+    webkit_web_view_load_html(s->web_view, html_utf8, base_url_utf8_or_null);
+}
+
+typedef struct
+{
+    shim_state* state;
+    uint64_t request_id;
+    const char* script;
+    gboolean buffered;
+    int32_t result;
+} eval_js_data;
+
+static void do_eval_js(void* data)
+{
+    eval_js_data* d = (eval_js_data*)data;
+    shim_state* s = d->state;
+    d->result = AG_GTK_EVAL_UNAVAILABLE;
+    if (atomic_load(&s->detached) || s->web_view == NULL) return;
+
+    /* Request id 0 is fire-and-forget: untracked and not subject to the limits. */
+    if (d->request_id == 0)
+    {
+        webkit_web_view_run_javascript(s->web_view, d->script, NULL, NULL, NULL);
+        d->result = AG_GTK_EVAL_STARTED;
+        return;
+    }
+
+    gboolean slot_free = s->eval_max_running <= 0 || s->eval_running < s->eval_max_running;
+    if (!slot_free && (int32_t)g_queue_get_length(s->eval_queue) >= s->eval_max_queued)
+    {
+        d->result = AG_GTK_EVAL_REJECTED;
+        return;
+    }
+
+    op_slot* slot = op_slot_acquire(s->ops, AG_GTK_OP_SCRIPT, NULL);
+    if (slot == NULL)
+    {
+        d->result = AG_GTK_EVAL_REJECTED;
+        return;
+    }
+
+    eval_op* op = OP_PAYLOAD(slot, eval_op);
+    op->slot = slot;
+    op->state = s;
+    op->request_id = d->request_id;
+    op->script = g_strdup(d->script);
+    op->buffered = d->buffered;
+    op->submitted_us = g_get_monotonic_time();
+    g_hash_table_replace(s->eval_ops, &op->request_id, op);
+    if (s->eval_timeout_ms > 0)
+        op->timeout_id = g_timeout_add((guint)s->eval_timeout_ms, on_eval_timeout, op);
+
+    if (slot_free)
+    {
+        eval_start(s, op);
+        d->result = AG_GTK_EVAL_STARTED;
+    }
+    else
+    {
+        g_queue_push_tail(s->eval_queue, op);
+        d->result = AG_GTK_EVAL_QUEUED;
+    }
+}
+
+/* Returns AG_GTK_EVAL_*. Started and queued requests report through on_script_settled and, when
+ * they complete, on_script_result. */
+int32_t ag_gtk_eval_js(ag_gtk_handle handle, uint64_t request_id, const char* script_utf8)
+{
+    if (!handle || !script_utf8) return AG_GTK_EVAL_UNAVAILABLE;
+    eval_js_data d = { (shim_state*)handle, request_id, script_utf8, FALSE, AG_GTK_EVAL_UNAVAILABLE };
+    run_on_gtk_thread(do_eval_js, &d);
+    return d.result;
+}
+
+/* Like ag_gtk_eval_js, but a non-null result always arrives through on_script_buffer. */
+int32_t ag_gtk_eval_js_buffered(ag_gtk_handle handle, uint64_t request_id, const char* script_utf8)
+{
+    if (!handle || !script_utf8 || request_id == 0) return AG_GTK_EVAL_UNAVAILABLE;
+    eval_js_data d = { (shim_state*)handle, request_id, script_utf8, TRUE, AG_GTK_EVAL_UNAVAILABLE };
+    run_on_gtk_thread(do_eval_js, &d);
+    return d.result;
+}
+
+/* Results of at least threshold_bytes (0 = never) arrive through on_script_buffer. */
+void ag_gtk_set_eval_buffer_threshold(ag_gtk_handle handle, int64_t threshold_bytes)
+{
+    if (!handle) return;
+    ((shim_state*)handle)->eval_buffer_threshold = threshold_bytes > 0 ? threshold_bytes : 0;
+}
+
+/* Releases a buffer handed out by on_script_buffer. Safe from any thread. */
+void ag_gtk_buffer_release(void* buffer)
+{
+    if (buffer != NULL)
+        g_bytes_unref((GBytes*)buffer);
+}
+
+typedef struct
+{
+    shim_state* state;
+    uint64_t request_id;
+} eval_cancel_data;
+
+static void do_eval_js_cancel(void* data)
+{
+    eval_cancel_data* d = (eval_cancel_data*)data;
+    shim_state* s = d->state;
+    if (atomic_load(&s->detached)) return;
+
+    eval_op* op = (eval_op*)g_hash_table_lookup(s->eval_ops, &d->request_id);
+    if (op == NULL) return;
+    if (op->script != NULL)
+        eval_drop_queued(s, op, AG_GTK_SCRIPT_CANCELLED);
+    else
+        eval_abandon_running(s, op, AG_GTK_SCRIPT_CANCELLED);
+}
+
+/* Cancels a queued or running evaluation; either settles before this returns. A running script
+ * is not interrupted in the web process: its in-flight slot goes to the next queued request at
+ * once and its eventual result is discarded. */
+void ag_gtk_eval_js_cancel(ag_gtk_handle handle, uint64_t request_id)
+{
+    if (!handle || request_id == 0) return;
+    eval_cancel_data d = { (shim_state*)handle, request_id };
+    run_on_gtk_thread(do_eval_js_cancel, &d);
+}
+
+typedef struct
+{
+    shim_state* state;
+    int32_t max_running;
+    int32_t max_queued;
+    int32_t timeout_ms;
+} eval_limits_data;
+
+static void do_set_eval_limits(void* data)
+{
+    eval_limits_data* d = (eval_limits_data*)data;
+    shim_state* s = d->state;
+    s->eval_max_running = d->max_running > 0 ? d->max_running : 0;
+    s->eval_max_queued = d->max_queued > 0 ? d->max_queued : 0;
+    s->eval_timeout_ms = d->timeout_ms > 0 ? d->timeout_ms : 0;
+    if (!atomic_load(&s->detached))
+        eval_start_queued(s);
+}
+
+/* max_running 0 = unlimited. With the limit reached, up to max_queued requests wait and the
+ * rest are rejected. timeout_ms (0 = none) applies to requests submitted afterwards. */
+void ag_gtk_set_eval_limits(ag_gtk_handle handle, int32_t max_running, int32_t max_queued, int32_t timeout_ms)
+{
+    if (!handle) return;
+    eval_limits_data d = { (shim_state*)handle, max_running, max_queued, timeout_ms };
+    run_on_gtk_thread(do_set_eval_limits, &d);
+}
+
+typedef struct
+{
+    shim_state* state;
+    int32_t running;
+    int32_t queued;
+} eval_stats_data;
+
+static void do_get_eval_stats(void* data)
+{
+    eval_stats_data* d = (eval_stats_data*)data;
+    d->running = d->state->eval_running;
+    d->queued = (int32_t)g_queue_get_length(d->state->eval_queue);
+}
+
+void ag_gtk_get_eval_stats(ag_gtk_handle handle, int32_t* out_running, int32_t* out_queued)
+{
+    eval_stats_data d = { (shim_state*)handle, 0, 0 };
+    if (handle)
+        run_on_gtk_thread(do_get_eval_stats, &d);
+    if (out_running) *out_running = d.running;
+    if (out_queued) *out_queued = d.queued;
+}
+
+bool ag_gtk_go_back(ag_gtk_handle handle)
+{
+    if (!handle) return false;
+    shim_state* s = (shim_state*)handle;
+    if (atomic_load(&s->detached) || s->web_view == NULL) return false;
+    if (!webkit_web_view_can_go_back(s->web_view)) return false;
+    webkit_web_view_go_back(s->web_view);
+    return true;
+}
+
+bool ag_gtk_go_forward(ag_gtk_handle handle)
+{
+    if (!handle) return false;
+    shim_state* s = (shim_state*)handle;
+    if (atomic_load(&s->detached) || s->web_view == NULL) return false;
+    if (!webkit_web_view_can_go_forward(s->web_view)) return false;
+    webkit_web_view_go_forward(s->web_view);
+    return true;
+}
+
+bool ag_gtk_reload(ag_gtk_handle handle)
+{
+    if (!handle) return false;
+    shim_state* s = (shim_state*)handle;
+    if (atomic_load(&s->detached) || s->web_view == NULL) return false;
+    webkit_web_view_reload(s->web_view);
+    return true;
+}
+
+void ag_gtk_stop(ag_gtk_handle handle)
+{
+    if (!handle) return;
+    shim_state* s = (shim_state*)handle;
+    if (atomic_load(&s->detached) || s->web_view == NULL) return;
+    webkit_web_view_stop_loading(s->web_view);
+}
+
+bool ag_gtk_can_go_back(ag_gtk_handle handle)
+{
+    if (!handle) return false;
+    shim_state* s = (shim_state*)handle;
+    if (atomic_load(&s->detached) || s->web_view == NULL) return false;
+    return webkit_web_view_can_go_back(s->web_view);
+}
+
+bool ag_gtk_can_go_forward(ag_gtk_handle handle)
+{
+    if (!handle) return false;
+    shim_state* s = (shim_state*)handle;
+    if (atomic_load(&s->detached) || s->web_view == NULL) return false;
+    return webkit_web_view_can_go_forward(s->web_view);
+}
+
+void* ag_gtk_get_webview_handle(ag_gtk_handle handle)
+{
+    if (!handle) return NULL;
+    shim_state* s = (shim_state*)handle;
+    if (atomic_load(&s->detached)) return NULL;
+    return (void*)s->web_view;
+}
+
+/* ========== Cookie management ========== */
+
+/* Held in an AG_GTK_OP_COOKIES slot. */
+typedef struct
+{
+    ag_gtk_cookies_get_cb callback;
+    void* context;
+} cookies_get_data;
+
+G_STATIC_ASSERT(sizeof(cookies_get_data) <= OP_PAYLOAD_SIZE);
+
+static void abort_cookies_get(op_slot* slot)
+{
+    cookies_get_data* data = OP_PAYLOAD(slot, cookies_get_data);
+    data->callback(data->context, "[]");
+}
+
+static void on_cookies_get_finish(WebKitCookieManager* manager, GAsyncResult* result, gpointer user_data)
+{
+    op_slot* slot = (op_slot*)user_data;
+    cookies_get_data* data = OP_PAYLOAD(slot, cookies_get_data);
+
+    GError* error = NULL;
+    GList* cookies = webkit_cookie_manager_get_cookies_finish(manager, result, &error);
+
+    /* Not claimable when the view detached first: abort_cookies_get already answered. */
+    if (!op_slot_claim(slot))
+    {
+        if (error != NULL)
+            g_error_free(error);
+        g_list_free_full(cookies, (GDestroyNotify)soup_cookie_free);
+        op_slot_release(slot);
+        return;
+    }
+
+    if (error != NULL)
+    {
+        data->callback(data->context, "[]");
+        g_error_free(error);
+        op_slot_release(slot);
+        return;
+    }
+
+    /* Build JSON array */
+    GString* json = g_string_new("[");
+    gboolean first = TRUE;
+    for (GList* l = cookies; l != NULL; l = l->next)
+    {
+        SoupCookie* c = (SoupCookie*)l->data;
+        if (!first) g_string_append_c(json, ',');
+        first = FALSE;
+
+        const char* name = soup_cookie_get_name(c);
+        const char* value = soup_cookie_get_value(c);
+        const char* domain = soup_cookie_get_domain(c);
+        const char* path = soup_cookie_get_path(c);
+        gboolean secure = soup_cookie_get_secure(c);
+        gboolean http_only = soup_cookie_get_http_only(c);
+
+        /* libsoup3 (webkit2gtk-4.1): soup_cookie_get_expires returns GDateTime* instead of SoupDate*. */
+        GDateTime* expires = soup_cookie_get_expires(c);
+        double expires_unix = expires ? (double)g_date_time_to_unix(expires) : -1.0;
+
+        g_string_append_printf(json,
+            "{\"name\":\"%s\",\"value\":\"%s\",\"domain\":\"%s\",\"path\":\"%s\","
+            "\"expires\":%.3f,\"isSecure\":%s,\"isHttpOnly\":%s}",
+            name ? name : "", value ? value : "", domain ? domain : "", path ? path : "/",
+            expires_unix,
+            secure ? "true" : "false",
+            http_only ? "true" : "false");
+    }
+    g_string_append_c(json, ']');
+
+    data->callback(data->context, json->str);
+
+    g_string_free(json, TRUE);
+    g_list_free_full(cookies, (GDestroyNotify)soup_cookie_free);
+    op_slot_release(slot);
+}
+
+void ag_gtk_cookies_get(ag_gtk_handle handle, const char* url_utf8,
+                         ag_gtk_cookies_get_cb callback, void* context)
+{
+    if (!handle || !callback) return;
+    shim_state* s = (shim_state*)handle;
+    if (atomic_load(&s->detached) || s->web_view == NULL)
+    {
+        callback(context, "[]");
+        return;
+    }
+
+    WebKitWebContext* web_ctx = webkit_web_view_get_context(s->web_view);
+    WebKitCookieManager* cookie_mgr = webkit_web_context_get_cookie_manager(web_ctx);
+
+    op_slot* slot = op_slot_acquire(s->ops, AG_GTK_OP_COOKIES, abort_cookies_get);
+    if (slot == NULL)
+    {
+        callback(context, "[]");
+        return;
+    }
+    cookies_get_data* data = OP_PAYLOAD(slot, cookies_get_data);
+    data->callback = callback;
+    data->context = context;
+
+    webkit_cookie_manager_get_cookies(cookie_mgr, url_utf8 ? url_utf8 : "",
+                                       NULL, (GAsyncReadyCallback)on_cookies_get_finish, slot);
+}
+
+void ag_gtk_cookie_set(ag_gtk_handle handle,
+    const char* name, const char* value, const char* domain, const char* path,
+    double expires_unix, bool is_secure, bool is_http_only,
+    ag_gtk_cookie_op_cb callback, void* context)
+{
+    if (!handle || !callback) return;
+    shim_state* s = (shim_state*)handle;
+    if (atomic_load(&s->detached) || s->web_view == NULL)
+    {
+        callback(context, false, "Detached");
+        return;
+    }
+
+    SoupCookie* cookie = soup_cookie_new(
+        name ? name : "", value ? value : "",
+        domain ? domain : "", path ? path : "/",
+        -1 /* max-age: session */);
+
+    if (expires_unix > 0)
+    {
+        /* libsoup3 (used by webkit2gtk-4.1) replaced SoupDate with GDateTime. */
+        GDateTime* date = g_date_time_new_from_unix_utc(expires_unix);
+        if (date)
+        {
+            soup_cookie_set_expires(cookie, date);
+            g_date_time_unref(date);
+        }
+    }
+
+    soup_cookie_set_secure(cookie, is_secure);
+    soup_cookie_set_http_only(cookie, is_http_only);
+
+    WebKitWebContext* web_ctx = webkit_web_view_get_context(s->web_view);
+    WebKitCookieManager* cookie_mgr = webkit_web_context_get_cookie_manager(web_ctx);
+    webkit_cookie_manager_add_cookie(cookie_mgr, cookie, NULL, NULL, NULL);
+
+    soup_cookie_free(cookie);
+    callback(context, true, NULL);
+}
+
+void ag_gtk_cookie_delete(ag_gtk_handle handle,
+    const char* name, const char* domain, const char* path,
+    ag_gtk_cookie_op_cb callback, void* context)
+{
+    if (!handle || !callback) return;
+    shim_state* s = (shim_state*)handle;
+    if (atomic_load(&s->detached) || s->web_view == NULL)
+    {
+        callback(context, false, "Detached");
+        return;
+    }
+
+    SoupCookie* cookie = soup_cookie_new(
+        name ? name : "", "",
+        domain ? domain : "", path ? path : "/",
+        0 /* expired */);
+
+    WebKitWebContext* web_ctx = webkit_web_view_get_context(s->web_view);
+    WebKitCookieManager* cookie_mgr = webkit_web_context_get_cookie_manager(web_ctx);
+    webkit_cookie_manager_delete_cookie(cookie_mgr, cookie, NULL, NULL, NULL);
+
+    soup_cookie_free(cookie);
+    callback(context, true, NULL);
+}
+
+void ag_gtk_cookies_clear_all(ag_gtk_handle handle,
+                               ag_gtk_cookie_op_cb callback, void* context)
+{
+    if (!handle || !callback) return;
+    shim_state* s = (shim_state*)handle;
+    if (atomic_load(&s->detached) || s->web_view == NULL)
+    {
+        callback(context, false, "Detached");
+        return;
+    }
+
+    WebKitWebContext* web_ctx = webkit_web_view_get_context(s->web_view);
+    WebKitWebsiteDataManager* data_mgr = webkit_web_context_get_website_data_manager(web_ctx);
+    webkit_website_data_manager_clear(data_mgr, WEBKIT_WEBSITE_DATA_COOKIES, 0, NULL, NULL, NULL);
+
+    callback(context, true, NULL);
+}
+
+/* ========== Environment options ========== */
+
+void ag_gtk_set_enable_dev_tools(ag_gtk_handle handle, bool enable)
+{
+    if (!handle) return;
+    shim_state* s = (shim_state*)handle;
+    s->opt_enable_dev_tools = enable;
+    if (!enable)
+        atomic_store(&s->dev_tools_open, FALSE);
+
+    /* Also apply to live WebView if already attached. */
+    if (s->web_view != NULL && !atomic_load(&s->detached))
+    {
+        WebKitSettings* settings = webkit_web_view_get_settings(s->web_view);
+        webkit_settings_set_enable_developer_extras(settings, enable);
+    }
+}
+
+/* ========== DevTools runtime toggle ========== */
+
+static void do_open_dev_tools(void* data)
+{
+    shim_state* s = (shim_state*)data;
+    if (atomic_load(&s->detached) || s->web_view == NULL) return;
+    if (!s->opt_enable_dev_tools) return;
+
+    WebKitWebInspector* inspector = webkit_web_view_get_inspector(s->web_view);
+    if (inspector == NULL) return;
+
+    webkit_web_inspector_show(inspector);
+    atomic_store(&s->dev_tools_open, TRUE);
+}
+
+static void do_close_dev_tools(void* data)
+{
+    shim_state* s = (shim_state*)data;
+    if (atomic_load(&s->detached) || s->web_view == NULL) return;
+    if (!s->opt_enable_dev_tools) return;
+
+    WebKitWebInspector* inspector = webkit_web_view_get_inspector(s->web_view);
+    if (inspector == NULL) return;
+
+    webkit_web_inspector_close(inspector);
+    atomic_store(&s->dev_tools_open, FALSE);
+}
+
+void ag_gtk_open_dev_tools(ag_gtk_handle handle)
+{
+    if (!handle) return;
+    shim_state* s = (shim_state*)handle;
+    run_on_gtk_thread(do_open_dev_tools, s);
+}
+
+void ag_gtk_close_dev_tools(ag_gtk_handle handle)
+{
+    if (!handle) return;
+    shim_state* s = (shim_state*)handle;
+    run_on_gtk_thread(do_close_dev_tools, s);
+}
+
+bool ag_gtk_is_dev_tools_open(ag_gtk_handle handle)
+{
+    if (!handle) return false;
+    shim_state* s = (shim_state*)handle;
+    return atomic_load(&s->dev_tools_open);
+}
+
+void ag_gtk_set_ephemeral(ag_gtk_handle handle, bool ephemeral)
+{
+    if (!handle) return;
+    shim_state* s = (shim_state*)handle;
+    s->opt_ephemeral = ephemeral;
+}
+
+void ag_gtk_set_user_agent(ag_gtk_handle handle, const char* ua_utf8_or_null)
+{
+    if (!handle) return;
+    shim_state* s = (shim_state*)handle;
+
+    free(s->opt_user_agent);
+    s->opt_user_agent = ua_utf8_or_null ? strdup(ua_utf8_or_null) : NULL;
+
+    /* Also update live WebView if already attached. */
+    if (s->web_view != NULL && !atomic_load(&s->detached))
+    {
+        WebKitSettings* settings = webkit_web_view_get_settings(s->web_view);
+        webkit_settings_set_user_agent(settings, ua_utf8_or_null);
+    }
+}
+
+/* ========== Screenshot capture ========== */
+
+typedef void (*ag_gtk_screenshot_cb)(void* context, const void* png_data, uint32_t png_len);
+
+/* Held in an AG_GTK_OP_SCREENSHOT slot. */
+typedef struct {
+    ag_gtk_screenshot_cb callback;
+    void* context;
+} screenshot_ctx;
+
+G_STATIC_ASSERT(sizeof(screenshot_ctx) <= OP_PAYLOAD_SIZE);
+
+static void abort_screenshot(op_slot* slot)
+{
+    screenshot_ctx* ctx = OP_PAYLOAD(slot, screenshot_ctx);
+    ctx->callback(ctx->context, NULL, 0);
+}
+
+static cairo_status_t png_write_to_byte_array(void* closure, const unsigned char* data, unsigned int length)
+{
+    GByteArray* array = (GByteArray*)closure;
+    g_byte_array_append(array, data, length);
+    return CAIRO_STATUS_SUCCESS;
+}
+
+static void on_snapshot_ready(GObject* source, GAsyncResult* result, gpointer user_data)
+{
+    op_slot* slot = (op_slot*)user_data;
+    screenshot_ctx* ctx = OP_PAYLOAD(slot, screenshot_ctx);
+    GError* error = NULL;
+    cairo_surface_t* surface = webkit_web_view_get_snapshot_finish(
+        WEBKIT_WEB_VIEW(source), result, &error);
+
+    /* Not claimable when the view detached first: abort_screenshot already answered. */
+    if (!op_slot_claim(slot))
+    {
+        if (error) g_error_free(error);
+        if (surface) cairo_surface_destroy(surface);
+        op_slot_release(slot);
+        return;
+    }
+
+    if (error != NULL || surface == NULL)
+    {
+        if (error) g_error_free(error);
+        ctx->callback(ctx->context, NULL, 0);
+        op_slot_release(slot);
+        return;
+    }
+
+    GByteArray* array = g_byte_array_new();
+    cairo_status_t status = cairo_surface_write_to_png_stream(surface, png_write_to_byte_array, array);
+    cairo_surface_destroy(surface);
+
+    if (status != CAIRO_STATUS_SUCCESS || array->len == 0)
+    {
+        g_byte_array_free(array, TRUE);
+        ctx->callback(ctx->context, NULL, 0);
+        op_slot_release(slot);
+        return;
+    }
+
+    ctx->callback(ctx->context, array->data, (uint32_t)array->len);
+    g_byte_array_free(array, TRUE);
+    op_slot_release(slot);
+}
+
+void ag_gtk_capture_screenshot(ag_gtk_handle handle, ag_gtk_screenshot_cb callback, void* context)
+{
+    if (!handle)
+    {
+        callback(context, NULL, 0);
+        return;
+    }
+    shim_state* s = (shim_state*)handle;
+    if (s->web_view == NULL || atomic_load(&s->detached))
+    {
+        callback(context, NULL, 0);
+        return;
+    }
+
+    op_slot* slot = op_slot_acquire(s->ops, AG_GTK_OP_SCREENSHOT, abort_screenshot);
+    if (slot == NULL)
+    {
+        callback(context, NULL, 0);
+        return;
+    }
+    screenshot_ctx* ctx = OP_PAYLOAD(slot, screenshot_ctx);
+    ctx->callback = callback;
+    ctx->context = context;
+
+    webkit_web_view_get_snapshot(
+        s->web_view,
+        WEBKIT_SNAPSHOT_REGION_VISIBLE,
+        WEBKIT_SNAPSHOT_OPTIONS_NONE,
+        NULL,
+        on_snapshot_ready,
+        slot);
+}
+
+/* ========== Full-document capture ========== */
+
+/* A full-document snapshot would be one surface the size of the page. Instead the page is
+ * scrolled a viewport at a time and each visible snapshot is cut into tiles that are handed
+ * out and dropped, so memory stays at one viewport surface plus one tile whatever the page
+ * height. Fixed and sticky elements appear in every viewport they cover; content wider than
+ * the viewport is cut at its right edge. The scroll position is restored afterwards. */
+
+#define AG_GTK_TILE_RAW 0
+#define AG_GTK_TILE_PNG 1
+
+#define AG_GTK_FULL_PAGE_COMPLETED 0
+#define AG_GTK_FULL_PAGE_CANCELLED 1
+#define AG_GTK_FULL_PAGE_FAILED    2
+
+/* One tile: document rows [y, y + height) in device pixels of a total_height-row document.
+ * Raw tiles are cairo ARGB32 rows (premultiplied BGRA in memory) of stride bytes; PNG tiles are
+ * a complete PNG file and stride is 0. data is valid for the call only. Return false to cancel. */
+typedef bool (*ag_gtk_full_page_tile_cb)(void* context, int32_t index, int32_t y, int32_t width,
+    int32_t height, int32_t total_height, int32_t stride, const void* data, uint32_t length);
+
+/* status is AG_GTK_FULL_PAGE_*; error_utf8 is set when it is FAILED. */
+typedef void (*ag_gtk_full_page_done_cb)(void* context, int32_t status, int32_t tiles, const char* error_utf8);
+
+/* Holds an AG_GTK_OP_SCREENSHOT slot whose payload points back here. GTK thread. */
+typedef struct
+{
+    shim_state* state;
+    op_slot* slot;
+    WebKitWebView* web_view;       /* referenced; the capture fails if the view is replaced */
+    ag_gtk_full_page_tile_cb on_tile;
+    ag_gtk_full_page_done_cb on_done;
+    void* context;
+    int32_t encoding;
+    int32_t tile_height;           /* requested, device px; 0 = the viewport height */
+    int64_t max_tile_bytes;        /* 0 = no limit beyond the viewport */
+    double origin_x, origin_y;     /* CSS px scroll position to restore */
+    double scroll_y;               /* CSS px, as the page reported it after the last scroll */
+    double view_height;            /* CSS px */
+    double doc_height;             /* CSS px, fixed by the first measurement */
+    double scale;                  /* device px per CSS px */
+    int32_t tile_rows;
+    int32_t total_rows;
+    int32_t next_row;              /* first document row not yet handed out */
+    int32_t tiles;
+    int32_t stalls;
+    gboolean measured;
+} full_page_op;
+
+static void full_page_scroll(full_page_op* op, double y);
+
+static void full_page_free(full_page_op* op)
+{
+    g_object_unref(op->web_view);
+    free(op);
+}
+
+/* The view went away mid-capture. The step still running in WebKit frees the op. */
+static void abort_full_page(op_slot* slot)
+{
+    full_page_op* op = (full_page_op*)slot->payload.object;
+    op->on_done(op->context, AG_GTK_FULL_PAGE_FAILED, op->tiles, "The view was detached during the capture");
+}
+
+/* False once the capture was aborted or its view replaced; the caller then drops the op. */
+static gboolean full_page_live(full_page_op* op)
+{
+    if (atomic_load(&op->slot->live) != op->slot->id)
+    {
+        op_slot_release(op->slot);
+        full_page_free(op);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+static void full_page_finish(full_page_op* op, int32_t status, const char* error)
+{
+    if (op->measured && op->state->web_view == op->web_view && !atomic_load(&op->state->detached))
+    {
+        char script[96];
+        g_snprintf(script, sizeof(script), "window.scrollTo(%.0f, %.0f);", op->origin_x, op->origin_y);
+        webkit_web_view_run_javascript(op->web_view, script, NULL, NULL, NULL);
+    }
+
+    if (op_slot_claim(op->slot))
+        op->on_done(op->context, status, op->tiles, error);
+    op_slot_release(op->slot);
+    full_page_free(op);
+}
+
+static gboolean full_page_emit(full_page_op* op, cairo_surface_t* surface, int32_t offset, int32_t rows)
+{
+    int32_t width = cairo_image_surface_get_width(surface);
+    int32_t stride = cairo_image_surface_get_stride(surface);
+    const unsigned char* data = cairo_image_surface_get_data(surface) + (size_t)offset * stride;
+    int32_t index = op->tiles++;
+
+    if (op->encoding != AG_GTK_TILE_PNG)
+        return op->on_tile(op->context, index, op->next_row, width, rows, op->total_rows,
+            stride, data, (uint32_t)((size_t)rows * stride));
+
+    cairo_surface_t* tile = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width, rows);
+    int32_t tile_stride = cairo_image_surface_get_stride(tile);
+    unsigned char* tile_data = cairo_image_surface_get_data(tile);
+    cairo_surface_flush(tile);
+    for (int32_t r = 0; r < rows; r++)
+        memcpy(tile_data + (size_t)r * tile_stride, data + (size_t)r * stride, (size_t)width * 4);
+    cairo_surface_mark_dirty(tile);
+
+    GByteArray* png = g_byte_array_new();
+    cairo_status_t status = cairo_surface_write_to_png_stream(tile, png_write_to_byte_array, png);
+    cairo_surface_destroy(tile);
+
+    gboolean go_on = status == CAIRO_STATUS_SUCCESS
+        && op->on_tile(op->context, index, op->next_row, width, rows, op->total_rows, 0, png->data, png->len);
+    g_byte_array_free(png, TRUE);
+    return go_on;
+}
+
+static void on_full_page_snapshot(GObject* source, GAsyncResult* result, gpointer user_data)
+{
+    full_page_op* op = (full_page_op*)user_data;
+    GError* error = NULL;
+    cairo_surface_t* surface = webkit_web_view_get_snapshot_finish(WEBKIT_WEB_VIEW(source), result, &error);
+
+    if (!full_page_live(op))
+    {
+        if (error) g_error_free(error);
+        if (surface) cairo_surface_destroy(surface);
+        return;
+    }
+    if (surface == NULL || cairo_surface_get_type(surface) != CAIRO_SURFACE_TYPE_IMAGE)
+    {
+        full_page_finish(op, AG_GTK_FULL_PAGE_FAILED, error ? error->message : "Snapshot failed");
+        if (error) g_error_free(error);
+        if (surface) cairo_surface_destroy(surface);
+        return;
+    }
+    cairo_surface_flush(surface);
+
+    int32_t surface_height = cairo_image_surface_get_height(surface);
+    if (!op->measured)
+    {
+        op->scale = op->view_height > 0 ? surface_height / op->view_height : 1.0;
+        op->total_rows = (int32_t)(op->doc_height * op->scale + 0.5);
+        int64_t rows = op->tile_height > 0 ? op->tile_height : surface_height;
+        int64_t row_bytes = (int64_t)cairo_image_surface_get_width(surface) * 4;
+        if (op->max_tile_bytes > 0 && row_bytes > 0)
+            rows = MIN(rows, op->max_tile_bytes / row_bytes);
+        op->tile_rows = (int32_t)CLAMP(rows, 1, surface_height);
+        op->measured = TRUE;
+    }
+
+    /* Hand out every whole tile this viewport shows, then scroll to the first missing row. */
+    int32_t view_top = (int32_t)(op->scroll_y * op->scale + 0.5);
+    int32_t first_row = op->next_row;
+    gboolean go_on = TRUE;
+    while (go_on && op->next_row < op->total_rows)
+    {
+        int32_t rows = MIN(op->tile_rows, op->total_rows - op->next_row);
+        if (op->next_row < view_top || op->next_row + rows > view_top + surface_height)
+            break;
+        go_on = full_page_emit(op, surface, op->next_row - view_top, rows);
+        op->next_row += rows;
+    }
+    cairo_surface_destroy(surface);
+
+    if (!go_on)
+    {
+        full_page_finish(op, AG_GTK_FULL_PAGE_CANCELLED, NULL);
+        return;
+    }
+    if (op->next_row >= op->total_rows)
+    {
+        full_page_finish(op, AG_GTK_FULL_PAGE_COMPLETED, NULL);
+        return;
+    }
+    if (op->next_row == first_row && ++op->stalls > 2)
+    {
+        full_page_finish(op, AG_GTK_FULL_PAGE_FAILED, "The document changed height during the capture");
+        return;
+    }
+    full_page_scroll(op, op->next_row / op->scale);
+}
+
+static void on_full_page_scrolled(GObject* source, GAsyncResult* result, gpointer user_data)
+{
+    full_page_op* op = (full_page_op*)user_data;
+    GError* error = NULL;
+    WebKitJavascriptResult* js_result = webkit_web_view_run_javascript_finish(WEBKIT_WEB_VIEW(source), result, &error);
+
+    /* origin x, origin y, scroll y, document height, viewport height */
+    double m[5] = { 0 };
+    int fields = 0;
+    if (js_result != NULL)
+    {
+        char* text = jsc_value_to_string(webkit_javascript_result_get_js_value(js_result));
+        if (text != NULL)
+        {
+            fields = parse_script_numbers(text, m, 5);
+            g_free(text);
+        }
+        webkit_javascript_result_unref(js_result);
+    }
+
+    if (!full_page_live(op))
+    {
+        if (error) g_error_free(error);
+        return;
+    }
+    if (fields != 5 || op->state->web_view != op->web_view)
+    {
+        full_page_finish(op, AG_GTK_FULL_PAGE_FAILED, error ? error->message : "The page could not be measured");
+        if (error) g_error_free(error);
+        return;
+    }
+
+    if (!op->measured)
+    {
+        op->origin_x = m[0];
+        op->origin_y = m[1];
+        op->doc_height = m[3];
+        op->view_height = m[4];
+    }
+    op->scroll_y = m[2];
+
+    webkit_web_view_get_snapshot(op->web_view, WEBKIT_SNAPSHOT_REGION_VISIBLE,
+        WEBKIT_SNAPSHOT_OPTIONS_NONE, NULL, on_full_page_snapshot, op);
+}
+
+static void full_page_scroll(full_page_op* op, double y)
+{
+    char script[320];
+    g_snprintf(script, sizeof(script),
+        "(function(y){var d=document.documentElement,b=document.body,x=scrollX,o=scrollY;"
+        "scrollTo(x,y);return [x,o,scrollY,Math.max(d.scrollHeight,b?b.scrollHeight:0),innerHeight].join(',');})(%ld)",
+        (long)y);
+    webkit_web_view_run_javascript(op->web_view, script, NULL, on_full_page_scrolled, op);
+}
+
+static void do_capture_full_page(void* data)
+{
+    full_page_op* op = (full_page_op*)data;
+    shim_state* s = op->state;
+    if (s->web_view == NULL || atomic_load(&s->detached))
+    {
+        op->on_done(op->context, AG_GTK_FULL_PAGE_FAILED, 0, "Not attached");
+        free(op);
+        return;
+    }
+
+    op->slot = op_slot_acquire(s->ops, AG_GTK_OP_SCREENSHOT, abort_full_page);
+    if (op->slot == NULL)
+    {
+        op->on_done(op->context, AG_GTK_FULL_PAGE_FAILED, 0, "Too many operations in flight");
+        free(op);
+        return;
+    }
+    op->slot->payload.object = op;
+    op->web_view = g_object_ref(s->web_view);
+    full_page_scroll(op, 0);
+}
+
+/* Captures the whole document as tiles of tile_height device rows (0 = the viewport height),
+ * lowered so no tile exceeds max_tile_bytes (0 = no limit). encoding is AG_GTK_TILE_RAW or
+ * AG_GTK_TILE_PNG. Tiles arrive in order on the GTK thread; on_done is called exactly once. */
+void ag_gtk_capture_full_page(ag_gtk_handle handle, int32_t tile_height, int64_t max_tile_bytes, int32_t encoding,
+    ag_gtk_full_page_tile_cb on_tile, ag_gtk_full_page_done_cb on_done, void* context)
+{
+    if (!handle)
+    {
+        on_done(context, AG_GTK_FULL_PAGE_FAILED, 0, "Not attached");
+        return;
+    }
+
+    full_page_op* op = (full_page_op*)calloc(1, sizeof(full_page_op));
+    op->state = (shim_state*)handle;
+    op->on_tile = on_tile;
+    op->on_done = on_done;
+    op->context = context;
+    op->encoding = encoding;
+    op->tile_height = tile_height > 0 ? tile_height : 0;
+    op->max_tile_bytes = max_tile_bytes > 0 ? max_tile_bytes : 0;
+    run_on_gtk_thread(do_capture_full_page, op);
+}
+
+/* ========== Print to PDF ========== */
+
+typedef void (*ag_gtk_pdf_cb)(void* context, const void* pdf_data, uint32_t pdf_len);
+
+/* Held in an AG_GTK_OP_PDF slot. On error WebKit emits "failed" and then "finished"; the
+ * result is reported by whichever claims the slot first and the slot is released on "finished". */
+typedef struct {
+    ag_gtk_pdf_cb callback;
+    void* context;
+    char temp_path[64];
+} pdf_ctx;
+
+G_STATIC_ASSERT(sizeof(pdf_ctx) <= OP_PAYLOAD_SIZE);
+
+static void abort_pdf(op_slot* slot)
+{
+    pdf_ctx* ctx = OP_PAYLOAD(slot, pdf_ctx);
+    ctx->callback(ctx->context, NULL, 0);
+}
+
+static void on_pdf_print_finished(WebKitPrintOperation* operation, gpointer user_data)
+{
+    (void)operation;
+    op_slot* slot = (op_slot*)user_data;
+    pdf_ctx* ctx = OP_PAYLOAD(slot, pdf_ctx);
+
+    if (op_slot_claim(slot))
+    {
+        gchar* contents = NULL;
+        gsize length = 0;
+        if (g_file_get_contents(ctx->temp_path, &contents, &length, NULL) && contents)
+        {
+            ctx->callback(ctx->context, contents, (uint32_t)length);
+            g_free(contents);
+        }
+        else
+        {
+            ctx->callback(ctx->context, NULL, 0);
+        }
+    }
+
+    g_unlink(ctx->temp_path);
+    op_slot_release(slot);
+}
+
+static void on_pdf_print_failed(WebKitPrintOperation* operation, GError* error, gpointer user_data)
+{
+    (void)operation;
+    (void)error;
+    op_slot* slot = (op_slot*)user_data;
+    if (op_slot_claim(slot))
+    {
+        pdf_ctx* ctx = OP_PAYLOAD(slot, pdf_ctx);
+        ctx->callback(ctx->context, NULL, 0);
+    }
+}
+
+void ag_gtk_print_to_pdf(ag_gtk_handle handle, ag_gtk_pdf_cb callback, void* context)
+{
+    if (!handle)
+    {
+        callback(context, NULL, 0);
+        return;
+    }
+    shim_state* s = (shim_state*)handle;
+    if (s->web_view == NULL || atomic_load(&s->detached))
+    {
+        callback(context, NULL, 0);
+        return;
+    }
+
+    /* Generate a unique temp file path for the PDF output. */
+    char temp_template[] = "/tmp/fulora_print_XXXXXX";
+    int fd = mkstemp(temp_template);
+    if (fd < 0)
+    {
+        callback(context, NULL, 0);
+        return;
+    }
+    close(fd);
+    /* Rename with .pdf extension for GTK print settings. */
+    char pdf_path[64];
+    snprintf(pdf_path, sizeof(pdf_path), "%s.pdf", temp_template);
+    rename(temp_template, pdf_path);
+
+    op_slot* slot = op_slot_acquire(s->ops, AG_GTK_OP_PDF, abort_pdf);
+    if (slot == NULL)
+    {
+        g_unlink(pdf_path);
+        callback(context, NULL, 0);
+        return;
+    }
+    pdf_ctx* ctx = OP_PAYLOAD(slot, pdf_ctx);
+    ctx->callback = callback;
+    ctx->context = context;
+    g_strlcpy(ctx->temp_path, pdf_path, sizeof(ctx->temp_path));
+
+    WebKitPrintOperation* print_op = webkit_print_operation_new(s->web_view);
+
+    GtkPrintSettings* settings = gtk_print_settings_new();
+    gtk_print_settings_set_printer(settings, "Print to File");
+    gtk_print_settings_set(settings, GTK_PRINT_SETTINGS_OUTPUT_FILE_FORMAT, "pdf");
+
+    gchar* file_uri = g_filename_to_uri(ctx->temp_path, NULL, NULL);
+    if (file_uri)
+    {
+        gtk_print_settings_set(settings, GTK_PRINT_SETTINGS_OUTPUT_URI, file_uri);
+        g_free(file_uri);
+    }
+    webkit_print_operation_set_print_settings(print_op, settings);
+
+    GtkPageSetup* page_setup = gtk_page_setup_new();
+    gtk_page_setup_set_paper_size(page_setup, gtk_paper_size_new(GTK_PAPER_NAME_A4));
+    webkit_print_operation_set_page_setup(print_op, page_setup);
+
+    g_signal_connect(print_op, "failed", G_CALLBACK(on_pdf_print_failed), slot);
+    g_signal_connect(print_op, "finished", G_CALLBACK(on_pdf_print_finished), slot);
+
+    webkit_print_operation_print(print_op);
+
+    g_object_unref(settings);
+    g_object_unref(page_setup);
+}
+
+/* ========== Zoom ========== */
+
+double ag_gtk_get_zoom(ag_gtk_handle handle)
+{
+    if (!handle) return 1.0;
+    shim_state* s = (shim_state*)handle;
+    if (s->web_view == NULL || atomic_load(&s->detached)) return 1.0;
+    return webkit_web_view_get_zoom_level(s->web_view);
+}
+
+void ag_gtk_set_zoom(ag_gtk_handle handle, double zoom_factor)
+{
+    if (!handle) return;
+    shim_state* s = (shim_state*)handle;
+    if (s->web_view == NULL || atomic_load(&s->detached)) return;
+    webkit_web_view_set_zoom_level(s->web_view, zoom_factor);
+}
+
+/* ========== Find in Page ========== */
+
+typedef void (*ag_gtk_find_cb)(void* context, int32_t active_match_index, int32_t total_matches);
+
+typedef struct {
+    ag_gtk_find_cb callback;
+    void* context;
+    gulong counted_id;
+    gulong failed_id;
+} find_ctx;
+
+static void on_counted_matches(WebKitFindController* controller, guint match_count, gpointer user_data)
+{
+    find_ctx* ctx = (find_ctx*)user_data;
+    /* We report match_count; active index isn't directly available in WebKitGTK find API.
+       Report 0 as active index when matches found. */
+    int32_t active = match_count > 0 ? 0 : -1;
+    if (ctx->counted_id) g_signal_handler_disconnect(controller, ctx->counted_id);
+    if (ctx->failed_id) g_signal_handler_disconnect(controller, ctx->failed_id);
+    ctx->callback(ctx->context, active, (int32_t)match_count);
+    free(ctx);
+}
+
+static void on_failed_to_find(WebKitFindController* controller, gpointer user_data)
+{
+    find_ctx* ctx = (find_ctx*)user_data;
+    if (ctx->counted_id) g_signal_handler_disconnect(controller, ctx->counted_id);
+    if (ctx->failed_id) g_signal_handler_disconnect(controller, ctx->failed_id);
+    ctx->callback(ctx->context, -1, 0);
+    free(ctx);
+}
+
+void ag_gtk_find_text(ag_gtk_handle handle, const char* text, int case_sensitive, int forward, ag_gtk_find_cb callback, void* context)
+{
+    if (!handle)
+    {
+        callback(context, -1, 0);
+        return;
+    }
+    shim_state* s = (shim_state*)handle;
+    if (s->web_view == NULL || atomic_load(&s->detached))
+    {
+        callback(context, -1, 0);
+        return;
+    }
+
+    WebKitFindController* fc = webkit_web_view_get_find_controller(s->web_view);
+
+    find_ctx* ctx = (find_ctx*)calloc(1, sizeof(find_ctx));
+    ctx->callback = callback;
+    ctx->context = context;
+
+    ctx->counted_id = g_signal_connect(fc, "counted-matches", G_CALLBACK(on_counted_matches), ctx);
+    ctx->failed_id = g_signal_connect(fc, "failed-to-find-text", G_CALLBACK(on_failed_to_find), ctx);
+
+    guint32 options = WEBKIT_FIND_OPTIONS_WRAP_AROUND;
+    if (!case_sensitive) options |= WEBKIT_FIND_OPTIONS_CASE_INSENSITIVE;
+    if (!forward) options |= WEBKIT_FIND_OPTIONS_BACKWARDS;
+
+    webkit_find_controller_search(fc, text, options, G_MAXUINT);
+    webkit_find_controller_count_matches(fc, text, options, G_MAXUINT);
+}
+
+void ag_gtk_stop_find(ag_gtk_handle handle)
+{
+    if (!handle) return;
+    shim_state* s = (shim_state*)handle;
+    if (s->web_view == NULL || atomic_load(&s->detached)) return;
+
+    WebKitFindController* fc = webkit_web_view_get_find_controller(s->web_view);
+    webkit_find_controller_search_finish(fc);
+}
+
+/* ========== Preload Scripts ========== */
+
+static atomic_int_fast64_t g_script_id_counter = 0;
+
+typedef struct
+{
+    shim_state* state;
+    const char* js;
+    char* id_out;
+} add_user_script_data;
+
+static void do_add_user_script(void* data)
+{
+    add_user_script_data* d = (add_user_script_data*)data;
+    shim_state* s = d->state;
+    if (s->content_manager == NULL || atomic_load(&s->detached)) return;
+
+    WebKitUserScript* script = webkit_user_script_new(
+        d->js,
+        WEBKIT_USER_CONTENT_INJECT_ALL_FRAMES,
+        WEBKIT_USER_SCRIPT_INJECT_AT_DOCUMENT_START,
+        NULL, NULL);
+    webkit_user_content_manager_add_script(s->content_manager, script);
+
+    int64_t id = atomic_fetch_add(&g_script_id_counter, 1) + 1;
+    char buf[32];
+    snprintf(buf, sizeof(buf), "preload_%lld", (long long)id);
+    g_hash_table_insert(s->user_scripts, g_strdup(buf), script); /* keeps the new() ref */
+    d->id_out = strdup(buf);
+}
+
+const char* ag_gtk_add_user_script(ag_gtk_handle handle, const char* js)
+{
+    if (!handle || !js) return NULL;
+    shim_state* s = (shim_state*)handle;
+    if (s->web_view == NULL || atomic_load(&s->detached)) return NULL;
+
+    add_user_script_data d = { s, js, NULL };
+    run_on_gtk_thread(do_add_user_script, &d);
+    return d.id_out;
+}
+
+typedef struct
+{
+    shim_state* state;
+    const char* id;
+    gboolean removed;
+} remove_user_script_data;
+
+static void do_remove_user_script(void* data)
+{
+    remove_user_script_data* d = (remove_user_script_data*)data;
+    shim_state* s = d->state;
+    WebKitUserScript* script = (WebKitUserScript*)g_hash_table_lookup(s->user_scripts, d->id);
+    if (script == NULL) return;
+
+    if (s->content_manager != NULL && !atomic_load(&s->detached))
+        webkit_user_content_manager_remove_script(s->content_manager, script);
+    g_hash_table_remove(s->user_scripts, d->id);
+    d->removed = TRUE;
+}
+
+/* Removes one script added with ag_gtk_add_user_script, leaving the others in place. */
+bool ag_gtk_remove_user_script(ag_gtk_handle handle, const char* script_id)
+{
+    if (!handle || !script_id) return false;
+    remove_user_script_data d = { (shim_state*)handle, script_id, FALSE };
+    run_on_gtk_thread(do_remove_user_script, &d);
+    return d.removed;
+}
+
+static void do_remove_all_user_scripts(void* data)
+{
+    shim_state* s = (shim_state*)data;
+    if (s->content_manager == NULL || atomic_load(&s->detached)) return;
+
+    webkit_user_content_manager_remove_all_scripts(s->content_manager);
+    g_hash_table_remove_all(s->user_scripts);
+
+    /* remove_all also drops scripts owned by shared content sets; restore them. */
+    attach_content_sets(s);
+}
+
+void ag_gtk_remove_all_user_scripts(ag_gtk_handle handle)
+{
+    if (!handle) return;
+    shim_state* s = (shim_state*)handle;
+    if (s->web_view == NULL || atomic_load(&s->detached)) return;
+    run_on_gtk_thread(do_remove_all_user_scripts, s);
+}
+
+/* ========== Shared content sets ========== */
+
+/* A named set of user scripts and style sheets created once and attached to any number of
+ * views' content managers. Redefining a set swaps its contents in every attached view within
+ * one GTK main-loop iteration, so a preload bundle can be hot-swapped without rebuilding views.
+ * The registry is guarded by g_content_sets_lock; content managers are touched on the GTK
+ * thread only. */
+
+#define AG_CONTENT_SET_TOP_FRAME_ONLY   0x1
+#define AG_CONTENT_SET_INJECT_AT_END    0x2
+
+typedef struct
+{
+    char* name;
+    GPtrArray* scripts;      /* WebKitUserScript*, owned */
+    GPtrArray* style_sheets; /* WebKitUserStyleSheet*, owned */
+    GPtrArray* views;        /* shim_state*, not owned */
+} content_set;
+
+static GMutex g_content_sets_lock;
+static GHashTable* g_content_sets = NULL; /* name -> content_set* */
+
+static void add_content_set_to_manager(content_set* set, WebKitUserContentManager* ucm)
+{
+    for (guint i = 0; i < set->scripts->len; i++)
+        webkit_user_content_manager_add_script(ucm, (WebKitUserScript*)g_ptr_array_index(set->scripts, i));
+    for (guint i = 0; i < set->style_sheets->len; i++)
+        webkit_user_content_manager_add_style_sheet(ucm, (WebKitUserStyleSheet*)g_ptr_array_index(set->style_sheets, i));
+}
+
+static void remove_content_items_from_manager(GPtrArray* scripts, GPtrArray* style_sheets, WebKitUserContentManager* ucm)
+{
+    for (guint i = 0; i < scripts->len; i++)
+        webkit_user_content_manager_remove_script(ucm, (WebKitUserScript*)g_ptr_array_index(scripts, i));
+    for (guint i = 0; i < style_sheets->len; i++)
+        webkit_user_content_manager_remove_style_sheet(ucm, (WebKitUserStyleSheet*)g_ptr_array_index(style_sheets, i));
+}
+
+static void attach_content_sets(shim_state* s)
+{
+    if (s->content_manager == NULL) return;
+    g_mutex_lock(&g_content_sets_lock);
+    for (guint i = 0; i < s->attached_content_sets->len; i++)
+        add_content_set_to_manager((content_set*)g_ptr_array_index(s->attached_content_sets, i), s->content_manager);
+    g_mutex_unlock(&g_content_sets_lock);
+}
+
+static void detach_content_sets(shim_state* s)
+{
+    g_mutex_lock(&g_content_sets_lock);
+    for (guint i = 0; i < s->attached_content_sets->len; i++)
+    {
+        content_set* set = (content_set*)g_ptr_array_index(s->attached_content_sets, i);
+        if (s->content_manager != NULL)
+            remove_content_items_from_manager(set->scripts, set->style_sheets, s->content_manager);
+        g_ptr_array_remove(set->views, s);
+    }
+    g_ptr_array_set_size(s->attached_content_sets, 0);
+    g_mutex_unlock(&g_content_sets_lock);
+}
+
+static content_set* content_set_new(const char* name)
+{
+    content_set* set = (content_set*)calloc(1, sizeof(content_set));
+    set->name = g_strdup(name);
+    set->scripts = g_ptr_array_new_with_free_func((GDestroyNotify)webkit_user_script_unref);
+    set->style_sheets = g_ptr_array_new_with_free_func((GDestroyNotify)webkit_user_style_sheet_unref);
+    set->views = g_ptr_array_new();
+    return set;
+}
+
+typedef struct
+{
+    const char* name;
+    GPtrArray* scripts;      /* in: the new contents; out: the replaced ones, for the caller to free */
+    GPtrArray* style_sheets;
+} content_set_define_data;
+
+/* Looks up (or creates) the set, swaps in the new contents and applies them to every attached
+ * view in the same step, so an attach or another define can never see the new arrays before
+ * the views have them. Caller holds g_content_sets_lock, on the GTK thread if the set has views. */
+static void content_set_replace_locked(content_set_define_data* d)
+{
+    if (g_content_sets == NULL)
+        g_content_sets = g_hash_table_new(g_str_hash, g_str_equal);
+    content_set* set = (content_set*)g_hash_table_lookup(g_content_sets, d->name);
+    if (set == NULL)
+    {
+        set = content_set_new(d->name);
+        g_hash_table_insert(g_content_sets, set->name, set);
+    }
+
+    GPtrArray* old_scripts = set->scripts;
+    GPtrArray* old_style_sheets = set->style_sheets;
+    set->scripts = d->scripts;
+    set->style_sheets = d->style_sheets;
+    for (guint i = 0; i < set->views->len; i++)
+    {
+        shim_state* s = (shim_state*)g_ptr_array_index(set->views, i);
+        if (s->content_manager == NULL || atomic_load(&s->detached))
+            continue;
+        remove_content_items_from_manager(old_scripts, old_style_sheets, s->content_manager);
+        add_content_set_to_manager(set, s->content_manager);
+    }
+    d->scripts = old_scripts;
+    d->style_sheets = old_style_sheets;
+}
+
+static void do_content_set_define(void* data)
+{
+    g_mutex_lock(&g_content_sets_lock);
+    content_set_replace_locked((content_set_define_data*)data);
+    g_mutex_unlock(&g_content_sets_lock);
+}
+
+/* Define or atomically replace the named set. Scripts run at document start (or end with
+ * AG_CONTENT_SET_INJECT_AT_END) in all frames (or the top frame only). */
+bool ag_gtk_content_set_define(const char* name,
+    const char* const* scripts, int32_t script_count,
+    const char* const* style_sheets, int32_t style_sheet_count,
+    uint32_t flags)
+{
+    if (!name) return false;
+
+    WebKitUserContentInjectedFrames frames = (flags & AG_CONTENT_SET_TOP_FRAME_ONLY) != 0
+        ? WEBKIT_USER_CONTENT_INJECT_TOP_FRAME
+        : WEBKIT_USER_CONTENT_INJECT_ALL_FRAMES;
+    WebKitUserScriptInjectionTime when = (flags & AG_CONTENT_SET_INJECT_AT_END) != 0
+        ? WEBKIT_USER_SCRIPT_INJECT_AT_DOCUMENT_END
+        : WEBKIT_USER_SCRIPT_INJECT_AT_DOCUMENT_START;
+
+    /* Build (and copy the sources of) the new objects once, outside the lock. */
+    GPtrArray* new_scripts = g_ptr_array_new_with_free_func((GDestroyNotify)webkit_user_script_unref);
+    for (int32_t i = 0; i < script_count; i++)
+    {
+        if (scripts[i] != NULL)
+            g_ptr_array_add(new_scripts, webkit_user_script_new(scripts[i], frames, when, NULL, NULL));
+    }
+    GPtrArray* new_style_sheets = g_ptr_array_new_with_free_func((GDestroyNotify)webkit_user_style_sheet_unref);
+    for (int32_t i = 0; i < style_sheet_count; i++)
+    {
+        if (style_sheets[i] != NULL)
+            g_ptr_array_add(new_style_sheets, webkit_user_style_sheet_new(style_sheets[i], frames,
+                WEBKIT_USER_STYLE_LEVEL_USER, NULL, NULL));
+    }
+
+    content_set_define_data d = { name, new_scripts, new_style_sheets };
+    g_mutex_lock(&g_content_sets_lock);
+    content_set* set = g_content_sets != NULL ? (content_set*)g_hash_table_lookup(g_content_sets, name) : NULL;
+    if (set == NULL || set->views->len == 0)
+    {
+        /* No content manager to update: replace in place. Attaches run on the GTK thread under
+         * this lock, so they see either the old or the new contents, never both. */
+        content_set_replace_locked(&d);
+        g_mutex_unlock(&g_content_sets_lock);
+    }
+    else
+    {
+        g_mutex_unlock(&g_content_sets_lock);
+        run_on_gtk_thread(do_content_set_define, &d);
+    }
+
+    g_ptr_array_unref(d.scripts);
+    g_ptr_array_unref(d.style_sheets);
+    return true;
+}
+
+typedef struct
+{
+    const char* name;
+    content_set* set; /* out: the set taken out of the registry, NULL if undefined */
+} content_set_destroy_data;
+
+/* Takes the set out of the registry and unlinks it from every view that attached it, including
+ * views not attached to a widget yet (no content manager), so no do_attach applies it later. */
+static void content_set_remove_locked(content_set_destroy_data* d)
+{
+    content_set* set = g_content_sets != NULL ? (content_set*)g_hash_table_lookup(g_content_sets, d->name) : NULL;
+    d->set = set;
+    if (set == NULL) return;
+
+    g_hash_table_remove(g_content_sets, d->name);
+    for (guint i = 0; i < set->views->len; i++)
+    {
+        shim_state* s = (shim_state*)g_ptr_array_index(set->views, i);
+        if (s->content_manager != NULL && !atomic_load(&s->detached))
+            remove_content_items_from_manager(set->scripts, set->style_sheets, s->content_manager);
+        g_ptr_array_remove(s->attached_content_sets, set);
+    }
+    g_ptr_array_set_size(set->views, 0);
+}
+
+static void do_content_set_destroy(void* data)
+{
+    g_mutex_lock(&g_content_sets_lock);
+    content_set_remove_locked((content_set_destroy_data*)data);
+    g_mutex_unlock(&g_content_sets_lock);
+}
+
+/* Removes the set from every attached view and frees it. */
+void ag_gtk_content_set_destroy(const char* name)
+{
+    if (!name) return;
+
+    content_set_destroy_data d = { name, NULL };
+    g_mutex_lock(&g_content_sets_lock);
+    content_set* set = g_content_sets != NULL ? (content_set*)g_hash_table_lookup(g_content_sets, name) : NULL;
+    if (set == NULL || set->views->len == 0)
+    {
+        content_set_remove_locked(&d);
+        g_mutex_unlock(&g_content_sets_lock);
+    }
+    else
+    {
+        g_mutex_unlock(&g_content_sets_lock);
+        run_on_gtk_thread(do_content_set_destroy, &d);
+    }
+
+    set = d.set;
+    if (set == NULL) return;
+    g_ptr_array_unref(set->scripts);
+    g_ptr_array_unref(set->style_sheets);
+    g_ptr_array_unref(set->views);
+    g_free(set->name);
+    free(set);
+}
+
+typedef struct
+{
+    shim_state* state;
+    const char* name;
+    gboolean attach;
+    gboolean result;
+} content_set_attach_data;
+
+static void do_content_set_attach(void* data)
+{
+    content_set_attach_data* d = (content_set_attach_data*)data;
+    shim_state* s = d->state;
+    if (atomic_load(&s->detached)) return;
+
+    g_mutex_lock(&g_content_sets_lock);
+    content_set* set = g_content_sets != NULL ? (content_set*)g_hash_table_lookup(g_content_sets, d->name) : NULL;
+    if (set != NULL)
+    {
+        gboolean attached = g_ptr_array_find(s->attached_content_sets, set, NULL);
+        if (d->attach && !attached)
+        {
+            g_ptr_array_add(s->attached_content_sets, set);
+            g_ptr_array_add(set->views, s);
+            if (s->content_manager != NULL)
+                add_content_set_to_manager(set, s->content_manager);
+        }
+        else if (!d->attach && attached)
+        {
+            if (s->content_manager != NULL)
+                remove_content_items_from_manager(set->scripts, set->style_sheets, s->content_manager);
+            g_ptr_array_remove(s->attached_content_sets, set);
+            g_ptr_array_remove(set->views, s);
+        }
+        d->result = TRUE;
+    }
+    g_mutex_unlock(&g_content_sets_lock);
+}
+
+/* Attach/detach a shared set to this view. Sets attached before ag_gtk_attach are applied
+ * when the content manager is created. Returns false if the set is not defined. */
+bool ag_gtk_content_set_attach(ag_gtk_handle handle, const char* name)
+{
+    if (!handle || !name) return false;
+    content_set_attach_data d = { (shim_state*)handle, name, TRUE, FALSE };
+    run_on_gtk_thread(do_content_set_attach, &d);
+    return d.result;
+}
+
+bool ag_gtk_content_set_detach(ag_gtk_handle handle, const char* name)
+{
+    if (!handle || !name) return false;
+    content_set_attach_data d = { (shim_state*)handle, name, FALSE, FALSE };
+    run_on_gtk_thread(do_content_set_attach, &d);
+    return d.result;
+}
+
+/* ========== Content filters ========== */
+
+/* Compiled content-blocker rule lists are applied natively by the web process, so they
+ * also cover subresources that never reach on_decide_policy. Stores are shared per
+ * storage path across all views; compiled filters persist on disk between runs. */
+
+static GHashTable* g_content_filter_stores = NULL; /* path -> WebKitUserContentFilterStore*, GTK thread only */
+
+static WebKitUserContentFilterStore* get_content_filter_store(shim_state* s)
+{
+    char* path = s->opt_content_filter_path != NULL
+        ? g_strdup(s->opt_content_filter_path)
+        : g_build_filename(g_get_user_cache_dir(), "agibuild-webview", "content-filters", NULL);
+
+    if (g_content_filter_stores == NULL)
+        g_content_filter_stores = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_object_unref);
+
+    WebKitUserContentFilterStore* store =
+        (WebKitUserContentFilterStore*)g_hash_table_lookup(g_content_filter_stores, path);
+    if (store == NULL)
+    {
+        store = webkit_user_content_filter_store_new(path);
+        g_hash_table_insert(g_content_filter_stores, path, store); /* takes path */
+        return store;
+    }
+
+    g_free(path);
+    return store;
+}
+
+static void attach_content_filters(shim_state* s)
+{
+    if (s->content_manager == NULL || s->content_filters == NULL)
+        return;
+    for (guint i = 0; i < s->content_filters->len; i++)
+    {
+        webkit_user_content_manager_add_filter(s->content_manager,
+            (WebKitUserContentFilter*)g_ptr_array_index(s->content_filters, i));
+    }
+}
+
+static void remove_content_filter_by_id(shim_state* s, const char* identifier)
+{
+    for (guint i = 0; i < s->content_filters->len; i++)
+    {
+        WebKitUserContentFilter* f = (WebKitUserContentFilter*)g_ptr_array_index(s->content_filters, i);
+        if (g_strcmp0(webkit_user_content_filter_get_identifier(f), identifier) == 0)
+        {
+            g_ptr_array_remove_index(s->content_filters, i);
+            break;
+        }
+    }
+    if (s->content_manager != NULL && !atomic_load(&s->detached))
+        webkit_user_content_manager_remove_filter_by_id(s->content_manager, identifier);
+}
+
+/* Held in an AG_GTK_OP_FILTER slot (payload.object). The store load/save carries the
+ * cancellable; whoever claims the slot first (completion or detach) reports, and a completion
+ * that loses only frees the context, so nothing touches the view once it is detached. */
+typedef struct
+{
+    op_slot* slot;
+    shim_state* state; /* valid only while the slot is live */
+    ag_gtk_content_filter_cb callback;
+    void* context;
+    char* identifier;
+    GBytes* source; /* NULL = load only */
+    GCancellable* cancellable;
+    gint64 started_us;
+    gboolean from_cache;
+} content_filter_ctx;
+
+static void content_filter_ctx_free(content_filter_ctx* ctx)
+{
+    if (ctx->source != NULL) g_bytes_unref(ctx->source);
+    g_object_unref(ctx->cancellable);
+    g_free(ctx->identifier);
+    free(ctx);
+}
+
+static void abort_content_filter(op_slot* slot)
+{
+    content_filter_ctx* ctx = (content_filter_ctx*)slot->payload.object;
+    g_cancellable_cancel(ctx->cancellable);
+    ctx->callback(ctx->context, false, false,
+        (int64_t)(g_get_monotonic_time() - ctx->started_us), "Detached");
+    /* The slot stays held until the store's callback runs and frees the context. */
+}
+
+/* Drops an operation the view's detach already answered. */
+static void content_filter_discard(content_filter_ctx* ctx)
+{
+    op_slot* slot = ctx->slot;
+    content_filter_ctx_free(ctx);
+    op_slot_release(slot);
+}
+
+static void content_filter_complete(content_filter_ctx* ctx, WebKitUserContentFilter* filter, GError* error)
+{
+    if (!op_slot_claim(ctx->slot))
+    {
+        if (filter != NULL) webkit_user_content_filter_unref(filter);
+        content_filter_discard(ctx);
+        return;
+    }
+
+    shim_state* s = ctx->state;
+    int64_t elapsed = (int64_t)(g_get_monotonic_time() - ctx->started_us);
+
+    if (filter == NULL)
+    {
+        ctx->callback(ctx->context, false, false, elapsed,
+            error != NULL ? error->message : "Content filter unavailable");
+    }
+    else
+    {
+        remove_content_filter_by_id(s, ctx->identifier);
+        g_ptr_array_add(s->content_filters, filter); /* takes the finish() reference */
+        if (s->content_manager != NULL && !atomic_load(&s->detached))
+            webkit_user_content_manager_add_filter(s->content_manager, filter);
+
+        ctx->callback(ctx->context, true, ctx->from_cache, elapsed, NULL);
+    }
+    content_filter_discard(ctx);
+}
+
+static void on_content_filter_saved(GObject* source, GAsyncResult* result, gpointer user_data)
+{
+    content_filter_ctx* ctx = (content_filter_ctx*)user_data;
+    GError* error = NULL;
+    WebKitUserContentFilter* filter = webkit_user_content_filter_store_save_finish(
+        WEBKIT_USER_CONTENT_FILTER_STORE(source), result, &error);
+
+    content_filter_complete(ctx, filter, error);
+    if (error) g_error_free(error);
+}
+
+static void on_content_filter_loaded(GObject* source, GAsyncResult* result, gpointer user_data)
+{
+    content_filter_ctx* ctx = (content_filter_ctx*)user_data;
+    GError* error = NULL;
+    WebKitUserContentFilter* filter = webkit_user_content_filter_store_load_finish(
+        WEBKIT_USER_CONTENT_FILTER_STORE(source), result, &error);
+
+    if (filter == NULL && ctx->source != NULL && !g_cancellable_is_cancelled(ctx->cancellable))
+    {
+        /* Cache miss: compile from source and persist for the next run. */
+        if (error) g_error_free(error);
+        ctx->from_cache = FALSE;
+        webkit_user_content_filter_store_save(WEBKIT_USER_CONTENT_FILTER_STORE(source),
+            ctx->identifier, ctx->source, ctx->cancellable, on_content_filter_saved, ctx);
+        return;
+    }
+
+    ctx->from_cache = TRUE;
+    content_filter_complete(ctx, filter, error);
+    if (error) g_error_free(error);
+}
+
+static void do_content_filter_load_or_compile(void* data)
+{
+    content_filter_ctx* ctx = (content_filter_ctx*)data;
+    ctx->started_us = g_get_monotonic_time();
+
+    /* Detached between acquire and here: abort_content_filter has already reported. */
+    if (atomic_load(&ctx->slot->live) == 0)
+    {
+        content_filter_discard(ctx);
+        return;
+    }
+
+    WebKitUserContentFilterStore* store = get_content_filter_store(ctx->state);
+    webkit_user_content_filter_store_load(store, ctx->identifier, ctx->cancellable, on_content_filter_loaded, ctx);
+}
+
+void ag_gtk_set_content_filter_store_path(ag_gtk_handle handle, const char* path_utf8_or_null)
+{
+    if (!handle) return;
+    shim_state* s = (shim_state*)handle;
+    free(s->opt_content_filter_path);
+    s->opt_content_filter_path = path_utf8_or_null ? strdup(path_utf8_or_null) : NULL;
+}
+
+/* Load the compiled filter `identifier` from the store; if it is missing and rules_json is
+ * non-NULL, compile it (webkit_user_content_filter_store_save) and persist it. The filter is
+ * attached to the view's content manager now (if attached) and on every later do_attach. */
+void ag_gtk_content_filter_load_or_compile(ag_gtk_handle handle, const char* identifier,
+    const char* rules_json_or_null, ag_gtk_content_filter_cb callback, void* context)
+{
+    if (!callback) return;
+    if (!handle || !identifier)
+    {
+        callback(context, false, false, 0, "Invalid arguments");
+        return;
+    }
+    shim_state* s = (shim_state*)handle;
+    if (atomic_load(&s->detached))
+    {
+        callback(context, false, false, 0, "Detached");
+        return;
+    }
+
+    op_slot* slot = op_slot_acquire(s->ops, AG_GTK_OP_FILTER, NULL);
+    if (slot == NULL)
+    {
+        callback(context, false, false, 0, "Too many outstanding operations");
+        return;
+    }
+
+    content_filter_ctx* ctx = (content_filter_ctx*)calloc(1, sizeof(content_filter_ctx));
+    ctx->slot = slot;
+    ctx->state = s;
+    ctx->callback = callback;
+    ctx->context = context;
+    ctx->identifier = g_strdup(identifier);
+    ctx->source = rules_json_or_null != NULL
+        ? g_bytes_new(rules_json_or_null, strlen(rules_json_or_null))
+        : NULL;
+    ctx->cancellable = g_cancellable_new();
+    ctx->started_us = g_get_monotonic_time();
+    slot->payload.object = ctx;
+    slot->abort = abort_content_filter; /* set last: detach may run abort from now on */
+
+    run_on_gtk_thread(do_content_filter_load_or_compile, ctx);
+}
+
+typedef struct
+{
+    shim_state* state;
+    const char* identifier;
+} content_filter_remove_data;
+
+static void do_content_filter_remove(void* data)
+{
+    content_filter_remove_data* rd = (content_filter_remove_data*)data;
+    remove_content_filter_by_id(rd->state, rd->identifier);
+}
+
+void ag_gtk_content_filter_remove(ag_gtk_handle handle, const char* identifier)
+{
+    if (!handle || !identifier) return;
+    content_filter_remove_data rd = { (shim_state*)handle, identifier };
+    run_on_gtk_thread(do_content_filter_remove, &rd);
+}
+
+/* ========== Drag-motion coalescing ========== */
+
+typedef struct
+{
+    shim_state* state;
+    int interval_ms;
+} drag_motion_interval_data;
+
+static void do_set_drag_motion_interval(void* data)
+{
+    drag_motion_interval_data* d = (drag_motion_interval_data*)data;
+    d->state->opt_drag_motion_interval_ms = d->interval_ms;
+}
+
+/* 0 = coalesce to one drag update per frame (default); > 0 = at most one per interval. */
+void ag_gtk_set_drag_motion_interval(ag_gtk_handle handle, int interval_ms)
+{
+    if (!handle) return;
+    drag_motion_interval_data d = { (shim_state*)handle, interval_ms > 0 ? interval_ms : 0 };
+    run_on_gtk_thread(do_set_drag_motion_interval, &d);
+}
+
+void ag_gtk_get_drag_motion_stats(ag_gtk_handle handle, uint64_t* out_delivered, uint64_t* out_suppressed)
+{
+    if (!handle) return;
+    shim_state* s = (shim_state*)handle;
+    if (out_delivered) *out_delivered = atomic_load(&s->drag_motion_delivered);
+    if (out_suppressed) *out_suppressed = atomic_load(&s->drag_motion_suppressed);
+}
+
+/* ========== Website data ========== */
+
+/* Contexts keyed by "data_dir\ncache_dir". WebKit allows a single data manager per directory
+ * pair, so views configured with the same directories share a context; contexts live for the
+ * process lifetime. GTK thread only. */
+static GHashTable* g_data_dir_contexts = NULL;
+
+static WebKitWebContext* get_data_dir_context(const char* data_dir, const char* cache_dir)
+{
+    if (g_data_dir_contexts == NULL)
+        g_data_dir_contexts = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_object_unref);
+
+    char* key = g_strdup_printf("%s\n%s", data_dir ? data_dir : "", cache_dir ? cache_dir : "");
+    WebKitWebContext* ctx = (WebKitWebContext*)g_hash_table_lookup(g_data_dir_contexts, key);
+    if (ctx != NULL)
+    {
+        g_free(key);
+        return ctx;
+    }
+
+    WebKitWebsiteDataManager* dm = webkit_website_data_manager_new(
+        "base-data-directory", data_dir,
+        "base-cache-directory", cache_dir,
+        NULL);
+    ctx = webkit_web_context_new_with_website_data_manager(dm);
+    g_object_unref(dm);
+    g_hash_table_insert(g_data_dir_contexts, key, ctx);
+    return ctx;
+}
+
+/* Base directories for persistent website data (IndexedDB, local storage, service workers,
+ * cookies) and caches (HTTP disk cache, DOM cache). Must be set before ag_gtk_attach. */
+void ag_gtk_set_data_directories(ag_gtk_handle handle, const char* data_dir_or_null, const char* cache_dir_or_null)
+{
+    if (!handle) return;
+    shim_state* s = (shim_state*)handle;
+    free(s->opt_data_dir);
+    free(s->opt_cache_dir);
+    s->opt_data_dir = data_dir_or_null ? strdup(data_dir_or_null) : NULL;
+    s->opt_cache_dir = cache_dir_or_null ? strdup(cache_dir_or_null) : NULL;
+}
+
+/* WebKitCacheModel to apply to the view's context at attach, or -1 for the default. */
+void ag_gtk_set_cache_model(ag_gtk_handle handle, int cache_model)
+{
+    if (!handle) return;
+    ((shim_state*)handle)->opt_cache_model = cache_model;
+}
+
+typedef struct
+{
+    WebKitWebsiteDataManager* data_manager; /* ref */
+    WebKitWebsiteDataTypes types;
+    char** names;                           /* NULL-terminated, NULL = all origins (remove only) */
+    ag_gtk_website_data_fetch_cb fetch_callback;
+    ag_gtk_cookie_op_cb op_callback;
+    void* context;
+} website_data_op;
+
+static void website_data_op_free(website_data_op* op)
+{
+    g_object_unref(op->data_manager);
+    g_strfreev(op->names);
+    free(op);
+}
+
+static void website_data_op_fail(website_data_op* op, const char* message)
+{
+    if (op->fetch_callback != NULL)
+        op->fetch_callback(op->context, false, 0, NULL, message);
+    else
+        op->op_callback(op->context, false, message);
+}
+
+static void on_website_data_fetched(GObject* source, GAsyncResult* result, gpointer user_data)
+{
+    website_data_op* op = (website_data_op*)user_data;
+    GError* error = NULL;
+    GList* list = webkit_website_data_manager_fetch_finish(WEBKIT_WEBSITE_DATA_MANAGER(source), result, &error);
+    if (error != NULL)
+    {
+        website_data_op_fail(op, error->message);
+        g_error_free(error);
+        website_data_op_free(op);
+        return;
+    }
+
+    guint count = g_list_length(list);
+    ag_gtk_website_data_entry* entries = (ag_gtk_website_data_entry*)g_malloc0_n(count > 0 ? count : 1, sizeof(ag_gtk_website_data_entry));
+    guint i = 0;
+    for (GList* l = list; l != NULL; l = l->next, i++)
+    {
+        WebKitWebsiteData* data = (WebKitWebsiteData*)l->data;
+        WebKitWebsiteDataTypes types = webkit_website_data_get_types(data);
+        entries[i].name = webkit_website_data_get_name(data);
+        entries[i].types = (uint32_t)types;
+        for (int bit = 0; bit < AG_GTK_WEBSITE_DATA_TYPE_SLOTS; bit++)
+        {
+            WebKitWebsiteDataTypes type = (WebKitWebsiteDataTypes)(1u << bit);
+            if ((types & type) != 0)
+                entries[i].sizes[bit] = webkit_website_data_get_size(data, type);
+        }
+    }
+
+    op->fetch_callback(op->context, true, (int32_t)count, entries, NULL);
+
+    g_free(entries);
+    g_list_free_full(list, (GDestroyNotify)webkit_website_data_unref);
+    website_data_op_free(op);
+}
+
+static void on_website_data_removed(GObject* source, GAsyncResult* result, gpointer user_data)
+{
+    website_data_op* op = (website_data_op*)user_data;
+    GError* error = NULL;
+    webkit_website_data_manager_remove_finish(WEBKIT_WEBSITE_DATA_MANAGER(source), result, &error);
+    if (error != NULL)
+    {
+        op->op_callback(op->context, false, error->message);
+        g_error_free(error);
+    }
+    else
+    {
+        op->op_callback(op->context, true, NULL);
+    }
+    website_data_op_free(op);
+}
+
+static void on_website_data_cleared(GObject* source, GAsyncResult* result, gpointer user_data)
+{
+    website_data_op* op = (website_data_op*)user_data;
+    GError* error = NULL;
+    webkit_website_data_manager_clear_finish(WEBKIT_WEBSITE_DATA_MANAGER(source), result, &error);
+    if (error != NULL)
+    {
+        op->op_callback(op->context, false, error->message);
+        g_error_free(error);
+    }
+    else
+    {
+        op->op_callback(op->context, true, NULL);
+    }
+    website_data_op_free(op);
+}
+
+/* Removal needs the WebKitWebsiteData records, so fetch first and remove the matching origins. */
+static void on_website_data_fetched_for_remove(GObject* source, GAsyncResult* result, gpointer user_data)
+{
+    website_data_op* op = (website_data_op*)user_data;
+    GError* error = NULL;
+    GList* list = webkit_website_data_manager_fetch_finish(WEBKIT_WEBSITE_DATA_MANAGER(source), result, &error);
+    if (error != NULL)
+    {
+        op->op_callback(op->context, false, error->message);
+        g_error_free(error);
+        website_data_op_free(op);
+        return;
+    }
+
+    GList* matches = NULL;
+    for (GList* l = list; l != NULL; l = l->next)
+    {
+        WebKitWebsiteData* data = (WebKitWebsiteData*)l->data;
+        if (g_strv_contains((const gchar* const*)op->names, webkit_website_data_get_name(data)))
+            matches = g_list_prepend(matches, data);
+    }
+
+    if (matches == NULL)
+        op->op_callback(op->context, true, NULL);
+    else
+        webkit_website_data_manager_remove(op->data_manager, op->types, matches, NULL, on_website_data_removed, op);
+
+    g_list_free(matches);
+    g_list_free_full(list, (GDestroyNotify)webkit_website_data_unref);
+    if (matches == NULL)
+        website_data_op_free(op);
+}
+
+typedef struct
+{
+    shim_state* state;
+    website_data_op* op;
+    gboolean remove;
+} website_data_start;
+
+static void do_website_data_start(void* data)
+{
+    website_data_start* d = (website_data_start*)data;
+    shim_state* s = d->state;
+    website_data_op* op = d->op;
+    if (atomic_load(&s->detached) || s->data_manager == NULL)
+    {
+        website_data_op_fail(op, "Detached");
+        website_data_op_free(op);
+        return;
+    }
+
+    op->data_manager = g_object_ref(s->data_manager);
+    if (!d->remove)
+        webkit_website_data_manager_fetch(op->data_manager, op->types, NULL, on_website_data_fetched, op);
+    else if (op->names == NULL)
+        webkit_website_data_manager_clear(op->data_manager, op->types, 0, NULL, on_website_data_cleared, op);
+    else
+        webkit_website_data_manager_fetch(op->data_manager, op->types, NULL, on_website_data_fetched_for_remove, op);
+}
+
+/* Fetches usage for the given WebKitWebsiteDataTypes, one entry per origin. The entries and
+ * their names are valid only for the duration of the callback. */
+void ag_gtk_website_data_fetch(ag_gtk_handle handle, uint32_t types,
+    ag_gtk_website_data_fetch_cb callback, void* context)
+{
+    if (!handle || !callback) return;
+    website_data_op* op = (website_data_op*)calloc(1, sizeof(website_data_op));
+    op->types = (WebKitWebsiteDataTypes)types;
+    op->fetch_callback = callback;
+    op->context = context;
+
+    website_data_start d = { (shim_state*)handle, op, FALSE };
+    run_on_gtk_thread(do_website_data_start, &d);
+}
+
+/* Removes the given data types for the listed origins (as reported by ag_gtk_website_data_fetch),
+ * or for every origin when origin_count is 0. */
+void ag_gtk_website_data_remove(ag_gtk_handle handle, uint32_t types,
+    const char* const* origins, int32_t origin_count,
+    ag_gtk_cookie_op_cb callback, void* context)
+{
+    if (!handle || !callback) return;
+    website_data_op* op = (website_data_op*)calloc(1, sizeof(website_data_op));
+    op->types = (WebKitWebsiteDataTypes)types;
+    op->op_callback = callback;
+    op->context = context;
+    if (origins != NULL && origin_count > 0)
+    {
+        op->names = g_new0(char*, origin_count + 1);
+        for (int32_t i = 0; i < origin_count; i++)
+            op->names[i] = g_strdup(origins[i] ? origins[i] : "");
+    }
+
+    website_data_start d = { (shim_state*)handle, op, TRUE };
+    run_on_gtk_thread(do_website_data_start, &d);
+}
+
+/* ========== DNS prefetch and preloading ========== */
+
+/* Preloaded URLs count as hits only within this window; later the cached responses are likely
+ * stale or evicted. At most AG_PRELOAD_MAX_READY completed URLs are remembered per view. */
+#define AG_PRELOAD_TTL_US       (5 * 60 * G_USEC_PER_SEC)
+#define AG_PRELOAD_MAX_READY    16
+#define AG_PRELOAD_MAX_QUEUED   8
+
+typedef struct
+{
+    shim_state* state;
+    const char* hostname;
+} prefetch_dns_data;
+
+static void do_prefetch_dns(void* data)
+{
+    prefetch_dns_data* d = (prefetch_dns_data*)data;
+    shim_state* s = d->state;
+    if (atomic_load(&s->detached) || s->web_view == NULL) return;
+    webkit_web_context_prefetch_dns(webkit_web_view_get_context(s->web_view), d->hostname);
+}
+
+/* Resolves hostname ahead of the first request to it. */
+void ag_gtk_prefetch_dns(ag_gtk_handle handle, const char* hostname_utf8)
+{
+    if (!handle || !hostname_utf8 || hostname_utf8[0] == '\0') return;
+    prefetch_dns_data d = { (shim_state*)handle, hostname_utf8 };
+    run_on_gtk_thread(do_prefetch_dns, &d);
+}
+
+static void start_next_preload(shim_state* s);
+
+/* Preloading warms the HTTP cache and connection pool, so only http(s) URLs are loaded. */
+static gboolean is_preloadable_url(const char* url)
+{
+    return url != NULL
+        && (g_ascii_strncasecmp(url, "http://", 7) == 0 || g_ascii_strncasecmp(url, "https://", 8) == 0);
+}
+
+/* The hidden view never reaches the host's navigation policy (it would raise navigation events
+ * for pages the user never opened), so it gets a fixed one: no new windows, http(s) only, and a
+ * main frame that stays on the host of the URL being preloaded unless the server redirects it.
+ * Custom-scheme subresources are refused in on_custom_scheme_request. */
+static gboolean on_preload_decide_policy(WebKitWebView* web_view, WebKitPolicyDecision* decision,
+                                         WebKitPolicyDecisionType type, gpointer user_data)
+{
+    (void)web_view;
+    shim_state* s = (shim_state*)user_data;
+
+    if (type == WEBKIT_POLICY_DECISION_TYPE_NEW_WINDOW_ACTION)
+    {
+        webkit_policy_decision_ignore(decision);
+        return TRUE;
+    }
+    if (type != WEBKIT_POLICY_DECISION_TYPE_NAVIGATION_ACTION)
+        return FALSE;
+
+    WebKitNavigationPolicyDecision* nav_decision = WEBKIT_NAVIGATION_POLICY_DECISION(decision);
+    WebKitNavigationAction* action = webkit_navigation_policy_decision_get_navigation_action(nav_decision);
+    const char* url = webkit_uri_request_get_uri(webkit_navigation_action_get_request(action));
+
+    /* The decision type is what separates the view's own navigations from window opens (refused
+     * above); the frame name only names the target of a new window, so it cannot. Every
+     * navigation the hidden view starts itself must stay on the preloaded host. */
+    gboolean allowed = !atomic_load(&s->detached) && is_preloadable_url(url);
+    if (allowed && !webkit_navigation_action_is_redirect(action))
+    {
+        char* host = ag_extract_host_from_uri_string(url);
+        g_mutex_lock(&s->preload_lock);
+        char* current_host = ag_extract_host_from_uri_string(s->preload_current);
+        g_mutex_unlock(&s->preload_lock);
+        allowed = host != NULL && current_host != NULL && g_ascii_strcasecmp(host, current_host) == 0;
+        g_free(host);
+        g_free(current_host);
+    }
+
+    if (allowed)
+        webkit_policy_decision_use(decision);
+    else
+        webkit_policy_decision_ignore(decision);
+    return TRUE;
+}
+
+static void on_preload_load_changed(WebKitWebView* web_view, WebKitLoadEvent event, gpointer user_data)
+{
+    (void)web_view;
+    if (event != WEBKIT_LOAD_FINISHED) return;
+    shim_state* s = (shim_state*)user_data;
+
+    g_mutex_lock(&s->preload_lock);
+    if (s->preload_current != NULL)
+    {
+        if (g_hash_table_size(s->preload_ready) >= AG_PRELOAD_MAX_READY)
+        {
+            /* Drop the oldest ready entry; it was never navigated to. */
+            GHashTableIter iter;
+            gpointer key, value, oldest_key = NULL;
+            gint64 oldest = G_MAXINT64;
+            g_hash_table_iter_init(&iter, s->preload_ready);
+            while (g_hash_table_iter_next(&iter, &key, &value))
+            {
+                if ((gint64)(intptr_t)value < oldest)
+                {
+                    oldest = (gint64)(intptr_t)value;
+                    oldest_key = key;
+                }
+            }
+            if (oldest_key != NULL)
+            {
+                g_hash_table_remove(s->preload_ready, oldest_key);
+                s->preload_wasted++;
+            }
         }
+        g_hash_table_replace(s->preload_ready, s->preload_current, (gpointer)(intptr_t)g_get_monotonic_time());
+        s->preload_current = NULL;
     }
+    g_mutex_unlock(&s->preload_lock);
 
-    /* Get origin from the main resource URI */
-    const char* uri = webkit_web_view_get_uri(web_view);
-    int state = 0; /* Default */
-    s->callbacks.on_permission(s->user_data, kind, uri ? uri : "", &state);
+    start_next_preload(s);
+}
 
-    if (state == 1) /* Allow */
+static void on_preload_load_failed(WebKitWebView* web_view, WebKitLoadEvent event,
+    const char* failing_uri, GError* error, gpointer user_data)
+{
+    (void)web_view; (void)event; (void)failing_uri; (void)error;
+    shim_state* s = (shim_state*)user_data;
+
+    /* load-changed FINISHED follows load-failed; drop the URL so it is not recorded as ready. */
+    g_mutex_lock(&s->preload_lock);
+    g_free(s->preload_current);
+    s->preload_current = NULL;
+    g_mutex_unlock(&s->preload_lock);
+}
+
+static void start_next_preload(shim_state* s)
+{
+    if (atomic_load(&s->detached) || s->web_view == NULL) return;
+
+    g_mutex_lock(&s->preload_lock);
+    char* url = NULL;
+    if (s->preload_current == NULL)
     {
-        webkit_permission_request_allow(request);
-        return TRUE;
+        url = (char*)g_queue_pop_head(s->preload_queue);
+        s->preload_current = url;
     }
-    else if (state == 2) /* Deny */
+    g_mutex_unlock(&s->preload_lock);
+    if (url == NULL) return;
+
+    if (s->preload_view == NULL)
     {
-        webkit_permission_request_deny(request);
-        return TRUE;
+        /* Same context as the visible view (shared network process, HTTP cache and custom
+         * schemes) but its own content manager, so preloaded pages never reach the bridge. */
+        WebKitUserContentManager* ucm = webkit_user_content_manager_new();
+        s->preload_view = WEBKIT_WEB_VIEW(g_object_new(WEBKIT_TYPE_WEB_VIEW,
+            "web-context", webkit_web_view_get_context(s->web_view),
+            "user-content-manager", ucm,
+            NULL));
+        g_object_unref(ucm);
+        g_object_ref_sink(s->preload_view);
+        g_object_set_data(G_OBJECT(s->preload_view), AG_SHIM_STATE_KEY, s);
+        webkit_settings_set_media_playback_requires_user_gesture(webkit_web_view_get_settings(s->preload_view), TRUE);
+        webkit_web_view_set_is_muted(s->preload_view, TRUE);
+        g_signal_connect(s->preload_view, "decide-policy", G_CALLBACK(on_preload_decide_policy), s);
+        g_signal_connect(s->preload_view, "load-changed", G_CALLBACK(on_preload_load_changed), s);
+        g_signal_connect(s->preload_view, "load-failed", G_CALLBACK(on_preload_load_failed), s);
     }
 
-    return FALSE; /* Let WebKitGTK handle default behavior */
+    webkit_web_view_load_uri(s->preload_view, url);
 }
 
-/* ========== Context menu signal handler ========== */
-
-static gboolean on_context_menu(WebKitWebView* web_view, WebKitContextMenu* context_menu,
-                                GdkEvent* event, WebKitHitTestResult* hit_test_result,
-                                gpointer user_data)
+static void destroy_preload_view(shim_state* s)
 {
-    shim_state* s = (shim_state*)user_data;
-    if (atomic_load(&s->detached)) return FALSE;
-    if (s->callbacks.on_context_menu == NULL) return FALSE;
+    if (s->preload_view == NULL) return;
+    g_signal_handlers_disconnect_by_data(s->preload_view, s);
+    g_object_set_data(G_OBJECT(s->preload_view), AG_SHIM_STATE_KEY, NULL);
+    webkit_web_view_stop_loading(s->preload_view);
+    gtk_widget_destroy(GTK_WIDGET(s->preload_view));
+    g_object_unref(s->preload_view);
+    s->preload_view = NULL;
+
+    g_mutex_lock(&s->preload_lock);
+    g_queue_clear_full(s->preload_queue, g_free);
+    g_free(s->preload_current);
+    s->preload_current = NULL;
+    g_mutex_unlock(&s->preload_lock);
+}
 
-    double x = 0, y = 0;
-    if (event != NULL && event->type == GDK_BUTTON_PRESS)
+/* Called on every ag_gtk_navigate: a ready, fresh preload of the same URL is a hit. Navigations
+ * are only counted once the view has been asked to preload something. */
+static void note_navigation_for_preload(shim_state* s, const char* url)
+{
+    g_mutex_lock(&s->preload_lock);
+    if (s->preload_used)
     {
-        x = ((GdkEventButton*)event)->x;
-        y = ((GdkEventButton*)event)->y;
+        gpointer value;
+        if (g_hash_table_lookup_extended(s->preload_ready, url, NULL, &value)
+            && g_get_monotonic_time() - (gint64)(intptr_t)value <= AG_PRELOAD_TTL_US)
+            s->preload_hits++;
+        else
+            s->preload_misses++;
+        g_hash_table_remove(s->preload_ready, url);
     }
+    g_mutex_unlock(&s->preload_lock);
+}
 
-    const char* link_uri = NULL;
-    const char* media_uri = NULL;
-    bool is_editable = false;
-    int media_type = 0;
+typedef struct
+{
+    shim_state* state;
+} preload_start_data;
 
-    if (hit_test_result != NULL)
-    {
-        if (webkit_hit_test_result_context_is_link(hit_test_result))
-            link_uri = webkit_hit_test_result_get_link_uri(hit_test_result);
+static void do_preload_start(void* data)
+{
+    start_next_preload(((preload_start_data*)data)->state);
+}
 
-        is_editable = webkit_hit_test_result_context_is_editable(hit_test_result);
+/* Queues likely next URLs for loading in a hidden view on the same context. A later
+ * ag_gtk_navigate to one of them is served from the warmed HTTP cache and connection pool.
+ * Replaces any URLs still waiting in the queue. */
+void ag_gtk_preload_urls(ag_gtk_handle handle, const char* const* urls, int32_t count)
+{
+    if (!handle || !urls) return;
+    shim_state* s = (shim_state*)handle;
+    if (atomic_load(&s->detached) || s->web_view == NULL) return;
 
-        if (webkit_hit_test_result_context_is_image(hit_test_result))
-        {
-            media_type = 1;
-            media_uri = webkit_hit_test_result_get_image_uri(hit_test_result);
-        }
-        else if (webkit_hit_test_result_context_is_media(hit_test_result))
-        {
-            media_type = 2; /* Video — WebKitGTK doesn't distinguish video/audio */
-            media_uri = webkit_hit_test_result_get_media_uri(hit_test_result);
-        }
+    g_mutex_lock(&s->preload_lock);
+    s->preload_used = TRUE;
+    g_queue_clear_full(s->preload_queue, g_free);
+    for (int32_t i = 0; i < count && (int32_t)g_queue_get_length(s->preload_queue) < AG_PRELOAD_MAX_QUEUED; i++)
+    {
+        if (urls[i] == NULL) continue;
+        if (g_hash_table_contains(s->preload_ready, urls[i])) continue;
+        if (!is_preloadable_url(urls[i])) continue;
+        if (s->preload_current != NULL && strcmp(s->preload_current, urls[i]) == 0) continue;
+        g_queue_push_tail(s->preload_queue, g_strdup(urls[i]));
     }
+    g_mutex_unlock(&s->preload_lock);
 
-    /* Selection text requires evaluating JS; WebKitGTK doesn't expose it via hit-test.
-       Pass NULL and let the managed side handle it if needed. */
-    bool handled = s->callbacks.on_context_menu(
-        s->user_data, x, y, link_uri, NULL, media_type, media_uri, is_editable);
+    preload_start_data d = { s };
+    run_on_gtk_thread(do_preload_start, &d);
+}
 
-    return handled ? TRUE : FALSE;
+/* Cumulative counts: navigations served by a preload, navigations with no usable preload, and
+ * preloads evicted before use. */
+void ag_gtk_get_preload_stats(ag_gtk_handle handle, uint64_t* hits, uint64_t* misses, uint64_t* wasted)
+{
+    if (!handle) return;
+    shim_state* s = (shim_state*)handle;
+    g_mutex_lock(&s->preload_lock);
+    if (hits) *hits = s->preload_hits;
+    if (misses) *misses = s->preload_misses;
+    if (wasted) *wasted = s->preload_wasted;
+    g_mutex_unlock(&s->preload_lock);
 }
 
-/* ========== Drag-drop signal handlers ========== */
+/* ========== JavaScript JIT ========== */
 
-static gboolean on_drag_motion(GtkWidget* widget, GdkDragContext* context,
-    gint x, gint y, guint time, gpointer user_data)
+/* JIT is a JavaScriptCore process option read from JSC_useJIT when a web process starts, not a
+ * WebKitSettings property, so it is one setting for the whole process. It can only be changed
+ * before the first view is created: after that GTK and WebKit threads may read the environment,
+ * and setenv would race with them. The value in effect is captured once at that point. */
+
+static atomic_bool g_process_options_frozen;
+static atomic_int g_javascript_jit = -1; /* captured at the first ag_gtk_create */
+
+static int javascript_jit_from_env(void)
 {
-    (void)widget;
-    (void)time;
-    shim_state* s = (shim_state*)user_data;
-    if (atomic_load(&s->detached)) return FALSE;
+    const char* jit = g_getenv("JSC_useJIT");
+    return jit == NULL || (strcmp(jit, "0") != 0 && g_ascii_strcasecmp(jit, "false") != 0) ? 1 : 0;
+}
 
-    if (!s->drag_inside)
-    {
-        s->drag_inside = TRUE;
-        if (s->callbacks.on_drag_entered)
-            s->callbacks.on_drag_entered(s->user_data, "[]", NULL, (double)x, (double)y);
-    }
-    else if (s->callbacks.on_drag_updated)
-    {
-        s->callbacks.on_drag_updated(s->user_data, (double)x, (double)y);
-    }
+/* Called by ag_gtk_create before anything touches GTK or WebKit. */
+static void freeze_process_options(void)
+{
+    if (atomic_exchange(&g_process_options_frozen, TRUE))
+        return;
+    atomic_store(&g_javascript_jit, javascript_jit_from_env());
+}
 
-    gdk_drag_status(context, GDK_ACTION_COPY, time);
-    return TRUE;
+/* Enables or disables the JavaScript JIT for every web process. Returns false once a view has
+ * been created; call it first, from the thread that creates views. */
+bool ag_gtk_set_javascript_jit(bool enabled)
+{
+    if (atomic_load(&g_process_options_frozen))
+        return false;
+    g_setenv("JSC_useJIT", enabled ? "1" : "0", TRUE);
+    return true;
 }
 
-static void on_drag_leave(GtkWidget* widget, GdkDragContext* context,
-    guint time, gpointer user_data)
+bool ag_gtk_get_javascript_jit(void)
 {
-    (void)widget;
-    (void)context;
-    (void)time;
-    shim_state* s = (shim_state*)user_data;
-    if (atomic_load(&s->detached)) return;
+    int jit = atomic_load(&g_javascript_jit);
+    return (jit >= 0 ? jit : javascript_jit_from_env()) != 0;
+}
 
-    s->drag_inside = FALSE;
-    if (s->callbacks.on_drag_exited)
-        s->callbacks.on_drag_exited(s->user_data);
+/* ========== Performance profile ========== */
+
+static void apply_performance_profile(shim_state* s, WebKitSettings* settings)
+{
+    const ag_gtk_performance_profile* p = &s->opt_profile;
+
+    if (p->hardware_acceleration_policy >= 0)
+        webkit_settings_set_hardware_acceleration_policy(settings,
+            (WebKitHardwareAccelerationPolicy)p->hardware_acceleration_policy);
+    if (p->enable_page_cache >= 0)
+        webkit_settings_set_enable_page_cache(settings, p->enable_page_cache != 0);
+    if (p->enable_smooth_scrolling >= 0)
+        webkit_settings_set_enable_smooth_scrolling(settings, p->enable_smooth_scrolling != 0);
+    if (p->enable_mediasource >= 0)
+        webkit_settings_set_enable_mediasource(settings, p->enable_mediasource != 0);
+    if (p->enable_webgl >= 0)
+        webkit_settings_set_enable_webgl(settings, p->enable_webgl != 0);
+    if (p->enable_write_console_messages_to_stdout >= 0)
+        webkit_settings_set_enable_write_console_messages_to_stdout(settings,
+            p->enable_write_console_messages_to_stdout != 0);
 }
 
-static void on_drag_data_received(GtkWidget* widget, GdkDragContext* context,
-    gint x, gint y, GtkSelectionData* data, guint info, guint time, gpointer user_data)
+typedef struct
 {
-    (void)widget;
-    shim_state* s = (shim_state*)user_data;
-    if (atomic_load(&s->detached))
+    shim_state* state;
+    ag_gtk_performance_profile* profile;
+} performance_profile_data;
+
+static void do_set_performance_profile(void* data)
+{
+    performance_profile_data* d = (performance_profile_data*)data;
+    shim_state* s = d->state;
+    s->opt_profile = *d->profile;
+    if (s->web_view != NULL && !atomic_load(&s->detached))
+        apply_performance_profile(s, webkit_web_view_get_settings(s->web_view));
+}
+
+/* Stores the profile for attach, and applies it to the live view when already attached.
+ * Fields left at -1 keep their current value. */
+void ag_gtk_set_performance_profile(ag_gtk_handle handle, const ag_gtk_performance_profile* profile)
+{
+    if (!handle || !profile) return;
+    shim_state* s = (shim_state*)handle;
+    ag_gtk_performance_profile copy = *profile;
+    if (s->web_view == NULL)
     {
-        gtk_drag_finish(context, FALSE, FALSE, time);
+        /* Not attached yet: nothing runs on the GTK thread for this view. */
+        s->opt_profile = copy;
         return;
     }
+    performance_profile_data d = { s, &copy };
+    run_on_gtk_thread(do_set_performance_profile, &d);
+}
 
-    s->drag_inside = FALSE;
-
-    const char* text = NULL;
-    const char* files_json = "[]";
-    char* files_buf = NULL;
+static void do_get_effective_settings(void* data)
+{
+    performance_profile_data* d = (performance_profile_data*)data;
+    shim_state* s = d->state;
+    ag_gtk_performance_profile* out = d->profile;
+    *out = s->opt_profile;
+    if (s->web_view == NULL || atomic_load(&s->detached)) return;
 
-    if (info == 0) /* text/uri-list */
-    {
-        gchar** uris = gtk_selection_data_get_uris(data);
-        if (uris)
-        {
-            size_t buf_size = 1024;
-            files_buf = (char*)malloc(buf_size);
-            strcpy(files_buf, "[");
+    WebKitSettings* settings = webkit_web_view_get_settings(s->web_view);
+    out->hardware_acceleration_policy = (int32_t)webkit_settings_get_hardware_acceleration_policy(settings);
+    out->enable_page_cache = webkit_settings_get_enable_page_cache(settings) ? 1 : 0;
+    out->enable_smooth_scrolling = webkit_settings_get_enable_smooth_scrolling(settings) ? 1 : 0;
+    out->enable_mediasource = webkit_settings_get_enable_mediasource(settings) ? 1 : 0;
+    out->enable_webgl = webkit_settings_get_enable_webgl(settings) ? 1 : 0;
+    out->enable_write_console_messages_to_stdout =
+        webkit_settings_get_enable_write_console_messages_to_stdout(settings) ? 1 : 0;
+}
 
-            for (int i = 0; uris[i]; i++)
-            {
-                gchar* path = g_filename_from_uri(uris[i], NULL, NULL);
-                if (path)
-                {
-                    char entry[512];
-                    snprintf(entry, sizeof(entry),
-                        "%s{\"path\":\"%s\"}", i > 0 ? "," : "", path);
-                    if (strlen(files_buf) + strlen(entry) + 2 > buf_size)
-                    {
-                        buf_size *= 2;
-                        files_buf = (char*)realloc(files_buf, buf_size);
-                    }
-                    strcat(files_buf, entry);
-                    g_free(path);
-                }
-            }
-            strcat(files_buf, "]");
-            files_json = files_buf;
-            g_strfreev(uris);
-        }
-    }
-    else /* text/plain or UTF8_STRING */
+/* Reports the values in effect on the attached view; before attach, reports the stored profile. */
+void ag_gtk_get_effective_settings(ag_gtk_handle handle, ag_gtk_performance_profile* out)
+{
+    if (!handle || !out) return;
+    shim_state* s = (shim_state*)handle;
+    performance_profile_data d = { s, out };
+    if (s->web_view == NULL)
     {
-        text = (const char*)gtk_selection_data_get_data(data);
+        *out = s->opt_profile;
+        return;
     }
-
-    if (s->callbacks.on_drop_performed)
-        s->callbacks.on_drop_performed(s->user_data, files_json, text, (double)x, (double)y);
-
-    if (files_buf)
-        free(files_buf);
-    gtk_drag_finish(context, TRUE, FALSE, time);
+    run_on_gtk_thread(do_get_effective_settings, &d);
 }
 
-/* ========== Attach helper ========== */
+/* ========== Hibernation ========== */
 
 typedef struct
 {
     shim_state* state;
-    gulong x11_window_id;
-    gboolean result;
-} attach_data;
+    WebKitWebView* web_view; /* ref; the view being hibernated */
+    gboolean capture_snapshot;
+    ag_gtk_hibernate_cb callback;
+    void* context;
+} hibernate_op;
 
-static void do_attach(void* data)
+static void hibernate_op_finish(hibernate_op* op, cairo_surface_t* snapshot, const char* error)
 {
-    attach_data* ad = (attach_data*)data;
-    shim_state* s = ad->state;
+    shim_state* s = op->state;
+    s->hibernating = FALSE;
 
-    if (atomic_load(&s->detached))
-    {
-        ad->result = FALSE;
-        return;
-    }
+    if (error == NULL && (atomic_load(&s->detached) || s->web_view != op->web_view))
+        error = "The view was detached or replaced while hibernating";
 
-    /* Create a GtkPlug to embed into the X11 window provided by Avalonia NativeControlHost */
-    s->plug = gtk_plug_new((Window)ad->x11_window_id);
-    if (s->plug == NULL)
+    if (error != NULL)
     {
-        ad->result = FALSE;
+        op->callback(op->context, false, error);
+        g_object_unref(op->web_view);
+        free(op);
         return;
     }
 
-    /* Create content manager for script message handling */
-    s->content_manager = webkit_user_content_manager_new();
-    g_signal_connect(s->content_manager, "script-message-received::agibuildWebView",
-                     G_CALLBACK(on_script_message), s);
-    webkit_user_content_manager_register_script_message_handler(s->content_manager, "agibuildWebView");
+    s->hibernation_session = webkit_web_view_get_session_state(s->web_view);
+
+    /* Release everything bound to the old view before it goes away. */
+    cancel_drag_motion_flush(s);
+    destroy_preload_view(s);
+    cancel_pending_policies(s);
+    bridge_unregister_view(s);
+    hang_end(s, AG_GTK_HANG_TERMINATED);
+    hang_reset(s);
+    g_signal_handlers_disconnect_by_data(s->web_view, s);
+    g_object_set_data(G_OBJECT(s->web_view), AG_SHIM_STATE_KEY, NULL);
+    gtk_widget_destroy(GTK_WIDGET(s->web_view));
+    s->web_view = NULL;
 
-    /* Create WebKitWebView */
-    if (s->opt_ephemeral)
-    {
-        WebKitWebContext* ctx = webkit_web_context_new_ephemeral();
-        s->web_view = WEBKIT_WEB_VIEW(g_object_new(WEBKIT_TYPE_WEB_VIEW,
-            "web-context", ctx,
-            "user-content-manager", s->content_manager,
-            NULL));
-        g_object_unref(ctx);
-    }
-    else
+    if (snapshot != NULL && s->plug != NULL)
     {
-        s->web_view = WEBKIT_WEB_VIEW(g_object_new(WEBKIT_TYPE_WEB_VIEW,
-            "user-content-manager", s->content_manager,
-            NULL));
+        s->hibernation_placeholder = gtk_image_new_from_surface(snapshot);
+        gtk_container_add(GTK_CONTAINER(s->plug), s->hibernation_placeholder);
+        gtk_widget_show_all(s->plug);
     }
 
-    /* Apply DevTools setting */
-    WebKitSettings* settings = webkit_web_view_get_settings(s->web_view);
-    webkit_settings_set_enable_developer_extras(settings, s->opt_enable_dev_tools);
+    g_atomic_int_set(&s->hibernated, TRUE);
+    op->callback(op->context, true, NULL);
+    g_object_unref(op->web_view);
+    free(op);
+}
 
-    /* Apply custom user agent */
-    if (s->opt_user_agent != NULL)
-    {
-        webkit_settings_set_user_agent(settings, s->opt_user_agent);
-    }
+static void on_hibernate_snapshot(GObject* source, GAsyncResult* result, gpointer user_data)
+{
+    hibernate_op* op = (hibernate_op*)user_data;
+    GError* error = NULL;
+    cairo_surface_t* surface = webkit_web_view_get_snapshot_finish(WEBKIT_WEB_VIEW(source), result, &error);
+    if (error != NULL)
+        g_error_free(error); /* Hibernate without a placeholder image. */
 
-    /* Enable JavaScript */
-    webkit_settings_set_enable_javascript(settings, TRUE);
+    hibernate_op_finish(op, surface, NULL);
+    if (surface != NULL)
+        cairo_surface_destroy(surface);
+}
 
-    /* Connect signals */
-    g_signal_connect(s->web_view, "decide-policy", G_CALLBACK(on_decide_policy), s);
-    g_signal_connect(s->web_view, "load-changed", G_CALLBACK(on_load_changed), s);
-    g_signal_connect(s->web_view, "load-failed", G_CALLBACK(on_load_failed), s);
-    g_signal_connect(s->web_view, "load-failed-with-tls-errors", G_CALLBACK(on_load_failed_tls), s);
+static void on_hibernate_scroll(GObject* source, GAsyncResult* result, gpointer user_data)
+{
+    hibernate_op* op = (hibernate_op*)user_data;
+    shim_state* s = op->state;
+    GError* error = NULL;
+    WebKitJavascriptResult* js_result = webkit_web_view_run_javascript_finish(WEBKIT_WEB_VIEW(source), result, &error);
 
-    /* Register custom URI schemes */
-    WebKitWebContext* web_context = webkit_web_view_get_context(s->web_view);
-    if (s->custom_schemes != NULL && s->callbacks.on_scheme_request != NULL)
+    s->hibernation_scroll_x = 0;
+    s->hibernation_scroll_y = 0;
+    if (js_result != NULL)
     {
-        for (int i = 0; i < s->custom_scheme_count; i++)
+        char* text = jsc_value_to_string(webkit_javascript_result_get_js_value(js_result));
+        if (text != NULL)
         {
-            webkit_web_context_register_uri_scheme(web_context, s->custom_schemes[i],
-                on_custom_scheme_request, s, NULL);
+            double scroll[2] = { 0 };
+            if (parse_script_numbers(text, scroll, 2) == 2)
+            {
+                s->hibernation_scroll_x = scroll[0];
+                s->hibernation_scroll_y = scroll[1];
+            }
+            g_free(text);
         }
+        webkit_javascript_result_unref(js_result);
     }
+    if (error != NULL)
+        g_error_free(error); /* No document or script disabled: restore at the top. */
 
-    /* Download signal */
-    g_signal_connect(web_context, "download-started", G_CALLBACK(on_download_started), s);
-
-    /* Permission signal */
-    g_signal_connect(s->web_view, "permission-request", G_CALLBACK(on_permission_request), s);
-
-    /* Context menu signal */
-    if (s->callbacks.on_context_menu != NULL)
+    if (op->capture_snapshot && !atomic_load(&s->detached) && s->web_view == op->web_view)
     {
-        g_signal_connect(s->web_view, "context-menu", G_CALLBACK(on_context_menu), s);
+        webkit_web_view_get_snapshot(op->web_view, WEBKIT_SNAPSHOT_REGION_VISIBLE,
+            WEBKIT_SNAPSHOT_OPTIONS_NONE, NULL, on_hibernate_snapshot, op);
+        return;
     }
+    hibernate_op_finish(op, NULL, NULL);
+}
 
-    /* Set up drag-and-drop targets */
-    GtkTargetEntry targets[] = {
-        {"text/uri-list", 0, 0},
-        {"text/plain", 0, 1},
-        {"UTF8_STRING", 0, 2}
-    };
-    gtk_drag_dest_set(GTK_WIDGET(s->web_view),
-        GTK_DEST_DEFAULT_ALL,
-        targets, G_N_ELEMENTS(targets),
-        GDK_ACTION_COPY);
-    g_signal_connect(s->web_view, "drag-data-received", G_CALLBACK(on_drag_data_received), s);
-    g_signal_connect(s->web_view, "drag-motion", G_CALLBACK(on_drag_motion), s);
-    g_signal_connect(s->web_view, "drag-leave", G_CALLBACK(on_drag_leave), s);
+static void do_hibernate(void* data)
+{
+    hibernate_op* op = (hibernate_op*)data;
+    shim_state* s = op->state;
 
-    /* Add WebView to the plug */
-    gtk_container_add(GTK_CONTAINER(s->plug), GTK_WIDGET(s->web_view));
-    gtk_widget_show_all(s->plug);
+    gboolean hibernated = g_atomic_int_get(&s->hibernated);
+    if (atomic_load(&s->detached) || (s->web_view == NULL && !hibernated))
+    {
+        op->callback(op->context, false, "Not attached");
+        free(op);
+        return;
+    }
+    if (hibernated || s->hibernating)
+    {
+        op->callback(op->context, hibernated, hibernated ? NULL : "Hibernation already in progress");
+        free(op);
+        return;
+    }
 
-    ad->result = TRUE;
+    s->hibernating = TRUE;
+    op->web_view = g_object_ref(s->web_view);
+    webkit_web_view_run_javascript(s->web_view, "scrollX + ',' + scrollY", NULL, on_hibernate_scroll, op);
 }
 
-/* ========== Detach helper ========== */
+/* Captures the back/forward session and scroll position (and optionally a snapshot of the
+ * visible area to show in the meantime), then destroys the WebKitWebView so its web process
+ * can exit. The plug, content manager and context are kept for ag_gtk_resume. */
+void ag_gtk_hibernate(ag_gtk_handle handle, bool capture_snapshot, ag_gtk_hibernate_cb callback, void* context)
+{
+    if (!handle || !callback) return;
+    hibernate_op* op = (hibernate_op*)calloc(1, sizeof(hibernate_op));
+    op->state = (shim_state*)handle;
+    op->capture_snapshot = capture_snapshot;
+    op->callback = callback;
+    op->context = context;
+    run_on_gtk_thread(do_hibernate, op);
+}
 
-static void do_detach(void* data)
+typedef struct
 {
-    shim_state* s = (shim_state*)data;
-    gboolean was_detached = atomic_exchange(&s->detached, TRUE);
-    if (was_detached)
-        return;
+    shim_state* state;
+    gboolean result;
+} resume_data;
 
-    atomic_store(&s->dev_tools_open, FALSE);
+static void do_resume(void* data)
+{
+    resume_data* d = (resume_data*)data;
+    shim_state* s = d->state;
+    if (atomic_load(&s->detached) || s->plug == NULL) return;
+    d->result = TRUE;
+    if (!g_atomic_int_get(&s->hibernated)) return;
 
-    /* Unregister script message handler */
-    if (s->content_manager != NULL)
+    if (s->hibernation_placeholder != NULL)
     {
-        webkit_user_content_manager_unregister_script_message_handler(s->content_manager, "agibuildWebView");
+        gtk_widget_destroy(s->hibernation_placeholder);
+        s->hibernation_placeholder = NULL;
     }
 
-    /* Destroy the plug (and its children including web_view) */
-    if (s->plug != NULL)
-    {
-        gtk_widget_destroy(s->plug);
-        s->plug = NULL;
-    }
+    create_web_view(s);
+    gtk_container_add(GTK_CONTAINER(s->plug), GTK_WIDGET(s->web_view));
+    gtk_widget_show_all(s->plug);
+    activity_apply(s);
+    g_atomic_int_set(&s->hibernated, FALSE);
 
-    /* Cancel all pending policy decisions */
-    if (s->pending_policy != NULL)
+    if (s->hibernation_session != NULL)
     {
-        GHashTableIter iter;
-        gpointer key, value;
-        g_hash_table_iter_init(&iter, s->pending_policy);
-        while (g_hash_table_iter_next(&iter, &key, &value))
+        webkit_web_view_restore_session_state(s->web_view, s->hibernation_session);
+        webkit_web_view_session_state_unref(s->hibernation_session);
+        s->hibernation_session = NULL;
+
+        WebKitBackForwardListItem* item =
+            webkit_back_forward_list_get_current_item(webkit_web_view_get_back_forward_list(s->web_view));
+        if (item != NULL)
         {
-            WebKitPolicyDecision* decision = (WebKitPolicyDecision*)value;
-            webkit_policy_decision_ignore(decision);
-            g_object_unref(decision);
+            s->restore_scroll_pending = s->hibernation_scroll_x != 0 || s->hibernation_scroll_y != 0;
+            s->restoring_session = TRUE;
+            g_free(s->restoring_uri);
+            s->restoring_uri = g_strdup(webkit_back_forward_list_item_get_uri(item));
+            webkit_web_view_go_to_back_forward_list_item(s->web_view, item);
         }
-        g_hash_table_remove_all(s->pending_policy);
     }
-
-    s->web_view = NULL;
-    s->content_manager = NULL;
 }
 
-/* ========== Public API ========== */
-
-ag_gtk_handle ag_gtk_create(const struct ag_gtk_callbacks* callbacks, void* user_data)
+/* Rebuilds a hibernated view the way attach does and reloads the current history entry.
+ * Returns true if the view is awake afterwards. */
+bool ag_gtk_resume(ag_gtk_handle handle)
 {
-    ensure_gtk_init();
+    if (!handle) return false;
+    resume_data d = { (shim_state*)handle, FALSE };
+    run_on_gtk_thread(do_resume, &d);
+    return d.result;
+}
 
-    shim_state* s = (shim_state*)calloc(1, sizeof(shim_state));
-    if (s == NULL)
-        return NULL;
+bool ag_gtk_is_hibernated(ag_gtk_handle handle)
+{
+    return handle && g_atomic_int_get(&((shim_state*)handle)->hibernated);
+}
 
-    if (callbacks)
+static void release_hibernation_state(shim_state* s)
+{
+    if (s->hibernation_session != NULL)
     {
-        s->callbacks = *callbacks;
+        webkit_web_view_session_state_unref(s->hibernation_session);
+        s->hibernation_session = NULL;
     }
-    s->user_data = user_data;
-    atomic_init(&s->next_request_id, 1);
-    atomic_init(&s->detached, FALSE);
-    atomic_init(&s->dev_tools_open, FALSE);
-    s->pending_policy = g_hash_table_new(g_direct_hash, g_direct_equal);
+    s->hibernation_placeholder = NULL; /* destroyed with the plug */
+    g_atomic_int_set(&s->hibernated, FALSE);
+    s->restore_scroll_pending = FALSE;
+    end_session_restore(s);
+}
 
-    return (ag_gtk_handle)s;
+/* ========== Activity state ========== */
+
+/* Views the host is not showing are throttled or suspended. Both hide the web view widget,
+ * which WebKit reports to the page as hidden (visibilitychange, document.hidden): it stops
+ * painting and requestAnimationFrame and throttles timers in the web process. Suspended also
+ * mutes the page so media stops pulling the audio stack. WebKitGTK has no public call to
+ * freeze a web process; hibernation is the step after suspension. */
+
+#define AG_GTK_ACTIVITY_ACTIVE    0
+#define AG_GTK_ACTIVITY_THROTTLED 1
+#define AG_GTK_ACTIVITY_SUSPENDED 2
+
+static void activity_apply(shim_state* s)
+{
+    if (s->web_view == NULL)
+        return;
+
+    if (s->activity_state == AG_GTK_ACTIVITY_ACTIVE)
+        gtk_widget_show(GTK_WIDGET(s->web_view));
+    else
+        gtk_widget_hide(GTK_WIDGET(s->web_view));
+    webkit_web_view_set_is_muted(s->web_view, s->activity_state == AG_GTK_ACTIVITY_SUSPENDED);
 }
 
-void ag_gtk_register_custom_scheme(ag_gtk_handle handle, const char* scheme_utf8)
+typedef struct
 {
-    if (!handle || !scheme_utf8) return;
-    shim_state* s = (shim_state*)handle;
+    shim_state* state;
+    int activity_state;
+} activity_state_data;
 
-    int new_count = s->custom_scheme_count + 1;
-    s->custom_schemes = (char**)realloc(s->custom_schemes, sizeof(char*) * (new_count + 1));
-    s->custom_schemes[s->custom_scheme_count] = strdup(scheme_utf8);
-    s->custom_schemes[new_count] = NULL; /* NULL-terminate */
-    s->custom_scheme_count = new_count;
+static void do_set_activity_state(void* data)
+{
+    activity_state_data* d = (activity_state_data*)data;
+    if (d->state->activity_state == d->activity_state)
+        return;
+    d->state->activity_state = d->activity_state;
+    activity_apply(d->state);
 }
 
-void ag_gtk_destroy(ag_gtk_handle handle)
+/* AG_GTK_ACTIVITY_ACTIVE, _THROTTLED or _SUSPENDED. May be called before attach. */
+void ag_gtk_set_activity_state(ag_gtk_handle handle, int32_t activity_state)
+{
+    if (!handle || activity_state < AG_GTK_ACTIVITY_ACTIVE || activity_state > AG_GTK_ACTIVITY_SUSPENDED) return;
+    activity_state_data d = { (shim_state*)handle, activity_state };
+    run_on_gtk_thread(do_set_activity_state, &d);
+}
+
+/* ========== Web process crash recovery ========== */
+
+/* When enabled, a view whose web process crashes or exceeds its memory limit reloads the last
+ * committed history entry on a new process. Terminations requested through the API are never
+ * recovered. May be called at any time. */
+void ag_gtk_set_crash_recovery(ag_gtk_handle handle, bool enabled)
+{
+    if (!handle) return;
+    ((shim_state*)handle)->opt_crash_recovery = enabled;
+}
+
+/* last_recovery_us is the time from the termination to the end of the recovery load for the
+ * most recent completed recovery, or 0 if none has completed. */
+void ag_gtk_get_crash_stats(ag_gtk_handle handle, uint64_t* out_terminations, uint64_t* out_recoveries,
+    int64_t* out_last_recovery_us)
 {
     if (!handle) return;
     shim_state* s = (shim_state*)handle;
-    ag_gtk_detach(handle);
+    if (out_terminations) *out_terminations = atomic_load(&s->web_process_terminations);
+    if (out_recoveries) *out_recoveries = atomic_load(&s->crash_recoveries);
+    if (out_last_recovery_us) *out_last_recovery_us = atomic_load(&s->last_recovery_us);
+}
 
-    if (s->pending_policy != NULL)
-    {
-        g_hash_table_destroy(s->pending_policy);
-        s->pending_policy = NULL;
-    }
+/* ========== Responsiveness watchdog ========== */
 
-    /* Free custom schemes */
-    if (s->custom_schemes != NULL)
+/* WebKit pings a web process that is in use and flips is-web-process-responsive once a ping
+ * has gone unanswered for a few seconds, so a hang is reported that long after it begins. */
+
+static void hang_cancel_terminate(shim_state* s)
+{
+    if (s->hang_terminate_id != 0)
     {
-        for (int i = 0; i < s->custom_scheme_count; i++)
-        {
-            free(s->custom_schemes[i]);
-        }
-        free(s->custom_schemes);
+        g_source_remove(s->hang_terminate_id);
+        s->hang_terminate_id = 0;
     }
-
-    free(s->opt_user_agent);
-    free(s);
 }
 
-bool ag_gtk_attach(ag_gtk_handle handle, unsigned long x11_window_id)
+/* Ends the current hang, if there is one, and reports how it ended. */
+static void hang_end(shim_state* s, int event)
 {
-    if (!handle || x11_window_id == 0) return false;
-    shim_state* s = (shim_state*)handle;
-
-    attach_data ad;
-    ad.state = s;
-    ad.x11_window_id = x11_window_id;
-    ad.result = FALSE;
+    hang_cancel_terminate(s);
+    if (s->hang_started_us == 0)
+        return;
 
-    run_on_gtk_thread(do_attach, &ad);
-    return ad.result;
+    gint64 duration_us = g_get_monotonic_time() - s->hang_started_us;
+    s->hang_started_us = 0;
+    if (s->callbacks.on_web_process_hang && !atomic_load(&s->detached))
+        s->callbacks.on_web_process_hang(s->user_data, event, duration_us);
 }
 
-void ag_gtk_detach(ag_gtk_handle handle)
+static void hang_reset(shim_state* s)
 {
-    if (!handle) return;
-    shim_state* s = (shim_state*)handle;
-    run_on_gtk_thread(do_detach, s);
+    hang_cancel_terminate(s);
+    s->hang_started_us = 0;
+    s->hang_terminated = FALSE;
 }
 
-void ag_gtk_policy_decide(ag_gtk_handle handle, uint64_t request_id, bool allow)
+static gboolean on_hang_terminate_timeout(gpointer user_data)
 {
-    if (!handle || request_id == 0) return;
-    shim_state* s = (shim_state*)handle;
+    shim_state* s = (shim_state*)user_data;
+    s->hang_terminate_id = 0;
+#if WEBKIT_CHECK_VERSION(2, 34, 0)
+    if (s->hang_started_us != 0 && s->web_view != NULL && !atomic_load(&s->detached))
+    {
+        s->hang_terminated = TRUE;
+        webkit_web_view_terminate_web_process(s->web_view);
+    }
+#endif
+    return G_SOURCE_REMOVE;
+}
 
-    WebKitPolicyDecision* decision = (WebKitPolicyDecision*)g_hash_table_lookup(
-        s->pending_policy, GUINT_TO_POINTER((guint)request_id));
+static void on_web_process_responsive_changed(GObject* object, GParamSpec* pspec, gpointer user_data)
+{
+    (void)pspec;
+    shim_state* s = (shim_state*)user_data;
+    if (atomic_load(&s->detached) || (WebKitWebView*)object != s->web_view)
+        return;
 
-    if (decision == NULL)
+#if WEBKIT_CHECK_VERSION(2, 34, 0)
+    if (webkit_web_view_get_is_web_process_responsive(s->web_view))
+    {
+        hang_end(s, AG_GTK_HANG_RECOVERED);
+        return;
+    }
+#endif
+    if (s->hang_started_us != 0)
         return;
 
-    g_hash_table_remove(s->pending_policy, GUINT_TO_POINTER((guint)request_id));
+    s->hang_started_us = g_get_monotonic_time();
+    if (s->callbacks.on_web_process_hang)
+        s->callbacks.on_web_process_hang(s->user_data, AG_GTK_HANG_STARTED, 0);
+    if (s->opt_hang_terminate_ms > 0)
+        s->hang_terminate_id = g_timeout_add((guint)s->opt_hang_terminate_ms, on_hang_terminate_timeout, s);
+}
 
-    if (allow)
-        webkit_policy_decision_use(decision);
-    else
-        webkit_policy_decision_ignore(decision);
+typedef struct
+{
+    shim_state* state;
+    int64_t terminate_after_ms;
+} hang_policy_data;
 
-    g_object_unref(decision);
+static void do_set_hang_policy(void* data)
+{
+    hang_policy_data* d = (hang_policy_data*)data;
+    d->state->opt_hang_terminate_ms = d->terminate_after_ms;
 }
 
-void ag_gtk_navigate(ag_gtk_handle handle, const char* url_utf8)
+/* terminate_after_ms > 0 terminates a web process that is still unresponsive that long after
+ * WebKit noticed the hang; the view then reloads its last committed entry on a new process.
+ * 0 only reports hangs. May be called at any time; takes effect from the next hang. */
+void ag_gtk_set_hang_policy(ag_gtk_handle handle, int64_t terminate_after_ms)
 {
-    if (!handle || !url_utf8) return;
-    shim_state* s = (shim_state*)handle;
-    if (atomic_load(&s->detached) || s->web_view == NULL) return;
-
-    webkit_web_view_load_uri(s->web_view, url_utf8);
+    if (!handle) return;
+    hang_policy_data d = { (shim_state*)handle, terminate_after_ms > 0 ? terminate_after_ms : 0 };
+    run_on_gtk_thread(do_set_hang_policy, &d);
 }
 
-void ag_gtk_load_html(ag_gtk_handle handle, const char* html_utf8, const char* base_url_utf8_or_null)
+/* ========== Resource timing ========== */
+
+#define AG_GTK_DEFAULT_RESOURCE_TIMING_CAPACITY 256
+
+typedef struct
 {
-    if (!handle || !html_utf8) return;
-    shim_state* s = (shim_state*)handle;
-    if (atomic_load(&s->detached) || s->web_view == NULL) return;
+    shim_state* state;
+    WebKitWebResource* resource; /* not owned; the handlers below die with it */
+    resource_record rec;
+} resource_load;
 
-    webkit_web_view_load_html(s->web_view, html_utf8, base_url_utf8_or_null);
+static void resource_record_clear(resource_record* r)
+{
+    g_free(r->url);
+    g_free(r->method);
+    g_free(r->mime_type);
+    memset(r, 0, sizeof(*r));
 }
 
-void ag_gtk_eval_js(ag_gtk_handle handle, uint64_t request_id, const char* script_utf8)
+/* Destroy notify of the "finished" handler: runs when the load completes or the resource
+ * (and with it the view) goes away. */
+static void resource_load_free(gpointer data, GClosure* closure)
 {
-    if (!handle || request_id == 0 || !script_utf8) return;
-    shim_state* s = (shim_state*)handle;
-    if (atomic_load(&s->detached) || s->web_view == NULL) return;
+    resource_load* load = (resource_load*)data;
+    shim_state* s = load->state;
+    if (s->resource_inflight != NULL)
+        g_hash_table_remove(s->resource_inflight, load);
+    resource_record_clear(&load->rec);
+    g_free(load);
+}
 
-    eval_js_data* data = (eval_js_data*)malloc(sizeof(eval_js_data));
-    if (data == NULL) return;
-    data->state = s;
-    data->request_id = request_id;
+static void resource_load_complete(WebKitWebResource* resource, resource_load* load, gboolean failed)
+{
+    shim_state* s = load->state;
+    load->rec.failed = failed;
+    load->rec.end_us = g_get_monotonic_time();
+
+    if (s->resource_ring != NULL && s->resource_ring_capacity > 0)
+    {
+        /* The ring takes the strings; the oldest record is dropped once it is full. */
+        resource_record* slot = &s->resource_ring[s->resource_ring_next];
+        resource_record_clear(slot);
+        *slot = load->rec;
+        memset(&load->rec, 0, sizeof(load->rec));
+        s->resource_ring_next = (s->resource_ring_next + 1) % s->resource_ring_capacity;
+        if (s->resource_ring_count < s->resource_ring_capacity)
+            s->resource_ring_count++;
+    }
 
-    webkit_web_view_run_javascript(s->web_view, script_utf8, NULL, on_eval_js_finish, data);
+    g_signal_handlers_disconnect_by_data(resource, load); /* frees load */
 }
 
-bool ag_gtk_go_back(ag_gtk_handle handle)
+static void on_resource_response(WebKitWebResource* resource, GParamSpec* pspec, gpointer user_data)
 {
-    if (!handle) return false;
-    shim_state* s = (shim_state*)handle;
-    if (atomic_load(&s->detached) || s->web_view == NULL) return false;
-    if (!webkit_web_view_can_go_back(s->web_view)) return false;
-    webkit_web_view_go_back(s->web_view);
-    return true;
+    resource_load* load = (resource_load*)user_data;
+    WebKitURIResponse* response = webkit_web_resource_get_response(resource);
+    if (response == NULL || load->rec.response_us >= 0) return;
+
+    load->rec.response_us = g_get_monotonic_time();
+    load->rec.status = (int32_t)webkit_uri_response_get_status_code(response);
+    load->rec.mime_type = g_strdup(webkit_uri_response_get_mime_type(response));
+    guint64 length = webkit_uri_response_get_content_length(response);
+    load->rec.size = length > 0 ? (int64_t)length : -1;
 }
 
-bool ag_gtk_go_forward(ag_gtk_handle handle)
+static void on_resource_finished(WebKitWebResource* resource, gpointer user_data)
 {
-    if (!handle) return false;
-    shim_state* s = (shim_state*)handle;
-    if (atomic_load(&s->detached) || s->web_view == NULL) return false;
-    if (!webkit_web_view_can_go_forward(s->web_view)) return false;
-    webkit_web_view_go_forward(s->web_view);
-    return true;
+    resource_load_complete(resource, (resource_load*)user_data, FALSE);
 }
 
-bool ag_gtk_reload(ag_gtk_handle handle)
+static void on_resource_failed(WebKitWebResource* resource, GError* error, gpointer user_data)
 {
-    if (!handle) return false;
-    shim_state* s = (shim_state*)handle;
-    if (atomic_load(&s->detached) || s->web_view == NULL) return false;
-    webkit_web_view_reload(s->web_view);
-    return true;
+    resource_load_complete(resource, (resource_load*)user_data, TRUE);
 }
 
-void ag_gtk_stop(ag_gtk_handle handle)
+static void on_resource_load_started(WebKitWebView* web_view, WebKitWebResource* resource,
+    WebKitURIRequest* request, gpointer user_data)
 {
-    if (!handle) return;
-    shim_state* s = (shim_state*)handle;
-    if (atomic_load(&s->detached) || s->web_view == NULL) return;
-    webkit_web_view_stop_loading(s->web_view);
+    shim_state* s = (shim_state*)user_data;
+    if (!s->resource_timing_enabled || atomic_load(&s->detached))
+        return;
+
+    const char* method = webkit_uri_request_get_http_method(request);
+    resource_load* load = g_new0(resource_load, 1);
+    load->state = s;
+    load->resource = resource;
+    load->rec.url = g_strdup(webkit_web_resource_get_uri(resource));
+    load->rec.method = g_strdup(method != NULL ? method : "GET");
+    load->rec.started_unix_us = g_get_real_time();
+    load->rec.start_us = g_get_monotonic_time();
+    load->rec.response_us = -1;
+    load->rec.size = -1;
+    load->rec.handler_us = -1;
+    if (load->rec.url == NULL)
+        load->rec.url = g_strdup("");
+    g_hash_table_add(s->resource_inflight, load);
+
+    g_signal_connect(resource, "notify::response", G_CALLBACK(on_resource_response), load);
+    g_signal_connect(resource, "failed", G_CALLBACK(on_resource_failed), load);
+    g_signal_connect_data(resource, "finished", G_CALLBACK(on_resource_finished), load,
+        resource_load_free, 0);
 }
 
-bool ag_gtk_can_go_back(ag_gtk_handle handle)
+/* Tags the most recently started in-flight load of uri; few loads are in flight at once. */
+static void note_scheme_handler_time(shim_state* s, const char* uri, gint64 elapsed_us)
 {
-    if (!handle) return false;
-    shim_state* s = (shim_state*)handle;
-    if (atomic_load(&s->detached) || s->web_view == NULL) return false;
-    return webkit_web_view_can_go_back(s->web_view);
+    if (s->resource_inflight == NULL) return;
+
+    resource_load* match = NULL;
+    GHashTableIter iter;
+    gpointer key;
+    g_hash_table_iter_init(&iter, s->resource_inflight);
+    while (g_hash_table_iter_next(&iter, &key, NULL))
+    {
+        resource_load* load = (resource_load*)key;
+        if (load->rec.handler_us < 0 && strcmp(load->rec.url, uri) == 0
+            && (match == NULL || load->rec.start_us > match->rec.start_us))
+            match = load;
+    }
+    if (match != NULL)
+        match->rec.handler_us = elapsed_us;
 }
 
-bool ag_gtk_can_go_forward(ag_gtk_handle handle)
+/* Drops every load still in flight (disconnecting frees it), so none outlives the state. */
+static void drop_inflight_resources(shim_state* s)
 {
-    if (!handle) return false;
-    shim_state* s = (shim_state*)handle;
-    if (atomic_load(&s->detached) || s->web_view == NULL) return false;
-    return webkit_web_view_can_go_forward(s->web_view);
+    if (s->resource_inflight == NULL) return;
+
+    GPtrArray* loads = g_hash_table_get_keys_as_ptr_array(s->resource_inflight);
+    for (guint i = 0; i < loads->len; i++)
+    {
+        resource_load* load = (resource_load*)g_ptr_array_index(loads, i);
+        g_signal_handlers_disconnect_by_data(load->resource, load);
+    }
+    g_ptr_array_unref(loads);
+    g_hash_table_remove_all(s->resource_inflight);
 }
 
-void* ag_gtk_get_webview_handle(ag_gtk_handle handle)
+static void release_resource_timing(shim_state* s)
 {
-    if (!handle) return NULL;
-    shim_state* s = (shim_state*)handle;
-    if (atomic_load(&s->detached)) return NULL;
-    return (void*)s->web_view;
+    if (s->resource_ring != NULL)
+    {
+        for (int i = 0; i < s->resource_ring_capacity; i++)
+            resource_record_clear(&s->resource_ring[i]);
+        g_free(s->resource_ring);
+        s->resource_ring = NULL;
+    }
+    s->resource_ring_capacity = 0;
+    s->resource_ring_count = 0;
+    s->resource_ring_next = 0;
+    if (s->resource_inflight != NULL)
+    {
+        drop_inflight_resources(s);
+        g_hash_table_destroy(s->resource_inflight);
+        s->resource_inflight = NULL;
+    }
 }
 
-/* ========== Cookie management ========== */
-
 typedef struct
 {
     shim_state* state;
-    ag_gtk_cookies_get_cb callback;
-    void* context;
-    char* url;
-} cookies_get_data;
+    gboolean enabled;
+    int capacity;
+} resource_timing_config;
 
-static void on_cookies_get_finish(WebKitCookieManager* manager, GAsyncResult* result, gpointer user_data)
+static void do_set_resource_timing(void* data)
 {
-    cookies_get_data* data = (cookies_get_data*)user_data;
+    resource_timing_config* c = (resource_timing_config*)data;
+    shim_state* s = c->state;
 
-    GError* error = NULL;
-    GList* cookies = webkit_cookie_manager_get_cookies_finish(manager, result, &error);
-
-    if (error != NULL)
+    if (s->resource_ring == NULL || c->capacity != s->resource_ring_capacity)
     {
-        data->callback(data->context, "[]");
-        g_error_free(error);
-        free(data->url);
-        free(data);
-        return;
+        /* Loads in flight keep their own record until they finish; only the ring is rebuilt. */
+        if (s->resource_ring != NULL)
+        {
+            for (int i = 0; i < s->resource_ring_capacity; i++)
+                resource_record_clear(&s->resource_ring[i]);
+            g_free(s->resource_ring);
+        }
+        s->resource_ring = g_new0(resource_record, c->capacity);
+        s->resource_ring_capacity = c->capacity;
+        s->resource_ring_count = 0;
+        s->resource_ring_next = 0;
     }
+    if (s->resource_inflight == NULL)
+        s->resource_inflight = g_hash_table_new(g_direct_hash, g_direct_equal);
+    s->resource_timing_enabled = c->enabled;
+}
 
-    /* Build JSON array */
-    GString* json = g_string_new("[");
-    gboolean first = TRUE;
-    for (GList* l = cookies; l != NULL; l = l->next)
-    {
-        SoupCookie* c = (SoupCookie*)l->data;
-        if (!first) g_string_append_c(json, ',');
-        first = FALSE;
+/* Starts or stops recording resource loads into a ring of the last `capacity` completed
+ * loads (<= 0 selects the default). Changing the capacity discards what was recorded;
+ * stopping keeps it for export. */
+void ag_gtk_set_resource_timing(ag_gtk_handle handle, bool enabled, int32_t capacity)
+{
+    if (!handle) return;
+    resource_timing_config c = { (shim_state*)handle, enabled,
+        capacity > 0 ? capacity : AG_GTK_DEFAULT_RESOURCE_TIMING_CAPACITY };
+    run_on_gtk_thread(do_set_resource_timing, &c);
+}
 
-        const char* name = soup_cookie_get_name(c);
-        const char* value = soup_cookie_get_value(c);
-        const char* domain = soup_cookie_get_domain(c);
-        const char* path = soup_cookie_get_path(c);
-        gboolean secure = soup_cookie_get_secure(c);
-        gboolean http_only = soup_cookie_get_http_only(c);
+static void do_clear_resource_timings(void* data)
+{
+    shim_state* s = (shim_state*)data;
+    for (int i = 0; i < s->resource_ring_capacity; i++)
+        resource_record_clear(&s->resource_ring[i]);
+    s->resource_ring_count = 0;
+    s->resource_ring_next = 0;
+}
 
-        /* libsoup3 (webkit2gtk-4.1): soup_cookie_get_expires returns GDateTime* instead of SoupDate*. */
-        GDateTime* expires = soup_cookie_get_expires(c);
-        double expires_unix = expires ? (double)g_date_time_to_unix(expires) : -1.0;
+void ag_gtk_clear_resource_timings(ag_gtk_handle handle)
+{
+    if (!handle) return;
+    run_on_gtk_thread(do_clear_resource_timings, handle);
+}
 
-        g_string_append_printf(json,
-            "{\"name\":\"%s\",\"value\":\"%s\",\"domain\":\"%s\",\"path\":\"%s\","
-            "\"expires\":%.3f,\"isSecure\":%s,\"isHttpOnly\":%s}",
-            name ? name : "", value ? value : "", domain ? domain : "", path ? path : "/",
-            expires_unix,
-            secure ? "true" : "false",
-            http_only ? "true" : "false");
-    }
-    g_string_append_c(json, ']');
+typedef struct
+{
+    shim_state* state;
+    ag_gtk_resource_timings_cb callback;
+    void* context;
+} resource_timings_read;
 
-    data->callback(data->context, json->str);
+static void do_get_resource_timings(void* data)
+{
+    resource_timings_read* r = (resource_timings_read*)data;
+    shim_state* s = r->state;
+    int count = s->resource_ring_count;
+    ag_gtk_resource_timing* entries = count > 0 ? g_new0(ag_gtk_resource_timing, count) : NULL;
+
+    /* Oldest first: when the ring is full the oldest record sits at resource_ring_next. */
+    int first = count < s->resource_ring_capacity ? 0 : s->resource_ring_next;
+    for (int i = 0; i < count; i++)
+    {
+        const resource_record* rec = &s->resource_ring[(first + i) % s->resource_ring_capacity];
+        ag_gtk_resource_timing* e = &entries[i];
+        e->url = rec->url;
+        e->method = rec->method;
+        e->mime_type = rec->mime_type;
+        e->status = rec->status;
+        e->failed = rec->failed ? 1 : 0;
+        e->started_unix_us = rec->started_unix_us;
+        e->wait_us = rec->response_us >= 0 ? rec->response_us - rec->start_us : -1;
+        e->receive_us = rec->response_us >= 0 ? rec->end_us - rec->response_us : -1;
+        e->total_us = rec->end_us - rec->start_us;
+        e->size = rec->size;
+        e->handler_us = rec->handler_us;
+    }
 
-    g_string_free(json, TRUE);
-    g_list_free_full(cookies, (GDestroyNotify)soup_cookie_free);
-    free(data->url);
-    free(data);
+    r->callback(r->context, count, entries);
+    g_free(entries);
 }
 
-void ag_gtk_cookies_get(ag_gtk_handle handle, const char* url_utf8,
-                         ag_gtk_cookies_get_cb callback, void* context)
+/* Calls callback synchronously with the recorded loads, oldest first. */
+void ag_gtk_get_resource_timings(ag_gtk_handle handle, ag_gtk_resource_timings_cb callback, void* context)
 {
     if (!handle || !callback) return;
-    shim_state* s = (shim_state*)handle;
-    if (atomic_load(&s->detached) || s->web_view == NULL)
+    resource_timings_read r = { (shim_state*)handle, callback, context };
+    run_on_gtk_thread(do_get_resource_timings, &r);
+}
+
+/* ========== Native bridge transport ========== */
+
+/* One connected web process. Reads and writes run asynchronously on the GTK main context,
+ * so a web process blocked writing to us can never deadlock against our writes. The open
+ * connection holds one reference and every pending read or write another, so a completion
+ * that arrives after the peer was closed still finds it. GTK thread only. */
+struct bridge_peer
+{
+    int ref_count;
+    gboolean closed;
+    GCancellable* cancellable; /* cancelled on close; fails the pending read and write */
+    GSocketConnection* connection;
+    GByteArray* read_buffer;
+    uint8_t read_chunk[64 * 1024];
+    GQueue* write_queue; /* GBytes* frames */
+    gboolean writing;
+};
+
+/* Parent of pid from /proc, or 0 when it cannot be read. */
+static pid_t proc_parent_pid(pid_t pid)
+{
+    char path[32];
+    g_snprintf(path, sizeof(path), "/proc/%d/stat", (int)pid);
+    char* contents = NULL;
+    if (!g_file_get_contents(path, &contents, NULL, NULL))
+        return 0;
+
+    /* The command name may itself contain spaces and parentheses; the state and parent id
+     * follow the last ')'. */
+    int ppid = 0;
+    const char* fields = strrchr(contents, ')');
+    if (fields == NULL || sscanf(fields + 1, " %*c %d", &ppid) != 1)
+        ppid = 0;
+    g_free(contents);
+    return (pid_t)ppid;
+}
+
+/* WebKitGTK does not expose the pid of a view's web process, so the peer's SO_PEERCRED pid is
+ * checked against the processes this one launched: web processes are our children, or our
+ * grandchildren under the bubblewrap sandbox. Another process of the same user is not. */
+static gboolean bridge_pid_is_web_process(pid_t pid)
+{
+    pid_t self = getpid();
+    for (int depth = 0; depth < 4 && pid > 1; depth++)
     {
-        callback(context, "[]");
-        return;
+        pid = proc_parent_pid(pid);
+        if (pid == self)
+            return TRUE;
     }
+    return FALSE;
+}
 
-    WebKitWebContext* web_ctx = webkit_web_view_get_context(s->web_view);
-    WebKitCookieManager* cookie_mgr = webkit_web_context_get_cookie_manager(web_ctx);
+static GSocketService* g_bridge_service;
+static char* g_bridge_socket_path;
+static char* g_bridge_extension_dir;
+static GHashTable* g_bridge_views; /* page id (guint64*) -> shim_state*; GTK thread */
 
-    cookies_get_data* data = (cookies_get_data*)calloc(1, sizeof(cookies_get_data));
-    data->state = s;
-    data->callback = callback;
-    data->context = context;
-    data->url = url_utf8 ? strdup(url_utf8) : NULL;
+static void bridge_peer_start_read(bridge_peer* peer);
 
-    webkit_cookie_manager_get_cookies(cookie_mgr, url_utf8 ? url_utf8 : "",
-                                       NULL, (GAsyncReadyCallback)on_cookies_get_finish, data);
+static bridge_peer* bridge_peer_ref(bridge_peer* peer)
+{
+    peer->ref_count++;
+    return peer;
 }
 
-void ag_gtk_cookie_set(ag_gtk_handle handle,
-    const char* name, const char* value, const char* domain, const char* path,
-    double expires_unix, bool is_secure, bool is_http_only,
-    ag_gtk_cookie_op_cb callback, void* context)
+static void bridge_peer_unref(bridge_peer* peer)
 {
-    if (!handle || !callback) return;
-    shim_state* s = (shim_state*)handle;
-    if (atomic_load(&s->detached) || s->web_view == NULL)
-    {
-        callback(context, false, "Detached");
+    if (--peer->ref_count > 0)
         return;
-    }
+    g_io_stream_close(G_IO_STREAM(peer->connection), NULL, NULL);
+    g_object_unref(peer->connection);
+    g_object_unref(peer->cancellable);
+    g_byte_array_unref(peer->read_buffer);
+    g_queue_free_full(peer->write_queue, (GDestroyNotify)g_bytes_unref);
+    g_free(peer);
+}
 
-    SoupCookie* cookie = soup_cookie_new(
-        name ? name : "", value ? value : "",
-        domain ? domain : "", path ? path : "/",
-        -1 /* max-age: session */);
+/* Detaches the peer from its views and cancels its I/O; the memory goes with the last
+ * pending operation. Safe to call more than once. */
+static void bridge_peer_close(bridge_peer* peer)
+{
+    if (peer->closed)
+        return;
+    peer->closed = TRUE;
 
-    if (expires_unix > 0)
+    if (g_bridge_views != NULL)
     {
-        /* libsoup3 (used by webkit2gtk-4.1) replaced SoupDate with GDateTime. */
-        GDateTime* date = g_date_time_new_from_unix_utc(expires_unix);
-        if (date)
+        GHashTableIter iter;
+        gpointer value;
+        g_hash_table_iter_init(&iter, g_bridge_views);
+        while (g_hash_table_iter_next(&iter, NULL, &value))
         {
-            soup_cookie_set_expires(cookie, date);
-            g_date_time_unref(date);
+            shim_state* s = (shim_state*)value;
+            if (s->bridge_peer == peer)
+                s->bridge_peer = NULL;
         }
     }
+    g_cancellable_cancel(peer->cancellable);
+    bridge_peer_unref(peer);
+}
 
-    soup_cookie_set_secure(cookie, is_secure);
-    soup_cookie_set_http_only(cookie, is_http_only);
+static shim_state* bridge_lookup_view(uint64_t page_id)
+{
+    guint64 key = page_id;
+    return g_bridge_views != NULL ? (shim_state*)g_hash_table_lookup(g_bridge_views, &key) : NULL;
+}
 
-    WebKitWebContext* web_ctx = webkit_web_view_get_context(s->web_view);
-    WebKitCookieManager* cookie_mgr = webkit_web_context_get_cookie_manager(web_ctx);
-    webkit_cookie_manager_add_cookie(cookie_mgr, cookie, NULL, NULL, NULL);
+static void bridge_handle_frame(bridge_peer* peer, uint8_t kind, uint64_t page_id, const uint8_t* payload, uint32_t len)
+{
+    shim_state* s = bridge_lookup_view(page_id);
+    if (s == NULL || atomic_load(&s->detached))
+        return;
 
-    soup_cookie_free(cookie);
-    callback(context, true, NULL);
+    if (kind == AG_BRIDGE_FRAME_HELLO)
+    {
+        /* A page id belongs to the first process that claims it until that process says goodbye
+         * or disconnects, or the page moves to a new process under a new id. A second claim
+         * is someone else guessing ids. */
+        if (s->bridge_peer == NULL)
+            s->bridge_peer = peer;
+        return;
+    }
+
+    /* Only the bound process speaks for the page. */
+    if (s->bridge_peer != peer)
+        return;
+
+    if (kind == AG_BRIDGE_FRAME_GOODBYE)
+    {
+        s->bridge_peer = NULL;
+    }
+    else if (kind == AG_BRIDGE_FRAME_MESSAGE && s->callbacks.on_message)
+    {
+        /* Same origin the script-message path reports, so the host's policy sees one value. */
+        char origin[512];
+        page_origin(s, origin, sizeof(origin));
+        char* body = g_strndup((const char*)payload, len);
+        s->callbacks.on_message(s->user_data, body, origin);
+        g_free(body);
+    }
 }
 
-void ag_gtk_cookie_delete(ag_gtk_handle handle,
-    const char* name, const char* domain, const char* path,
-    ag_gtk_cookie_op_cb callback, void* context)
+static void on_bridge_peer_read(GObject* source, GAsyncResult* result, gpointer user_data)
 {
-    if (!handle || !callback) return;
-    shim_state* s = (shim_state*)handle;
-    if (atomic_load(&s->detached) || s->web_view == NULL)
+    bridge_peer* peer = (bridge_peer*)user_data;
+    gssize n = g_input_stream_read_finish(G_INPUT_STREAM(source), result, NULL);
+    if (n <= 0 || peer->closed)
     {
-        callback(context, false, "Detached");
+        bridge_peer_close(peer); /* the web process exited or the stream was closed */
+        bridge_peer_unref(peer);
         return;
     }
 
-    SoupCookie* cookie = soup_cookie_new(
-        name ? name : "", "",
-        domain ? domain : "", path ? path : "/",
-        0 /* expired */);
+    g_byte_array_append(peer->read_buffer, peer->read_chunk, (guint)n);
+    while (peer->read_buffer->len >= AG_BRIDGE_HEADER_SIZE)
+    {
+        uint32_t len;
+        uint8_t kind;
+        uint64_t page_id;
+        ag_bridge_read_header(peer->read_buffer->data, &len, &kind, &page_id);
+        if (len > AG_BRIDGE_MAX_PAYLOAD)
+        {
+            bridge_peer_close(peer);
+            bridge_peer_unref(peer);
+            return;
+        }
+        if (peer->read_buffer->len < AG_BRIDGE_HEADER_SIZE + len)
+            break;
 
-    WebKitWebContext* web_ctx = webkit_web_view_get_context(s->web_view);
-    WebKitCookieManager* cookie_mgr = webkit_web_context_get_cookie_manager(web_ctx);
-    webkit_cookie_manager_delete_cookie(cookie_mgr, cookie, NULL, NULL, NULL);
+        bridge_handle_frame(peer, kind, page_id, peer->read_buffer->data + AG_BRIDGE_HEADER_SIZE, len);
+        g_byte_array_remove_range(peer->read_buffer, 0, AG_BRIDGE_HEADER_SIZE + len);
+    }
+    bridge_peer_start_read(peer);
+    bridge_peer_unref(peer);
+}
 
-    soup_cookie_free(cookie);
-    callback(context, true, NULL);
+static void bridge_peer_start_read(bridge_peer* peer)
+{
+    if (peer->closed)
+        return;
+    g_input_stream_read_async(g_io_stream_get_input_stream(G_IO_STREAM(peer->connection)),
+        peer->read_chunk, sizeof(peer->read_chunk), G_PRIORITY_DEFAULT, peer->cancellable,
+        on_bridge_peer_read, bridge_peer_ref(peer));
 }
 
-void ag_gtk_cookies_clear_all(ag_gtk_handle handle,
-                               ag_gtk_cookie_op_cb callback, void* context)
+static void bridge_peer_write_next(bridge_peer* peer);
+
+static void on_bridge_peer_written(GObject* source, GAsyncResult* result, gpointer user_data)
 {
-    if (!handle || !callback) return;
-    shim_state* s = (shim_state*)handle;
-    if (atomic_load(&s->detached) || s->web_view == NULL)
+    bridge_peer* peer = (bridge_peer*)user_data;
+    peer->writing = FALSE;
+    if (!g_output_stream_write_all_finish(G_OUTPUT_STREAM(source), result, NULL, NULL))
+        bridge_peer_close(peer);
+    else
     {
-        callback(context, false, "Detached");
-        return;
+        g_bytes_unref((GBytes*)g_queue_pop_head(peer->write_queue));
+        bridge_peer_write_next(peer);
     }
+    bridge_peer_unref(peer);
+}
 
-    WebKitWebContext* web_ctx = webkit_web_view_get_context(s->web_view);
-    WebKitWebsiteDataManager* data_mgr = webkit_web_context_get_website_data_manager(web_ctx);
-    webkit_website_data_manager_clear(data_mgr, WEBKIT_WEBSITE_DATA_COOKIES, 0, NULL, NULL, NULL);
+static void bridge_peer_write_next(bridge_peer* peer)
+{
+    if (peer->closed || peer->writing || g_queue_is_empty(peer->write_queue))
+        return;
 
-    callback(context, true, NULL);
+    gsize size;
+    const void* data = g_bytes_get_data((GBytes*)g_queue_peek_head(peer->write_queue), &size);
+    peer->writing = TRUE;
+    g_output_stream_write_all_async(g_io_stream_get_output_stream(G_IO_STREAM(peer->connection)),
+        data, size, G_PRIORITY_DEFAULT, peer->cancellable, on_bridge_peer_written, bridge_peer_ref(peer));
 }
 
-/* ========== Environment options ========== */
+static gboolean on_bridge_incoming(GSocketService* service, GSocketConnection* connection,
+                                   GObject* source_object, gpointer user_data)
+{
+    /* The socket lives in the user's runtime directory; still only accept our own user, and
+     * of that user's processes only our web processes. */
+    GCredentials* credentials = g_socket_get_credentials(g_socket_connection_get_socket(connection), NULL);
+    gboolean trusted = credentials != NULL
+        && g_credentials_get_unix_user(credentials, NULL) == getuid()
+        && bridge_pid_is_web_process(g_credentials_get_unix_pid(credentials, NULL));
+    if (credentials != NULL)
+        g_object_unref(credentials);
+    if (!trusted)
+        return TRUE;
 
-void ag_gtk_set_enable_dev_tools(ag_gtk_handle handle, bool enable)
+    bridge_peer* peer = g_new0(bridge_peer, 1);
+    peer->ref_count = 1; /* the open connection's */
+    peer->cancellable = g_cancellable_new();
+    peer->connection = g_object_ref(connection);
+    peer->read_buffer = g_byte_array_new();
+    peer->write_queue = g_queue_new();
+    bridge_peer_start_read(peer);
+    return TRUE;
+}
+
+/* Runs at process exit; the service itself lives as long as the process. A process killed
+ * by a signal leaves the file behind for ensure_bridge_server to remove on pid reuse. */
+static void bridge_remove_socket(void)
 {
-    if (!handle) return;
-    shim_state* s = (shim_state*)handle;
-    s->opt_enable_dev_tools = enable;
-    if (!enable)
-        atomic_store(&s->dev_tools_open, FALSE);
+    if (g_bridge_socket_path != NULL)
+        unlink(g_bridge_socket_path);
+}
 
-    /* Also apply to live WebView if already attached. */
-    if (s->web_view != NULL && !atomic_load(&s->detached))
+/* Starts the per-process socket service the first time a view asks for the native bridge.
+ * Returns false (and the view keeps the script-message path) when the extension is not
+ * installed next to the shim or the socket cannot be created. */
+static gboolean ensure_bridge_server(void)
+{
+    if (g_bridge_service != NULL)
+        return TRUE;
+
+    if (g_bridge_extension_dir == NULL)
     {
-        WebKitSettings* settings = webkit_web_view_get_settings(s->web_view);
-        webkit_settings_set_enable_developer_extras(settings, enable);
+        Dl_info info;
+        if (!dladdr((void*)ensure_bridge_server, &info) || info.dli_fname == NULL)
+            return FALSE;
+        char* lib_dir = g_path_get_dirname(info.dli_fname);
+        char* ext_dir = g_build_filename(lib_dir, "webkit-extensions", NULL);
+        char* ext_lib = g_build_filename(ext_dir, "libAgibuildWebViewGtkBridge.so", NULL);
+        gboolean present = g_file_test(ext_lib, G_FILE_TEST_EXISTS);
+        g_free(ext_lib);
+        g_free(lib_dir);
+        if (!present)
+        {
+            g_free(ext_dir);
+            return FALSE;
+        }
+        g_bridge_extension_dir = ext_dir;
     }
-}
 
-/* ========== DevTools runtime toggle ========== */
+    char* path = g_strdup_printf("%s/agibuild-bridge-%d.sock", g_get_user_runtime_dir(), (int)getpid());
+    unlink(path); /* left over from a crashed process with the same pid */
+    GSocketAddress* address = g_unix_socket_address_new(path);
+    GSocketService* service = g_socket_service_new();
+    gboolean ok = g_socket_listener_add_address(G_SOCKET_LISTENER(service), address,
+        G_SOCKET_TYPE_STREAM, G_SOCKET_PROTOCOL_DEFAULT, NULL, NULL, NULL);
+    g_object_unref(address);
+    if (!ok)
+    {
+        g_object_unref(service);
+        g_free(path);
+        return FALSE;
+    }
 
-static void do_open_dev_tools(void* data)
+    g_signal_connect(service, "incoming", G_CALLBACK(on_bridge_incoming), NULL);
+    g_socket_service_start(service);
+    g_bridge_service = service;
+    g_bridge_socket_path = path;
+    g_bridge_views = g_hash_table_new_full(g_int64_hash, g_int64_equal, g_free, NULL);
+    atexit(bridge_remove_socket);
+    return TRUE;
+}
+
+static void on_initialize_web_extensions(WebKitWebContext* context, gpointer user_data)
 {
-    shim_state* s = (shim_state*)data;
-    if (atomic_load(&s->detached) || s->web_view == NULL) return;
-    if (!s->opt_enable_dev_tools) return;
+    webkit_web_context_set_web_extensions_directory(context, g_bridge_extension_dir);
+    webkit_web_context_set_web_extensions_initialization_user_data(context,
+        g_variant_new_string(g_bridge_socket_path));
+}
 
-    WebKitWebInspector* inspector = webkit_web_view_get_inspector(s->web_view);
-    if (inspector == NULL) return;
+/* A process swap moves the page to a new web process under a new id. The old process's
+ * connection no longer speaks for the view; the new one binds with its own HELLO. */
+static void on_bridge_page_id_changed(GObject* object, GParamSpec* pspec, gpointer user_data)
+{
+    shim_state* s = (shim_state*)user_data;
+    if (atomic_load(&s->detached) || s->bridge_page_id == 0)
+        return;
 
-    webkit_web_inspector_show(inspector);
-    atomic_store(&s->dev_tools_open, TRUE);
+    g_hash_table_remove(g_bridge_views, &s->bridge_page_id);
+    s->bridge_peer = NULL;
+    s->bridge_page_id = webkit_web_view_get_page_id(s->web_view);
+    g_hash_table_replace(g_bridge_views, g_memdup2(&s->bridge_page_id, sizeof(guint64)), s);
 }
 
-static void do_close_dev_tools(void* data)
+static void bridge_register_view(shim_state* s)
 {
-    shim_state* s = (shim_state*)data;
-    if (atomic_load(&s->detached) || s->web_view == NULL) return;
-    if (!s->opt_enable_dev_tools) return;
+    if (!ensure_bridge_server())
+        return;
 
-    WebKitWebInspector* inspector = webkit_web_view_get_inspector(s->web_view);
-    if (inspector == NULL) return;
+    /* Web processes launched from this context load the extension from now on. The handler
+     * is not tied to a view, so it stays for every view sharing the context. */
+    if (g_object_get_data(G_OBJECT(s->web_context), "ag-bridge-extension") == NULL)
+    {
+        g_object_set_data(G_OBJECT(s->web_context), "ag-bridge-extension", GINT_TO_POINTER(1));
+        g_signal_connect(s->web_context, "initialize-web-extensions", G_CALLBACK(on_initialize_web_extensions), NULL);
+    }
 
-    webkit_web_inspector_close(inspector);
-    atomic_store(&s->dev_tools_open, FALSE);
+    s->bridge_page_id = webkit_web_view_get_page_id(s->web_view);
+    g_hash_table_replace(g_bridge_views, g_memdup2(&s->bridge_page_id, sizeof(guint64)), s);
+    s->bridge_page_id_handler = g_signal_connect(s->web_view, "notify::page-id",
+        G_CALLBACK(on_bridge_page_id_changed), s);
 }
 
-void ag_gtk_open_dev_tools(ag_gtk_handle handle)
+static void bridge_unregister_view(shim_state* s)
 {
-    if (!handle) return;
-    shim_state* s = (shim_state*)handle;
-    run_on_gtk_thread(do_open_dev_tools, s);
+    if (s->bridge_page_id_handler != 0)
+    {
+        g_signal_handler_disconnect(s->web_view, s->bridge_page_id_handler);
+        s->bridge_page_id_handler = 0;
+    }
+    if (s->bridge_page_id != 0 && g_bridge_views != NULL)
+        g_hash_table_remove(g_bridge_views, &s->bridge_page_id);
+    s->bridge_page_id = 0;
+    s->bridge_peer = NULL;
 }
 
-void ag_gtk_close_dev_tools(ag_gtk_handle handle)
+/* Routes bridge traffic through the web extension when it is installed. Set before attach. */
+void ag_gtk_set_native_bridge(ag_gtk_handle handle, bool enabled)
 {
     if (!handle) return;
-    shim_state* s = (shim_state*)handle;
-    run_on_gtk_thread(do_close_dev_tools, s);
+    ((shim_state*)handle)->opt_native_bridge = enabled;
 }
 
-bool ag_gtk_is_dev_tools_open(ag_gtk_handle handle)
+bool ag_gtk_bridge_is_connected(ag_gtk_handle handle)
 {
-    if (!handle) return false;
-    shim_state* s = (shim_state*)handle;
-    return atomic_load(&s->dev_tools_open);
+    return handle && ((shim_state*)handle)->bridge_peer != NULL;
 }
 
-void ag_gtk_set_ephemeral(ag_gtk_handle handle, bool ephemeral)
+typedef struct
 {
-    if (!handle) return;
-    shim_state* s = (shim_state*)handle;
-    s->opt_ephemeral = ephemeral;
-}
+    shim_state* state;
+    uint8_t kind;
+    const char* payload;
+    gboolean result;
+} bridge_send_data;
 
-void ag_gtk_set_user_agent(ag_gtk_handle handle, const char* ua_utf8_or_null)
+static void do_bridge_send(void* data)
 {
-    if (!handle) return;
-    shim_state* s = (shim_state*)handle;
+    bridge_send_data* d = (bridge_send_data*)data;
+    shim_state* s = d->state;
+    bridge_peer* peer = s->bridge_peer;
+    if (peer == NULL || atomic_load(&s->detached))
+        return;
 
-    free(s->opt_user_agent);
-    s->opt_user_agent = ua_utf8_or_null ? strdup(ua_utf8_or_null) : NULL;
+    size_t len = strlen(d->payload);
+    if (len > AG_BRIDGE_MAX_PAYLOAD)
+        return;
 
-    /* Also update live WebView if already attached. */
-    if (s->web_view != NULL && !atomic_load(&s->detached))
-    {
-        WebKitSettings* settings = webkit_web_view_get_settings(s->web_view);
-        webkit_settings_set_user_agent(settings, ua_utf8_or_null);
-    }
+    uint8_t* frame = g_malloc(AG_BRIDGE_HEADER_SIZE + len);
+    ag_bridge_write_header(frame, (uint32_t)len, d->kind, s->bridge_page_id);
+    memcpy(frame + AG_BRIDGE_HEADER_SIZE, d->payload, len);
+    g_queue_push_tail(peer->write_queue, g_bytes_new_take(frame, AG_BRIDGE_HEADER_SIZE + len));
+    bridge_peer_write_next(peer);
+    d->result = TRUE;
 }
 
-/* ========== Screenshot capture ========== */
+/* Queues an AG_BRIDGE_FRAME_DISPATCH or AG_BRIDGE_FRAME_RESPONSE frame for the page. Returns
+ * false when the page has no extension connection, so the caller falls back to eval_js. */
+bool ag_gtk_bridge_send(ag_gtk_handle handle, int32_t kind, const char* payload_utf8)
+{
+    if (!handle || !payload_utf8) return false;
+    if (kind != AG_BRIDGE_FRAME_DISPATCH && kind != AG_BRIDGE_FRAME_RESPONSE) return false;
+    bridge_send_data d = { (shim_state*)handle, (uint8_t)kind, payload_utf8, FALSE };
+    run_on_gtk_thread(do_bridge_send, &d);
+    return d.result;
+}
 
-typedef void (*ag_gtk_screenshot_cb)(void* context, const void* png_data, uint32_t png_len);
+/* ========== Published blobs ========== */
 
-typedef struct {
-    ag_gtk_screenshot_cb callback;
+/* The host's buffer is wrapped in a GBytes whose free function is the host's release callback.
+ * The registry holds one reference and every response holds a sub-range reference, so revoking
+ * a blob never pulls memory out from under a response that is still being read. */
+struct published_blob
+{
+    GBytes* bytes;
+    char* mime_type;
+};
+
+typedef struct
+{
+    ag_gtk_blob_release_cb release;
     void* context;
-} screenshot_ctx;
+} blob_release_data;
 
-static cairo_status_t png_write_to_byte_array(void* closure, const unsigned char* data, unsigned int length)
+static void published_blob_free(published_blob* blob)
 {
-    GByteArray* array = (GByteArray*)closure;
-    g_byte_array_append(array, data, length);
-    return CAIRO_STATUS_SUCCESS;
+    g_bytes_unref(blob->bytes);
+    g_free(blob->mime_type);
+    g_free(blob);
 }
 
-static void on_snapshot_ready(GObject* source, GAsyncResult* result, gpointer user_data)
+static void blob_release(gpointer data)
 {
-    screenshot_ctx* ctx = (screenshot_ctx*)user_data;
-    GError* error = NULL;
-    cairo_surface_t* surface = webkit_web_view_get_snapshot_finish(
-        WEBKIT_WEB_VIEW(source), result, &error);
+    blob_release_data* r = (blob_release_data*)data;
+    if (r->release)
+        r->release(r->context);
+    g_free(r);
+}
 
-    if (error != NULL || surface == NULL)
+static gboolean is_valid_blob_id(const char* id)
+{
+    if (id == NULL || *id == '\0' || strlen(id) > 128)
+        return FALSE;
+    for (const char* p = id; *p; p++)
     {
-        if (error) g_error_free(error);
-        ctx->callback(ctx->context, NULL, 0);
-        free(ctx);
-        return;
+        if (!g_ascii_isalnum(*p) && *p != '-' && *p != '_' && *p != '.')
+            return FALSE;
     }
+    return TRUE;
+}
 
-    GByteArray* array = g_byte_array_new();
-    cairo_status_t status = cairo_surface_write_to_png_stream(surface, png_write_to_byte_array, array);
-    cairo_surface_destroy(surface);
+/* Returns the blob id of <scheme>://<host>/__blob/<id>[?query][#fragment], or NULL. The path
+ * form keeps blob URLs same-origin with pages served from the scheme. */
+static char* blob_id_from_uri(const char* uri)
+{
+    const char* p = uri != NULL ? strstr(uri, "://") : NULL;
+    if (p == NULL)
+        return NULL;
+    p = strchr(p + 3, '/');
+    if (p == NULL || strncmp(p, "/__blob/", 8) != 0)
+        return NULL;
+    p += 8;
+    return g_strndup(p, strcspn(p, "?#"));
+}
 
-    if (status != CAIRO_STATUS_SUCCESS || array->len == 0)
+/* Parses a single "bytes=first-last", "bytes=first-" or "bytes=-suffix" range. Returns
+ * 1 for a satisfiable range, 0 when there is no usable Range header, -1 if unsatisfiable. */
+static int parse_byte_range(const char* header, gsize total, gsize* offset, gsize* length)
+{
+    if (header == NULL || strncmp(header, "bytes=", 6) != 0 || strchr(header, ',') != NULL)
+        return 0;
+
+    const char* spec = header + 6;
+    char* end;
+    if (*spec == '-')
     {
-        g_byte_array_free(array, TRUE);
-        ctx->callback(ctx->context, NULL, 0);
-        free(ctx);
-        return;
+        guint64 suffix = g_ascii_strtoull(spec + 1, &end, 10);
+        if (end == spec + 1 || *end != '\0')
+            return 0;
+        if (suffix == 0 || total == 0)
+            return -1;
+        *length = suffix < total ? (gsize)suffix : total;
+        *offset = total - *length;
+        return 1;
+    }
+
+    guint64 first = g_ascii_strtoull(spec, &end, 10);
+    if (end == spec || *end != '-')
+        return 0;
+    const char* last_spec = end + 1;
+    guint64 last = total > 0 ? total - 1 : 0;
+    if (*last_spec != '\0')
+    {
+        last = g_ascii_strtoull(last_spec, &end, 10);
+        if (end == last_spec || *end != '\0' || last < first)
+            return 0;
+        if (last >= total)
+            last = total - 1;
+    }
+    if (first >= total)
+        return -1;
+
+    *offset = (gsize)first;
+    *length = (gsize)(last - first + 1);
+    return 1;
+}
+
+static gboolean serve_published_blob(shim_state* s, WebKitURISchemeRequest* request, const char* uri)
+{
+    char* id = blob_id_from_uri(uri);
+    if (id == NULL)
+        return FALSE;
+
+    GBytes* bytes = NULL;
+    char* mime_type = NULL;
+    g_mutex_lock(&s->blob_lock);
+    published_blob* blob = (published_blob*)g_hash_table_lookup(s->blobs, id);
+    if (blob != NULL)
+    {
+        bytes = g_bytes_ref(blob->bytes);
+        mime_type = g_strdup(blob->mime_type);
+    }
+    g_mutex_unlock(&s->blob_lock);
+    g_free(id);
+
+    if (bytes == NULL)
+    {
+        GError* err = g_error_new_literal(g_quark_from_string("ag-webkit"), 404, "Blob not found or revoked");
+        webkit_uri_scheme_request_finish_error(request, err);
+        g_error_free(err);
+        return TRUE;
     }
 
-    ctx->callback(ctx->context, array->data, (uint32_t)array->len);
-    g_byte_array_free(array, TRUE);
-    free(ctx);
-}
-
-void ag_gtk_capture_screenshot(ag_gtk_handle handle, ag_gtk_screenshot_cb callback, void* context)
-{
-    if (!handle)
+    gsize total = g_bytes_get_size(bytes);
+    gsize offset = 0;
+    gsize length = total;
+    SoupMessageHeaders* request_headers = webkit_uri_scheme_request_get_http_headers(request);
+    int range = parse_byte_range(
+        request_headers != NULL ? soup_message_headers_get_one(request_headers, "Range") : NULL,
+        total, &offset, &length);
+
+    SoupMessageHeaders* headers = soup_message_headers_new(SOUP_MESSAGE_HEADERS_RESPONSE);
+    soup_message_headers_replace(headers, "Accept-Ranges", "bytes");
+    soup_message_headers_replace(headers, "Cache-Control", "no-store");
+
+    GInputStream* stream;
+    WebKitURISchemeResponse* response;
+    if (range < 0)
     {
-        callback(context, NULL, 0);
-        return;
+        char* content_range = g_strdup_printf("bytes */%" G_GSIZE_FORMAT, total);
+        soup_message_headers_replace(headers, "Content-Range", content_range);
+        g_free(content_range);
+        stream = g_memory_input_stream_new();
+        response = webkit_uri_scheme_response_new(stream, 0);
+        webkit_uri_scheme_response_set_status(response, 416, "Range Not Satisfiable");
     }
-    shim_state* s = (shim_state*)handle;
-    if (s->web_view == NULL || atomic_load(&s->detached))
+    else
     {
-        callback(context, NULL, 0);
-        return;
+        /* A sub-range view of the same buffer: no copy, and it keeps the blob alive. */
+        GBytes* slice = g_bytes_new_from_bytes(bytes, offset, length);
+        stream = g_memory_input_stream_new_from_bytes(slice);
+        g_bytes_unref(slice);
+        response = webkit_uri_scheme_response_new(stream, (gint64)length);
+        if (range > 0)
+        {
+            char* content_range = g_strdup_printf("bytes %" G_GSIZE_FORMAT "-%" G_GSIZE_FORMAT "/%" G_GSIZE_FORMAT,
+                offset, offset + length - 1, total);
+            soup_message_headers_replace(headers, "Content-Range", content_range);
+            g_free(content_range);
+            webkit_uri_scheme_response_set_status(response, 206, "Partial Content");
+        }
     }
 
-    screenshot_ctx* ctx = (screenshot_ctx*)malloc(sizeof(screenshot_ctx));
-    ctx->callback = callback;
-    ctx->context = context;
+    webkit_uri_scheme_response_set_content_type(response, mime_type);
+    webkit_uri_scheme_response_set_http_headers(response, headers); /* takes ownership */
+    webkit_uri_scheme_request_finish_with_response(request, response);
 
-    webkit_web_view_get_snapshot(
-        s->web_view,
-        WEBKIT_SNAPSHOT_REGION_VISIBLE,
-        WEBKIT_SNAPSHOT_OPTIONS_NONE,
-        NULL,
-        on_snapshot_ready,
-        ctx);
+    g_object_unref(response);
+    g_object_unref(stream);
+    g_bytes_unref(bytes);
+    g_free(mime_type);
+    return TRUE;
 }
 
-/* ========== Print to PDF ========== */
-
-typedef void (*ag_gtk_pdf_cb)(void* context, const void* pdf_data, uint32_t pdf_len);
-
-typedef struct {
-    ag_gtk_pdf_cb callback;
-    void* context;
-    char* temp_path;
-} pdf_ctx;
-
-static void on_pdf_print_finished(WebKitPrintOperation* operation, gpointer user_data)
+/* Serves [data, data + length) at <scheme>://<host>/__blob/<id> on every custom scheme of the
+ * view, without copying. The memory must stay valid and unchanged until release(context) runs.
+ * An id stays taken until it is revoked, so a response never switches buffers mid-range.
+ * Returns one of the AG_GTK_BLOB_* codes. */
+int32_t ag_gtk_publish_blob(ag_gtk_handle handle, const char* id, const void* data, int64_t length,
+                            const char* mime_type, ag_gtk_blob_release_cb release, void* context)
 {
-    (void)operation;
-    pdf_ctx* ctx = (pdf_ctx*)user_data;
-    if (!ctx) return;
+    if (!handle || !is_valid_blob_id(id) || length < 0 || (data == NULL && length > 0))
+        return AG_GTK_BLOB_INVALID_ID;
+    shim_state* s = (shim_state*)handle;
+    if (atomic_load(&s->detached))
+        return AG_GTK_BLOB_UNAVAILABLE;
 
-    if (ctx->temp_path)
+    blob_release_data* r = g_try_new(blob_release_data, 1);
+    published_blob* blob = g_try_new(published_blob, 1);
+    if (r == NULL || blob == NULL)
     {
-        gchar* contents = NULL;
-        gsize length = 0;
-        if (g_file_get_contents(ctx->temp_path, &contents, &length, NULL) && contents)
-        {
-            ctx->callback(ctx->context, contents, (uint32_t)length);
-            g_free(contents);
-        }
-        else
-        {
-            ctx->callback(ctx->context, NULL, 0);
-        }
-        g_unlink(ctx->temp_path);
-        free(ctx->temp_path);
+        g_free(r);
+        g_free(blob);
+        return AG_GTK_BLOB_NO_MEMORY;
     }
-    else
+    r->release = release;
+    r->context = context;
+    blob->bytes = g_bytes_new_with_free_func(data, (gsize)length, blob_release, r);
+    blob->mime_type = g_strdup(mime_type != NULL && *mime_type ? mime_type : "application/octet-stream");
+
+    g_mutex_lock(&s->blob_lock);
+    gboolean duplicate = g_hash_table_contains(s->blobs, id);
+    if (!duplicate)
+        g_hash_table_insert(s->blobs, g_strdup(id), blob);
+    g_mutex_unlock(&s->blob_lock);
+
+    if (duplicate)
     {
-        ctx->callback(ctx->context, NULL, 0);
+        /* Freed outside the lock, and without calling back: the caller keeps its buffer. */
+        r->release = NULL;
+        published_blob_free(blob);
+        return AG_GTK_BLOB_DUPLICATE_ID;
     }
-    free(ctx);
+    return AG_GTK_BLOB_PUBLISHED;
 }
 
-static void on_pdf_print_failed(WebKitPrintOperation* operation, GError* error, gpointer user_data)
+/* Stops serving the blob; its memory is released once in-flight responses finish. */
+bool ag_gtk_revoke_blob(ag_gtk_handle handle, const char* id)
 {
-    (void)operation;
-    (void)error;
-    pdf_ctx* ctx = (pdf_ctx*)user_data;
-    if (!ctx) return;
+    if (!handle || !id) return false;
+    shim_state* s = (shim_state*)handle;
 
-    ctx->callback(ctx->context, NULL, 0);
-    if (ctx->temp_path)
-    {
-        g_unlink(ctx->temp_path);
-        free(ctx->temp_path);
-    }
-    free(ctx);
+    /* Steal under the lock, release outside it: the release callback may re-enter the shim. */
+    gpointer key = NULL;
+    gpointer value = NULL;
+    g_mutex_lock(&s->blob_lock);
+    gboolean found = g_hash_table_steal_extended(s->blobs, id, &key, &value);
+    g_mutex_unlock(&s->blob_lock);
+
+    if (!found)
+        return false;
+    g_free(key);
+    published_blob_free((published_blob*)value);
+    return true;
 }
 
-void ag_gtk_print_to_pdf(ag_gtk_handle handle, ag_gtk_pdf_cb callback, void* context)
+/* ========== Pending operations ========== */
+
+typedef struct
 {
-    if (!handle)
-    {
-        callback(context, NULL, 0);
-        return;
-    }
+    uint64_t id;
+    int32_t kind;       /* AG_GTK_OP_* */
+    int32_t completing; /* already answered (detach), waiting for WebKit to finish with it */
+    int64_t age_us;
+} ag_gtk_pending_op;
+
+typedef void (*ag_gtk_pending_ops_cb)(void* context, const ag_gtk_pending_op* ops, int32_t count);
+
+/* Lists the operations that currently hold a slot on the view. Any thread; the callback runs
+ * before this returns and the array is only valid during it. */
+void ag_gtk_get_pending_ops(ag_gtk_handle handle, ag_gtk_pending_ops_cb callback, void* context)
+{
+    if (!handle || !callback) return;
     shim_state* s = (shim_state*)handle;
-    if (s->web_view == NULL || atomic_load(&s->detached))
-    {
-        callback(context, NULL, 0);
-        return;
-    }
+    op_table* t = s->ops;
 
-    pdf_ctx* ctx = (pdf_ctx*)calloc(1, sizeof(pdf_ctx));
-    ctx->callback = callback;
-    ctx->context = context;
+    GArray* ops = g_array_new(FALSE, FALSE, sizeof(ag_gtk_pending_op));
+    gint64 now = g_get_monotonic_time();
 
-    /* Generate a unique temp file path for the PDF output. */
-    char temp_template[] = "/tmp/fulora_print_XXXXXX";
-    int fd = mkstemp(temp_template);
-    if (fd < 0)
+    g_mutex_lock(&t->lock);
+    for (uint32_t i = 0; i < t->used; i++)
     {
-        callback(context, NULL, 0);
-        free(ctx);
-        return;
+        op_slot* slot = op_slot_at(t, i);
+        if (!slot->in_use)
+            continue;
+        ag_gtk_pending_op op = { slot->id, slot->kind, atomic_load(&slot->live) == 0, now - slot->started_us };
+        g_array_append_val(ops, op);
     }
-    close(fd);
-    /* Rename with .pdf extension for GTK print settings. */
-    char pdf_path[256];
-    snprintf(pdf_path, sizeof(pdf_path), "%s.pdf", temp_template);
-    rename(temp_template, pdf_path);
-    ctx->temp_path = strdup(pdf_path);
+    g_mutex_unlock(&t->lock);
 
-    WebKitPrintOperation* print_op = webkit_print_operation_new(s->web_view);
+    callback(context, (const ag_gtk_pending_op*)(void*)ops->data, (int32_t)ops->len);
+    g_array_free(ops, TRUE);
+}
 
-    GtkPrintSettings* settings = gtk_print_settings_new();
-    gtk_print_settings_set_printer(settings, "Print to File");
-    gtk_print_settings_set(settings, GTK_PRINT_SETTINGS_OUTPUT_FILE_FORMAT, "pdf");
+/* ========== Offscreen composition ========== */
 
-    gchar* file_uri = g_filename_to_uri(ctx->temp_path, NULL, NULL);
-    if (file_uri)
+/* Frames are handed over through a ring of three buffers: the consumer holds at most one, the
+ * newest published one is never overwritten, so the GTK thread always has a buffer to fill.
+ * Each buffer tracks the regions it is missing and only those are copied from the offscreen
+ * surface. */
+
+#define OFFSCREEN_BUFFERS 3
+
+typedef struct
+{
+    uint8_t* data;           /* ARGB32, premultiplied, native byte order */
+    int32_t width;
+    int32_t height;
+    int32_t stride;
+    cairo_region_t* stale;   /* GTK thread: damage not yet copied into this buffer */
+    uint64_t sequence;
+} offscreen_buffer;
+
+struct offscreen_ring
+{
+    offscreen_buffer buffers[OFFSCREEN_BUFFERS];
+
+    /* GTK thread only. */
+    cairo_region_t* damage;  /* damage since the last flush */
+    gint64 damage_since_us;
+    guint flush_id;
+    uint64_t next_sequence;
+    gboolean focused;
+
+    /* Handoff with the consumer, any thread. */
+    GMutex lock;
+    int latest;              /* newest published buffer, -1 = none */
+    int reading;             /* buffer held by the consumer, -1 = none */
+    uint64_t acquired_sequence;
+    int32_t acquired_width;
+    int32_t acquired_height;
+    cairo_region_t* unread;  /* damage published since the consumer's last acquire */
+    gint64 unread_since_us;
+    uint64_t frames_published;
+    uint64_t frames_dropped; /* published, then superseded before the consumer took them */
+    gboolean orphaned;       /* destroyed while a frame was held; freed on its release */
+};
+
+typedef struct
+{
+    const uint8_t* data;
+    int32_t width;
+    int32_t height;
+    int32_t stride;
+    int32_t dirty_x;
+    int32_t dirty_y;
+    int32_t dirty_width;
+    int32_t dirty_height;
+    uint64_t sequence;
+    int64_t latency_us; /* from the oldest damage first shown in this frame to its acquire */
+} ag_gtk_offscreen_frame;
+
+static gboolean offscreen_flush(gpointer user_data)
+{
+    shim_state* s = (shim_state*)user_data;
+    offscreen_ring* r = s->offscreen;
+    r->flush_id = 0;
+    if (s->plug == NULL || cairo_region_is_empty(r->damage))
+        return G_SOURCE_REMOVE;
+
+    cairo_surface_t* source = gtk_offscreen_window_get_surface(GTK_OFFSCREEN_WINDOW(s->plug));
+    int32_t width = gtk_widget_get_allocated_width(s->plug);
+    int32_t height = gtk_widget_get_allocated_height(s->plug);
+    if (source == NULL || width <= 0 || height <= 0)
+        return G_SOURCE_REMOVE;
+
+    g_mutex_lock(&r->lock);
+    int index = 0;
+    while (index == r->latest || index == r->reading)
+        index++;
+    g_mutex_unlock(&r->lock);
+
+    gint64 started = g_get_monotonic_time();
+    for (int i = 0; i < OFFSCREEN_BUFFERS; i++)
+        cairo_region_union(r->buffers[i].stale, r->damage);
+
+    offscreen_buffer* b = &r->buffers[index];
+    if (b->width != width || b->height != height)
     {
-        gtk_print_settings_set(settings, GTK_PRINT_SETTINGS_OUTPUT_URI, file_uri);
-        g_free(file_uri);
+        g_free(b->data);
+        b->width = width;
+        b->height = height;
+        b->stride = cairo_format_stride_for_width(CAIRO_FORMAT_ARGB32, width);
+        b->data = g_malloc0((gsize)b->stride * (gsize)height);
+        cairo_rectangle_int_t all = { 0, 0, width, height };
+        cairo_region_union_rectangle(b->stale, &all);
     }
-    webkit_print_operation_set_print_settings(print_op, settings);
-
-    GtkPageSetup* page_setup = gtk_page_setup_new();
-    gtk_page_setup_set_paper_size(page_setup, gtk_paper_size_new(GTK_PAPER_NAME_A4));
-    webkit_print_operation_set_page_setup(print_op, page_setup);
 
-    g_signal_connect(print_op, "finished", G_CALLBACK(on_pdf_print_finished), ctx);
-    g_signal_connect(print_op, "failed", G_CALLBACK(on_pdf_print_failed), ctx);
+    cairo_surface_t* target = cairo_image_surface_create_for_data(b->data, CAIRO_FORMAT_ARGB32,
+        b->width, b->height, b->stride);
+    cairo_t* cr = cairo_create(target);
+    gdk_cairo_region(cr, b->stale);
+    cairo_clip(cr);
+    cairo_set_operator(cr, CAIRO_OPERATOR_SOURCE);
+    cairo_set_source_surface(cr, source, 0, 0);
+    cairo_paint(cr);
+    cairo_destroy(cr);
+    cairo_surface_flush(target);
+    cairo_surface_destroy(target);
+    cairo_region_destroy(b->stale);
+    b->stale = cairo_region_create();
+    b->sequence = ++r->next_sequence;
+    gint64 copy_us = g_get_monotonic_time() - started;
+
+    g_mutex_lock(&r->lock);
+    if (r->latest >= 0 && r->buffers[r->latest].sequence > r->acquired_sequence)
+        r->frames_dropped++;
+    r->latest = index;
+    r->frames_published++;
+    cairo_region_union(r->unread, r->damage);
+    if (r->unread_since_us == 0)
+        r->unread_since_us = r->damage_since_us;
+    g_mutex_unlock(&r->lock);
+
+    cairo_region_destroy(r->damage);
+    r->damage = cairo_region_create();
+    r->damage_since_us = 0;
+
+    if (s->callbacks.on_offscreen_frame)
+        s->callbacks.on_offscreen_frame(s->user_data, b->sequence, copy_us);
+    return G_SOURCE_REMOVE;
+}
 
-    webkit_print_operation_print(print_op);
+/* Damage arrives once per painted area; the copy runs once WebKit is done painting. */
+static gboolean on_offscreen_damage(GtkWidget* widget, GdkEventExpose* event, gpointer user_data)
+{
+    (void)widget;
+    shim_state* s = (shim_state*)user_data;
+    offscreen_ring* r = s->offscreen;
+
+    cairo_region_union_rectangle(r->damage, &event->area);
+    if (r->damage_since_us == 0)
+        r->damage_since_us = g_get_monotonic_time();
+    if (r->flush_id == 0)
+        r->flush_id = g_idle_add_full(G_PRIORITY_HIGH_IDLE + 20, offscreen_flush, s, NULL);
+    return FALSE;
+}
 
-    g_object_unref(settings);
-    g_object_unref(page_setup);
+static GtkWidget* offscreen_create_window(shim_state* s)
+{
+    offscreen_ring* r = g_new0(offscreen_ring, 1);
+    for (int i = 0; i < OFFSCREEN_BUFFERS; i++)
+        r->buffers[i].stale = cairo_region_create();
+    r->damage = cairo_region_create();
+    r->unread = cairo_region_create();
+    r->latest = -1;
+    r->reading = -1;
+    g_mutex_init(&r->lock);
+    g_mutex_lock(&s->offscreen_lock);
+    s->offscreen = r;
+    g_mutex_unlock(&s->offscreen_lock);
+
+    GtkWidget* window = gtk_offscreen_window_new();
+    gtk_window_set_default_size(GTK_WINDOW(window),
+        s->offscreen_width > 0 ? s->offscreen_width : 800,
+        s->offscreen_height > 0 ? s->offscreen_height : 600);
+    g_signal_connect(window, "damage-event", G_CALLBACK(on_offscreen_damage), s);
+    return window;
 }
 
-/* ========== Zoom ========== */
+static void offscreen_ring_free(offscreen_ring* r)
+{
+    for (int i = 0; i < OFFSCREEN_BUFFERS; i++)
+    {
+        g_free(r->buffers[i].data);
+        cairo_region_destroy(r->buffers[i].stale);
+    }
+    cairo_region_destroy(r->damage);
+    cairo_region_destroy(r->unread);
+    g_mutex_clear(&r->lock);
+    g_free(r);
+}
 
-double ag_gtk_get_zoom(ag_gtk_handle handle)
+/* After the offscreen window is destroyed. The consumer may be acquiring a frame on another
+ * thread: the ring is unpublished under offscreen_lock, and a frame still held keeps the ring
+ * until ag_gtk_offscreen_release_frame. */
+static void offscreen_destroy(shim_state* s)
 {
-    if (!handle) return 1.0;
-    shim_state* s = (shim_state*)handle;
-    if (s->web_view == NULL || atomic_load(&s->detached)) return 1.0;
-    return webkit_web_view_get_zoom_level(s->web_view);
+    offscreen_ring* r = s->offscreen;
+    if (r == NULL) return;
+
+    if (r->flush_id != 0)
+        g_source_remove(r->flush_id);
+    r->flush_id = 0;
+
+    g_mutex_lock(&s->offscreen_lock);
+    s->offscreen = NULL;
+    gboolean held = s->offscreen_held == r;
+    r->orphaned = held;
+    g_mutex_unlock(&s->offscreen_lock);
+
+    if (!held)
+        offscreen_ring_free(r);
 }
 
-void ag_gtk_set_zoom(ag_gtk_handle handle, double zoom_factor)
+/* Before attach. width/height are the initial size in pixels (0 = 800x600). */
+void ag_gtk_set_offscreen_rendering(ag_gtk_handle handle, bool enabled, int32_t width, int32_t height)
 {
     if (!handle) return;
     shim_state* s = (shim_state*)handle;
-    if (s->web_view == NULL || atomic_load(&s->detached)) return;
-    webkit_web_view_set_zoom_level(s->web_view, zoom_factor);
+    s->opt_offscreen = enabled;
+    s->offscreen_width = width;
+    s->offscreen_height = height;
 }
 
-/* ========== Find in Page ========== */
-
-typedef void (*ag_gtk_find_cb)(void* context, int32_t active_match_index, int32_t total_matches);
-
-typedef struct {
-    ag_gtk_find_cb callback;
-    void* context;
-    gulong counted_id;
-    gulong failed_id;
-} find_ctx;
+typedef struct
+{
+    shim_state* state;
+    int32_t width;
+    int32_t height;
+} offscreen_resize_data;
 
-static void on_counted_matches(WebKitFindController* controller, guint match_count, gpointer user_data)
+static void do_offscreen_resize(void* data)
 {
-    find_ctx* ctx = (find_ctx*)user_data;
-    /* We report match_count; active index isn't directly available in WebKitGTK find API.
-       Report 0 as active index when matches found. */
-    int32_t active = match_count > 0 ? 0 : -1;
-    if (ctx->counted_id) g_signal_handler_disconnect(controller, ctx->counted_id);
-    if (ctx->failed_id) g_signal_handler_disconnect(controller, ctx->failed_id);
-    ctx->callback(ctx->context, active, (int32_t)match_count);
-    free(ctx);
+    offscreen_resize_data* d = (offscreen_resize_data*)data;
+    shim_state* s = d->state;
+    s->offscreen_width = d->width;
+    s->offscreen_height = d->height;
+    if (s->offscreen != NULL && s->plug != NULL)
+        gtk_window_resize(GTK_WINDOW(s->plug), d->width, d->height);
 }
 
-static void on_failed_to_find(WebKitFindController* controller, gpointer user_data)
+void ag_gtk_offscreen_resize(ag_gtk_handle handle, int32_t width, int32_t height)
 {
-    find_ctx* ctx = (find_ctx*)user_data;
-    if (ctx->counted_id) g_signal_handler_disconnect(controller, ctx->counted_id);
-    if (ctx->failed_id) g_signal_handler_disconnect(controller, ctx->failed_id);
-    ctx->callback(ctx->context, -1, 0);
-    free(ctx);
+    if (!handle || width <= 0 || height <= 0) return;
+    offscreen_resize_data d = { (shim_state*)handle, width, height };
+    run_on_gtk_thread(do_offscreen_resize, &d);
 }
 
-void ag_gtk_find_text(ag_gtk_handle handle, const char* text, int case_sensitive, int forward, ag_gtk_find_cb callback, void* context)
+/* Any thread. Takes the newest frame not yet acquired; false when there is none or a frame is
+ * still held. The dirty rectangle covers everything changed since the previous acquire, so a
+ * consumer keeping its own copy only needs that area. The frame stays valid until
+ * ag_gtk_offscreen_release_frame, even across detach. */
+bool ag_gtk_offscreen_acquire_frame(ag_gtk_handle handle, ag_gtk_offscreen_frame* out)
 {
-    if (!handle)
+    if (!handle || !out) return false;
+    shim_state* s = (shim_state*)handle;
+
+    g_mutex_lock(&s->offscreen_lock);
+    offscreen_ring* r = s->offscreen;
+    if (r == NULL || s->offscreen_held != NULL) /* a frame of an earlier ring is still held */
     {
-        callback(context, -1, 0);
-        return;
+        g_mutex_unlock(&s->offscreen_lock);
+        return false;
     }
-    shim_state* s = (shim_state*)handle;
-    if (s->web_view == NULL || atomic_load(&s->detached))
+
+    g_mutex_lock(&r->lock);
+    if (r->latest < 0 || r->reading >= 0 || r->buffers[r->latest].sequence <= r->acquired_sequence)
     {
-        callback(context, -1, 0);
-        return;
+        g_mutex_unlock(&r->lock);
+        g_mutex_unlock(&s->offscreen_lock);
+        return false;
     }
+    s->offscreen_held = r;
 
-    WebKitFindController* fc = webkit_web_view_get_find_controller(s->web_view);
+    offscreen_buffer* b = &r->buffers[r->latest];
+    r->reading = r->latest;
+    r->acquired_sequence = b->sequence;
 
-    find_ctx* ctx = (find_ctx*)calloc(1, sizeof(find_ctx));
-    ctx->callback = callback;
-    ctx->context = context;
+    cairo_rectangle_int_t dirty = { 0, 0, b->width, b->height };
+    if (b->width == r->acquired_width && b->height == r->acquired_height)
+    {
+        cairo_region_intersect_rectangle(r->unread, &dirty);
+        cairo_region_get_extents(r->unread, &dirty);
+    }
+    r->acquired_width = b->width;
+    r->acquired_height = b->height;
+
+    out->data = b->data;
+    out->width = b->width;
+    out->height = b->height;
+    out->stride = b->stride;
+    out->dirty_x = dirty.x;
+    out->dirty_y = dirty.y;
+    out->dirty_width = dirty.width;
+    out->dirty_height = dirty.height;
+    out->sequence = b->sequence;
+    out->latency_us = r->unread_since_us != 0 ? g_get_monotonic_time() - r->unread_since_us : 0;
+
+    cairo_region_destroy(r->unread);
+    r->unread = cairo_region_create();
+    r->unread_since_us = 0;
+    g_mutex_unlock(&r->lock);
+    g_mutex_unlock(&s->offscreen_lock);
+    return true;
+}
 
-    ctx->counted_id = g_signal_connect(fc, "counted-matches", G_CALLBACK(on_counted_matches), ctx);
-    ctx->failed_id = g_signal_connect(fc, "failed-to-find-text", G_CALLBACK(on_failed_to_find), ctx);
+void ag_gtk_offscreen_release_frame(ag_gtk_handle handle)
+{
+    if (!handle) return;
+    shim_state* s = (shim_state*)handle;
 
-    guint32 options = WEBKIT_FIND_OPTIONS_WRAP_AROUND;
-    if (!case_sensitive) options |= WEBKIT_FIND_OPTIONS_CASE_INSENSITIVE;
-    if (!forward) options |= WEBKIT_FIND_OPTIONS_BACKWARDS;
+    g_mutex_lock(&s->offscreen_lock);
+    offscreen_ring* r = s->offscreen_held;
+    s->offscreen_held = NULL;
+    gboolean orphaned = r != NULL && r->orphaned;
+    if (r != NULL && !orphaned)
+    {
+        g_mutex_lock(&r->lock);
+        r->reading = -1;
+        g_mutex_unlock(&r->lock);
+    }
+    g_mutex_unlock(&s->offscreen_lock);
 
-    webkit_find_controller_search(fc, text, options, G_MAXUINT);
-    webkit_find_controller_count_matches(fc, text, options, G_MAXUINT);
+    if (orphaned)
+        offscreen_ring_free(r);
 }
 
-void ag_gtk_stop_find(ag_gtk_handle handle)
+void ag_gtk_offscreen_get_stats(ag_gtk_handle handle, uint64_t* out_published, uint64_t* out_dropped)
 {
+    *out_published = 0;
+    *out_dropped = 0;
     if (!handle) return;
     shim_state* s = (shim_state*)handle;
-    if (s->web_view == NULL || atomic_load(&s->detached)) return;
 
-    WebKitFindController* fc = webkit_web_view_get_find_controller(s->web_view);
-    webkit_find_controller_search_finish(fc);
+    g_mutex_lock(&s->offscreen_lock);
+    offscreen_ring* r = s->offscreen;
+    if (r != NULL)
+    {
+        g_mutex_lock(&r->lock);
+        *out_published = r->frames_published;
+        *out_dropped = r->frames_dropped;
+        g_mutex_unlock(&r->lock);
+    }
+    g_mutex_unlock(&s->offscreen_lock);
 }
 
-/* ========== Preload Scripts ========== */
+/* Input forwarded by the host in offscreen mode, in view pixels. modifiers are GdkModifierType
+ * bits; button uses GDK numbering (1 = primary). */
+#define AG_GTK_INPUT_MOTION         0
+#define AG_GTK_INPUT_BUTTON_PRESS   1
+#define AG_GTK_INPUT_BUTTON_RELEASE 2
+#define AG_GTK_INPUT_SCROLL         3
+#define AG_GTK_INPUT_KEY_PRESS      4
+#define AG_GTK_INPUT_KEY_RELEASE    5
+#define AG_GTK_INPUT_FOCUS_IN       6
+#define AG_GTK_INPUT_FOCUS_OUT      7
 
-static int64_t g_script_id_counter = 0;
+typedef struct
+{
+    int32_t type;
+    uint32_t time_ms;
+    double x;
+    double y;
+    double delta_x;
+    double delta_y;
+    uint32_t button;
+    uint32_t keyval;
+    uint32_t modifiers;
+} ag_gtk_input_event;
 
-const char* ag_gtk_add_user_script(ag_gtk_handle handle, const char* js)
+typedef struct
 {
-    if (!handle || !js) return NULL;
-    shim_state* s = (shim_state*)handle;
-    if (s->web_view == NULL || atomic_load(&s->detached)) return NULL;
+    shim_state* state;
+    const ag_gtk_input_event* input;
+    gboolean result;
+} offscreen_input_data;
 
-    WebKitUserContentManager* ucm = webkit_web_view_get_user_content_manager(s->web_view);
-    WebKitUserScript* script = webkit_user_script_new(
-        js,
-        WEBKIT_USER_CONTENT_INJECT_ALL_FRAMES,
-        WEBKIT_USER_SCRIPT_INJECT_AT_DOCUMENT_START,
-        NULL, NULL);
-    webkit_user_content_manager_add_script(ucm, script);
-    webkit_user_script_unref(script);
+static void offscreen_send_focus(shim_state* s, gboolean in)
+{
+    offscreen_ring* r = s->offscreen;
+    GdkWindow* window = gtk_widget_get_window(s->plug);
+    if (r->focused == in || window == NULL)
+        return;
+    r->focused = in;
+
+    GdkEvent* event = gdk_event_new(GDK_FOCUS_CHANGE);
+    event->focus_change.window = g_object_ref(window);
+    event->focus_change.send_event = TRUE;
+    event->focus_change.in = in;
+    gdk_event_set_device(event, gdk_seat_get_keyboard(gdk_display_get_default_seat(gdk_window_get_display(window))));
+    gtk_main_do_event(event);
+    gdk_event_free(event);
+}
 
-    int64_t id = ++g_script_id_counter;
-    char buf[32];
-    snprintf(buf, sizeof(buf), "preload_%lld", (long long)id);
-    return strdup(buf);
+static void do_offscreen_send_input(void* data)
+{
+    offscreen_input_data* d = (offscreen_input_data*)data;
+    shim_state* s = d->state;
+    const ag_gtk_input_event* in = d->input;
+    d->result = FALSE;
+    if (atomic_load(&s->detached) || s->offscreen == NULL || s->web_view == NULL)
+        return;
+
+    GdkWindow* window = gtk_widget_get_window(GTK_WIDGET(s->web_view));
+    if (window == NULL)
+        return;
+    GdkSeat* seat = gdk_display_get_default_seat(gdk_window_get_display(window));
+    GdkEvent* event = NULL;
+
+    switch (in->type)
+    {
+        case AG_GTK_INPUT_MOTION:
+            event = gdk_event_new(GDK_MOTION_NOTIFY);
+            event->motion.x = event->motion.x_root = in->x;
+            event->motion.y = event->motion.y_root = in->y;
+            event->motion.state = in->modifiers;
+            event->motion.time = in->time_ms;
+            break;
+        case AG_GTK_INPUT_BUTTON_PRESS:
+        case AG_GTK_INPUT_BUTTON_RELEASE:
+            if (in->type == AG_GTK_INPUT_BUTTON_PRESS)
+            {
+                offscreen_send_focus(s, TRUE);
+                gtk_widget_grab_focus(GTK_WIDGET(s->web_view));
+            }
+            event = gdk_event_new(in->type == AG_GTK_INPUT_BUTTON_PRESS ? GDK_BUTTON_PRESS : GDK_BUTTON_RELEASE);
+            event->button.x = event->button.x_root = in->x;
+            event->button.y = event->button.y_root = in->y;
+            event->button.button = in->button;
+            event->button.state = in->modifiers;
+            event->button.time = in->time_ms;
+            break;
+        case AG_GTK_INPUT_SCROLL:
+            event = gdk_event_new(GDK_SCROLL);
+            event->scroll.x = event->scroll.x_root = in->x;
+            event->scroll.y = event->scroll.y_root = in->y;
+            event->scroll.direction = GDK_SCROLL_SMOOTH;
+            event->scroll.delta_x = in->delta_x;
+            event->scroll.delta_y = in->delta_y;
+            event->scroll.state = in->modifiers;
+            event->scroll.time = in->time_ms;
+            break;
+        case AG_GTK_INPUT_KEY_PRESS:
+        case AG_GTK_INPUT_KEY_RELEASE:
+        {
+            /* Key events go to the toplevel, which routes them to its focus widget. */
+            window = gtk_widget_get_window(s->plug);
+            if (window == NULL)
+                return;
+            event = gdk_event_new(in->type == AG_GTK_INPUT_KEY_PRESS ? GDK_KEY_PRESS : GDK_KEY_RELEASE);
+            event->key.keyval = in->keyval;
+            event->key.state = in->modifiers;
+            event->key.time = in->time_ms;
+            GdkKeymapKey* keys = NULL;
+            gint n_keys = 0;
+            if (gdk_keymap_get_entries_for_keyval(gdk_keymap_get_for_display(gdk_window_get_display(window)),
+                    in->keyval, &keys, &n_keys) && n_keys > 0)
+            {
+                event->key.hardware_keycode = (guint16)keys[0].keycode;
+                event->key.group = (guint8)keys[0].group;
+            }
+            g_free(keys);
+            break;
+        }
+        case AG_GTK_INPUT_FOCUS_IN:
+        case AG_GTK_INPUT_FOCUS_OUT:
+            offscreen_send_focus(s, in->type == AG_GTK_INPUT_FOCUS_IN);
+            d->result = TRUE;
+            return;
+        default:
+            return;
+    }
+
+    event->any.window = g_object_ref(window);
+    event->any.send_event = TRUE;
+    gboolean is_key = in->type == AG_GTK_INPUT_KEY_PRESS || in->type == AG_GTK_INPUT_KEY_RELEASE;
+    gdk_event_set_device(event, is_key ? gdk_seat_get_keyboard(seat) : gdk_seat_get_pointer(seat));
+    gtk_main_do_event(event);
+    gdk_event_free(event);
+    d->result = TRUE;
 }
 
-void ag_gtk_remove_all_user_scripts(ag_gtk_handle handle)
+bool ag_gtk_offscreen_send_input(ag_gtk_handle handle, const ag_gtk_input_event* input)
 {
-    if (!handle) return;
-    shim_state* s = (shim_state*)handle;
-    if (s->web_view == NULL || atomic_load(&s->detached)) return;
+    if (!handle || !input) return false;
+    offscreen_input_data d = { (shim_state*)handle, input, FALSE };
+    run_on_gtk_thread(do_offscreen_send_input, &d);
+    return d.result;
+}
 
-    WebKitUserContentManager* ucm = webkit_web_view_get_user_content_manager(s->web_view);
-    webkit_user_content_manager_remove_all_scripts(ucm);
+/* ========== Resource statistics ========== */
+
+typedef struct
+{
+    int64_t live_views;            /* created and not yet destroyed */
+    int64_t attached_views;
+    int64_t op_tables;             /* includes tables of destroyed views with operations in flight */
+    int64_t outstanding_ops;
+    int32_t instance_counts;       /* 1 when GOBJECT_DEBUG=instance-count fills the fields below */
+    int32_t reserved;
+    int64_t web_views;             /* WebKitWebView, including preload views */
+    int64_t user_content_managers;
+    int64_t web_contexts;
+    int64_t downloads;
+    int64_t plugs;
+    int64_t offscreen_windows;
+} ag_gtk_resource_stats;
+
+static gboolean instance_counting_enabled(void)
+{
+    const char* flags = g_getenv("GOBJECT_DEBUG");
+    return flags != NULL && (strstr(flags, "instance-count") != NULL || strstr(flags, "all") != NULL);
+}
+
+/* Process-wide; any thread. GObject instance counts are only maintained when GOBJECT_DEBUG
+ * contained instance-count before GObject initialised, and read 0 otherwise. */
+void ag_gtk_get_resource_stats(ag_gtk_resource_stats* out)
+{
+    if (out == NULL) return;
+    memset(out, 0, sizeof(*out));
+    out->live_views = atomic_load(&g_live_views);
+    out->attached_views = atomic_load(&g_attached_views);
+    out->op_tables = atomic_load(&g_live_op_tables);
+    out->outstanding_ops = atomic_load(&g_outstanding_ops);
+
+    if (!instance_counting_enabled())
+        return;
+    out->instance_counts = 1;
+    out->web_views = g_type_get_instance_count(WEBKIT_TYPE_WEB_VIEW);
+    out->user_content_managers = g_type_get_instance_count(WEBKIT_TYPE_USER_CONTENT_MANAGER);
+    out->web_contexts = g_type_get_instance_count(WEBKIT_TYPE_WEB_CONTEXT);
+    out->downloads = g_type_get_instance_count(WEBKIT_TYPE_DOWNLOAD);
+    out->plugs = g_type_get_instance_count(GTK_TYPE_PLUG);
+    out->offscreen_windows = g_type_get_instance_count(GTK_TYPE_OFFSCREEN_WINDOW);
 }
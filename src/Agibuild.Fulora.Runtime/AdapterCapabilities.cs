@@ -12,13 +12,45 @@ namespace Agibuild.Fulora;
 /// reference.
 /// </summary>
 /// <remarks>
-/// Only two capabilities stay opt-in and therefore need a slot here:
+/// Only these capabilities stay opt-in and therefore need a slot here:
 /// <list type="bullet">
 ///   <item><description><see cref="IDragDropAdapter"/> — Android WebView has no
 ///   native drag-and-drop APIs.</description></item>
 ///   <item><description><see cref="IAsyncPreloadScriptAdapter"/> — an async
 ///   refinement of <see cref="IPreloadScriptAdapter"/>; only Windows WebView2
 ///   currently exposes a native async preload entry point.</description></item>
+///   <item><description><see cref="IFetchBridgeAdapter"/> — serving bridge RPC
+///   over a custom-scheme <c>fetch</c> needs request bodies from the engine;
+///   only WebKitGTK 2.40+ provides them.</description></item>
+///   <item><description><see cref="IHostVisibilityAdapter"/> — throttling hidden
+///   pages; the other engines already park hidden views on their own.</description></item>
+///   <item><description><see cref="IRpcDeliveryAdapter"/> — handing RPC envelopes to the
+///   page stub without script evaluation; only the WebKitGTK bridge extension has such a
+///   channel.</description></item>
+///   <item><description><see cref="IBlobPublishingAdapter"/> — serving host memory to the
+///   page by URL; only the WebKitGTK shim implements it.</description></item>
+///   <item><description><see cref="IContentFilterAdapter"/> — compiled content-blocker rule
+///   lists; only WebKitGTK exposes a content-filter store today.</description></item>
+///   <item><description><see cref="ISharedContentSetAdapter"/> — process-wide script and style
+///   sheet sets shared by views; only the WebKitGTK shim implements them.</description></item>
+///   <item><description><see cref="IWebsiteDataAdapter"/> — per-origin website data usage;
+///   only WebKitGTK's data manager reports it.</description></item>
+///   <item><description><see cref="ISpeculativeLoadingAdapter"/> — DNS prefetch and hidden-view
+///   preloading; only the WebKitGTK shim implements them.</description></item>
+///   <item><description><see cref="IResourceTimingAdapter"/> — per-resource load timing
+///   exported as HAR; only the WebKitGTK shim records it.</description></item>
+///   <item><description><see cref="IScriptEvaluationLimitsAdapter"/> — bounding concurrent
+///   and queued script evaluations; only the WebKitGTK shim queues them.</description></item>
+///   <item><description><see cref="IScriptStreamingAdapter"/> — reading large script results
+///   in place; only the WebKitGTK shim hands out its result buffer.</description></item>
+///   <item><description><see cref="IOffscreenRenderingAdapter"/> — frames the host draws itself
+///   instead of a native child window; only the WebKitGTK shim renders offscreen.</description></item>
+///   <item><description><see cref="IDownloadManagementAdapter"/> — deferred destinations,
+///   progress, completion and cancellation of downloads; only the WebKitGTK shim owns its downloads.</description></item>
+///   <item><description><see cref="IActivityStateAdapter"/> — whether a hidden view is throttled
+///   or suspended; only the WebKitGTK shim follows host visibility.</description></item>
+///   <item><description><see cref="IFullPageCaptureAdapter"/> — whole-document captures in
+///   bounded memory; only the WebKitGTK shim tiles the document.</description></item>
 /// </list>
 /// The probe runs exactly once per adapter instance during
 /// <c>WebViewCore</c> construction. A <see langword="null"/> slot means "not
@@ -26,18 +58,47 @@ namespace Agibuild.Fulora;
 /// </remarks>
 internal readonly record struct AdapterCapabilities(
     IDragDropAdapter? DragDrop,
-    IAsyncPreloadScriptAdapter? AsyncPreloadScript)
+    IAsyncPreloadScriptAdapter? AsyncPreloadScript,
+    IFetchBridgeAdapter? FetchBridge,
+    IHostVisibilityAdapter? HostVisibility,
+    IRpcDeliveryAdapter? RpcDelivery,
+    IBlobPublishingAdapter? BlobPublishing,
+    IContentFilterAdapter? ContentFilters,
+    ISharedContentSetAdapter? SharedContentSets,
+    IWebsiteDataAdapter? WebsiteData,
+    ISpeculativeLoadingAdapter? SpeculativeLoading,
+    IResourceTimingAdapter? ResourceTiming,
+    IScriptEvaluationLimitsAdapter? ScriptEvaluationLimits,
+    IScriptStreamingAdapter? ScriptStreaming,
+    IOffscreenRenderingAdapter? OffscreenRendering,
+    IDownloadManagementAdapter? DownloadManagement,
+    IActivityStateAdapter? ActivityState,
+    IFullPageCaptureAdapter? FullPageCapture)
 {
     /// <summary>
     /// Performs the one-shot optional-capability negotiation against
-    /// <paramref name="adapter"/>, producing a snapshot of the two opt-in
-    /// slots.
+    /// <paramref name="adapter"/>, producing a snapshot of the opt-in slots.
     /// </summary>
     public static AdapterCapabilities From(IWebViewAdapter adapter)
     {
         ArgumentNullException.ThrowIfNull(adapter);
         return new AdapterCapabilities(
             DragDrop: adapter as IDragDropAdapter,
-            AsyncPreloadScript: adapter as IAsyncPreloadScriptAdapter);
+            AsyncPreloadScript: adapter as IAsyncPreloadScriptAdapter,
+            FetchBridge: adapter as IFetchBridgeAdapter,
+            HostVisibility: adapter as IHostVisibilityAdapter,
+            RpcDelivery: adapter as IRpcDeliveryAdapter,
+            BlobPublishing: adapter as IBlobPublishingAdapter,
+            ContentFilters: adapter as IContentFilterAdapter,
+            SharedContentSets: adapter as ISharedContentSetAdapter,
+            WebsiteData: adapter as IWebsiteDataAdapter,
+            SpeculativeLoading: adapter as ISpeculativeLoadingAdapter,
+            ResourceTiming: adapter as IResourceTimingAdapter,
+            ScriptEvaluationLimits: adapter as IScriptEvaluationLimitsAdapter,
+            ScriptStreaming: adapter as IScriptStreamingAdapter,
+            OffscreenRendering: adapter as IOffscreenRenderingAdapter,
+            DownloadManagement: adapter as IDownloadManagementAdapter,
+            ActivityState: adapter as IActivityStateAdapter,
+            FullPageCapture: adapter as IFullPageCaptureAdapter);
     }
 }
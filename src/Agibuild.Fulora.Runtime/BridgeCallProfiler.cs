@@ -46,17 +46,47 @@ public sealed record ServiceProfileStats(
     double AvgLatencyMs,
     IReadOnlyList<MethodProfileStats> Methods);
 
+/// <summary>
+/// Latency percentiles for one phase of timed JS → C# calls.
+/// </summary>
+/// <param name="Phase">The phase name (see <see cref="BridgeCallPhases"/>).</param>
+/// <param name="CallCount">Number of timed calls.</param>
+/// <param name="P50Ms">50th percentile (median) in milliseconds.</param>
+/// <param name="P95Ms">95th percentile in milliseconds.</param>
+/// <param name="P99Ms">99th percentile in milliseconds.</param>
+/// <param name="MaxMs">Maximum observed in milliseconds.</param>
+public sealed record BridgePhaseStats(
+    string Phase,
+    long CallCount,
+    double P50Ms,
+    double P95Ms,
+    double P99Ms,
+    double MaxMs);
+
 /// <summary>
 /// An <see cref="IBridgeTracer"/> that collects per-method and per-service statistics
 /// for call counts, errors, and latency percentiles. Optionally delegates to an inner tracer.
+/// As an <see cref="IBridgeCallTimingSink"/> it also keeps per-phase percentiles of the
+/// end-to-end call timings reported by the page.
 /// </summary>
-public sealed class BridgeCallProfiler : IBridgeTracer
+public sealed class BridgeCallProfiler : IBridgeTracer, IBridgeCallTimingSink
 {
     private const int MaxLatencySamples = 10000;
 
+    private static readonly string[] PhaseOrder =
+    [
+        BridgeCallPhases.PageSerialize,
+        BridgeCallPhases.RequestTransit,
+        BridgeCallPhases.HostQueue,
+        BridgeCallPhases.HostHandler,
+        BridgeCallPhases.ResponseTransit,
+        BridgeCallPhases.Total,
+    ];
+
     private readonly IBridgeTracer? _inner;
     private readonly IFuloraDiagnosticsSink? _diagnosticsSink;
     private readonly ConcurrentDictionary<string, MethodCallStats> _stats = new();
+    private readonly ConcurrentDictionary<string, PhaseSamples> _phases = new(StringComparer.Ordinal);
 
     /// <summary>
     /// Creates a profiler with optional inner tracer delegation.
@@ -121,6 +151,31 @@ public sealed class BridgeCallProfiler : IBridgeTracer
         _inner?.OnServiceRemoved(serviceName);
     }
 
+    /// <inheritdoc />
+    public void OnCallTiming(BridgeCallTiming timing)
+    {
+        foreach (var (phase, _, duration) in timing.Phases)
+        {
+            _phases.GetOrAdd(phase, _ => new PhaseSamples(MaxLatencySamples)).Record(duration.TotalMilliseconds);
+        }
+        (_inner as IBridgeCallTimingSink)?.OnCallTiming(timing);
+    }
+
+    /// <summary>
+    /// Gets latency percentiles per call phase, in call order. Empty until the page has
+    /// reported call timings.
+    /// </summary>
+    public IReadOnlyList<BridgePhaseStats> GetPhaseStats()
+    {
+        var result = new List<BridgePhaseStats>(PhaseOrder.Length);
+        foreach (var phase in PhaseOrder)
+        {
+            if (_phases.TryGetValue(phase, out var samples) && samples.ToStats(phase) is { } stats)
+                result.Add(stats);
+        }
+        return result;
+    }
+
     /// <summary>
     /// Gets statistics for a specific method, or null if no calls have been recorded.
     /// </summary>
@@ -211,6 +266,7 @@ public sealed class BridgeCallProfiler : IBridgeTracer
     public void Reset()
     {
         _stats.Clear();
+        _phases.Clear();
     }
 
     private void RecordLatency(string serviceName, string methodName, long elapsedMs, bool isError)
@@ -314,4 +370,50 @@ public sealed class BridgeCallProfiler : IBridgeTracer
             return sorted[idx];
         }
     }
+
+    private sealed class PhaseSamples
+    {
+        private readonly int _maxSamples;
+        private readonly object _lock = new();
+        private readonly List<double> _samples = [];
+        private long _count;
+
+        public PhaseSamples(int maxSamples)
+        {
+            _maxSamples = maxSamples;
+        }
+
+        public void Record(double ms)
+        {
+            lock (_lock)
+            {
+                _count++;
+                _samples.Add(ms);
+                if (_samples.Count > _maxSamples)
+                    _samples.RemoveAt(0);
+            }
+        }
+
+        public BridgePhaseStats? ToStats(string phase)
+        {
+            lock (_lock)
+            {
+                if (_samples.Count == 0)
+                    return null;
+
+                var sorted = _samples.ToList();
+                sorted.Sort();
+                return new BridgePhaseStats(
+                    Phase: phase,
+                    CallCount: _count,
+                    P50Ms: Percentile(sorted, 0.50),
+                    P95Ms: Percentile(sorted, 0.95),
+                    P99Ms: Percentile(sorted, 0.99),
+                    MaxMs: sorted[^1]);
+            }
+        }
+
+        private static double Percentile(List<double> sorted, double p)
+            => sorted[Math.Max(0, (int)Math.Ceiling(p * sorted.Count) - 1)];
+    }
 }
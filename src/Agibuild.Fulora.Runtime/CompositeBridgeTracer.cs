@@ -4,10 +4,12 @@ namespace Agibuild.Fulora;
 /// An <see cref="IBridgeTracer"/> that holds multiple tracers and forwards each callback to all.
 /// Exceptions from one tracer are caught and do not prevent other tracers from receiving events.
 /// <see cref="NullBridgeTracer"/> instances are filtered out and not included.
+/// Call timings are forwarded to the tracers that implement <see cref="IBridgeCallTimingSink"/>.
 /// </summary>
-public sealed class CompositeBridgeTracer : IBridgeTracer
+public sealed class CompositeBridgeTracer : IBridgeTracer, IBridgeCallTimingSink
 {
     private readonly IBridgeTracer[] _tracers;
+    private readonly IBridgeCallTimingSink[] _timingSinks;
 
     /// <summary>
     /// Creates a composite tracer that forwards to the given tracers.
@@ -16,6 +18,7 @@ public sealed class CompositeBridgeTracer : IBridgeTracer
     public CompositeBridgeTracer(params IBridgeTracer[] tracers)
     {
         _tracers = tracers.Where(t => t is not NullBridgeTracer).ToArray();
+        _timingSinks = _tracers.OfType<IBridgeCallTimingSink>().ToArray();
     }
 
     /// <summary>
@@ -96,4 +99,17 @@ public sealed class CompositeBridgeTracer : IBridgeTracer
             catch { /* isolate per-tracer exceptions */ }
         }
     }
+
+    /// <summary>Whether any inner tracer receives call timings.</summary>
+    internal bool HasCallTimingSinks => _timingSinks.Length > 0;
+
+    /// <inheritdoc />
+    public void OnCallTiming(BridgeCallTiming timing)
+    {
+        foreach (var t in _timingSinks)
+        {
+            try { t.OnCallTiming(timing); }
+            catch { /* isolate per-tracer exceptions */ }
+        }
+    }
 }
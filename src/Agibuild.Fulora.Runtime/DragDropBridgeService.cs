@@ -24,8 +24,16 @@ internal sealed class DragDropBridgeService : IDragDropBridgeService
     }
 
     /// <inheritdoc />
-    public Task<DragDropPayload?> GetLastDropPayloadAsync(CancellationToken ct = default)
-        => Task.FromResult(_lastPayload);
+    public async Task<DragDropPayload?> GetLastDropPayloadAsync(CancellationToken ct = default)
+    {
+        if (_lastPayload is not { } payload)
+            return null;
+
+        // Keep the described payload unless a newer drop replaced it meanwhile.
+        var described = await payload.WithFileInfoAsync(ct).ConfigureAwait(false);
+        Interlocked.CompareExchange(ref _lastPayload, described, payload);
+        return described;
+    }
 
     /// <inheritdoc />
     public Task<bool> IsDragDropSupportedAsync(CancellationToken ct = default)
@@ -0,0 +1,185 @@
+using System.Text.Json;
+
+namespace Agibuild.Fulora.Rpc;
+
+/// <summary>Transport names reported in <see cref="BridgeCallTiming.Transport"/>.</summary>
+internal static class RpcCallTransports
+{
+    public const string Message = "message";
+    public const string Fetch = "fetch";
+}
+
+/// <summary>
+/// Joins the host's timestamps for JS → C# requests with the page stub's <c>$/trace</c>
+/// reports into <see cref="BridgeCallTiming"/> records.
+/// <para>
+/// The host side stamps <see cref="OnDispatched"/> and <see cref="OnResponded"/>; the page keeps
+/// its own invoke/send/receive times and reports them in batches after the responses arrive,
+/// so tracing adds no fields to requests or responses. Entries that never get a report (page
+/// navigated away, stub without tracing) are pruned after <see cref="EntryLifetime"/>, and at
+/// most <see cref="MaxEntries"/> are kept.
+/// </para>
+/// <para>
+/// Page and host clocks disagree by a few milliseconds, sometimes more. Each report is an NTP
+/// exchange: the offset sample is <c>((HostReceived - PageSent) + (HostResponded - PageReceived)) / 2</c>
+/// and its error is at most half the round trip <c>(PageReceived - PageSent) - (HostResponded - HostReceived)</c>.
+/// The collector keeps the sample with the smallest round trip seen for the current page
+/// (identified by the <c>origin</c> the stub sends, its <c>performance.timeOrigin</c>) and
+/// reports it as <see cref="BridgeCallTiming.ClockOffset"/>.
+/// </para>
+/// </summary>
+internal sealed class RpcCallTimingCollector
+{
+    internal const int MaxEntries = 4096;
+    internal static readonly TimeSpan EntryLifetime = TimeSpan.FromMinutes(1);
+
+    // Latest instant DateTimeOffset can hold, in Unix milliseconds.
+    private const double MaxUnixMilliseconds = 253402300799999;
+
+    private readonly IBridgeCallTimingSink _sink;
+    private readonly Func<DateTimeOffset> _clock;
+    private readonly object _lock = new();
+    private readonly Dictionary<string, HostTiming> _calls = new(StringComparer.Ordinal);
+    private double _pageOrigin;
+    private TimeSpan _clockOffset;
+    private TimeSpan? _roundTrip;
+
+    public RpcCallTimingCollector(IBridgeCallTimingSink sink, Func<DateTimeOffset>? clock = null)
+    {
+        _sink = sink ?? throw new ArgumentNullException(nameof(sink));
+        _clock = clock ?? (() => DateTimeOffset.UtcNow);
+    }
+
+    public IBridgeCallTimingSink Sink => _sink;
+
+    public DateTimeOffset Now => _clock();
+
+    /// <summary>Records that request <paramref name="id"/>, received at <paramref name="receivedAt"/>, is being dispatched now.</summary>
+    public void OnDispatched(string id, string method, string transport, DateTimeOffset? receivedAt)
+    {
+        var now = Now;
+        var entry = new HostTiming(method, transport, receivedAt ?? now, now);
+        lock (_lock)
+        {
+            if (_calls.Count >= MaxEntries)
+                Prune(now);
+            if (_calls.Count < MaxEntries || _calls.ContainsKey(id))
+                _calls[id] = entry;
+        }
+    }
+
+    /// <summary>Records that the response to <paramref name="id"/> is being handed to the transport now.</summary>
+    public void OnResponded(string id)
+    {
+        var now = Now;
+        lock (_lock)
+        {
+            if (_calls.TryGetValue(id, out var entry) && entry.Responded is null)
+                entry.Responded = now;
+        }
+    }
+
+    /// <summary>
+    /// Handles the params of a <c>$/trace</c> notification:
+    /// <c>{ "origin": timeOriginMs, "calls": [[id, invokedMs, sentMs, receivedMs, failed], ...] }</c>
+    /// with Unix epoch milliseconds. Reports for unknown or unanswered ids are ignored.
+    /// </summary>
+    public void OnPageReport(JsonElement parameters)
+    {
+        if (parameters.ValueKind != JsonValueKind.Object
+            || !parameters.TryGetProperty("calls", out var calls)
+            || calls.ValueKind != JsonValueKind.Array)
+            return;
+
+        // A new document brings a new time origin and a new offset.
+        var origin = parameters.TryGetProperty("origin", out var o) && o.ValueKind == JsonValueKind.Number
+            ? o.GetDouble()
+            : 0;
+        lock (_lock)
+        {
+            if (origin != _pageOrigin)
+            {
+                _pageOrigin = origin;
+                _roundTrip = null;
+            }
+        }
+
+        foreach (var call in calls.EnumerateArray())
+        {
+            if (call.ValueKind != JsonValueKind.Array || call.GetArrayLength() < 5
+                || call[0].ValueKind != JsonValueKind.String
+                || !TryReadTime(call[1], out var invoked)
+                || !TryReadTime(call[2], out var sent)
+                || !TryReadTime(call[3], out var received))
+                continue;
+
+            var id = call[0].GetString()!;
+            HostTiming? host;
+            DateTimeOffset responded;
+            TimeSpan clockOffset;
+            lock (_lock)
+            {
+                if (!_calls.Remove(id, out host) || host.Responded is not { } answered)
+                    continue;
+                responded = answered;
+
+                var roundTrip = (received - sent) - (responded - host.Received);
+                if (_roundTrip is not { } best || roundTrip < best)
+                {
+                    _roundTrip = roundTrip;
+                    _clockOffset = ((host.Received - sent) + (responded - received)) / 2;
+                }
+                clockOffset = _clockOffset;
+            }
+
+            var (serviceName, methodName) = RpcMethodHelpers.SplitRpcMethod(host.Method);
+            _sink.OnCallTiming(new BridgeCallTiming(
+                CallId: id,
+                ServiceName: serviceName,
+                MethodName: methodName,
+                Transport: host.Transport,
+                PageInvoked: invoked,
+                PageSent: sent,
+                HostReceived: host.Received,
+                HostDispatched: host.Dispatched,
+                HostResponded: responded,
+                PageReceived: received,
+                IsError: call[4].ValueKind is JsonValueKind.True
+                    || (call[4].ValueKind == JsonValueKind.Number && call[4].GetDouble() != 0),
+                ClockOffset: clockOffset));
+        }
+    }
+
+    private void Prune(DateTimeOffset now)
+    {
+        var cutoff = now - EntryLifetime;
+        foreach (var (id, entry) in _calls)
+        {
+            if (entry.Dispatched < cutoff)
+                _calls.Remove(id);
+        }
+    }
+
+    private static bool TryReadTime(JsonElement value, out DateTimeOffset time)
+    {
+        if (value.ValueKind == JsonValueKind.Number
+            && value.TryGetDouble(out var ms)
+            && ms is > 0 and < MaxUnixMilliseconds)
+        {
+            time = DateTimeOffset.UnixEpoch.AddTicks((long)(ms * TimeSpan.TicksPerMillisecond));
+            return true;
+        }
+
+        time = default;
+        return false;
+    }
+
+    private sealed class HostTiming(string method, string transport, DateTimeOffset received, DateTimeOffset dispatched)
+    {
+        public string Method { get; } = method;
+        public string Transport { get; } = transport;
+        public DateTimeOffset Received { get; } = received;
+        public DateTimeOffset Dispatched { get; } = dispatched;
+        public DateTimeOffset? Responded { get; set; }
+    }
+}
@@ -0,0 +1,19 @@
+using System.Text.Json;
+using Agibuild.Fulora.Adapters.Abstractions;
+
+namespace Agibuild.Fulora.Rpc;
+
+/// <summary>
+/// Builds the scripts that hand an RPC envelope to the page stub, used whenever the adapter
+/// has no <see cref="IRpcDeliveryAdapter"/> channel (or it is not connected yet).
+/// </summary>
+internal static class RpcDeliveryScripts
+{
+    public static string For(RpcDeliveryKind kind, string json)
+    {
+        var literal = JsonSerializer.Serialize(json, RpcJsonContext.Default.String);
+        return kind == RpcDeliveryKind.Dispatch
+            ? $"window.agWebView && window.agWebView.rpc && window.agWebView.rpc._dispatch({literal})"
+            : $"window.agWebView && window.agWebView.rpc && window.agWebView.rpc._onResponse({literal})";
+    }
+}
@@ -3,7 +3,7 @@ namespace Agibuild.Fulora.Rpc;
 /// <summary>
 /// JavaScript stub injected into every WebView page that exposes the
 /// <c>window.agWebView.rpc</c> facade (invoke / handle / batch / async iterators
-/// / cancellation). Kept as a single string constant so it can be referenced by
+/// / cancellation / call timing). Kept as a single string constant so it can be referenced by
 /// the runtime, integration tests, and tooling without re-encoding the file.
 /// </summary>
 internal static class RpcJsStub
@@ -18,10 +18,59 @@ internal static class RpcJsStub
             function post(msg) {
                 if (window.chrome && window.chrome.webview) {
                     window.chrome.webview.postMessage(msg);
+                } else if (window.__agibuildBridge && window.__agibuildBridge.native) {
+                    window.__agibuildBridge.postMessage(msg);
                 } else if (window.webkit && window.webkit.messageHandlers && window.webkit.messageHandlers.agibuildWebView) {
                     window.webkit.messageHandlers.agibuildWebView.postMessage(msg);
                 }
             }
+            var transport = 'message';
+            // Call timing (off unless the host turns it on): [invoked, sent] per pending id,
+            // completed calls reported in batches as $/trace so requests stay unchanged.
+            var tracing = false;
+            var traces = [];
+            var traceTimer = 0;
+            function now() {
+                return performance.timeOrigin + performance.now();
+            }
+            function flushTraces() {
+                traceTimer = 0;
+                if (traces.length === 0) return;
+                var calls = traces;
+                traces = [];
+                post(JSON.stringify({ jsonrpc: '2.0', method: '$/trace', params: { origin: performance.timeOrigin, calls: calls } }));
+            }
+            function traceSent(ids, invoked) {
+                var sent = now();
+                for (var i = 0; i < ids.length; i++) {
+                    if (pending[ids[i]]) pending[ids[i]].trace = [invoked, sent];
+                }
+            }
+            function traceReceived(id, p, received, failed) {
+                traces.push([id, p.trace[0], p.trace[1], received, failed ? 1 : 0]);
+                if (traces.length >= 64) flushTraces();
+                else if (!traceTimer) traceTimer = setTimeout(flushTraces, 1000);
+            }
+            function send(msg, path, ids) {
+                if (transport !== 'fetch') {
+                    post(msg);
+                    return;
+                }
+                fetch('app://__rpc/' + encodeURI(path), { method: 'POST', body: msg }).then(function(r) {
+                    if (!r.ok) throw new Error('RPC transport error ' + r.status);
+                    return r.text();
+                }).then(function(text) {
+                    if (text) window.agWebView.rpc._onResponse(text);
+                }).catch(function(e) {
+                    for (var i = 0; i < ids.length; i++) {
+                        var p = pending[ids[i]];
+                        if (p) {
+                            delete pending[ids[i]];
+                            p.reject(e instanceof Error ? e : new Error('RPC transport error'));
+                        }
+                    }
+                });
+            }
             window.agWebView.rpc = {
                 _uint8ToBase64: function(bytes) {
                     var binary = '';
@@ -68,9 +117,11 @@ internal static class RpcJsStub
                 invoke: function(method, params, signal) {
                     return new Promise(function(resolve, reject) {
                         var id = '__js_' + (nextId++);
+                        var invoked = tracing ? now() : 0;
                         pending[id] = { resolve: resolve, reject: reject };
                         var encodedParams = window.agWebView.rpc._encodeBinaryPayload(params);
-                        post(JSON.stringify({ jsonrpc: '2.0', id: id, method: method, params: encodedParams }));
+                        send(JSON.stringify({ jsonrpc: '2.0', id: id, method: method, params: encodedParams }), method.replace('.', '/'), [id]);
+                        if (tracing) traceSent([id], invoked);
                         if (signal) {
                             var onAbort = function() {
                                 post(JSON.stringify({ jsonrpc: '2.0', method: '$/cancelRequest', params: { id: id } }));
@@ -107,6 +158,7 @@ internal static class RpcJsStub
                     }
                 },
                 batch: function(calls) {
+                    var invoked = tracing ? now() : 0;
                     var requests = [];
                     var ids = [];
                     for (var i = 0; i < calls.length; i++) {
@@ -124,15 +176,25 @@ internal static class RpcJsStub
                             pending[id] = { resolve: resolve, reject: reject };
                         });
                     });
-                    post(JSON.stringify(requests));
+                    send(JSON.stringify(requests), '$/batch', ids);
+                    if (tracing) traceSent(ids, invoked);
                     return Promise.all(resultPromises);
                 },
+                _setTransport: function(name) {
+                    transport = name === 'fetch' && typeof fetch === 'function' ? 'fetch' : 'message';
+                },
+                _setTracing: function(enabled) {
+                    tracing = !!enabled && typeof performance === 'object' && typeof performance.timeOrigin === 'number';
+                    if (!tracing) traces = [];
+                },
                 _onResponse: function(jsonStr) {
+                    var received = tracing ? now() : 0;
                     var msg = JSON.parse(jsonStr);
                     function resolveItem(item) {
                         var p = pending[item.id];
                         if (p) {
                             delete pending[item.id];
+                            if (p.trace && tracing) traceReceived(item.id, p, received, !!item.error);
                             if (item.error) {
                                 p.reject(new Error(item.error.message || 'RPC error'));
                             } else {
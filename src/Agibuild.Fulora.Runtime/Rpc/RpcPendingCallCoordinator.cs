@@ -1,6 +1,7 @@
 using System.Collections.Concurrent;
 using System.Diagnostics.CodeAnalysis;
 using System.Text.Json;
+using Agibuild.Fulora.Adapters.Abstractions;
 
 namespace Agibuild.Fulora.Rpc;
 
@@ -10,26 +11,26 @@ namespace Agibuild.Fulora.Rpc;
 /// <list type="number">
 ///   <item>Allocates a request id and a <see cref="TaskCompletionSource{TResult}"/>.</item>
 ///   <item>Serialises the request envelope and pushes it to the JS runtime
-///         via the supplied <c>invokeScript</c> delegate.</item>
+///         via the supplied <c>deliver</c> delegate.</item>
 ///   <item>Waits for either a JS-side response (resolved by
 ///         <see cref="TryResolve"/> from the dispatcher), a 30 s timeout, or
 ///         a caller-supplied cancellation token.</item>
 /// </list>
 /// On caller cancellation, a best-effort <c>$/cancelRequest</c> notification
-/// is sent through the same <c>invokeScript</c> delegate to give the JS side a
+/// is sent through the same <c>deliver</c> delegate to give the JS side a
 /// chance to abort. The 30 s timeout is the contractual upper bound; tests
-/// that need a tighter bound should drive the underlying script delegate.
+/// that need a tighter bound should drive the underlying delivery delegate.
 /// </summary>
 internal sealed class RpcPendingCallCoordinator
 {
     private static readonly TimeSpan InvokeTimeout = TimeSpan.FromSeconds(30);
 
     private readonly ConcurrentDictionary<string, TaskCompletionSource<JsonElement>> _pendingCalls = new();
-    private readonly Func<string, Task<string?>> _invokeScript;
+    private readonly Func<RpcDeliveryKind, string, Task> _deliver;
 
-    public RpcPendingCallCoordinator(Func<string, Task<string?>> invokeScript)
+    public RpcPendingCallCoordinator(Func<RpcDeliveryKind, string, Task> deliver)
     {
-        _invokeScript = invokeScript;
+        _deliver = deliver;
     }
 
     [UnconditionalSuppressMessage("Trimming", "IL2026",
@@ -177,8 +178,7 @@ internal sealed class RpcPendingCallCoordinator
     private async Task DispatchEnvelopeAsync(RpcRequest envelope)
     {
         var json = JsonSerializer.Serialize(envelope, RpcJsonContext.Default.RpcRequest);
-        var script = $"window.agWebView && window.agWebView.rpc && window.agWebView.rpc._dispatch({JsonSerializer.Serialize(json, RpcJsonContext.Default.String)})";
-        await _invokeScript(script);
+        await _deliver(RpcDeliveryKind.Dispatch, json);
     }
 
     private async Task SendCancelRequestAsync(string requestId)
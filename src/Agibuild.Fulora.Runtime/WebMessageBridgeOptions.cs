@@ -31,6 +31,12 @@ public sealed class WebMessageBridgeOptions
     /// Default is false to avoid information leakage in production.
     /// </summary>
     public bool EnableDevToolsDiagnostics { get; init; }
+
+    /// <summary>
+    /// Transport for JS → C# RPC requests. Default is <see cref="WebMessageBridgeTransport.PostMessage"/>.
+    /// C# → JS calls and notifications always use the message channel.
+    /// </summary>
+    public WebMessageBridgeTransport Transport { get; init; } = WebMessageBridgeTransport.PostMessage;
 }
 
 internal sealed class DefaultWebMessagePolicy : IWebMessagePolicy
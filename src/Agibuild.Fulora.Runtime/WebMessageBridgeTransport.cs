@@ -0,0 +1,20 @@
+namespace Agibuild.Fulora;
+
+/// <summary>
+/// How page script sends bridge RPC requests and receives their responses.
+/// </summary>
+public enum WebMessageBridgeTransport
+{
+    /// <summary>
+    /// Requests go through the platform <c>postMessage</c> channel and responses come back as
+    /// evaluated script. Supported by every adapter.
+    /// </summary>
+    PostMessage = 0,
+
+    /// <summary>
+    /// Requests are <c>fetch</c> POSTs to <c>app://__rpc/&lt;service&gt;/&lt;method&gt;</c> and the
+    /// response is the HTTP body, so calls run concurrently through the engine's request
+    /// pipeline. Falls back to <see cref="PostMessage"/> when the adapter cannot serve them.
+    /// </summary>
+    Fetch = 1,
+}
@@ -203,6 +203,32 @@ internal sealed class WebViewCore : ISpaHostingWebView, IWebViewCoreControlEvent
     /// <summary>Whether the current adapter supports drag-and-drop.</summary>
     internal bool HasDragDropSupport => _featureRuntime.HasDragDropSupport;
 
+    /// <summary>
+    /// Reports whether the hosting control is currently shown, so adapters that support it can
+    /// throttle or suspend a page nobody can see. Repeated reports of the same value are ignored.
+    /// </summary>
+    internal void SetHostVisible(bool visible) => _featureRuntime.SetHostVisible(visible);
+
+    /// <summary>
+    /// How much work the view is currently allowed to do. Always <see cref="WebViewActivityState.Active"/>
+    /// where the platform does not throttle hidden views.
+    /// </summary>
+    public WebViewActivityState ActivityState => _featureRuntime.ActivityState;
+
+    /// <summary>
+    /// Sets how long a hidden view stays throttled before it is suspended; <see langword="null"/>
+    /// never suspends it.
+    /// </summary>
+    /// <returns><see langword="false"/> when the platform does not throttle hidden views.</returns>
+    public bool TrySetSuspendAfterHidden(TimeSpan? delay) => _featureRuntime.TrySetSuspendAfterHidden(delay);
+
+    /// <summary>
+    /// The adapter's offscreen frames, when it renders offscreen; <see langword="null"/> when it
+    /// draws into a native child window.
+    /// </summary>
+    internal IOffscreenRenderingAdapter? OffscreenRendering
+        => _context.Capabilities.OffscreenRendering is { IsOffscreenRendering: true } offscreen ? offscreen : null;
+
     /// <summary>
     /// Internal accessor exposing the event hub for integration tests that simulate adapter-raised
     /// events post-dispose to verify downstream subscribers have been detached. Production code
@@ -326,6 +352,37 @@ internal sealed class WebViewCore : ISpaHostingWebView, IWebViewCoreControlEvent
         remove => _events.DropCompleted -= value;
     }
 
+    /// <summary>
+    /// Raised on the UI thread with the progress of running downloads, at most once per
+    /// <see cref="TrySetDownloadProgressInterval"/> per download, where the platform reports it.
+    /// </summary>
+    public event EventHandler<WebViewDownloadProgress>? DownloadProgressChanged
+    {
+        add => _events.DownloadProgressChanged += value;
+        remove => _events.DownloadProgressChanged -= value;
+    }
+
+    /// <summary>
+    /// Raised on the UI thread when a download completed, failed or was cancelled, where the
+    /// platform reports it.
+    /// </summary>
+    public event EventHandler<WebViewDownloadResult>? DownloadCompleted
+    {
+        add => _events.DownloadCompleted += value;
+        remove => _events.DownloadCompleted -= value;
+    }
+
+    /// <summary>
+    /// Raised on the UI thread when the view was throttled, suspended or made active again as the
+    /// host hid or showed it. Bridge events keep flowing while suspended; hosts that want to hold
+    /// them back pause their publishers here.
+    /// </summary>
+    public event EventHandler<WebViewActivityState>? ActivityStateChanged
+    {
+        add => _events.ActivityStateChanged += value;
+        remove => _events.ActivityStateChanged -= value;
+    }
+
     /// <inheritdoc />
     public void Dispose()
     {
@@ -422,6 +479,58 @@ internal sealed class WebViewCore : ISpaHostingWebView, IWebViewCoreControlEvent
         }
     }
 
+    /// <summary>
+    /// Evaluates <paramref name="script"/> like <see cref="InvokeScriptAsync"/> but returns the
+    /// result as a read-only UTF-8 stream, or <see langword="null"/> for <c>null</c>/<c>undefined</c>.
+    /// Where the platform supports it the stream reads the engine's buffer in place, so large
+    /// results are never copied into a string; elsewhere the string result is encoded. Dispose
+    /// the stream to release the buffer.
+    /// </summary>
+    public Task<Stream?> InvokeScriptStreamAsync(string script, CancellationToken cancellationToken = default)
+    {
+        ArgumentNullException.ThrowIfNull(script);
+        _logger.LogInvokeScript(script.Length);
+
+        if (_context.IsDisposed)
+        {
+            return Task.FromException<Stream?>(new ObjectDisposedException(nameof(WebViewCore)));
+        }
+
+        return _operationQueue.EnqueueAsync(nameof(InvokeScriptStreamAsync), () => InvokeScriptStreamOnUiThreadAsync(script));
+
+        async Task<Stream?> InvokeScriptStreamOnUiThreadAsync(string s)
+        {
+            _context.ThrowIfDisposed();
+
+            try
+            {
+                if (_context.Capabilities.ScriptStreaming is { } streaming)
+                {
+                    var stream = await streaming.InvokeScriptStreamAsync(s, cancellationToken).ConfigureAwait(false);
+                    _logger.LogInvokeScriptResult(stream is { CanSeek: true } ? (int)Math.Min(int.MaxValue, stream.Length) : 0);
+                    return stream;
+                }
+
+                var result = await _adapter.InvokeScriptAsync(s).WaitAsync(cancellationToken).ConfigureAwait(false);
+                _logger.LogInvokeScriptResult(result?.Length ?? 0);
+                return result is null ? null : new MemoryStream(System.Text.Encoding.UTF8.GetBytes(result), writable: false);
+            }
+            catch (Exception ex) when (ex is not OperationCanceledException)
+            {
+                _logger.LogInvokeScriptFailed(ex);
+                throw new WebViewScriptException("Script execution failed.", ex);
+            }
+        }
+    }
+
+    /// <summary>
+    /// String results of at least <paramref name="thresholdBytes"/> UTF-8 bytes (0 = never) are
+    /// decoded from the engine's buffer instead of a NUL-terminated copy.
+    /// </summary>
+    /// <returns><see langword="false"/> when the platform cannot hand out its result buffer.</returns>
+    public bool TrySetScriptResultBufferThreshold(long thresholdBytes)
+        => _featureRuntime.TrySetScriptResultBufferThreshold(thresholdBytes);
+
     /// <inheritdoc />
     public Task<bool> GoBackAsync()
         => _operationQueue.EnqueueAsync(nameof(GoBackAsync), () => Task.FromResult(GoBackCore()));
@@ -581,9 +690,164 @@ internal sealed class WebViewCore : ISpaHostingWebView, IWebViewCoreControlEvent
     /// <inheritdoc />
     public Task<byte[]> CaptureScreenshotAsync() => _featureRuntime.CaptureScreenshotAsync();
 
+    /// <summary>
+    /// Captures the whole document, not just the viewport, as one PNG written to
+    /// <paramref name="destination"/> (left open), in memory bounded by a viewport rather than
+    /// the document. <paramref name="progress"/> reports the fraction of rows captured. A failed
+    /// or cancelled capture may leave a partial image in the stream.
+    /// </summary>
+    /// <returns>The image size, or <see langword="null"/> when the platform cannot capture whole
+    /// documents; nothing is written then.</returns>
+    public Task<FullPageCaptureResult?> CaptureFullPageAsync(Stream destination, IProgress<double>? progress = null,
+        CancellationToken cancellationToken = default)
+        => _featureRuntime.CaptureFullPageAsync(destination, progress, cancellationToken);
+
     /// <inheritdoc />
     public Task<byte[]> PrintToPdfAsync(PdfPrintOptions? options = null) => _featureRuntime.PrintToPdfAsync(options);
 
+    /// <summary>
+    /// Serves <paramref name="data"/> to the page without copying, so page script can
+    /// <c>fetch()</c> the returned same-origin path instead of receiving the bytes as base64.
+    /// Range requests are supported. An id stays taken until it is revoked with
+    /// <see cref="RevokeBlob"/>; publishing it again before then throws <see cref="ArgumentException"/>.
+    /// </summary>
+    /// <param name="id">Blob id; letters, digits, '.', '-' and '_'.</param>
+    /// <param name="data">The bytes to serve. They must not change until <paramref name="owner"/> is disposed.</param>
+    /// <param name="mimeType">Content type of the response; defaults to <c>application/octet-stream</c>.</param>
+    /// <param name="owner">Disposed once the blob is revoked and no response is reading from it.</param>
+    /// <returns>The path to fetch, or <see langword="null"/> when the platform cannot serve blobs.</returns>
+    public string? TryPublishBlob(string id, ReadOnlyMemory<byte> data, string? mimeType = null, IDisposable? owner = null)
+        => _featureRuntime.TryPublishBlob(id, data, mimeType, owner);
+
+    /// <summary>
+    /// Stops serving a blob published with <see cref="TryPublishBlob"/>; responses already
+    /// streaming finish first. Returns <see langword="false"/> when no blob has that id.
+    /// </summary>
+    public bool RevokeBlob(string id) => _featureRuntime.RevokeBlob(id);
+
+    /// <summary>
+    /// Applies a content-blocker rule list (WebKit content-extension JSON) to this view under
+    /// <paramref name="identifier"/>, replacing any rules loaded under the same identifier. The
+    /// compiled form is cached in <see cref="IWebViewEnvironmentOptions.ContentFilterStorePath"/>,
+    /// so unchanged rules load without recompiling on the next start.
+    /// </summary>
+    /// <returns>The load outcome, or <see langword="null"/> when the platform has no content filters.</returns>
+    public Task<ContentFilterResult?> TryLoadContentFilterAsync(string identifier, string rulesJson)
+        => _featureRuntime.TryLoadContentFilterAsync(identifier, rulesJson);
+
+    /// <summary>Removes the content filter loaded under <paramref name="identifier"/>, if any.</summary>
+    public void RemoveContentFilter(string identifier) => _featureRuntime.RemoveContentFilter(identifier);
+
+    /// <summary>
+    /// Defines or atomically replaces the process-wide content set <paramref name="name"/>, a bundle
+    /// of user scripts and style sheets held once and shared by every view it is attached to.
+    /// Views that already have the set attached pick up the new contents for their next document.
+    /// </summary>
+    /// <returns><see langword="false"/> when the platform has no shared content sets.</returns>
+    public bool TryDefineSharedContentSet(string name, IReadOnlyList<string> scripts, IReadOnlyList<string>? styleSheets = null,
+        SharedContentSetOptions options = SharedContentSetOptions.None)
+        => _featureRuntime.TryDefineSharedContentSet(name, scripts, styleSheets, options);
+
+    /// <summary>Removes the content set from every view it is attached to and releases it.</summary>
+    public void DestroySharedContentSet(string name) => _featureRuntime.DestroySharedContentSet(name);
+
+    /// <summary>
+    /// Injects a content set defined with <see cref="TryDefineSharedContentSet"/> into this view's
+    /// documents. Throws when no set has that name.
+    /// </summary>
+    /// <returns><see langword="false"/> when the platform has no shared content sets.</returns>
+    public bool TryAttachSharedContentSet(string name) => _featureRuntime.TryAttachSharedContentSet(name);
+
+    /// <summary>Stops injecting the content set into this view's documents.</summary>
+    public void DetachSharedContentSet(string name) => _featureRuntime.DetachSharedContentSet(name);
+
+    /// <summary>
+    /// Reports how much website data of the given categories each origin stores, so hosts can
+    /// trim the origins that grow past a budget with <see cref="TryRemoveWebsiteDataAsync"/>.
+    /// Where the data lives is set by <see cref="IWebViewEnvironmentOptions.WebsiteDataDirectory"/>
+    /// and <see cref="IWebViewEnvironmentOptions.WebsiteCacheDirectory"/>.
+    /// </summary>
+    /// <returns>Usage per origin, or <see langword="null"/> when the platform does not report it.</returns>
+    public Task<IReadOnlyList<WebsiteDataUsage>?> TryFetchWebsiteDataUsageAsync(WebsiteDataTypes types = WebsiteDataTypes.All)
+        => _featureRuntime.TryFetchWebsiteDataUsageAsync(types);
+
+    /// <summary>
+    /// Removes the given data categories for <paramref name="origins"/> (as reported by
+    /// <see cref="TryFetchWebsiteDataUsageAsync"/>), or for every origin when <see langword="null"/>.
+    /// </summary>
+    /// <returns><see langword="false"/> when the platform does not manage website data per origin.</returns>
+    public Task<bool> TryRemoveWebsiteDataAsync(WebsiteDataTypes types, IReadOnlyCollection<string>? origins = null)
+        => _featureRuntime.TryRemoveWebsiteDataAsync(types, origins);
+
+    /// <summary>Resolves <paramref name="hostname"/> ahead of the first request to it.</summary>
+    /// <returns><see langword="false"/> when the platform cannot prefetch DNS.</returns>
+    public bool TryPrefetchDns(string hostname) => _featureRuntime.TryPrefetchDns(hostname);
+
+    /// <summary>
+    /// Replaces the preload queue with <paramref name="uris"/>, the pages the user is likely to
+    /// open next. They load in the background so navigating to one is served from warm
+    /// connections and cache. Only absolute http(s) URIs are preloaded.
+    /// </summary>
+    /// <returns><see langword="false"/> when the platform cannot preload.</returns>
+    public bool TryPreloadUris(IReadOnlyList<Uri> uris) => _featureRuntime.TryPreloadUris(uris);
+
+    /// <summary>
+    /// Returns how many navigations used a preloaded page, or <see langword="null"/> when the
+    /// platform cannot preload.
+    /// </summary>
+    public PreloadStats? GetPreloadStats() => _featureRuntime.GetPreloadStats();
+
+    /// <summary>
+    /// Starts or stops recording the view's resource loads for <see cref="ExportResourceTimingsAsHar"/>.
+    /// <paramref name="capacity"/> bounds the number of completed loads kept (0 selects the
+    /// platform default); changing it discards what was recorded.
+    /// </summary>
+    /// <returns><see langword="false"/> when the platform does not record resource timing.</returns>
+    public bool TrySetResourceTimingEnabled(bool enabled, int capacity = 0)
+        => _featureRuntime.TrySetResourceTimingEnabled(enabled, capacity);
+
+    /// <summary>Discards the resource loads recorded so far.</summary>
+    public void ClearResourceTimings() => _featureRuntime.ClearResourceTimings();
+
+    /// <summary>
+    /// Exports the recorded resource loads, oldest first, as HAR 1.2 JSON, or returns
+    /// <see langword="null"/> when the platform does not record resource timing.
+    /// </summary>
+    public string? ExportResourceTimingsAsHar() => _featureRuntime.ExportResourceTimingsAsHar();
+
+    /// <summary>
+    /// Runs at most <paramref name="maxInFlight"/> script evaluations at once (0 = unlimited) with
+    /// up to <paramref name="maxQueued"/> waiting; further calls to <see cref="InvokeScriptAsync"/>
+    /// fail immediately. A <paramref name="timeout"/> bounds queueing plus execution of calls
+    /// made afterwards.
+    /// </summary>
+    /// <returns><see langword="false"/> when the platform does not limit script evaluation.</returns>
+    public bool TryConfigureScriptEvaluation(int maxInFlight, int maxQueued, TimeSpan? timeout = null)
+        => _featureRuntime.TryConfigureScriptEvaluation(maxInFlight, maxQueued, timeout);
+
+    /// <summary>
+    /// Chooses the destination of downloads that <see cref="DownloadRequested"/> handlers left
+    /// undecided, without blocking the UI thread: the download waits until the returned task
+    /// completes, and a <see langword="null"/> path or a failing resolver cancels it.
+    /// <see langword="null"/> removes the resolver.
+    /// </summary>
+    /// <returns><see langword="false"/> when the platform cannot defer download destinations.</returns>
+    public bool TrySetDownloadDestinationResolver(Func<WebViewDownload, CancellationToken, ValueTask<string?>>? resolver)
+        => _featureRuntime.TrySetDownloadDestinationResolver(resolver);
+
+    /// <summary>Sets the minimum time between two <see cref="DownloadProgressChanged"/> reports for the same download.</summary>
+    /// <returns><see langword="false"/> when the platform does not report download progress.</returns>
+    public bool TrySetDownloadProgressInterval(TimeSpan interval)
+        => _featureRuntime.TrySetDownloadProgressInterval(interval);
+
+    /// <summary>
+    /// Cancels a running download by the id from <see cref="TrySetDownloadDestinationResolver"/>
+    /// or <see cref="DownloadProgressChanged"/>.
+    /// </summary>
+    /// <returns><see langword="false"/> when the id is unknown, the download already finished, or
+    /// the platform cannot cancel downloads.</returns>
+    public bool CancelDownload(ulong downloadId) => _featureRuntime.CancelDownload(downloadId);
+
     // ==================== Zoom ====================
 
     /// <summary>
@@ -1,9 +1,18 @@
+using Agibuild.Fulora.Adapters.Abstractions;
+using Agibuild.Fulora.Rpc;
 using Microsoft.Extensions.Logging;
 
 namespace Agibuild.Fulora;
 
 internal sealed class WebViewCoreBridgeRuntime : IDisposable
 {
+    /// <summary>Switches an injected RPC stub to the fetch transport.</summary>
+    internal const string FetchTransportScript = "window.agWebView && window.agWebView.rpc && window.agWebView.rpc._setTransport('fetch')";
+
+    /// <summary>Turns the injected RPC stub's call timing reports on or off.</summary>
+    internal static string CallTimingScript(bool enabled)
+        => $"window.agWebView && window.agWebView.rpc && window.agWebView.rpc._setTracing({(enabled ? "true" : "false")})";
+
     private readonly WebViewCoreContext _context;
     private readonly bool _enableDevToolsByDefault;
 
@@ -14,6 +23,8 @@ internal sealed class WebViewCoreBridgeRuntime : IDisposable
     private WebViewRpcService? _rpcService;
     private RuntimeBridgeService? _bridgeService;
     private IBridgeTracer? _bridgeTracer;
+    private int _protocolVersion;
+    private bool _fetchBridgeActive;
 
     public WebViewCoreBridgeRuntime(
         WebViewCoreContext context,
@@ -25,6 +36,9 @@ internal sealed class WebViewCoreBridgeRuntime : IDisposable
 
     public bool IsBridgeEnabled => _webMessageBridgeEnabled;
 
+    /// <summary>Whether JS → C# requests currently travel over the adapter's fetch bridge.</summary>
+    internal bool IsFetchBridgeActive => _fetchBridgeActive;
+
     public IWebViewRpcService? Rpc => _rpcService;
 
     public IBridgeTracer? BridgeTracer
@@ -39,6 +53,7 @@ internal sealed class WebViewCoreBridgeRuntime : IDisposable
             }
 
             _bridgeTracer = value;
+            ApplyCallTimingSink();
         }
     }
 
@@ -83,10 +98,14 @@ internal sealed class WebViewCoreBridgeRuntime : IDisposable
         _webMessagePolicy = new DefaultWebMessagePolicy(options.AllowedOrigins, options.ProtocolVersion, _context.ChannelId);
         _webMessageDropDiagnosticsSink = options.DropDiagnosticsSink;
         _fuloraDiagnosticsSink = options.DiagnosticsSink;
-        _rpcService ??= new WebViewRpcService(script => InvokeScriptAsync(script), _context.Logger, options.EnableDevToolsDiagnostics);
+        _protocolVersion = options.ProtocolVersion;
+        _rpcService ??= new WebViewRpcService(script => InvokeScriptAsync(script), _context.Logger, options.EnableDevToolsDiagnostics,
+            DeliverRpcAsync);
+        _rpcService.CallTimingSink = ResolveCallTimingSink(_bridgeTracer);
+        SetFetchBridgeActive(options.Transport == WebMessageBridgeTransport.Fetch);
 
         _context.ObserveBackgroundTask(
-            InvokeScriptAsync(WebViewRpcService.JsStub),
+            InvokeScriptAsync(RpcStubScript),
             $"{nameof(EnableWebMessageBridge)}.{nameof(WebViewRpcService.JsStub)}");
 
         _context.Logger.LogWebMessageBridgeEnabled(
@@ -104,6 +123,7 @@ internal sealed class WebViewCoreBridgeRuntime : IDisposable
         _webMessageDropDiagnosticsSink = null;
         _fuloraDiagnosticsSink = null;
         _rpcService = null;
+        SetFetchBridgeActive(false);
 
         _context.Logger.LogWebMessageBridgeDisabled();
     }
@@ -115,7 +135,7 @@ internal sealed class WebViewCoreBridgeRuntime : IDisposable
             return;
         }
 
-        _context.ObserveBackgroundTask(InvokeScriptAsync(WebViewRpcService.JsStub), "ReinjectBridgeStubs.RpcStub");
+        _context.ObserveBackgroundTask(InvokeScriptAsync(RpcStubScript), "ReinjectBridgeStubs.RpcStub");
         _bridgeService?.ReinjectServiceStubs();
 
         _context.Logger.LogBridgeReInjected();
@@ -170,7 +190,7 @@ internal sealed class WebViewCoreBridgeRuntime : IDisposable
         var decision = policy.Evaluate(in envelope);
         if (decision.IsAllowed)
         {
-            if (_rpcService is not null && _rpcService.TryProcessMessage(args.Body))
+            if (_rpcService is not null && _rpcService.TryProcessMessage(args.Body, args.ReceivedAt))
             {
                 _context.Logger.LogWebMessageHandledAsRpc();
                 return;
@@ -181,25 +201,141 @@ internal sealed class WebViewCoreBridgeRuntime : IDisposable
             return;
         }
 
-        var reason = decision.DropReason ?? WebMessageDropReason.OriginNotAllowed;
+        ReportDrop(decision.DropReason ?? WebMessageDropReason.OriginNotAllowed, args.Origin, args.ChannelId);
+    }
+
+    private void ReportDrop(WebMessageDropReason reason, string origin, Guid channelId)
+    {
         _context.Logger.LogWebMessagePolicyDenied(reason);
-        _webMessageDropDiagnosticsSink?.OnMessageDropped(new WebMessageDropDiagnostic(reason, args.Origin, args.ChannelId));
+        _webMessageDropDiagnosticsSink?.OnMessageDropped(new WebMessageDropDiagnostic(reason, origin, channelId));
         _fuloraDiagnosticsSink?.OnEvent(new FuloraDiagnosticsEvent
         {
             EventName = "runtime.webmessage.dropped",
             Layer = "runtime",
             Component = nameof(WebViewCore),
-            ChannelId = args.ChannelId.ToString("D"),
+            ChannelId = channelId.ToString("D"),
             Status = "dropped",
             ErrorType = reason.ToString(),
             Attributes = new Dictionary<string, string>(StringComparer.Ordinal)
             {
-                ["origin"] = args.Origin,
+                ["origin"] = origin,
                 ["dropReason"] = reason.ToString()
             }
         });
     }
 
+    // ==================== Call timing ====================
+
+    /// <summary>
+    /// The tracer's <see cref="IBridgeCallTimingSink"/> facet, if it has one. A composite only
+    /// counts when one of its tracers does, so plain tracers never switch page timing on.
+    /// </summary>
+    private static IBridgeCallTimingSink? ResolveCallTimingSink(IBridgeTracer? tracer)
+        => tracer is CompositeBridgeTracer { HasCallTimingSinks: false } ? null : tracer as IBridgeCallTimingSink;
+
+    private void ApplyCallTimingSink()
+    {
+        var rpcService = _rpcService;
+        if (rpcService is null)
+        {
+            return;
+        }
+
+        var sink = ResolveCallTimingSink(_bridgeTracer);
+        var changed = (sink is null) != (rpcService.CallTimingSink is null);
+        rpcService.CallTimingSink = sink;
+        if (changed && _webMessageBridgeEnabled)
+        {
+            _context.ObserveBackgroundTask(InvokeScriptAsync(CallTimingScript(sink is not null)), nameof(ApplyCallTimingSink));
+        }
+    }
+
+    // ==================== Fetch transport ====================
+
+    private string RpcStubScript
+    {
+        get
+        {
+            var script = _fetchBridgeActive
+                ? WebViewRpcService.JsStub + ";\n" + FetchTransportScript
+                : WebViewRpcService.JsStub;
+            return _rpcService?.CallTimingSink is null
+                ? script
+                : script + ";\n" + CallTimingScript(true);
+        }
+    }
+
+    /// <summary>
+    /// Installs or removes this runtime as the adapter's fetch bridge handler. Adapters without
+    /// <see cref="IFetchBridgeAdapter"/>, or whose engine cannot serve request bodies, keep the
+    /// postMessage transport.
+    /// </summary>
+    private void SetFetchBridgeActive(bool requested)
+    {
+        var fetchBridge = _context.Capabilities.FetchBridge;
+        if (requested)
+        {
+            _fetchBridgeActive = fetchBridge?.SetFetchBridgeHandler(HandleFetchBridgeRequestAsync) == true;
+            if (_fetchBridgeActive)
+                _context.Logger.LogFetchBridgeEnabled();
+            else
+                _context.Logger.LogFetchBridgeUnavailable();
+            return;
+        }
+
+        if (_fetchBridgeActive)
+        {
+            fetchBridge?.SetFetchBridgeHandler(null);
+            _fetchBridgeActive = false;
+        }
+    }
+
+    /// <summary>
+    /// Adapter entry point for a fetch bridge request (any thread). The origin policy and the
+    /// handlers run on the UI thread like message-borne requests; only the response skips the
+    /// script round trip, going back as the HTTP body.
+    /// </summary>
+    private Task<string?> HandleFetchBridgeRequestAsync(string body, string origin, CancellationToken cancellationToken)
+    {
+        if (_context.IsDisposed || _context.IsAdapterDestroyed)
+        {
+            return Task.FromResult<string?>(null);
+        }
+
+        var receivedAt = DateTimeOffset.UtcNow;
+        return _context.Dispatcher.CheckAccess()
+            ? HandleFetchBridgeRequestOnUiThreadAsync(body, origin, receivedAt)
+            : _context.Dispatcher.InvokeAsync(() => HandleFetchBridgeRequestOnUiThreadAsync(body, origin, receivedAt));
+    }
+
+    internal Task<string?> HandleFetchBridgeRequestOnUiThreadAsync(string body, string origin, DateTimeOffset? receivedAt = null)
+    {
+        var rpcService = _rpcService;
+        var policy = _webMessagePolicy;
+        if (_context.IsDisposed || !_fetchBridgeActive || rpcService is null || policy is null)
+        {
+            _context.Logger.LogFetchBridgeRequestRefused();
+            return Task.FromResult<string?>(null);
+        }
+
+        // The adapter itself is the channel, so only origin (and the page's protocol version,
+        // which the stub does not vary per transport) decide.
+        var envelope = new WebMessageEnvelope(
+            Body: body,
+            Origin: origin,
+            ChannelId: _context.ChannelId,
+            ProtocolVersion: _protocolVersion);
+
+        var decision = policy.Evaluate(in envelope);
+        if (!decision.IsAllowed)
+        {
+            ReportDrop(decision.DropReason ?? WebMessageDropReason.OriginNotAllowed, origin, _context.ChannelId);
+            return Task.FromResult<string?>(null);
+        }
+
+        return rpcService.ProcessFetchRequestAsync(body, receivedAt);
+    }
+
     /// <summary>
     /// Invokes a script through the public async pipeline so the call is serialized, dispatched onto
     /// the UI thread, and classified for failure reporting. Kept private to the bridge runtime — the
@@ -210,8 +346,25 @@ internal sealed class WebViewCoreBridgeRuntime : IDisposable
             "InvokeScriptAsync",
             () => _context.Adapter.InvokeScriptAsync(script));
 
+    /// <summary>
+    /// Hands an RPC envelope to the page stub through the adapter's direct channel when it has
+    /// one, and evaluates the delivery script otherwise, in one step of the operation queue.
+    /// </summary>
+    private Task DeliverRpcAsync(RpcDeliveryKind kind, string json)
+        => _context.Operations.EnqueueAsync<string?>(
+            "InvokeScriptAsync",
+            () => _context.Capabilities.RpcDelivery?.TryDeliverRpc(kind, json) == true
+                ? Task.FromResult<string?>(null)
+                : _context.Adapter.InvokeScriptAsync(RpcDeliveryScripts.For(kind, json)));
+
     public void Dispose()
     {
+        if (_fetchBridgeActive)
+        {
+            _context.Capabilities.FetchBridge?.SetFetchBridgeHandler(null);
+            _fetchBridgeActive = false;
+        }
+
         _bridgeService?.Dispose();
         _bridgeService = null;
     }
@@ -51,4 +51,16 @@ internal static partial class WebViewCoreBridgeRuntimeLog
     [LoggerMessage(EventId = 2210, Level = LogLevel.Debug,
         Message = "WebMessageReceived: policy denied, reason={Reason}")]
     public static partial void LogWebMessagePolicyDenied(this ILogger logger, WebMessageDropReason reason);
+
+    [LoggerMessage(EventId = 2211, Level = LogLevel.Debug,
+        Message = "WebMessageBridge: RPC requests use the fetch transport")]
+    public static partial void LogFetchBridgeEnabled(this ILogger logger);
+
+    [LoggerMessage(EventId = 2212, Level = LogLevel.Information,
+        Message = "WebMessageBridge: fetch transport requested but not supported by the adapter, using postMessage")]
+    public static partial void LogFetchBridgeUnavailable(this ILogger logger);
+
+    [LoggerMessage(EventId = 2213, Level = LogLevel.Debug,
+        Message = "Fetch bridge request: bridge not enabled, refusing")]
+    public static partial void LogFetchBridgeRequestRefused(this ILogger logger);
 }
@@ -1,3 +1,5 @@
+using Agibuild.Fulora.Adapters.Abstractions;
+
 namespace Agibuild.Fulora;
 
 /// <summary>
@@ -46,6 +48,9 @@ internal sealed class WebViewCoreEventHub : IWebViewCoreControlEvents
     public event EventHandler<DragEventArgs>? DragOver;
     public event EventHandler<EventArgs>? DragLeft;
     public event EventHandler<DropEventArgs>? DropCompleted;
+    public event EventHandler<WebViewDownloadProgress>? DownloadProgressChanged;
+    public event EventHandler<WebViewDownloadResult>? DownloadCompleted;
+    public event EventHandler<WebViewActivityState>? ActivityStateChanged;
 
     public void RaiseNavigationStarted(NavigationStartingEventArgs args)
         => NavigationStarted?.Invoke(_sender, args);
@@ -94,4 +99,13 @@ internal sealed class WebViewCoreEventHub : IWebViewCoreControlEvents
 
     public void RaiseDropCompleted(DropEventArgs args)
         => DropCompleted?.Invoke(_sender, args);
+
+    public void RaiseDownloadProgressChanged(WebViewDownloadProgress progress)
+        => DownloadProgressChanged?.Invoke(_sender, progress);
+
+    public void RaiseDownloadCompleted(WebViewDownloadResult result)
+        => DownloadCompleted?.Invoke(_sender, result);
+
+    public void RaiseActivityStateChanged(WebViewActivityState state)
+        => ActivityStateChanged?.Invoke(_sender, state);
 }
@@ -9,6 +9,7 @@ internal sealed class WebViewCoreFeatureRuntime : IDisposable
     private const double MaxZoom = 5.0;
 
     private readonly WebViewCoreContext _context;
+    private bool? _hostVisible;
 
     public WebViewCoreFeatureRuntime(WebViewCoreContext context)
     {
@@ -43,10 +44,277 @@ internal sealed class WebViewCoreFeatureRuntime : IDisposable
         }
 
         _context.Logger.LogDragDropSupport(_context.Capabilities.DragDrop is not null);
+
+        if (_context.Capabilities.DownloadManagement is { } downloads)
+        {
+            downloads.DownloadProgressChanged += OnAdapterDownloadProgressChanged;
+            downloads.DownloadCompleted += OnAdapterDownloadCompleted;
+        }
+
+        if (_context.Capabilities.ActivityState is { } activity)
+        {
+            activity.ActivityStateChanged += OnAdapterActivityStateChanged;
+        }
     }
 
     public bool HasDragDropSupport => _context.Capabilities.DragDrop is not null;
 
+    public void SetHostVisible(bool visible)
+    {
+        if (_context.IsDisposed || _hostVisible == visible)
+        {
+            return;
+        }
+
+        _hostVisible = visible;
+        _context.Capabilities.HostVisibility?.SetHostVisible(visible);
+    }
+
+    public WebViewActivityState ActivityState
+        => _context.Capabilities.ActivityState?.ActivityState ?? WebViewActivityState.Active;
+
+    public bool TrySetSuspendAfterHidden(TimeSpan? delay)
+    {
+        if (delay is { } d)
+        {
+            ArgumentOutOfRangeException.ThrowIfLessThan(d, TimeSpan.Zero, nameof(delay));
+        }
+
+        _context.ThrowIfDisposed();
+        if (_context.Capabilities.ActivityState is not { } activity)
+        {
+            return false;
+        }
+
+        activity.SuspendAfterHidden = delay;
+        return true;
+    }
+
+    public string? TryPublishBlob(string id, ReadOnlyMemory<byte> data, string? mimeType, IDisposable? owner)
+    {
+        ArgumentException.ThrowIfNullOrEmpty(id);
+        _context.ThrowIfDisposed();
+        return _context.Capabilities.BlobPublishing?.PublishBlob(id, data, mimeType, owner);
+    }
+
+    public bool RevokeBlob(string id)
+    {
+        ArgumentNullException.ThrowIfNull(id);
+        _context.ThrowIfDisposed();
+        return _context.Capabilities.BlobPublishing?.RevokeBlob(id) ?? false;
+    }
+
+    public Task<ContentFilterResult?> TryLoadContentFilterAsync(string identifier, string rulesJson)
+    {
+        ArgumentException.ThrowIfNullOrEmpty(identifier);
+        ArgumentNullException.ThrowIfNull(rulesJson);
+        _context.ThrowIfDisposed();
+        if (_context.Capabilities.ContentFilters is not { } filters)
+        {
+            return Task.FromResult<ContentFilterResult?>(null);
+        }
+
+        return LoadAsync(filters, identifier, rulesJson);
+
+        static async Task<ContentFilterResult?> LoadAsync(IContentFilterAdapter filters, string identifier, string rulesJson)
+            => await filters.LoadOrCompileContentFilterAsync(identifier, rulesJson).ConfigureAwait(false);
+    }
+
+    public void RemoveContentFilter(string identifier)
+    {
+        ArgumentNullException.ThrowIfNull(identifier);
+        _context.ThrowIfDisposed();
+        _context.Capabilities.ContentFilters?.RemoveContentFilter(identifier);
+    }
+
+    public bool TryDefineSharedContentSet(string name, IReadOnlyList<string> scripts, IReadOnlyList<string>? styleSheets,
+        SharedContentSetOptions options)
+    {
+        ArgumentException.ThrowIfNullOrEmpty(name);
+        ArgumentNullException.ThrowIfNull(scripts);
+        _context.ThrowIfDisposed();
+        if (_context.Capabilities.SharedContentSets is not { } sets)
+        {
+            return false;
+        }
+
+        sets.DefineSharedContentSet(name, scripts, styleSheets, options);
+        return true;
+    }
+
+    public void DestroySharedContentSet(string name)
+    {
+        ArgumentException.ThrowIfNullOrEmpty(name);
+        _context.ThrowIfDisposed();
+        _context.Capabilities.SharedContentSets?.DestroySharedContentSet(name);
+    }
+
+    public bool TryAttachSharedContentSet(string name)
+    {
+        ArgumentException.ThrowIfNullOrEmpty(name);
+        _context.ThrowIfDisposed();
+        if (_context.Capabilities.SharedContentSets is not { } sets)
+        {
+            return false;
+        }
+
+        sets.AttachSharedContentSet(name);
+        return true;
+    }
+
+    public void DetachSharedContentSet(string name)
+    {
+        ArgumentException.ThrowIfNullOrEmpty(name);
+        _context.ThrowIfDisposed();
+        _context.Capabilities.SharedContentSets?.DetachSharedContentSet(name);
+    }
+
+    public Task<IReadOnlyList<WebsiteDataUsage>?> TryFetchWebsiteDataUsageAsync(WebsiteDataTypes types)
+    {
+        _context.ThrowIfDisposed();
+        if (_context.Capabilities.WebsiteData is not { } websiteData)
+        {
+            return Task.FromResult<IReadOnlyList<WebsiteDataUsage>?>(null);
+        }
+
+        return FetchAsync(websiteData, types);
+
+        static async Task<IReadOnlyList<WebsiteDataUsage>?> FetchAsync(IWebsiteDataAdapter websiteData, WebsiteDataTypes types)
+            => await websiteData.FetchWebsiteDataUsageAsync(types).ConfigureAwait(false);
+    }
+
+    public async Task<bool> TryRemoveWebsiteDataAsync(WebsiteDataTypes types, IReadOnlyCollection<string>? origins)
+    {
+        _context.ThrowIfDisposed();
+        if (_context.Capabilities.WebsiteData is not { } websiteData)
+        {
+            return false;
+        }
+
+        await websiteData.RemoveWebsiteDataAsync(types, origins).ConfigureAwait(false);
+        return true;
+    }
+
+    public bool TryPrefetchDns(string hostname)
+    {
+        ArgumentException.ThrowIfNullOrEmpty(hostname);
+        _context.ThrowIfDisposed();
+        if (_context.Capabilities.SpeculativeLoading is not { } speculative)
+        {
+            return false;
+        }
+
+        speculative.PrefetchDns(hostname);
+        return true;
+    }
+
+    public bool TryPreloadUris(IReadOnlyList<Uri> uris)
+    {
+        ArgumentNullException.ThrowIfNull(uris);
+        _context.ThrowIfDisposed();
+        if (_context.Capabilities.SpeculativeLoading is not { } speculative)
+        {
+            return false;
+        }
+
+        speculative.PreloadUris(uris);
+        return true;
+    }
+
+    public PreloadStats? GetPreloadStats()
+    {
+        _context.ThrowIfDisposed();
+        return _context.Capabilities.SpeculativeLoading?.GetPreloadStats();
+    }
+
+    public bool TrySetResourceTimingEnabled(bool enabled, int capacity)
+    {
+        ArgumentOutOfRangeException.ThrowIfNegative(capacity);
+        _context.ThrowIfDisposed();
+        if (_context.Capabilities.ResourceTiming is not { } resourceTiming)
+        {
+            return false;
+        }
+
+        resourceTiming.SetResourceTimingEnabled(enabled, capacity);
+        return true;
+    }
+
+    public void ClearResourceTimings()
+    {
+        _context.ThrowIfDisposed();
+        _context.Capabilities.ResourceTiming?.ClearResourceTimings();
+    }
+
+    public string? ExportResourceTimingsAsHar()
+    {
+        _context.ThrowIfDisposed();
+        return _context.Capabilities.ResourceTiming?.ExportResourceTimingsAsHar();
+    }
+
+    public bool TryConfigureScriptEvaluation(int maxInFlight, int maxQueued, TimeSpan? timeout)
+    {
+        ArgumentOutOfRangeException.ThrowIfNegative(maxInFlight);
+        ArgumentOutOfRangeException.ThrowIfNegative(maxQueued);
+        if (timeout is { } t)
+        {
+            ArgumentOutOfRangeException.ThrowIfLessThanOrEqual(t, TimeSpan.Zero, nameof(timeout));
+        }
+
+        _context.ThrowIfDisposed();
+        if (_context.Capabilities.ScriptEvaluationLimits is not { } limits)
+        {
+            return false;
+        }
+
+        limits.ConfigureScriptEvaluation(maxInFlight, maxQueued, timeout);
+        return true;
+    }
+
+    public bool TrySetScriptResultBufferThreshold(long thresholdBytes)
+    {
+        ArgumentOutOfRangeException.ThrowIfNegative(thresholdBytes);
+        _context.ThrowIfDisposed();
+        if (_context.Capabilities.ScriptStreaming is not { } streaming)
+        {
+            return false;
+        }
+
+        streaming.SetScriptResultBufferThreshold(thresholdBytes);
+        return true;
+    }
+
+    public bool TrySetDownloadDestinationResolver(Func<WebViewDownload, CancellationToken, ValueTask<string?>>? resolver)
+    {
+        _context.ThrowIfDisposed();
+        if (_context.Capabilities.DownloadManagement is not { } downloads)
+        {
+            return false;
+        }
+
+        downloads.DownloadDestinationResolver = resolver;
+        return true;
+    }
+
+    public bool TrySetDownloadProgressInterval(TimeSpan interval)
+    {
+        ArgumentOutOfRangeException.ThrowIfLessThan(interval, TimeSpan.Zero);
+        _context.ThrowIfDisposed();
+        if (_context.Capabilities.DownloadManagement is not { } downloads)
+        {
+            return false;
+        }
+
+        downloads.SetDownloadProgressInterval(interval);
+        return true;
+    }
+
+    public bool CancelDownload(ulong downloadId)
+    {
+        _context.ThrowIfDisposed();
+        return _context.Capabilities.DownloadManagement?.CancelDownload(downloadId) ?? false;
+    }
+
     public Task OpenDevToolsAsync()
     {
         return _context.Operations.EnqueueAsync(nameof(OpenDevToolsAsync), () =>
@@ -85,6 +353,27 @@ internal sealed class WebViewCoreFeatureRuntime : IDisposable
         });
     }
 
+    public Task<FullPageCaptureResult?> CaptureFullPageAsync(Stream destination, IProgress<double>? progress,
+        CancellationToken cancellationToken)
+    {
+        ArgumentNullException.ThrowIfNull(destination);
+        if (!destination.CanWrite)
+        {
+            throw new ArgumentException("The destination stream must be writable.", nameof(destination));
+        }
+
+        return _context.Operations.EnqueueAsync<FullPageCaptureResult?>(nameof(CaptureFullPageAsync), async () =>
+        {
+            _context.ThrowIfDisposed();
+            if (_context.Capabilities.FullPageCapture is not { } fullPage)
+            {
+                return null;
+            }
+
+            return await fullPage.CaptureFullPageAsync(destination, progress, cancellationToken).ConfigureAwait(false);
+        });
+    }
+
     public Task<byte[]> PrintToPdfAsync(PdfPrintOptions? options = null)
     {
         return _context.Operations.EnqueueAsync(nameof(PrintToPdfAsync), () =>
@@ -210,6 +499,17 @@ internal sealed class WebViewCoreFeatureRuntime : IDisposable
             dragDrop.DragLeft -= OnAdapterDragLeft;
             dragDrop.DropCompleted -= OnAdapterDropCompleted;
         }
+
+        if (_context.Capabilities.DownloadManagement is { } downloads)
+        {
+            downloads.DownloadProgressChanged -= OnAdapterDownloadProgressChanged;
+            downloads.DownloadCompleted -= OnAdapterDownloadCompleted;
+        }
+
+        if (_context.Capabilities.ActivityState is { } activity)
+        {
+            activity.ActivityStateChanged -= OnAdapterActivityStateChanged;
+        }
     }
 
     private void OnAdapterZoomFactorChanged(object? sender, double newZoom)
@@ -251,4 +551,25 @@ internal sealed class WebViewCoreFeatureRuntime : IDisposable
 
     private void OnAdapterDropCompleted(object? sender, DropEventArgs args)
         => _context.Events.RaiseDropCompleted(args);
+
+    private void OnAdapterDownloadProgressChanged(object? sender, WebViewDownloadProgress progress)
+        => UiThreadHelper.SafeDispatch(
+            _context.Dispatcher,
+            _context.IsDisposed,
+            _context.IsAdapterDestroyed,
+            () => _context.Events.RaiseDownloadProgressChanged(progress));
+
+    private void OnAdapterDownloadCompleted(object? sender, WebViewDownloadResult result)
+        => UiThreadHelper.SafeDispatch(
+            _context.Dispatcher,
+            _context.IsDisposed,
+            _context.IsAdapterDestroyed,
+            () => _context.Events.RaiseDownloadCompleted(result));
+
+    private void OnAdapterActivityStateChanged(object? sender, WebViewActivityState state)
+        => UiThreadHelper.SafeDispatch(
+            _context.Dispatcher,
+            _context.IsDisposed,
+            _context.IsAdapterDestroyed,
+            () => _context.Events.RaiseActivityStateChanged(state));
 }
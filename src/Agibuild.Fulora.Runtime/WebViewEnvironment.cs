@@ -15,6 +15,60 @@ public sealed class WebViewEnvironmentOptions : IWebViewEnvironmentOptions
     public bool UseEphemeralSession { get; set; }
     /// <inheritdoc />
     public bool TransparentBackground { get; set; }
+    /// <summary>
+    /// Directory compiled content filters are cached in, where the platform compiles them;
+    /// <see langword="null"/> keeps the platform default.
+    /// </summary>
+    public string? ContentFilterStorePath { get; set; }
+    /// <summary>
+    /// Directory persistent website data (storage, databases, cookies) is kept in, where the
+    /// platform lets it be chosen; <see langword="null"/> keeps the platform default. Ignored for
+    /// ephemeral sessions.
+    /// </summary>
+    public string? WebsiteDataDirectory { get; set; }
+    /// <summary>
+    /// Directory the HTTP and other website caches are kept in, where the platform lets it be
+    /// chosen; <see langword="null"/> keeps the platform default.
+    /// </summary>
+    public string? WebsiteCacheDirectory { get; set; }
+    /// <summary>Caching policy for the view; <see langword="null"/> keeps the platform default.</summary>
+    public WebViewCacheModel? CacheModel { get; set; }
+    /// <summary>
+    /// Preset applied to the engine's rendering and caching settings where the platform exposes
+    /// them; <see cref="WebViewPerformanceProfile.Default"/> keeps the engine defaults.
+    /// </summary>
+    public WebViewPerformanceProfile PerformanceProfile { get; set; }
+    /// <summary>
+    /// Memory budget for awake views, where the platform can hibernate them. Views sharing a
+    /// budget keep only as many web processes as fit it; the least recently active ones release
+    /// theirs and are rebuilt, with history and scroll position, when shown or used again.
+    /// <see langword="null"/> never hibernates.
+    /// </summary>
+    public long? HibernationMemoryBudgetBytes { get; set; }
+    /// <summary>
+    /// Reloads the last committed page after the web process crashes or is killed for exceeding
+    /// its memory limit, where the platform reports terminations. Pending script calls and the
+    /// interrupted navigation still fail with <see cref="WebViewProcessTerminatedException"/>.
+    /// </summary>
+    public bool EnableCrashRecovery { get; set; }
+    /// <summary>
+    /// Terminates a web process that is still unresponsive this long after the platform noticed
+    /// the hang, where the platform reports hangs, and reloads the view on a new process.
+    /// <see langword="null"/> leaves a hung page alone.
+    /// </summary>
+    public TimeSpan? TerminateUnresponsiveWebProcessAfter { get; set; }
+    /// <summary>
+    /// Carries bridge messages over a direct channel to the page's web process, where the
+    /// platform provides one, instead of script messages and script evaluation. Without it, or
+    /// when the channel is not installed, the script path is used.
+    /// </summary>
+    public bool EnableNativeBridge { get; set; }
+    /// <summary>
+    /// Renders the page into frames the host draws itself instead of a native child window,
+    /// where the platform supports it. Use with <c>OffscreenWebView</c>; a native
+    /// <c>WebView</c> shows nothing in this mode.
+    /// </summary>
+    public bool OffscreenRendering { get; set; }
     /// <inheritdoc />
     public IReadOnlyList<CustomSchemeRegistration> CustomSchemes { get; set; } = [];
     /// <inheritdoc />
@@ -1,4 +1,5 @@
 using System.Text.Json;
+using Agibuild.Fulora.Adapters.Abstractions;
 using Agibuild.Fulora.Rpc;
 using Microsoft.Extensions.Logging;
 
@@ -23,6 +24,8 @@ namespace Agibuild.Fulora;
 ///         <c>$/enumerator/abort</c>.</item>
 ///   <item><see cref="RpcResultSerializer"/> — AOT-safe success/error envelope
 ///         serialization.</item>
+///   <item><see cref="RpcCallTimingCollector"/> — end-to-end call timing joined
+///         from host timestamps and the page's <c>$/trace</c> reports.</item>
 /// </list>
 /// The coordinator only owns the message dispatch pipeline (parse →
 /// route response/notification/request → run handler → ship response).
@@ -44,20 +47,23 @@ internal sealed class WebViewRpcService : IWebViewRpcService
     /// </summary>
     internal static TimeSpan EnumeratorInactivityTimeout => RpcEnumeratorRegistry.InactivityTimeout;
 
-    private readonly Func<string, Task<string?>> _invokeScript;
+    private readonly Func<RpcDeliveryKind, string, Task> _deliver;
     private readonly ILogger _logger;
     private readonly RpcHandlerRegistry _handlers;
     private readonly RpcPendingCallCoordinator _pendingCalls;
     private readonly RpcCancellationCoordinator _cancellations;
     private readonly RpcEnumeratorRegistry _enumerators;
     private readonly RpcResultSerializer _serializer;
+    private RpcCallTimingCollector? _callTiming;
 
-    internal WebViewRpcService(Func<string, Task<string?>> invokeScript, ILogger logger, bool enableDevToolsDiagnostics = false)
+    // deliver hands envelopes to the page stub; without one they are evaluated as delivery scripts.
+    internal WebViewRpcService(Func<string, Task<string?>> invokeScript, ILogger logger, bool enableDevToolsDiagnostics = false,
+        Func<RpcDeliveryKind, string, Task>? deliver = null)
     {
-        _invokeScript = invokeScript;
+        _deliver = deliver ?? ((kind, json) => invokeScript(RpcDeliveryScripts.For(kind, json)));
         _logger = logger;
         _handlers = new RpcHandlerRegistry();
-        _pendingCalls = new RpcPendingCallCoordinator(invokeScript);
+        _pendingCalls = new RpcPendingCallCoordinator(_deliver);
         _cancellations = new RpcCancellationCoordinator();
         _enumerators = new RpcEnumeratorRegistry(_handlers, logger);
         _serializer = new RpcResultSerializer(enableDevToolsDiagnostics);
@@ -102,6 +108,46 @@ internal sealed class WebViewRpcService : IWebViewRpcService
     public Task NotifyAsync(string method, object? args = null)
         => _pendingCalls.NotifyAsync(method, args);
 
+    // ==================== Call timing ====================
+
+    /// <summary>
+    /// Receiver of end-to-end JS → C# call timings, or <c>null</c> to stop collecting. The page
+    /// stub only reports when its tracing switch is on; the bridge runtime flips both together.
+    /// </summary>
+    internal IBridgeCallTimingSink? CallTimingSink
+    {
+        get => _callTiming?.Sink;
+        set
+        {
+            if (ReferenceEquals(value, _callTiming?.Sink)) return;
+            _callTiming = value is null ? null : new RpcCallTimingCollector(value);
+        }
+    }
+
+    private void MarkResponded(JsonElement requests)
+    {
+        var timing = _callTiming;
+        if (timing is null) return;
+
+        if (requests.ValueKind == JsonValueKind.Array)
+        {
+            foreach (var element in requests.EnumerateArray())
+                MarkResponded(timing, element);
+        }
+        else
+        {
+            MarkResponded(timing, requests);
+        }
+    }
+
+    private static void MarkResponded(RpcCallTimingCollector timing, JsonElement request)
+    {
+        if (request.ValueKind == JsonValueKind.Object
+            && request.TryGetProperty("id", out var id)
+            && id.ValueKind == JsonValueKind.String)
+            timing.OnResponded(id.GetString()!);
+    }
+
     // ==================== Test-visible cancellation hooks ====================
 
     internal void RegisterCancellation(string requestId, CancellationTokenSource cts)
@@ -116,9 +162,10 @@ internal sealed class WebViewRpcService : IWebViewRpcService
     /// Called by <c>WebViewCoreBridgeRuntime</c> when a WebMessage with an RPC
     /// envelope is received. Returns <c>true</c> if the message was handled
     /// (request, notification, response, or batch). Non-RPC payloads return
-    /// <c>false</c> so the caller can route them elsewhere.
+    /// <c>false</c> so the caller can route them elsewhere. <paramref name="receivedAt"/> is
+    /// when the adapter raised the message, for call timing.
     /// </summary>
-    internal bool TryProcessMessage(string body)
+    internal bool TryProcessMessage(string body, DateTimeOffset? receivedAt = null)
     {
         if (string.IsNullOrEmpty(body)) return false;
 
@@ -129,7 +176,7 @@ internal sealed class WebViewRpcService : IWebViewRpcService
 
             if (root.ValueKind == JsonValueKind.Array)
             {
-                _ = ProcessBatchAsync(root.Clone());
+                _ = ProcessBatchAsync(root.Clone(), receivedAt);
                 return true;
             }
 
@@ -152,6 +199,7 @@ internal sealed class WebViewRpcService : IWebViewRpcService
                     {
                         // Mark request as active before scheduling async dispatch so early cancel notifications are not lost.
                         _cancellations.MarkActive(id);
+                        _callTiming?.OnDispatched(id, method, RpcCallTransports.Message, receivedAt);
                     }
                     _ = DispatchRequestAsync(id, method, root);
                     return true;
@@ -171,6 +219,8 @@ internal sealed class WebViewRpcService : IWebViewRpcService
         var responseJson = id is null
             ? await DispatchRequestCoreAsync(id, method, root)
             : await DispatchTrackedRequestCoreAsync(id, method, root);
+        if (id is not null)
+            _callTiming?.OnResponded(id);
         await SendResponseAsync(responseJson);
     }
 
@@ -260,31 +310,36 @@ internal sealed class WebViewRpcService : IWebViewRpcService
         }
     }
 
-    private async Task SendResponseAsync(string json)
-    {
-        var script = $"window.agWebView && window.agWebView.rpc && window.agWebView.rpc._onResponse({JsonSerializer.Serialize(json, RpcJsonContext.Default.String)})";
-        await _invokeScript(script);
-    }
+    private Task SendResponseAsync(string json)
+        => _deliver(RpcDeliveryKind.Response, json);
 
     // ==================== Batch dispatch ====================
 
-    private async Task ProcessBatchAsync(JsonElement batchArray)
+    private async Task ProcessBatchAsync(JsonElement batchArray, DateTimeOffset? receivedAt)
+    {
+        var batchJson = await BuildBatchResponseAsync(batchArray, RpcCallTransports.Message, receivedAt);
+        if (batchJson is null) return;
+
+        MarkResponded(batchArray);
+        await SendResponseAsync(batchJson);
+    }
+
+    private async Task<string?> BuildBatchResponseAsync(JsonElement batchArray, string transport, DateTimeOffset? receivedAt)
     {
         var tasks = new List<Task<string?>>();
         foreach (var element in batchArray.EnumerateArray())
         {
-            tasks.Add(ProcessBatchElementAsync(element));
+            tasks.Add(ProcessBatchElementAsync(element, transport, receivedAt));
         }
 
         var responses = await Task.WhenAll(tasks);
         var nonNull = responses.Where(r => r is not null).ToArray();
-        if (nonNull.Length == 0) return;
+        if (nonNull.Length == 0) return null;
 
-        var batchJson = "[" + string.Join(",", nonNull) + "]";
-        await SendResponseAsync(batchJson);
+        return "[" + string.Join(",", nonNull) + "]";
     }
 
-    private async Task<string?> ProcessBatchElementAsync(JsonElement root)
+    private async Task<string?> ProcessBatchElementAsync(JsonElement root, string transport, DateTimeOffset? receivedAt)
     {
         var elementId = root.TryGetProperty("id", out var rawId) ? rawId.GetString() : null;
 
@@ -309,6 +364,7 @@ internal sealed class WebViewRpcService : IWebViewRpcService
             {
                 // Keep cancellation visibility consistent with the single-request dispatch path.
                 _cancellations.MarkActive(id);
+                _callTiming?.OnDispatched(id, method, transport, receivedAt);
                 return await DispatchTrackedRequestCoreAsync(id, method, root);
             }
         }
@@ -316,6 +372,38 @@ internal sealed class WebViewRpcService : IWebViewRpcService
         return RpcResultSerializer.BuildErrorResponseJson(id, -32600, "Invalid Request");
     }
 
+    // ==================== Fetch transport ====================
+
+    /// <summary>
+    /// Called by <c>WebViewCoreBridgeRuntime</c> for a request (or batch) that arrived as the
+    /// body of a fetch bridge POST. Runs the same dispatch as <see cref="TryProcessMessage"/>
+    /// but returns the response JSON for the HTTP body instead of evaluating it in the page.
+    /// Returns <c>null</c> when there is nothing to answer (notifications, malformed bodies).
+    /// </summary>
+    internal async Task<string?> ProcessFetchRequestAsync(string body, DateTimeOffset? receivedAt = null)
+    {
+        if (string.IsNullOrEmpty(body)) return null;
+
+        JsonElement root;
+        try
+        {
+            using var doc = JsonDocument.Parse(body);
+            root = doc.RootElement.Clone();
+        }
+        catch (JsonException ex)
+        {
+            _logger.LogParseMessageFailed(ex);
+            return null;
+        }
+
+        var response = root.ValueKind == JsonValueKind.Array
+            ? await BuildBatchResponseAsync(root, RpcCallTransports.Fetch, receivedAt)
+            : await ProcessBatchElementAsync(root, RpcCallTransports.Fetch, receivedAt);
+        if (response is not null)
+            MarkResponded(root);
+        return response;
+    }
+
     // ==================== Notification routing ====================
 
     private bool HandleNotification(JsonElement root)
@@ -338,6 +426,22 @@ internal sealed class WebViewRpcService : IWebViewRpcService
             return true;
         }
 
+        if (methodName == "$/trace")
+        {
+            if (_callTiming is { } timing && root.TryGetProperty("params", out var traceParams))
+            {
+                try
+                {
+                    timing.OnPageReport(traceParams);
+                }
+                catch (Exception ex)
+                {
+                    _logger.LogCallTimingSinkFailed(ex);
+                }
+            }
+            return true;
+        }
+
         if (methodName == "$/enumerator/abort" && root.TryGetProperty("params", out var abortParams))
         {
             if (abortParams.TryGetProperty("token", out var tokenProp))
@@ -35,4 +35,8 @@ internal static partial class WebViewRpcServiceLog
     [LoggerMessage(EventId = 2406, Level = LogLevel.Debug,
         Message = "RPC: handler for '{Method}' threw")]
     public static partial void LogHandlerThrew(this ILogger logger, System.Exception exception, string method);
+
+    [LoggerMessage(EventId = 2407, Level = LogLevel.Debug,
+        Message = "RPC: call timing sink threw")]
+    public static partial void LogCallTimingSinkFailed(this ILogger logger, System.Exception exception);
 }
@@ -6,9 +6,11 @@ namespace Agibuild.Fulora.Telemetry;
 
 /// <summary>
 /// OpenTelemetry implementation of <see cref="IBridgeTracer"/> that creates Activity spans
-/// and metrics for bridge calls (export and import).
+/// and metrics for bridge calls (export and import). End-to-end call timings from the page
+/// become a round-trip span with one child span per phase, and a per-phase latency histogram
+/// (<c>fulora.bridge.call_phase_ms</c>) from which backends derive percentiles.
 /// </summary>
-public sealed class OpenTelemetryBridgeTracer : IBridgeTracer
+public sealed class OpenTelemetryBridgeTracer : IBridgeTracer, IBridgeCallTimingSink
 {
     /// <summary>Activity source name for Fulora bridge spans.</summary>
     public static readonly string ActivitySourceName = "Agibuild.Fulora";
@@ -28,12 +30,29 @@ public sealed class OpenTelemetryBridgeTracer : IBridgeTracer
     /// <summary>Attribute key for optional params JSON (truncated if large).</summary>
     public const string ParamsJsonKey = "fulora.params_json";
 
+    /// <summary>Attribute key for the call phase of a timing (see <see cref="BridgeCallPhases"/>).</summary>
+    public const string PhaseKey = "fulora.phase";
+
+    /// <summary>Attribute key for the request transport of a timing (message/fetch).</summary>
+    public const string TransportKey = "fulora.transport";
+
+    /// <summary>Attribute key for the JSON-RPC call id of a timing.</summary>
+    public const string CallIdKey = "fulora.call_id";
+
+    /// <summary>Attribute key for the estimated host-minus-page clock offset of a timing, in milliseconds.</summary>
+    public const string ClockOffsetKey = "fulora.clock_offset_ms";
+
+    // Phases range from tens of microseconds (queue hops) to seconds (slow handlers).
+    private static readonly double[] PhaseBucketBoundariesMs =
+        [0.05, 0.1, 0.25, 0.5, 1, 2.5, 5, 10, 25, 50, 100, 250, 500, 1000, 2500, 5000];
+
     private static readonly ActivitySource Source = new(ActivitySourceName);
     private static readonly Meter BridgeMeter = new(MeterName);
 
     private readonly Counter<long> _callCounter;
     private readonly Counter<long> _errorCounter;
     private readonly Histogram<double> _latencyHistogram;
+    private readonly Histogram<double> _phaseHistogram;
 
     private readonly ConcurrentDictionary<string, Activity?> _activities = new();
 
@@ -45,6 +64,12 @@ public sealed class OpenTelemetryBridgeTracer : IBridgeTracer
         _callCounter = BridgeMeter.CreateCounter<long>("fulora.bridge.call_count");
         _errorCounter = BridgeMeter.CreateCounter<long>("fulora.bridge.call_errors");
         _latencyHistogram = BridgeMeter.CreateHistogram<double>("fulora.bridge.call_latency_ms");
+        _phaseHistogram = BridgeMeter.CreateHistogram<double>(
+            "fulora.bridge.call_phase_ms",
+            unit: "ms",
+            description: "JS → C# bridge call latency by phase, page to page.",
+            tags: null,
+            advice: new InstrumentAdvice<double> { HistogramBucketBoundaries = PhaseBucketBoundariesMs });
     }
 
     /// <inheritdoc />
@@ -161,6 +186,57 @@ public sealed class OpenTelemetryBridgeTracer : IBridgeTracer
         // No-op per spec
     }
 
+    /// <inheritdoc />
+    public void OnCallTiming(BridgeCallTiming timing)
+    {
+        ArgumentNullException.ThrowIfNull(timing);
+
+        var tags = new ActivityTagsCollection
+        {
+            { ServiceNameKey, timing.ServiceName },
+            { MethodNameKey, timing.MethodName },
+            { DirectionKey, "export" },
+            { TransportKey, timing.Transport },
+            { CallIdKey, timing.CallId },
+            { ClockOffsetKey, timing.ClockOffset.TotalMilliseconds }
+        };
+
+        var phases = timing.Phases;
+        var (_, invoked, total) = phases[^1];
+        using (var activity = Source.StartActivity(
+            $"{timing.ServiceName}.{timing.MethodName} round trip",
+            ActivityKind.Internal,
+            parentContext: default,
+            tags,
+            links: null,
+            startTime: invoked))
+        {
+            if (activity is not null)
+            {
+                // Children parent to the round-trip span through Activity.Current.
+                foreach (var (phase, start, duration) in phases)
+                {
+                    if (phase == BridgeCallPhases.Total) continue;
+                    using var child = Source.StartActivity(phase, ActivityKind.Internal, parentContext: default, tags: null, links: null, startTime: start);
+                    child?.SetEndTime((start + duration).UtcDateTime);
+                }
+
+                if (timing.IsError)
+                    activity.SetStatus(ActivityStatusCode.Error);
+                activity.SetEndTime((invoked + total).UtcDateTime);
+            }
+        }
+
+        foreach (var (phase, _, duration) in phases)
+        {
+            _phaseHistogram.Record(duration.TotalMilliseconds,
+                new KeyValuePair<string, object?>(ServiceNameKey, timing.ServiceName),
+                new KeyValuePair<string, object?>(MethodNameKey, timing.MethodName),
+                new KeyValuePair<string, object?>(TransportKey, timing.Transport),
+                new KeyValuePair<string, object?>(PhaseKey, phase));
+        }
+    }
+
     private static string Key(string serviceName, string methodName, string direction) =>
         $"{direction}:{serviceName}.{methodName}";
 
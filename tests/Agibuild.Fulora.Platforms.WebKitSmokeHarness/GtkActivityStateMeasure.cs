@@ -0,0 +1,187 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2026 Agibuild
+
+using System.Diagnostics;
+using System.Globalization;
+using Agibuild.Fulora;
+using Agibuild.Fulora.Adapters.Abstractions;
+using Agibuild.Fulora.Adapters.Gtk;
+using static GtkLifecycleSoak;
+
+/// <summary>
+/// Runs an animated page (requestAnimationFrame plus a 4 ms interval) in a WebKitGTK view and,
+/// for each activity state, measures the web process's CPU time and context switches and the
+/// page's own frame and timer counts over the same window. Fails when a hidden state does not
+/// cut animation frames. Linux only; run under Xvfb:
+/// <code>xvfb-run dotnet Agibuild.Fulora.Platforms.WebKitSmokeHarness.dll --case gtk-activity-state --seconds 10</code>
+/// </summary>
+internal static class GtkActivityStateMeasure
+{
+    public const string CaseId = "gtk-activity-state";
+
+    // Linux reports /proc CPU times in USER_HZ, which is 100 on every supported kernel.
+    private const double ClockTicksPerSecond = 100;
+    private static readonly TimeSpan StepTimeout = TimeSpan.FromSeconds(30);
+    private static readonly TimeSpan Settle = TimeSpan.FromSeconds(1);
+
+    private const string AnimatedPage = """
+        <!doctype html><html><body><canvas id="c" width="640" height="480"></canvas><script>
+        window.__frames = 0; window.__ticks = 0;
+        var ctx = document.getElementById('c').getContext('2d');
+        (function frame(t) {
+            window.__frames++;
+            ctx.fillStyle = 'hsl(' + (t / 10 % 360) + ',80%,50%)';
+            ctx.fillRect(0, 0, 640, 480);
+            requestAnimationFrame(frame);
+        })(0);
+        setInterval(function() { window.__ticks++; }, 4);
+        </script></body></html>
+        """;
+
+    private readonly record struct Counters(long CpuTicks, long ContextSwitches, long Frames, long Ticks, long Timestamp);
+
+    private readonly record struct Measurement(WebViewActivityState State, double CpuPercent, double SwitchesPerSecond, double FramesPerSecond, double TicksPerSecond);
+
+    /// <summary>Measures every activity state; throws when hiding the view does not throttle it. Returns a one-line summary.</summary>
+    public static string Run(string[] args)
+    {
+        var window = TimeSpan.FromSeconds(ParseInt(args, "--seconds", 5));
+
+        var display = Native.XOpenDisplay(IntPtr.Zero);
+        if (display == IntPtr.Zero)
+            throw new InvalidOperationException("Could not open the X11 display.");
+        var xid = Native.XCreateSimpleWindow(display, Native.XDefaultRootWindow(display), 0, 0, 800, 600, 0, 0, 0);
+        Native.XMapWindow(display, xid);
+        Native.XFlush(display);
+        Native.g_main_context_acquire(IntPtr.Zero);
+
+        var adapter = new GtkWebViewAdapter();
+        try
+        {
+            adapter.Initialize(new SoakHost());
+            adapter.AutoActivityState = false;
+
+            var navigated = new TaskCompletionSource<NavigationCompletedStatus>(TaskCreationOptions.RunContinuationsAsynchronously);
+            adapter.NavigationCompleted += (_, e) => navigated.TrySetResult(e.Status);
+            adapter.Attach(new X11Handle((nint)xid));
+            adapter.NavigateToStringAsync(Guid.NewGuid(), AnimatedPage).GetAwaiter().GetResult();
+            if (Pump(navigated.Task) != NavigationCompletedStatus.Success)
+                throw new InvalidOperationException("The animated page did not load.");
+
+            var results = new List<Measurement>();
+            foreach (var state in new[] { WebViewActivityState.Active, WebViewActivityState.Throttled, WebViewActivityState.Suspended })
+            {
+                adapter.SetActivityState(state);
+                Spin(Settle);
+                var m = Measure(adapter, state, window);
+                Console.WriteLine(string.Create(CultureInfo.InvariantCulture,
+                    $"// state={m.State} webCpu={m.CpuPercent:F1}% switches/s={m.SwitchesPerSecond:F0} frames/s={m.FramesPerSecond:F1} timers/s={m.TicksPerSecond:F1}"));
+                results.Add(m);
+            }
+
+            var active = results[0];
+            foreach (var hidden in results.Skip(1))
+            {
+                if (hidden.FramesPerSecond >= active.FramesPerSecond / 2)
+                    throw new InvalidOperationException(string.Create(CultureInfo.InvariantCulture,
+                        $"{hidden.State} still ran {hidden.FramesPerSecond:F1} frames/s against {active.FramesPerSecond:F1} while active."));
+            }
+
+            return string.Join("; ", results.Select(m => string.Create(CultureInfo.InvariantCulture,
+                $"{m.State.ToString().ToLowerInvariant()} cpu {m.CpuPercent:F1}% switches {m.SwitchesPerSecond:F0}/s")));
+        }
+        finally
+        {
+            adapter.Detach();
+            Native.g_main_context_release(IntPtr.Zero);
+            Native.XDestroyWindow(display, xid);
+            Native.XCloseDisplay(display);
+        }
+    }
+
+    private static Measurement Measure(GtkWebViewAdapter adapter, WebViewActivityState state, TimeSpan window)
+    {
+        var before = Read(adapter);
+        Spin(window);
+        var after = Read(adapter);
+
+        var seconds = (after.Timestamp - before.Timestamp) / (double)Stopwatch.Frequency;
+        return new Measurement(state,
+            CpuPercent: (after.CpuTicks - before.CpuTicks) / ClockTicksPerSecond / seconds * 100,
+            SwitchesPerSecond: (after.ContextSwitches - before.ContextSwitches) / seconds,
+            FramesPerSecond: (after.Frames - before.Frames) / seconds,
+            TicksPerSecond: (after.Ticks - before.Ticks) / seconds);
+    }
+
+    private static Counters Read(GtkWebViewAdapter adapter)
+    {
+        var page = Pump(adapter.InvokeScriptAsync("window.__frames + ',' + window.__ticks"))?.Trim('"').Split(',');
+        if (page is not { Length: 2 })
+            throw new InvalidOperationException("Could not read the page counters.");
+
+        var (cpu, switches) = ReadWebProcessActivity();
+        return new Counters(cpu, switches,
+            long.Parse(page[0], CultureInfo.InvariantCulture),
+            long.Parse(page[1], CultureInfo.InvariantCulture),
+            Stopwatch.GetTimestamp());
+    }
+
+    /// <summary>Sums utime+stime and voluntary+involuntary context switches over this process's web processes.</summary>
+    private static (long CpuTicks, long ContextSwitches) ReadWebProcessActivity()
+    {
+        var self = Environment.ProcessId;
+        long cpu = 0, switches = 0;
+        foreach (var dir in Directory.EnumerateDirectories("/proc"))
+        {
+            if (!int.TryParse(Path.GetFileName(dir), NumberStyles.None, CultureInfo.InvariantCulture, out var pid) || pid == self)
+                continue;
+            var comm = TryRead(Path.Combine(dir, "comm"))?.Trim();
+            if (comm is null || !comm.StartsWith("WebKitWeb", StringComparison.Ordinal) || !DescendsFrom(pid, self))
+                continue;
+
+            // Fields after "(comm) ": state is [0], utime [11], stime [12].
+            var stat = TryRead(Path.Combine(dir, "stat"));
+            if (stat is not null)
+            {
+                var fields = stat[(stat.LastIndexOf(')') + 2)..].Split(' ');
+                cpu += long.Parse(fields[11], CultureInfo.InvariantCulture) + long.Parse(fields[12], CultureInfo.InvariantCulture);
+            }
+
+            foreach (var line in (TryRead(Path.Combine(dir, "status")) ?? "").Split('\n'))
+            {
+                if (line.StartsWith("voluntary_ctxt_switches:", StringComparison.Ordinal)
+                    || line.StartsWith("nonvoluntary_ctxt_switches:", StringComparison.Ordinal))
+                    switches += long.Parse(line.AsSpan(line.IndexOf(':') + 1).Trim(), CultureInfo.InvariantCulture);
+            }
+        }
+        return (cpu, switches);
+    }
+
+    private static void Spin(TimeSpan duration)
+    {
+        var until = Stopwatch.GetTimestamp() + (long)(duration.TotalSeconds * Stopwatch.Frequency);
+        while (Stopwatch.GetTimestamp() < until)
+        {
+            if (!Native.g_main_context_iteration(IntPtr.Zero, false))
+                Thread.Sleep(5);
+        }
+    }
+
+    private static T Pump<T>(Task<T> task)
+    {
+        var deadline = Stopwatch.GetTimestamp() + (long)(StepTimeout.TotalSeconds * Stopwatch.Frequency);
+        while (!task.IsCompleted)
+        {
+            if (Stopwatch.GetTimestamp() > deadline)
+                throw new TimeoutException($"A measurement step did not finish within {StepTimeout}.");
+            Native.g_main_context_iteration(IntPtr.Zero, false);
+        }
+        return task.GetAwaiter().GetResult();
+    }
+
+    private static int ParseInt(string[] args, string name, int fallback)
+    {
+        var i = Array.IndexOf(args, name);
+        return i >= 0 && i + 1 < args.Length ? int.Parse(args[i + 1], CultureInfo.InvariantCulture) : fallback;
+    }
+}
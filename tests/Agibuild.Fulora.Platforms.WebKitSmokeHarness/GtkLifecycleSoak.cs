@@ -0,0 +1,671 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2026 Agibuild
+
+using System.Diagnostics;
+using System.Globalization;
+using System.Runtime.InteropServices;
+using System.Text;
+using Agibuild.Fulora;
+using Agibuild.Fulora.Adapters.Gtk;
+
+/// <summary>
+/// Cycles WebKitGTK views through create, attach, custom-scheme navigation, script evaluation,
+/// preload scripts, shared content sets, a screenshot and detach, then checks that the shim's view and operation
+/// counts, GObject instance counts, process RSS (UI and WebKit child processes) and open file
+/// descriptors stay within budget of a post-warm-up baseline. Linux only; run under Xvfb:
+/// <code>xvfb-run dotnet Agibuild.Fulora.Platforms.WebKitSmokeHarness.dll --case gtk-lifecycle-soak --iterations 5000</code>
+/// </summary>
+internal static partial class GtkLifecycleSoak
+{
+    public const string CaseId = "gtk-lifecycle-soak";
+
+    private const string InstanceCountVariable = "GOBJECT_DEBUG";
+    private const string SharedSetName = "soak-shared";
+    private const string DroppedSetName = "soak-dropped";
+    private const string SharedSetScript = "window.__soakSet = (window.__soakSet || 0) + 1;";
+    private static readonly TimeSpan StepTimeout = TimeSpan.FromSeconds(30);
+
+    private sealed record Options(int Iterations, int Warmup, int SampleEvery, long UiRssBudgetMb, long WebRssBudgetMb, int FdBudget, int ObjectSlack);
+
+    private readonly record struct Sample(int Cycle, GtkNativeResourceStats Stats, long UiRssKb, long WebRssKb, int WebProcesses, int Fds);
+
+    /// <summary>GObject only honours instance-count when it is set before the library initialises.</summary>
+    public static bool HasInstanceCounting()
+        => Environment.GetEnvironmentVariable(InstanceCountVariable)?.Contains("instance-count", StringComparison.Ordinal) == true;
+
+    /// <summary>Runs this case again in a child process with GObject instance counting enabled.</summary>
+    public static int RelaunchWithInstanceCounting()
+    {
+        var commandLine = Environment.GetCommandLineArgs();
+        var startInfo = new ProcessStartInfo(Environment.ProcessPath!) { UseShellExecute = false };
+        // Under `dotnet harness.dll` the first argument is the entry assembly.
+        var first = commandLine[0].EndsWith(".dll", StringComparison.OrdinalIgnoreCase) ? 0 : 1;
+        for (var i = first; i < commandLine.Length; i++)
+            startInfo.ArgumentList.Add(commandLine[i]);
+
+        var existing = Environment.GetEnvironmentVariable(InstanceCountVariable);
+        startInfo.Environment[InstanceCountVariable] = string.IsNullOrEmpty(existing) ? "instance-count" : existing + ",instance-count";
+
+        using var child = Process.Start(startInfo)!;
+        child.WaitForExit();
+        return child.ExitCode;
+    }
+
+    /// <summary>Runs the soak; throws when a budget is exceeded. Returns a one-line summary.</summary>
+    public static string Run(string[] args)
+    {
+        var options = ParseOptions(args);
+
+        var display = Native.XOpenDisplay(IntPtr.Zero);
+        if (display == IntPtr.Zero)
+            throw new InvalidOperationException("Could not open the X11 display.");
+        var window = Native.XCreateSimpleWindow(display, Native.XDefaultRootWindow(display), 0, 0, 800, 600, 0, 0, 0);
+        Native.XMapWindow(display, window);
+        Native.XFlush(display);
+        Native.g_main_context_acquire(IntPtr.Zero);
+
+        try
+        {
+            for (var i = 0; i < options.Warmup; i++)
+                RunCycle(window, i);
+            Drain();
+
+            var baseline = TakeSample(0);
+            WriteSample("baseline", baseline);
+
+            var last = baseline;
+            for (var i = 1; i <= options.Iterations; i++)
+            {
+                RunCycle(window, i);
+                if (i % options.SampleEvery == 0 || i == options.Iterations)
+                {
+                    Drain();
+                    last = TakeSample(i);
+                    WriteSample("sample", last);
+                }
+            }
+
+            CheckBudgets(options, baseline, last);
+            return string.Create(CultureInfo.InvariantCulture,
+                $"{options.Iterations} cycles; ui rss {Delta(baseline.UiRssKb, last.UiRssKb)} KiB, web rss {Delta(baseline.WebRssKb, last.WebRssKb)} KiB, fds {Delta(baseline.Fds, last.Fds)}");
+        }
+        finally
+        {
+            Native.g_main_context_release(IntPtr.Zero);
+            Native.XDestroyWindow(display, window);
+            Native.XCloseDisplay(display);
+        }
+    }
+
+    // ==================== One view lifetime ====================
+
+    private static void RunCycle(ulong window, int cycle)
+    {
+        var adapter = new GtkWebViewAdapter();
+        var host = new SoakHost();
+        adapter.Initialize(host);
+        adapter.RegisterCustomSchemes([new CustomSchemeRegistration { SchemeName = "soak", HasAuthorityComponent = true }]);
+        adapter.WebResourceRequested += (_, e) => ServeSchemeRequest(e, cycle);
+        var held = new HeldUpload();
+        adapter.SchemeUploadHandler = (upload, ct) => ServeUploadAsync(upload, held, ct);
+        var holdingUpload = false;
+
+        var navigated = new TaskCompletionSource<NavigationCompletedStatus>(TaskCreationOptions.RunContinuationsAsynchronously);
+        var navigationsCompleted = 0;
+        adapter.NavigationCompleted += (_, e) =>
+        {
+            navigationsCompleted++;
+            navigated.TrySetResult(e.Status);
+        };
+
+        try
+        {
+            // A set attached before Attach and destroyed before Attach must not be applied (or
+            // touched) when the view attaches; a live set is redefined while attached and must
+            // still run exactly once per document.
+            GtkWebViewAdapter.DefineSharedContentSet(DroppedSetName, ["window.__soakDropped = true;"]);
+            adapter.AttachSharedContentSet(DroppedSetName);
+            GtkWebViewAdapter.DestroySharedContentSet(DroppedSetName);
+            GtkWebViewAdapter.DefineSharedContentSet(SharedSetName, [SharedSetScript]);
+            adapter.AttachSharedContentSet(SharedSetName);
+
+            adapter.Attach(new X11Handle((nint)window));
+
+            GtkWebViewAdapter.DefineSharedContentSet(SharedSetName, [SharedSetScript]);
+            adapter.AttachSharedContentSet(SharedSetName);
+            var preloadId = adapter.AddPreloadScript("window.__soakPreload = true;");
+            adapter.NavigateAsync(Guid.NewGuid(), new Uri("soak://app/index.html")).GetAwaiter().GetResult();
+            var status = Pump(navigated.Task);
+            if (status != NavigationCompletedStatus.Success)
+                throw new InvalidOperationException($"Cycle {cycle}: navigation finished with {status}.");
+
+            var title = Pump(adapter.InvokeScriptAsync(
+                "document.title + ':' + window.__soakScript + ':' + window.__soakPreload + ':' + window.__soakSet + ':' + (window.__soakDropped === undefined)"));
+            if (title?.Contains("soak:loaded:true:1:true", StringComparison.Ordinal) != true)
+                throw new InvalidOperationException($"Cycle {cycle}: unexpected page state {title}.");
+
+            adapter.RemovePreloadScript(preloadId);
+
+            var png = Pump(adapter.CaptureScreenshotAsync());
+            if (png.Length == 0)
+                throw new InvalidOperationException($"Cycle {cycle}: empty screenshot.");
+
+            if (cycle % 5 == 1)
+                CheckPublishedBlob(adapter, cycle);
+            if (cycle % 5 == 2)
+                CheckRunawayScript(adapter, cycle);
+            if (cycle % 5 == 3)
+                CheckSchemeUploads(adapter, cycle);
+
+            // Every fifth view is hibernated and resumed; the restore reload must not look like
+            // a new navigation to the host.
+            if (cycle % 5 == 0)
+            {
+                var (starts, completions) = (host.NavigationStarts, navigationsCompleted);
+                Pump(adapter.HibernateAsync(captureSnapshot: cycle % 10 == 0));
+                adapter.Resume();
+                var restored = PumpUntil(() => adapter.InvokeScriptAsync("document.readyState + ':' + window.__soakScript"),
+                    "complete:loaded");
+                if (!restored || host.NavigationStarts != starts || navigationsCompleted != completions)
+                    throw new InvalidOperationException(
+                        $"Cycle {cycle}: resume restored={restored}, navigation starts {host.NavigationStarts - starts}, completions {navigationsCompleted - completions}.");
+            }
+
+            // Every tenth view goes away with work still in flight, so the abort paths are soaked too.
+            if (cycle % 10 == 0)
+            {
+                _ = adapter.InvokeScriptAsync("new Promise(function() {})").ContinueWith(t => _ = t.Exception, TaskScheduler.Default);
+                _ = adapter.CaptureScreenshotAsync().ContinueWith(t => _ = t.Exception, TaskScheduler.Default);
+
+                // An upload handler still running at detach sees its token cancelled; its reply
+                // must not reach the destroyed view.
+                Pump(adapter.InvokeScriptAsync("fetch('/upload/hold', { method: 'POST', body: 'x' }).catch(function() {}); 0"));
+                Pump(held.Started.Task);
+                holdingUpload = true;
+            }
+        }
+        finally
+        {
+            // Alternate destroying the shared set while it is attached and after the view is gone.
+            if (cycle % 2 == 0)
+                GtkWebViewAdapter.DestroySharedContentSet(SharedSetName);
+            adapter.Detach();
+            if (cycle % 2 != 0)
+                GtkWebViewAdapter.DestroySharedContentSet(SharedSetName);
+        }
+
+        if (holdingUpload && !held.Cancelled.Task.Wait(StepTimeout))
+            throw new InvalidOperationException($"Cycle {cycle}: detach did not cancel the pending upload handler.");
+    }
+
+    // ==================== Published blobs ====================
+
+    private const int BlobLength = 8 * 1024 * 1024;
+
+    private const string BlobRangeScript = """
+        (function() {
+            window.__blobRanges = null;
+            function get(range) {
+                return fetch('/__blob/soak', range ? { headers: { Range: range } } : {}).then(function(r) {
+                    return r.arrayBuffer().then(function(b) {
+                        var v = new Uint8Array(b);
+                        return r.status + ':' + v.length + ':' + (v.length ? v[0] : -1);
+                    });
+                });
+            }
+            Promise.all([get('bytes=100-'), get('bytes=-3'), get('bytes=8388608-'), get('bytes=5-2')]).then(
+                function(a) { window.__blobRanges = a.join(','); },
+                function(e) { window.__blobRanges = 'error:' + e; });
+        })()
+        """;
+
+    private const string BlobInFlightScript = """
+        (function() {
+            window.__blobInFlight = null;
+            fetch('/__blob/soak').then(function(r) {
+                window.__blobInFlight = 'streaming';
+                return r.arrayBuffer();
+            }).then(function(b) {
+                var v = new Uint8Array(b), sum = 0;
+                for (var i = 0; i < v.length; i++) sum = (sum + v[i]) % 65521;
+                window.__blobInFlight = 'done:' + v.length + ':' + sum;
+            }, function(e) { window.__blobInFlight = 'error:' + e; });
+        })()
+        """;
+
+    /// <summary>
+    /// Serves ranges of a published blob (open-ended, suffix, past the end, malformed) and revokes
+    /// it while a response is still streaming; that response must complete intact and the buffer
+    /// must be released only afterwards.
+    /// </summary>
+    private static void CheckPublishedBlob(GtkWebViewAdapter adapter, int cycle)
+    {
+        var data = new byte[BlobLength];
+        var sum = 0;
+        for (var i = 0; i < data.Length; i++)
+        {
+            data[i] = (byte)(i % 251);
+            sum = (sum + data[i]) % 65521;
+        }
+        var owner = new ReleaseProbe();
+        adapter.PublishBlob("soak", data, "application/octet-stream", owner);
+
+        Pump(adapter.InvokeScriptAsync(BlobRangeScript));
+        var expected = string.Create(CultureInfo.InvariantCulture,
+            $"206:{BlobLength - 100}:{100 % 251},206:3:{(BlobLength - 3) % 251},416:0:-1,200:{BlobLength}:0");
+        if (!PumpUntil(() => adapter.InvokeScriptAsync("String(window.__blobRanges)"), expected))
+            throw new InvalidOperationException($"Cycle {cycle}: blob ranges {Pump(adapter.InvokeScriptAsync("String(window.__blobRanges)"))}.");
+
+        Pump(adapter.InvokeScriptAsync(BlobInFlightScript));
+        if (!PumpUntil(() => adapter.InvokeScriptAsync("window.__blobInFlight === null ? 'waiting' : 'started'"), "started"))
+            throw new InvalidOperationException($"Cycle {cycle}: the blob response never started.");
+        if (!adapter.RevokeBlob("soak"))
+            throw new InvalidOperationException($"Cycle {cycle}: the blob was not published.");
+
+        var done = string.Create(CultureInfo.InvariantCulture, $"done:{BlobLength}:{sum}");
+        if (!PumpUntil(() => adapter.InvokeScriptAsync("String(window.__blobInFlight)"), done))
+            throw new InvalidOperationException($"Cycle {cycle}: revoked blob response {Pump(adapter.InvokeScriptAsync("String(window.__blobInFlight)"))}.");
+
+        if (!PumpUntil(() => Task.FromResult<string?>(owner.Released ? "released" : null), "released")
+            || adapter.PublishedBlobBytes != 0)
+            throw new InvalidOperationException($"Cycle {cycle}: blob still held ({adapter.PublishedBlobBytes} bytes).");
+        GC.KeepAlive(data);
+    }
+
+    private sealed class ReleaseProbe : IDisposable
+    {
+        private int _released;
+
+        public bool Released => Volatile.Read(ref _released) != 0;
+
+        public void Dispose() => Volatile.Write(ref _released, 1);
+    }
+
+    // ==================== Runaway scripts ====================
+
+    private const string RunawayScript = "(function() { var end = Date.now() + 3000; while (Date.now() < end) {} return 'late'; })()";
+
+    /// <summary>
+    /// Times out a script that keeps the web process busy well past its deadline: the request must
+    /// fail at the deadline, and the request queued behind it must get its in-flight slot at once
+    /// rather than when the runaway script finally returns.
+    /// </summary>
+    private static void CheckRunawayScript(GtkWebViewAdapter adapter, int cycle)
+    {
+        adapter.ConfigureScriptEvaluation(maxInFlight: 1, maxQueued: 1, TimeSpan.FromMilliseconds(250));
+        var started = Stopwatch.GetTimestamp();
+        var runaway = adapter.InvokeScriptAsync(RunawayScript);
+        adapter.ConfigureScriptEvaluation(maxInFlight: 1, maxQueued: 1);
+        var next = adapter.InvokeScriptAsync("'next'");
+
+        var failed = Pump(runaway.ContinueWith(t => t.Exception?.InnerException, TaskScheduler.Default));
+        var elapsed = Stopwatch.GetElapsedTime(started);
+        var stats = adapter.GetScriptEvaluationStats();
+        if (failed is not WebViewScriptException { InnerException: TimeoutException } || elapsed > TimeSpan.FromSeconds(2))
+            throw new InvalidOperationException($"Cycle {cycle}: runaway script settled after {elapsed} with {failed?.GetType().Name ?? "a result"}.");
+        if (stats != (1, 0))
+            throw new InvalidOperationException($"Cycle {cycle}: after the timeout {stats.Running} running, {stats.Queued} queued.");
+
+        if (Pump(next) != "next")
+            throw new InvalidOperationException($"Cycle {cycle}: the queued script did not complete.");
+        adapter.ConfigureScriptEvaluation(maxInFlight: 0, maxQueued: 0);
+    }
+
+    // ==================== Scheme uploads ====================
+
+    private const int UploadLength = 256 * 1024;
+
+    private static readonly string UploadScript = $$"""
+        (function() {
+            window.__uploads = null;
+            var body = new Uint8Array({{UploadLength}});
+            for (var i = 0; i < body.length; i++) body[i] = i % 251;
+            function post(path) {
+                return fetch(path, { method: 'POST', body: body }).then(
+                    function(r) { return r.text().then(function(t) { return r.status + ':' + t; }); },
+                    function() { return 'failed'; });
+            }
+            function get(path) {
+                return fetch(path).then(function(r) { return 'status:' + r.status; }, function() { return 'failed'; });
+            }
+            Promise.all([post('/upload/echo'), post('/upload/none'), post('/upload/throw'), get('/unhandled')]).then(
+                function(a) { window.__uploads = a.join(','); });
+        })()
+        """;
+
+    /// <summary>
+    /// Posts bodies through <see cref="GtkWebViewAdapter.SchemeUploadHandler"/>: a deferred
+    /// request answered by the handler, one it does not handle and one it fails, plus a
+    /// body-less request no handler takes.
+    /// </summary>
+    private static void CheckSchemeUploads(GtkWebViewAdapter adapter, int cycle)
+    {
+        var sum = 0;
+        for (var i = 0; i < UploadLength; i++)
+            sum = (sum + i % 251) % 65521;
+
+        Pump(adapter.InvokeScriptAsync(UploadScript));
+        var expected = string.Create(CultureInfo.InvariantCulture, $"200:{UploadLength}:{sum},failed,failed,failed");
+        if (!PumpUntil(() => adapter.InvokeScriptAsync("String(window.__uploads)"), expected))
+            throw new InvalidOperationException($"Cycle {cycle}: uploads {Pump(adapter.InvokeScriptAsync("String(window.__uploads)"))}.");
+    }
+
+    private sealed class HeldUpload
+    {
+        public TaskCompletionSource Started { get; } = new(TaskCreationOptions.RunContinuationsAsynchronously);
+        public TaskCompletionSource Cancelled { get; } = new(TaskCreationOptions.RunContinuationsAsynchronously);
+    }
+
+    private static async Task<GtkSchemeResponse?> ServeUploadAsync(GtkSchemeUpload upload, HeldUpload held, CancellationToken cancellationToken)
+    {
+        switch (upload.RequestUri.AbsolutePath)
+        {
+            case "/upload/echo":
+                if (upload.Body.CanSeek || upload.ContentLength != UploadLength || upload.Body.Length != UploadLength)
+                    throw new InvalidOperationException("Unexpected upload body shape.");
+                var buffer = new byte[16 * 1024];
+                long total = 0;
+                var sum = 0;
+                int read;
+                while ((read = await upload.Body.ReadAsync(buffer, cancellationToken)) > 0)
+                {
+                    for (var i = 0; i < read; i++)
+                        sum = (sum + buffer[i]) % 65521;
+                    total += read;
+                }
+                if (upload.Body.Position != total)
+                    throw new InvalidOperationException("Upload position does not match the bytes read.");
+                return new GtkSchemeResponse(Encoding.UTF8.GetBytes(string.Create(CultureInfo.InvariantCulture, $"{total}:{sum}")), "text/plain");
+
+            case "/upload/hold":
+                held.Started.TrySetResult();
+                try
+                {
+                    await Task.Delay(Timeout.Infinite, cancellationToken);
+                }
+                catch (OperationCanceledException)
+                {
+                    held.Cancelled.TrySetResult();
+                    throw;
+                }
+                return null;
+
+            case "/upload/throw":
+                throw new InvalidOperationException("soak upload failure");
+
+            default:
+                return null;
+        }
+    }
+
+    private static void ServeSchemeRequest(WebResourceRequestedEventArgs e, int cycle)
+    {
+        if (e.RequestUri?.AbsolutePath == "/unhandled")
+            return;
+
+        var (body, contentType) = e.RequestUri?.AbsolutePath switch
+        {
+            "/index.html" => ("<!doctype html><html><head><title>soak</title><script src=\"soak://app/app.js\"></script></head>"
+                + "<body><img src=\"soak://app/pixel.svg\"><p>cycle " + cycle + "</p></body></html>", "text/html"),
+            "/app.js" => ("window.__soakScript = 'loaded';", "text/javascript"),
+            "/pixel.svg" => ("<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"1\" height=\"1\"/>", "image/svg+xml"),
+            _ => ((string?)null, "text/plain"),
+        };
+
+        if (body is null)
+        {
+            e.ResponseStatusCode = 404;
+            e.ResponseBody = new MemoryStream();
+        }
+        else
+        {
+            e.ResponseBody = new MemoryStream(Encoding.UTF8.GetBytes(body));
+        }
+        e.ResponseContentType = contentType;
+        e.Handled = true;
+    }
+
+    // ==================== Measurement ====================
+
+    /// <summary>Lets WebKit finish tearing views down, then collects managed garbage.</summary>
+    private static void Drain()
+    {
+        var until = Stopwatch.GetTimestamp() + Stopwatch.Frequency;
+        while (Stopwatch.GetTimestamp() < until)
+        {
+            if (!Native.g_main_context_iteration(IntPtr.Zero, false))
+                Thread.Sleep(5);
+        }
+
+        GC.Collect();
+        GC.WaitForPendingFinalizers();
+        GC.Collect();
+    }
+
+    private static Sample TakeSample(int cycle)
+    {
+        var (webRss, webProcesses) = ReadWebProcessRss();
+        return new Sample(cycle, GtkWebViewAdapter.GetNativeResourceStats(),
+            ReadRssKb("/proc/self/status"), webRss, webProcesses,
+            Directory.GetFileSystemEntries("/proc/self/fd").Length);
+    }
+
+    private static void WriteSample(string label, in Sample s)
+        => Console.WriteLine(string.Create(CultureInfo.InvariantCulture,
+            $"// {label} cycle={s.Cycle} views={s.Stats.LiveViews} attached={s.Stats.AttachedViews} ops={s.Stats.OutstandingOperations} tables={s.Stats.OperationTables} " +
+            $"webviews={s.Stats.WebViews} ucms={s.Stats.UserContentManagers} plugs={s.Stats.Plugs} uiRssKb={s.UiRssKb} webRssKb={s.WebRssKb} webProcs={s.WebProcesses} fds={s.Fds}"));
+
+    private static void CheckBudgets(Options options, in Sample baseline, in Sample last)
+    {
+        var failures = new List<string>();
+
+        void Exact(string name, long before, long after)
+        {
+            if (after != before)
+                failures.Add($"{name}: {before} -> {after}");
+        }
+
+        void AtMost(string name, long before, long after, long budget, string unit = "")
+        {
+            if (after - before > budget)
+                failures.Add($"{name} grew by {after - before}{unit} (budget {budget}{unit})");
+        }
+
+        Exact("live views", baseline.Stats.LiveViews, last.Stats.LiveViews);
+        Exact("attached views", baseline.Stats.AttachedViews, last.Stats.AttachedViews);
+        Exact("outstanding operations", baseline.Stats.OutstandingOperations, last.Stats.OutstandingOperations);
+        Exact("operation tables", baseline.Stats.OperationTables, last.Stats.OperationTables);
+
+        if (last.Stats.HasInstanceCounts)
+        {
+            AtMost("WebKitWebView instances", baseline.Stats.WebViews, last.Stats.WebViews, options.ObjectSlack);
+            AtMost("WebKitUserContentManager instances", baseline.Stats.UserContentManagers, last.Stats.UserContentManagers, options.ObjectSlack);
+            AtMost("WebKitWebContext instances", baseline.Stats.WebContexts, last.Stats.WebContexts, options.ObjectSlack);
+            AtMost("GtkPlug instances", baseline.Stats.Plugs, last.Stats.Plugs, options.ObjectSlack);
+        }
+
+        AtMost("UI process RSS", baseline.UiRssKb / 1024, last.UiRssKb / 1024, options.UiRssBudgetMb, " MiB");
+        AtMost("WebKit process RSS", baseline.WebRssKb / 1024, last.WebRssKb / 1024, options.WebRssBudgetMb, " MiB");
+        AtMost("WebKit processes", baseline.WebProcesses, last.WebProcesses, options.ObjectSlack);
+        AtMost("open file descriptors", baseline.Fds, last.Fds, options.FdBudget);
+
+        if (failures.Count > 0)
+            throw new InvalidOperationException($"Lifecycle soak exceeded its budgets after {last.Cycle} cycles: {string.Join("; ", failures)}");
+    }
+
+    private static long ReadRssKb(string statusPath)
+    {
+        try
+        {
+            foreach (var line in File.ReadLines(statusPath))
+            {
+                if (line.StartsWith("VmRSS:", StringComparison.Ordinal))
+                    return long.Parse(line.AsSpan(6).Trim().TrimEnd("kB").Trim(), CultureInfo.InvariantCulture);
+            }
+        }
+        catch (IOException)
+        {
+            // The process exited while we were reading it.
+        }
+        return 0;
+    }
+
+    /// <summary>Sums RSS over WebKit web and network processes descended from this process.</summary>
+    private static (long RssKb, int Count) ReadWebProcessRss()
+    {
+        var self = Environment.ProcessId;
+        long total = 0;
+        var count = 0;
+        foreach (var dir in Directory.EnumerateDirectories("/proc"))
+        {
+            if (!int.TryParse(Path.GetFileName(dir), NumberStyles.None, CultureInfo.InvariantCulture, out var pid) || pid == self)
+                continue;
+            var comm = TryRead(Path.Combine(dir, "comm"))?.Trim();
+            if (comm is null || !comm.StartsWith("WebKit", StringComparison.Ordinal) || !DescendsFrom(pid, self))
+                continue;
+            total += ReadRssKb(Path.Combine(dir, "status"));
+            count++;
+        }
+        return (total, count);
+    }
+
+    /// <summary>WebKit may start its children through a sandbox launcher, so walk a few levels up.</summary>
+    internal static bool DescendsFrom(int pid, int ancestor)
+    {
+        for (var depth = 0; depth < 4 && pid > 1; depth++)
+        {
+            var stat = TryRead($"/proc/{pid}/stat");
+            if (stat is null) return false;
+            // "pid (comm) state ppid ..."; comm may contain spaces, so parse after the last ')'.
+            var fields = stat[(stat.LastIndexOf(')') + 2)..].Split(' ');
+            if (!int.TryParse(fields[1], NumberStyles.None, CultureInfo.InvariantCulture, out pid))
+                return false;
+            if (pid == ancestor) return true;
+        }
+        return false;
+    }
+
+    internal static string? TryRead(string path)
+    {
+        try
+        {
+            return File.ReadAllText(path);
+        }
+        catch (IOException)
+        {
+            return null;
+        }
+        catch (UnauthorizedAccessException)
+        {
+            return null;
+        }
+    }
+
+    private static string Delta(long before, long after)
+        => (after - before).ToString("+#;-#;0", CultureInfo.InvariantCulture);
+
+    // ==================== Plumbing ====================
+
+    private static Options ParseOptions(string[] args)
+    {
+        int Int(string name, int fallback)
+        {
+            var i = Array.IndexOf(args, name);
+            return i >= 0 && i + 1 < args.Length ? int.Parse(args[i + 1], CultureInfo.InvariantCulture) : fallback;
+        }
+
+        return new Options(
+            Iterations: Int("--iterations", 2000),
+            Warmup: Int("--warmup", 50),
+            SampleEvery: Math.Max(1, Int("--sample-every", 250)),
+            UiRssBudgetMb: Int("--ui-rss-budget-mb", 64),
+            WebRssBudgetMb: Int("--web-rss-budget-mb", 128),
+            FdBudget: Int("--fd-budget", 16),
+            ObjectSlack: Int("--object-slack", 2));
+    }
+
+    private static T Pump<T>(Task<T> task)
+    {
+        var deadline = Stopwatch.GetTimestamp() + (long)(StepTimeout.TotalSeconds * Stopwatch.Frequency);
+        while (!task.IsCompleted)
+        {
+            if (Stopwatch.GetTimestamp() > deadline)
+                throw new TimeoutException($"A soak step did not finish within {StepTimeout}.");
+            Native.g_main_context_iteration(IntPtr.Zero, false);
+        }
+        return task.GetAwaiter().GetResult();
+    }
+
+    private static void Pump(Task task)
+        => Pump(task.ContinueWith(static t => { t.GetAwaiter().GetResult(); return true; }, TaskScheduler.Default));
+
+    /// <summary>Re-runs <paramref name="probe"/> until it returns <paramref name="expected"/> or the step times out.</summary>
+    private static bool PumpUntil(Func<Task<string?>> probe, string expected)
+    {
+        var deadline = Stopwatch.GetTimestamp() + (long)(StepTimeout.TotalSeconds * Stopwatch.Frequency);
+        while (Stopwatch.GetTimestamp() < deadline)
+        {
+            if (Pump(probe())?.Contains(expected, StringComparison.Ordinal) == true)
+                return true;
+            Native.g_main_context_iteration(IntPtr.Zero, false);
+        }
+        return false;
+    }
+
+    internal sealed class SoakHost : IWebViewAdapterHost
+    {
+        public Guid ChannelId { get; } = Guid.NewGuid();
+
+        public int NavigationStarts { get; private set; }
+
+        public ValueTask<NativeNavigationStartingDecision> OnNativeNavigationStartingAsync(NativeNavigationStartingInfo info)
+        {
+            NavigationStarts++;
+            return ValueTask.FromResult(new NativeNavigationStartingDecision(IsAllowed: true, NavigationId: info.CorrelationId));
+        }
+    }
+
+    internal sealed record X11Handle(nint Handle) : INativeHandle
+    {
+        public string HandleDescriptor => "XID";
+    }
+
+    internal static partial class Native
+    {
+        private const string X11Lib = "libX11.so.6";
+        private const string GLibLib = "libglib-2.0.so.0";
+
+        [LibraryImport(X11Lib)]
+        public static partial IntPtr XOpenDisplay(IntPtr name);
+
+        [LibraryImport(X11Lib)]
+        public static partial ulong XDefaultRootWindow(IntPtr display);
+
+        [LibraryImport(X11Lib)]
+        public static partial ulong XCreateSimpleWindow(IntPtr display, ulong parent, int x, int y,
+            uint width, uint height, uint borderWidth, ulong border, ulong background);
+
+        [LibraryImport(X11Lib)]
+        public static partial int XMapWindow(IntPtr display, ulong window);
+
+        [LibraryImport(X11Lib)]
+        public static partial int XFlush(IntPtr display);
+
+        [LibraryImport(X11Lib)]
+        public static partial int XDestroyWindow(IntPtr display, ulong window);
+
+        [LibraryImport(X11Lib)]
+        public static partial int XCloseDisplay(IntPtr display);
+
+        [LibraryImport(GLibLib)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static partial bool g_main_context_acquire(IntPtr context);
+
+        [LibraryImport(GLibLib)]
+        public static partial void g_main_context_release(IntPtr context);
+
+        [LibraryImport(GLibLib)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static partial bool g_main_context_iteration(IntPtr context, [MarshalAs(UnmanagedType.I1)] bool mayBlock);
+    }
+}
@@ -38,6 +38,16 @@ internal static class WebKitSmokeHarness
             return 64;
         }
 
+        if (caseId == GtkLifecycleSoak.CaseId)
+        {
+            return RunGtkLifecycleSoak(caseId, args);
+        }
+
+        if (caseId == GtkActivityStateMeasure.CaseId)
+        {
+            return RunGtkActivityStateMeasure(caseId, args);
+        }
+
         if (!OperatingSystem.IsMacOS())
         {
             WriteResult(caseId, ok: true, "non-macOS host skipped");
@@ -88,6 +98,53 @@ internal static class WebKitSmokeHarness
         }
     }
 
+    private static int RunGtkLifecycleSoak(string caseId, string[] args)
+    {
+        if (!OperatingSystem.IsLinux() || string.IsNullOrEmpty(Environment.GetEnvironmentVariable("DISPLAY")))
+        {
+            WriteResult(caseId, ok: true, "no Linux X11 display; skipped");
+            return 0;
+        }
+
+        if (!GtkLifecycleSoak.HasInstanceCounting())
+        {
+            return GtkLifecycleSoak.RelaunchWithInstanceCounting();
+        }
+
+        try
+        {
+            WriteResult(caseId, ok: true, GtkLifecycleSoak.Run(args));
+            return 0;
+        }
+        catch (Exception ex)
+        {
+            Console.Error.WriteLine(ex);
+            WriteResult(caseId, ok: false, ex.Message);
+            return 1;
+        }
+    }
+
+    private static int RunGtkActivityStateMeasure(string caseId, string[] args)
+    {
+        if (!OperatingSystem.IsLinux() || string.IsNullOrEmpty(Environment.GetEnvironmentVariable("DISPLAY")))
+        {
+            WriteResult(caseId, ok: true, "no Linux X11 display; skipped");
+            return 0;
+        }
+
+        try
+        {
+            WriteResult(caseId, ok: true, GtkActivityStateMeasure.Run(args));
+            return 0;
+        }
+        catch (Exception ex)
+        {
+            Console.Error.WriteLine(ex);
+            WriteResult(caseId, ok: false, ex.Message);
+            return 1;
+        }
+    }
+
     private static void RunWebViewInit()
     {
         using var config = WKWebViewConfiguration.Create();
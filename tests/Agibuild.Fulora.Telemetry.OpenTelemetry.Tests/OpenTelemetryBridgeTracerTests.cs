@@ -84,6 +84,38 @@ public class OpenTelemetryBridgeTracerTests
         Assert.Equal(ActivityStatusCode.Error, capturedActivity.Status);
     }
 
+    [Fact]
+    public void OnCallTiming_emits_a_round_trip_span_with_one_child_per_phase()
+    {
+        var tracer = new OpenTelemetryBridgeTracer();
+        var stopped = new List<Activity>();
+        using var listener = new ActivityListener
+        {
+            ActivityStopped = a => stopped.Add(a),
+            ShouldListenTo = s => s.Name == OpenTelemetryBridgeTracer.ActivitySourceName,
+            Sample = (ref ActivityCreationOptions<ActivityContext> _) => ActivitySamplingResult.AllData
+        };
+        ActivitySource.AddActivityListener(listener);
+
+        var t = new DateTimeOffset(2026, 1, 1, 0, 0, 0, TimeSpan.Zero);
+        tracer.OnCallTiming(new BridgeCallTiming("__js_7", "Timed", "Call", "message",
+            PageInvoked: t, PageSent: t.AddMilliseconds(1), HostReceived: t.AddMilliseconds(3),
+            HostDispatched: t.AddMilliseconds(4), HostResponded: t.AddMilliseconds(9), PageReceived: t.AddMilliseconds(12),
+            IsError: false));
+
+        var root = Assert.Single(stopped, a => a.OperationName == "Timed.Call round trip");
+        Assert.Equal(t.UtcDateTime, root.StartTimeUtc);
+        Assert.Equal(TimeSpan.FromMilliseconds(12), root.Duration);
+        Assert.Equal("__js_7", root.GetTagItem(OpenTelemetryBridgeTracer.CallIdKey));
+        Assert.Equal(0.0, root.GetTagItem(OpenTelemetryBridgeTracer.ClockOffsetKey));
+
+        var children = stopped.Where(a => a.ParentSpanId == root.SpanId).ToList();
+        Assert.Equal(
+            new[] { BridgeCallPhases.PageSerialize, BridgeCallPhases.RequestTransit, BridgeCallPhases.HostQueue, BridgeCallPhases.HostHandler, BridgeCallPhases.ResponseTransit },
+            children.Select(a => a.OperationName));
+        Assert.Equal(TimeSpan.FromMilliseconds(5), children.Single(a => a.OperationName == BridgeCallPhases.HostHandler).Duration);
+    }
+
     [Fact]
     public void OnServiceExposed_and_OnServiceRemoved_do_not_throw()
     {
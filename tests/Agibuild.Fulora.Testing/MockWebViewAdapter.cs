@@ -404,6 +404,51 @@ internal class MockWebViewAdapter : IWebViewAdapter
     /// <summary>Creates a mock that supports drag-and-drop events.</summary>
     public static MockWebViewAdapterWithDragDrop CreateWithDragDrop() => new();
 
+    /// <summary>Creates a mock that serves the fetch bridge transport.</summary>
+    public static MockWebViewAdapterWithFetchBridge CreateWithFetchBridge() => new();
+
+    /// <summary>Creates a mock that records host visibility changes.</summary>
+    public static MockWebViewAdapterWithHostVisibility CreateWithHostVisibility() => new();
+
+    /// <summary>Creates a mock with a direct RPC delivery channel.</summary>
+    public static MockWebViewAdapterWithRpcDelivery CreateWithRpcDelivery() => new();
+
+    /// <summary>Creates a mock that records published blobs.</summary>
+    public static MockWebViewAdapterWithBlobPublishing CreateWithBlobPublishing() => new();
+
+    /// <summary>Creates a mock that records loaded content filters.</summary>
+    public static MockWebViewAdapterWithContentFilters CreateWithContentFilters() => new();
+
+    /// <summary>Creates a mock that records shared content sets.</summary>
+    public static MockWebViewAdapterWithSharedContentSets CreateWithSharedContentSets() => new();
+
+    /// <summary>Creates a mock that reports and removes website data.</summary>
+    public static MockWebViewAdapterWithWebsiteData CreateWithWebsiteData() => new();
+
+    /// <summary>Creates a mock that records DNS prefetches and preloads.</summary>
+    public static MockWebViewAdapterWithSpeculativeLoading CreateWithSpeculativeLoading() => new();
+
+    /// <summary>Creates a mock that records resource timing requests.</summary>
+    public static MockWebViewAdapterWithResourceTiming CreateWithResourceTiming() => new();
+
+    /// <summary>Creates a mock that records script evaluation limits.</summary>
+    public static MockWebViewAdapterWithScriptEvaluationLimits CreateWithScriptEvaluationLimits() => new();
+
+    /// <summary>Creates a mock that streams script results.</summary>
+    public static MockWebViewAdapterWithScriptStreaming CreateWithScriptStreaming() => new();
+
+    /// <summary>Creates a mock that renders offscreen.</summary>
+    public static MockWebViewAdapterWithOffscreenRendering CreateWithOffscreenRendering() => new();
+
+    /// <summary>Creates a mock that manages downloads.</summary>
+    public static MockWebViewAdapterWithDownloadManagement CreateWithDownloadManagement() => new();
+
+    /// <summary>Creates a mock that reports its activity state.</summary>
+    public static MockWebViewAdapterWithActivityState CreateWithActivityState() => new();
+
+    /// <summary>Creates a mock that captures whole documents.</summary>
+    public static MockWebViewAdapterWithFullPageCapture CreateWithFullPageCapture() => new();
+
     // -----------------------------------------------------------------------
     // Default no-op implementations for every MANDATORY capability facet that
     // IWebViewAdapter now inherits. Implemented explicitly so that derived
@@ -790,3 +835,318 @@ internal sealed class MockWebViewAdapterWithDragDrop : MockWebViewAdapter, IDrag
     /// <summary>Simulates a drop completed event.</summary>
     public void RaiseDropCompleted(DropEventArgs args) => DropCompleted?.Invoke(this, args);
 }
+
+/// <summary>Mock adapter that also implements <see cref="IFetchBridgeAdapter"/> for fetch transport testing.</summary>
+internal sealed class MockWebViewAdapterWithFetchBridge : MockWebViewAdapter, IFetchBridgeAdapter
+{
+    /// <summary>When false, <see cref="SetFetchBridgeHandler"/> reports the transport as unavailable.</summary>
+    public bool FetchBridgeSupported { get; set; } = true;
+
+    /// <summary>The handler installed by the runtime, or null.</summary>
+    public FetchBridgeRequestHandler? FetchBridgeHandler { get; private set; }
+
+    public bool SetFetchBridgeHandler(FetchBridgeRequestHandler? handler)
+    {
+        if (handler is not null && !FetchBridgeSupported)
+        {
+            return false;
+        }
+
+        FetchBridgeHandler = handler;
+        return true;
+    }
+
+    /// <summary>Simulates the page fetching <c>app://__rpc/…</c> with <paramref name="body"/>.</summary>
+    public Task<string?> FetchAsync(string body, string origin = "app://localhost")
+    {
+        var handler = FetchBridgeHandler ?? throw new InvalidOperationException("The fetch bridge is not enabled.");
+        return handler(body, origin, CancellationToken.None);
+    }
+}
+
+/// <summary>Mock adapter that also implements <see cref="IHostVisibilityAdapter"/> for visibility testing.</summary>
+internal sealed class MockWebViewAdapterWithHostVisibility : MockWebViewAdapter, IHostVisibilityAdapter
+{
+    /// <summary>Every visibility reported by the runtime, in order.</summary>
+    public List<bool> HostVisibilityChanges { get; } = [];
+
+    public void SetHostVisible(bool visible) => HostVisibilityChanges.Add(visible);
+}
+
+/// <summary>Mock adapter that also implements <see cref="IRpcDeliveryAdapter"/> for direct delivery testing.</summary>
+internal sealed class MockWebViewAdapterWithRpcDelivery : MockWebViewAdapter, IRpcDeliveryAdapter
+{
+    /// <summary>When false, deliveries are refused and the runtime falls back to script.</summary>
+    public bool RpcDeliveryConnected { get; set; } = true;
+
+    /// <summary>Every envelope delivered directly, in order.</summary>
+    public List<(RpcDeliveryKind Kind, string Json)> RpcDeliveries { get; } = [];
+
+    public bool TryDeliverRpc(RpcDeliveryKind kind, string json)
+    {
+        if (!RpcDeliveryConnected)
+        {
+            return false;
+        }
+
+        RpcDeliveries.Add((kind, json));
+        return true;
+    }
+}
+
+/// <summary>Mock adapter that also implements <see cref="IBlobPublishingAdapter"/> for blob publishing testing.</summary>
+internal sealed class MockWebViewAdapterWithBlobPublishing : MockWebViewAdapter, IBlobPublishingAdapter
+{
+    /// <summary>Currently published blobs by id.</summary>
+    public Dictionary<string, (ReadOnlyMemory<byte> Data, string? MimeType, IDisposable? Owner)> Blobs { get; } = new(StringComparer.Ordinal);
+
+    public string PublishBlob(string id, ReadOnlyMemory<byte> data, string? mimeType, IDisposable? owner)
+    {
+        if (!Blobs.TryAdd(id, (data, mimeType, owner)))
+        {
+            throw new ArgumentException($"A blob with id '{id}' is already published; revoke it first.", nameof(id));
+        }
+
+        return "/__blob/" + id;
+    }
+
+    public bool RevokeBlob(string id)
+    {
+        if (!Blobs.Remove(id, out var blob))
+        {
+            return false;
+        }
+
+        blob.Owner?.Dispose();
+        return true;
+    }
+}
+
+/// <summary>Mock adapter that also implements <see cref="IContentFilterAdapter"/> for content filter testing.</summary>
+internal sealed class MockWebViewAdapterWithContentFilters : MockWebViewAdapter, IContentFilterAdapter
+{
+    /// <summary>Currently loaded rule lists by identifier.</summary>
+    public Dictionary<string, string> Filters { get; } = new(StringComparer.Ordinal);
+
+    public Task<ContentFilterResult> LoadOrCompileContentFilterAsync(string identifier, string rulesJson)
+    {
+        var fromCache = Filters.TryGetValue(identifier, out var previous) && previous == rulesJson;
+        Filters[identifier] = rulesJson;
+        return Task.FromResult(new ContentFilterResult(identifier, 0, fromCache, TimeSpan.Zero));
+    }
+
+    public void RemoveContentFilter(string identifier) => Filters.Remove(identifier);
+}
+
+/// <summary>Mock adapter that also implements <see cref="ISharedContentSetAdapter"/> for shared content set testing.</summary>
+internal sealed class MockWebViewAdapterWithSharedContentSets : MockWebViewAdapter, ISharedContentSetAdapter
+{
+    /// <summary>Defined sets by name.</summary>
+    public Dictionary<string, (IReadOnlyList<string> Scripts, SharedContentSetOptions Options)> Defined { get; } = new(StringComparer.Ordinal);
+
+    /// <summary>Names of the sets attached to this view.</summary>
+    public HashSet<string> Attached { get; } = new(StringComparer.Ordinal);
+
+    public void DefineSharedContentSet(string name, IReadOnlyList<string> scripts, IReadOnlyList<string>? styleSheets,
+        SharedContentSetOptions options)
+        => Defined[name] = (scripts, options);
+
+    public void DestroySharedContentSet(string name)
+    {
+        Defined.Remove(name);
+        Attached.Remove(name);
+    }
+
+    public void AttachSharedContentSet(string name)
+    {
+        if (!Defined.ContainsKey(name))
+        {
+            throw new InvalidOperationException($"Content set '{name}' is not defined.");
+        }
+
+        Attached.Add(name);
+    }
+
+    public void DetachSharedContentSet(string name) => Attached.Remove(name);
+}
+
+/// <summary>Mock adapter that also implements <see cref="IWebsiteDataAdapter"/> for website data testing.</summary>
+internal sealed class MockWebViewAdapterWithWebsiteData : MockWebViewAdapter, IWebsiteDataAdapter
+{
+    /// <summary>Usage reported by <see cref="FetchWebsiteDataUsageAsync"/>.</summary>
+    public List<WebsiteDataUsage> Usage { get; } = [];
+
+    public Task<IReadOnlyList<WebsiteDataUsage>> FetchWebsiteDataUsageAsync(WebsiteDataTypes types)
+        => Task.FromResult<IReadOnlyList<WebsiteDataUsage>>(Usage.Where(u => (u.Types & types) != 0).ToArray());
+
+    public Task RemoveWebsiteDataAsync(WebsiteDataTypes types, IReadOnlyCollection<string>? origins)
+    {
+        Usage.RemoveAll(u => (u.Types & types) != 0 && (origins is null || origins.Contains(u.Origin)));
+        return Task.CompletedTask;
+    }
+}
+
+/// <summary>Mock adapter that also implements <see cref="ISpeculativeLoadingAdapter"/> for preload testing.</summary>
+internal sealed class MockWebViewAdapterWithSpeculativeLoading : MockWebViewAdapter, ISpeculativeLoadingAdapter
+{
+    /// <summary>Host names passed to <see cref="PrefetchDns"/>.</summary>
+    public List<string> PrefetchedHosts { get; } = [];
+
+    /// <summary>The current preload queue.</summary>
+    public IReadOnlyList<Uri> PreloadQueue { get; private set; } = [];
+
+    /// <summary>Stats returned by <see cref="GetPreloadStats"/>.</summary>
+    public PreloadStats Stats { get; set; }
+
+    public void PrefetchDns(string hostname) => PrefetchedHosts.Add(hostname);
+
+    public void PreloadUris(IReadOnlyList<Uri> uris) => PreloadQueue = uris;
+
+    public PreloadStats GetPreloadStats() => Stats;
+}
+
+/// <summary>Mock adapter that also implements <see cref="IResourceTimingAdapter"/> for HAR export testing.</summary>
+internal sealed class MockWebViewAdapterWithResourceTiming : MockWebViewAdapter, IResourceTimingAdapter
+{
+    /// <summary>Whether recording is on.</summary>
+    public bool ResourceTimingEnabled { get; private set; }
+
+    /// <summary>The capacity last passed to <see cref="SetResourceTimingEnabled"/>.</summary>
+    public int ResourceTimingCapacity { get; private set; }
+
+    /// <summary>Whether <see cref="ClearResourceTimings"/> was called.</summary>
+    public bool ResourceTimingsCleared { get; private set; }
+
+    /// <summary>HAR returned by <see cref="ExportResourceTimingsAsHar"/>.</summary>
+    public string Har { get; set; } = "{\"log\":{\"version\":\"1.2\",\"entries\":[]}}";
+
+    public void SetResourceTimingEnabled(bool enabled, int capacity)
+    {
+        ResourceTimingEnabled = enabled;
+        ResourceTimingCapacity = capacity;
+    }
+
+    public void ClearResourceTimings() => ResourceTimingsCleared = true;
+
+    public string ExportResourceTimingsAsHar() => Har;
+}
+
+/// <summary>Mock adapter that also implements <see cref="IScriptEvaluationLimitsAdapter"/> for limit testing.</summary>
+internal sealed class MockWebViewAdapterWithScriptEvaluationLimits : MockWebViewAdapter, IScriptEvaluationLimitsAdapter
+{
+    /// <summary>The limits last passed to <see cref="ConfigureScriptEvaluation"/>.</summary>
+    public (int MaxInFlight, int MaxQueued, TimeSpan? Timeout)? Limits { get; private set; }
+
+    public void ConfigureScriptEvaluation(int maxInFlight, int maxQueued, TimeSpan? timeout)
+        => Limits = (maxInFlight, maxQueued, timeout);
+}
+
+/// <summary>Mock adapter that also implements <see cref="IScriptStreamingAdapter"/> for streamed result testing.</summary>
+internal sealed class MockWebViewAdapterWithScriptStreaming : MockWebViewAdapter, IScriptStreamingAdapter
+{
+    /// <summary>Bytes returned as the stream by <see cref="InvokeScriptStreamAsync"/>; null returns no stream.</summary>
+    public byte[]? StreamResult { get; set; }
+
+    /// <summary>Scripts passed to <see cref="InvokeScriptStreamAsync"/>.</summary>
+    public List<string> StreamedScripts { get; } = [];
+
+    /// <summary>The threshold last passed to <see cref="SetScriptResultBufferThreshold"/>.</summary>
+    public long? BufferThreshold { get; private set; }
+
+    public Task<Stream?> InvokeScriptStreamAsync(string script, CancellationToken cancellationToken)
+    {
+        StreamedScripts.Add(script);
+        return Task.FromResult<Stream?>(StreamResult is null ? null : new MemoryStream(StreamResult, writable: false));
+    }
+
+    public void SetScriptResultBufferThreshold(long thresholdBytes) => BufferThreshold = thresholdBytes;
+}
+
+/// <summary>Mock adapter that also implements <see cref="IOffscreenRenderingAdapter"/> for offscreen presenter testing.</summary>
+internal sealed class MockWebViewAdapterWithOffscreenRendering : MockWebViewAdapter, IOffscreenRenderingAdapter
+{
+    public bool IsOffscreenRendering { get; set; } = true;
+
+    public event EventHandler<ulong>? OffscreenFrameReady;
+
+    /// <summary>The size last passed to <see cref="ResizeOffscreen"/>.</summary>
+    public (int Width, int Height)? Size { get; private set; }
+
+    /// <summary>Input passed to <see cref="SendOffscreenInput"/>.</summary>
+    public List<OffscreenInput> Inputs { get; } = [];
+
+    /// <summary>Frames still to hand out from <see cref="TryCopyOffscreenFrame"/>.</summary>
+    public Queue<OffscreenFrameCopy> Frames { get; } = new();
+
+    public void RaiseOffscreenFrameReady(ulong sequence) => OffscreenFrameReady?.Invoke(this, sequence);
+
+    public void ResizeOffscreen(int width, int height) => Size = (width, height);
+
+    public bool TryCopyOffscreenFrame(IntPtr destination, int destinationStride, int destinationWidth, int destinationHeight,
+        out OffscreenFrameCopy copy) => Frames.TryDequeue(out copy);
+
+    public bool SendOffscreenInput(in OffscreenInput input)
+    {
+        Inputs.Add(input);
+        return true;
+    }
+}
+
+/// <summary>Mock adapter that also implements <see cref="IDownloadManagementAdapter"/> for download management testing.</summary>
+internal sealed class MockWebViewAdapterWithDownloadManagement : MockWebViewAdapter, IDownloadManagementAdapter
+{
+    public Func<WebViewDownload, CancellationToken, ValueTask<string?>>? DownloadDestinationResolver { get; set; }
+
+    public event EventHandler<WebViewDownloadProgress>? DownloadProgressChanged;
+
+    public event EventHandler<WebViewDownloadResult>? DownloadCompleted;
+
+    /// <summary>The interval last passed to <see cref="SetDownloadProgressInterval"/>.</summary>
+    public TimeSpan? ProgressInterval { get; private set; }
+
+    /// <summary>Ids of downloads that are still running; <see cref="CancelDownload"/> removes them.</summary>
+    public HashSet<ulong> RunningDownloads { get; } = [];
+
+    public void SetDownloadProgressInterval(TimeSpan interval) => ProgressInterval = interval;
+
+    public bool CancelDownload(ulong downloadId) => RunningDownloads.Remove(downloadId);
+
+    public void RaiseDownloadProgressChanged(WebViewDownloadProgress progress) => DownloadProgressChanged?.Invoke(this, progress);
+
+    public void RaiseDownloadCompleted(WebViewDownloadResult result) => DownloadCompleted?.Invoke(this, result);
+}
+
+/// <summary>Mock adapter that also implements <see cref="IActivityStateAdapter"/> for activity state testing.</summary>
+internal sealed class MockWebViewAdapterWithActivityState : MockWebViewAdapter, IActivityStateAdapter
+{
+    public WebViewActivityState ActivityState { get; private set; }
+
+    public event EventHandler<WebViewActivityState>? ActivityStateChanged;
+
+    public TimeSpan? SuspendAfterHidden { get; set; } = TimeSpan.FromSeconds(30);
+
+    public void RaiseActivityStateChanged(WebViewActivityState state)
+    {
+        ActivityState = state;
+        ActivityStateChanged?.Invoke(this, state);
+    }
+}
+
+/// <summary>Mock adapter that also implements <see cref="IFullPageCaptureAdapter"/> for full-page capture testing.</summary>
+internal sealed class MockWebViewAdapterWithFullPageCapture : MockWebViewAdapter, IFullPageCaptureAdapter
+{
+    /// <summary>Bytes written to the destination by <see cref="CaptureFullPageAsync"/>.</summary>
+    public byte[] FullPagePng { get; set; } = [0x89, (byte)'P', (byte)'N', (byte)'G'];
+
+    /// <summary>Result returned by <see cref="CaptureFullPageAsync"/>.</summary>
+    public FullPageCaptureResult FullPageResult { get; set; } = new(800, 4000, 7);
+
+    public async Task<FullPageCaptureResult> CaptureFullPageAsync(Stream destination, IProgress<double>? progress,
+        CancellationToken cancellationToken)
+    {
+        cancellationToken.ThrowIfCancellationRequested();
+        await destination.WriteAsync(FullPagePng, cancellationToken);
+        progress?.Report(1.0);
+        return FullPageResult;
+    }
+}
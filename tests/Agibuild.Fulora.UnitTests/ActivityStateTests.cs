@@ -0,0 +1,67 @@
+using Agibuild.Fulora.Adapters.Abstractions;
+using Agibuild.Fulora.Testing;
+using Xunit;
+
+namespace Agibuild.Fulora.UnitTests;
+
+public sealed class ActivityStateTests
+{
+    private readonly TestDispatcher _dispatcher = new();
+
+    [Fact]
+    public void State_changes_are_raised_by_the_core()
+    {
+        var adapter = MockWebViewAdapter.CreateWithActivityState();
+        using var core = new WebViewCore(adapter, _dispatcher);
+        var states = new List<WebViewActivityState>();
+        core.ActivityStateChanged += (sender, state) =>
+        {
+            Assert.Same(core, sender);
+            states.Add(state);
+        };
+
+        adapter.RaiseActivityStateChanged(WebViewActivityState.Throttled);
+        adapter.RaiseActivityStateChanged(WebViewActivityState.Suspended);
+
+        Assert.Equal(new[] { WebViewActivityState.Throttled, WebViewActivityState.Suspended }, states);
+        Assert.Equal(WebViewActivityState.Suspended, core.ActivityState);
+    }
+
+    [Fact]
+    public void Suspend_delay_reaches_the_adapter()
+    {
+        var adapter = MockWebViewAdapter.CreateWithActivityState();
+        using var core = new WebViewCore(adapter, _dispatcher);
+
+        Assert.True(core.TrySetSuspendAfterHidden(TimeSpan.FromMinutes(2)));
+        Assert.Equal<TimeSpan?>(TimeSpan.FromMinutes(2), adapter.SuspendAfterHidden);
+
+        Assert.True(core.TrySetSuspendAfterHidden(null));
+        Assert.Null(adapter.SuspendAfterHidden);
+
+        Assert.Throws<ArgumentOutOfRangeException>(() => core.TrySetSuspendAfterHidden(TimeSpan.FromSeconds(-1)));
+    }
+
+    [Fact]
+    public void Events_stop_after_dispose()
+    {
+        var adapter = MockWebViewAdapter.CreateWithActivityState();
+        var core = new WebViewCore(adapter, _dispatcher);
+        var raised = 0;
+        core.ActivityStateChanged += (_, _) => raised++;
+
+        core.Dispose();
+        adapter.RaiseActivityStateChanged(WebViewActivityState.Throttled);
+
+        Assert.Equal(0, raised);
+    }
+
+    [Fact]
+    public void Adapters_without_activity_state_stay_active()
+    {
+        using var core = new WebViewCore(MockWebViewAdapter.Create(), _dispatcher);
+
+        Assert.Equal(WebViewActivityState.Active, core.ActivityState);
+        Assert.False(core.TrySetSuspendAfterHidden(TimeSpan.FromSeconds(1)));
+    }
+}
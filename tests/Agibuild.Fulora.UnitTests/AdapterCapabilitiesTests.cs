@@ -6,8 +6,8 @@ namespace Agibuild.Fulora.UnitTests;
 /// <summary>
 /// Exercises the one-shot capability negotiation performed by
 /// <see cref="AdapterCapabilities.From"/>. After the P0 contract consolidation
-/// only two facets remain truly optional (<c>DragDrop</c> and
-/// <c>AsyncPreloadScript</c>); every other capability is part of the mandatory
+/// only a few facets remain truly optional (<c>DragDrop</c>,
+/// <c>AsyncPreloadScript</c>, <c>FetchBridge</c>, <c>HostVisibility</c>, <c>RpcDelivery</c>, <c>BlobPublishing</c>, <c>ContentFilters</c>, <c>SharedContentSets</c>, <c>WebsiteData</c>, <c>SpeculativeLoading</c>, <c>ResourceTiming</c>, <c>ScriptEvaluationLimits</c>, <c>ScriptStreaming</c>, <c>OffscreenRendering</c>, <c>DownloadManagement</c>, <c>ActivityState</c> and <c>FullPageCapture</c>); every other capability is part of the mandatory
 /// <see cref="Adapters.Abstractions.IWebViewAdapter"/> surface and is therefore
 /// not probed here.
 /// </summary>
@@ -28,6 +28,171 @@ public sealed class AdapterCapabilitiesTests
 
         Assert.Null(capabilities.DragDrop);
         Assert.Null(capabilities.AsyncPreloadScript);
+        Assert.Null(capabilities.FetchBridge);
+        Assert.Null(capabilities.HostVisibility);
+        Assert.Null(capabilities.RpcDelivery);
+        Assert.Null(capabilities.BlobPublishing);
+        Assert.Null(capabilities.ContentFilters);
+        Assert.Null(capabilities.SharedContentSets);
+        Assert.Null(capabilities.WebsiteData);
+        Assert.Null(capabilities.SpeculativeLoading);
+        Assert.Null(capabilities.ResourceTiming);
+        Assert.Null(capabilities.ScriptEvaluationLimits);
+        Assert.Null(capabilities.ScriptStreaming);
+        Assert.Null(capabilities.OffscreenRendering);
+        Assert.Null(capabilities.DownloadManagement);
+        Assert.Null(capabilities.ActivityState);
+        Assert.Null(capabilities.FullPageCapture);
+    }
+
+    [Fact]
+    public void From_detects_fetch_bridge_capability()
+    {
+        var adapter = MockWebViewAdapter.CreateWithFetchBridge();
+
+        var capabilities = AdapterCapabilities.From(adapter);
+
+        Assert.Same(adapter, capabilities.FetchBridge);
+    }
+
+    [Fact]
+    public void From_detects_host_visibility_capability()
+    {
+        var adapter = MockWebViewAdapter.CreateWithHostVisibility();
+
+        var capabilities = AdapterCapabilities.From(adapter);
+
+        Assert.Same(adapter, capabilities.HostVisibility);
+    }
+
+    [Fact]
+    public void From_detects_rpc_delivery_capability()
+    {
+        var adapter = MockWebViewAdapter.CreateWithRpcDelivery();
+
+        var capabilities = AdapterCapabilities.From(adapter);
+
+        Assert.Same(adapter, capabilities.RpcDelivery);
+    }
+
+    [Fact]
+    public void From_detects_blob_publishing_capability()
+    {
+        var adapter = MockWebViewAdapter.CreateWithBlobPublishing();
+
+        var capabilities = AdapterCapabilities.From(adapter);
+
+        Assert.Same(adapter, capabilities.BlobPublishing);
+    }
+
+    [Fact]
+    public void From_detects_content_filter_capability()
+    {
+        var adapter = MockWebViewAdapter.CreateWithContentFilters();
+
+        var capabilities = AdapterCapabilities.From(adapter);
+
+        Assert.Same(adapter, capabilities.ContentFilters);
+    }
+
+    [Fact]
+    public void From_detects_shared_content_set_capability()
+    {
+        var adapter = MockWebViewAdapter.CreateWithSharedContentSets();
+
+        var capabilities = AdapterCapabilities.From(adapter);
+
+        Assert.Same(adapter, capabilities.SharedContentSets);
+    }
+
+    [Fact]
+    public void From_detects_website_data_capability()
+    {
+        var adapter = MockWebViewAdapter.CreateWithWebsiteData();
+
+        var capabilities = AdapterCapabilities.From(adapter);
+
+        Assert.Same(adapter, capabilities.WebsiteData);
+    }
+
+    [Fact]
+    public void From_detects_speculative_loading_capability()
+    {
+        var adapter = MockWebViewAdapter.CreateWithSpeculativeLoading();
+
+        var capabilities = AdapterCapabilities.From(adapter);
+
+        Assert.Same(adapter, capabilities.SpeculativeLoading);
+    }
+
+    [Fact]
+    public void From_detects_resource_timing_capability()
+    {
+        var adapter = MockWebViewAdapter.CreateWithResourceTiming();
+
+        var capabilities = AdapterCapabilities.From(adapter);
+
+        Assert.Same(adapter, capabilities.ResourceTiming);
+    }
+
+    [Fact]
+    public void From_detects_script_evaluation_limits_capability()
+    {
+        var adapter = MockWebViewAdapter.CreateWithScriptEvaluationLimits();
+
+        var capabilities = AdapterCapabilities.From(adapter);
+
+        Assert.Same(adapter, capabilities.ScriptEvaluationLimits);
+    }
+
+    [Fact]
+    public void From_detects_script_streaming_capability()
+    {
+        var adapter = MockWebViewAdapter.CreateWithScriptStreaming();
+
+        var capabilities = AdapterCapabilities.From(adapter);
+
+        Assert.Same(adapter, capabilities.ScriptStreaming);
+    }
+
+    [Fact]
+    public void From_detects_offscreen_rendering_capability()
+    {
+        var adapter = MockWebViewAdapter.CreateWithOffscreenRendering();
+
+        var capabilities = AdapterCapabilities.From(adapter);
+
+        Assert.Same(adapter, capabilities.OffscreenRendering);
+    }
+
+    [Fact]
+    public void From_detects_download_management_capability()
+    {
+        var adapter = MockWebViewAdapter.CreateWithDownloadManagement();
+
+        var capabilities = AdapterCapabilities.From(adapter);
+
+        Assert.Same(adapter, capabilities.DownloadManagement);
+    }
+
+    [Fact]
+    public void From_detects_activity_state_capability()
+    {
+        var adapter = MockWebViewAdapter.CreateWithActivityState();
+
+        var capabilities = AdapterCapabilities.From(adapter);
+
+        Assert.Same(adapter, capabilities.ActivityState);
+    }
+
+    [Fact]
+    public void From_detects_full_page_capture_capability()
+    {
+        var adapter = MockWebViewAdapter.CreateWithFullPageCapture();
+
+        var capabilities = AdapterCapabilities.From(adapter);
+
+        Assert.Same(adapter, capabilities.FullPageCapture);
     }
 
     [Fact]
@@ -0,0 +1,59 @@
+using Agibuild.Fulora.Testing;
+using Xunit;
+
+namespace Agibuild.Fulora.UnitTests;
+
+public sealed class BlobPublishingTests
+{
+    private readonly TestDispatcher _dispatcher = new();
+
+    [Fact]
+    public void TryPublishBlob_hands_the_buffer_to_the_adapter_and_returns_its_path()
+    {
+        var adapter = MockWebViewAdapter.CreateWithBlobPublishing();
+        using var core = new WebViewCore(adapter, _dispatcher);
+        var data = new byte[] { 1, 2, 3 };
+        var owner = new CountingOwner();
+
+        var path = core.TryPublishBlob("frame-1", data, "image/png", owner);
+
+        Assert.Equal("/__blob/frame-1", path);
+        var blob = adapter.Blobs["frame-1"];
+        Assert.True(blob.Data.Span.SequenceEqual(data));
+        Assert.Equal("image/png", blob.MimeType);
+
+        Assert.True(core.RevokeBlob("frame-1"));
+        Assert.False(core.RevokeBlob("frame-1"));
+        Assert.Equal(1, owner.Disposals);
+    }
+
+    [Fact]
+    public void A_published_id_stays_taken_until_revoked()
+    {
+        var adapter = MockWebViewAdapter.CreateWithBlobPublishing();
+        using var core = new WebViewCore(adapter, _dispatcher);
+        core.TryPublishBlob("frame-1", new byte[] { 1 });
+
+        Assert.Throws<ArgumentException>(() => core.TryPublishBlob("frame-1", new byte[] { 2 }));
+        Assert.Equal(1, adapter.Blobs["frame-1"].Data.Span[0]);
+
+        Assert.True(core.RevokeBlob("frame-1"));
+        Assert.Equal("/__blob/frame-1", core.TryPublishBlob("frame-1", new byte[] { 2 }));
+    }
+
+    [Fact]
+    public void Without_the_capability_nothing_is_published()
+    {
+        using var core = new WebViewCore(MockWebViewAdapter.Create(), _dispatcher);
+
+        Assert.Null(core.TryPublishBlob("frame-1", new byte[] { 1 }));
+        Assert.False(core.RevokeBlob("frame-1"));
+    }
+
+    private sealed class CountingOwner : IDisposable
+    {
+        public int Disposals { get; private set; }
+
+        public void Dispose() => Disposals++;
+    }
+}
@@ -0,0 +1,264 @@
+using System.Globalization;
+using System.Text.Json;
+using Agibuild.Fulora.Rpc;
+using Agibuild.Fulora.Testing;
+using Microsoft.Extensions.Logging.Abstractions;
+using Xunit;
+
+namespace Agibuild.Fulora.UnitTests;
+
+public sealed class BridgeCallTimingTests
+{
+    [Fact]
+    public void Page_trace_report_is_joined_with_host_timestamps_by_call_id()
+    {
+        var rpc = CreateRpc(out var scripts);
+        var sink = new RecordingTimingSink();
+        rpc.CallTimingSink = sink;
+        rpc.Handle("Calc.add", _ => (object?)3);
+
+        var received = DateTimeOffset.UtcNow.AddMilliseconds(-2);
+        Assert.True(rpc.TryProcessMessage("""{"jsonrpc":"2.0","id":"__js_0","method":"Calc.add","params":{}}""", received));
+        WaitUntil(() => scripts.Any(s => s.Contains("__js_0")));
+
+        var invoked = received.AddMilliseconds(-3);
+        Assert.True(rpc.TryProcessMessage(TraceReport(("__js_0", invoked, invoked.AddMilliseconds(1), DateTimeOffset.UtcNow.AddMilliseconds(1), false))));
+
+        var timing = Assert.Single(sink.Timings);
+        Assert.Equal("__js_0", timing.CallId);
+        Assert.Equal("Calc", timing.ServiceName);
+        Assert.Equal("add", timing.MethodName);
+        Assert.Equal("message", timing.Transport);
+        Assert.Equal(received, timing.HostReceived);
+        Assert.True(timing.HostDispatched >= received);
+        Assert.True(timing.HostResponded >= timing.HostDispatched);
+        Assert.False(timing.IsError);
+        Assert.InRange(timing.Phases[0].Duration.TotalMilliseconds, 0.99, 1.01);
+        Assert.Equal(
+            new[]
+            {
+                BridgeCallPhases.PageSerialize, BridgeCallPhases.RequestTransit, BridgeCallPhases.HostQueue,
+                BridgeCallPhases.HostHandler, BridgeCallPhases.ResponseTransit, BridgeCallPhases.Total,
+            },
+            timing.Phases.Select(p => p.Phase));
+    }
+
+    [Fact]
+    public void Trace_reports_for_unknown_ids_or_without_a_sink_are_consumed_silently()
+    {
+        var rpc = CreateRpc(out _);
+        var report = TraceReport(("__js_9", DateTimeOffset.UtcNow, DateTimeOffset.UtcNow, DateTimeOffset.UtcNow, false));
+
+        Assert.True(rpc.TryProcessMessage(report));
+
+        var sink = new RecordingTimingSink();
+        rpc.CallTimingSink = sink;
+        Assert.True(rpc.TryProcessMessage(report));
+        Assert.Empty(sink.Timings);
+    }
+
+    [Fact]
+    public async Task Fetch_requests_are_timed_with_the_fetch_transport()
+    {
+        var rpc = CreateRpc(out _);
+        var sink = new RecordingTimingSink();
+        rpc.CallTimingSink = sink;
+        rpc.Handle("Calc.fail", _ => throw new InvalidOperationException("nope"));
+
+        var response = await rpc.ProcessFetchRequestAsync("""{"jsonrpc":"2.0","id":"__js_1","method":"Calc.fail"}""", DateTimeOffset.UtcNow);
+        Assert.NotNull(response);
+
+        var now = DateTimeOffset.UtcNow;
+        rpc.TryProcessMessage(TraceReport(("__js_1", now, now, now, true)));
+
+        var timing = Assert.Single(sink.Timings);
+        Assert.Equal("fetch", timing.Transport);
+        Assert.True(timing.IsError);
+    }
+
+    [Fact]
+    public void Phases_move_page_timestamps_onto_the_host_clock_by_the_offset()
+    {
+        // The page clock runs 10 ms behind the host's: 2 ms request transit, 3 ms response transit.
+        var t = DateTimeOffset.UtcNow;
+        var timing = new BridgeCallTiming("1", "S", "m", "message",
+            PageInvoked: t, PageSent: t.AddMilliseconds(1), HostReceived: t.AddMilliseconds(13), HostDispatched: t.AddMilliseconds(14),
+            HostResponded: t.AddMilliseconds(16), PageReceived: t.AddMilliseconds(9), IsError: false,
+            ClockOffset: TimeSpan.FromMilliseconds(10));
+
+        Assert.Equal(TimeSpan.FromMilliseconds(2), timing.Phases[1].Duration);
+        Assert.Equal(t.AddMilliseconds(11), timing.Phases[1].Start);
+        Assert.Equal(TimeSpan.FromMilliseconds(3), timing.Phases[4].Duration);
+        Assert.Equal(t.AddMilliseconds(10), timing.Phases[^1].Start);
+        Assert.Equal(TimeSpan.FromMilliseconds(9), timing.Phases[^1].Duration);
+    }
+
+    [Fact]
+    public void Phases_without_an_offset_show_the_skew_instead_of_hiding_it()
+    {
+        var t = DateTimeOffset.UtcNow;
+        var timing = new BridgeCallTiming("1", "S", "m", "message",
+            PageInvoked: t, PageSent: t.AddMilliseconds(1), HostReceived: t, HostDispatched: t.AddMilliseconds(2),
+            HostResponded: t.AddMilliseconds(5), PageReceived: t.AddMilliseconds(4), IsError: false);
+
+        Assert.Equal(TimeSpan.FromMilliseconds(-1), timing.Phases[1].Duration);
+        Assert.Equal(TimeSpan.FromMilliseconds(-1), timing.Phases[4].Duration);
+        Assert.Equal(TimeSpan.FromMilliseconds(4), timing.Phases[^1].Duration);
+    }
+
+    [Fact]
+    public void Collector_reports_the_ntp_offset_of_the_shortest_round_trip_per_page()
+    {
+        var host = new DateTimeOffset(2026, 1, 1, 0, 0, 0, TimeSpan.Zero);
+        var sink = new RecordingTimingSink();
+        var collector = new RpcCallTimingCollector(sink, () => host.AddMilliseconds(10));
+        var page = host.AddSeconds(-5); // the page clock runs 5 s behind
+
+        void Call(string id, double transitMs)
+        {
+            collector.OnDispatched(id, "S.m", RpcCallTransports.Message, host.AddMilliseconds(transitMs));
+            collector.OnResponded(id);
+        }
+
+        // Request transit 4/1/3 ms, response transit 10/2/6 ms: round trips 14, 3 and 9 ms.
+        Call("a", 4);
+        Call("b", 1);
+        Call("c", 3);
+        collector.OnPageReport(TraceParams(origin: 1, ("a", page, page, page.AddMilliseconds(20), false)));
+        collector.OnPageReport(TraceParams(origin: 1,
+            ("b", page, page, page.AddMilliseconds(12), false),
+            ("c", page, page, page.AddMilliseconds(16), false)));
+
+        Assert.Equal(
+            new[] { 4997.0, 4999.5, 4999.5 },
+            sink.Timings.Select(timing => timing.ClockOffset.TotalMilliseconds));
+        Assert.All(sink.Timings, timing => Assert.All(timing.Phases, phase => Assert.True(phase.Duration >= TimeSpan.Zero)));
+        Assert.Equal(TimeSpan.FromMilliseconds(1.5), sink.Timings[1].Phases[1].Duration);
+        Assert.Equal(TimeSpan.FromMilliseconds(1.5), sink.Timings[1].Phases[4].Duration);
+        Assert.Equal(TimeSpan.FromMilliseconds(3.5), sink.Timings[2].Phases[1].Duration);
+        Assert.Equal(TimeSpan.FromMilliseconds(5.5), sink.Timings[2].Phases[4].Duration);
+
+        // A new document starts a new estimate, even with a longer round trip.
+        Call("d", 2);
+        collector.OnPageReport(TraceParams(origin: 2, ("d", page, page, page.AddMilliseconds(30), false)));
+        Assert.Equal(4991.0, sink.Timings[^1].ClockOffset.TotalMilliseconds);
+    }
+
+    [Fact]
+    public void Profiler_keeps_phase_percentiles_and_forwards_timings()
+    {
+        var inner = new RecordingTimingTracer();
+        var profiler = new BridgeCallProfiler(inner);
+        var t = DateTimeOffset.UtcNow;
+        for (var i = 1; i <= 100; i++)
+        {
+            profiler.OnCallTiming(new BridgeCallTiming($"__js_{i}", "S", "m", "message",
+                t, t, t, t, t.AddMilliseconds(i), t.AddMilliseconds(i), IsError: false));
+        }
+
+        var phases = profiler.GetPhaseStats();
+        var handler = Assert.Single(phases, p => p.Phase == BridgeCallPhases.HostHandler);
+        Assert.Equal(100, handler.CallCount);
+        Assert.Equal(50, handler.P50Ms, 3);
+        Assert.Equal(95, handler.P95Ms, 3);
+        Assert.Equal(100, handler.MaxMs, 3);
+        Assert.Equal(BridgeCallPhases.PageSerialize, phases[0].Phase);
+        Assert.Equal(100, inner.Timings.Count);
+
+        profiler.Reset();
+        Assert.Empty(profiler.GetPhaseStats());
+    }
+
+    [Fact]
+    public void Composite_forwards_timings_only_to_sinks()
+    {
+        var plain = new CompositeBridgeTracer(new LoggingBridgeTracer(NullLogger.Instance));
+        Assert.False(plain.HasCallTimingSinks);
+
+        var sink = new RecordingTimingTracer();
+        var composite = new CompositeBridgeTracer(new LoggingBridgeTracer(NullLogger.Instance), sink);
+        Assert.True(composite.HasCallTimingSinks);
+
+        var t = DateTimeOffset.UtcNow;
+        composite.OnCallTiming(new BridgeCallTiming("1", "S", "m", "message", t, t, t, t, t, t, false));
+        Assert.Single(sink.Timings);
+    }
+
+    [Fact]
+    public void Timing_tracer_switches_page_tracing_on_and_plain_tracers_do_not()
+    {
+        var dispatcher = new TestDispatcher();
+        var adapter = MockWebViewAdapter.Create();
+        var scripts = new List<string>();
+        adapter.ScriptCallback = script => { scripts.Add(script); return null; };
+        using var core = new WebViewCore(adapter, dispatcher);
+
+        core.BridgeTracer = new LoggingBridgeTracer(NullLogger.Instance);
+        core.EnableWebMessageBridge(new WebMessageBridgeOptions());
+        dispatcher.RunAll();
+        Assert.DoesNotContain(scripts, s => s.Contains("_setTracing(true)"));
+
+        core.BridgeTracer = new BridgeCallProfiler();
+        dispatcher.RunAll();
+        Assert.Contains(scripts, s => s.Contains("_setTracing(true)"));
+
+        scripts.Clear();
+        core.DisableWebMessageBridge();
+        core.EnableWebMessageBridge(new WebMessageBridgeOptions());
+        dispatcher.RunAll();
+        Assert.Contains(scripts, s => s.Contains(WebViewRpcService.JsStub) && s.Contains("_setTracing(true)"));
+    }
+
+    private static string TraceReport(params (string Id, DateTimeOffset Invoked, DateTimeOffset Sent, DateTimeOffset Received, bool Failed)[] calls)
+        => $$"""{"jsonrpc":"2.0","method":"$/trace","params":{"calls":[{{TraceCalls(calls)}}]}}""";
+
+    private static JsonElement TraceParams(double origin, params (string Id, DateTimeOffset Invoked, DateTimeOffset Sent, DateTimeOffset Received, bool Failed)[] calls)
+        => JsonDocument.Parse($$"""{"origin":{{origin.ToString("R", CultureInfo.InvariantCulture)}},"calls":[{{TraceCalls(calls)}}]}""").RootElement;
+
+    private static string TraceCalls((string Id, DateTimeOffset Invoked, DateTimeOffset Sent, DateTimeOffset Received, bool Failed)[] calls)
+    {
+        static string Ms(DateTimeOffset t) => (t - DateTimeOffset.UnixEpoch).TotalMilliseconds.ToString("R", CultureInfo.InvariantCulture);
+        return string.Join(",", calls.Select(c => $"[\"{c.Id}\",{Ms(c.Invoked)},{Ms(c.Sent)},{Ms(c.Received)},{(c.Failed ? 1 : 0)}]"));
+    }
+
+    private static WebViewRpcService CreateRpc(out List<string> scripts)
+    {
+        var captured = new List<string>();
+        scripts = captured;
+        return new WebViewRpcService(
+            script =>
+            {
+                lock (captured) captured.Add(script);
+                return Task.FromResult<string?>(null);
+            },
+            NullLogger.Instance);
+    }
+
+    private static void WaitUntil(Func<bool> condition, int timeoutMilliseconds = 3000)
+    {
+        Assert.True(
+            SpinWait.SpinUntil(condition, TimeSpan.FromMilliseconds(timeoutMilliseconds)),
+            "Timed out while waiting for RPC response.");
+    }
+
+    private sealed class RecordingTimingSink : IBridgeCallTimingSink
+    {
+        public List<BridgeCallTiming> Timings { get; } = [];
+
+        public void OnCallTiming(BridgeCallTiming timing) => Timings.Add(timing);
+    }
+
+    private sealed class RecordingTimingTracer : IBridgeTracer, IBridgeCallTimingSink
+    {
+        public List<BridgeCallTiming> Timings { get; } = [];
+
+        public void OnCallTiming(BridgeCallTiming timing) => Timings.Add(timing);
+        public void OnExportCallStart(string serviceName, string methodName, string? paramsJson) { }
+        public void OnExportCallEnd(string serviceName, string methodName, long elapsedMs, string? resultType) { }
+        public void OnExportCallError(string serviceName, string methodName, long elapsedMs, Exception exception) { }
+        public void OnImportCallStart(string serviceName, string methodName, string? paramsJson) { }
+        public void OnImportCallEnd(string serviceName, string methodName, long elapsedMs) { }
+        public void OnServiceExposed(string serviceName, int methodCount, bool isSourceGenerated) { }
+        public void OnServiceRemoved(string serviceName) { }
+    }
+}
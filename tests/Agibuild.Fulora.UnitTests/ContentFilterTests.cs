@@ -0,0 +1,38 @@
+using Agibuild.Fulora.Testing;
+using Xunit;
+
+namespace Agibuild.Fulora.UnitTests;
+
+public sealed class ContentFilterTests
+{
+    private const string Rules = """[{"trigger":{"url-filter":"ads"},"action":{"type":"block"}}]""";
+
+    private readonly TestDispatcher _dispatcher = new();
+
+    [Fact]
+    public async Task TryLoadContentFilterAsync_applies_the_rules_through_the_adapter()
+    {
+        var adapter = MockWebViewAdapter.CreateWithContentFilters();
+        using var core = new WebViewCore(adapter, _dispatcher);
+
+        var first = await core.TryLoadContentFilterAsync("ads", Rules);
+        var second = await core.TryLoadContentFilterAsync("ads", Rules);
+
+        Assert.Equal("ads", first!.Identifier);
+        Assert.False(first.FromCache);
+        Assert.True(second!.FromCache);
+        Assert.Equal(Rules, adapter.Filters["ads"]);
+
+        core.RemoveContentFilter("ads");
+        Assert.Empty(adapter.Filters);
+    }
+
+    [Fact]
+    public async Task Without_the_capability_nothing_is_loaded()
+    {
+        using var core = new WebViewCore(MockWebViewAdapter.Create(), _dispatcher);
+
+        Assert.Null(await core.TryLoadContentFilterAsync("ads", Rules));
+        core.RemoveContentFilter("ads");
+    }
+}
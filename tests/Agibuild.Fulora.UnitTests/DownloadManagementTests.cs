@@ -0,0 +1,94 @@
+using Agibuild.Fulora.Adapters.Abstractions;
+using Agibuild.Fulora.Testing;
+using Xunit;
+
+namespace Agibuild.Fulora.UnitTests;
+
+public sealed class DownloadManagementTests
+{
+    private readonly TestDispatcher _dispatcher = new();
+
+    [Fact]
+    public void Resolver_and_progress_interval_reach_the_adapter()
+    {
+        var adapter = MockWebViewAdapter.CreateWithDownloadManagement();
+        using var core = new WebViewCore(adapter, _dispatcher);
+        Func<WebViewDownload, CancellationToken, ValueTask<string?>> resolver = (_, _) => ValueTask.FromResult<string?>("/tmp/file");
+
+        Assert.True(core.TrySetDownloadDestinationResolver(resolver));
+        Assert.True(core.TrySetDownloadProgressInterval(TimeSpan.FromMilliseconds(500)));
+
+        Assert.Same(resolver, adapter.DownloadDestinationResolver);
+        Assert.Equal<TimeSpan?>(TimeSpan.FromMilliseconds(500), adapter.ProgressInterval);
+
+        Assert.True(core.TrySetDownloadDestinationResolver(null));
+        Assert.Null(adapter.DownloadDestinationResolver);
+    }
+
+    [Fact]
+    public void Cancel_reports_whether_the_download_was_running()
+    {
+        var adapter = MockWebViewAdapter.CreateWithDownloadManagement();
+        adapter.RunningDownloads.Add(7);
+        using var core = new WebViewCore(adapter, _dispatcher);
+
+        Assert.True(core.CancelDownload(7));
+        Assert.False(core.CancelDownload(7));
+    }
+
+    [Fact]
+    public void Progress_and_completion_are_raised_by_the_core()
+    {
+        var adapter = MockWebViewAdapter.CreateWithDownloadManagement();
+        using var core = new WebViewCore(adapter, _dispatcher);
+        var progress = new List<WebViewDownloadProgress>();
+        var results = new List<WebViewDownloadResult>();
+        core.DownloadProgressChanged += (sender, p) =>
+        {
+            Assert.Same(core, sender);
+            progress.Add(p);
+        };
+        core.DownloadCompleted += (_, r) => results.Add(r);
+
+        adapter.RaiseDownloadProgressChanged(new WebViewDownloadProgress(3, 1024, 4096, 2048));
+        var result = new WebViewDownloadResult(3, WebViewDownloadStatus.Completed, "/tmp/file", 4096, null);
+        adapter.RaiseDownloadCompleted(result);
+
+        Assert.Equal(new[] { new WebViewDownloadProgress(3, 1024, 4096, 2048) }, progress);
+        Assert.Same(result, Assert.Single(results));
+    }
+
+    [Fact]
+    public void Events_stop_after_dispose()
+    {
+        var adapter = MockWebViewAdapter.CreateWithDownloadManagement();
+        var core = new WebViewCore(adapter, _dispatcher);
+        var raised = 0;
+        core.DownloadCompleted += (_, _) => raised++;
+
+        core.Dispose();
+        adapter.RaiseDownloadCompleted(new WebViewDownloadResult(1, WebViewDownloadStatus.Cancelled, null, 0, "cancelled"));
+
+        Assert.Equal(0, raised);
+    }
+
+    [Fact]
+    public void Adapters_without_download_management_report_unsupported()
+    {
+        using var core = new WebViewCore(MockWebViewAdapter.Create(), _dispatcher);
+
+        Assert.False(core.TrySetDownloadDestinationResolver((_, _) => ValueTask.FromResult<string?>(null)));
+        Assert.False(core.TrySetDownloadProgressInterval(TimeSpan.FromSeconds(1)));
+        Assert.False(core.CancelDownload(1));
+    }
+
+    [Fact]
+    public void Negative_progress_interval_is_rejected()
+    {
+        var adapter = MockWebViewAdapter.CreateWithDownloadManagement();
+        using var core = new WebViewCore(adapter, _dispatcher);
+
+        Assert.Throws<ArgumentOutOfRangeException>(() => core.TrySetDownloadProgressInterval(TimeSpan.FromMilliseconds(-1)));
+        Assert.Null(adapter.ProgressInterval);
+    }
+}
@@ -169,6 +169,68 @@ public sealed class DragDropContractTests
         Assert.Equal("dropped text", result!.Text);
     }
 
+    [Fact]
+    public async Task DragDropBridgeService_fills_in_file_info_the_platform_deferred()
+    {
+        var dispatcher = new TestDispatcher();
+        var adapter = MockWebViewAdapter.CreateWithDragDrop();
+        using var core = new WebViewCore(adapter, dispatcher);
+        var service = new DragDropBridgeService(core);
+
+        var resolverCalls = 0;
+        ((MockWebViewAdapterWithDragDrop)adapter).RaiseDropCompleted(new DropEventArgs
+        {
+            Payload = new DragDropPayload
+            {
+                Files = [new FileDropInfo("/a.txt"), new FileDropInfo("/b.png")],
+                FileInfoResolver = (file, _) =>
+                {
+                    resolverCalls++;
+                    return Task.FromResult(file with { MimeType = "application/test", Size = file.Path.Length });
+                }
+            },
+            Effect = DragDropEffects.Copy
+        });
+
+        var result = await service.GetLastDropPayloadAsync(TestContext.Current.CancellationToken);
+        var again = await service.GetLastDropPayloadAsync(TestContext.Current.CancellationToken);
+
+        Assert.Equal(2, resolverCalls);
+        Assert.All(result!.Files!, f => Assert.Equal("application/test", f.MimeType));
+        Assert.Equal([6L, 6L], result.Files!.Select(f => f.Size!.Value));
+        Assert.Same(result, again);
+        Assert.Same(result, await result.WithFileInfoAsync(TestContext.Current.CancellationToken));
+    }
+
+    [Fact]
+    public async Task GetFileInfoAsync_looks_up_only_the_requested_file()
+    {
+        var looked = new List<string>();
+        var payload = new DragDropPayload
+        {
+            Files = [new FileDropInfo("/a.txt"), new FileDropInfo("/b.png")],
+            FileInfoResolver = (file, _) =>
+            {
+                looked.Add(file.Path);
+                return Task.FromResult(file with { Size = 1 });
+            }
+        };
+
+        var info = await payload.GetFileInfoAsync(1, TestContext.Current.CancellationToken);
+
+        Assert.Equal(new FileDropInfo("/b.png", null, 1), info);
+        Assert.Equal(new[] { "/b.png" }, looked);
+        await Assert.ThrowsAsync<ArgumentOutOfRangeException>(() => payload.GetFileInfoAsync(2, TestContext.Current.CancellationToken));
+    }
+
+    [Fact]
+    public async Task WithFileInfoAsync_returns_payloads_without_a_resolver_unchanged()
+    {
+        var payload = new DragDropPayload { Files = [new FileDropInfo("/a.txt", "text/plain", 3)] };
+
+        Assert.Same(payload, await payload.WithFileInfoAsync(TestContext.Current.CancellationToken));
+    }
+
     [Fact]
     public async Task DragDropBridgeService_reports_supported()
     {
@@ -0,0 +1,129 @@
+using System.Text.Json;
+using Agibuild.Fulora.Testing;
+using Xunit;
+
+namespace Agibuild.Fulora.UnitTests;
+
+public sealed class FetchBridgeTransportTests
+{
+    private const string Origin = "app://localhost";
+
+    private readonly TestDispatcher _dispatcher = new();
+
+    private (WebViewCore Core, MockWebViewAdapterWithFetchBridge Adapter, List<string> Scripts) CreateCore(
+        WebMessageBridgeTransport transport = WebMessageBridgeTransport.Fetch,
+        IWebMessageDropDiagnosticsSink? dropSink = null)
+    {
+        var adapter = MockWebViewAdapter.CreateWithFetchBridge();
+        var scripts = new List<string>();
+        adapter.ScriptCallback = script => { scripts.Add(script); return null; };
+        var core = new WebViewCore(adapter, _dispatcher);
+        core.EnableWebMessageBridge(new WebMessageBridgeOptions
+        {
+            AllowedOrigins = new HashSet<string> { Origin },
+            DropDiagnosticsSink = dropSink,
+            Transport = transport
+        });
+        _dispatcher.RunAll();
+        core.Rpc!.Handle("Calc.add", (JsonElement? args) =>
+            (object?)(args!.Value.GetProperty("a").GetInt32() + args.Value.GetProperty("b").GetInt32()));
+        return (core, adapter, scripts);
+    }
+
+    [Fact]
+    public void Fetch_transport_installs_the_handler_and_switches_the_stub()
+    {
+        var (_, adapter, scripts) = CreateCore();
+
+        Assert.NotNull(adapter.FetchBridgeHandler);
+        Assert.Contains(scripts, s => s.Contains("_setTransport('fetch')"));
+    }
+
+    [Fact]
+    public void PostMessage_transport_leaves_the_adapter_handler_unset()
+    {
+        var (_, adapter, scripts) = CreateCore(WebMessageBridgeTransport.PostMessage);
+
+        Assert.Null(adapter.FetchBridgeHandler);
+        Assert.DoesNotContain(scripts, s => s.Contains("_setTransport"));
+    }
+
+    [Fact]
+    public void Fetch_transport_falls_back_when_the_adapter_cannot_serve_it()
+    {
+        var adapter = MockWebViewAdapter.CreateWithFetchBridge();
+        adapter.FetchBridgeSupported = false;
+        var scripts = new List<string>();
+        adapter.ScriptCallback = script => { scripts.Add(script); return null; };
+        var core = new WebViewCore(adapter, _dispatcher);
+
+        core.EnableWebMessageBridge(new WebMessageBridgeOptions { Transport = WebMessageBridgeTransport.Fetch });
+        _dispatcher.RunAll();
+
+        Assert.Null(adapter.FetchBridgeHandler);
+        Assert.DoesNotContain(scripts, s => s.Contains("_setTransport"));
+    }
+
+    [Fact]
+    public async Task Fetch_request_is_answered_in_the_response_body()
+    {
+        var (_, adapter, scripts) = CreateCore();
+        scripts.Clear();
+
+        var response = await adapter.FetchAsync("""{"jsonrpc":"2.0","id":"__js_1","method":"Calc.add","params":{"a":3,"b":4}}""");
+
+        Assert.NotNull(response);
+        using var doc = JsonDocument.Parse(response);
+        Assert.Equal("__js_1", doc.RootElement.GetProperty("id").GetString());
+        Assert.Equal(7, doc.RootElement.GetProperty("result").GetInt32());
+        Assert.DoesNotContain(scripts, s => s.Contains("_onResponse"));
+    }
+
+    [Fact]
+    public async Task Fetch_batch_returns_an_array()
+    {
+        var (_, adapter, _) = CreateCore();
+
+        var response = await adapter.FetchAsync(
+            """[{"jsonrpc":"2.0","id":"b1","method":"Calc.add","params":{"a":1,"b":1}},{"jsonrpc":"2.0","id":"b2","method":"No.such","params":{}}]""");
+
+        Assert.NotNull(response);
+        using var doc = JsonDocument.Parse(response);
+        var items = doc.RootElement.EnumerateArray().ToList();
+        Assert.Equal(2, items.Count);
+        Assert.Equal(2, items.Single(e => e.GetProperty("id").GetString() == "b1").GetProperty("result").GetInt32());
+        Assert.True(items.Single(e => e.GetProperty("id").GetString() == "b2").TryGetProperty("error", out _));
+    }
+
+    [Fact]
+    public async Task Fetch_request_from_a_disallowed_origin_is_refused_and_reported()
+    {
+        var sink = new RecordingDropSink();
+        var (_, adapter, _) = CreateCore(dropSink: sink);
+
+        var response = await adapter.FetchAsync(
+            """{"jsonrpc":"2.0","id":"__js_1","method":"Calc.add","params":{"a":1,"b":2}}""", "https://evil.example");
+
+        Assert.Null(response);
+        var dropped = Assert.Single(sink.Diagnostics);
+        Assert.Equal(WebMessageDropReason.OriginNotAllowed, dropped.Reason);
+        Assert.Equal("https://evil.example", dropped.Origin);
+    }
+
+    [Fact]
+    public void Disabling_the_bridge_removes_the_handler()
+    {
+        var (core, adapter, _) = CreateCore();
+
+        core.DisableWebMessageBridge();
+
+        Assert.Null(adapter.FetchBridgeHandler);
+    }
+
+    private sealed class RecordingDropSink : IWebMessageDropDiagnosticsSink
+    {
+        public List<WebMessageDropDiagnostic> Diagnostics { get; } = [];
+
+        public void OnMessageDropped(in WebMessageDropDiagnostic diagnostic) => Diagnostics.Add(diagnostic);
+    }
+}
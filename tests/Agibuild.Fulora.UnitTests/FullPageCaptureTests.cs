@@ -0,0 +1,43 @@
+using Agibuild.Fulora.Adapters.Abstractions;
+using Agibuild.Fulora.Testing;
+using Xunit;
+
+namespace Agibuild.Fulora.UnitTests;
+
+public sealed class FullPageCaptureTests
+{
+    private readonly TestDispatcher _dispatcher = new();
+
+    [Fact]
+    public void Capture_is_written_to_the_destination()
+    {
+        var adapter = MockWebViewAdapter.CreateWithFullPageCapture();
+        using var core = new WebViewCore(adapter, _dispatcher);
+        using var destination = new MemoryStream();
+
+        var result = DispatcherTestPump.Run(_dispatcher, () => core.CaptureFullPageAsync(destination));
+
+        Assert.Equal(adapter.FullPageResult, result);
+        Assert.Equal(adapter.FullPagePng, destination.ToArray());
+        Assert.True(destination.CanWrite);
+    }
+
+    [Fact]
+    public void Adapters_without_full_page_capture_write_nothing()
+    {
+        using var core = new WebViewCore(MockWebViewAdapter.Create(), _dispatcher);
+        using var destination = new MemoryStream();
+
+        Assert.Null(DispatcherTestPump.Run(_dispatcher, () => core.CaptureFullPageAsync(destination)));
+        Assert.Equal(0, destination.Length);
+    }
+
+    [Fact]
+    public void Read_only_destinations_are_rejected()
+    {
+        using var core = new WebViewCore(MockWebViewAdapter.CreateWithFullPageCapture(), _dispatcher);
+
+        Assert.Throws<ArgumentException>(() => core.CaptureFullPageAsync(new MemoryStream([], writable: false)));
+        Assert.Throws<ArgumentNullException>(() => core.CaptureFullPageAsync(null!));
+    }
+}
@@ -0,0 +1,144 @@
+using Agibuild.Fulora.Adapters.Abstractions;
+using Agibuild.Fulora.Adapters.Gtk;
+using Xunit;
+
+namespace Agibuild.Fulora.UnitTests.Gtk;
+
+public sealed class GtkActivityStateTests
+{
+    [Fact]
+    public void Hidden_view_is_throttled_then_suspended_on_the_ui_context()
+    {
+        var (adapter, clock, states) = Create(TimeSpan.FromSeconds(30));
+        var ui = new QueueingContext();
+
+        RunOn(ui, () => adapter.TestOnly_FollowHostVisibility(false));
+
+        Assert.Equal(WebViewActivityState.Throttled, adapter.ActivityState);
+        var timer = Assert.Single(clock.Timers);
+        Assert.Equal(TimeSpan.FromSeconds(30), timer.DueTime);
+
+        timer.Fire();
+        Assert.Equal(WebViewActivityState.Throttled, adapter.ActivityState);
+
+        ui.RunAll();
+        Assert.Equal(WebViewActivityState.Suspended, adapter.ActivityState);
+        Assert.Equal(new[] { WebViewActivityState.Throttled, WebViewActivityState.Suspended }, states);
+    }
+
+    [Fact]
+    public void Showing_the_view_cancels_the_pending_suspend()
+    {
+        var (adapter, clock, states) = Create(TimeSpan.FromSeconds(30));
+
+        adapter.TestOnly_FollowHostVisibility(false);
+        adapter.TestOnly_FollowHostVisibility(true);
+
+        var timer = Assert.Single(clock.Timers);
+        Assert.True(timer.Disposed);
+        timer.Fire();
+
+        Assert.Equal(WebViewActivityState.Active, adapter.ActivityState);
+        Assert.Equal(new[] { WebViewActivityState.Throttled, WebViewActivityState.Active }, states);
+    }
+
+    [Fact]
+    public void Repeated_hides_start_a_single_timer()
+    {
+        var (adapter, clock, states) = Create(TimeSpan.FromSeconds(30));
+
+        adapter.TestOnly_FollowHostVisibility(false);
+        adapter.TestOnly_FollowHostVisibility(false);
+        adapter.TestOnly_FollowHostVisibility(true);
+        adapter.TestOnly_FollowHostVisibility(true);
+
+        Assert.Single(clock.Timers);
+        Assert.Equal(new[] { WebViewActivityState.Throttled, WebViewActivityState.Active }, states);
+    }
+
+    [Fact]
+    public void Without_a_suspend_delay_a_hidden_view_stays_throttled()
+    {
+        var (adapter, clock, _) = Create(null);
+
+        adapter.TestOnly_FollowHostVisibility(false);
+
+        Assert.Equal(WebViewActivityState.Throttled, adapter.ActivityState);
+        Assert.Empty(clock.Timers);
+    }
+
+    private static (GtkWebViewAdapter Adapter, ManualTimeProvider Clock, List<WebViewActivityState> States) Create(TimeSpan? suspendAfter)
+    {
+        var clock = new ManualTimeProvider();
+        var adapter = new GtkWebViewAdapter
+        {
+            SuspendAfterHidden = suspendAfter,
+            ActivityTimeProvider = clock,
+        };
+        var states = new List<WebViewActivityState>();
+        adapter.ActivityStateChanged += (_, state) => states.Add(state);
+        return (adapter, clock, states);
+    }
+
+    private static void RunOn(SynchronizationContext context, Action action)
+    {
+        var previous = SynchronizationContext.Current;
+        SynchronizationContext.SetSynchronizationContext(context);
+        try
+        {
+            action();
+        }
+        finally
+        {
+            SynchronizationContext.SetSynchronizationContext(previous);
+        }
+    }
+
+    private sealed class QueueingContext : SynchronizationContext
+    {
+        private readonly Queue<(SendOrPostCallback Callback, object? State)> _posted = new();
+
+        public override void Post(SendOrPostCallback d, object? state) => _posted.Enqueue((d, state));
+
+        public void RunAll()
+        {
+            while (_posted.TryDequeue(out var item))
+                item.Callback(item.State);
+        }
+    }
+
+    private sealed class ManualTimeProvider : TimeProvider
+    {
+        public List<ManualTimer> Timers { get; } = [];
+
+        public override ITimer CreateTimer(TimerCallback callback, object? state, TimeSpan dueTime, TimeSpan period)
+        {
+            var timer = new ManualTimer(callback, state, dueTime);
+            Timers.Add(timer);
+            return timer;
+        }
+    }
+
+    private sealed class ManualTimer(TimerCallback callback, object? state, TimeSpan dueTime) : ITimer
+    {
+        public TimeSpan DueTime { get; private set; } = dueTime;
+        public bool Disposed { get; private set; }
+
+        // A real timer can still fire once after Dispose if the callback was already queued.
+        public void Fire() => callback(state);
+
+        public bool Change(TimeSpan dueTime, TimeSpan period)
+        {
+            DueTime = dueTime;
+            return !Disposed;
+        }
+
+        public void Dispose() => Disposed = true;
+
+        public ValueTask DisposeAsync()
+        {
+            Dispose();
+            return ValueTask.CompletedTask;
+        }
+    }
+}
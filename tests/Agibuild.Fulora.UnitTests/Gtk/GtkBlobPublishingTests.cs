@@ -0,0 +1,27 @@
+using Agibuild.Fulora.Adapters.Gtk;
+using Xunit;
+
+namespace Agibuild.Fulora.UnitTests.Gtk;
+
+public sealed class GtkBlobPublishingTests
+{
+    [Theory]
+    [InlineData(GtkWebViewAdapter.BlobInvalidId, typeof(ArgumentException))]
+    [InlineData(GtkWebViewAdapter.BlobNoMemory, typeof(InsufficientMemoryException))]
+    [InlineData(GtkWebViewAdapter.BlobUnavailable, typeof(ObjectDisposedException))]
+    [InlineData(GtkWebViewAdapter.BlobDuplicateId, typeof(ArgumentException))]
+    public void Each_publish_failure_maps_to_its_own_exception(int status, Type expected)
+    {
+        Assert.IsType(expected, GtkWebViewAdapter.PublishBlobFailure(status, "frame-1"));
+    }
+
+    [Fact]
+    public void Duplicate_and_invalid_ids_are_told_apart()
+    {
+        var invalid = GtkWebViewAdapter.PublishBlobFailure(GtkWebViewAdapter.BlobInvalidId, "frame/1");
+        var duplicate = GtkWebViewAdapter.PublishBlobFailure(GtkWebViewAdapter.BlobDuplicateId, "frame-1");
+
+        Assert.Contains("may only contain", invalid.Message);
+        Assert.Contains("already published", duplicate.Message);
+    }
+}
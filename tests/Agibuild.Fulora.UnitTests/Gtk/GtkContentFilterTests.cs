@@ -0,0 +1,70 @@
+using Agibuild.Fulora.Adapters.Abstractions;
+using Agibuild.Fulora.Adapters.Gtk;
+using Xunit;
+
+namespace Agibuild.Fulora.UnitTests.Gtk;
+
+public sealed class GtkContentFilterTests
+{
+    [Fact]
+    public void CountContentFilterRules_counts_top_level_rule_objects()
+    {
+        const string rules = """
+            [
+              { "trigger": { "url-filter": ".*tracker\\.example" }, "action": { "type": "block" } },
+              { "trigger": { "url-filter": ".*", "resource-type": ["image"] }, "action": { "type": "block" } },
+              { "trigger": { "url-filter": "ads" }, "action": { "type": "css-display-none", "selector": ".ad" } }
+            ]
+            """;
+
+        Assert.Equal(3, GtkWebViewAdapter.CountContentFilterRules(rules));
+    }
+
+    [Fact]
+    public void CountContentFilterRules_returns_zero_for_empty_list()
+    {
+        Assert.Equal(0, GtkWebViewAdapter.CountContentFilterRules("[]"));
+    }
+
+    [Fact]
+    public void CountContentFilterRules_rejects_non_array_payload()
+    {
+        Assert.Throws<ArgumentException>(() => GtkWebViewAdapter.CountContentFilterRules("""{ "rules": [] }"""));
+    }
+
+    [Fact]
+    public void ContentFilterStoreId_changes_when_the_rules_change()
+    {
+        var first = GtkWebViewAdapter.ContentFilterStoreId("ads", "[]");
+
+        Assert.Equal(first, GtkWebViewAdapter.ContentFilterStoreId("ads", "[]"));
+        Assert.StartsWith("ads-", first);
+        Assert.NotEqual(first, GtkWebViewAdapter.ContentFilterStoreId("ads", """[{ "trigger": {} }]"""));
+        Assert.NotEqual(first, GtkWebViewAdapter.ContentFilterStoreId("trackers", "[]"));
+    }
+
+    [Fact]
+    public async Task ContentFilterRequest_reports_the_load_result()
+    {
+        var request = new GtkWebViewAdapter.ContentFilterRequest("ads", ruleCount: 2);
+
+        request.Complete(success: true, fromCache: true, elapsedUs: 1500, error: null);
+
+        var result = await request.Completion.Task;
+        Assert.Equal(new ContentFilterResult("ads", 2, true, TimeSpan.FromMicroseconds(1500)), result);
+    }
+
+    [Fact]
+    public async Task ContentFilterRequest_faults_when_the_view_detaches_mid_load()
+    {
+        var request = new GtkWebViewAdapter.ContentFilterRequest("ads", ruleCount: 2);
+
+        // The shim's detach answers an in-flight load with "Detached"; the store's own
+        // completion afterwards is dropped natively and never reaches managed code.
+        request.Complete(success: false, fromCache: false, elapsedUs: 10, error: "Detached");
+        request.Complete(success: true, fromCache: false, elapsedUs: 20, error: null);
+
+        var ex = await Assert.ThrowsAsync<InvalidOperationException>(() => request.Completion.Task);
+        Assert.Contains("Detached", ex.Message);
+    }
+}
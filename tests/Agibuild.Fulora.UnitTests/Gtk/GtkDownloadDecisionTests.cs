@@ -0,0 +1,40 @@
+using Agibuild.Fulora.Adapters.Gtk;
+using Xunit;
+
+namespace Agibuild.Fulora.UnitTests.Gtk;
+
+public sealed class GtkDownloadDecisionTests
+{
+    private static DownloadRequestedEventArgs Args() => new(new Uri("https://example.test/file.zip"), "file.zip");
+
+    [Fact]
+    public void Cancel_wins_over_a_destination()
+    {
+        var args = Args();
+        args.DownloadPath = "/tmp/file.zip";
+        args.Cancel = true;
+
+        Assert.Equal(GtkWebViewAdapter.DownloadDecisionCancel, GtkWebViewAdapter.DecideDownload(args, hasResolver: true));
+    }
+
+    [Fact]
+    public void Destination_from_the_event_is_accepted_without_the_resolver()
+    {
+        var args = Args();
+        args.DownloadPath = "/tmp/file.zip";
+
+        Assert.Equal(GtkWebViewAdapter.DownloadDecisionAccepted, GtkWebViewAdapter.DecideDownload(args, hasResolver: true));
+    }
+
+    [Theory]
+    [InlineData(false, false, GtkWebViewAdapter.DownloadDecisionDefault)]
+    [InlineData(true, false, GtkWebViewAdapter.DownloadDecisionDeferred)]
+    [InlineData(true, true, GtkWebViewAdapter.DownloadDecisionDefault)]
+    public void Undecided_downloads_defer_to_the_resolver_unless_handled(bool hasResolver, bool handled, int expected)
+    {
+        var args = Args();
+        args.Handled = handled;
+
+        Assert.Equal(expected, GtkWebViewAdapter.DecideDownload(args, hasResolver));
+    }
+}
@@ -0,0 +1,37 @@
+using Agibuild.Fulora.Adapters.Gtk;
+using Xunit;
+
+namespace Agibuild.Fulora.UnitTests.Gtk;
+
+public sealed class GtkDragMotionStatsTests
+{
+    [Fact]
+    public void AdvanceCounter_reports_the_increase_since_the_last_report()
+    {
+        ulong reported = 0;
+
+        Assert.Equal(5, GtkWebViewAdapter.AdvanceCounter(5, ref reported));
+        Assert.Equal(0, GtkWebViewAdapter.AdvanceCounter(5, ref reported));
+        Assert.Equal(3, GtkWebViewAdapter.AdvanceCounter(8, ref reported));
+        Assert.Equal(8UL, reported);
+    }
+
+    [Fact]
+    public void AdvanceCounter_does_not_wrap_when_the_counter_goes_backwards()
+    {
+        ulong reported = 40;
+
+        // Stats read after detach are zero.
+        Assert.Equal(0, GtkWebViewAdapter.AdvanceCounter(0, ref reported));
+        Assert.Equal(0UL, reported);
+        Assert.Equal(2, GtkWebViewAdapter.AdvanceCounter(2, ref reported));
+    }
+
+    [Fact]
+    public void AdvanceCounter_saturates_at_long_max()
+    {
+        ulong reported = 0;
+
+        Assert.Equal(long.MaxValue, GtkWebViewAdapter.AdvanceCounter(ulong.MaxValue, ref reported));
+    }
+}
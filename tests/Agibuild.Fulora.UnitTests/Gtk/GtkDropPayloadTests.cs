@@ -0,0 +1,105 @@
+using System.Runtime.InteropServices;
+using Agibuild.Fulora.Adapters.Gtk;
+using Xunit;
+
+namespace Agibuild.Fulora.UnitTests.Gtk;
+
+public sealed class GtkDropPayloadTests
+{
+    [Fact]
+    public void BuildGtkDropPayload_keeps_local_paths_verbatim_and_first_remote_uri()
+    {
+        var strings = new List<IntPtr>();
+        IntPtr Utf8(string value)
+        {
+            var ptr = Marshal.StringToCoTaskMemUTF8(value);
+            strings.Add(ptr);
+            return ptr;
+        }
+
+        try
+        {
+            var paths = new[] { Utf8("/photos/a \"quoted\" name.jpg"), IntPtr.Zero, Utf8("/photos/back\\slash.png") };
+            var uris = new[]
+            {
+                Utf8("file:///photos/a%20%22quoted%22%20name.jpg"),
+                Utf8("https://example.test/remote.png"),
+                Utf8("file:///photos/back%5Cslash.png"),
+            };
+
+            var payload = GtkWebViewAdapter.BuildGtkDropPayload(paths, uris, IntPtr.Zero);
+
+            Assert.NotNull(payload.Files);
+            Assert.Equal(["/photos/a \"quoted\" name.jpg", "/photos/back\\slash.png"], payload.Files!.Select(f => f.Path));
+            Assert.All(payload.Files!, f => Assert.Null(f.MimeType));
+            Assert.NotNull(payload.FileInfoResolver);
+            Assert.Equal("https://example.test/remote.png", payload.Uri);
+            Assert.Null(payload.Text);
+        }
+        finally
+        {
+            strings.ForEach(Marshal.FreeCoTaskMem);
+        }
+    }
+
+    [Fact]
+    public void BuildGtkDropPayload_with_text_only_has_no_files()
+    {
+        var text = Marshal.StringToCoTaskMemUTF8("dropped text");
+        try
+        {
+            var payload = GtkWebViewAdapter.BuildGtkDropPayload([], [], text);
+
+            Assert.Null(payload.Files);
+            Assert.Equal("dropped text", payload.Text);
+        }
+        finally
+        {
+            Marshal.FreeCoTaskMem(text);
+        }
+    }
+
+    [Fact]
+    public async Task Drop_file_info_is_looked_up_once_per_file()
+    {
+        var queries = new List<string>();
+        var resolver = GtkWebViewAdapter.CreateDropFileInfoResolver(file =>
+        {
+            lock (queries)
+                queries.Add(file.Path);
+            return file with { MimeType = "text/plain" };
+        });
+        var payload = new DragDropPayload
+        {
+            Files = [new FileDropInfo("/a.txt"), new FileDropInfo("/b.txt")],
+            FileInfoResolver = resolver
+        };
+
+        var first = await payload.GetFileInfoAsync(0, TestContext.Current.CancellationToken);
+        var all = await payload.WithFileInfoAsync(TestContext.Current.CancellationToken);
+
+        Assert.Equal("text/plain", first.MimeType);
+        Assert.All(all.Files!, f => Assert.Equal("text/plain", f.MimeType));
+        Assert.Equal(new[] { "/a.txt", "/b.txt" }, queries);
+    }
+
+    [Fact]
+    public async Task Cancelled_wait_does_not_cache_a_cancelled_lookup()
+    {
+        using var release = new ManualResetEventSlim();
+        var resolver = GtkWebViewAdapter.CreateDropFileInfoResolver(file =>
+        {
+            release.Wait();
+            return file with { Size = 7 };
+        });
+        using var cts = new CancellationTokenSource();
+
+        var waiting = resolver(new FileDropInfo("/a.bin"), cts.Token);
+        cts.Cancel();
+        await Assert.ThrowsAnyAsync<OperationCanceledException>(() => waiting);
+
+        release.Set();
+        var info = await resolver(new FileDropInfo("/a.bin"), TestContext.Current.CancellationToken);
+        Assert.Equal(7, info.Size);
+    }
+}
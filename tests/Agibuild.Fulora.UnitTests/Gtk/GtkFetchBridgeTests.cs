@@ -0,0 +1,55 @@
+using System.Text;
+using Agibuild.Fulora.Adapters.Gtk;
+using Xunit;
+
+namespace Agibuild.Fulora.UnitTests.Gtk;
+
+public sealed class GtkFetchBridgeTests
+{
+    private const string Origin = "https://app.example";
+
+    [Fact]
+    public async Task Admitted_call_names_exactly_its_origin()
+    {
+        string? seenOrigin = null;
+        var response = await GtkWebViewAdapter.ServeFetchBridgeRequestAsync((body, origin, _) =>
+        {
+            seenOrigin = origin;
+            return Task.FromResult<string?>("{\"echo\":" + body + "}");
+        }, Upload("1", Origin), CancellationToken.None);
+
+        Assert.NotNull(response);
+        Assert.Equal(Origin, seenOrigin);
+        Assert.Equal(Origin, response.AllowOrigin);
+        Assert.Equal("application/json", response.ContentType);
+        Assert.Equal("{\"echo\":1}", Encoding.UTF8.GetString(response.Body.Span));
+    }
+
+    [Fact]
+    public async Task Refused_call_has_no_response_to_attach_cors_headers_to()
+    {
+        var response = await GtkWebViewAdapter.ServeFetchBridgeRequestAsync(
+            (_, _, _) => Task.FromResult<string?>(null), Upload("1", "https://evil.example"), CancellationToken.None);
+
+        Assert.Null(response);
+    }
+
+    [Fact]
+    public async Task Call_without_an_origin_gets_no_wildcard()
+    {
+        var response = await GtkWebViewAdapter.ServeFetchBridgeRequestAsync(
+            (_, _, _) => Task.FromResult<string?>("{}"), Upload("1", origin: null), CancellationToken.None);
+
+        Assert.NotNull(response);
+        Assert.Null(response.AllowOrigin);
+    }
+
+    private static GtkSchemeUpload Upload(string body, string? origin)
+    {
+        var headers = new Dictionary<string, string>(StringComparer.OrdinalIgnoreCase);
+        if (origin is not null)
+            headers["Origin"] = origin;
+        var bytes = Encoding.UTF8.GetBytes(body);
+        return new GtkSchemeUpload(new Uri("app://__rpc/Calc/add"), "POST", headers, bytes.Length, new MemoryStream(bytes));
+    }
+}
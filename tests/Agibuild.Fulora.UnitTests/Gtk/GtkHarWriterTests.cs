@@ -0,0 +1,45 @@
+using System.Text.Json;
+using Agibuild.Fulora.Adapters.Gtk;
+using Xunit;
+
+namespace Agibuild.Fulora.UnitTests.Gtk;
+
+public sealed class GtkHarWriterTests
+{
+    [Fact]
+    public void Write_produces_har_entries_with_timings_and_handler_time()
+    {
+        var started = new DateTimeOffset(2026, 3, 1, 12, 0, 0, TimeSpan.Zero);
+        var entries = new[]
+        {
+            GtkResourceTiming.FromNative("app://localhost/index.html", "GET", "text/html", 200, failed: false,
+                startedUnixUs: started.ToUnixTimeMilliseconds() * 1000, waitUs: 12_000, receiveUs: 3_000,
+                totalUs: 15_000, size: 2048, handlerUs: 11_500),
+            GtkResourceTiming.FromNative("https://cdn.example/missing.js", "GET", null, 0, failed: true,
+                startedUnixUs: started.ToUnixTimeMilliseconds() * 1000, waitUs: -1, receiveUs: -1,
+                totalUs: 40_000, size: -1, handlerUs: -1),
+        };
+
+        using var doc = JsonDocument.Parse(GtkHarWriter.Write(entries, "Test", "1.0"));
+        var log = doc.RootElement.GetProperty("log");
+        Assert.Equal("1.2", log.GetProperty("version").GetString());
+
+        var har = log.GetProperty("entries");
+        Assert.Equal(2, har.GetArrayLength());
+
+        var first = har[0];
+        Assert.Equal("app://localhost/index.html", first.GetProperty("request").GetProperty("url").GetString());
+        Assert.Equal(200, first.GetProperty("response").GetProperty("status").GetInt32());
+        Assert.Equal(2048, first.GetProperty("response").GetProperty("content").GetProperty("size").GetInt64());
+        Assert.Equal(12, first.GetProperty("timings").GetProperty("wait").GetDouble());
+        Assert.Equal(3, first.GetProperty("timings").GetProperty("receive").GetDouble());
+        Assert.Equal(11.5, first.GetProperty("_handlerMs").GetDouble());
+        Assert.Equal(15, first.GetProperty("time").GetDouble());
+
+        var second = har[1];
+        Assert.True(second.GetProperty("_failed").GetBoolean());
+        Assert.Equal(40, second.GetProperty("timings").GetProperty("wait").GetDouble());
+        Assert.Equal(-1, second.GetProperty("response").GetProperty("content").GetProperty("size").GetInt64());
+        Assert.False(second.TryGetProperty("_handlerMs", out _));
+    }
+}
@@ -0,0 +1,97 @@
+using Agibuild.Fulora.Adapters.Gtk;
+using Xunit;
+
+namespace Agibuild.Fulora.UnitTests.Gtk;
+
+public sealed class GtkHibernationManagerTests
+{
+    private const long Mb = 1024 * 1024;
+
+    [Fact]
+    public async Task MarkActiveAsync_hibernates_least_recently_active_views_beyond_budget()
+    {
+        var manager = new GtkHibernationManager(memoryBudgetBytes: 400 * Mb, estimatedBytesPerView: 200 * Mb);
+        var a = new FakeView();
+        var b = new FakeView();
+        var c = new FakeView();
+        manager.Register(a);
+        manager.Register(b);
+        manager.Register(c);
+
+        await manager.MarkActiveAsync(a);
+
+        Assert.True(b.IsHibernated);
+        Assert.False(a.IsHibernated);
+        Assert.False(c.IsHibernated);
+        Assert.Equal(2, manager.AwakeViewCount);
+    }
+
+    [Fact]
+    public async Task MarkActiveAsync_resumes_a_hibernated_view_and_evicts_the_next_oldest()
+    {
+        var manager = new GtkHibernationManager(memoryBudgetBytes: 200 * Mb, estimatedBytesPerView: 200 * Mb)
+        {
+            CaptureSnapshots = false,
+        };
+        var a = new FakeView();
+        var b = new FakeView();
+        manager.Register(a);
+        manager.Register(b);
+        await manager.TrimAsync();
+        Assert.True(a.IsHibernated);
+
+        await manager.MarkActiveAsync(a);
+
+        Assert.False(a.IsHibernated);
+        Assert.True(b.IsHibernated);
+        Assert.Equal(1, a.ResumeCount);
+        Assert.False(b.LastCaptureSnapshot);
+    }
+
+    [Fact]
+    public void Adapter_becoming_visible_marks_itself_active_in_its_manager()
+    {
+        var manager = new GtkHibernationManager(memoryBudgetBytes: 200 * Mb, estimatedBytesPerView: 200 * Mb);
+        var background = new FakeView();
+        manager.Register(background);
+        var adapter = new GtkWebViewAdapter { HibernationManager = manager };
+
+        adapter.SetHostVisible(false);
+        Assert.False(background.IsHibernated);
+
+        adapter.SetHostVisible(true);
+
+        Assert.True(background.IsHibernated);
+        Assert.Equal(1, manager.AwakeViewCount);
+    }
+
+    [Fact]
+    public void Views_configured_with_the_same_budget_share_one_manager()
+    {
+        var shared = GtkHibernationManager.ForBudget(800 * Mb);
+
+        Assert.Same(shared, GtkHibernationManager.ForBudget(800 * Mb));
+        Assert.NotSame(shared, GtkHibernationManager.ForBudget(400 * Mb));
+        Assert.Equal(4, shared.MaxAwakeViews);
+    }
+
+    private sealed class FakeView : IGtkHibernatable
+    {
+        public bool IsHibernated { get; private set; }
+        public int ResumeCount { get; private set; }
+        public bool? LastCaptureSnapshot { get; private set; }
+
+        public Task HibernateAsync(bool captureSnapshot)
+        {
+            LastCaptureSnapshot = captureSnapshot;
+            IsHibernated = true;
+            return Task.CompletedTask;
+        }
+
+        public void Resume()
+        {
+            ResumeCount++;
+            IsHibernated = false;
+        }
+    }
+}
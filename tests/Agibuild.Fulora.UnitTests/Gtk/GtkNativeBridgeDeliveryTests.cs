@@ -0,0 +1,18 @@
+using Agibuild.Fulora.Adapters.Abstractions;
+using Agibuild.Fulora.Adapters.Gtk;
+using Xunit;
+
+namespace Agibuild.Fulora.UnitTests.Gtk;
+
+public sealed class GtkNativeBridgeDeliveryTests
+{
+    [Theory]
+    [InlineData(RpcDeliveryKind.Dispatch)]
+    [InlineData(RpcDeliveryKind.Response)]
+    public void TryDeliverRpc_without_an_attached_native_bridge_leaves_delivery_to_script(RpcDeliveryKind kind)
+    {
+        var adapter = new GtkWebViewAdapter();
+
+        Assert.False(adapter.TryDeliverRpc(kind, """{"jsonrpc":"2.0","id":"__js_1","result":1}"""));
+    }
+}
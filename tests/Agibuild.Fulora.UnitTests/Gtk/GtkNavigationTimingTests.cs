@@ -0,0 +1,43 @@
+using Agibuild.Fulora;
+using Agibuild.Fulora.Adapters.Gtk;
+using Xunit;
+
+namespace Agibuild.Fulora.UnitTests.Gtk;
+
+public sealed class GtkNavigationTimingTests
+{
+    [Fact]
+    public void FromNative_converts_offsets_and_derives_server_and_render_time()
+    {
+        var timing = GtkNavigationTiming.FromNative(
+            "https://gtk-timing.example/", status: 0,
+            policyDecidedUs: 1_500, policyWaitUs: 2_000, loadStartedUs: 2_000,
+            committedUs: 52_000, firstPaintUs: 70_000, finishedUs: 90_000, redirectCount: 1);
+
+        Assert.Equal(new Uri("https://gtk-timing.example/"), timing.Url);
+        Assert.Equal(NavigationCompletedStatus.Success, timing.Status);
+        Assert.Equal(TimeSpan.FromMilliseconds(1.5), timing.PolicyDecided);
+        Assert.Equal(TimeSpan.FromMilliseconds(2), timing.PolicyWait);
+        Assert.Equal(TimeSpan.FromMilliseconds(50), timing.ServerTime);
+        Assert.Equal(TimeSpan.FromMilliseconds(18), timing.RenderTime);
+        Assert.Equal(TimeSpan.FromMilliseconds(90), timing.Finished);
+        Assert.Equal(1, timing.RedirectCount);
+    }
+
+    [Fact]
+    public void FromNative_leaves_unreached_phases_null()
+    {
+        var timing = GtkNavigationTiming.FromNative(
+            null, status: 4,
+            policyDecidedUs: -1, policyWaitUs: 0, loadStartedUs: 100,
+            committedUs: -1, firstPaintUs: -1, finishedUs: 30_000, redirectCount: 0);
+
+        Assert.Null(timing.Url);
+        Assert.Equal(NavigationCompletedStatus.Failure, timing.Status);
+        Assert.Null(timing.PolicyDecided);
+        Assert.Null(timing.Committed);
+        Assert.Null(timing.ServerTime);
+        Assert.Null(timing.RenderTime);
+        Assert.Equal(TimeSpan.FromMilliseconds(30), timing.Finished);
+    }
+}
@@ -0,0 +1,42 @@
+using Agibuild.Fulora.Adapters.Gtk;
+using Xunit;
+
+namespace Agibuild.Fulora.UnitTests.Gtk;
+
+public sealed class GtkOffscreenFrameCopyTests
+{
+    [Fact]
+    public void CopyPixels_writes_only_the_dirty_rectangle()
+    {
+        const int width = 4, height = 3;
+        const int sourceStride = width * 4 + 8; // padded rows, as cairo may produce
+        const int destinationStride = width * 4;
+        var source = new byte[sourceStride * height];
+        for (var i = 0; i < source.Length; i++)
+            source[i] = (byte)(i + 1);
+        var destination = new byte[destinationStride * height];
+
+        GtkWebViewAdapter.CopyPixels(source, sourceStride, destination, destinationStride, x: 1, y: 1, width: 2, height: 2);
+
+        for (var row = 0; row < height; row++)
+        {
+            for (var column = 0; column < width; column++)
+            {
+                var inside = row is >= 1 and < 3 && column is >= 1 and < 3;
+                for (var channel = 0; channel < 4; channel++)
+                {
+                    var expected = inside ? source[row * sourceStride + column * 4 + channel] : (byte)0;
+                    Assert.Equal(expected, destination[row * destinationStride + column * 4 + channel]);
+                }
+            }
+        }
+    }
+
+    [Fact]
+    public void CopyPixels_ignores_an_empty_rectangle()
+    {
+        var destination = new byte[16];
+        GtkWebViewAdapter.CopyPixels(new byte[16], 16, destination, 16, 0, 0, 0, 1);
+        Assert.All(destination, b => Assert.Equal(0, b));
+    }
+}
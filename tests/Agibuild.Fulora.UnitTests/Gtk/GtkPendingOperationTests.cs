@@ -0,0 +1,46 @@
+using Agibuild.Fulora.Adapters.Gtk;
+using Xunit;
+
+namespace Agibuild.Fulora.UnitTests.Gtk;
+
+public sealed class GtkPendingOperationTests
+{
+    [Fact]
+    public void CreatePendingOperation_keeps_the_full_64_bit_id()
+    {
+        const ulong id = (7UL << 32) | 3;
+        var op = GtkWebViewAdapter.CreatePendingOperation(new GtkWebViewAdapter.PendingOpNative
+        {
+            Id = id,
+            Kind = 1,
+            Completing = 0,
+            AgeUs = 2_500,
+        });
+
+        Assert.Equal(id, op.Id);
+        Assert.Equal(GtkPendingOperationKind.PolicyDecision, op.Kind);
+        Assert.False(op.Completing);
+        Assert.Equal(TimeSpan.FromMicroseconds(2_500), op.Age);
+    }
+
+    [Theory]
+    [InlineData(2, GtkPendingOperationKind.Script)]
+    [InlineData(3, GtkPendingOperationKind.Screenshot)]
+    [InlineData(4, GtkPendingOperationKind.PrintToPdf)]
+    [InlineData(5, GtkPendingOperationKind.CookieRead)]
+    [InlineData(42, GtkPendingOperationKind.Unknown)]
+    public void CreatePendingOperation_maps_native_kinds(int nativeKind, GtkPendingOperationKind expected)
+    {
+        var op = GtkWebViewAdapter.CreatePendingOperation(new GtkWebViewAdapter.PendingOpNative
+        {
+            Id = 1,
+            Kind = nativeKind,
+            Completing = 1,
+            AgeUs = -5,
+        });
+
+        Assert.Equal(expected, op.Kind);
+        Assert.True(op.Completing);
+        Assert.Equal(TimeSpan.Zero, op.Age);
+    }
+}
@@ -0,0 +1,69 @@
+using Agibuild.Fulora.Adapters.Gtk;
+using Xunit;
+
+namespace Agibuild.Fulora.UnitTests.Gtk;
+
+public sealed class GtkPerformanceProfileTests
+{
+    public static TheoryData<WebViewPerformanceProfile> Presets => new()
+    {
+        WebViewPerformanceProfile.Default,
+        WebViewPerformanceProfile.LowMemory,
+        WebViewPerformanceProfile.Throughput,
+        WebViewPerformanceProfile.Interactive,
+    };
+
+    [Theory]
+    [MemberData(nameof(Presets))]
+    public void Presets_survive_the_native_struct(WebViewPerformanceProfile name)
+    {
+        var profile = GtkPerformanceProfile.From(name);
+
+        Assert.Equal(profile, GtkWebViewAdapter.TestOnly_RoundTripNativeProfile(profile));
+    }
+
+    [Fact]
+    public void Environment_option_selects_the_matching_preset()
+    {
+        Assert.Same(GtkPerformanceProfile.Default, GtkPerformanceProfile.From(WebViewPerformanceProfile.Default));
+        Assert.Same(GtkPerformanceProfile.LowMemory, GtkPerformanceProfile.From(WebViewPerformanceProfile.LowMemory));
+        Assert.Same(GtkPerformanceProfile.Throughput, GtkPerformanceProfile.From(WebViewPerformanceProfile.Throughput));
+        Assert.Same(GtkPerformanceProfile.Interactive, GtkPerformanceProfile.From(WebViewPerformanceProfile.Interactive));
+    }
+
+    [Fact]
+    public void Unset_values_stay_unset()
+    {
+        var profile = GtkPerformanceProfile.Default with { EnableWebGL = false };
+
+        var native = GtkWebViewAdapter.TestOnly_RoundTripNativeProfile(profile);
+
+        Assert.False(native.EnableWebGL);
+        Assert.Null(native.HardwareAccelerationPolicy);
+        Assert.Null(native.EnablePageCache);
+        Assert.Null(native.EnableSmoothScrolling);
+        Assert.Null(native.EnableMediaSource);
+        Assert.Null(native.EnableWriteConsoleMessagesToStdout);
+    }
+
+    [Fact]
+    public void Every_acceleration_policy_maps_through()
+    {
+        foreach (var policy in Enum.GetValues<GtkHardwareAccelerationPolicy>())
+        {
+            var profile = GtkPerformanceProfile.Default with { HardwareAccelerationPolicy = policy };
+            Assert.Equal(policy, GtkWebViewAdapter.TestOnly_RoundTripNativeProfile(profile).HardwareAccelerationPolicy);
+        }
+    }
+
+    [Fact]
+    public void Presets_set_the_documented_values()
+    {
+        Assert.Equal(GtkHardwareAccelerationPolicy.Never, GtkPerformanceProfile.LowMemory.HardwareAccelerationPolicy);
+        Assert.False(GtkPerformanceProfile.LowMemory.EnablePageCache);
+        Assert.Equal(GtkHardwareAccelerationPolicy.Always, GtkPerformanceProfile.Throughput.HardwareAccelerationPolicy);
+        Assert.False(GtkPerformanceProfile.Throughput.EnableSmoothScrolling);
+        Assert.Equal(GtkPerformanceProfile.Throughput with { EnableSmoothScrolling = true }, GtkPerformanceProfile.Interactive);
+        Assert.Equal(new GtkPerformanceProfile(), GtkPerformanceProfile.Default);
+    }
+}
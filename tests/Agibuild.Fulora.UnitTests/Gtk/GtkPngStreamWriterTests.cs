@@ -0,0 +1,148 @@
+using System.Buffers.Binary;
+using System.IO.Compression;
+using Agibuild.Fulora.Adapters.Gtk;
+using Xunit;
+
+namespace Agibuild.Fulora.UnitTests.Gtk;
+
+public sealed class GtkPngStreamWriterTests
+{
+    [Fact]
+    public void Rows_written_in_blocks_become_one_unpremultiplied_rgba_image()
+    {
+        using var output = new MemoryStream();
+        var writer = new GtkPngStreamWriter(output, width: 2, height: 3);
+
+        // BGRA, premultiplied; stride padded past the row on purpose.
+        byte[] first =
+        [
+            0, 0, 255, 255, 255, 0, 0, 255, 9, 9,
+            0, 64, 0, 128, 0, 0, 0, 0, 9, 9,
+        ];
+        byte[] last = [10, 20, 30, 255, 1, 2, 3, 255];
+        writer.WriteRows(first, stride: 10, rows: 2);
+        writer.WriteRows(last, stride: 8, rows: 1);
+        writer.Complete();
+
+        var (width, height, pixels) = Decode(output.ToArray());
+
+        Assert.Equal(2, width);
+        Assert.Equal(3, height);
+        Assert.Equal(new byte[]
+        {
+            0, 255, 0, 0, 255, 0, 0, 255, 255,
+            0, 0, 128, 0, 128, 0, 0, 0, 0,
+            0, 30, 20, 10, 255, 3, 2, 1, 255,
+        }, pixels);
+    }
+
+    [Fact]
+    public void Complete_requires_every_row()
+    {
+        using var output = new MemoryStream();
+        using var writer = new GtkPngStreamWriter(output, width: 1, height: 2);
+        writer.WriteRows([0, 0, 0, 255], stride: 4, rows: 1);
+
+        Assert.Throws<InvalidOperationException>(writer.Complete);
+    }
+
+    [Fact]
+    public void Writing_past_the_declared_height_is_rejected()
+    {
+        using var output = new MemoryStream();
+        using var writer = new GtkPngStreamWriter(output, width: 1, height: 1);
+
+        Assert.Throws<ArgumentOutOfRangeException>(() => writer.WriteRows(new byte[8], stride: 4, rows: 2));
+    }
+
+    [Fact]
+    public async Task Tile_writer_encodes_copied_tiles_in_order()
+    {
+        using var output = new MemoryStream();
+        var writer = new GtkPngTileWriter(output, maxQueuedTiles: 1);
+
+        var tile = new byte[] { 10, 20, 30, 255, 9, 9 };
+        for (var i = 0; i < 4; i++)
+        {
+            tile[0] = (byte)i;
+            writer.Add(new GtkScreenshotTile(i, i, 1, 1, 4, stride: 6, GtkTileEncoding.Raw, tile));
+        }
+        tile[0] = 99; // the writer holds its own copies
+        await writer.CompleteAsync();
+        await writer.DisposeAsync();
+
+        var (width, height, pixels) = Decode(output.ToArray());
+        Assert.Equal(1, width);
+        Assert.Equal(4, height);
+        Assert.Equal(new byte[]
+        {
+            0, 30, 20, 0, 255,
+            0, 30, 20, 1, 255,
+            0, 30, 20, 2, 255,
+            0, 30, 20, 3, 255,
+        }, pixels);
+    }
+
+    [Fact]
+    public async Task Tile_writer_failure_stops_the_next_tile_and_completion()
+    {
+        using var output = new MemoryStream();
+        var writer = new GtkPngTileWriter(output);
+
+        // Two rows into a one-row image fail on the writer.
+        writer.Add(new GtkScreenshotTile(0, 0, 1, 2, 1, stride: 4, GtkTileEncoding.Raw, new byte[8]));
+
+        await Assert.ThrowsAsync<ArgumentOutOfRangeException>(writer.CompleteAsync);
+        Assert.Throws<ArgumentOutOfRangeException>(() =>
+            writer.Add(new GtkScreenshotTile(1, 1, 1, 1, 1, stride: 4, GtkTileEncoding.Raw, new byte[4])));
+        await writer.DisposeAsync();
+    }
+
+    [Fact]
+    public async Task Tile_writer_without_tiles_has_no_image()
+    {
+        await using var writer = new GtkPngTileWriter(new MemoryStream());
+
+        await Assert.ThrowsAsync<InvalidOperationException>(writer.CompleteAsync);
+    }
+
+    /// <summary>Returns the IHDR size and the inflated scanlines (filter byte included).</summary>
+    private static (int Width, int Height, byte[] Scanlines) Decode(byte[] png)
+    {
+        Assert.Equal(new byte[] { 0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A }, png[..8]);
+
+        int width = 0, height = 0;
+        using var idat = new MemoryStream();
+        var offset = 8;
+        var sawEnd = false;
+        while (offset < png.Length)
+        {
+            var length = BinaryPrimitives.ReadInt32BigEndian(png.AsSpan(offset));
+            var type = System.Text.Encoding.ASCII.GetString(png, offset + 4, 4);
+            var data = png.AsSpan(offset + 8, length);
+            switch (type)
+            {
+                case "IHDR":
+                    width = BinaryPrimitives.ReadInt32BigEndian(data);
+                    height = BinaryPrimitives.ReadInt32BigEndian(data[4..]);
+                    Assert.Equal(8, data[8]);
+                    Assert.Equal(6, data[9]);
+                    break;
+                case "IDAT":
+                    idat.Write(data);
+                    break;
+                case "IEND":
+                    sawEnd = true;
+                    break;
+            }
+            offset += 12 + length;
+        }
+        Assert.True(sawEnd);
+
+        idat.Position = 0;
+        using var inflate = new ZLibStream(idat, CompressionMode.Decompress);
+        using var scanlines = new MemoryStream();
+        inflate.CopyTo(scanlines);
+        return (width, height, scanlines.ToArray());
+    }
+}
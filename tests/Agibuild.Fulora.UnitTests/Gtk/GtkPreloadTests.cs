@@ -0,0 +1,25 @@
+using Agibuild.Fulora.Adapters.Gtk;
+using Xunit;
+
+namespace Agibuild.Fulora.UnitTests.Gtk;
+
+public sealed class GtkPreloadTests
+{
+    [Theory]
+    [InlineData("https://example.test/next", true)]
+    [InlineData("HTTP://example.test/", true)]
+    [InlineData("app://localhost/index.html", false)]
+    [InlineData("file:///tmp/page.html", false)]
+    [InlineData("data:text/html,hi", false)]
+    [InlineData("javascript:alert(1)", false)]
+    public void Only_http_and_https_uris_are_preloaded(string uri, bool expected)
+    {
+        Assert.Equal(expected, GtkWebViewAdapter.IsPreloadableUri(new Uri(uri)));
+    }
+
+    [Fact]
+    public void Relative_uris_are_not_preloaded()
+    {
+        Assert.False(GtkWebViewAdapter.IsPreloadableUri(new Uri("/next", UriKind.Relative)));
+    }
+}
@@ -0,0 +1,43 @@
+using Agibuild.Fulora.Adapters.Gtk;
+using Xunit;
+
+namespace Agibuild.Fulora.UnitTests.Gtk;
+
+public sealed class GtkSchemeRequestHeadersTests
+{
+    [Fact]
+    public void Headers_are_case_insensitive_and_trimmed()
+    {
+        var headers = GtkWebViewAdapter.ParseSchemeRequestHeaders(
+            "Content-Type: application/octet-stream\nContent-Length:  1073741824 \nOrigin: app://local\n");
+
+        Assert.NotNull(headers);
+        Assert.Equal("application/octet-stream", headers["content-type"]);
+        Assert.Equal("1073741824", headers["CONTENT-LENGTH"]);
+        Assert.Equal("app://local", headers["Origin"]);
+    }
+
+    [Fact]
+    public void Repeated_headers_are_combined()
+    {
+        var headers = GtkWebViewAdapter.ParseSchemeRequestHeaders("Accept: text/html\naccept: application/json\n");
+
+        Assert.Equal("text/html, application/json", headers!["Accept"]);
+    }
+
+    [Theory]
+    [InlineData(null)]
+    [InlineData("")]
+    public void Missing_headers_yield_null(string? text)
+    {
+        Assert.Null(GtkWebViewAdapter.ParseSchemeRequestHeaders(text));
+    }
+
+    [Fact]
+    public void Malformed_lines_are_skipped()
+    {
+        var headers = GtkWebViewAdapter.ParseSchemeRequestHeaders("no colon here\n: empty name\nX-Ok: 1\n");
+
+        Assert.Equal("X-Ok", Assert.Single(headers!.Keys));
+    }
+}
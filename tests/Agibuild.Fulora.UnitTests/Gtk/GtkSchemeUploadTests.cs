@@ -0,0 +1,104 @@
+using System.Text;
+using Agibuild.Fulora.Adapters.Gtk;
+using Xunit;
+
+namespace Agibuild.Fulora.UnitTests.Gtk;
+
+public sealed class GtkSchemeUploadTests
+{
+    [Fact]
+    public async Task Handler_response_is_returned_and_the_body_closed()
+    {
+        var body = new TrackingStream(Encoding.UTF8.GetBytes("payload"));
+        var upload = Upload(body);
+        using var cts = new CancellationTokenSource();
+        CancellationToken seen = default;
+
+        var reply = await GtkWebViewAdapter.RunSchemeUploadAsync(async (u, ct) =>
+        {
+            seen = ct;
+            using var reader = new StreamReader(u.Body, leaveOpen: true);
+            var text = await reader.ReadToEndAsync(ct);
+            return new GtkSchemeResponse(Encoding.UTF8.GetBytes(text.ToUpperInvariant()), "text/plain", 201);
+        }, upload, cts.Token);
+
+        var response = Assert.IsType<GtkSchemeResponse>(reply.Response);
+        Assert.Equal("PAYLOAD", Encoding.UTF8.GetString(response.Body.Span));
+        Assert.Equal(201, response.StatusCode);
+        Assert.Equal(cts.Token, seen);
+        Assert.True(body.Disposed);
+    }
+
+    [Fact]
+    public async Task Null_response_is_not_handled()
+    {
+        var body = new TrackingStream([]);
+
+        var reply = await GtkWebViewAdapter.RunSchemeUploadAsync((_, _) => Task.FromResult<GtkSchemeResponse?>(null),
+            Upload(body), CancellationToken.None);
+
+        Assert.Null(reply.Response);
+        Assert.Equal(404, reply.FailureStatus);
+        Assert.True(body.Disposed);
+    }
+
+    [Fact]
+    public async Task Handler_failure_and_detach_cancellation_answer_500()
+    {
+        var body = new TrackingStream([]);
+        using var cts = new CancellationTokenSource();
+        cts.Cancel();
+
+        var reply = await GtkWebViewAdapter.RunSchemeUploadAsync(async (_, ct) =>
+        {
+            await Task.Delay(Timeout.Infinite, ct);
+            return null;
+        }, Upload(body), cts.Token);
+
+        Assert.Null(reply.Response);
+        Assert.Equal(500, reply.FailureStatus);
+        Assert.False(string.IsNullOrEmpty(reply.FailureMessage));
+        Assert.True(body.Disposed);
+    }
+
+    [Fact]
+    public void Body_stream_is_forward_only_and_closed_once()
+    {
+        var stream = new GtkWebViewAdapter.SchemeBodyStream(IntPtr.Zero, -1);
+
+        Assert.False(stream.CanSeek);
+        Assert.False(stream.CanWrite);
+        Assert.False(stream.CanRead);
+        Assert.Equal(0, stream.Position);
+        Assert.Throws<NotSupportedException>(() => stream.Length);
+        Assert.Throws<NotSupportedException>(() => stream.Position = 1);
+        Assert.Throws<NotSupportedException>(() => stream.Seek(0, SeekOrigin.Begin));
+        Assert.Throws<ObjectDisposedException>(() => stream.Read(new byte[4], 0, 4));
+
+        stream.Dispose();
+        stream.Dispose();
+    }
+
+    [Fact]
+    public void Body_stream_reports_a_declared_length()
+    {
+        using var stream = new GtkWebViewAdapter.SchemeBodyStream(IntPtr.Zero, 1024);
+
+        Assert.Equal(1024, stream.Length);
+    }
+
+    private static GtkSchemeUpload Upload(Stream body)
+        => new(new Uri("app://local/upload"), "POST",
+            new Dictionary<string, string>(StringComparer.OrdinalIgnoreCase), body.Length, body);
+
+    private sealed class TrackingStream(byte[] data) : MemoryStream(data)
+    {
+        public bool Disposed { get; private set; }
+
+        protected override void Dispose(bool disposing)
+        {
+            Disposed = true;
+            base.Dispose(disposing);
+        }
+    }
+}
@@ -0,0 +1,42 @@
+using Agibuild.Fulora;
+using Agibuild.Fulora.Adapters.Gtk;
+using Xunit;
+
+namespace Agibuild.Fulora.UnitTests.Gtk;
+
+public sealed class GtkScriptEvaluationLimitTests
+{
+    [Fact]
+    public async Task Timed_out_request_fails_with_timeout()
+    {
+        var adapter = new GtkWebViewAdapter();
+        var pending = adapter.TestOnly_TrackScriptRequest(7);
+
+        adapter.TestOnly_RaiseScriptSettledFromNative(7, GtkWebViewAdapter.ScriptTimedOut, queuedUs: 5_000, runUs: 0);
+
+        var ex = await Assert.ThrowsAsync<WebViewScriptException>(() => pending);
+        Assert.IsType<TimeoutException>(ex.InnerException);
+    }
+
+    [Fact]
+    public async Task Cancelled_request_is_cancelled()
+    {
+        var adapter = new GtkWebViewAdapter();
+        var pending = adapter.TestOnly_TrackScriptRequest(8);
+
+        adapter.TestOnly_RaiseScriptSettledFromNative(8, GtkWebViewAdapter.ScriptCancelled, queuedUs: 0, runUs: 1_000);
+
+        await Assert.ThrowsAnyAsync<OperationCanceledException>(() => pending);
+    }
+
+    [Fact]
+    public void Completed_request_waits_for_its_result()
+    {
+        var adapter = new GtkWebViewAdapter();
+        var pending = adapter.TestOnly_TrackScriptRequest(9);
+
+        adapter.TestOnly_RaiseScriptSettledFromNative(9, GtkWebViewAdapter.ScriptCompleted, queuedUs: 0, runUs: 2_000);
+
+        Assert.False(pending.IsCompleted);
+    }
+}
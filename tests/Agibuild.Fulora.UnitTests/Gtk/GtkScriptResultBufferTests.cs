@@ -0,0 +1,83 @@
+using System.Runtime.InteropServices;
+using System.Text;
+using Agibuild.Fulora;
+using Agibuild.Fulora.Adapters.Gtk;
+using Xunit;
+
+namespace Agibuild.Fulora.UnitTests.Gtk;
+
+public sealed class GtkScriptResultBufferTests
+{
+    [Fact]
+    public async Task String_request_decodes_the_whole_buffer_including_embedded_nuls()
+    {
+        var adapter = new GtkWebViewAdapter();
+        var pending = adapter.TestOnly_TrackScriptRequest(11);
+        var bytes = Encoding.UTF8.GetBytes("a\0bé");
+
+        RaiseBuffer(adapter, 11, bytes);
+
+        Assert.Equal("a\0bé", await pending);
+    }
+
+    [Fact]
+    public async Task Stream_request_reads_the_buffer_in_place_and_settles_the_string_request()
+    {
+        var adapter = new GtkWebViewAdapter();
+        var pending = adapter.TestOnly_TrackScriptStreamRequest(12);
+        var bytes = Encoding.UTF8.GetBytes("{\"rows\":[1,2,3]}");
+
+        var data = Marshal.AllocHGlobal(bytes.Length);
+        try
+        {
+            Marshal.Copy(bytes, 0, data, bytes.Length);
+            adapter.TestOnly_RaiseScriptBufferFromNative(12, data, bytes.Length);
+
+            using var stream = await pending;
+            Assert.NotNull(stream);
+            Assert.False(stream.CanWrite);
+            Assert.Equal(bytes.Length, stream.Length);
+            using var copy = new MemoryStream();
+            await stream.CopyToAsync(copy);
+            Assert.Equal(bytes, copy.ToArray());
+        }
+        finally
+        {
+            Marshal.FreeHGlobal(data);
+        }
+    }
+
+    [Fact]
+    public async Task Stream_request_fails_with_the_string_request()
+    {
+        var adapter = new GtkWebViewAdapter();
+        var pending = adapter.TestOnly_TrackScriptStreamRequest(13);
+
+        adapter.TestOnly_RaiseScriptSettledFromNative(13, GtkWebViewAdapter.ScriptTimedOut, queuedUs: 0, runUs: 1_000);
+
+        var ex = await Assert.ThrowsAsync<WebViewScriptException>(() => pending);
+        Assert.IsType<TimeoutException>(ex.InnerException);
+    }
+
+    [Fact]
+    public void Buffer_for_an_unknown_request_is_dropped()
+    {
+        var adapter = new GtkWebViewAdapter();
+
+        RaiseBuffer(adapter, 14, [1, 2, 3]);
+    }
+
+    private static void RaiseBuffer(GtkWebViewAdapter adapter, ulong requestId, byte[] bytes)
+    {
+        var data = Marshal.AllocHGlobal(Math.Max(bytes.Length, 1));
+        try
+        {
+            Marshal.Copy(bytes, 0, data, bytes.Length);
+            adapter.TestOnly_RaiseScriptBufferFromNative(requestId, data, bytes.Length);
+        }
+        finally
+        {
+            Marshal.FreeHGlobal(data);
+        }
+    }
+}
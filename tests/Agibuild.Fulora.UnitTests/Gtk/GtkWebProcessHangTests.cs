@@ -0,0 +1,69 @@
+using Agibuild.Fulora.Adapters.Gtk;
+using Xunit;
+
+namespace Agibuild.Fulora.UnitTests.Gtk;
+
+public sealed class GtkWebProcessHangTests
+{
+    [Fact]
+    public void Hang_start_captures_the_navigation_scripts_and_bridge_message_in_flight()
+    {
+        var adapter = new GtkWebViewAdapter();
+        var navId = Guid.NewGuid();
+        var uri = new Uri("https://gtk-hang.example/panel");
+        var reports = new List<GtkWebProcessHang>();
+        adapter.WebProcessHang += (_, e) => reports.Add(e);
+
+        adapter.TestOnly_SetActiveNavigationForSslTest(navId, uri);
+        _ = adapter.TestOnly_TrackScriptRequest(7);
+        adapter.TestOnly_RaiseMessageFromNative("""{"jsonrpc":"2.0","id":"__js_1","method":"Panel.load"}""", "app://localhost");
+
+        adapter.TestOnly_RaiseWebProcessHangFromNative(GtkWebProcessHangPhase.Started, 0);
+
+        var started = Assert.Single(reports);
+        Assert.Equal(GtkWebProcessHangPhase.Started, started.Phase);
+        Assert.Equal(TimeSpan.Zero, started.Duration);
+        Assert.Equal(navId, started.NavigationId);
+        Assert.Equal(uri, started.NavigationUri);
+        Assert.Equal(1, started.ScriptsInFlight);
+        Assert.Contains("Panel.load", started.LastBridgeMessage!);
+        Assert.False(adapter.IsWebProcessResponsive);
+    }
+
+    [Fact]
+    public void Hang_end_repeats_the_start_context_with_the_duration()
+    {
+        var adapter = new GtkWebViewAdapter();
+        var navId = Guid.NewGuid();
+        var reports = new List<GtkWebProcessHang>();
+        adapter.WebProcessHang += (_, e) => reports.Add(e);
+
+        adapter.TestOnly_SetActiveNavigationForSslTest(navId, new Uri("https://gtk-hang.example/"));
+        adapter.TestOnly_RaiseWebProcessHangFromNative(GtkWebProcessHangPhase.Started, 0);
+        adapter.TestOnly_RaiseWebProcessHangFromNative(GtkWebProcessHangPhase.Recovered, 2_500_000);
+
+        Assert.Equal(2, reports.Count);
+        var ended = reports[1];
+        Assert.Equal(GtkWebProcessHangPhase.Recovered, ended.Phase);
+        Assert.Equal(TimeSpan.FromSeconds(2.5), ended.Duration);
+        Assert.Equal(navId, ended.NavigationId);
+        Assert.True(adapter.IsWebProcessResponsive);
+    }
+
+    [Fact]
+    public void Long_bridge_messages_are_truncated_in_reports()
+    {
+        var adapter = new GtkWebViewAdapter();
+        GtkWebProcessHang? report = null;
+        adapter.WebProcessHang += (_, e) => report = e;
+
+        adapter.TestOnly_RaiseMessageFromNative(new string('x', 10_000), "app://localhost");
+        adapter.TestOnly_RaiseWebProcessHangFromNative(GtkWebProcessHangPhase.Started, 0);
+
+        Assert.NotNull(report);
+        Assert.True(report!.LastBridgeMessage!.Length < 200);
+        Assert.Null(report.PendingScript);
+        Assert.Equal(0, report.ScriptsInFlight);
+        Assert.Null(report.NavigationId);
+    }
+}
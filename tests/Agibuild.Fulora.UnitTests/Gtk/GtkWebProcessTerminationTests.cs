@@ -0,0 +1,43 @@
+using Agibuild.Fulora;
+using Agibuild.Fulora.Adapters.Gtk;
+using Xunit;
+
+namespace Agibuild.Fulora.UnitTests.Gtk;
+
+public sealed class GtkWebProcessTerminationTests
+{
+    [Fact]
+    public async Task Termination_fails_active_navigation_with_process_terminated_error()
+    {
+        var adapter = new GtkWebViewAdapter();
+        var navId = Guid.NewGuid();
+        var uri = new Uri("https://gtk-crash.example/page");
+
+        var completed = new TaskCompletionSource<NavigationCompletedEventArgs>(TaskCreationOptions.RunContinuationsAsynchronously);
+        adapter.NavigationCompleted += (_, e) => completed.TrySetResult(e);
+
+        adapter.TestOnly_SetActiveNavigationForSslTest(navId, uri);
+        adapter.TestOnly_RaiseWebProcessTerminatedFromNative(reason: 1, recovering: false);
+
+        var args = await completed.Task;
+        Assert.Equal(NavigationCompletedStatus.Failure, args.Status);
+        Assert.Equal(navId, args.NavigationId);
+        var ex = Assert.IsType<WebViewProcessTerminatedException>(args.Error);
+        Assert.Equal(WebViewProcessTerminationReason.ExceededMemoryLimit, ex.Reason);
+        Assert.Equal(FuloraErrorCodes.WebProcessTerminated, ex.ErrorCode);
+    }
+
+    [Fact]
+    public void Termination_raises_event_with_reason_and_recovery_flag()
+    {
+        var adapter = new GtkWebViewAdapter();
+        GtkWebProcessTerminatedEventArgs? raised = null;
+        adapter.WebProcessTerminated += (_, e) => raised = e;
+
+        adapter.TestOnly_RaiseWebProcessTerminatedFromNative(reason: 0, recovering: true);
+
+        Assert.NotNull(raised);
+        Assert.Equal(WebViewProcessTerminationReason.Crashed, raised!.Reason);
+        Assert.True(raised.Recovering);
+    }
+}
@@ -0,0 +1,28 @@
+using Agibuild.Fulora.Adapters.Abstractions;
+using Agibuild.Fulora.Adapters.Gtk;
+using Xunit;
+
+namespace Agibuild.Fulora.UnitTests.Gtk;
+
+public sealed class GtkWebsiteDataTests
+{
+    [Fact]
+    public void CreateWebsiteDataUsage_maps_sizes_by_type_bit_and_skips_unsized_types()
+    {
+        var sizes = new ulong[16];
+        sizes[1] = 4096;  // disk cache
+        sizes[6] = 1024;  // IndexedDB
+        sizes[8] = 0;     // cookies are present but never sized
+        sizes[12] = 99;   // not in the type mask, ignored
+
+        var types = (uint)(WebsiteDataTypes.DiskCache | WebsiteDataTypes.IndexedDbDatabases | WebsiteDataTypes.Cookies);
+        var usage = GtkWebViewAdapter.CreateWebsiteDataUsage("example.test", types, sizes);
+
+        Assert.Equal("example.test", usage.Origin);
+        Assert.True(usage.Types.HasFlag(WebsiteDataTypes.Cookies));
+        Assert.Equal(2, usage.Sizes.Count);
+        Assert.Equal(4096, usage.Sizes[WebsiteDataTypes.DiskCache]);
+        Assert.Equal(1024, usage.Sizes[WebsiteDataTypes.IndexedDbDatabases]);
+        Assert.Equal(5120, usage.TotalSize);
+    }
+}
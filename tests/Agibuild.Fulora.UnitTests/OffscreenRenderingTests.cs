@@ -0,0 +1,68 @@
+using Agibuild.Fulora.Adapters.Abstractions;
+using Agibuild.Fulora.Testing;
+using Avalonia.Input;
+using Xunit;
+
+namespace Agibuild.Fulora.UnitTests;
+
+public sealed class OffscreenRenderingTests
+{
+    private readonly TestDispatcher _dispatcher = new();
+
+    [Fact]
+    public void Core_exposes_frames_only_while_the_adapter_renders_offscreen()
+    {
+        var adapter = MockWebViewAdapter.CreateWithOffscreenRendering();
+        using var core = new WebViewCore(adapter, _dispatcher);
+
+        Assert.Same(adapter, core.OffscreenRendering);
+
+        adapter.IsOffscreenRendering = false;
+        Assert.Null(core.OffscreenRendering);
+    }
+
+    [Fact]
+    public void Adapters_without_offscreen_rendering_report_none()
+    {
+        using var core = new WebViewCore(MockWebViewAdapter.Create(), _dispatcher);
+
+        Assert.Null(core.OffscreenRendering);
+    }
+
+    [Theory]
+    [InlineData(Key.Enter, null, 0xff0du)]
+    [InlineData(Key.Back, null, 0xff08u)]
+    [InlineData(Key.Left, null, 0xff51u)]
+    [InlineData(Key.PageDown, null, 0xff56u)]
+    [InlineData(Key.F5, null, 0xffc2u)]
+    [InlineData(Key.A, "A", 0x41u)]
+    [InlineData(Key.A, null, 0x61u)]
+    [InlineData(Key.D7, "7", 0x37u)]
+    [InlineData(Key.OemQuotes, "é", 0xe9u)]
+    [InlineData(Key.OemQuotes, "€", 0x010020acu)]
+    [InlineData(Key.Space, " ", 0x20u)]
+    [InlineData(Key.Scroll, null, 0u)]
+    public void Keys_map_to_x_keysyms(Key key, string? symbol, uint expected)
+    {
+        Assert.Equal(expected, OffscreenInputMapper.ToKeyVal(key, symbol));
+    }
+
+    [Fact]
+    public void Modifiers_map_to_gdk_bits()
+    {
+        Assert.Equal(
+            OffscreenInputModifiers.Shift | OffscreenInputModifiers.Control | OffscreenInputModifiers.Alt | OffscreenInputModifiers.Super,
+            OffscreenInputMapper.ToModifiers(KeyModifiers.Shift | KeyModifiers.Control | KeyModifiers.Alt | KeyModifiers.Meta));
+        Assert.Equal(OffscreenInputModifiers.None, OffscreenInputMapper.ToModifiers(KeyModifiers.None));
+    }
+
+    [Theory]
+    [InlineData(PointerUpdateKind.LeftButtonPressed, 1u)]
+    [InlineData(PointerUpdateKind.MiddleButtonReleased, 2u)]
+    [InlineData(PointerUpdateKind.RightButtonPressed, 3u)]
+    [InlineData(PointerUpdateKind.Other, 0u)]
+    public void Pointer_buttons_map_to_gdk_numbers(PointerUpdateKind kind, uint expected)
+    {
+        Assert.Equal(expected, OffscreenInputMapper.ToButton(kind));
+    }
+}
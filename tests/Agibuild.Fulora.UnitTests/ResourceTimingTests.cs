@@ -0,0 +1,42 @@
+using Agibuild.Fulora.Testing;
+using Xunit;
+
+namespace Agibuild.Fulora.UnitTests;
+
+public sealed class ResourceTimingTests
+{
+    private readonly TestDispatcher _dispatcher = new();
+
+    [Fact]
+    public void Recording_and_export_reach_the_adapter()
+    {
+        var adapter = MockWebViewAdapter.CreateWithResourceTiming();
+        using var core = new WebViewCore(adapter, _dispatcher);
+
+        Assert.True(core.TrySetResourceTimingEnabled(true, capacity: 64));
+        core.ClearResourceTimings();
+
+        Assert.True(adapter.ResourceTimingEnabled);
+        Assert.Equal(64, adapter.ResourceTimingCapacity);
+        Assert.True(adapter.ResourceTimingsCleared);
+        Assert.Equal(adapter.Har, core.ExportResourceTimingsAsHar());
+    }
+
+    [Fact]
+    public void Negative_capacity_is_rejected()
+    {
+        using var core = new WebViewCore(MockWebViewAdapter.CreateWithResourceTiming(), _dispatcher);
+
+        Assert.Throws<ArgumentOutOfRangeException>(() => core.TrySetResourceTimingEnabled(true, capacity: -1));
+    }
+
+    [Fact]
+    public void Without_the_capability_nothing_is_recorded()
+    {
+        using var core = new WebViewCore(MockWebViewAdapter.Create(), _dispatcher);
+
+        Assert.False(core.TrySetResourceTimingEnabled(true));
+        core.ClearResourceTimings();
+        Assert.Null(core.ExportResourceTimingsAsHar());
+    }
+}
@@ -0,0 +1,74 @@
+using System.Text.Json;
+using Agibuild.Fulora.Adapters.Abstractions;
+using Agibuild.Fulora.Testing;
+using Xunit;
+
+namespace Agibuild.Fulora.UnitTests;
+
+public sealed class RpcDeliveryAdapterTests
+{
+    private readonly TestDispatcher _dispatcher = new();
+
+    private (WebViewCore Core, MockWebViewAdapterWithRpcDelivery Adapter, List<string> Scripts) CreateCore()
+    {
+        var adapter = MockWebViewAdapter.CreateWithRpcDelivery();
+        var scripts = new List<string>();
+        adapter.ScriptCallback = script => { scripts.Add(script); return null; };
+        var core = new WebViewCore(adapter, _dispatcher);
+        core.EnableWebMessageBridge(new WebMessageBridgeOptions
+        {
+            AllowedOrigins = new HashSet<string> { "*" }
+        });
+        _dispatcher.RunAll();
+        core.Rpc!.Handle("Calc.add", (JsonElement? args) =>
+            (object?)(args!.Value.GetProperty("a").GetInt32() + args.Value.GetProperty("b").GetInt32()));
+        scripts.Clear();
+        return (core, adapter, scripts);
+    }
+
+    [Fact]
+    public void Responses_go_through_the_direct_channel_instead_of_script()
+    {
+        var (core, adapter, scripts) = CreateCore();
+
+        adapter.RaiseWebMessage("""{"jsonrpc":"2.0","id":"__js_1","method":"Calc.add","params":{"a":3,"b":4}}""", "*", core.ChannelId);
+        WaitUntil(() => { _dispatcher.RunAll(); return adapter.RpcDeliveries.Count > 0; });
+
+        var (kind, json) = Assert.Single(adapter.RpcDeliveries);
+        Assert.Equal(RpcDeliveryKind.Response, kind);
+        using var doc = JsonDocument.Parse(json);
+        Assert.Equal("__js_1", doc.RootElement.GetProperty("id").GetString());
+        Assert.Equal(7, doc.RootElement.GetProperty("result").GetInt32());
+        Assert.DoesNotContain(scripts, s => s.Contains("_onResponse"));
+    }
+
+    [Fact]
+    public void Calls_into_the_page_are_dispatched_through_the_direct_channel()
+    {
+        var (core, adapter, scripts) = CreateCore();
+
+        _ = core.Rpc!.NotifyAsync("Page.refresh");
+        _dispatcher.RunAll();
+
+        var (kind, json) = Assert.Single(adapter.RpcDeliveries);
+        Assert.Equal(RpcDeliveryKind.Dispatch, kind);
+        Assert.Contains("Page.refresh", json);
+        Assert.DoesNotContain(scripts, s => s.Contains("_dispatch"));
+    }
+
+    [Fact]
+    public void A_refused_delivery_falls_back_to_the_delivery_script()
+    {
+        var (core, adapter, scripts) = CreateCore();
+        adapter.RpcDeliveryConnected = false;
+
+        adapter.RaiseWebMessage("""{"jsonrpc":"2.0","id":"__js_2","method":"Calc.add","params":{"a":1,"b":1}}""", "*", core.ChannelId);
+        WaitUntil(() => { _dispatcher.RunAll(); return scripts.Any(s => s.Contains("_onResponse")); });
+
+        Assert.Empty(adapter.RpcDeliveries);
+        Assert.Contains(scripts, s => s.Contains("__js_2"));
+    }
+
+    private static void WaitUntil(Func<bool> condition)
+        => Assert.True(SpinWait.SpinUntil(condition, TimeSpan.FromSeconds(3)), "Timed out waiting for the RPC response.");
+}
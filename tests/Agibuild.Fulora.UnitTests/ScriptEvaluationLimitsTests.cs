@@ -0,0 +1,40 @@
+using Agibuild.Fulora.Testing;
+using Xunit;
+
+namespace Agibuild.Fulora.UnitTests;
+
+public sealed class ScriptEvaluationLimitsTests
+{
+    private readonly TestDispatcher _dispatcher = new();
+
+    [Fact]
+    public void Limits_reach_the_adapter()
+    {
+        var adapter = MockWebViewAdapter.CreateWithScriptEvaluationLimits();
+        using var core = new WebViewCore(adapter, _dispatcher);
+
+        Assert.True(core.TryConfigureScriptEvaluation(maxInFlight: 4, maxQueued: 16, TimeSpan.FromSeconds(5)));
+
+        Assert.Equal<(int, int, TimeSpan?)?>((4, 16, TimeSpan.FromSeconds(5)), adapter.Limits);
+    }
+
+    [Fact]
+    public void Invalid_limits_are_rejected_before_reaching_the_adapter()
+    {
+        var adapter = MockWebViewAdapter.CreateWithScriptEvaluationLimits();
+        using var core = new WebViewCore(adapter, _dispatcher);
+
+        Assert.Throws<ArgumentOutOfRangeException>(() => core.TryConfigureScriptEvaluation(-1, 0));
+        Assert.Throws<ArgumentOutOfRangeException>(() => core.TryConfigureScriptEvaluation(1, -1));
+        Assert.Throws<ArgumentOutOfRangeException>(() => core.TryConfigureScriptEvaluation(1, 0, TimeSpan.Zero));
+        Assert.Null(adapter.Limits);
+    }
+
+    [Fact]
+    public void Without_the_capability_nothing_is_configured()
+    {
+        using var core = new WebViewCore(MockWebViewAdapter.Create(), _dispatcher);
+
+        Assert.False(core.TryConfigureScriptEvaluation(4, 16));
+    }
+}
@@ -0,0 +1,55 @@
+using System.Text;
+using Agibuild.Fulora.Testing;
+using Xunit;
+
+namespace Agibuild.Fulora.UnitTests;
+
+public sealed class ScriptStreamingTests
+{
+    private readonly TestDispatcher _dispatcher = new();
+
+    [Fact]
+    public void Streamed_result_comes_from_the_adapter_buffer()
+    {
+        var adapter = MockWebViewAdapter.CreateWithScriptStreaming();
+        adapter.StreamResult = Encoding.UTF8.GetBytes("\"large\"");
+        using var core = new WebViewCore(adapter, _dispatcher);
+
+        using var stream = DispatcherTestPump.Run(_dispatcher, () => core.InvokeScriptStreamAsync("big()"));
+
+        Assert.Equal("\"large\"", new StreamReader(stream!).ReadToEnd());
+        Assert.Equal(new[] { "big()" }, adapter.StreamedScripts);
+        Assert.Null(adapter.LastScript);
+    }
+
+    [Fact]
+    public void Without_the_capability_the_string_result_is_encoded()
+    {
+        var adapter = new MockWebViewAdapter { ScriptResult = "héllo" };
+        using var core = new WebViewCore(adapter, _dispatcher);
+
+        using var stream = DispatcherTestPump.Run(_dispatcher, () => core.InvokeScriptStreamAsync("greet()"));
+
+        Assert.Equal("héllo", new StreamReader(stream!, Encoding.UTF8).ReadToEnd());
+        Assert.False(core.TrySetScriptResultBufferThreshold(1024));
+    }
+
+    [Fact]
+    public void Null_result_returns_no_stream()
+    {
+        using var core = new WebViewCore(MockWebViewAdapter.CreateWithScriptStreaming(), _dispatcher);
+
+        Assert.Null(DispatcherTestPump.Run(_dispatcher, () => core.InvokeScriptStreamAsync("undefined")));
+    }
+
+    [Fact]
+    public void Buffer_threshold_reaches_the_adapter()
+    {
+        var adapter = MockWebViewAdapter.CreateWithScriptStreaming();
+        using var core = new WebViewCore(adapter, _dispatcher);
+
+        Assert.True(core.TrySetScriptResultBufferThreshold(1 << 20));
+        Assert.Equal<long?>(1 << 20, adapter.BufferThreshold);
+        Assert.Throws<ArgumentOutOfRangeException>(() => core.TrySetScriptResultBufferThreshold(-1));
+    }
+}
@@ -0,0 +1,38 @@
+using Agibuild.Fulora.Adapters.Abstractions;
+using Agibuild.Fulora.Testing;
+using Xunit;
+
+namespace Agibuild.Fulora.UnitTests;
+
+public sealed class SharedContentSetTests
+{
+    private readonly TestDispatcher _dispatcher = new();
+
+    [Fact]
+    public void Defined_set_is_attached_and_detached_through_the_adapter()
+    {
+        var adapter = MockWebViewAdapter.CreateWithSharedContentSets();
+        using var core = new WebViewCore(adapter, _dispatcher);
+
+        Assert.True(core.TryDefineSharedContentSet("bundle", ["window.bundle = 1;"], options: SharedContentSetOptions.TopFrameOnly));
+        Assert.True(core.TryAttachSharedContentSet("bundle"));
+
+        Assert.Equal(SharedContentSetOptions.TopFrameOnly, adapter.Defined["bundle"].Options);
+        Assert.Contains("bundle", adapter.Attached);
+
+        core.DetachSharedContentSet("bundle");
+        Assert.Empty(adapter.Attached);
+
+        core.DestroySharedContentSet("bundle");
+        Assert.Empty(adapter.Defined);
+    }
+
+    [Fact]
+    public void Without_the_capability_nothing_is_defined()
+    {
+        using var core = new WebViewCore(MockWebViewAdapter.Create(), _dispatcher);
+
+        Assert.False(core.TryDefineSharedContentSet("bundle", ["window.bundle = 1;"]));
+        Assert.False(core.TryAttachSharedContentSet("bundle"));
+    }
+}
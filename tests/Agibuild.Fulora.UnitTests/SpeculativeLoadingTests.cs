@@ -0,0 +1,36 @@
+using Agibuild.Fulora.Adapters.Abstractions;
+using Agibuild.Fulora.Testing;
+using Xunit;
+
+namespace Agibuild.Fulora.UnitTests;
+
+public sealed class SpeculativeLoadingTests
+{
+    private readonly TestDispatcher _dispatcher = new();
+
+    [Fact]
+    public void Prefetch_and_preload_reach_the_adapter()
+    {
+        var adapter = MockWebViewAdapter.CreateWithSpeculativeLoading();
+        adapter.Stats = new PreloadStats(Hits: 2, Misses: 1, Wasted: 0);
+        using var core = new WebViewCore(adapter, _dispatcher);
+        var next = new Uri("https://example.test/next");
+
+        Assert.True(core.TryPrefetchDns("cdn.example.test"));
+        Assert.True(core.TryPreloadUris([next]));
+
+        Assert.Equal(new[] { "cdn.example.test" }, adapter.PrefetchedHosts);
+        Assert.Equal(next, Assert.Single(adapter.PreloadQueue));
+        Assert.Equal<PreloadStats?>(adapter.Stats, core.GetPreloadStats());
+    }
+
+    [Fact]
+    public void Without_the_capability_nothing_is_preloaded()
+    {
+        using var core = new WebViewCore(MockWebViewAdapter.Create(), _dispatcher);
+
+        Assert.False(core.TryPrefetchDns("cdn.example.test"));
+        Assert.False(core.TryPreloadUris([new Uri("https://example.test/next")]));
+        Assert.Null(core.GetPreloadStats());
+    }
+}
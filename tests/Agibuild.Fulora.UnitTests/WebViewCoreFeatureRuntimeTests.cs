@@ -35,6 +35,29 @@ public sealed class WebViewCoreFeatureRuntimeTests
         Assert.True(dragDropRuntime.HasDragDropSupport);
     }
 
+    [Fact]
+    public void SetHostVisible_forwards_changes_only()
+    {
+        var adapter = MockWebViewAdapter.CreateWithHostVisibility();
+        using var runtime = new WebViewCoreFeatureRuntime(WebViewCoreTestContext.Create(adapter));
+
+        runtime.SetHostVisible(true);
+        runtime.SetHostVisible(true);
+        runtime.SetHostVisible(false);
+        runtime.SetHostVisible(true);
+
+        Assert.Equal([true, false, true], adapter.HostVisibilityChanges);
+    }
+
+    [Fact]
+    public void SetHostVisible_is_a_no_op_without_the_capability()
+    {
+        using var runtime = new WebViewCoreFeatureRuntime(
+            WebViewCoreTestContext.Create(MockWebViewAdapter.Create()));
+
+        runtime.SetHostVisible(false);
+    }
+
     [Fact]
     public async Task TryGetWebViewHandleAsync_returns_null_after_adapter_destroyed()
     {
@@ -0,0 +1,38 @@
+using Agibuild.Fulora.Adapters.Abstractions;
+using Agibuild.Fulora.Testing;
+using Xunit;
+
+namespace Agibuild.Fulora.UnitTests;
+
+public sealed class WebsiteDataTests
+{
+    private readonly TestDispatcher _dispatcher = new();
+
+    [Fact]
+    public async Task Usage_is_reported_and_trimmed_per_origin()
+    {
+        var adapter = MockWebViewAdapter.CreateWithWebsiteData();
+        adapter.Usage.Add(Usage("big.test", 10_000));
+        adapter.Usage.Add(Usage("small.test", 10));
+        using var core = new WebViewCore(adapter, _dispatcher);
+
+        var usage = await core.TryFetchWebsiteDataUsageAsync();
+        var over = usage!.Where(u => u.TotalSize > 1_000).Select(u => u.Origin).ToArray();
+
+        Assert.True(await core.TryRemoveWebsiteDataAsync(WebsiteDataTypes.All, over));
+        Assert.Equal("small.test", Assert.Single(adapter.Usage).Origin);
+    }
+
+    [Fact]
+    public async Task Without_the_capability_nothing_is_reported()
+    {
+        using var core = new WebViewCore(MockWebViewAdapter.Create(), _dispatcher);
+
+        Assert.Null(await core.TryFetchWebsiteDataUsageAsync());
+        Assert.False(await core.TryRemoveWebsiteDataAsync(WebsiteDataTypes.All));
+    }
+
+    private static WebsiteDataUsage Usage(string origin, long diskCache)
+        => new(origin, WebsiteDataTypes.DiskCache,
+            new Dictionary<WebsiteDataTypes, long> { [WebsiteDataTypes.DiskCache] = diskCache });
+}